@@ -404,6 +404,7 @@ ClangTidyASTConsumerFactory::CreateASTConsumer(
     Profiling = std::make_unique<ClangTidyProfiling>(
         Context.getProfileStorageParams());
     FinderOptions.CheckProfiling.emplace(Profiling->Records);
+    FinderOptions.CheckProfiling->MatcherRecords = &Profiling->MatcherRecords;
   }
 
   std::unique_ptr<ast_matchers::MatchFinder> Finder(
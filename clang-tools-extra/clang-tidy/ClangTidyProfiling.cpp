@@ -38,6 +38,8 @@ ClangTidyProfiling::StorageParams::StorageParams(llvm::StringRef ProfilePrefix,
 
 void ClangTidyProfiling::printUserFriendlyTable(llvm::raw_ostream &OS) {
   TG->print(OS);
+  if (MatcherTG)
+    MatcherTG->print(OS);
   OS.flush();
 }
 
@@ -46,7 +48,9 @@ void ClangTidyProfiling::printAsJSON(llvm::raw_ostream &OS) {
   OS << "\"file\": \"" << Storage->SourceFilename << "\",\n";
   OS << "\"timestamp\": \"" << Storage->Timestamp << "\",\n";
   OS << "\"profile\": {\n";
-  TG->printJSONValues(OS, "");
+  const char *Delim = TG->printJSONValues(OS, "");
+  if (MatcherTG)
+    MatcherTG->printJSONValues(OS, Delim);
   OS << "\n}\n";
   OS << "}\n";
   OS.flush();
@@ -79,6 +83,9 @@ ClangTidyProfiling::ClangTidyProfiling(llvm::Optional<StorageParams> Storage)
 
 ClangTidyProfiling::~ClangTidyProfiling() {
   TG.emplace("clang-tidy", "clang-tidy checks profiling", Records);
+  if (!MatcherRecords.empty())
+    MatcherTG.emplace("clang-tidy-matchers", "clang-tidy matchers profiling",
+                      MatcherRecords);
 
   if (!Storage.hasValue())
     printUserFriendlyTable(llvm::errs());
@@ -36,6 +36,7 @@ public:
 
 private:
   llvm::Optional<llvm::TimerGroup> TG;
+  llvm::Optional<llvm::TimerGroup> MatcherTG;
 
   llvm::Optional<StorageParams> Storage;
 
@@ -47,6 +48,9 @@ private:
 public:
   llvm::StringMap<llvm::TimeRecord> Records;
 
+  /// Time spent in each matcher of the checks that register more than one.
+  llvm::StringMap<llvm::TimeRecord> MatcherRecords;
+
   ClangTidyProfiling() = default;
 
   ClangTidyProfiling(llvm::Optional<StorageParams> Storage);
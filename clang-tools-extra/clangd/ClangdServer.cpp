@@ -142,6 +142,7 @@ ClangdServer::Options::operator TUScheduler::Options() const {
   Opts.RetentionPolicy = RetentionPolicy;
   Opts.StorePreamblesInMemory = StorePreamblesInMemory;
   Opts.UpdateDebounce = UpdateDebounce;
+  Opts.PreambleRebuildDelay = PreambleRebuildDelay;
   Opts.ContextProvider = ContextProvider;
   return Opts;
 }
@@ -155,6 +156,7 @@ ClangdServer::ClangdServer(const GlobalCompilationDatabase &CDB,
       WorkspaceRoot(Opts.WorkspaceRoot),
       Transient(Opts.ImplicitCancellation ? TUScheduler::InvalidateOnUpdate
                                           : TUScheduler::NoInvalidation),
+      AsyncThreadsCount(Opts.AsyncThreadsCount),
       DirtyFS(std::make_unique<DraftStoreFS>(TFS, DraftMgr)) {
   // Pass a callback into `WorkScheduler` to extract symbols from a newly
   // parsed file and rebuild the file index synchronously each time an AST
@@ -523,7 +525,8 @@ void ClangdServer::rename(PathRef File, Position Pos, llvm::StringRef NewName,
     if (!InpAST)
       return CB(InpAST.takeError());
     auto R = clangd::rename({Pos, NewName, InpAST->AST, File,
-                             DirtyFS->view(llvm::None), Index, Opts});
+                             DirtyFS->view(llvm::None), Index, Opts,
+                             std::max(AsyncThreadsCount, 1u)});
     if (!R)
       return CB(R.takeError());
 
@@ -150,6 +150,9 @@ public:
         /*RebuildRatio=*/1,
     };
 
+    /// Time to wait before rebuilding a preamble invalidated by an edit.
+    std::chrono::steady_clock::duration PreambleRebuildDelay = {};
+
     /// Cancel certain requests if the file changes before they begin running.
     /// This is useful for "transient" actions like enumerateTweaks that were
     /// likely implicitly generated, and avoids redundant work if clients forget
@@ -411,6 +414,9 @@ private:
   llvm::Optional<TUScheduler> WorkScheduler;
   // Invalidation policy used for actions that we assume are "transient".
   TUScheduler::ASTActionInvalidation Transient;
+  // The number of worker threads (-j), which also bounds the threads used by
+  // a single cross-file rename.
+  unsigned AsyncThreadsCount;
 
   // Store of the current versions of the open documents.
   // Only written from the main thread (despite being threadsafe).
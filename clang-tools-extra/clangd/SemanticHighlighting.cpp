@@ -343,6 +343,24 @@ public:
     std::vector<HighlightingToken> WithInactiveLines;
     auto SortedSkippedRanges = AST.getMacros().SkippedRanges;
     llvm::sort(SortedSkippedRanges);
+    // Inactive lines are visited in order, so find the start of each one by
+    // scanning forward from the previous one. Converting each position to an
+    // offset from scratch is quadratic in the size of the file.
+    int CurrentLine = 0;
+    size_t CurrentLineStart = 0;
+    auto GetStartOfLine = [&](int Line) -> llvm::Optional<size_t> {
+      if (Line < CurrentLine) {
+        CurrentLine = 0;
+        CurrentLineStart = 0;
+      }
+      for (; CurrentLine < Line; ++CurrentLine) {
+        size_t NextNewline = MainCode.find('\n', CurrentLineStart);
+        if (NextNewline == llvm::StringRef::npos)
+          return llvm::None;
+        CurrentLineStart = NextNewline + 1;
+      }
+      return CurrentLineStart;
+    };
     auto It = NonConflicting.begin();
     for (const Range &R : SortedSkippedRanges) {
       // Create one token for each line in the skipped range, so it works
@@ -357,8 +375,7 @@ public:
         for (; It != NonConflicting.end() && It->R.start.line < Line; ++It)
           WithInactiveLines.push_back(std::move(*It));
         // Add a token for the inactive line itself.
-        auto StartOfLine = positionToOffset(MainCode, Position{Line, 0});
-        if (StartOfLine) {
+        if (auto StartOfLine = GetStartOfLine(Line)) {
           StringRef LineText =
               MainCode.drop_front(*StartOfLine).take_until([](char C) {
                 return C == '\n';
@@ -371,8 +388,7 @@ public:
           WithInactiveLines.back().R.end.character =
               static_cast<int>(lspLength(LineText));
         } else {
-          elog("Failed to convert position to offset: {0}",
-               StartOfLine.takeError());
+          elog("Inactive line {0} is past the end of the main file", Line);
         }
 
         // Skip any other tokens on the inactive line. e.g.
@@ -114,33 +114,50 @@ class TUScheduler::ASTCache {
 public:
   using Key = const ASTWorker *;
 
-  ASTCache(unsigned MaxRetainedASTs) : MaxRetainedASTs(MaxRetainedASTs) {}
+  ASTCache(unsigned MaxRetainedASTs, std::size_t MaxRetainedASTBytes)
+      : MaxRetainedASTs(MaxRetainedASTs),
+        MaxRetainedASTBytes(MaxRetainedASTBytes) {}
 
-  /// Returns result of getUsedBytes() for the AST cached by \p K.
-  /// If no AST is cached, 0 is returned.
+  /// Returns result of getUsedBytes() for the AST cached by \p K, as of when
+  /// it was stored. If no AST is cached, 0 is returned.
   std::size_t getUsedBytes(Key K) {
     std::lock_guard<std::mutex> Lock(Mut);
     auto It = findByKey(K);
-    if (It == LRU.end() || !It->second)
+    if (It == LRU.end())
       return 0;
-    return It->second->getUsedBytes();
+    return It->UsedBytes;
   }
 
-  /// Store the value in the pool, possibly removing the last used AST.
+  /// Returns the sum of getUsedBytes() for all cached ASTs.
+  std::size_t getUsedBytes() {
+    std::lock_guard<std::mutex> Lock(Mut);
+    return UsedBytes;
+  }
+
+  /// Store the value in the pool, possibly removing the last used ASTs.
   /// The value should not be in the pool when this function is called.
   void put(Key K, std::unique_ptr<ParsedAST> V) {
+    // Computing the size walks the AST, do it before taking the lock.
+    std::size_t Size = V ? V->getUsedBytes() : 0;
+    std::vector<std::unique_ptr<ParsedAST>> ForCleanup;
     std::unique_lock<std::mutex> Lock(Mut);
     assert(findByKey(K) == LRU.end());
 
-    LRU.insert(LRU.begin(), {K, std::move(V)});
-    if (LRU.size() <= MaxRetainedASTs)
-      return;
-    // We're past the limit, remove the last element.
-    std::unique_ptr<ParsedAST> ForCleanup = std::move(LRU.back().second);
-    LRU.pop_back();
-    // Run the expensive destructor outside the lock.
+    LRU.insert(LRU.begin(), {K, std::move(V), Size});
+    UsedBytes += Size;
+    // Remove the last elements while we're past the limits. The byte limit
+    // never evicts the AST that was just stored, as it is the most likely one
+    // to be used next.
+    while (LRU.size() > MaxRetainedASTs ||
+           (MaxRetainedASTBytes && UsedBytes > MaxRetainedASTBytes &&
+            LRU.size() > 1)) {
+      UsedBytes -= LRU.back().UsedBytes;
+      ForCleanup.push_back(std::move(LRU.back().AST));
+      LRU.pop_back();
+    }
+    // Run the expensive destructors outside the lock.
     Lock.unlock();
-    ForCleanup.reset();
+    ForCleanup.clear();
   }
 
   /// Returns the cached value for \p K, or llvm::None if the value is not in
@@ -159,7 +176,8 @@ public:
     }
     if (AccessMetric)
       AccessMetric->record(1, "hit");
-    std::unique_ptr<ParsedAST> V = std::move(Existing->second);
+    std::unique_ptr<ParsedAST> V = std::move(Existing->AST);
+    UsedBytes -= Existing->UsedBytes;
     LRU.erase(Existing);
     // GCC 4.8 fails to compile `return V;`, as it tries to call the copy
     // constructor of unique_ptr, so we call the move ctor explicitly to avoid
@@ -168,17 +186,70 @@ public:
   }
 
 private:
-  using KVPair = std::pair<Key, std::unique_ptr<ParsedAST>>;
+  struct Entry {
+    Key K;
+    std::unique_ptr<ParsedAST> AST;
+    std::size_t UsedBytes;
+  };
 
-  std::vector<KVPair>::iterator findByKey(Key K) {
-    return llvm::find_if(LRU, [K](const KVPair &P) { return P.first == K; });
+  std::vector<Entry>::iterator findByKey(Key K) {
+    return llvm::find_if(LRU, [K](const Entry &E) { return E.K == K; });
   }
 
   std::mutex Mut;
   unsigned MaxRetainedASTs;
+  std::size_t MaxRetainedASTBytes;
   /// Items sorted in LRU order, i.e. first item is the most recently accessed
   /// one.
-  std::vector<KVPair> LRU; /* GUARDED_BY(Mut) */
+  std::vector<Entry> LRU; /* GUARDED_BY(Mut) */
+  std::size_t UsedBytes = 0; /* GUARDED_BY(Mut) */
+};
+
+/// An LRU cache of the preambles of closed files.
+/// Reopening a file starts from its retained preamble, which is reused if it
+/// is still compatible with the new inputs, instead of building one from
+/// scratch. Only accessed from the thread calling update() and remove().
+class TUScheduler::PreambleCache {
+public:
+  PreambleCache(unsigned MaxRetainedPreambles)
+      : MaxRetainedPreambles(MaxRetainedPreambles) {}
+
+  /// Store the preamble of \p File, possibly removing the last used one.
+  void put(PathRef File, std::shared_ptr<const PreambleData> Preamble) {
+    if (!Preamble || MaxRetainedPreambles == 0)
+      return;
+    LRU.insert(LRU.begin(), {File.str(), std::move(Preamble)});
+    if (LRU.size() > MaxRetainedPreambles)
+      LRU.pop_back();
+  }
+
+  /// Returns the preamble retained for \p File and removes it from the cache,
+  /// or null if there is none.
+  std::shared_ptr<const PreambleData> take(PathRef File) {
+    auto Existing = llvm::find_if(
+        LRU, [File](const KVPair &P) { return P.first == File; });
+    if (Existing == LRU.end())
+      return nullptr;
+    std::shared_ptr<const PreambleData> V = std::move(Existing->second);
+    LRU.erase(Existing);
+    return V;
+  }
+
+  /// Returns the memory used by retained preambles that are stored in memory.
+  std::size_t getUsedBytes() const {
+    std::size_t Bytes = 0;
+    for (const KVPair &P : LRU)
+      Bytes += P.second->Preamble.getSize();
+    return Bytes;
+  }
+
+private:
+  using KVPair = std::pair<std::string, std::shared_ptr<const PreambleData>>;
+
+  unsigned MaxRetainedPreambles;
+  /// Items sorted in LRU order, i.e. first item is the most recently closed
+  /// one.
+  std::vector<KVPair> LRU;
 };
 
 /// A map from header files to an opened "proxy" file that includes them.
@@ -348,11 +419,14 @@ class PreambleThread {
 public:
   PreambleThread(llvm::StringRef FileName, ParsingCallbacks &Callbacks,
                  bool StorePreambleInMemory, bool RunSync,
+                 std::chrono::steady_clock::duration RebuildDelay,
                  SynchronizedTUStatus &Status,
                  TUScheduler::HeaderIncluderCache &HeaderIncluders,
-                 ASTWorker &AW)
-      : FileName(FileName), Callbacks(Callbacks),
-        StoreInMemory(StorePreambleInMemory), RunSync(RunSync), Status(Status),
+                 ASTWorker &AW,
+                 std::shared_ptr<const PreambleData> RetainedPreamble)
+      : LatestBuild(std::move(RetainedPreamble)), FileName(FileName),
+        Callbacks(Callbacks), StoreInMemory(StorePreambleInMemory),
+        RunSync(RunSync), RebuildDelay(RebuildDelay), Status(Status),
         ASTPeer(AW), HeaderIncluders(HeaderIncluders) {}
 
   /// It isn't guaranteed that each requested version will be built. If there
@@ -477,6 +551,7 @@ private:
   ParsingCallbacks &Callbacks;
   const bool StoreInMemory;
   const bool RunSync;
+  const std::chrono::steady_clock::duration RebuildDelay;
 
   SynchronizedTUStatus &Status;
   ASTWorker &ASTPeer;
@@ -501,7 +576,8 @@ class ASTWorker {
             TUScheduler::ASTCache &LRUCache,
             TUScheduler::HeaderIncluderCache &HeaderIncluders,
             Semaphore &Barrier, bool RunSync, const TUScheduler::Options &Opts,
-            ParsingCallbacks &Callbacks);
+            ParsingCallbacks &Callbacks,
+            std::shared_ptr<const PreambleData> RetainedPreamble);
 
 public:
   /// Create a new ASTWorker and return a handle to it.
@@ -509,12 +585,15 @@ public:
   /// is null, all requests will be processed on the calling thread
   /// synchronously instead. \p Barrier is acquired when processing each
   /// request, it is used to limit the number of actively running threads.
+  /// \p RetainedPreamble, if not null, is reused for the first update if it
+  /// is still compatible with its inputs.
   static ASTWorkerHandle
   create(PathRef FileName, const GlobalCompilationDatabase &CDB,
          TUScheduler::ASTCache &IdleASTs,
          TUScheduler::HeaderIncluderCache &HeaderIncluders,
          AsyncTaskRunner *Tasks, Semaphore &Barrier,
-         const TUScheduler::Options &Opts, ParsingCallbacks &Callbacks);
+         const TUScheduler::Options &Opts, ParsingCallbacks &Callbacks,
+         std::shared_ptr<const PreambleData> RetainedPreamble = nullptr);
   ~ASTWorker();
 
   void update(ParseInputs Inputs, WantDiagnostics, bool ContentChanged);
@@ -710,10 +789,12 @@ ASTWorker::create(PathRef FileName, const GlobalCompilationDatabase &CDB,
                   TUScheduler::HeaderIncluderCache &HeaderIncluders,
                   AsyncTaskRunner *Tasks, Semaphore &Barrier,
                   const TUScheduler::Options &Opts,
-                  ParsingCallbacks &Callbacks) {
+                  ParsingCallbacks &Callbacks,
+                  std::shared_ptr<const PreambleData> RetainedPreamble) {
   std::shared_ptr<ASTWorker> Worker(
       new ASTWorker(FileName, CDB, IdleASTs, HeaderIncluders, Barrier,
-                    /*RunSync=*/!Tasks, Opts, Callbacks));
+                    /*RunSync=*/!Tasks, Opts, Callbacks,
+                    std::move(RetainedPreamble)));
   if (Tasks) {
     Tasks->runAsync("ASTWorker:" + llvm::sys::path::filename(FileName),
                     [Worker]() { Worker->run(); });
@@ -729,13 +810,15 @@ ASTWorker::ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
                      TUScheduler::HeaderIncluderCache &HeaderIncluders,
                      Semaphore &Barrier, bool RunSync,
                      const TUScheduler::Options &Opts,
-                     ParsingCallbacks &Callbacks)
+                     ParsingCallbacks &Callbacks,
+                     std::shared_ptr<const PreambleData> RetainedPreamble)
     : IdleASTs(LRUCache), HeaderIncluders(HeaderIncluders), RunSync(RunSync),
       UpdateDebounce(Opts.UpdateDebounce), FileName(FileName),
       ContextProvider(Opts.ContextProvider), CDB(CDB), Callbacks(Callbacks),
       Barrier(Barrier), Done(false), Status(FileName, Callbacks),
       PreamblePeer(FileName, Callbacks, Opts.StorePreamblesInMemory, RunSync,
-                   Status, HeaderIncluders, *this) {
+                   Opts.PreambleRebuildDelay, Status, HeaderIncluders, *this,
+                   std::move(RetainedPreamble)) {
   // Set a fallback command because compile command can be accessed before
   // `Inputs` is initialized. Other fields are only used after initialization
   // from client inputs.
@@ -919,6 +1002,21 @@ void PreambleThread::build(Request Req) {
          LatestBuild->Version, Inputs.Version, FileName);
     return;
   } else {
+    // Edits to the preamble region tend to come in bursts, e.g. while typing
+    // an #include. Until the rebuild finishes, ASTs are built by patching the
+    // stale preamble, so wait for the edits to settle before paying for it.
+    if (RebuildDelay.count() > 0 && !RunSync &&
+        Req.WantDiags != WantDiagnostics::Yes) {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      if (wait(Lock, ReqCV,
+               Deadline(std::chrono::steady_clock::now() + RebuildDelay),
+               [&] { return NextReq || Done; })) {
+        vlog("Skipping preamble rebuild for {0} version {1}, superseded by a "
+             "newer version",
+             FileName, Inputs.Version);
+        return;
+      }
+    }
     vlog("Rebuilding invalidated preamble for {0} version {1} (previous was "
          "version {2})",
          FileName, Inputs.Version, LatestBuild->Version);
@@ -1451,7 +1549,10 @@ TUScheduler::TUScheduler(const GlobalCompilationDatabase &CDB,
                           : std::make_unique<ParsingCallbacks>()),
       Barrier(Opts.AsyncThreadsCount), QuickRunBarrier(Opts.AsyncThreadsCount),
       IdleASTs(
-          std::make_unique<ASTCache>(Opts.RetentionPolicy.MaxRetainedASTs)),
+          std::make_unique<ASTCache>(Opts.RetentionPolicy.MaxRetainedASTs,
+                                     Opts.RetentionPolicy.MaxRetainedASTBytes)),
+      ClosedPreambles(std::make_unique<PreambleCache>(
+          Opts.RetentionPolicy.MaxRetainedPreambles)),
       HeaderIncluders(std::make_unique<HeaderIncluderCache>()) {
   // Avoid null checks everywhere.
   if (!Opts.ContextProvider) {
@@ -1496,7 +1597,8 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
     ASTWorkerHandle Worker =
         ASTWorker::create(File, CDB, *IdleASTs, *HeaderIncluders,
                           WorkerThreads ? WorkerThreads.getPointer() : nullptr,
-                          Barrier, Opts, *Callbacks);
+                          Barrier, Opts, *Callbacks,
+                          ClosedPreambles->take(File));
     FD = std::unique_ptr<FileData>(
         new FileData{Inputs.Contents, std::move(Worker)});
     ContentChanged = true;
@@ -1509,10 +1611,14 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
 }
 
 void TUScheduler::remove(PathRef File) {
-  bool Removed = Files.erase(File);
-  if (!Removed)
+  auto It = Files.find(File);
+  if (It == Files.end()) {
     elog("Trying to remove file from TUScheduler that is not tracked: {0}",
          File);
+    return;
+  }
+  ClosedPreambles->put(File, It->second->Worker->getPossiblyStalePreamble());
+  Files.erase(It);
   // We don't call HeaderIncluders.remove(File) here.
   // If we did, we'd avoid potentially stale header/mainfile associations.
   // However, it would mean that closing a mainfile could invalidate the
@@ -1670,6 +1776,8 @@ void TUScheduler::profile(MemoryTree &MT) const {
     MT.detail(Elem.first()).child("ast").addUsage(Elem.second.UsedBytesAST);
     MT.child("header_includer_cache").addUsage(HeaderIncluders->getUsedBytes());
   }
+  if (Opts.StorePreamblesInMemory)
+    MT.child("closed_preambles").addUsage(ClosedPreambles->getUsedBytes());
 }
 } // namespace clangd
 } // namespace clang
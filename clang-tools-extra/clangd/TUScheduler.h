@@ -63,6 +63,15 @@ struct ASTRetentionPolicy {
   /// Maximum number of ASTs to be retained in memory when there are no pending
   /// requests for them.
   unsigned MaxRetainedASTs = 3;
+
+  /// Maximum total size in bytes of the idle ASTs retained in memory, as
+  /// reported by ParsedAST::getUsedBytes(). The most recently used AST is
+  /// always retained. 0 means no limit.
+  std::size_t MaxRetainedASTBytes = 0;
+
+  /// Maximum number of preambles to be retained after their files are closed,
+  /// so that reopening a file can reuse its preamble if it is still valid.
+  unsigned MaxRetainedPreambles = 0;
 };
 
 /// Clangd may wait after an update to see if another one comes along.
@@ -193,6 +202,12 @@ public:
     /// This tries to ensure we rebuild once the user stops typing.
     DebouncePolicy UpdateDebounce;
 
+    /// Time to wait before rebuilding an invalidated preamble, to see if
+    /// another update comes along. ASTs are built on top of the stale
+    /// preamble in the meantime. Updates that want diagnostics are not
+    /// delayed.
+    std::chrono::steady_clock::duration PreambleRebuildDelay = {};
+
     /// Determines when to keep idle ASTs in memory for future use.
     ASTRetentionPolicy RetentionPolicy;
 
@@ -307,6 +322,8 @@ public:
   /// Responsible for retaining and rebuilding idle ASTs. An implementation is
   /// an LRU cache.
   class ASTCache;
+  /// Retains the preambles of recently closed files. An LRU cache.
+  class PreambleCache;
   /// Tracks headers included by open files, to get known-good compile commands.
   class HeaderIncluderCache;
 
@@ -331,6 +348,7 @@ private:
   Semaphore QuickRunBarrier;
   llvm::StringMap<std::unique_ptr<FileData>> Files;
   std::unique_ptr<ASTCache> IdleASTs;
+  std::unique_ptr<PreambleCache> ClosedPreambles;
   std::unique_ptr<HeaderIncluderCache> HeaderIncluders;
   // None when running tasks synchronously and non-None when running tasks
   // asynchronously.
@@ -8,6 +8,8 @@
 
 #include "../index/Serialization.h"
 #include "../index/dex/Dex.h"
+#include "../index/dex/Iterator.h"
+#include "../index/dex/PostingList.h"
 #include "benchmark/benchmark.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -95,6 +97,31 @@ static void DexBuild(benchmark::State &State) {
 }
 BENCHMARK(DexBuild);
 
+// Intersects posting lists of synthetic DocIDs, whose density is controlled by
+// the maximum gap between subsequent documents. This measures chunk decoding
+// and advanceTo() without depending on the contents of an index file.
+static void DexPostingListIntersection(benchmark::State &State) {
+  const dex::DocID MaxGap = State.range(0);
+  const dex::DocID NumDocs = 1000000;
+  std::vector<dex::PostingList> Lists;
+  for (dex::DocID Seed = 1; Seed <= 3; ++Seed) {
+    std::vector<dex::DocID> Docs;
+    for (dex::DocID Doc = Seed; Doc < NumDocs;
+         Doc += 1 + (Doc * Seed) % MaxGap)
+      Docs.push_back(Doc);
+    Lists.emplace_back(Docs);
+  }
+  dex::Corpus Corpus(NumDocs);
+  for (auto _ : State) {
+    std::vector<std::unique_ptr<dex::Iterator>> Children;
+    for (const dex::PostingList &L : Lists)
+      Children.push_back(L.iterator());
+    auto And = Corpus.intersect(std::move(Children));
+    benchmark::DoNotOptimize(dex::consume(*And));
+  }
+}
+BENCHMARK(DexPostingListIntersection)->Arg(4)->Arg(64)->Arg(1024);
+
 } // namespace
 } // namespace clangd
 } // namespace clang
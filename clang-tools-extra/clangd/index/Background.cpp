@@ -157,6 +157,7 @@ static llvm::StringRef filenameWithoutExtension(llvm::StringRef Path) {
 
 BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   std::string Tag = filenameWithoutExtension(Path).str();
+  std::string Directory = llvm::sys::path::parent_path(Path).str();
   uint64_t Key = llvm::xxHash64(Path);
   BackgroundQueue::Task T([this, Path(std::move(Path))] {
     llvm::Optional<WithContext> WithProvidedContext;
@@ -170,6 +171,7 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   });
   T.QueuePri = IndexFile;
   T.Tag = std::move(Tag);
+  T.Directory = std::move(Directory);
   T.Key = Key;
   return T;
 }
@@ -177,6 +179,8 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
 void BackgroundIndex::boostRelated(llvm::StringRef Path) {
   if (isHeaderFile(Path))
     Queue.boost(filenameWithoutExtension(Path), IndexBoostedFile);
+  // Files in the same directory are likely to be edited or navigated to next.
+  Queue.boostDirectory(llvm::sys::path::parent_path(Path), IndexNearbyFile);
 }
 
 /// Given index results from a TU, only update symbols coming from files that
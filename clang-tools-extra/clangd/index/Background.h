@@ -76,6 +76,7 @@ public:
     llvm::ThreadPriority ThreadPri = llvm::ThreadPriority::Background;
     unsigned QueuePri = 0; // Higher-priority tasks will run first.
     std::string Tag;       // Allows priority to be boosted later.
+    std::string Directory; // Allows priority to be boosted for nearby files.
     uint64_t Key = 0;      // If the key matches a previous task, drop this one.
                            // (in practice this means we never reindex a file).
 
@@ -100,6 +101,8 @@ public:
   // lower priority.
   // Reducing the boost of a tag affects future tasks but not current ones.
   void boost(llvm::StringRef Tag, unsigned NewPriority);
+  // Likewise, for tasks whose Directory is \p Directory.
+  void boostDirectory(llvm::StringRef Directory, unsigned NewPriority);
 
   // Process items on the queue until the queue is stopped.
   // If the queue becomes empty, OnIdle will be called (on one worker).
@@ -117,6 +120,8 @@ public:
 private:
   void notifyProgress() const; // Requires lock Mu
   bool adjust(Task &T);
+  void boostMatching(llvm::StringMap<unsigned> &Boosts, llvm::StringRef Key,
+                     unsigned NewPriority, std::string Task::*Field);
 
   std::mutex Mu;
   Stats Stat;
@@ -124,6 +129,7 @@ private:
   bool ShouldStop = false;
   std::vector<Task> Queue; // max-heap
   llvm::StringMap<unsigned> Boosts;
+  llvm::StringMap<unsigned> DirectoryBoosts;
   std::function<void(Stats)> OnProgress;
   llvm::DenseSet<uint64_t> SeenKeys;
 };
@@ -160,7 +166,8 @@ public:
   }
 
   /// Boosts priority of indexing related to Path.
-  /// Typically used to index TUs when headers are opened.
+  /// Typically used to index TUs when headers are opened, and the TUs next to
+  /// any opened file before the rest of the project.
   void boostRelated(llvm::StringRef Path);
 
   // Cause background threads to stop after ther current task, any remaining
@@ -215,6 +222,7 @@ private:
   // from lowest to highest priority
   enum QueuePriority {
     IndexFile,
+    IndexNearbyFile,
     IndexBoostedFile,
     LoadShards,
   };
@@ -82,6 +82,7 @@ bool BackgroundQueue::adjust(Task &T) {
   if (T.Key && !SeenKeys.insert(T.Key).second)
     return false;
   T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.Tag));
+  T.QueuePri = std::max(T.QueuePri, DirectoryBoosts.lookup(T.Directory));
   return true;
 }
 
@@ -114,8 +115,19 @@ void BackgroundQueue::append(std::vector<Task> Tasks) {
 }
 
 void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
+  boostMatching(Boosts, Tag, NewPriority, &Task::Tag);
+}
+
+void BackgroundQueue::boostDirectory(llvm::StringRef Directory,
+                                     unsigned NewPriority) {
+  boostMatching(DirectoryBoosts, Directory, NewPriority, &Task::Directory);
+}
+
+void BackgroundQueue::boostMatching(llvm::StringMap<unsigned> &Boosts,
+                                    llvm::StringRef Key, unsigned NewPriority,
+                                    std::string Task::*Field) {
   std::lock_guard<std::mutex> Lock(Mu);
-  unsigned &Boost = Boosts[Tag];
+  unsigned &Boost = Boosts[Key];
   bool Increase = NewPriority > Boost;
   Boost = NewPriority;
   if (!Increase)
@@ -123,7 +135,7 @@ void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
 
   unsigned Changes = 0;
   for (Task &T : Queue)
-    if (Tag == T.Tag && NewPriority > T.QueuePri) {
+    if (Key == T.*Field && NewPriority > T.QueuePri) {
       T.QueuePri = NewPriority;
       ++Changes;
     }
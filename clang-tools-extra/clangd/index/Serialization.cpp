@@ -721,6 +721,9 @@ std::unique_ptr<SymbolIndex> loadIndex(llvm::StringRef SymbolFilename,
       return nullptr;
     }
   }
+  // The slabs own copies of everything they need, so release the file before
+  // building the index to reduce peak memory usage.
+  Buffer->reset();
 
   size_t NumSym = Symbols.size();
   size_t NumRefs = Refs.numRefs();
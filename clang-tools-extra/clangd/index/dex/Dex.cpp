@@ -73,23 +73,33 @@ public:
   }
 
   // Assemble the final compressed posting lists for the added symbols.
-  llvm::DenseMap<Token, PostingList> build() {
+  // The uncompressed lists are released as soon as they are compressed, so
+  // that a large index does not hold both forms at once while loading.
+  llvm::DenseMap<Token, PostingList> build() && {
     llvm::DenseMap<Token, PostingList> Result(/*InitialReserve=*/
                                               TrigramDocs.size() +
                                               RestrictedCCDocs.size() +
                                               TypeDocs.size() +
                                               ScopeDocs.size() +
                                               ProximityDocs.size());
-    for (const auto &E : TrigramDocs)
-      Result.try_emplace(Token(Token::Kind::Trigram, E.first.str()), E.second);
-    for (const auto &E : TypeDocs)
-      Result.try_emplace(Token(Token::Kind::Type, E.first()), E.second);
-    for (const auto &E : ScopeDocs)
-      Result.try_emplace(Token(Token::Kind::Scope, E.first()), E.second);
-    for (const auto &E : ProximityDocs)
-      Result.try_emplace(Token(Token::Kind::ProximityURI, E.first()), E.second);
+    auto Add = [&](Token Tok, std::vector<DocID> &Docs) {
+      Result.try_emplace(std::move(Tok), Docs);
+      std::vector<DocID>().swap(Docs);
+    };
+    for (auto &E : TrigramDocs)
+      Add(Token(Token::Kind::Trigram, E.first.str()), E.second);
+    TrigramDocs.clear();
+    for (auto &E : TypeDocs)
+      Add(Token(Token::Kind::Type, E.first()), E.second);
+    TypeDocs.clear();
+    for (auto &E : ScopeDocs)
+      Add(Token(Token::Kind::Scope, E.first()), E.second);
+    ScopeDocs.clear();
+    for (auto &E : ProximityDocs)
+      Add(Token(Token::Kind::ProximityURI, E.first()), E.second);
+    ProximityDocs.clear();
     if (!RestrictedCCDocs.empty())
-      Result.try_emplace(RestrictedForCodeCompletion, RestrictedCCDocs);
+      Add(RestrictedForCodeCompletion, RestrictedCCDocs);
     return Result;
   }
 };
@@ -122,7 +132,7 @@ void Dex::buildIndex() {
   IndexBuilder Builder;
   for (DocID SymbolRank = 0; SymbolRank < Symbols.size(); ++SymbolRank)
     Builder.add(*Symbols[SymbolRank], SymbolRank);
-  InvertedIndex = Builder.build();
+  InvertedIndex = std::move(Builder).build();
 }
 
 std::unique_ptr<Iterator> Dex::iterator(const Token &Tok) const {
@@ -12,12 +12,15 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MathExtras.h"
+#include <cstring>
 
 namespace clang {
 namespace clangd {
 namespace dex {
 namespace {
 
+void decompressInto(const Chunk &C, llvm::SmallVectorImpl<DocID> &Result);
+
 /// Implements iterator of PostingList chunks. This requires iterating over two
 /// levels: the first level iterator iterates over the chunks and decompresses
 /// them on-the-fly when the contents of chunk are to be seen.
@@ -26,7 +29,7 @@ public:
   explicit ChunkIterator(const Token *Tok, llvm::ArrayRef<Chunk> Chunks)
       : Tok(Tok), Chunks(Chunks), CurrentChunk(Chunks.begin()) {
     if (!Chunks.empty()) {
-      DecompressedChunk = CurrentChunk->decompress();
+      decompressInto(*CurrentChunk, DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -94,7 +97,7 @@ private:
     ++CurrentChunk;
     if (CurrentChunk == Chunks.end()) // Reached the end of PostingList.
       return;
-    DecompressedChunk = CurrentChunk->decompress();
+    decompressInto(*CurrentChunk, DecompressedChunk);
     CurrentID = DecompressedChunk.begin();
   }
 
@@ -106,7 +109,7 @@ private:
           std::partition_point(CurrentChunk + 1, Chunks.end(),
                                [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
-      DecompressedChunk = CurrentChunk->decompress();
+      decompressInto(*CurrentChunk, DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -200,20 +203,49 @@ llvm::Optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
   return Result;
 }
 
-} // namespace
-
-llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
-  llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
+/// Decodes the DocIDs of \p C into \p Result, replacing its contents.
+///
+/// Dense posting lists mostly consist of one-byte deltas, so eight bytes of
+/// payload are examined at a time: if none of them has its continuation bit
+/// set or is the terminating zero, they are eight complete deltas and are
+/// decoded without going through readVByte().
+void decompressInto(const Chunk &C, llvm::SmallVectorImpl<DocID> &Result) {
+  constexpr uint64_t HighBits = 0x8080808080808080;
+  constexpr uint64_t LowBits = 0x0101010101010101;
+  Result.clear();
+  Result.push_back(C.Head);
+  llvm::ArrayRef<uint8_t> Bytes(C.Payload);
+  DocID Current = C.Head;
+  while (!Bytes.empty()) {
+    if (Bytes.size() >= sizeof(uint64_t)) {
+      uint64_t Word;
+      std::memcpy(&Word, Bytes.data(), sizeof(Word));
+      bool HasContinuation = Word & HighBits;
+      // (Word - LowBits) & ~Word & HighBits is non-zero iff a byte is zero.
+      bool HasTerminator = (Word - LowBits) & ~Word & HighBits;
+      if (!HasContinuation && !HasTerminator) {
+        for (size_t I = 0; I < sizeof(uint64_t); ++I) {
+          Current += Bytes[I];
+          Result.push_back(Current);
+        }
+        Bytes = Bytes.drop_front(sizeof(uint64_t));
+        continue;
+      }
+    }
     auto MaybeDelta = readVByte(Bytes);
     if (!MaybeDelta)
       break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+    Current += *MaybeDelta;
+    Result.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+}
+
+} // namespace
+
+llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
+  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result;
+  decompressInto(*this, Result);
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
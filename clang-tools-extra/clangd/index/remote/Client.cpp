@@ -15,13 +15,16 @@
 #include "support/Logger.h"
 #include "support/Trace.h"
 #include "clang/Basic/Version.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 
 #include <atomic>
 #include <chrono>
+#include <list>
 #include <memory>
+#include <mutex>
 
 namespace clang {
 namespace clangd {
@@ -63,6 +66,17 @@ class IndexClient : public clangd::SymbolIndex {
   bool streamRPC(ClangdRequestT Request,
                  StreamingCall<RequestT, ReplyT> RPCCall,
                  CallbackT Callback) const {
+    return streamRPC(std::move(Request), RPCCall, std::move(Callback),
+                     [](const ReplyT &) {});
+  }
+
+  // OnReply is called with each reply that was successfully parsed, before it
+  // is passed to Callback.
+  template <typename RequestT, typename ReplyT, typename ClangdRequestT,
+            typename CallbackT, typename ReplyCallbackT>
+  bool streamRPC(ClangdRequestT Request,
+                 StreamingCall<RequestT, ReplyT> RPCCall, CallbackT Callback,
+                 ReplyCallbackT OnReply) const {
     updateConnectionStatus();
     bool FinalResult = false;
     trace::Span Tracer(RequestT::descriptor()->name());
@@ -93,6 +107,7 @@ class IndexClient : public clangd::SymbolIndex {
         ++FailedToParse;
         continue;
       }
+      OnReply(Reply);
       Callback(*Response);
       ++Successful;
     }
@@ -125,7 +140,28 @@ public:
   void lookup(const clangd::LookupRequest &Request,
               llvm::function_ref<void(const clangd::Symbol &)> Callback)
       const override {
-    streamRPC(Request, &remote::v1::SymbolIndex::Stub::Lookup, Callback);
+    // Features like hover and go-to-definition look up the same few symbols
+    // over and over, so answer from the cache when possible and only send the
+    // remaining IDs to the server.
+    std::vector<remote::v1::Symbol> Cached;
+    clangd::LookupRequest Missing;
+    Missing.IDs = Request.IDs;
+    LookupCache.take(Missing.IDs, Cached);
+    for (const auto &Message : Cached) {
+      auto Sym = ProtobufMarshaller->fromProtobuf(Message);
+      if (!Sym) {
+        // This has been parsed successfully when it was received.
+        llvm::consumeError(Sym.takeError());
+        continue;
+      }
+      Callback(*Sym);
+    }
+    if (Missing.IDs.empty())
+      return;
+    streamRPC(Missing, &remote::v1::SymbolIndex::Stub::Lookup, Callback,
+              [&](const remote::v1::LookupReply &Reply) {
+                LookupCache.put(Reply.stream_result());
+              });
   }
 
   bool fuzzyFind(const clangd::FuzzyFindRequest &Request,
@@ -166,6 +202,76 @@ public:
   size_t estimateMemoryUsage() const override { return 0; }
 
 private:
+  /// Remembers the most recently received symbols, so that repeated lookups
+  /// do not pay for a round trip to the server. Entries expire after a while,
+  /// as the server reloads its index periodically.
+  class SymbolCache {
+  public:
+    SymbolCache(size_t MaxSize, std::chrono::steady_clock::duration MaxAge)
+        : MaxSize(MaxSize), MaxAge(MaxAge) {}
+
+    /// Appends the cached symbols for \p IDs to \p Result, and removes them
+    /// from \p IDs.
+    void take(llvm::DenseSet<SymbolID> &IDs,
+              std::vector<remote::v1::Symbol> &Result) {
+      std::lock_guard<std::mutex> Lock(Mu);
+      auto Now = std::chrono::steady_clock::now();
+      for (auto It = IDs.begin(); It != IDs.end();) {
+        auto Current = It++;
+        auto Found = Index.find(*Current);
+        if (Found == Index.end())
+          continue;
+        auto Entry = Found->second;
+        if (Now - Entry->Time > MaxAge) {
+          Index.erase(Found);
+          Entries.erase(Entry);
+          continue;
+        }
+        // Move the entry to the front, as it is the most recently used one.
+        Entries.splice(Entries.begin(), Entries, Entry);
+        Result.push_back(Entry->Message);
+        IDs.erase(Current);
+      }
+    }
+
+    void put(const remote::v1::Symbol &Message) {
+      auto ID = SymbolID::fromStr(Message.id());
+      if (!ID) {
+        llvm::consumeError(ID.takeError());
+        return;
+      }
+      std::lock_guard<std::mutex> Lock(Mu);
+      auto Now = std::chrono::steady_clock::now();
+      auto Found = Index.find(*ID);
+      if (Found != Index.end()) {
+        Found->second->Message = Message;
+        Found->second->Time = Now;
+        Entries.splice(Entries.begin(), Entries, Found->second);
+        return;
+      }
+      Entries.push_front({*ID, Message, Now});
+      Index[*ID] = Entries.begin();
+      if (Entries.size() > MaxSize) {
+        Index.erase(Entries.back().ID);
+        Entries.pop_back();
+      }
+    }
+
+  private:
+    struct Entry {
+      SymbolID ID;
+      remote::v1::Symbol Message;
+      std::chrono::steady_clock::time_point Time;
+    };
+
+    std::mutex Mu;
+    /// Most recently used entries first.
+    std::list<Entry> Entries;
+    llvm::DenseMap<SymbolID, std::list<Entry>::iterator> Index;
+    const size_t MaxSize;
+    const std::chrono::steady_clock::duration MaxAge;
+  };
+
   std::unique_ptr<remote::v1::SymbolIndex::Stub> Stub;
   std::shared_ptr<grpc::Channel> Channel;
   llvm::SmallString<256> ServerAddress;
@@ -173,6 +279,8 @@ private:
   std::unique_ptr<Marshaller> ProtobufMarshaller;
   // Each request will be terminated if it takes too long.
   std::chrono::milliseconds DeadlineWaitingTime;
+  mutable SymbolCache LookupCache{/*MaxSize=*/1024,
+                                  /*MaxAge=*/std::chrono::minutes(5)};
 };
 
 } // namespace
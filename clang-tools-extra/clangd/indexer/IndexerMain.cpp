@@ -17,12 +17,16 @@
 #include "index/Symbol.h"
 #include "index/SymbolCollector.h"
 #include "support/Logger.h"
+#include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Tooling/ArgumentsAdjusters.h"
 #include "clang/Tooling/CommonOptionsParser.h"
 #include "clang/Tooling/Execution.h"
 #include "clang/Tooling/Tooling.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/xxhash.h"
 
 namespace clang {
 namespace clangd {
@@ -36,6 +40,47 @@ static llvm::cl::opt<IndexFileFormat>
                                        "binary RIFF format")),
            llvm::cl::init(IndexFileFormat::RIFF));
 
+static llvm::cl::opt<unsigned> NumShards(
+    "num-shards",
+    llvm::cl::desc("Split the translation units into this many shards by a "
+                   "hash of their file name, and only index the one selected "
+                   "by --shard. The indexes of all shards can then be "
+                   "combined with --merge"),
+    llvm::cl::init(1));
+
+static llvm::cl::opt<unsigned>
+    Shard("shard",
+          llvm::cl::desc("The shard to index, from 0 to --num-shards - 1"),
+          llvm::cl::init(0));
+
+static llvm::cl::list<std::string> MergeFiles(
+    "merge",
+    llvm::cl::desc("Instead of indexing sources, merge these index files, "
+                   "such as the outputs of --shard runs, into one"),
+    llvm::cl::CommaSeparated);
+
+void mergeSymbols(SymbolSlab::Builder &Symbols, const SymbolSlab &S) {
+  for (const auto &Sym : S) {
+    if (const auto *Existing = Symbols.find(Sym.ID))
+      Symbols.insert(mergeSymbol(*Existing, Sym));
+    else
+      Symbols.insert(Sym);
+  }
+}
+
+void mergeRefs(RefSlab::Builder &Refs, const RefSlab &S) {
+  for (const auto &Sym : S) {
+    // Deduplication happens during insertion.
+    for (const auto &Ref : Sym.second)
+      Refs.insert(Sym.first, Ref);
+  }
+}
+
+void mergeRelations(RelationSlab::Builder &Relations, const RelationSlab &S) {
+  for (const auto &R : S)
+    Relations.insert(R);
+}
+
 class IndexActionFactory : public tooling::FrontendActionFactory {
 public:
   IndexActionFactory(IndexFileIn &Result) : Result(Result) {}
@@ -58,30 +103,32 @@ public:
         [&](SymbolSlab S) {
           // Merge as we go.
           std::lock_guard<std::mutex> Lock(SymbolsMu);
-          for (const auto &Sym : S) {
-            if (const auto *Existing = Symbols.find(Sym.ID))
-              Symbols.insert(mergeSymbol(*Existing, Sym));
-            else
-              Symbols.insert(Sym);
-          }
+          mergeSymbols(Symbols, S);
         },
         [&](RefSlab S) {
           std::lock_guard<std::mutex> Lock(RefsMu);
-          for (const auto &Sym : S) {
-            // Deduplication happens during insertion.
-            for (const auto &Ref : Sym.second)
-              Refs.insert(Sym.first, Ref);
-          }
+          mergeRefs(Refs, S);
         },
         [&](RelationSlab S) {
           std::lock_guard<std::mutex> Lock(RelsMu);
-          for (const auto &R : S) {
-            Relations.insert(R);
-          }
+          mergeRelations(Relations, S);
         },
         /*IncludeGraphCallback=*/nullptr);
   }
 
+  bool runInvocation(std::shared_ptr<CompilerInvocation> Invocation,
+                     FileManager *Files,
+                     std::shared_ptr<PCHContainerOperations> PCHContainerOps,
+                     DiagnosticConsumer *DiagConsumer) override {
+    // Translation units of other shards are skipped without an error.
+    const auto &Inputs = Invocation->getFrontendOpts().Inputs;
+    if (NumShards > 1 && !Inputs.empty() && Inputs.front().isFile() &&
+        llvm::xxHash64(Inputs.front().getFile()) % NumShards != Shard)
+      return true;
+    return FrontendActionFactory::runInvocation(
+        std::move(Invocation), Files, std::move(PCHContainerOps), DiagConsumer);
+  }
+
   // Awkward: we write the result in the destructor, because the executor
   // takes ownership so it's the easiest way to get our data back out.
   ~IndexActionFactory() {
@@ -102,6 +149,68 @@ private:
   RelationSlab::Builder Relations;
 };
 
+// Merges the index files at Paths into Result. The files are read and
+// decoded in parallel, one batch at a time, so that at most a batch of decoded
+// files is alive next to the merged result. They are merged in the order
+// given, so that the result does not depend on timing.
+bool mergeIndexFiles(llvm::ArrayRef<std::string> Paths, IndexFileIn &Result) {
+  size_t BatchSize =
+      std::max(1u, llvm::parallel::strategy.compute_thread_count());
+  std::vector<llvm::Optional<llvm::Expected<IndexFileIn>>> Inputs(
+      std::min(BatchSize, Paths.size()));
+
+  bool Success = true;
+  SymbolSlab::Builder Symbols;
+  RefSlab::Builder Refs;
+  RelationSlab::Builder Relations;
+  for (size_t Begin = 0; Begin < Paths.size(); Begin += BatchSize) {
+    llvm::ArrayRef<std::string> Batch =
+        Paths.slice(Begin, std::min(BatchSize, Paths.size() - Begin));
+    llvm::parallelForEachN(0, Batch.size(), [&](size_t I) {
+      auto Buffer = llvm::MemoryBuffer::getFile(Batch[I]);
+      if (!Buffer)
+        Inputs[I].emplace(llvm::errorCodeToError(Buffer.getError()));
+      else
+        Inputs[I].emplace(readIndexFile((*Buffer)->getBuffer()));
+    });
+
+    for (size_t I = 0; I != Batch.size(); ++I) {
+      llvm::Expected<IndexFileIn> &Input = *Inputs[I];
+      if (!Input) {
+        elog("Failed to load {0}: {1}", Batch[I], Input.takeError());
+        Success = false;
+      } else {
+        if (Input->Symbols)
+          mergeSymbols(Symbols, *Input->Symbols);
+        if (Input->Refs)
+          mergeRefs(Refs, *Input->Refs);
+        if (Input->Relations)
+          mergeRelations(Relations, *Input->Relations);
+      }
+      // Release each shard as soon as it is merged.
+      Inputs[I].reset();
+    }
+  }
+
+  Result.Symbols = std::move(Symbols).build();
+  Result.Refs = std::move(Refs).build();
+  Result.Relations = std::move(Relations).build();
+  return Success;
+}
+
+// Creates the executor selected by --executor from the parsed command line.
+llvm::Expected<std::unique_ptr<tooling::ToolExecutor>>
+createExecutor(tooling::CommonOptionsParser &OptionsParser) {
+  for (const auto &TEPlugin : tooling::ToolExecutorPluginRegistry::entries()) {
+    if (TEPlugin.getName() != tooling::ExecutorName)
+      continue;
+    std::unique_ptr<tooling::ToolExecutorPlugin> Plugin(TEPlugin.instantiate());
+    return Plugin->create(OptionsParser);
+  }
+  return error("Executor \"{0}\" is not registered.",
+               tooling::ExecutorName.getValue());
+}
+
 } // namespace
 } // namespace clangd
 } // namespace clang
@@ -120,24 +229,54 @@ int main(int argc, const char **argv) {
 
   $ clangd-indexer File1.cpp File2.cpp ... FileN.cpp > clangd.dex
 
+  Large projects can be indexed in parts, possibly on different machines, and
+  the parts merged afterwards:
+
+  $ clangd-indexer --executor=all-TUs --num-shards=2 --shard=0 \
+        compile_commands.json > shard0.idx
+  $ clangd-indexer --executor=all-TUs --num-shards=2 --shard=1 \
+        compile_commands.json > shard1.idx
+  $ clangd-indexer --merge=shard0.idx,shard1.idx > clangd.dex
+
   Note: only symbols from header files will be indexed.
   )";
 
-  auto Executor = clang::tooling::createExecutorFromCommandLineArgs(
-      argc, argv, llvm::cl::GeneralCategory, Overview);
-
-  if (!Executor) {
-    llvm::errs() << llvm::toString(Executor.takeError()) << "\n";
+  // Parse the command line once, without creating an executor: --merge
+  // takes no sources, and the executors reject an empty source list.
+  auto OptionsParser = clang::tooling::CommonOptionsParser::create(
+      argc, argv, llvm::cl::GeneralCategory, llvm::cl::ZeroOrMore, Overview);
+  if (!OptionsParser) {
+    llvm::errs() << llvm::toString(OptionsParser.takeError()) << "\n";
     return 1;
   }
 
-  // Collect symbols found in each translation unit, merging as we go.
   clang::clangd::IndexFileIn Data;
-  auto Err = Executor->get()->execute(
-      std::make_unique<clang::clangd::IndexActionFactory>(Data),
-      clang::tooling::getStripPluginsAdjuster());
-  if (Err) {
-    clang::clangd::elog("{0}", std::move(Err));
+  if (!clang::clangd::MergeFiles.empty()) {
+    if (!OptionsParser->getSourcePathList().empty()) {
+      llvm::errs() << "--merge cannot be combined with sources to index\n";
+      return 1;
+    }
+    if (!clang::clangd::mergeIndexFiles(clang::clangd::MergeFiles, Data))
+      return 1;
+  } else {
+    auto Executor = clang::clangd::createExecutor(*OptionsParser);
+    if (!Executor) {
+      llvm::errs() << llvm::toString(Executor.takeError()) << "\n";
+      return 1;
+    }
+    if (clang::clangd::NumShards == 0 ||
+        clang::clangd::Shard >= clang::clangd::NumShards) {
+      llvm::errs() << "--shard must be less than --num-shards\n";
+      return 1;
+    }
+
+    // Collect symbols found in each translation unit, merging as we go.
+    auto Err = Executor->get()->execute(
+        std::make_unique<clang::clangd::IndexActionFactory>(Data),
+        clang::tooling::getStripPluginsAdjuster());
+    if (Err) {
+      clang::clangd::elog("{0}", std::move(Err));
+    }
   }
 
   // Emit collected data.
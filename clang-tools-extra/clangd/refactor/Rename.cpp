@@ -13,7 +13,10 @@
 #include "Selection.h"
 #include "SourceCode.h"
 #include "index/SymbolCollector.h"
+#include "support/Cancellation.h"
+#include "support/Context.h"
 #include "support/Logger.h"
+#include "support/Threading.h"
 #include "support/Trace.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTTypeTraits.h"
@@ -34,6 +37,7 @@
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/JSON.h"
 #include <algorithm>
+#include <atomic>
 
 namespace clang {
 namespace clangd {
@@ -613,44 +617,105 @@ findOccurrencesOutsideFile(const NamedDecl &RenameDecl,
 llvm::Expected<FileEdits>
 renameOutsideFile(const NamedDecl &RenameDecl, llvm::StringRef MainFilePath,
                   llvm::StringRef NewName, const SymbolIndex &Index,
-                  size_t MaxLimitFiles, llvm::vfs::FileSystem &FS) {
+                  size_t MaxLimitFiles, llvm::vfs::FileSystem &FS,
+                  unsigned AsyncThreadsCount) {
   trace::Span Tracer("RenameOutsideFile");
   auto AffectedFiles = findOccurrencesOutsideFile(RenameDecl, MainFilePath,
                                                   Index, MaxLimitFiles);
   if (!AffectedFiles)
     return AffectedFiles.takeError();
-  FileEdits Results;
+  // Read the affected files up front, as the file system may not be
+  // thread-safe.
+  struct AffectedFile {
+    llvm::StringRef Path;
+    std::vector<Range> Occurrences;
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+    llvm::Optional<llvm::Expected<Edit>> Result;
+  };
+  std::vector<AffectedFile> Files;
   for (auto &FileAndOccurrences : *AffectedFiles) {
     llvm::StringRef FilePath = FileAndOccurrences.first();
-
     auto ExpBuffer = FS.getBufferForFile(FilePath);
     if (!ExpBuffer) {
       elog("Fail to read file content: Fail to open file {0}: {1}", FilePath,
            ExpBuffer.getError().message());
       continue;
     }
+    Files.push_back({FilePath, std::move(FileAndOccurrences.second),
+                     std::move(*ExpBuffer), llvm::None});
+  }
 
-    auto AffectedFileCode = (*ExpBuffer)->getBuffer();
-    auto RenameRanges =
-        adjustRenameRanges(AffectedFileCode, RenameDecl.getNameAsString(),
-                           std::move(FileAndOccurrences.second),
-                           RenameDecl.getASTContext().getLangOpts());
-    if (!RenameRanges) {
-      // Our heuristics fails to adjust rename ranges to the current state of
-      // the file, it is most likely the index is stale, so we give up the
-      // entire rename.
-      return error("Index results don't match the content of file {0} "
-                   "(the index may be stale)",
-                   FilePath);
+  // Lexing the affected files to adjust the rename ranges dominates renaming
+  // symbols with many references, and is independent for each file.
+  std::string Identifier = RenameDecl.getNameAsString();
+  const LangOptions &LangOpts = RenameDecl.getASTContext().getLangOpts();
+  std::atomic<size_t> NextFile(0);
+  auto AdjustFiles = [&] {
+    for (size_t I; (I = NextFile++) < Files.size();) {
+      AffectedFile &File = Files[I];
+      if (isCancelled())
+        return;
+      auto AffectedFileCode = File.Buffer->getBuffer();
+      auto RenameRanges = adjustRenameRanges(
+          AffectedFileCode, Identifier, std::move(File.Occurrences), LangOpts);
+      if (!RenameRanges) {
+        // Our heuristics fails to adjust rename ranges to the current state of
+        // the file, it is most likely the index is stale, so we give up the
+        // entire rename.
+        File.Result.emplace(error("Index results don't match the content of "
+                                  "file {0} (the index may be stale)",
+                                  File.Path));
+        continue;
+      }
+      auto RenameEdit =
+          buildRenameEdit(File.Path, AffectedFileCode, *RenameRanges, NewName);
+      if (!RenameEdit) {
+        File.Result.emplace(error("failed to rename in file {0}: {1}",
+                                  File.Path, RenameEdit.takeError()));
+        continue;
+      }
+      File.Result.emplace(std::move(RenameEdit));
+    }
+  };
+  {
+    // The calling thread is one of the workers.
+    AsyncTaskRunner Workers;
+    size_t NumWorkers = std::min<size_t>(AsyncThreadsCount, Files.size());
+    for (size_t I = 1; I < NumWorkers; ++I)
+      Workers.runAsync("rename", [&AdjustFiles,
+                                  Ctx = Context::current().clone()]() mutable {
+        WithContext WithCtx(std::move(Ctx));
+        AdjustFiles();
+      });
+    AdjustFiles();
+  }
+  if (auto Reason = isCancelled()) {
+    // Some of the files may have been adjusted, and their errors have to be
+    // consumed.
+    for (AffectedFile &File : Files)
+      if (File.Result && !*File.Result)
+        llvm::consumeError(File.Result->takeError());
+    return llvm::make_error<CancelledError>(Reason);
+  }
+
+  FileEdits Results;
+  llvm::Error Err = llvm::Error::success();
+  for (AffectedFile &File : Files) {
+    assert(File.Result && "file was not processed");
+    auto &RenameEdit = *File.Result;
+    if (!RenameEdit) {
+      // Report the first failure, but consume all of them.
+      if (!Err)
+        Err = RenameEdit.takeError();
+      else
+        llvm::consumeError(RenameEdit.takeError());
+      continue;
     }
-    auto RenameEdit =
-        buildRenameEdit(FilePath, AffectedFileCode, *RenameRanges, NewName);
-    if (!RenameEdit)
-      return error("failed to rename in file {0}: {1}", FilePath,
-                   RenameEdit.takeError());
     if (!RenameEdit->Replacements.empty())
-      Results.insert({FilePath, std::move(*RenameEdit)});
+      Results.insert({File.Path, std::move(*RenameEdit)});
   }
+  if (Err)
+    return std::move(Err);
   return Results;
 }
 
@@ -777,7 +842,7 @@ llvm::Expected<RenameResult> rename(const RenameInputs &RInputs) {
       RenameDecl, RInputs.MainFilePath, RInputs.NewName, *RInputs.Index,
       Opts.LimitFiles == 0 ? std::numeric_limits<size_t>::max()
                            : Opts.LimitFiles,
-      *RInputs.FS);
+      *RInputs.FS, RInputs.AsyncThreadsCount);
   if (!OtherFilesEdits)
     return OtherFilesEdits.takeError();
   Result.GlobalChanges = *OtherFilesEdits;
@@ -45,6 +45,10 @@ struct RenameInputs {
   const SymbolIndex *Index = nullptr;
 
   RenameOptions Opts = {};
+
+  // The number of threads, including the calling one, that adjust the rename
+  // ranges in the affected files of a cross-file rename.
+  unsigned AsyncThreadsCount = 1;
 };
 
 struct RenameResult {
@@ -359,6 +359,33 @@ opt<PCHStorageFlag> PCHStorage{
     init(PCHStorageFlag::Disk),
 };
 
+opt<unsigned> PreambleRebuildDelay{
+    "preamble-rebuild-delay",
+    cat(Misc),
+    desc("Milliseconds to wait after an edit invalidates a preamble before "
+         "rebuilding it. The stale preamble is used in the meantime"),
+    init(0),
+    Hidden,
+};
+
+opt<unsigned> RetainedASTMemory{
+    "retained-ast-memory",
+    cat(Misc),
+    desc("Maximum memory in megabytes used by the ASTs of files that are not "
+         "being processed. 0 means no limit"),
+    init(0),
+    Hidden,
+};
+
+opt<unsigned> RetainedPreambles{
+    "retained-preambles",
+    cat(Misc),
+    desc("Number of preambles of closed files to keep, so that reopening "
+         "them does not rebuild their preamble"),
+    init(0),
+    Hidden,
+};
+
 opt<bool> Sync{
     "sync",
     cat(Misc),
@@ -783,6 +810,10 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
     Opts.StorePreamblesInMemory = false;
     break;
   }
+  Opts.PreambleRebuildDelay = std::chrono::milliseconds(PreambleRebuildDelay);
+  Opts.RetentionPolicy.MaxRetainedASTBytes =
+      static_cast<std::size_t>(RetainedASTMemory) * 1024 * 1024;
+  Opts.RetentionPolicy.MaxRetainedPreambles = RetainedPreambles;
   if (!ResourceDir.empty())
     Opts.ResourceDir = ResourceDir;
   Opts.BuildDynamicSymbolIndex = true;
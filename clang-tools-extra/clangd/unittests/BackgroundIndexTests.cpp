@@ -822,6 +822,42 @@ TEST(BackgroundQueueTest, Boost) {
   }
 }
 
+TEST(BackgroundQueueTest, BoostDirectory) {
+  std::string Sequence;
+
+  BackgroundQueue::Task A([&] { Sequence.push_back('A'); });
+  A.Directory = "/a";
+  A.QueuePri = 1;
+
+  BackgroundQueue::Task B([&] { Sequence.push_back('B'); });
+  B.Directory = "/b";
+  B.QueuePri = 2;
+
+  {
+    BackgroundQueue Q;
+    Q.boostDirectory("/a", 3);
+    Q.append({A, B});
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("AB", Sequence) << "A was boosted before enqueueing";
+  }
+  Sequence.clear();
+  {
+    BackgroundQueue Q;
+    Q.append({A, B});
+    Q.boostDirectory("/a", 3);
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("AB", Sequence) << "A was boosted after enqueueing";
+  }
+  Sequence.clear();
+  {
+    BackgroundQueue Q;
+    Q.append({A, B});
+    Q.boost("/a", 3);
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("BA", Sequence) << "tags and directories are boosted separately";
+  }
+}
+
 TEST(BackgroundQueueTest, Duplicates) {
   std::string Sequence;
   BackgroundQueue::Task A([&] { Sequence.push_back('A'); });
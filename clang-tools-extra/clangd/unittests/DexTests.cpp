@@ -68,6 +68,21 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, DenseDocumentIterator) {
+  // Mix runs of one-byte deltas with multi-byte ones, so that chunks are
+  // decoded both eight deltas at a time and one delta at a time.
+  std::vector<DocID> Docs;
+  for (DocID Doc = 1; Doc < 5000; Doc += (Doc % 37 == 0) ? 300 : Doc % 5 + 1)
+    Docs.push_back(Doc);
+  const PostingList L(Docs);
+  auto DocIterator = L.iterator();
+  EXPECT_EQ(consumeIDs(*DocIterator), Docs);
+
+  DocIterator = L.iterator();
+  DocIterator->advanceTo(Docs[100] - 1);
+  EXPECT_EQ(DocIterator->peek(), Docs[100]);
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
@@ -13,6 +13,8 @@
 #include "TestTU.h"
 #include "index/Ref.h"
 #include "refactor/Rename.h"
+#include "support/Cancellation.h"
+#include "support/Context.h"
 #include "support/TestTracer.h"
 #include "clang/Tooling/Core/Replacement.h"
 #include "llvm/ADT/STLExtras.h"
@@ -1399,6 +1401,49 @@ TEST(CrossFileRenameTests, DeduplicateRefsFromIndex) {
           Pair(Eq(MainFilePath), Eq(expectedResult(MainCode, NewName)))));
 }
 
+TEST(CrossFileRenameTests, ManyFilesInParallel) {
+  Annotations MainCode("class  [[Fo^o]] {};");
+  auto MainFilePath = testPath("main.cc");
+  llvm::StringRef NewName = "newName";
+  llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemFS =
+      new llvm::vfs::InMemoryFileSystem;
+  FileSymbols FSymbols(IndexContents::All);
+  std::vector<std::pair<std::string, std::string>> Expected;
+  // Every file has different contents, so that the edits can't be mixed up
+  // between the threads.
+  for (unsigned I = 0; I < 16; ++I) {
+    Annotations Code(std::string(I, '\n') + "class [[Foo]] {};");
+    std::string Path = testPath("foo" + std::to_string(I) + ".cc");
+    FSymbols.update(Path, nullptr, buildRefSlab(Code, "Foo", Path), nullptr,
+                    false);
+    InMemFS->addFile(Path, 0,
+                     llvm::MemoryBuffer::getMemBufferCopy(Code.code()));
+    Expected.emplace_back(Path, expectedResult(Code, NewName));
+  }
+  Expected.emplace_back(MainFilePath, expectedResult(MainCode, NewName));
+  auto Index = FSymbols.buildIndex(IndexType::Light);
+
+  TestTU TU = TestTU::withCode(MainCode.code());
+  auto AST = TU.build();
+  RenameInputs Inputs{MainCode.point(), NewName, AST, MainFilePath,
+                      createOverlay(getVFSFromAST(AST), InMemFS), Index.get()};
+  Inputs.AsyncThreadsCount = 4;
+  auto Results = rename(Inputs);
+  ASSERT_TRUE(bool(Results)) << Results.takeError();
+  EXPECT_THAT(applyEdits(std::move(Results->GlobalChanges)),
+              UnorderedElementsAreArray(Expected));
+
+  // A cancelled rename fails, rather than returning partial edits.
+  auto Task = cancelableTask();
+  WithContext Cancelable(std::move(Task.first));
+  Task.second();
+  Results = rename(Inputs);
+  ASSERT_FALSE(bool(Results));
+  llvm::Error Err = Results.takeError();
+  EXPECT_TRUE(Err.isA<CancelledError>());
+  llvm::consumeError(std::move(Err));
+}
+
 TEST(CrossFileRenameTests, WithUpToDateIndex) {
   MockCompilationDatabase CDB;
   CDB.ExtraClangFlags = {"-xc++"};
@@ -632,6 +632,30 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, EvictedASTByMemory) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 3;
+  // Any AST is larger than that, so only the last one should be retained.
+  Opts.RetentionPolicy.MaxRetainedASTBytes = 1;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+
+  updateWithDiags(S, Foo, "int x = 1;", WantDiagnostics::Yes,
+                  [](std::vector<Diag>) {});
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+  ASSERT_THAT(S.getFilesWithCachedAST(), ElementsAre(Foo));
+
+  updateWithDiags(S, Bar, "int x = 2;", WantDiagnostics::Yes,
+                  [](std::vector<Diag>) {});
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+  EXPECT_THAT(S.getFilesWithCachedAST(), ElementsAre(Bar));
+  EXPECT_EQ(S.fileStats().lookup(Foo).UsedBytesAST, 0u);
+  EXPECT_GT(S.fileStats().lookup(Bar).UsedBytesAST, 0u);
+}
+
 // We send "empty" changes to TUScheduler when we think some external event
 // *might* have invalidated current state (e.g. a header was edited).
 // Verify that this doesn't evict our cache entries.
@@ -829,6 +853,83 @@ TEST_F(TUSchedulerTests, NoopOnEmptyChanges) {
   ASSERT_EQ(S.fileStats().lookup(Source).PreambleBuilds, 3u);
 }
 
+TEST_F(TUSchedulerTests, PreambleRebuildDelay) {
+  auto Opts = optsForTest();
+  // Long enough that the delay never expires during the test.
+  Opts.PreambleRebuildDelay = std::chrono::hours(1);
+  TUScheduler S(CDB, Opts, captureDiags());
+
+  auto Source = testPath("foo.cpp");
+  FS.Files[testPath("a.h")] = "int a;";
+  FS.Files[testPath("b.h")] = "int b;";
+  FS.Files[testPath("c.h")] = "int c;";
+
+  // The first preamble is built right away.
+  S.update(Source, getInputs(Source, "#include \"a.h\"\nint x = a;"),
+           WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+  EXPECT_EQ(S.fileStats().lookup(Source).PreambleBuilds, 1u);
+
+  // Rebuilding for the first edit is delayed until it gets superseded by the
+  // second one, which wants diagnostics and so is built right away.
+  S.update(Source,
+           getInputs(Source,
+                     "#include \"a.h\"\n#include \"b.h\"\nint x = a + b;"),
+           WantDiagnostics::Auto);
+  S.update(Source,
+           getInputs(Source,
+                     "#include \"a.h\"\n#include \"c.h\"\nint x = a + c;"),
+           WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+  EXPECT_EQ(S.fileStats().lookup(Source).PreambleBuilds, 2u);
+}
+
+TEST_F(TUSchedulerTests, RetainedPreambles) {
+  class CountPreambles : public ParsingCallbacks {
+  public:
+    CountPreambles(std::atomic<int> &Count) : Count(Count) {}
+    void onPreambleAST(PathRef Path, llvm::StringRef Version, ASTContext &Ctx,
+                       std::shared_ptr<clang::Preprocessor> PP,
+                       const CanonicalIncludes &) override {
+      ++Count;
+    }
+
+  private:
+    std::atomic<int> &Count;
+  };
+
+  auto Opts = optsForTest();
+  Opts.RetentionPolicy.MaxRetainedPreambles = 1;
+  std::atomic<int> PreambleBuilds(0);
+  TUScheduler S(CDB, Opts, std::make_unique<CountPreambles>(PreambleBuilds));
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+  FS.Files[testPath("foo.h")] = "int a;";
+  std::string Contents = "#include \"foo.h\"\nint b = a;";
+
+  auto OpenAndClose = [&](PathRef File) {
+    S.update(File, getInputs(File, Contents), WantDiagnostics::Yes);
+    ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+    S.remove(File);
+  };
+
+  OpenAndClose(Foo);
+  EXPECT_EQ(PreambleBuilds, 1);
+  // Reopening the file reuses its preamble.
+  OpenAndClose(Foo);
+  EXPECT_EQ(PreambleBuilds, 1);
+  // Closing another file evicts it.
+  OpenAndClose(Bar);
+  EXPECT_EQ(PreambleBuilds, 2);
+  OpenAndClose(Foo);
+  EXPECT_EQ(PreambleBuilds, 3);
+  // The retained preamble is not reused once it is out of date.
+  FS.Files[testPath("foo.h")] = "int a = 1;";
+  OpenAndClose(Foo);
+  EXPECT_EQ(PreambleBuilds, 4);
+}
+
 // We rebuild if a completely missing header exists, but not if one is added
 // on a higher-priority include path entry (for performance).
 // (Previously we wouldn't automatically rebuild when files were added).
@@ -0,0 +1,22 @@
+// RUN: clang-tidy -enable-check-profile -checks='-*,readability-function-size,misc-throw-by-value-catch-by-reference' %s -- 2>&1 | FileCheck --match-full-lines -implicit-check-not='{{warning:|error:}}' %s
+
+// CHECK: ===-------------------------------------------------------------------------===
+// CHECK-NEXT:                          clang-tidy checks profiling
+// CHECK-NEXT: ===-------------------------------------------------------------------------===
+
+// Only the check that registers more than one matcher is broken down.
+// CHECK: ===-------------------------------------------------------------------------===
+// CHECK-NEXT:                          clang-tidy matchers profiling
+// CHECK-NEXT: ===-------------------------------------------------------------------------===
+// CHECK: {{.*}}  --- Name ---
+// CHECK-DAG: {{.*}}  misc-throw-by-value-catch-by-reference/0:{{.*}}
+// CHECK-DAG: {{.*}}  misc-throw-by-value-catch-by-reference/1:{{.*}}
+// CHECK-NOT: {{.*}}  readability-function-size/{{.*}}
+// CHECK: {{.*}}  Total
+
+void f() {
+  try {
+    throw 1;
+  } catch (int) {
+  }
+}
@@ -132,6 +132,12 @@ public:
 
       /// Per bucket timing information.
       llvm::StringMap<llvm::TimeRecord> &Records;
+
+      /// If set, receives the time spent in each matcher of the callbacks
+      /// that registered more than one matcher, keyed by
+      /// "<callback ID>/<index>:<node kind>", where index is the position of
+      /// the matcher among those of its callback.
+      llvm::StringMap<llvm::TimeRecord> *MatcherRecords = nullptr;
     };
 
     /// Enables per-check timers.
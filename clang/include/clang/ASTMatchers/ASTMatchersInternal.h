@@ -55,6 +55,7 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/iterator.h"
@@ -298,6 +299,13 @@ public:
   virtual llvm::Optional<clang::TraversalKind> TraversalKind() const {
     return llvm::None;
   }
+
+  /// Returns the names given to \c hasName() or \c hasAnyName() if the
+  /// matcher can only match declarations with one of them, and an empty list
+  /// otherwise.
+  ///
+  /// Lets \c MatchFinder index its toplevel matchers by name.
+  virtual ArrayRef<std::string> requiredNames() const { return None; }
 };
 
 /// Generic interface for matchers on an AST node of type T.
@@ -485,6 +493,13 @@ public:
     return Implementation->TraversalKind();
   }
 
+  /// Returns the names one of which a node must have to be matched, if any.
+  ///
+  /// See \c DynMatcherInterface::requiredNames().
+  ArrayRef<std::string> getRequiredNames() const {
+    return Implementation->requiredNames();
+  }
+
 private:
   DynTypedMatcher(ASTNodeKind SupportedKind, ASTNodeKind RestrictKind,
                   IntrusiveRefCntPtr<DynMatcherInterface> Implementation)
@@ -894,6 +909,8 @@ class HasNameMatcher : public SingleNodeMatcherInterface<NamedDecl> {
 
   bool matchesNode(const NamedDecl &Node) const override;
 
+  ArrayRef<std::string> requiredNames() const override { return Names; }
+
  private:
   /// Unqualified match routine.
   ///
@@ -920,6 +937,16 @@ class HasNameMatcher : public SingleNodeMatcherInterface<NamedDecl> {
   std::vector<std::string> Names;
 };
 
+/// Returns the last component of \p Name, as written in \c hasName().
+///
+/// A \c hasName() pattern can only match declarations whose last name
+/// component, as given by the overload below, is the same.
+StringRef getLastNameComponent(StringRef Name);
+
+/// Returns the last component of the name \c hasName() sees for \p Node.
+StringRef getLastNameComponent(const NamedDecl &Node,
+                               llvm::SmallString<128> &Scratch);
+
 /// Trampoline function to use VariadicFunction<> to construct a
 ///        HasNameMatcher.
 Matcher<NamedDecl> hasAnyNameFunc(ArrayRef<const StringRef *> NameRefs);
@@ -1517,6 +1544,10 @@ public:
       return NestedKind;
     return Traversal;
   }
+
+  ArrayRef<std::string> requiredNames() const override {
+    return this->InnerMatcher.getRequiredNames();
+  }
 };
 
 template <typename MatcherType> class TraversalWrapper {
@@ -476,6 +476,9 @@ public:
 
   BodyFarm &getBodyFarm();
 
+  /// \returns The number of AnalysisDeclContexts currently alive.
+  unsigned getNumContexts() const { return Contexts.size(); }
+
   /// Discard all previously created AnalysisDeclContexts.
   void clear();
 
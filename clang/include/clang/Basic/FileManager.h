@@ -147,6 +147,14 @@ public:
   /// Removes the FileSystemStatCache object from the manager.
   void clearStatCache();
 
+  /// Forget the files and directories that could not be found.
+  ///
+  /// A FileManager that is kept alive across compilations, e.g. by a
+  /// long-running tool, would otherwise keep reporting files as missing after
+  /// they have been created.  Successful lookups are kept, since FileEntryRef
+  /// and DirectoryEntryRef refer to them.
+  void clearFailedLookups();
+
   /// Returns the number of unique real file entries cached by the file manager.
   size_t getNumUniqueRealFiles() const { return UniqueRealFiles.size(); }
 
@@ -203,8 +203,9 @@ private:
                                                      StringRef IndexName,
                                                      bool DisplayCTUProgress);
   template <typename T>
-  const T *findDefInDeclContext(const DeclContext *DC,
-                                StringRef LookupName);
+  const T *findDefInUnit(ASTUnit *Unit, StringRef LookupName);
+  void collectDefsInDeclContext(const DeclContext *DC,
+                                llvm::StringMap<const NamedDecl *> &Defs);
   template <typename T>
   llvm::Expected<const T *> importDefinitionImpl(const T *D, ASTUnit *Unit);
 
@@ -213,6 +214,11 @@ private:
 
   ImporterMapTy ASTUnitImporterMap;
 
+  /// The definitions of each loaded ASTUnit by their lookup names. Built the
+  /// first time a definition is looked up in the unit, so that each further
+  /// lookup does not need to walk the whole AST again.
+  llvm::DenseMap<ASTUnit *, llvm::StringMap<const NamedDecl *>> UnitDefsMap;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
@@ -320,6 +320,26 @@ public:
   /// of three. The inferior process's stdin(0), stdout(1), and stderr(2) will
   /// be redirected to the corresponding paths, if provided (not llvm::None).
   void Redirect(ArrayRef<Optional<StringRef>> Redirects);
+
+private:
+  /// Print \p C if requested by -v or CC_PRINT_OPTIONS.
+  ///
+  /// \return Zero on success, or the result code to report for \p C.
+  int PrintCommand(const Command &C) const;
+
+  /// Report the outcome of running \p C, which returned \p Res.
+  ///
+  /// \return The result code of the subprocess.
+  int FinishCommand(const Command &C, int Res, StringRef Error,
+                    bool ExecutionFailed,
+                    const Command *&FailingCommand) const;
+
+  /// Execute \p Jobs as ExecuteJobs does, running up to \p NumThreads
+  /// independent commands at the same time.
+  void ExecuteJobsInParallel(
+      const JobList &Jobs,
+      SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands,
+      unsigned NumThreads) const;
 };
 
 } // namespace driver
@@ -694,6 +694,10 @@ private:
                           Module *RequestingModule,
                           ModuleMap::KnownHeader *SuggestedModule);
 
+  /// Whether the search directory \p Dir may contain \p Filename, according
+  /// to \c HeaderSearchOptions::DirectoryIndex if there is one.
+  bool mayContainFile(const DirectoryEntry *Dir, StringRef Filename);
+
 public:
   /// Retrieve the module map.
   ModuleMap &getModuleMap() { return ModMap; }
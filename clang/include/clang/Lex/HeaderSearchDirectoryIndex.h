@@ -0,0 +1,58 @@
+//===--- HeaderSearchDirectoryIndex.h - Search Directory Contents -*- C++ -*-=//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the HeaderSearchDirectoryIndex class, which remembers
+//  the contents of header search directories.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_HEADERSEARCHDIRECTORYINDEX_H
+#define LLVM_CLANG_LEX_HEADERSEARCHDIRECTORYINDEX_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include <mutex>
+
+namespace llvm {
+namespace vfs {
+class FileSystem;
+} // namespace vfs
+} // namespace llvm
+
+namespace clang {
+
+/// An index of the entries of header search directories, which lets header
+/// search rule out most of the directories that don't contain a header without
+/// stat'ing the header in each of them.
+///
+/// Each directory is listed the first time it's asked about, and its contents
+/// are assumed not to change while the index is in use. The index is
+/// thread-safe, so that it can be shared by all the compilations of a process
+/// through \c HeaderSearchOptions::DirectoryIndex.
+class HeaderSearchDirectoryIndex {
+public:
+  /// Whether the directory at the absolute path \p Dir may have an entry
+  /// called \p Name.
+  ///
+  /// Names are compared case-insensitively, so that this never rules out a
+  /// header on case-insensitive file systems. If \p Dir can't be listed, it's
+  /// assumed to contain anything.
+  bool mayContain(llvm::vfs::FileSystem &FS, StringRef Dir, StringRef Name);
+
+private:
+  std::mutex Lock;
+  /// The lowercased names of the entries of each directory, or None for the
+  /// ones that couldn't be listed.
+  llvm::StringMap<Optional<llvm::StringSet<>>> Dirs;
+};
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_LEX_HEADERSEARCHDIRECTORYINDEX_H
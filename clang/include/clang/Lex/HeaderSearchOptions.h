@@ -15,12 +15,15 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringRef.h"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
 
 namespace clang {
 
+class HeaderSearchDirectoryIndex;
+
 namespace frontend {
 
 /// IncludeDirGroup - Identifies the group an include Entry belongs to,
@@ -170,6 +173,10 @@ public:
   /// loading.
   uint64_t BuildSessionTimestamp = 0;
 
+  /// The number of threads used to compress the files embedded in a module
+  /// file, or 0 to use all the available hardware threads.
+  unsigned ModulesEmbedCompressionThreads = 1;
+
   /// The set of macro names that should be ignored for the purposes
   /// of computing the module hash.
   llvm::SmallSetVector<llvm::CachedHashString, 16> ModulesIgnoreMacros;
@@ -218,6 +225,13 @@ public:
   /// diagnostics.
   unsigned ModulesStrictContextHash : 1;
 
+  /// The contents of the search directories, if header search should use them
+  /// to avoid looking for headers in directories that can't contain them.
+  ///
+  /// The index may be shared by all the compilations of a process, as long as
+  /// the search directories don't change while it's in use.
+  std::shared_ptr<HeaderSearchDirectoryIndex> DirectoryIndex;
+
   HeaderSearchOptions(StringRef _Sysroot = "/")
       : Sysroot(_Sysroot), ModuleFormat("raw"), DisableModuleHash(false),
         ImplicitModuleMaps(false), ModuleMapFileHomeIsCwd(false),
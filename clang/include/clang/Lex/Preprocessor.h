@@ -2382,6 +2382,14 @@ private:
   Optional<unsigned>
   getSkippedRangeForExcludedConditionalBlock(SourceLocation HashLoc);
 
+  /// Get the file whose excluded conditional blocks can be looked up in and
+  /// added to \c PreprocessorOptions::SkippedRangeCache, if any.
+  const FileEntry *getFileForSkippedRangeCache(FileID FID);
+
+  /// Record in \c PreprocessorOptions::SkippedRangeCache that the excluded
+  /// block whose directive starts at \p HashLoc ends at \p EndHashLoc.
+  void recordSkippedRange(SourceLocation HashLoc, SourceLocation EndHashLoc);
+
   /// Contains the currently active skipped range mappings for skipping excluded
   /// conditional directives.
   ExcludedPreprocessorDirectiveSkipMapping
@@ -30,6 +30,8 @@ class MemoryBuffer;
 
 namespace clang {
 
+class PreprocessorSkippedRangeCache;
+
 /// Enumerate the kinds of standard library that
 enum ObjCXXARCStandardLibraryKind {
   ARCXX_nolib,
@@ -206,6 +208,15 @@ public:
   ExcludedPreprocessorDirectiveSkipMapping
       *ExcludedConditionalDirectiveSkipMappings = nullptr;
 
+  /// The extent of excluded conditional blocks found while preprocessing.
+  ///
+  /// When set, the preprocessor jumps over the excluded blocks this cache
+  /// knows about instead of lexing them, and records the ones it had to lex.
+  /// The pointer may be shared by all the preprocessors of a process, so that
+  /// headers excluded in one translation unit are cheap to exclude in the
+  /// next ones.
+  std::shared_ptr<PreprocessorSkippedRangeCache> SkippedRangeCache;
+
   /// Set up preprocessor for RunAnalysis action.
   bool SetUpStaticAnalyzer = false;
 
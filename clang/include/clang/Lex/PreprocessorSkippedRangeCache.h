@@ -0,0 +1,66 @@
+//===--- PreprocessorSkippedRangeCache.h - Skipped Ranges Cache -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the PreprocessorSkippedRangeCache class, which remembers
+//  the extent of excluded conditional blocks across preprocessor instances.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_PREPROCESSORSKIPPEDRANGECACHE_H
+#define LLVM_CLANG_LEX_PREPROCESSORSKIPPEDRANGECACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "clang/Lex/PreprocessorExcludedConditionalDirectiveSkipMapping.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/Support/FileSystem/UniqueID.h"
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <sys/types.h>
+
+namespace clang {
+
+class FileEntry;
+
+/// Remembers, for each file on disk, how many bytes separate the '#' of a
+/// conditional directive from the '#' of the directive that ends the block it
+/// starts, such as its \#else or \#endif.
+///
+/// The extent of a block only depends on the text of the file, not on the
+/// outcome of any condition, so once a preprocessor has lexed through an
+/// excluded block, any other preprocessor that excludes the same block can
+/// jump over it instead of lexing it again. Files are identified by their
+/// unique ID, and their entries are dropped when their size or modification
+/// time changes.
+///
+/// The cache is thread-safe, so that it can be shared by all the preprocessor
+/// instances of a process through \c PreprocessorOptions::SkippedRangeCache.
+class PreprocessorSkippedRangeCache {
+public:
+  /// Get the number of bytes from the '#' at \p Offset in \p File to the '#'
+  /// of the directive ending the block, if known.
+  Optional<unsigned> lookup(const FileEntry &File, unsigned Offset);
+
+  /// Record that the block started by the '#' at \p Offset in \p File ends
+  /// \p Length bytes later.
+  void insert(const FileEntry &File, unsigned Offset, unsigned Length);
+
+private:
+  struct FileRanges {
+    off_t Size = 0;
+    time_t ModTime = 0;
+    PreprocessorSkippedRangeMapping Ranges;
+  };
+
+  std::mutex Lock;
+  std::map<llvm::sys::fs::UniqueID, FileRanges> Files;
+};
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_LEX_PREPROCESSORSKIPPEDRANGECACHE_H
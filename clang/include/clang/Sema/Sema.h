@@ -1381,6 +1381,15 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of class and function template instantiations performed.
+  unsigned NumClassInstantiations = 0;
+  unsigned NumFunctionInstantiations = 0;
+
+  /// The number of function template instantiations whose definition was
+  /// already available from an AST file, such as a PCH built with
+  /// -fpch-instantiate-templates, and so did not need to be instantiated.
+  unsigned NumFunctionInstantiationsFromAST = 0;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
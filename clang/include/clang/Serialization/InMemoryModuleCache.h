@@ -13,10 +13,48 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <ctime>
 #include <memory>
+#include <mutex>
+#include <sys/types.h>
 
 namespace clang {
 
+/// Thread-safe cache of PCM file contents, shared between the
+/// InMemoryModuleCaches of the compilations run by one process, such as the
+/// workers of a dependency scanning service.
+///
+/// Buffers are keyed by file name together with the size and modification
+/// time of the file they were read from.  Those are the same properties
+/// ModuleManager checks to decide whether a module file is out of date, so a
+/// PCM that gets rebuilt on disk is read again rather than served stale.
+class SharedModuleBufferCache
+    : public llvm::ThreadSafeRefCountedBase<SharedModuleBufferCache> {
+  struct Entry {
+    off_t Size;
+    time_t ModTime;
+    std::shared_ptr<llvm::MemoryBuffer> Buffer;
+  };
+
+  llvm::StringMap<Entry> Buffers;
+  mutable std::mutex Lock;
+
+public:
+  /// Get the buffer for \p Filename if it was read from a file with the given
+  /// size and modification time; else nullptr.
+  std::shared_ptr<llvm::MemoryBuffer>
+  lookup(llvm::StringRef Filename, off_t Size, time_t ModTime) const;
+
+  /// Store the contents of \p Filename as read from a file with the given
+  /// size and modification time, replacing any buffer of an older version.
+  ///
+  /// \return the cached buffer, which is not \p Buffer if another thread
+  /// stored the same version first.
+  std::shared_ptr<llvm::MemoryBuffer>
+  insert(llvm::StringRef Filename, off_t Size, time_t ModTime,
+         std::unique_ptr<llvm::MemoryBuffer> Buffer);
+};
+
 /// In-memory cache for modules.
 ///
 /// This is a cache for modules for use across a compilation, sharing state
@@ -29,7 +67,7 @@ namespace clang {
 /// each \a ModuleManager sees the same files.
 class InMemoryModuleCache : public llvm::RefCountedBase<InMemoryModuleCache> {
   struct PCM {
-    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+    std::shared_ptr<llvm::MemoryBuffer> Buffer;
 
     /// Track whether this PCM is known to be good (either built or
     /// successfully imported by a CompilerInstance/ASTReader using this
@@ -37,13 +75,16 @@ class InMemoryModuleCache : public llvm::RefCountedBase<InMemoryModuleCache> {
     bool IsFinal = false;
 
     PCM() = default;
-    PCM(std::unique_ptr<llvm::MemoryBuffer> Buffer)
+    PCM(std::shared_ptr<llvm::MemoryBuffer> Buffer)
         : Buffer(std::move(Buffer)) {}
   };
 
   /// Cache of buffers.
   llvm::StringMap<PCM> PCMs;
 
+  /// Contents of PCM files shared with other compilations, if any.
+  llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> SharedBuffers;
+
 public:
   /// There are four states for a PCM.  It must monotonically increase.
   ///
@@ -67,6 +108,14 @@ public:
   llvm::MemoryBuffer &addPCM(llvm::StringRef Filename,
                              std::unique_ptr<llvm::MemoryBuffer> Buffer);
 
+  /// Store a PCM whose buffer is shared with other caches under the Filename.
+  ///
+  /// \pre state is Unknown
+  /// \post state is Tentative
+  /// \return a reference to the buffer as a convenience.
+  llvm::MemoryBuffer &addPCM(llvm::StringRef Filename,
+                             std::shared_ptr<llvm::MemoryBuffer> Buffer);
+
   /// Store a just-built PCM under the Filename.
   ///
   /// \pre state is Unknown or ToBuild.
@@ -100,6 +149,18 @@ public:
   ///
   /// \return true iff state is ToBuild.
   bool shouldBuildPCM(llvm::StringRef Filename) const;
+
+  /// Share the contents of PCM files read from disk with other compilations
+  /// using \p Buffers.
+  void setSharedBuffers(llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> B) {
+    SharedBuffers = std::move(B);
+  }
+
+  /// Get the cache of PCM file contents shared with other compilations, if
+  /// any; else nullptr.
+  SharedModuleBufferCache *getSharedBuffers() const {
+    return SharedBuffers.get();
+  }
 };
 
 } // end namespace clang
@@ -46,9 +46,13 @@ public:
   /// mismatching size of the file. If file is not minimized, the full file is
   /// read and copied into memory to ensure that it's not memory mapped to avoid
   /// running out of file descriptors.
-  static CachedFileSystemEntry createFileEntry(StringRef Filename,
-                                               llvm::vfs::FileSystem &FS,
-                                               bool Minimize = true);
+  ///
+  /// If \p PersistentCacheDir is not empty, minimized contents are looked up
+  /// in and added to the on-disk cache in that directory, see
+  /// DependencyScanningFilesystemSharedCache::setPersistentCacheDir.
+  static CachedFileSystemEntry
+  createFileEntry(StringRef Filename, llvm::vfs::FileSystem &FS,
+                  bool Minimize = true, StringRef PersistentCacheDir = "");
 
   /// Create an entry that represents a directory on the filesystem.
   static CachedFileSystemEntry createDirectoryEntry(llvm::vfs::Status &&Stat);
@@ -122,6 +126,17 @@ public:
   /// thread safe call.
   SharedFileSystemEntry &get(StringRef Key);
 
+  /// Keep the minimized contents of source files in \p Dir as well, so that
+  /// they outlive this cache.
+  ///
+  /// Entries are keyed by a hash and the size of the original contents rather
+  /// than by file name and modification time, so they stay valid for fresh
+  /// checkouts of the same sources.
+  void setPersistentCacheDir(StringRef Dir) { PersistentCacheDir = Dir.str(); }
+
+  /// The directory minimized contents are kept in, or empty if none.
+  StringRef getPersistentCacheDir() const { return PersistentCacheDir; }
+
 private:
   struct CacheShard {
     std::mutex CacheLock;
@@ -129,6 +144,7 @@ private:
   };
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::string PersistentCacheDir;
 };
 
 /// A virtual file system optimized for the dependency discovery.
@@ -9,12 +9,18 @@
 #ifndef LLVM_CLANG_TOOLING_DEPENDENCY_SCANNING_SERVICE_H
 #define LLVM_CLANG_TOOLING_DEPENDENCY_SCANNING_SERVICE_H
 
+#include "clang/Serialization/InMemoryModuleCache.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "llvm/ADT/StringMap.h"
+#include <memory>
+#include <mutex>
 
 namespace clang {
 namespace tooling {
 namespace dependencies {
 
+struct ModuleDeps;
+
 /// The mode in which the dependency scanner will operate to find the
 /// dependencies.
 enum class ScanningMode {
@@ -42,6 +48,26 @@ enum class ScanningOutputFormat {
   Full,
 };
 
+/// The dependencies of the modules discovered by any of the workers of a
+/// service, so that each module's input files are only visited once.
+///
+/// Modules are identified by their context hash and name, which determine the
+/// PCM that describes them.
+class SharedModuleDepsCache {
+public:
+  /// \returns the recorded dependencies of the given module, or null.
+  std::shared_ptr<const ModuleDeps> lookup(StringRef ContextHash,
+                                           StringRef ModuleName);
+
+  /// Record the dependencies of module \p MD, keeping the existing entry if
+  /// another worker got there first.
+  void insert(const ModuleDeps &MD);
+
+private:
+  std::mutex Lock;
+  llvm::StringMap<std::shared_ptr<const ModuleDeps>> Entries;
+};
+
 /// The dependency scanning service contains the shared state that is used by
 /// the invidual dependency scanning workers.
 class DependencyScanningService {
@@ -62,6 +88,12 @@ public:
     return SharedCache;
   }
 
+  llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> getSharedModuleBuffers() {
+    return SharedModuleBuffers;
+  }
+
+  SharedModuleDepsCache &getSharedModuleDeps() { return SharedModuleDeps; }
+
 private:
   const ScanningMode Mode;
   const ScanningOutputFormat Format;
@@ -72,6 +104,10 @@ private:
   const bool SkipExcludedPPRanges;
   /// The global file system cache.
   DependencyScanningFilesystemSharedCache SharedCache;
+  /// The contents of the PCM files read by the workers.
+  llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> SharedModuleBuffers;
+  /// The dependencies of the modules discovered by the workers.
+  SharedModuleDepsCache SharedModuleDeps;
 };
 
 } // end namespace dependencies
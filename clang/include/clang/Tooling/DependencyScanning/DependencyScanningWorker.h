@@ -76,6 +76,10 @@ private:
   /// The file manager that is reused accross multiple invocations by this
   /// worker. If null, the file manager will not be reused.
   llvm::IntrusiveRefCntPtr<FileManager> Files;
+  /// The contents of PCM files, shared with the other workers of the service.
+  llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> ModuleBuffers;
+  /// The module dependencies, shared with the other workers of the service.
+  SharedModuleDepsCache &ModuleDeps;
   ScanningOutputFormat Format;
 };
 
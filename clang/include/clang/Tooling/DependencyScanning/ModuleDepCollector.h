@@ -27,6 +27,7 @@ namespace tooling {
 namespace dependencies {
 
 class DependencyConsumer;
+class SharedModuleDepsCache;
 
 /// This is used to refer to a specific module.
 ///
@@ -141,7 +142,8 @@ private:
 class ModuleDepCollector final : public DependencyCollector {
 public:
   ModuleDepCollector(std::unique_ptr<DependencyOutputOptions> Opts,
-                     CompilerInstance &I, DependencyConsumer &C);
+                     CompilerInstance &I, DependencyConsumer &C,
+                     SharedModuleDepsCache &SharedDeps);
 
   void attachToPreprocessor(Preprocessor &PP) override;
   void attachToASTReader(ASTReader &R) override;
@@ -151,6 +153,8 @@ private:
 
   CompilerInstance &Instance;
   DependencyConsumer &Consumer;
+  /// The modules already discovered by other translation units.
+  SharedModuleDepsCache &SharedDeps;
   std::string MainFile;
   std::string ContextHash;
   std::vector<std::string> MainDeps;
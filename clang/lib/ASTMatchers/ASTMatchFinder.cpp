@@ -20,6 +20,7 @@
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Timer.h"
 #include <deque>
@@ -405,10 +406,27 @@ class MatchASTVisitor : public RecursiveASTVisitor<MatchASTVisitor>,
 public:
   MatchASTVisitor(const MatchFinder::MatchersByType *Matchers,
                   const MatchFinder::MatchFinderOptions &Options)
-      : Matchers(Matchers), Options(Options), ActiveASTContext(nullptr) {}
+      : Matchers(Matchers), Options(Options), ActiveASTContext(nullptr) {
+    // Create all the buckets up front: the map must not grow while a
+    // TimeBucketRegion points into it.
+    if (Options.CheckProfiling) {
+      auto AddBuckets = [&](const auto &List) {
+        for (const auto &MP : List)
+          TimeByMatcher[&MP];
+      };
+      AddBuckets(Matchers->DeclOrStmt);
+      AddBuckets(Matchers->Type);
+      AddBuckets(Matchers->NestedNameSpecifier);
+      AddBuckets(Matchers->NestedNameSpecifierLoc);
+      AddBuckets(Matchers->TypeLoc);
+      AddBuckets(Matchers->CtorInit);
+      AddBuckets(Matchers->TemplateArgumentLoc);
+    }
+  }
 
   ~MatchASTVisitor() override {
     if (Options.CheckProfiling) {
+      collectMatcherTimes();
       Options.CheckProfiling->Records = std::move(TimeByBucket);
     }
   }
@@ -802,6 +820,14 @@ private:
     llvm::TimeRecord *Bucket;
   };
 
+  /// The toplevel \c Decl and \c Stmt matchers to try on a node kind.
+  struct MatcherFilter {
+    /// Matchers to try on every node of the kind.
+    std::vector<unsigned short> Unnamed;
+    /// Matchers to try on the declarations with a given last name component.
+    llvm::StringMap<std::vector<unsigned short>> ByName;
+  };
+
   /// Runs all the \p Matchers on \p Node.
   ///
   /// Used by \c matchDispatch() below.
@@ -811,7 +837,7 @@ private:
     TimeBucketRegion Timer;
     for (const auto &MP : Matchers) {
       if (EnableCheckProfiling)
-        Timer.setBucket(&TimeByBucket[MP.second->getID()]);
+        Timer.setBucket(&TimeByMatcher[&MP]);
       BoundNodesTreeBuilder Builder;
       if (MP.first.matches(Node, this, &Builder)) {
         MatchVisitor Visitor(ActiveASTContext, MP.second);
@@ -826,16 +852,32 @@ private:
     const auto &Filter =
         it != MatcherFiltersMap.end() ? it->second : getFilterForKind(Kind);
 
-    if (Filter.empty())
+    ArrayRef<unsigned short> Indices = Filter.Unnamed;
+    llvm::SmallVector<unsigned short, 32> Merged;
+    if (!Filter.ByName.empty()) {
+      llvm::SmallString<128> Scratch;
+      auto NamedIt = Filter.ByName.find(getLastNameComponent(
+          *DynNode.get<NamedDecl>(), Scratch));
+      if (NamedIt != Filter.ByName.end()) {
+        // Keep the matchers in the order they were added.
+        const std::vector<unsigned short> &Named = NamedIt->second;
+        Merged.resize(Indices.size() + Named.size());
+        std::merge(Indices.begin(), Indices.end(), Named.begin(), Named.end(),
+                   Merged.begin());
+        Indices = Merged;
+      }
+    }
+
+    if (Indices.empty())
       return;
 
     const bool EnableCheckProfiling = Options.CheckProfiling.hasValue();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
-    for (unsigned short I : Filter) {
+    for (unsigned short I : Indices) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
-        Timer.setBucket(&TimeByBucket[MP.second->getID()]);
+        Timer.setBucket(&TimeByMatcher[&MP]);
       BoundNodesTreeBuilder Builder;
 
       {
@@ -852,13 +894,27 @@ private:
     }
   }
 
-  const std::vector<unsigned short> &getFilterForKind(ASTNodeKind Kind) {
+  const MatcherFilter &getFilterForKind(ASTNodeKind Kind) {
     auto &Filter = MatcherFiltersMap[Kind];
     auto &Matchers = this->Matchers->DeclOrStmt;
     assert((Matchers.size() < USHRT_MAX) && "Too many matchers.");
+    const bool IsNamed =
+        ASTNodeKind::getFromNodeKind<NamedDecl>().isBaseOf(Kind);
     for (unsigned I = 0, E = Matchers.size(); I != E; ++I) {
-      if (Matchers[I].first.canMatchNodesOfKind(Kind)) {
-        Filter.push_back(I);
+      if (!Matchers[I].first.canMatchNodesOfKind(Kind))
+        continue;
+      ArrayRef<std::string> Names;
+      if (IsNamed)
+        Names = Matchers[I].first.getRequiredNames();
+      if (Names.empty()) {
+        Filter.Unnamed.push_back(I);
+        continue;
+      }
+      for (StringRef Name : Names) {
+        auto &Named = Filter.ByName[getLastNameComponent(Name)];
+        // Several names of the same matcher can share a last component.
+        if (Named.empty() || Named.back() != I)
+          Named.push_back(I);
       }
     }
     return Filter;
@@ -1081,11 +1137,61 @@ private:
     return false;
   }
 
+  /// Folds the time spent in each matcher into the bucket of its callback,
+  /// and reports it per matcher if requested.
+  void collectMatcherTimes() {
+    llvm::DenseMap<MatchCallback *, unsigned> NumMatchers;
+    auto Count = [&](const auto &List) {
+      for (const auto &MP : List)
+        ++NumMatchers[MP.second];
+    };
+    Count(Matchers->DeclOrStmt);
+    Count(Matchers->Type);
+    Count(Matchers->NestedNameSpecifier);
+    Count(Matchers->NestedNameSpecifierLoc);
+    Count(Matchers->TypeLoc);
+    Count(Matchers->CtorInit);
+    Count(Matchers->TemplateArgumentLoc);
+
+    auto *MatcherRecords = Options.CheckProfiling->MatcherRecords;
+    llvm::DenseMap<MatchCallback *, unsigned> NextIndex;
+    auto Collect = [&](const auto &List) {
+      for (const auto &MP : List) {
+        unsigned Index = NextIndex[MP.second]++;
+        auto It = TimeByMatcher.find(&MP);
+        if (It == TimeByMatcher.end())
+          continue;
+        // Leave out the matchers that took no time, such as the ones that
+        // never ran and only have the bucket created up front.
+        if (It->second.getWallTime() == 0.0 &&
+            It->second.getProcessTime() == 0.0)
+          continue;
+        TimeByBucket[MP.second->getID()] += It->second;
+        if (MatcherRecords && NumMatchers[MP.second] > 1)
+          (*MatcherRecords)[(MP.second->getID() + "/" + Twine(Index) + ":" +
+                             MP.first.getID().first.asStringRef())
+                                .str()] += It->second;
+      }
+    };
+    Collect(Matchers->DeclOrStmt);
+    Collect(Matchers->Type);
+    Collect(Matchers->NestedNameSpecifier);
+    Collect(Matchers->NestedNameSpecifierLoc);
+    Collect(Matchers->TypeLoc);
+    Collect(Matchers->CtorInit);
+    Collect(Matchers->TemplateArgumentLoc);
+  }
+
   /// Bucket to record map.
   ///
-  /// Used to get the appropriate bucket for each matcher.
+  /// Used to get the appropriate bucket for each callback.
   llvm::StringMap<llvm::TimeRecord> TimeByBucket;
 
+  /// Time spent in each matcher, keyed by its entry in \c Matchers. Lookups
+  /// by address keep the hashing of callback IDs out of the matching loops.
+  /// All the entries are created by the constructor.
+  llvm::DenseMap<const void *, llvm::TimeRecord> TimeByMatcher;
+
   const MatchFinder::MatchersByType *Matchers;
 
   /// Filtered list of matcher indices for each matcher kind.
@@ -1094,7 +1200,10 @@ private:
   /// kind (and derived kinds) so it is a waste to try every matcher on every
   /// node.
   /// We precalculate a list of matchers that pass the toplevel restrict check.
-  llvm::DenseMap<ASTNodeKind, std::vector<unsigned short>> MatcherFiltersMap;
+  /// Matchers that only accept declarations with some names, like
+  /// \c functionDecl(hasName("f")), are further bucketed by name, so tools
+  /// with many of them only try the few that can match a given declaration.
+  llvm::DenseMap<ASTNodeKind, MatcherFilter> MatcherFiltersMap;
 
   const MatchFinder::MatchFinderOptions &Options;
   ASTContext *ActiveASTContext;
@@ -123,6 +123,19 @@ public:
     return Func(DynNode, Finder, Builder, InnerMatchers);
   }
 
+  ArrayRef<std::string> requiredNames() const override {
+    // Every inner matcher of an allOf() has to match, so any of their name
+    // requirements holds for the whole matcher.
+    if (Func != allOfVariadicOperator)
+      return None;
+    for (const DynTypedMatcher &InnerMatcher : InnerMatchers) {
+      ArrayRef<std::string> Names = InnerMatcher.getRequiredNames();
+      if (!Names.empty())
+        return Names;
+    }
+    return None;
+  }
+
 private:
   std::vector<DynTypedMatcher> InnerMatchers;
 };
@@ -144,6 +157,10 @@ public:
     return InnerMatcher->TraversalKind();
   }
 
+  ArrayRef<std::string> requiredNames() const override {
+    return InnerMatcher->requiredNames();
+  }
+
 private:
   const std::string ID;
   const IntrusiveRefCntPtr<DynMatcherInterface> InnerMatcher;
@@ -180,6 +197,10 @@ public:
     return TK;
   }
 
+  ArrayRef<std::string> requiredNames() const override {
+    return InnerMatcher->requiredNames();
+  }
+
 private:
   clang::TraversalKind TK;
   IntrusiveRefCntPtr<DynMatcherInterface> InnerMatcher;
@@ -522,6 +543,16 @@ static StringRef getNodeName(const NamespaceDecl &Node,
   return Node.isAnonymousNamespace() ? "(anonymous namespace)" : Node.getName();
 }
 
+StringRef getLastNameComponent(StringRef Name) {
+  size_t Pos = Name.rfind("::");
+  return Pos == StringRef::npos ? Name : Name.drop_front(Pos + 2);
+}
+
+StringRef getLastNameComponent(const NamedDecl &Node,
+                               llvm::SmallString<128> &Scratch) {
+  return getLastNameComponent(getNodeName(Node, Scratch));
+}
+
 namespace {
 
 class PatternSet {
@@ -67,6 +67,19 @@ void FileManager::setStatCache(std::unique_ptr<FileSystemStatCache> statCache) {
 
 void FileManager::clearStatCache() { StatCache.reset(); }
 
+void FileManager::clearFailedLookups() {
+  for (auto I = SeenFileEntries.begin(), E = SeenFileEntries.end(); I != E;) {
+    auto Current = I++;
+    if (!Current->second)
+      SeenFileEntries.erase(Current);
+  }
+  for (auto I = SeenDirEntries.begin(), E = SeenDirEntries.end(); I != E;) {
+    auto Current = I++;
+    if (!Current->second)
+      SeenDirEntries.erase(Current);
+  }
+}
+
 /// Retrieve the directory that the given file name resides in.
 /// Filename can point to either a real file or a virtual file.
 static llvm::Expected<DirectoryEntryRef>
@@ -507,6 +507,8 @@ static bool initTargetOptions(DiagnosticsEngine &Diags,
   Options.UseInitArray = CodeGenOpts.UseInitArray;
   Options.DisableIntegratedAS = CodeGenOpts.DisableIntegratedAS;
   Options.CompressDebugSections = CodeGenOpts.getCompressDebugSections();
+  Options.CompressDebugSectionsThreads =
+      CodeGenOpts.CompressDebugSectionsThreads;
   Options.RelaxELFRelocations = CodeGenOpts.RelaxELFRelocations;
 
   // Set EABI version.
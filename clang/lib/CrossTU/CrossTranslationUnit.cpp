@@ -222,29 +222,46 @@ CrossTranslationUnitContext::getLookupName(const NamedDecl *ND) {
   return std::string(DeclUSR.str());
 }
 
-/// Recursively visits the decls of a DeclContext, and returns one with the
-/// given USR.
-template <typename T>
-const T *
-CrossTranslationUnitContext::findDefInDeclContext(const DeclContext *DC,
-                                                  StringRef LookupName) {
+/// Recursively visits the decls of a DeclContext, and records the function
+/// and variable definitions by their USRs. The first definition visited wins.
+void CrossTranslationUnitContext::collectDefsInDeclContext(
+    const DeclContext *DC, llvm::StringMap<const NamedDecl *> &Defs) {
   assert(DC && "Declaration Context must not be null");
   for (const Decl *D : DC->decls()) {
-    const auto *SubDC = dyn_cast<DeclContext>(D);
-    if (SubDC)
-      if (const auto *ND = findDefInDeclContext<T>(SubDC, LookupName))
-        return ND;
-
-    const auto *ND = dyn_cast<T>(D);
-    const T *ResultDecl;
-    if (!ND || !hasBodyOrInit(ND, ResultDecl))
-      continue;
-    llvm::Optional<std::string> ResultLookupName = getLookupName(ResultDecl);
-    if (!ResultLookupName || *ResultLookupName != LookupName)
+    if (const auto *SubDC = dyn_cast<DeclContext>(D))
+      collectDefsInDeclContext(SubDC, Defs);
+
+    const NamedDecl *ResultDecl = nullptr;
+    if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+      const FunctionDecl *DefD;
+      if (hasBodyOrInit(FD, DefD))
+        ResultDecl = DefD;
+    } else if (const auto *VD = dyn_cast<VarDecl>(D)) {
+      const VarDecl *DefD;
+      if (hasBodyOrInit(VD, DefD))
+        ResultDecl = DefD;
+    }
+    if (!ResultDecl)
       continue;
-    return ResultDecl;
+    if (llvm::Optional<std::string> ResultLookupName =
+            getLookupName(ResultDecl))
+      Defs.try_emplace(*ResultLookupName, ResultDecl);
+  }
+}
+
+template <typename T>
+const T *CrossTranslationUnitContext::findDefInUnit(ASTUnit *Unit,
+                                                    StringRef LookupName) {
+  auto It = UnitDefsMap.find(Unit);
+  if (It == UnitDefsMap.end()) {
+    It = UnitDefsMap.try_emplace(Unit).first;
+    collectDefsInDeclContext(Unit->getASTContext().getTranslationUnitDecl(),
+                             It->second);
   }
-  return nullptr;
+  auto DefIt = It->second.find(LookupName);
+  if (DefIt == It->second.end())
+    return nullptr;
+  return dyn_cast<T>(DefIt->second);
 }
 
 template <typename T>
@@ -315,8 +332,7 @@ llvm::Expected<const T *> CrossTranslationUnitContext::getCrossTUDefinitionImpl(
         index_error_code::lang_dialect_mismatch);
   }
 
-  TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
-  if (const T *ResultDecl = findDefInDeclContext<T>(TU, *LookupName))
+  if (const T *ResultDecl = findDefInUnit<T>(Unit, *LookupName))
     return importDefinition(ResultDecl, Unit);
   return llvm::make_error<IndexError>(index_error_code::failed_import);
 }
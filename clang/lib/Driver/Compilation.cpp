@@ -18,11 +18,14 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptSpecifier.h"
 #include "llvm/Option/Option.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <string>
@@ -161,8 +164,7 @@ bool Compilation::CleanupFileMap(const ArgStringMap &Files,
   return Success;
 }
 
-int Compilation::ExecuteCommand(const Command &C,
-                                const Command *&FailingCommand) const {
+int Compilation::PrintCommand(const Command &C) const {
   if ((getDriver().CCPrintOptions ||
        getArgs().hasArg(options::OPT_v)) && !getDriver().CCGenDiagnostics) {
     raw_ostream *OS = &llvm::errs();
@@ -178,7 +180,6 @@ int Compilation::ExecuteCommand(const Command &C,
       if (EC) {
         getDriver().Diag(diag::err_drv_cc_print_options_failure)
             << EC.message();
-        FailingCommand = &C;
         return 1;
       }
       OS = OwnedStream.get();
@@ -189,10 +190,12 @@ int Compilation::ExecuteCommand(const Command &C,
 
     C.Print(*OS, "\n", /*Quote=*/getDriver().CCPrintOptions);
   }
+  return 0;
+}
 
-  std::string Error;
-  bool ExecutionFailed;
-  int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+int Compilation::FinishCommand(const Command &C, int Res, StringRef Error,
+                               bool ExecutionFailed,
+                               const Command *&FailingCommand) const {
   if (PostCallback)
     PostCallback(C, Res);
   if (!Error.empty()) {
@@ -206,6 +209,19 @@ int Compilation::ExecuteCommand(const Command &C,
   return ExecutionFailed ? 1 : Res;
 }
 
+int Compilation::ExecuteCommand(const Command &C,
+                                const Command *&FailingCommand) const {
+  if (int Res = PrintCommand(C)) {
+    FailingCommand = &C;
+    return Res;
+  }
+
+  std::string Error;
+  bool ExecutionFailed;
+  int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+  return FinishCommand(C, Res, Error, ExecutionFailed, FailingCommand);
+}
+
 using FailingCommandList = SmallVectorImpl<std::pair<int, const Command *>>;
 
 static bool ActionFailed(const Action *A,
@@ -237,6 +253,21 @@ static bool InputsOk(const Command &C,
 
 void Compilation::ExecuteJobs(const JobList &Jobs,
                               FailingCommandList &FailingCommands) const {
+  // Invalid values have been diagnosed by Driver::BuildCompilation.
+  unsigned NumThreads = 1;
+  if (const Arg *A = getArgs().getLastArg(options::OPT_parallel_jobs_EQ))
+    if (StringRef(A->getValue()).getAsInteger(10, NumThreads) ||
+        NumThreads == 0)
+      NumThreads = 1;
+  // In-process cc1 relies on process-wide state, so only commands that run in
+  // their own process can overlap. cl mode stops at the first failure, which
+  // only makes sense serially.
+  if (NumThreads > 1 && !TheDriver.IsCLMode() &&
+      llvm::none_of(Jobs, [](const Command &Job) { return Job.InProcess; })) {
+    ExecuteJobsInParallel(Jobs, FailingCommands, NumThreads);
+    return;
+  }
+
   // According to UNIX standard, driver need to continue compiling all the
   // inputs on the command line even one of them failed.
   // In all but CLMode, execute all the jobs unless the necessary inputs for the
@@ -254,6 +285,59 @@ void Compilation::ExecuteJobs(const JobList &Jobs,
   }
 }
 
+void Compilation::ExecuteJobsInParallel(const JobList &Jobs,
+                                        FailingCommandList &FailingCommands,
+                                        unsigned NumThreads) const {
+  struct Launched {
+    const Command *C;
+    int Res = 0;
+    std::string Error;
+    bool ExecutionFailed = false;
+  };
+  // Commands that are running, in job order, and the files they produce.
+  std::vector<std::unique_ptr<Launched>> Running;
+  llvm::StringSet<> PendingOutputs;
+  llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+
+  // Wait for the running commands and report them in job order, so that
+  // diagnostics and FailingCommands look the same as for a serial run.
+  auto Drain = [&] {
+    Pool.wait();
+    for (std::unique_ptr<Launched> &L : Running) {
+      const Command *FailingCommand = nullptr;
+      if (int Res = FinishCommand(*L->C, L->Res, L->Error, L->ExecutionFailed,
+                                  FailingCommand))
+        FailingCommands.push_back(std::make_pair(Res, FailingCommand));
+    }
+    Running.clear();
+    PendingOutputs.clear();
+  };
+
+  for (const auto &Job : Jobs) {
+    // A command that consumes the output of a running one has to wait for it.
+    if (llvm::any_of(Job.getInputFilenames(), [&](const char *Input) {
+          return PendingOutputs.count(Input);
+        }))
+      Drain();
+    if (!InputsOk(Job, FailingCommands))
+      continue;
+    if (int Res = PrintCommand(Job)) {
+      FailingCommands.push_back(std::make_pair(Res, &Job));
+      continue;
+    }
+
+    Running.push_back(std::make_unique<Launched>());
+    Launched *L = Running.back().get();
+    L->C = &Job;
+    for (const std::string &Output : Job.getOutputFilenames())
+      PendingOutputs.insert(Output);
+    Pool.async([this, L] {
+      L->Res = L->C->Execute(Redirects, &L->Error, &L->ExecutionFailed);
+    });
+  }
+  Drain();
+}
+
 void Compilation::initCompilationForDiagnostics() {
   ForDiagnostics = true;
 
@@ -1106,6 +1106,15 @@ Compilation *Driver::BuildCompilation(ArrayRef<const char *> ArgList) {
   if (Args.hasArg(options::OPT_fproc_stat_report))
     CCPrintProcessStats = true;
 
+  // -parallel-jobs= is only used when the jobs run, check it now so that a bad
+  // value stops the compilation before any of them does.
+  if (const Arg *A = Args.getLastArg(options::OPT_parallel_jobs_EQ)) {
+    unsigned NumJobs;
+    if (StringRef(A->getValue()).getAsInteger(10, NumJobs) || NumJobs == 0)
+      Diag(diag::err_drv_invalid_int_value)
+          << A->getAsString(Args) << A->getValue();
+  }
+
   // FIXME: TargetTriple is used by the target-prefixed calls to as/ld
   // and getToolChain is const.
   if (IsCLMode()) {
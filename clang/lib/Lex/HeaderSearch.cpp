@@ -19,6 +19,7 @@
 #include "clang/Lex/DirectoryLookup.h"
 #include "clang/Lex/ExternalPreprocessorSource.h"
 #include "clang/Lex/HeaderMap.h"
+#include "clang/Lex/HeaderSearchDirectoryIndex.h"
 #include "clang/Lex/HeaderSearchOptions.h"
 #include "clang/Lex/LexDiagnostic.h"
 #include "clang/Lex/ModuleMap.h"
@@ -371,6 +372,19 @@ Optional<FileEntryRef> HeaderSearch::getFileAndSuggestModule(
   return *File;
 }
 
+bool HeaderSearch::mayContainFile(const DirectoryEntry *Dir,
+                                  StringRef Filename) {
+  if (!HSOpts->DirectoryIndex)
+    return true;
+  StringRef FirstComponent = *llvm::sys::path::begin(Filename);
+  if (FirstComponent == "." || FirstComponent == "..")
+    return true;
+  SmallString<256> DirPath(Dir->getName());
+  FileMgr.makeAbsolutePath(DirPath);
+  return HSOpts->DirectoryIndex->mayContain(FileMgr.getVirtualFileSystem(),
+                                            DirPath, FirstComponent);
+}
+
 /// LookupFile - Lookup the specified file in this search path, returning it
 /// if it exists or returning null if not.
 Optional<FileEntryRef> DirectoryLookup::LookupFile(
@@ -398,6 +412,8 @@ Optional<FileEntryRef> DirectoryLookup::LookupFile(
       RelativePath->append(Filename.begin(), Filename.end());
     }
 
+    if (!HS.mayContainFile(getDir(), Filename))
+      return None;
     return HS.getFileAndSuggestModule(TmpDir, IncludeLoc, getDir(),
                                       isSystemHeaderDirectory(),
                                       RequestingModule, SuggestedModule);
@@ -0,0 +1,49 @@
+//===--- HeaderSearchDirectoryIndex.cpp - Search Directory Contents -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the HeaderSearchDirectoryIndex class, which remembers
+//  the contents of header search directories.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/HeaderSearchDirectoryIndex.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+using namespace clang;
+
+static Optional<llvm::StringSet<>> listDirectory(llvm::vfs::FileSystem &FS,
+                                                 StringRef Dir) {
+  std::error_code EC;
+  llvm::StringSet<> Names;
+  for (llvm::vfs::directory_iterator It = FS.dir_begin(Dir, EC), End;
+       It != End && !EC; It.increment(EC))
+    Names.insert(llvm::sys::path::filename(It->path()).lower());
+  if (EC)
+    return None;
+  return Names;
+}
+
+bool HeaderSearchDirectoryIndex::mayContain(llvm::vfs::FileSystem &FS,
+                                            StringRef Dir, StringRef Name) {
+  std::string LowerName = Name.lower();
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    auto It = Dirs.find(Dir);
+    if (It != Dirs.end())
+      return !It->second || It->second->count(LowerName);
+  }
+
+  // List the directory without holding the lock, another thread may do the
+  // same in the meantime but both get the same result.
+  Optional<llvm::StringSet<>> Names = listDirectory(FS, Dir);
+  bool Result = !Names || Names->count(LowerName);
+  std::lock_guard<std::mutex> Guard(Lock);
+  Dirs.try_emplace(Dir, std::move(Names));
+  return Result;
+}
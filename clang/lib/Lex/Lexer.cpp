@@ -2264,6 +2264,13 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   return false;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 /// We have just read the // characters from input.  Skip until we find the
 /// newline character that terminates the comment.  Then update BufferPtr and
 /// return.
@@ -2290,6 +2297,26 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   // character that ends the line comment.
   char C;
   while (true) {
+#ifdef __SSE2__
+    // Skip 16 characters at a time while none of them can end the loop below.
+    // Long comments, such as license banners and the comments of generated
+    // headers, make this a hot loop.
+    __m128i Nuls = _mm_setzero_si128();
+    __m128i Newlines = _mm_set1_epi8('\n');
+    __m128i Returns = _mm_set1_epi8('\r');
+    while (CurPtr + 16 <= BufferEnd) {
+      __m128i Chars = _mm_loadu_si128((const __m128i *)CurPtr);
+      int cmp = _mm_movemask_epi8(
+          _mm_or_si128(_mm_cmpeq_epi8(Chars, Nuls),
+                       _mm_or_si128(_mm_cmpeq_epi8(Chars, Newlines),
+                                    _mm_cmpeq_epi8(Chars, Returns))));
+      if (cmp != 0) {
+        CurPtr += llvm::countTrailingZeros<unsigned>(cmp);
+        break;
+      }
+      CurPtr += 16;
+    }
+#endif
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (C != 0 &&                // Potentially EOF.
@@ -2497,13 +2524,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -30,6 +30,7 @@
 #include "clang/Lex/Pragma.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
+#include "clang/Lex/PreprocessorSkippedRangeCache.h"
 #include "clang/Lex/Token.h"
 #include "clang/Lex/VariadicMacroSupport.h"
 #include "llvm/ADT/ArrayRef.h"
@@ -370,39 +371,74 @@ SourceLocation Preprocessor::CheckEndOfDirective(const char *DirType,
   return DiscardUntilEndOfDirective().getEnd();
 }
 
+const FileEntry *Preprocessor::getFileForSkippedRangeCache(FileID FID) {
+  if (!PPOpts->SkippedRangeCache || isCodeCompletionEnabled())
+    return nullptr;
+  // Only files whose contents come from disk can be told apart by the cache.
+  const FileEntry *File = SourceMgr.getFileEntryForID(FID);
+  if (!File || File->isNamedPipe() ||
+      File->getUniqueID() == llvm::sys::fs::UniqueID(0, 0) ||
+      SourceMgr.isFileOverridden(File))
+    return nullptr;
+  return File;
+}
+
 Optional<unsigned> Preprocessor::getSkippedRangeForExcludedConditionalBlock(
     SourceLocation HashLoc) {
-  if (!ExcludedConditionalDirectiveSkipMappings)
+  if (!ExcludedConditionalDirectiveSkipMappings && !PPOpts->SkippedRangeCache)
     return None;
   if (!HashLoc.isFileID())
     return None;
 
   std::pair<FileID, unsigned> HashFileOffset =
       SourceMgr.getDecomposedLoc(HashLoc);
-  Optional<llvm::MemoryBufferRef> Buf =
-      SourceMgr.getBufferOrNone(HashFileOffset.first);
-  if (!Buf)
-    return None;
-  auto It =
-      ExcludedConditionalDirectiveSkipMappings->find(Buf->getBufferStart());
-  if (It == ExcludedConditionalDirectiveSkipMappings->end())
-    return None;
-
-  const PreprocessorSkippedRangeMapping &SkippedRanges = *It->getSecond();
-  // Check if the offset of '#' is mapped in the skipped ranges.
-  auto MappingIt = SkippedRanges.find(HashFileOffset.second);
-  if (MappingIt == SkippedRanges.end())
+  Optional<unsigned> BytesToSkip;
+  if (ExcludedConditionalDirectiveSkipMappings) {
+    Optional<llvm::MemoryBufferRef> Buf =
+        SourceMgr.getBufferOrNone(HashFileOffset.first);
+    if (!Buf)
+      return None;
+    auto It =
+        ExcludedConditionalDirectiveSkipMappings->find(Buf->getBufferStart());
+    if (It == ExcludedConditionalDirectiveSkipMappings->end())
+      return None;
+
+    const PreprocessorSkippedRangeMapping &SkippedRanges = *It->getSecond();
+    // Check if the offset of '#' is mapped in the skipped ranges.
+    auto MappingIt = SkippedRanges.find(HashFileOffset.second);
+    if (MappingIt == SkippedRanges.end())
+      return None;
+    BytesToSkip = MappingIt->getSecond();
+  } else if (const FileEntry *File =
+                 getFileForSkippedRangeCache(HashFileOffset.first)) {
+    BytesToSkip =
+        PPOpts->SkippedRangeCache->lookup(*File, HashFileOffset.second);
+  }
+  if (!BytesToSkip)
     return None;
 
-  unsigned BytesToSkip = MappingIt->getSecond();
   unsigned CurLexerBufferOffset = CurLexer->getCurrentBufferOffset();
   assert(CurLexerBufferOffset >= HashFileOffset.second &&
          "lexer is before the hash?");
   // Take into account the fact that the lexer has already advanced, so the
   // number of bytes to skip must be adjusted.
   unsigned LengthDiff = CurLexerBufferOffset - HashFileOffset.second;
-  assert(BytesToSkip >= LengthDiff && "lexer is after the skipped range?");
-  return BytesToSkip - LengthDiff;
+  assert(*BytesToSkip >= LengthDiff && "lexer is after the skipped range?");
+  return *BytesToSkip - LengthDiff;
+}
+
+void Preprocessor::recordSkippedRange(SourceLocation HashLoc,
+                                      SourceLocation EndHashLoc) {
+  if (!PPOpts->SkippedRangeCache || !HashLoc.isFileID() ||
+      !EndHashLoc.isFileID())
+    return;
+  std::pair<FileID, unsigned> Begin = SourceMgr.getDecomposedLoc(HashLoc);
+  std::pair<FileID, unsigned> End = SourceMgr.getDecomposedLoc(EndHashLoc);
+  if (Begin.first != End.first || Begin.second >= End.second)
+    return;
+  if (const FileEntry *File = getFileForSkippedRangeCache(Begin.first))
+    PPOpts->SkippedRangeCache->insert(*File, Begin.second,
+                                      End.second - Begin.second);
 }
 
 /// SkipExcludedConditionalBlock - We just read a \#if or related directive and
@@ -431,11 +467,27 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
   // disabling warnings, etc.
   CurPPLexer->LexingRawMode = true;
   Token Tok;
-  if (auto SkipLength =
-          getSkippedRangeForExcludedConditionalBlock(HashTokenLoc)) {
-    // Skip to the next '#endif' / '#else' / '#elif'.
-    CurLexer->skipOver(*SkipLength);
-  }
+
+  // The '#' of the directive that started the part of the block being skipped,
+  // and whether its extent should be recorded once we reach its end.
+  SourceLocation RangeHashLoc;
+  bool RecordRange = false;
+  auto SkipRange = [&](SourceLocation HashLoc) {
+    RangeHashLoc = HashLoc;
+    RecordRange = true;
+    if (auto SkipLength = getSkippedRangeForExcludedConditionalBlock(HashLoc)) {
+      // Skip to the next '#endif' / '#else' / '#elif'.
+      CurLexer->skipOver(*SkipLength);
+      RecordRange = false;
+    }
+  };
+  auto EndRange = [&](SourceLocation EndHashLoc) {
+    if (RecordRange)
+      recordSkippedRange(RangeHashLoc, EndHashLoc);
+    RecordRange = false;
+  };
+  SkipRange(HashTokenLoc);
+
   SourceLocation endLoc;
   while (true) {
     CurLexer->Lex(Tok);
@@ -461,6 +513,9 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
     // If this token is not a preprocessor directive, just skip it.
     if (Tok.isNot(tok::hash) || !Tok.isAtStartOfLine())
       continue;
+    SourceLocation HashLoc = Tok.getLocation();
+    // The '#' of the directive starting the next part of the block to skip.
+    SourceLocation NextRangeHashLoc;
 
     // We just parsed a # character at the start of a line, so we're in
     // directive mode.  Tell the lexer this so any newlines we see will be
@@ -540,6 +595,7 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
 
         // If we popped the outermost skipping block, we're done skipping!
         if (!CondInfo.WasSkipping) {
+          EndRange(HashLoc);
           // Restore the value of LexingRawMode so that trailing comments
           // are handled correctly, if we've reached the outermost block.
           CurPPLexer->LexingRawMode = false;
@@ -558,10 +614,17 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
         PPConditionalInfo &CondInfo = CurPPLexer->peekConditionalLevel();
 
         // If this is a #else with a #else before it, report the error.
-        if (CondInfo.FoundElse) Diag(Tok, diag::pp_err_else_after_else);
+        if (CondInfo.FoundElse) {
+          Diag(Tok, diag::pp_err_else_after_else);
+          // Jumping over this block next time would lose the error.
+          if (CondInfo.WasSkipping)
+            RecordRange = false;
+        }
 
         // Note that we've seen a #else in this conditional.
         CondInfo.FoundElse = true;
+        if (!CondInfo.WasSkipping)
+          EndRange(HashLoc);
 
         // If the conditional is at the top level, and the #if block wasn't
         // entered, enter the #else block now.
@@ -577,17 +640,28 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
           break;
         } else {
           DiscardUntilEndOfDirective();  // C99 6.10p4.
+          if (!CondInfo.WasSkipping)
+            NextRangeHashLoc = HashLoc;
         }
       } else if (Sub == "lif") {  // "elif".
         PPConditionalInfo &CondInfo = CurPPLexer->peekConditionalLevel();
 
         // If this is a #elif with a #else before it, report the error.
-        if (CondInfo.FoundElse) Diag(Tok, diag::pp_err_elif_after_else);
+        if (CondInfo.FoundElse) {
+          Diag(Tok, diag::pp_err_elif_after_else);
+          // Jumping over this block next time would lose the error.
+          if (CondInfo.WasSkipping)
+            RecordRange = false;
+        }
+        if (!CondInfo.WasSkipping)
+          EndRange(HashLoc);
 
         // If this is in a skipping block or if we're already handled this #if
         // block, don't bother parsing the condition.
         if (CondInfo.WasSkipping || CondInfo.FoundNonSkip) {
           DiscardUntilEndOfDirective();
+          if (!CondInfo.WasSkipping)
+            NextRangeHashLoc = HashLoc;
         } else {
           // Restore the value of LexingRawMode so that identifiers are
           // looked up, etc, inside the #elif expression.
@@ -608,6 +682,7 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
             CondInfo.FoundNonSkip = true;
             break;
           }
+          NextRangeHashLoc = HashLoc;
         }
       }
     }
@@ -615,6 +690,8 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
     CurPPLexer->ParsingPreprocessorDirective = false;
     // Restore comment saving mode.
     if (CurLexer) CurLexer->resetExtendedTokenMode();
+    if (NextRangeHashLoc.isValid())
+      SkipRange(NextRangeHashLoc);
   }
 
   // Finally, if we are out of the conditional (saw an #endif or ran off the end
@@ -0,0 +1,44 @@
+//===--- PreprocessorSkippedRangeCache.cpp - Skipped Ranges Cache ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the PreprocessorSkippedRangeCache class, which
+//  remembers the extent of excluded conditional blocks across preprocessor
+//  instances.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/PreprocessorSkippedRangeCache.h"
+#include "clang/Basic/FileEntry.h"
+
+using namespace clang;
+
+Optional<unsigned>
+PreprocessorSkippedRangeCache::lookup(const FileEntry &File, unsigned Offset) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  auto It = Files.find(File.getUniqueID());
+  if (It == Files.end() || It->second.Size != File.getSize() ||
+      It->second.ModTime != File.getModificationTime())
+    return None;
+  auto RangeIt = It->second.Ranges.find(Offset);
+  if (RangeIt == It->second.Ranges.end())
+    return None;
+  return RangeIt->second;
+}
+
+void PreprocessorSkippedRangeCache::insert(const FileEntry &File,
+                                           unsigned Offset, unsigned Length) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  FileRanges &Entry = Files[File.getUniqueID()];
+  if (Entry.Size != File.getSize() ||
+      Entry.ModTime != File.getModificationTime()) {
+    Entry.Size = File.getSize();
+    Entry.ModTime = File.getModificationTime();
+    Entry.Ranges.clear();
+  }
+  Entry.Ranges[Offset] = Length;
+}
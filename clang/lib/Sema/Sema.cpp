@@ -522,6 +522,11 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumClassInstantiations << " class template instantiations.\n";
+  llvm::errs() << NumFunctionInstantiations
+               << " function template instantiations ("
+               << NumFunctionInstantiationsFromAST
+               << " definitions reused from AST files).\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
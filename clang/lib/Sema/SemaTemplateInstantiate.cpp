@@ -2661,6 +2661,7 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
   assert(!Inst.isAlreadyInstantiating() && "should have been caught by caller");
   PrettyDeclStackTraceEntry CrashInfo(Context, Instantiation, SourceLocation(),
                                       "instantiating class definition");
+  ++NumClassInstantiations;
 
   // Enter the scope of this instantiation. We don't use
   // PushDeclContext because we don't have a scope.
@@ -4702,8 +4702,11 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
   const FunctionDecl *ExistingDefn = nullptr;
   if (Function->isDefined(ExistingDefn,
                           /*CheckForPendingFriendDefinition=*/true)) {
-    if (ExistingDefn->isThisDeclarationADefinition())
+    if (ExistingDefn->isThisDeclarationADefinition()) {
+      if (ExistingDefn->isFromASTFile())
+        ++NumFunctionInstantiationsFromAST;
       return;
+    }
 
     // If we're asked to instantiate a function whose body comes from an
     // instantiated friend declaration, attach the instantiated body to the
@@ -4764,6 +4767,7 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
     return;
   }
 
+  ++NumFunctionInstantiations;
   llvm::TimeTraceScope TimeScope("InstantiateFunction", [&]() {
     std::string Name;
     llvm::raw_string_ostream OS(Name);
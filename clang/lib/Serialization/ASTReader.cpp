@@ -100,6 +100,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
@@ -143,6 +144,13 @@ using namespace clang::serialization::reader;
 using llvm::BitstreamCursor;
 using llvm::RoundingMode;
 
+#define DEBUG_TYPE "ast-reader"
+
+STATISTIC(NumDeclsDeserialized, "Number of declarations deserialized");
+STATISTIC(NumTypesDeserialized, "Number of types deserialized");
+STATISTIC(NumIdentifiersDeserialized,
+          "Number of identifiers deserialized by ID");
+
 //===----------------------------------------------------------------------===//
 // ChainedASTReaderListener implementation
 //===----------------------------------------------------------------------===//
@@ -4330,10 +4338,10 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
 
     // Preload all the pending interesting identifiers by marking them out of
     // date.
+    ASTIdentifierLookupTrait Trait(*this, F);
     for (auto Offset : F.PreloadIdentifierOffsets) {
       const unsigned char *Data = F.IdentifierTableData + Offset;
 
-      ASTIdentifierLookupTrait Trait(*this, F);
       auto KeyDataLen = Trait.ReadKeyDataLength(Data);
       auto Key = Trait.ReadKey(Data, KeyDataLen.first);
       auto &II = PP.getIdentifierTable().getOwn(Key);
@@ -7092,6 +7100,7 @@ QualType ASTReader::GetType(TypeID ID) {
   Index -= NUM_PREDEF_TYPE_IDS;
   assert(Index < TypesLoaded.size() && "Type index out-of-range");
   if (TypesLoaded[Index].isNull()) {
+    ++NumTypesDeserialized;
     TypesLoaded[Index] = readTypeRecord(Index);
     if (TypesLoaded[Index].isNull())
       return QualType();
@@ -7459,6 +7468,7 @@ Decl *ASTReader::GetDecl(DeclID ID) {
   }
 
   if (!DeclsLoaded[Index]) {
+    ++NumDeclsDeserialized;
     ReadDeclRecord(ID);
     if (DeserializationListener)
       DeserializationListener->DeclRead(ID, DeclsLoaded[Index]);
@@ -8541,6 +8551,7 @@ IdentifierInfo *ASTReader::DecodeIdentifierInfo(IdentifierID ID) {
     auto KeyDataLen = Trait.ReadKeyDataLength(Data);
     auto Key = Trait.ReadKey(Data, KeyDataLen.first);
     auto &II = PP.getIdentifierTable().get(Key);
+    ++NumIdentifiersDeserialized;
     IdentifiersLoaded[ID] = &II;
     markIdentifierFromAST(*this,  II);
     if (DeserializationListener)
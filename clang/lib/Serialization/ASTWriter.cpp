@@ -100,6 +100,7 @@
 #include "llvm/Support/OnDiskHashTable.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/VersionTuple.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -1888,30 +1889,46 @@ void ASTWriter::WriteHeaderSearch(const HeaderSearch &HS) {
     free(const_cast<char *>(SavedStrings[I]));
 }
 
+/// Compress the contents of a buffer embedded in the AST file, if possible.
+/// We expect that almost all PCM consumers will not want its contents.
+static Optional<SmallString<0>> compressBlob(StringRef Blob) {
+  if (!llvm::zlib::isAvailable())
+    return None;
+  SmallString<0> CompressedBuffer;
+  if (llvm::Error E = llvm::zlib::compress(Blob.drop_back(1),
+                                           CompressedBuffer)) {
+    llvm::consumeError(std::move(E));
+    return None;
+  }
+  return CompressedBuffer;
+}
+
 static void emitBlob(llvm::BitstreamWriter &Stream, StringRef Blob,
+                     const Optional<SmallString<0>> &CompressedBuffer,
                      unsigned SLocBufferBlobCompressedAbbrv,
                      unsigned SLocBufferBlobAbbrv) {
   using RecordDataType = ASTWriter::RecordData::value_type;
 
-  // Compress the buffer if possible. We expect that almost all PCM
-  // consumers will not want its contents.
-  SmallString<0> CompressedBuffer;
-  if (llvm::zlib::isAvailable()) {
-    llvm::Error E = llvm::zlib::compress(Blob.drop_back(1), CompressedBuffer);
-    if (!E) {
-      RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED,
-                                 Blob.size() - 1};
-      Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
-                                CompressedBuffer);
-      return;
-    }
-    llvm::consumeError(std::move(E));
+  if (CompressedBuffer) {
+    RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED,
+                               Blob.size() - 1};
+    Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
+                              *CompressedBuffer);
+    return;
   }
 
   RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB};
   Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record, Blob);
 }
 
+/// Whether the contents of \p Content are embedded in the AST file, rather
+/// than read back from the file system.
+static bool isBufferEmbedded(const SrcMgr::ContentCache &Content) {
+  if (Content.OrigEntry)
+    return Content.BufferOverridden || Content.IsTransient;
+  return true;
+}
+
 /// Writes the block containing the serialized form of the
 /// source manager.
 ///
@@ -1936,6 +1953,42 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
       CreateSLocBufferBlobAbbrev(Stream, true);
   unsigned SLocExpansionAbbrv = CreateSLocExpansionAbbrev(Stream);
 
+  // Collect the buffers embedded in the AST file and compress them up front.
+  // Compression is independent for each buffer, so it can be done in parallel;
+  // the records are still emitted in order below, so the output is the same
+  // however many threads are used.
+  SmallVector<StringRef, 16> Blobs;
+  for (unsigned I = 1, N = SourceMgr.local_sloc_entry_size(); I != N; ++I) {
+    const SrcMgr::SLocEntry &SLoc = SourceMgr.getLocalSLocEntry(I);
+    if (!SLoc.isFile() ||
+        !isBufferEmbedded(SLoc.getFile().getContentCache()))
+      continue;
+
+    // Include the implicit terminating null character in the on-disk buffer
+    // if we're writing it uncompressed.
+    llvm::Optional<llvm::MemoryBufferRef> Buffer =
+        SLoc.getFile().getContentCache().getBufferOrNone(PP.getDiagnostics(),
+                                                         PP.getFileManager());
+    if (!Buffer)
+      Buffer = llvm::MemoryBufferRef("<<<INVALID BUFFER>>>", "");
+    Blobs.push_back(
+        StringRef(Buffer->getBufferStart(), Buffer->getBufferSize() + 1));
+  }
+  std::vector<Optional<SmallString<0>>> CompressedBlobs(Blobs.size());
+  unsigned CompressionThreads = PP.getHeaderSearchInfo()
+                                    .getHeaderSearchOpts()
+                                    .ModulesEmbedCompressionThreads;
+  if (CompressionThreads == 1 || Blobs.size() < 2) {
+    for (unsigned I = 0, N = Blobs.size(); I != N; ++I)
+      CompressedBlobs[I] = compressBlob(Blobs[I]);
+  } else {
+    llvm::ThreadPool Pool(llvm::hardware_concurrency(CompressionThreads));
+    for (unsigned I = 0, N = Blobs.size(); I != N; ++I)
+      Pool.async([&, I] { CompressedBlobs[I] = compressBlob(Blobs[I]); });
+    Pool.wait();
+  }
+  unsigned NextBlob = 0;
+
   // Write out the source location entry table. We skip the first
   // entry, which is always the same dummy entry.
   std::vector<uint32_t> SLocEntryOffsets;
@@ -1976,7 +2029,6 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
       Record.push_back(File.hasLineDirectives());
 
       const SrcMgr::ContentCache *Content = &File.getContentCache();
-      bool EmitBlob = false;
       if (Content->OrigEntry) {
         assert(Content->OrigEntry == Content->ContentsEntry &&
                "Writing to AST an overridden file is not supported");
@@ -1997,9 +2049,6 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
         }
 
         Stream.EmitRecordWithAbbrev(SLocFileAbbrv, Record);
-
-        if (Content->BufferOverridden || Content->IsTransient)
-          EmitBlob = true;
       } else {
         // The source location entry is a buffer. The blob associated
         // with this entry contains the contents of the buffer.
@@ -2012,22 +2061,16 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
         StringRef Name = Buffer ? Buffer->getBufferIdentifier() : "";
         Stream.EmitRecordWithBlob(SLocBufferAbbrv, Record,
                                   StringRef(Name.data(), Name.size() + 1));
-        EmitBlob = true;
 
         if (Name == "<built-in>")
           PreloadSLocs.push_back(SLocEntryOffsets.size());
       }
 
-      if (EmitBlob) {
-        // Include the implicit terminating null character in the on-disk buffer
-        // if we're writing it uncompressed.
-        llvm::Optional<llvm::MemoryBufferRef> Buffer =
-            Content->getBufferOrNone(PP.getDiagnostics(), PP.getFileManager());
-        if (!Buffer)
-          Buffer = llvm::MemoryBufferRef("<<<INVALID BUFFER>>>", "");
-        StringRef Blob(Buffer->getBufferStart(), Buffer->getBufferSize() + 1);
-        emitBlob(Stream, Blob, SLocBufferBlobCompressedAbbrv,
-                 SLocBufferBlobAbbrv);
+      if (isBufferEmbedded(*Content)) {
+        assert(NextBlob < Blobs.size() && "Missed embedded buffer");
+        emitBlob(Stream, Blobs[NextBlob], CompressedBlobs[NextBlob],
+                 SLocBufferBlobCompressedAbbrv, SLocBufferBlobAbbrv);
+        ++NextBlob;
       }
     } else {
       // The source location entry is a macro expansion.
@@ -21,9 +21,41 @@ InMemoryModuleCache::getPCMState(llvm::StringRef Filename) const {
   return I->second.Buffer ? Tentative : ToBuild;
 }
 
+std::shared_ptr<llvm::MemoryBuffer>
+SharedModuleBufferCache::lookup(llvm::StringRef Filename, off_t Size,
+                                time_t ModTime) const {
+  std::lock_guard<std::mutex> Guard(Lock);
+  auto I = Buffers.find(Filename);
+  if (I == Buffers.end() || I->second.Size != Size ||
+      I->second.ModTime != ModTime)
+    return nullptr;
+  return I->second.Buffer;
+}
+
+std::shared_ptr<llvm::MemoryBuffer>
+SharedModuleBufferCache::insert(llvm::StringRef Filename, off_t Size,
+                                time_t ModTime,
+                                std::unique_ptr<llvm::MemoryBuffer> Buffer) {
+  std::lock_guard<std::mutex> Guard(Lock);
+  Entry &E = Buffers[Filename];
+  if (!E.Buffer || E.Size != Size || E.ModTime != ModTime) {
+    E.Size = Size;
+    E.ModTime = ModTime;
+    E.Buffer = std::move(Buffer);
+  }
+  return E.Buffer;
+}
+
 llvm::MemoryBuffer &
 InMemoryModuleCache::addPCM(llvm::StringRef Filename,
                             std::unique_ptr<llvm::MemoryBuffer> Buffer) {
+  return addPCM(Filename,
+                std::shared_ptr<llvm::MemoryBuffer>(std::move(Buffer)));
+}
+
+llvm::MemoryBuffer &
+InMemoryModuleCache::addPCM(llvm::StringRef Filename,
+                            std::shared_ptr<llvm::MemoryBuffer> Buffer) {
   auto Insertion = PCMs.insert(std::make_pair(Filename, std::move(Buffer)));
   assert(Insertion.second && "Already has a PCM");
   return *Insertion.first->second.Buffer;
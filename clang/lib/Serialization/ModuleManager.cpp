@@ -99,6 +99,18 @@ static void updateModuleImports(ModuleFile &MF, ModuleFile *ImportedBy,
   }
 }
 
+/// Get the contents of the module file \p Entry if another compilation that
+/// shares PCM buffers with \p ModuleCache already read this version of it.
+static std::shared_ptr<llvm::MemoryBuffer>
+lookupSharedBuffer(InMemoryModuleCache &ModuleCache, StringRef FileName,
+                   const FileEntry *Entry) {
+  SharedModuleBufferCache *SharedBuffers = ModuleCache.getSharedBuffers();
+  if (!SharedBuffers || !Entry)
+    return nullptr;
+  return SharedBuffers->lookup(FileName, Entry->getSize(),
+                               Entry->getModificationTime());
+}
+
 ModuleManager::AddModuleResult
 ModuleManager::addModule(StringRef FileName, ModuleKind Type,
                          SourceLocation ImportLoc, ModuleFile *ImportedBy,
@@ -201,6 +213,12 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
     // import it earlier.
     Entry->closeFile();
     return OutOfDate;
+  } else if (std::shared_ptr<llvm::MemoryBuffer> Shared =
+                 lookupSharedBuffer(getModuleCache(), FileName, Entry)) {
+    // Another compilation in this process already read this version of the
+    // file.
+    NewModule->Buffer = &getModuleCache().addPCM(FileName, std::move(Shared));
+    Entry->closeFile();
   } else {
     // Open the AST file.
     llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buf((std::error_code()));
@@ -223,7 +241,15 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
       return Missing;
     }
 
-    NewModule->Buffer = &getModuleCache().addPCM(FileName, std::move(*Buf));
+    SharedModuleBufferCache *SharedBuffers =
+        getModuleCache().getSharedBuffers();
+    if (SharedBuffers && Entry)
+      NewModule->Buffer = &getModuleCache().addPCM(
+          FileName, SharedBuffers->insert(FileName, Entry->getSize(),
+                                          Entry->getModificationTime(),
+                                          std::move(*Buf)));
+    else
+      NewModule->Buffer = &getModuleCache().addPCM(FileName, std::move(*Buf));
   }
 
   // Initialize the stream.
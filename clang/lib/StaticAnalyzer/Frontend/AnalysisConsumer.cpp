@@ -60,6 +60,11 @@ STATISTIC(NumVisitedBlocksInAnalyzedFunctions,
           "The # of visited basic blocks in the analyzed functions.");
 STATISTIC(PercentReachableBlocks, "The % of reachable basic blocks.");
 STATISTIC(MaxCFGSize, "The maximum number of basic blocks in a function.");
+STATISTIC(MaxExplodedGraphNodes,
+          "The maximum number of nodes in an exploded graph.");
+STATISTIC(MaxExplodedGraphBytes,
+          "The maximum number of bytes allocated for the exploded graph and "
+          "the program states of a top level function.");
 
 //===----------------------------------------------------------------------===//
 // AnalysisConsumer declaration.
@@ -655,8 +660,12 @@ void AnalysisConsumer::HandleCode(Decl *D, AnalysisMode Mode,
   if (Mode == AM_None)
     return;
 
-  // Clear the AnalysisManager of old AnalysisDeclContexts.
-  Mgr->ClearContexts();
+  // Clear the AnalysisManager of old AnalysisDeclContexts once there are too
+  // many of them. Until then, the CFGs of functions that are inlined into
+  // several top-level functions are built only once.
+  if (Mgr->getAnalysisDeclContextManager().getNumContexts() >=
+      Opts->MaxCachedAnalysisContexts)
+    Mgr->ClearContexts();
   // Ignore autosynthesized code.
   if (Mgr->getAnalysisDeclContext(D)->isBodyAutosynthesized())
     return;
@@ -711,6 +720,16 @@ void AnalysisConsumer::RunPathSensitiveChecks(Decl *D,
   if (ExprEngineTimer)
     ExprEngineTimer->stopTimer();
 
+  // Nodes, program states, stores and symbols all come from the allocator of
+  // the exploded graph.
+  ExplodedGraph &G = Eng.getGraph();
+  size_t GraphBytes = G.getAllocator().getTotalMemory();
+  MaxExplodedGraphNodes.updateMax(G.size());
+  MaxExplodedGraphBytes.updateMax(GraphBytes);
+  if (Opts->PrintStats)
+    llvm::errs() << "Exploded graph of " << getFunctionName(D) << ": "
+                 << G.size() << " nodes, " << GraphBytes << " bytes\n";
+
   if (!Mgr->options.DumpExplodedGraphTo.empty())
     Eng.DumpGraph(Mgr->options.TrimGraph, Mgr->options.DumpExplodedGraphTo);
 
@@ -8,15 +8,93 @@
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
 #include "clang/Lex/DependencyDirectivesSourceMinimizer.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace clang;
 using namespace tooling;
 using namespace dependencies;
 
+// Entries of the persistent cache start with this magic, which must change
+// whenever the format or the output of the minimizer changes.
+static const char PersistentEntryMagic[] = "CSDMIN01";
+
+/// Get the path of the persistent cache entry for a file with \p Contents.
+static std::string getPersistentEntryPath(StringRef CacheDir,
+                                          StringRef Contents) {
+  SmallString<128> Path(CacheDir);
+  llvm::sys::path::append(Path, llvm::utohexstr(llvm::xxHash64(Contents)) +
+                                    "-" + llvm::utostr(Contents.size()));
+  return std::string(Path.str());
+}
+
+/// Read a persistent cache entry into \p Contents and \p Mapping.
+///
+/// \returns false if there is no valid entry at \p Path.
+static bool readPersistentEntry(StringRef Path,
+                                llvm::SmallString<1024> &Contents,
+                                PreprocessorSkippedRangeMapping &Mapping) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> MaybeBuffer =
+      llvm::MemoryBuffer::getFile(Path, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
+  if (!MaybeBuffer)
+    return false;
+  StringRef Data = (*MaybeBuffer)->getBuffer();
+  const size_t MagicSize = sizeof(PersistentEntryMagic) - 1;
+  if (!Data.consume_front(StringRef(PersistentEntryMagic, MagicSize)) ||
+      Data.size() < 4)
+    return false;
+  using namespace llvm::support;
+  uint32_t NumRanges = endian::read32le(Data.data());
+  Data = Data.drop_front(4);
+  if (Data.size() < uint64_t(NumRanges) * 8)
+    return false;
+  for (uint32_t I = 0; I != NumRanges; ++I) {
+    Mapping[endian::read32le(Data.data())] = endian::read32le(Data.data() + 4);
+    Data = Data.drop_front(8);
+  }
+  Contents = Data;
+  return true;
+}
+
+/// Write a persistent cache entry, ignoring failures: the cache is only an
+/// optimization. The entry is renamed into place so that concurrent readers
+/// never see a partial one.
+static void writePersistentEntry(StringRef Path, StringRef Contents,
+                                 const PreprocessorSkippedRangeMapping &Mapping) {
+  int FD;
+  SmallString<128> TempPath;
+  if (llvm::sys::fs::createUniqueFile(Path + ".tmp-%%%%%%%%", FD, TempPath))
+    return;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    llvm::support::endian::Writer W(OS, llvm::support::little);
+    OS << StringRef(PersistentEntryMagic, sizeof(PersistentEntryMagic) - 1);
+    W.write<uint32_t>(Mapping.size());
+    for (const auto &Range : Mapping) {
+      W.write<uint32_t>(Range.first);
+      W.write<uint32_t>(Range.second);
+    }
+    OS << Contents;
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(TempPath, Path))
+    llvm::sys::fs::remove(TempPath);
+}
+
 CachedFileSystemEntry CachedFileSystemEntry::createFileEntry(
-    StringRef Filename, llvm::vfs::FileSystem &FS, bool Minimize) {
+    StringRef Filename, llvm::vfs::FileSystem &FS, bool Minimize,
+    StringRef PersistentCacheDir) {
   // Load the file and its content from the file system.
   llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> MaybeFile =
       FS.openFileForRead(Filename);
@@ -33,11 +111,23 @@ CachedFileSystemEntry CachedFileSystemEntry::createFileEntry(
     return MaybeBuffer.getError();
 
   llvm::SmallString<1024> MinimizedFileContents;
-  // Minimize the file down to directives that might affect the dependencies.
   const auto &Buffer = *MaybeBuffer;
+  PreprocessorSkippedRangeMapping Mapping;
+  std::string PersistentPath;
+  bool FromPersistentCache = false;
+  if (Minimize && !PersistentCacheDir.empty()) {
+    PersistentPath =
+        getPersistentEntryPath(PersistentCacheDir, Buffer->getBuffer());
+    FromPersistentCache =
+        readPersistentEntry(PersistentPath, MinimizedFileContents, Mapping);
+  }
+
+  // Minimize the file down to directives that might affect the dependencies.
   SmallVector<minimize_source_to_dependency_directives::Token, 64> Tokens;
-  if (!Minimize || minimizeSourceToDependencyDirectives(
-                       Buffer->getBuffer(), MinimizedFileContents, Tokens)) {
+  if (!Minimize ||
+      (!FromPersistentCache &&
+       minimizeSourceToDependencyDirectives(Buffer->getBuffer(),
+                                            MinimizedFileContents, Tokens))) {
     // Use the original file unless requested otherwise, or
     // if the minimization failed.
     // FIXME: Propage the diagnostic if desired by the client.
@@ -58,7 +148,8 @@ CachedFileSystemEntry CachedFileSystemEntry::createFileEntry(
                                        Stat->getUser(), Stat->getGroup(), Size,
                                        Stat->getType(), Stat->getPermissions());
   // The contents produced by the minimizer must be null terminated.
-  assert(MinimizedFileContents.data()[MinimizedFileContents.size()] == '\0' &&
+  assert((FromPersistentCache ||
+          MinimizedFileContents.data()[MinimizedFileContents.size()] == '\0') &&
          "not null terminated contents");
   // Even though there's an implicit null terminator in the minimized contents,
   // we want to temporarily make it explicit. This will ensure that the
@@ -70,21 +161,25 @@ CachedFileSystemEntry CachedFileSystemEntry::createFileEntry(
   // it right where the buffer ends.
   Result.Contents.pop_back();
 
-  // Compute the skipped PP ranges that speedup skipping over inactive
-  // preprocessor blocks.
-  llvm::SmallVector<minimize_source_to_dependency_directives::SkippedRange, 32>
-      SkippedRanges;
-  minimize_source_to_dependency_directives::computeSkippedRanges(Tokens,
-                                                                 SkippedRanges);
-  PreprocessorSkippedRangeMapping Mapping;
-  for (const auto &Range : SkippedRanges) {
-    if (Range.Length < 16) {
-      // Ignore small ranges as non-profitable.
-      // FIXME: This is a heuristic, its worth investigating the tradeoffs
-      // when it should be applied.
-      continue;
+  if (!FromPersistentCache) {
+    // Compute the skipped PP ranges that speedup skipping over inactive
+    // preprocessor blocks.
+    llvm::SmallVector<minimize_source_to_dependency_directives::SkippedRange,
+                      32>
+        SkippedRanges;
+    minimize_source_to_dependency_directives::computeSkippedRanges(
+        Tokens, SkippedRanges);
+    for (const auto &Range : SkippedRanges) {
+      if (Range.Length < 16) {
+        // Ignore small ranges as non-profitable.
+        // FIXME: This is a heuristic, its worth investigating the tradeoffs
+        // when it should be applied.
+        continue;
+      }
+      Mapping[Range.Offset] = Range.Length;
     }
-    Mapping[Range.Offset] = Range.Length;
+    if (!PersistentPath.empty())
+      writePersistentEntry(PersistentPath, Result.Contents, Mapping);
   }
   Result.PPSkippedRangeMapping = std::move(Mapping);
 
@@ -185,7 +280,8 @@ DependencyScanningWorkerFilesystem::getOrCreateFileSystemEntry(
             std::move(*MaybeStatus));
       else
         CacheEntry = CachedFileSystemEntry::createFileEntry(
-            Filename, FS, !KeepOriginalSource);
+            Filename, FS, !KeepOriginalSource,
+            SharedCache.getPersistentCacheDir());
     }
 
     Result = &CacheEntry;
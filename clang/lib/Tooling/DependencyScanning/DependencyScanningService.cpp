@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
+#include "clang/Tooling/DependencyScanning/ModuleDepCollector.h"
 
 using namespace clang;
 using namespace tooling;
@@ -16,4 +17,23 @@ DependencyScanningService::DependencyScanningService(
     ScanningMode Mode, ScanningOutputFormat Format, bool ReuseFileManager,
     bool SkipExcludedPPRanges)
     : Mode(Mode), Format(Format), ReuseFileManager(ReuseFileManager),
-      SkipExcludedPPRanges(SkipExcludedPPRanges) {}
+      SkipExcludedPPRanges(SkipExcludedPPRanges),
+      SharedModuleBuffers(new SharedModuleBufferCache()) {}
+
+std::shared_ptr<const ModuleDeps>
+SharedModuleDepsCache::lookup(StringRef ContextHash, StringRef ModuleName) {
+  std::lock_guard<std::mutex> LockGuard(Lock);
+  auto It = Entries.find((ContextHash + ModuleName).str());
+  if (It == Entries.end())
+    return nullptr;
+  return It->second;
+}
+
+void SharedModuleDepsCache::insert(const ModuleDeps &MD) {
+  auto Entry = std::make_shared<ModuleDeps>(MD);
+  // Whether the module was imported by the main file is specific to the
+  // translation unit that discovered it.
+  Entry->ImportedByMainFile = false;
+  std::lock_guard<std::mutex> LockGuard(Lock);
+  Entries.try_emplace(MD.ContextHash + MD.ModuleName, std::move(Entry));
+}
@@ -52,9 +52,11 @@ public:
       StringRef WorkingDirectory, DependencyConsumer &Consumer,
       llvm::IntrusiveRefCntPtr<DependencyScanningWorkerFilesystem> DepFS,
       ExcludedPreprocessorDirectiveSkipMapping *PPSkipMappings,
-      ScanningOutputFormat Format)
+      llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> ModuleBuffers,
+      SharedModuleDepsCache &ModuleDeps, ScanningOutputFormat Format)
       : WorkingDirectory(WorkingDirectory), Consumer(Consumer),
         DepFS(std::move(DepFS)), PPSkipMappings(PPSkipMappings),
+        ModuleBuffers(std::move(ModuleBuffers)), ModuleDeps(ModuleDeps),
         Format(Format) {}
 
   bool runInvocation(std::shared_ptr<CompilerInvocation> Invocation,
@@ -64,6 +66,8 @@ public:
     // Create a compiler instance to handle the actual work.
     CompilerInstance Compiler(std::move(PCHContainerOps));
     Compiler.setInvocation(std::move(Invocation));
+    // Don't re-read the PCMs other invocations already loaded.
+    Compiler.getModuleCache().setSharedBuffers(ModuleBuffers);
 
     // Don't print 'X warnings and Y errors generated'.
     Compiler.getDiagnosticOpts().ShowCarets = false;
@@ -121,7 +125,7 @@ public:
       break;
     case ScanningOutputFormat::Full:
       Compiler.addDependencyCollector(std::make_shared<ModuleDepCollector>(
-          std::move(Opts), Compiler, Consumer));
+          std::move(Opts), Compiler, Consumer, ModuleDeps));
       break;
     }
 
@@ -144,6 +148,8 @@ private:
   DependencyConsumer &Consumer;
   llvm::IntrusiveRefCntPtr<DependencyScanningWorkerFilesystem> DepFS;
   ExcludedPreprocessorDirectiveSkipMapping *PPSkipMappings;
+  llvm::IntrusiveRefCntPtr<SharedModuleBufferCache> ModuleBuffers;
+  SharedModuleDepsCache &ModuleDeps;
   ScanningOutputFormat Format;
 };
 
@@ -151,7 +157,8 @@ private:
 
 DependencyScanningWorker::DependencyScanningWorker(
     DependencyScanningService &Service)
-    : Format(Service.getFormat()) {
+    : ModuleBuffers(Service.getSharedModuleBuffers()),
+      ModuleDeps(Service.getSharedModuleDeps()), Format(Service.getFormat()) {
   DiagOpts = new DiagnosticOptions();
   PCHContainerOps = std::make_shared<PCHContainerOperations>();
   RealFS = llvm::vfs::createPhysicalFileSystem();
@@ -184,6 +191,13 @@ llvm::Error DependencyScanningWorker::computeDependencies(
     const std::string &Input, StringRef WorkingDirectory,
     const CompilationDatabase &CDB, DependencyConsumer &Consumer) {
   RealFS->setCurrentWorkingDirectory(WorkingDirectory);
+  // The reused file manager must not keep reporting files as missing that
+  // were created since the last scan, e.g. generated headers. This does not
+  // apply to minimized scans: the shared cache behind DepFS keeps the failed
+  // lookups of source files for the lifetime of the service, which assumes
+  // that the files it scans don't change.
+  if (Files && !DepFS)
+    Files->clearFailedLookups();
   return runWithDiags(DiagOpts.get(), [&](DiagnosticConsumer &DC) {
     /// Create the tool that uses the underlying file system to ensure that any
     /// file system requests that are made by the driver do not go through the
@@ -194,7 +208,8 @@ llvm::Error DependencyScanningWorker::computeDependencies(
     Tool.setPrintErrorMessage(false);
     Tool.setDiagnosticConsumer(&DC);
     DependencyScanningAction Action(WorkingDirectory, Consumer, DepFS,
-                                    PPSkipMappings.get(), Format);
+                                    PPSkipMappings.get(), ModuleBuffers,
+                                    ModuleDeps, Format);
     return !Tool.run(&Action);
   });
 }
@@ -11,6 +11,7 @@
 
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Lex/Preprocessor.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
 
 using namespace clang;
@@ -147,15 +148,28 @@ void ModuleDepCollectorPP::handleTopLevelModule(const Module *M) {
   MD.ModuleName = M->getFullModuleName();
   MD.ImplicitModulePCMPath = std::string(M->getASTFile()->getName());
   MD.ContextHash = MDC.ContextHash;
-  serialization::ModuleFile *MF =
-      MDC.Instance.getASTReader()->getModuleManager().lookup(M->getASTFile());
-  MDC.Instance.getASTReader()->visitInputFiles(
-      *MF, true, true, [&](const serialization::InputFile &IF, bool isSystem) {
-        MD.FileDeps.insert(IF.getFile()->getName());
-      });
+  // Visiting the input files of the PCM is what makes this expensive, so do it
+  // once per module and service rather than once per translation unit.
+  std::shared_ptr<const ModuleDeps> Known =
+      MDC.SharedDeps.lookup(MD.ContextHash, MD.ModuleName);
+  if (Known) {
+    MD.FileDeps = Known->FileDeps;
+  } else {
+    serialization::ModuleFile *MF =
+        MDC.Instance.getASTReader()->getModuleManager().lookup(
+            M->getASTFile());
+    MDC.Instance.getASTReader()->visitInputFiles(
+        *MF, true, true,
+        [&](const serialization::InputFile &IF, bool isSystem) {
+          MD.FileDeps.insert(IF.getFile()->getName());
+        });
+  }
 
   llvm::DenseSet<const Module *> AddedModules;
   addAllSubmoduleDeps(M, MD, AddedModules);
+
+  if (!Known)
+    MDC.SharedDeps.insert(MD);
 }
 
 void ModuleDepCollectorPP::addAllSubmoduleDeps(
@@ -183,8 +197,9 @@ void ModuleDepCollectorPP::addModuleDep(
 
 ModuleDepCollector::ModuleDepCollector(
     std::unique_ptr<DependencyOutputOptions> Opts, CompilerInstance &I,
-    DependencyConsumer &C)
-    : Instance(I), Consumer(C), Opts(std::move(Opts)) {}
+    DependencyConsumer &C, SharedModuleDepsCache &SharedDeps)
+    : Instance(I), Consumer(C), SharedDeps(SharedDeps),
+      Opts(std::move(Opts)) {}
 
 void ModuleDepCollector::attachToPreprocessor(Preprocessor &PP) {
   PP.addPPCallbacks(std::make_unique<ModuleDepCollectorPP>(Instance, *this));
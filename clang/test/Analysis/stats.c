@@ -4,6 +4,7 @@
 void foo() {
   int x;
 }
+// CHECK: Exploded graph of foo: {{[0-9]+}} nodes, {{[0-9]+}} bytes
 // CHECK: ... Statistics Collected ...
 // CHECK:100 AnalysisConsumer - The % of reachable basic blocks.
 // CHECK:The # of times RemoveDeadBindings is called
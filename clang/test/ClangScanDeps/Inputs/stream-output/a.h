@@ -0,0 +1 @@
+typedef int a_t;
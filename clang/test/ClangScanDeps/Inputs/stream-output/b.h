@@ -0,0 +1,3 @@
+#include "a.h"
+
+typedef a_t b_t;
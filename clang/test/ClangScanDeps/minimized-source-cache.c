@@ -0,0 +1,68 @@
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: sed -e "s|DIR|%/t|g" %t/cdb.json.template > %t/cdb.json
+
+// The first run minimizes every file and keeps the result in the cache.
+// RUN: clang-scan-deps -compilation-database %t/cdb.json -j 1 \
+// RUN:   -mode preprocess-minimized-sources \
+// RUN:   -minimized-source-cache-dir %t/cache | FileCheck %s -DPREFIX=%/t
+// RUN: ls %t/cache | count 3
+
+// Later runs read the minimized sources from the cache. Make the cached
+// a.h include c.h instead of b.h to check that it is used.
+// RUN: %python %t/patch.py %t/cache
+// RUN: clang-scan-deps -compilation-database %t/cdb.json -j 1 \
+// RUN:   -mode preprocess-minimized-sources \
+// RUN:   -minimized-source-cache-dir %t/cache | \
+// RUN:   FileCheck %s -DPREFIX=%/t --check-prefix=CACHED
+// RUN: clang-scan-deps -compilation-database %t/cdb.json -j 1 \
+// RUN:   -mode preprocess-minimized-sources | FileCheck %s -DPREFIX=%/t
+
+// RUN: not clang-scan-deps -compilation-database %t/cdb.json -j 1 \
+// RUN:   -minimized-source-cache-dir %t/main.c/cache 2>&1 | \
+// RUN:   FileCheck %s -DPREFIX=%/t --check-prefix=ERROR
+
+// CHECK:      main.o:
+// CHECK-NEXT:   [[PREFIX]]/main.c
+// CHECK-NEXT:   [[PREFIX]]/a.h
+// CHECK-NEXT:   [[PREFIX]]/b.h
+// CHECK-NOT:    c.h
+
+// CACHED:      main.o:
+// CACHED-NEXT:   [[PREFIX]]/main.c
+// CACHED-NEXT:   [[PREFIX]]/a.h
+// CACHED-NEXT:   [[PREFIX]]/c.h
+// CACHED-NOT:    b.h
+
+// ERROR: error: could not create '[[PREFIX]]/main.c/cache': {{.*}}
+
+//--- cdb.json.template
+[{
+  "directory": "DIR",
+  "command": "clang -c DIR/main.c -o DIR/main.o",
+  "file": "DIR/main.c"
+}]
+
+//--- main.c
+#include "a.h"
+
+//--- a.h
+#include "b.h"
+int a;
+
+//--- b.h
+#define B 1
+
+//--- c.h
+#define C 1
+
+//--- patch.py
+import os
+import sys
+
+for name in os.listdir(sys.argv[1]):
+    path = os.path.join(sys.argv[1], name)
+    with open(path, 'rb') as f:
+        data = f.read()
+    with open(path, 'wb') as f:
+        f.write(data.replace(b'"b.h"', b'"c.h"'))
@@ -0,0 +1,24 @@
+// RUN: rm -rf %t.dir
+// RUN: rm -rf %t.cdb
+// RUN: mkdir -p %t.dir
+// RUN: cp %s %t.dir/stream_output_input.cpp
+// RUN: mkdir %t.dir/Inputs
+// RUN: cp %S/Inputs/stream-output/module.modulemap %t.dir/Inputs/module.modulemap
+// RUN: cp %S/Inputs/stream-output/a.h %t.dir/Inputs/a.h
+// RUN: cp %S/Inputs/stream-output/b.h %t.dir/Inputs/b.h
+// RUN: sed -e "s|DIR|%/t.dir|g" %S/Inputs/stream-output/cdb.json > %t.cdb
+//
+// RUN: clang-scan-deps -compilation-database %t.cdb -j 1 -format experimental-full \
+// RUN:   -mode preprocess-minimized-sources -stream-output | FileCheck %s
+
+// Every module is printed on its own line after the modules it imports, and
+// the translation unit comes last.
+
+// CHECK-NOT: "translation-unit"
+// CHECK:     {"module":{{.*}}"name":"A"
+// CHECK-NOT: "translation-unit"
+// CHECK:     {"module":{{.*}}"clang-module-deps":[{"context-hash":"{{.*}}","module-name":"A"}]{{.*}}"name":"B"
+// CHECK-NEXT: {"translation-unit":{{.*}}"module-name":"B"{{.*}}"input-file":"{{.*}}stream_output_input.cpp"
+// CHECK-NOT: "module"
+
+#include "b.h"
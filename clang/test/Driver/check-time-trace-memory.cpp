@@ -0,0 +1,33 @@
+// RUN: %clangxx -### -c -ftime-trace -ftime-trace-memory %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=DRIVER %s
+// DRIVER: "-cc1"
+// DRIVER-SAME: "-ftime-trace"
+// DRIVER-SAME: "-ftime-trace-memory"
+
+// RUN: %clangxx -S -ftime-trace -ftime-trace-granularity=0 -ftime-trace-memory -o %T/check-time-trace-memory %s
+// RUN: cat %T/check-time-trace-memory.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s
+
+// RUN: %clangxx -S -ftime-trace -ftime-trace-granularity=0 -o %T/check-time-trace-no-memory %s
+// RUN: cat %T/check-time-trace-no-memory.json \
+// RUN:   | FileCheck --check-prefix=NOMEM %s
+
+// Both the sections and their per-name totals carry the heap usage change.
+// CHECK:      "mem delta": {{-?[0-9]+}}
+// CHECK:      "avg ms":
+// CHECK-NEXT: "count":
+// CHECK-NEXT: "mem delta": {{-?[0-9]+}}
+
+// NOMEM-NOT: mem delta
+
+template <typename T>
+struct Struct {
+  T Num;
+};
+
+int main() {
+  Struct<int> S;
+
+  return 0;
+}
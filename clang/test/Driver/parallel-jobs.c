@@ -0,0 +1,32 @@
+// REQUIRES: x86-registered-target
+
+// Check that invalid values of -parallel-jobs= are diagnosed before any job
+// runs.
+// RUN: %clang -### -parallel-jobs=0 -c %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=INVALID-0 %s
+// RUN: %clang -### -parallel-jobs=x -c %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=INVALID-X %s
+// INVALID-0: error: invalid integral value '0' in '-parallel-jobs=0'
+// INVALID-X: error: invalid integral value 'x' in '-parallel-jobs=x'
+
+// Check that independent compile jobs produce the same results as a serial
+// run: every object is written and the commands are printed in job order.
+// RUN: rm -rf %t && mkdir %t && cd %t
+// RUN: echo 'int second(void) { return 2; }' > second.c
+// RUN: %clang -target x86_64-unknown-linux -parallel-jobs=2 -v -c %s second.c \
+// RUN:   2>&1 | FileCheck --check-prefix=ORDER %s
+// RUN: ls parallel-jobs.o second.o
+// ORDER: "-cc1"
+// ORDER-SAME: "-main-file-name" "parallel-jobs.c"
+// ORDER: "-cc1"
+// ORDER-SAME: "-main-file-name" "second.c"
+
+// Check that a failing job doesn't stop the other one.
+// RUN: rm -f parallel-jobs.o
+// RUN: echo 'int broken(void) { return }' > broken.c
+// RUN: not %clang -target x86_64-unknown-linux -parallel-jobs=2 -c broken.c \
+// RUN:   %s 2>&1 | FileCheck --check-prefix=FAIL %s
+// RUN: ls parallel-jobs.o
+// FAIL: broken.c:1:{{[0-9]+}}: error: expected expression
+
+int first(void) { return 1; }
@@ -3,3 +3,14 @@
 
 // RUN: %clang -cc1as -triple i686 --compress-debug-sections %s -o /dev/null
 // RUN: %clang -cc1as -triple i686 -compress-debug-sections=zlib %s -o /dev/null
+
+// RUN: %clang -cc1as -triple i686 -compress-debug-sections=zlib -filetype obj %s -o %t.1.o
+// RUN: %clang -cc1as -triple i686 -compress-debug-sections=zlib -compress-debug-sections-threads=4 -filetype obj %s -o %t.4.o
+// RUN: cmp %t.1.o %t.4.o
+
+	.section	.debug_str,"MS",@progbits,1
+	.asciz	"perfectly compressable data sample *****************************************"
+	.section	.debug_abbrev,"",@progbits
+	.rept 64
+	.byte	0
+	.endr
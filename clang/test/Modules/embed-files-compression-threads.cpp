@@ -0,0 +1,20 @@
+// REQUIRES: zlib
+// REQUIRES: shell
+//
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: echo 'int a;' > %t/a.h
+// RUN: echo 'int b;' > %t/b.h
+// RUN: echo 'int c;' > %t/c.h
+// RUN: echo 'int d;' > %t/d.h
+// RUN: echo 'module m { header "a.h" header "b.h" header "c.h" header "d.h" }' > %t/modulemap
+//
+// Compressing the embedded files on several threads produces the same module
+// file as compressing them serially.
+//
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=m -emit-module %t/modulemap -fmodules-embed-all-files -o %t/m.pcm
+// RUN: mv %t/m.pcm %t/serial.pcm
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=m -emit-module %t/modulemap -fmodules-embed-all-files -fmodules-embed-compression-threads=4 -o %t/m.pcm
+// RUN: cmp %t/serial.pcm %t/m.pcm
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=m -emit-module %t/modulemap -fmodules-embed-all-files -fmodules-embed-compression-threads=0 -o %t/m.pcm
+// RUN: cmp %t/serial.pcm %t/m.pcm
@@ -12,6 +12,7 @@
 #include "clang/Tooling/DependencyScanning/DependencyScanningTool.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
 #include "clang/Tooling/JSONCompilationDatabase.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/InitLLVM.h"
@@ -20,6 +21,7 @@
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
+#include <functional>
 #include <mutex>
 #include <thread>
 
@@ -136,6 +138,14 @@ static llvm::cl::opt<bool> FullCommandLine(
     llvm::cl::desc("Include the full command lines to use to build modules"),
     llvm::cl::init(false), llvm::cl::cat(DependencyScannerCategory));
 
+static llvm::cl::opt<bool> StreamOutput(
+    "stream-output",
+    llvm::cl::desc("With -format=experimental-full, print every module and "
+                   "translation unit as a JSON object on its own line as soon "
+                   "as it has been scanned, rather than the whole graph once "
+                   "scanning has finished"),
+    llvm::cl::init(false), llvm::cl::cat(DependencyScannerCategory));
+
 llvm::cl::opt<unsigned>
     NumThreads("j", llvm::cl::Optional,
                llvm::cl::desc("Number of worker threads to use (default: use "
@@ -160,6 +170,12 @@ llvm::cl::opt<bool> SkipExcludedPPRanges(
         "until reaching the end directive."),
     llvm::cl::init(true), llvm::cl::cat(DependencyScannerCategory));
 
+llvm::cl::opt<std::string> MinimizedSourceCacheDir(
+    "minimized-source-cache-dir",
+    llvm::cl::desc("Directory in which to keep the minimized contents of "
+                   "source files between runs."),
+    llvm::cl::cat(DependencyScannerCategory));
+
 llvm::cl::opt<bool> Verbose("v", llvm::cl::Optional,
                             llvm::cl::desc("Use verbose output."),
                             llvm::cl::init(false),
@@ -238,6 +254,10 @@ static llvm::json::Array toJSONSorted(std::vector<ClangModuleDep> V) {
 // Thread safe.
 class FullDeps {
 public:
+  /// \param StreamOS if not null, modules and translation units are printed to
+  ///        it one per line as they are merged.
+  FullDeps(raw_ostream *StreamOS = nullptr) : StreamOS(StreamOS) {}
+
   void mergeDeps(StringRef Input, FullDependenciesResult FDR,
                  size_t InputIndex) {
     const FullDependencies &FD = FDR.FullDeps;
@@ -249,15 +269,20 @@ public:
     ID.ModuleDeps = std::move(FD.ClangModuleDeps);
 
     std::unique_lock<std::mutex> ul(Lock);
+    std::vector<const ModuleDeps *> NewModules;
     for (const ModuleDeps &MD : FDR.DiscoveredModules) {
       auto I = Modules.find({MD.ContextHash, MD.ModuleName, 0});
       if (I != Modules.end()) {
         I->first.InputIndex = std::min(I->first.InputIndex, InputIndex);
         continue;
       }
-      Modules.insert(
+      auto Inserted = Modules.insert(
           I, {{MD.ContextHash, MD.ModuleName, InputIndex}, std::move(MD)});
+      if (StreamOS)
+        NewModules.push_back(&Inserted->second);
     }
+    if (StreamOS)
+      printModules(NewModules);
 
     if (FullCommandLine)
       ID.AdditonalCommandLine = FD.getAdditionalCommandLine(
@@ -266,6 +291,12 @@ public:
             return lookupModuleDeps(CMD);
           });
 
+    // Modules are printed before the translation units that import them, so
+    // consumers can start building them right away.
+    if (StreamOS) {
+      printLine(llvm::json::Object{{"translation-unit", toJSON(ID)}});
+      return;
+    }
     Inputs.push_back(std::move(ID));
   }
 
@@ -287,37 +318,12 @@ public:
     using namespace llvm::json;
 
     Array OutModules;
-    for (auto &&ModName : ModuleNames) {
-      auto &MD = Modules[ModName];
-      Object O{
-          {"name", MD.ModuleName},
-          {"context-hash", MD.ContextHash},
-          {"file-deps", toJSONSorted(MD.FileDeps)},
-          {"clang-module-deps", toJSONSorted(MD.ClangModuleDeps)},
-          {"clang-modulemap-file", MD.ClangModuleMapFile},
-          {"command-line",
-           FullCommandLine
-               ? MD.getFullCommandLine(
-                     [&](ClangModuleDep CMD) { return lookupPCMPath(CMD); },
-                     [&](ClangModuleDep CMD) -> const ModuleDeps & {
-                       return lookupModuleDeps(CMD);
-                     })
-               : MD.NonPathCommandLine},
-      };
-      OutModules.push_back(std::move(O));
-    }
+    for (auto &&ModName : ModuleNames)
+      OutModules.push_back(toJSON(Modules[ModName]));
 
     Array TUs;
-    for (auto &&I : Inputs) {
-      Object O{
-          {"input-file", I.FileName},
-          {"clang-context-hash", I.ContextHash},
-          {"file-deps", I.FileDeps},
-          {"clang-module-deps", toJSONSorted(I.ModuleDeps)},
-          {"command-line", I.AdditonalCommandLine},
-      };
-      TUs.push_back(std::move(O));
-    }
+    for (auto &&I : Inputs)
+      TUs.push_back(toJSON(I));
 
     Object Output{
         {"modules", std::move(OutModules)},
@@ -328,9 +334,61 @@ public:
   }
 
 private:
+  struct InputDeps;
+
+  llvm::json::Object toJSON(const ModuleDeps &MD) {
+    return llvm::json::Object{
+        {"name", MD.ModuleName},
+        {"context-hash", MD.ContextHash},
+        {"file-deps", toJSONSorted(MD.FileDeps)},
+        {"clang-module-deps", toJSONSorted(MD.ClangModuleDeps)},
+        {"clang-modulemap-file", MD.ClangModuleMapFile},
+        {"command-line",
+         FullCommandLine
+             ? MD.getFullCommandLine(
+                   [&](ClangModuleDep CMD) { return lookupPCMPath(CMD); },
+                   [&](ClangModuleDep CMD) -> const ModuleDeps & {
+                     return lookupModuleDeps(CMD);
+                   })
+             : MD.NonPathCommandLine},
+    };
+  }
+
+  static llvm::json::Object toJSON(const InputDeps &I) {
+    return llvm::json::Object{
+        {"input-file", I.FileName},
+        {"clang-context-hash", I.ContextHash},
+        {"file-deps", I.FileDeps},
+        {"clang-module-deps", toJSONSorted(I.ModuleDeps)},
+        {"command-line", I.AdditonalCommandLine},
+    };
+  }
+
+  /// Print \p O to \c StreamOS on a single line. Expects \c Lock to be held.
+  void printLine(llvm::json::Object O) {
+    *StreamOS << llvm::json::Value(std::move(O)) << "\n";
+    StreamOS->flush();
+  }
+
+  /// Print the modules in \p NewModules to \c StreamOS, each after the
+  /// modules it depends on. Expects \c Lock to be held, and every dependency
+  /// of these modules to have been merged already.
+  void printModules(ArrayRef<const ModuleDeps *> NewModules) {
+    llvm::DenseSet<const ModuleDeps *> Unprinted(NewModules.begin(),
+                                                  NewModules.end());
+    std::function<void(const ModuleDeps &)> Print = [&](const ModuleDeps &MD) {
+      if (!Unprinted.erase(&MD))
+        return;
+      for (const ClangModuleDep &CMD : MD.ClangModuleDeps)
+        Print(lookupModuleDeps(CMD));
+      printLine(llvm::json::Object{{"module", toJSON(MD)}});
+    };
+    for (const ModuleDeps *MD : NewModules)
+      Print(*MD);
+  }
+
   StringRef lookupPCMPath(ClangModuleDep CMD) {
-    return Modules[ContextModulePair{CMD.ContextHash, CMD.ModuleName, 0}]
-        .ImplicitModulePCMPath;
+    return lookupModuleDeps(CMD).ImplicitModulePCMPath;
   }
 
   const ModuleDeps &lookupModuleDeps(ClangModuleDep CMD) {
@@ -370,6 +428,7 @@ private:
   std::unordered_map<ContextModulePair, ModuleDeps, ContextModulePairHasher>
       Modules;
   std::vector<InputDeps> Inputs;
+  raw_ostream *StreamOS;
 };
 
 static bool handleFullDependencyToolResult(
@@ -486,6 +545,15 @@ int main(int argc, const char **argv) {
 
   DependencyScanningService Service(ScanMode, Format, ReuseFileManager,
                                     SkipExcludedPPRanges);
+  if (!MinimizedSourceCacheDir.empty()) {
+    if (std::error_code EC =
+            llvm::sys::fs::create_directories(MinimizedSourceCacheDir)) {
+      llvm::errs() << "error: could not create '" << MinimizedSourceCacheDir
+                   << "': " << EC.message() << "\n";
+      return 1;
+    }
+    Service.getSharedCache().setPersistentCacheDir(MinimizedSourceCacheDir);
+  }
   llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
   std::vector<std::unique_ptr<DependencyScanningTool>> WorkerTools;
   for (unsigned I = 0; I < Pool.getThreadCount(); ++I)
@@ -497,7 +565,7 @@ int main(int argc, const char **argv) {
     Inputs.emplace_back(Cmd);
 
   std::atomic<bool> HadErrors(false);
-  FullDeps FD;
+  FullDeps FD(StreamOutput ? &llvm::outs() : nullptr);
   std::mutex Lock;
   size_t Index = 0;
 
@@ -543,7 +611,7 @@ int main(int argc, const char **argv) {
   }
   Pool.wait();
 
-  if (Format == ScanningOutputFormat::Full)
+  if (Format == ScanningOutputFormat::Full && !StreamOutput)
     FD.printFullOutput(llvm::outs());
 
   return HadErrors;
@@ -99,6 +99,7 @@ struct AssemblerInvocation {
   std::map<const std::string, const std::string> DebugPrefixMap;
   llvm::DebugCompressionType CompressDebugSections =
       llvm::DebugCompressionType::None;
+  unsigned CompressDebugSectionsThreads = 1;
   std::string MainFileName;
   std::string SplitDwarfOutput;
 
@@ -231,6 +232,8 @@ bool AssemblerInvocation::CreateFromArgs(AssemblerInvocation &Opts,
             .Case("zlib-gnu", llvm::DebugCompressionType::GNU)
             .Default(llvm::DebugCompressionType::None);
   }
+  Opts.CompressDebugSectionsThreads = getLastArgIntValue(
+      Args, OPT_compress_debug_sections_threads_EQ, 1, Diags);
 
   Opts.RelaxELFRelocations = Args.hasArg(OPT_mrelax_relocations);
   if (auto *DwarfFormatArg = Args.getLastArg(OPT_gdwarf64, OPT_gdwarf32))
@@ -369,6 +372,7 @@ static bool ExecuteAssembler(AssemblerInvocation &Opts,
   // Ensure MCAsmInfo initialization occurs before any use, otherwise sections
   // may be created with a combination of default and explicit settings.
   MAI->setCompressDebugSections(Opts.CompressDebugSections);
+  MAI->setCompressDebugSectionsThreads(Opts.CompressDebugSectionsThreads);
 
   MAI->setRelaxELFRelocations(Opts.RelaxELFRelocations);
 
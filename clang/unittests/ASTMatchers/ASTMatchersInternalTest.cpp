@@ -111,6 +111,32 @@ TEST(MatchFinder, CheckProfiling) {
   EXPECT_EQ("MyID", Records.begin()->getKey());
 }
 
+TEST(MatchFinder, RunsNameBasedMatchersInOrder) {
+  struct LoggingCallback : public MatchFinder::MatchCallback {
+    LoggingCallback(std::string &Log, char Tag) : Log(Log), Tag(Tag) {}
+    void run(const MatchFinder::MatchResult &Result) override {
+      Log += Tag;
+    }
+    std::string &Log;
+    char Tag;
+  };
+  std::string Log;
+  LoggingCallback A(Log, 'a'), B(Log, 'b'), C(Log, 'c'), D(Log, 'd'),
+      E(Log, 'e');
+  MatchFinder Finder;
+  Finder.addMatcher(functionDecl(hasName("f")), &A);
+  Finder.addMatcher(functionDecl(), &B);
+  Finder.addMatcher(functionDecl(hasAnyName("::ns::g", "f")).bind("x"), &C);
+  Finder.addMatcher(namedDecl(unless(hasName("f")), hasName("g")), &D);
+  Finder.addMatcher(cxxConstructorDecl(hasName("S")), &E);
+  std::unique_ptr<FrontendActionFactory> Factory(
+      newFrontendActionFactory(&Finder));
+  ASSERT_TRUE(tooling::runToolOnCode(
+      Factory->create(), "void f(); namespace ns { void g(); }\n"
+                         "struct S { S(); };"));
+  EXPECT_EQ("abcbcdbe", Log);
+}
+
 class VerifyStartOfTranslationUnit : public MatchFinder::MatchCallback {
 public:
   VerifyStartOfTranslationUnit() : Called(false) {}
@@ -243,6 +243,33 @@ TEST_F(FileManagerTest, getFileReturnsErrorForNonexistentFile) {
   ASSERT_EQ(readingFileAsDir.getError(), std::errc::not_a_directory);
 }
 
+TEST_F(FileManagerTest, clearFailedLookups) {
+  auto statCache = std::make_unique<FakeStatCache>();
+  statCache->InjectDirectory(".", 41);
+  statCache->InjectFile("foo.cpp", 42);
+  FakeStatCache *Cache = statCache.get();
+  manager.setStatCache(std::move(statCache));
+
+  auto foo = manager.getFileRef("foo.cpp");
+  ASSERT_FALSE(!foo);
+  EXPECT_FALSE(manager.getFile("bar.cpp"));
+  EXPECT_FALSE(manager.getDirectory("MyDirectory"));
+
+  // The failures are cached.
+  Cache->InjectFile("bar.cpp", 43);
+  Cache->InjectDirectory("MyDirectory", 49);
+  EXPECT_FALSE(manager.getFile("bar.cpp"));
+  EXPECT_FALSE(manager.getDirectory("MyDirectory"));
+
+  // Until they are cleared, while the successful lookups stay the same.
+  manager.clearFailedLookups();
+  EXPECT_TRUE(manager.getFile("bar.cpp"));
+  EXPECT_TRUE(manager.getDirectory("MyDirectory"));
+  auto foo2 = manager.getFileRef("foo.cpp");
+  ASSERT_FALSE(!foo2);
+  EXPECT_TRUE(foo->isSameRef(*foo2));
+}
+
 // The following tests apply to Unix-like system only.
 
 #ifndef _WIN32
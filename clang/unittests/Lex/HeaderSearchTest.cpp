@@ -15,6 +15,7 @@
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/TargetOptions.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchDirectoryIndex.h"
 #include "clang/Lex/HeaderSearchOptions.h"
 #include "clang/Serialization/InMemoryModuleCache.h"
 #include "gtest/gtest.h"
@@ -136,5 +137,34 @@ TEST_F(HeaderSearchTest, IncludeFromSameDirectory) {
             "y/z/t.h");
 }
 
+TEST_F(HeaderSearchTest, DirectoryIndex) {
+  Search.getHeaderSearchOpts().DirectoryIndex =
+      std::make_shared<HeaderSearchDirectoryIndex>();
+  addSearchDir("/a");
+  addSearchDir("/b");
+  VFS->addFile("/b/x.h", 0, llvm::MemoryBuffer::getMemBuffer(""));
+  VFS->addFile("/b/sub/y.h", 0, llvm::MemoryBuffer::getMemBuffer(""));
+
+  auto Lookup = [&](StringRef Filename) {
+    const DirectoryLookup *CurDir = nullptr;
+    return Search.LookupFile(Filename, SourceLocation(), /*isAngled=*/false,
+                             /*FromDir=*/nullptr, CurDir, /*Includers=*/None,
+                             /*SearchPath=*/nullptr, /*RelativePath=*/nullptr,
+                             /*RequestingModule=*/nullptr,
+                             /*SuggestedModule=*/nullptr, /*IsMapped=*/nullptr,
+                             /*IsFrameworkFound=*/nullptr);
+  };
+
+  auto X = Lookup("x.h");
+  ASSERT_TRUE(X);
+  EXPECT_EQ(X->getName(), "/b/x.h");
+  EXPECT_TRUE(Lookup("sub/y.h"));
+  EXPECT_TRUE(Lookup("./x.h"));
+
+  // Directories are assumed not to change once they've been listed.
+  VFS->addFile("/a/z.h", 0, llvm::MemoryBuffer::getMemBuffer(""));
+  EXPECT_FALSE(Lookup("z.h"));
+}
+
 } // namespace
 } // namespace clang
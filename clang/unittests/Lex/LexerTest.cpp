@@ -482,6 +482,18 @@ TEST_F(LexerTest, AvoidPastEndOfStringDereference) {
   EXPECT_TRUE(Lex("#include <\\\\\n").empty());
 }
 
+TEST_F(LexerTest, LongLineComments) {
+  // Line comments are skipped in blocks, so vary where their end falls.
+  for (unsigned Length = 0; Length != 40; ++Length) {
+    std::string Comment = "//" + std::string(Length, 'x');
+    CheckLex(Comment + "\nint", {tok::kw_int});
+    CheckLex(Comment + "\r\nint", {tok::kw_int});
+    CheckLex(Comment + "\\\nint\nint", {tok::kw_int});
+    CheckLex(Comment + "\\\n" + Comment + "\nint", {tok::kw_int});
+    EXPECT_TRUE(Lex(Comment).empty());
+  }
+}
+
 TEST_F(LexerTest, StringizingRasString) {
   // For "std::string Lexer::Stringify(StringRef Str, bool Charify)".
   std::string String1 = R"(foo
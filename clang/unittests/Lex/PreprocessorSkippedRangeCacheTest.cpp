@@ -0,0 +1,147 @@
+//===- unittests/Lex/PreprocessorSkippedRangeCacheTest.cpp ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/PreprocessorSkippedRangeCache.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TargetOptions.h"
+#include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchOptions.h"
+#include "clang/Lex/ModuleLoader.h"
+#include "clang/Lex/Preprocessor.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+using ::testing::ElementsAre;
+
+namespace {
+
+class PreprocessorSkippedRangeCacheTest : public ::testing::Test {
+protected:
+  PreprocessorSkippedRangeCacheTest()
+      : FS(new llvm::vfs::InMemoryFileSystem), DiagID(new DiagnosticIDs()),
+        Diags(DiagID, new DiagnosticOptions, new IgnoringDiagConsumer()),
+        TargetOpts(new TargetOptions), FileMgr(FileSystemOptions(), FS),
+        Cache(std::make_shared<PreprocessorSkippedRangeCache>()) {
+    TargetOpts->Triple = "x86_64-apple-darwin11.1.0";
+    Target = TargetInfo::CreateTargetInfo(Diags, TargetOpts);
+  }
+
+  void addFile(StringRef Name, StringRef Contents) {
+    FS->addFile(Name, /*ModificationTime=*/0,
+                llvm::MemoryBuffer::getMemBufferCopy(Contents));
+  }
+
+  /// Preprocess \p Name in a fresh preprocessor that uses \c Cache, as
+  /// another translation unit would, and return the spelling of its tokens.
+  std::vector<std::string> preprocess(StringRef Name) {
+    FileManager FileMgr(FileSystemOptions(), FS);
+    SourceManager SourceMgr(Diags, FileMgr);
+    auto File = FileMgr.getFile(Name);
+    EXPECT_TRUE(File);
+    if (!File)
+      return {};
+    SourceMgr.setMainFileID(
+        SourceMgr.createFileID(*File, SourceLocation(), SrcMgr::C_User));
+
+    TrivialModuleLoader ModLoader;
+    HeaderSearch HeaderInfo(std::make_shared<HeaderSearchOptions>(), SourceMgr,
+                            Diags, LangOpts, Target.get());
+    auto PPOpts = std::make_shared<PreprocessorOptions>();
+    PPOpts->SkippedRangeCache = Cache;
+    Preprocessor PP(PPOpts, Diags, LangOpts, SourceMgr, HeaderInfo, ModLoader,
+                    /*IILookup =*/nullptr,
+                    /*OwnsHeaderSearch =*/false);
+    PP.Initialize(*Target);
+    PP.EnterMainSourceFile();
+
+    std::vector<std::string> Tokens;
+    while (true) {
+      Token Tok;
+      PP.Lex(Tok);
+      if (Tok.is(tok::eof))
+        break;
+      Tokens.push_back(PP.getSpelling(Tok));
+    }
+    return Tokens;
+  }
+
+  /// Get a file entry that's separate from the ones the preprocessors use.
+  const FileEntry *getFile(StringRef Name) {
+    auto File = FileMgr.getFile(Name);
+    return File ? *File : nullptr;
+  }
+
+  IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> FS;
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID;
+  DiagnosticsEngine Diags;
+  LangOptions LangOpts;
+  std::shared_ptr<TargetOptions> TargetOpts;
+  IntrusiveRefCntPtr<TargetInfo> Target;
+  FileManager FileMgr;
+  std::shared_ptr<PreprocessorSkippedRangeCache> Cache;
+};
+
+TEST_F(PreprocessorSkippedRangeCacheTest, RecordsExcludedBlocks) {
+  StringRef Source = "#if 0\n"
+                     "int a;\n"
+                     "#if 1\n"
+                     "#else\n"
+                     "#endif\n"
+                     "#elif 0\n"
+                     "int b;\n"
+                     "#else\n"
+                     "int c;\n"
+                     "#endif\n"
+                     "#ifdef FOO\n"
+                     "int d;\n"
+                     "#endif\n";
+  addFile("/main.c", Source);
+
+  EXPECT_THAT(preprocess("/main.c"), ElementsAre("int", "c", ";"));
+
+  const FileEntry *File = getFile("/main.c");
+  ASSERT_TRUE(File);
+  size_t Elif = Source.find("#elif");
+  EXPECT_EQ(Cache->lookup(*File, 0).getValueOr(0), Elif);
+  EXPECT_EQ(Cache->lookup(*File, Elif).getValueOr(0),
+            Source.find("#else\nint c") - Elif);
+  size_t Ifdef = Source.find("#ifdef");
+  EXPECT_EQ(Cache->lookup(*File, Ifdef).getValueOr(0),
+            Source.rfind("#endif") - Ifdef);
+  // Blocks nested in excluded blocks are never entered, so not recorded.
+  EXPECT_FALSE(Cache->lookup(*File, Source.find("#if 1")));
+
+  EXPECT_THAT(preprocess("/main.c"), ElementsAre("int", "c", ";"));
+}
+
+TEST_F(PreprocessorSkippedRangeCacheTest, JumpsOverRecordedBlocks) {
+  StringRef Source = "#if 0\n"
+                     "int a;\n"
+                     "#else\n"
+                     "int b;\n"
+                     "#endif\n"
+                     "int c;\n";
+  addFile("/main.c", Source);
+  const FileEntry *File = getFile("/main.c");
+  ASSERT_TRUE(File);
+
+  // Pretend that the '#else' is part of the excluded block, which can only
+  // make a difference if the preprocessor jumps over it.
+  Cache->insert(*File, 0, Source.find("#endif"));
+  EXPECT_THAT(preprocess("/main.c"), ElementsAre("int", "c", ";"));
+}
+
+} // anonymous namespace
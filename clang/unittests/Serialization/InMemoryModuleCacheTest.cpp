@@ -116,4 +116,42 @@ TEST(InMemoryModuleCacheTest, finalizePCM) {
   EXPECT_TRUE(Cache.isPCMFinal("B"));
 }
 
+TEST(InMemoryModuleCacheTest, sharedBuffers) {
+  IntrusiveRefCntPtr<SharedModuleBufferCache> Shared(
+      new SharedModuleBufferCache());
+  EXPECT_EQ(nullptr, Shared->lookup("B", 6, 1));
+
+  auto B = getBuffer(1);
+  auto *RawB = B.get();
+  EXPECT_EQ(RawB, Shared->insert("B", 6, 1, std::move(B)).get());
+  EXPECT_EQ(RawB, Shared->lookup("B", 6, 1).get());
+
+  // A different version of the file misses.
+  EXPECT_EQ(nullptr, Shared->lookup("B", 6, 2));
+  EXPECT_EQ(nullptr, Shared->lookup("B", 7, 1));
+
+  // Inserting the same version again keeps the first buffer.
+  EXPECT_EQ(RawB, Shared->insert("B", 6, 1, getBuffer(2)).get());
+
+  // Caches sharing the buffer see the same one.
+  InMemoryModuleCache Cache1, Cache2;
+  Cache1.setSharedBuffers(Shared);
+  EXPECT_EQ(Shared.get(), Cache1.getSharedBuffers());
+  EXPECT_EQ(nullptr, Cache2.getSharedBuffers());
+  EXPECT_EQ(RawB, &Cache1.addPCM("B", Shared->lookup("B", 6, 1)));
+  EXPECT_EQ(RawB, &Cache2.addPCM("B", Shared->lookup("B", 6, 1)));
+
+  // Replacing the version in the shared cache leaves users of the old one
+  // alone.
+  auto B2 = getBuffer(2);
+  auto *RawB2 = B2.get();
+  EXPECT_EQ(RawB2, Shared->insert("B", 6, 2, std::move(B2)).get());
+  EXPECT_EQ(nullptr, Shared->lookup("B", 6, 1));
+  EXPECT_EQ(RawB, Cache1.lookupPCM("B"));
+
+  // Dropping a tentative PCM from one cache doesn't affect another.
+  EXPECT_FALSE(Cache1.tryToDropPCM("B"));
+  EXPECT_EQ(RawB, Cache2.lookupPCM("B"));
+}
+
 } // namespace
@@ -12,6 +12,85 @@
 
 #include "int_lib.h"
 
+// Returns the 64 bit division result by 32 bit. Result must fit in 32 bits.
+// Remainder stored in r.
+// This is udiv128by64to64default from udivmodti4.c at half the width; for a
+// correctness proof see Knuth, Volume 2, section 4.3.1, Algorithm D.
+UNUSED
+static inline su_int udiv64by32to32default(su_int u1, su_int u0, su_int v,
+                                           su_int *r) {
+  const unsigned n_uword_bits = sizeof(su_int) * CHAR_BIT;
+  const su_int b = (1U << (n_uword_bits / 2)); // Number base (16 bits)
+  su_int un1, un0;                             // Norm. dividend LSD's
+  su_int vn1, vn0;                             // Norm. divisor digits
+  su_int q1, q0;                               // Quotient digits
+  su_int un32, un21, un10;                     // Dividend digit pairs
+  su_int rhat;                                 // A remainder
+  si_int s;                                    // Shift amount for normalization
+
+  s = clzsi(v);
+  if (s > 0) {
+    // Normalize the divisor.
+    v = v << s;
+    un32 = (u1 << s) | (u0 >> (n_uword_bits - s));
+    un10 = u0 << s; // Shift dividend left
+  } else {
+    // Avoid undefined behavior of (u0 >> 32).
+    un32 = u1;
+    un10 = u0;
+  }
+
+  // Break divisor up into two 16-bit digits.
+  vn1 = v >> (n_uword_bits / 2);
+  vn0 = v & 0xFFFF;
+
+  // Break right half of dividend into two digits.
+  un1 = un10 >> (n_uword_bits / 2);
+  un0 = un10 & 0xFFFF;
+
+  // Compute the first quotient digit, q1.
+  q1 = un32 / vn1;
+  rhat = un32 - q1 * vn1;
+
+  // q1 has at most error 2. No more than 2 iterations.
+  while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+    q1 = q1 - 1;
+    rhat = rhat + vn1;
+    if (rhat >= b)
+      break;
+  }
+
+  un21 = un32 * b + un1 - q1 * v;
+
+  // Compute the second quotient digit.
+  q0 = un21 / vn1;
+  rhat = un21 - q0 * vn1;
+
+  // q0 has at most error 2. No more than 2 iterations.
+  while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+    q0 = q0 - 1;
+    rhat = rhat + vn1;
+    if (rhat >= b)
+      break;
+  }
+
+  *r = (un21 * b + un0 - q0 * v) >> s;
+  return q1 * b + q0;
+}
+
+static inline su_int udiv64by32to32(su_int u1, su_int u0, su_int v,
+                                    su_int *r) {
+#if defined(__i386__)
+  su_int result;
+  __asm__("divl %[v]"
+          : "=a"(result), "=d"(*r)
+          : [ v ] "r"(v), "a"(u0), "d"(u1));
+  return result;
+#else
+  return udiv64by32to32default(u1, u0, v, r);
+#endif
+}
+
 // Effects: if rem != 0, *rem = a % b
 // Returns: a / b
 
@@ -120,27 +199,19 @@ COMPILER_RT_ABI du_int __udivmoddi4(du_int a, du_int b, du_int *rem) {
       // K X
       // ---
       // 0 K
-      sr = 1 + n_uword_bits + clzsi(d.s.low) - clzsi(n.s.high);
-      // 2 <= sr <= n_udword_bits - 1
-      // q.all = n.all << (n_udword_bits - sr);
-      // r.all = n.all >> sr;
-      if (sr == n_uword_bits) {
-        q.s.low = 0;
-        q.s.high = n.s.low;
-        r.s.high = 0;
-        r.s.low = n.s.high;
-      } else if (sr < n_uword_bits) /* 2 <= sr <= n_uword_bits - 1 */ {
-        q.s.low = 0;
-        q.s.high = n.s.low << (n_uword_bits - sr);
-        r.s.high = n.s.high >> sr;
-        r.s.low = (n.s.high << (n_uword_bits - sr)) | (n.s.low >> sr);
-      } else /* n_uword_bits + 1 <= sr <= n_udword_bits - 1 */ {
-        q.s.low = n.s.low << (n_udword_bits - sr);
-        q.s.high = (n.s.high << (n_udword_bits - sr)) |
-                   (n.s.low >> (sr - n_uword_bits));
-        r.s.high = 0;
-        r.s.low = n.s.high >> (sr - n_uword_bits);
+      // Divide digit by digit instead of bit by bit, as in __udivmodti4.
+      // First divide the high part so that n.s.high < d.s.low, which makes
+      // the rest of the quotient fit in a single word.
+      q.s.high = 0;
+      if (n.s.high >= d.s.low) {
+        q.s.high = n.s.high / d.s.low;
+        n.s.high = n.s.high % d.s.low;
       }
+      r.s.high = 0;
+      q.s.low = udiv64by32to32(n.s.high, n.s.low, d.s.low, &r.s.low);
+      if (rem)
+        *rem = r.all;
+      return q.all;
     } else {
       // K X
       // ---
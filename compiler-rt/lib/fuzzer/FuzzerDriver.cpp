@@ -761,6 +761,8 @@ int FuzzerDriver(int *argc, char ***argv, UserCallback Callback) {
     Options.FeaturesDir = Flags.features_dir;
     ValidateDirectoryExists(Options.FeaturesDir, Flags.create_missing_dirs);
   }
+  if (Flags.shared_features)
+    Options.SharedFeaturesFile = Flags.shared_features;
   if (Flags.mutation_graph_file)
     Options.MutationGraphFile = Flags.mutation_graph_file;
   if (Flags.collect_data_flow)
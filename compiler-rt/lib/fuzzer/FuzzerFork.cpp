@@ -93,6 +93,8 @@ struct GlobalEnv {
   std::string DFTDir;
   std::string DataFlowBinary;
   Set<uint32_t> Features, Cov;
+  SharedFeatureSet SharedFeatures;
+  std::string SharedFeaturesFile;
   Set<std::string> FilesWithDFT;
   Vector<std::string> Files;
   Random *Rand;
@@ -126,6 +128,8 @@ struct GlobalEnv {
     Cmd.addFlag("print_funcs", "0");  // no need to spend time symbolizing.
     Cmd.addFlag("max_total_time", std::to_string(std::min((size_t)300, JobId)));
     Cmd.addFlag("stop_file", StopFile());
+    if (SharedFeatures.IsMapped())
+      Cmd.addFlag("shared_features", SharedFeaturesFile);
     if (!DataFlowBinary.empty()) {
       Cmd.addFlag("data_flow_trace", DFTDir);
       if (!Cmd.hasFlag("focus_function"))
@@ -223,6 +227,9 @@ struct GlobalEnv {
     }
     Features.insert(NewFeatures.begin(), NewFeatures.end());
     Cov.insert(NewCov.begin(), NewCov.end());
+    if (SharedFeatures.IsMapped())
+      for (auto Ft : NewFeatures)
+        SharedFeatures.Add(Ft);
     for (auto Idx : NewCov)
       if (auto *TE = TPC.PCTableEntryByIdx(Idx))
         if (TPC.PcIsFuncEntry(TE))
@@ -323,6 +330,13 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
     Env.Cov.insert(NewFeatures.begin(), NewFeatures.end());
     RemoveFile(CFPath);
   }
+  // Let the jobs know about the features of the seed corpus, and about each
+  // other's discoveries, through a shared bitmap.
+  Env.SharedFeaturesFile = DirPlusFile(Env.TempDir, "features.bitmap");
+  if (Env.SharedFeatures.Map(Env.SharedFeaturesFile))
+    for (auto Ft : Env.Features)
+      Env.SharedFeatures.Add(Ft);
+
   Printf("INFO: -fork=%d: %zd seed inputs, starting to fuzz in %s\n", NumJobs,
          Env.Files.size(), Env.TempDir.c_str());
 
@@ -10,12 +10,55 @@
 #define LLVM_FUZZER_FORK_H
 
 #include "FuzzerDefs.h"
+#include "FuzzerIO.h"
 #include "FuzzerOptions.h"
 #include "FuzzerRandom.h"
 
+#include <atomic>
 #include <string>
 
 namespace fuzzer {
+
+// The set of features found by all the processes of a -fork run. It is kept
+// in a file mapped by each of them, so discoveries propagate to the other
+// jobs immediately. Jobs only save inputs with features nobody found yet,
+// which saves both the disk writes and the parent's merge work.
+class SharedFeatureSet {
+public:
+  // Same granularity as the features tracked by the corpus.
+  static const size_t kNumFeatures = 1 << 21;
+  static const size_t kMapSize = kNumFeatures / 8;
+
+  bool Map(const std::string &Path) {
+    Words = reinterpret_cast<std::atomic<uint64_t> *>(
+        MapSharedFile(Path, kMapSize));
+    return Words != nullptr;
+  }
+
+  bool IsMapped() const { return Words != nullptr; }
+
+  // Adds Feature to the set. Returns true if it wasn't in the set already.
+  bool Add(uint32_t Feature) {
+    size_t Idx = Feature % kNumFeatures;
+    uint64_t Mask = 1ULL << (Idx % 64);
+    return !(Words[Idx / 64].fetch_or(Mask, std::memory_order_relaxed) & Mask);
+  }
+
+  // Adds all of Features to the set. Returns true if any of them wasn't in the
+  // set already, or if the set isn't mapped.
+  bool AddAll(const Vector<uint32_t> &Features) {
+    if (!IsMapped())
+      return true;
+    bool AnyNew = false;
+    for (uint32_t Feature : Features)
+      AnyNew |= Add(Feature);
+    return AnyNew;
+  }
+
+private:
+  std::atomic<uint64_t> *Words = nullptr;
+};
+
 void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
                   const Vector<std::string> &Args,
                   const Vector<std::string> &CorpusDirs, int NumJobs);
@@ -107,6 +107,11 @@ void RmDir(const std::string &Path);
 
 const std::string &getDevNull();
 
+// Maps Size bytes of the file at Path, creating it and growing it as needed,
+// so that the mapping is shared with all the processes mapping the same file.
+// Returns nullptr on failure or if the platform doesn't support it.
+uint8_t *MapSharedFile(const std::string &Path, size_t Size);
+
 }  // namespace fuzzer
 
 #endif  // LLVM_FUZZER_IO_H
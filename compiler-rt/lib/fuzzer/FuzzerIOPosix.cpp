@@ -15,9 +15,11 @@
 #include <cstdarg>
 #include <cstdio>
 #include <dirent.h>
+#include <fcntl.h>
 #include <fstream>
 #include <iterator>
 #include <libgen.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -175,6 +177,25 @@ const std::string &getDevNull() {
   return devNull;
 }
 
+uint8_t *MapSharedFile(const std::string &Path, size_t Size) {
+#if LIBFUZZER_FUCHSIA
+  return nullptr;
+#else
+  int Fd = open(Path.c_str(), O_RDWR | O_CREAT, 0600);
+  if (Fd < 0)
+    return nullptr;
+  struct stat St;
+  if (fstat(Fd, &St) || (static_cast<size_t>(St.st_size) < Size &&
+                         ftruncate(Fd, static_cast<off_t>(Size)))) {
+    close(Fd);
+    return nullptr;
+  }
+  void *Mem = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+  close(Fd);
+  return Mem == MAP_FAILED ? nullptr : static_cast<uint8_t *>(Mem);
+#endif
+}
+
 }  // namespace fuzzer
 
 #endif // LIBFUZZER_POSIX
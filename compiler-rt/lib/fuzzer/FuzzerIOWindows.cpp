@@ -420,6 +420,10 @@ const std::string &getDevNull() {
   return devNull;
 }
 
+uint8_t *MapSharedFile(const std::string &Path, size_t Size) {
+  return nullptr;
+}
+
 }  // namespace fuzzer
 
 #endif // LIBFUZZER_WINDOWS
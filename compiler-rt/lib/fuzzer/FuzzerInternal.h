@@ -14,6 +14,7 @@
 #include "FuzzerDataFlowTrace.h"
 #include "FuzzerDefs.h"
 #include "FuzzerExtFunctions.h"
+#include "FuzzerFork.h"
 #include "FuzzerInterface.h"
 #include "FuzzerOptions.h"
 #include "FuzzerSHA1.h"
@@ -116,6 +117,12 @@ private:
 
   bool GracefulExitRequested = false;
 
+  // Features found by all the jobs of a -fork run, if this is one of them.
+  SharedFeatureSet SharedFeatures;
+  // Whether the last unit added by RunOne() only has features already found
+  // by other jobs, in which case it isn't written to the output corpus.
+  bool LastNewUnitFoundElsewhere = false;
+
   size_t TotalNumberOfRuns = 0;
   size_t NumberOfNewUnitsAdded = 0;
 
@@ -237,6 +237,7 @@ struct MemInfoBlock {
            "MinAccessCount/MaxAccessCount/AveLifetime/MinLifetime/MaxLifetime/"
            "NumMigratedCpu/NumLifetimeOverlaps/NumSameAllocCpu/"
            "NumSameDeallocCpu\n");
+    Printf("STACK:StackID/PC/...\n");
   }
 
   void Merge(MemInfoBlock &newMIB) {
@@ -270,12 +271,26 @@ struct MemInfoBlock {
 static u32 AccessCount = 0;
 static u32 MissCount = 0;
 
+// Prints the allocation context of a MIB in the terse format, as the
+// addresses of the calls in its stack, innermost first. Together with the
+// module map (print_module_map=1), this maps the MIB back to its allocation
+// site and calling context in the binary.
+static void PrintAllocContext(u64 id) {
+  StackTrace stack = StackDepotGet(id);
+  Printf("STACK:%llu", id);
+  for (uptr i = 0; i < stack.size; i++)
+    Printf("/0x%zx", StackTrace::GetPreviousInstructionPc(stack.trace[i]));
+  Printf("\n");
+}
+
 struct SetEntry {
   SetEntry() : id(0), MIB() {}
   bool Empty() { return id == 0; }
   void Print() {
     CHECK(!Empty());
     MIB.Print(id);
+    if (flags()->print_terse)
+      PrintAllocContext(id);
   }
   // The stack id
   u64 id;
@@ -326,4 +326,13 @@ extern char INSTR_PROF_PROFILE_NAME_VAR[1]; /* __llvm_profile_filename. */
  */
 COMPILER_RT_VISIBILITY extern intptr_t __llvm_profile_counter_bias;
 
+/*!
+ * This variable is a weak symbol defined in InstrProfilingShardsVar.c. The
+ * compiler emits an overriding definition when the counters of each function
+ * are sharded between threads (-instrprof-counter-shards). The shards are then
+ * folded into the first one before the profile is written. This variable has
+ * hidden visibility.
+ */
+COMPILER_RT_VISIBILITY extern uint32_t __llvm_profile_counter_shards;
+
 #endif /* PROFILE_INSTRPROFILING_H_ */
@@ -546,6 +546,10 @@ static void initializeProfileForContinuousMode(void) {
   if (!__llvm_profile_is_continuous_mode_enabled())
     return;
 
+  if (__llvm_profile_counter_shards > 1)
+    PROF_WARN("%s\n", "Counter shards are never folded in continuous mode, so "
+                      "the profile only reflects the first shard.");
+
 #if defined(__Fuchsia__) || defined(_WIN32)
   PROF_ERR("%s\n", "Continuous mode not yet supported on Fuchsia or Windows.");
 #else // defined(__Fuchsia__) || defined(_WIN32)
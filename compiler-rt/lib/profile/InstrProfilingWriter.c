@@ -238,6 +238,35 @@ static int writeValueProfData(ProfDataWriter *Writer,
   return 0;
 }
 
+/* When the counters of each function are sharded between threads, add the
+ * counts of every shard to the first one, which is the only one profile
+ * readers look at, and reset the other shards. */
+static void foldCounterShards(const __llvm_profile_data *DataBegin,
+                              const __llvm_profile_data *DataEnd,
+                              const uint64_t *CountersEnd) {
+  const uint32_t NumShards = __llvm_profile_counter_shards;
+  if (NumShards <= 1)
+    return;
+
+  const __llvm_profile_data *Data;
+  for (Data = DataBegin; Data < DataEnd; Data++) {
+    uint64_t *Counters = (uint64_t *)Data->CounterPtr;
+    const uint32_t NumCounters = Data->NumCounters;
+    /* All the objects are expected to use the same number of shards, but
+     * don't go past the counters section if that isn't the case. */
+    if (Counters + (uint64_t)NumShards * NumCounters > CountersEnd)
+      continue;
+    uint32_t Shard, I;
+    for (Shard = 1; Shard < NumShards; Shard++) {
+      uint64_t *ShardCounters = Counters + (uint64_t)Shard * NumCounters;
+      for (I = 0; I < NumCounters; I++) {
+        Counters[I] += ShardCounters[I];
+        ShardCounters[I] = 0;
+      }
+    }
+  }
+}
+
 COMPILER_RT_VISIBILITY int lprofWriteData(ProfDataWriter *Writer,
                                           VPDataReaderType *VPDataReader,
                                           int SkipNameDataWrite) {
@@ -246,6 +275,7 @@ COMPILER_RT_VISIBILITY int lprofWriteData(ProfDataWriter *Writer,
   const __llvm_profile_data *DataEnd = __llvm_profile_end_data();
   const uint64_t *CountersBegin = __llvm_profile_begin_counters();
   const uint64_t *CountersEnd = __llvm_profile_end_counters();
+  foldCounterShards(DataBegin, DataEnd, CountersEnd);
   const char *NamesBegin = __llvm_profile_begin_names();
   const char *NamesEnd = __llvm_profile_end_names();
   return lprofWriteDataImpl(Writer, DataBegin, DataEnd, CountersBegin,
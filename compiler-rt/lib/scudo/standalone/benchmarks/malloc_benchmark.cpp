@@ -14,6 +14,8 @@
 
 #include <memory>
 
+#include <sys/resource.h>
+
 template <typename Config> static void BM_malloc_free(benchmark::State &State) {
   using AllocatorT = scudo::Allocator<Config>;
   auto Deleter = [](AllocatorT *A) {
@@ -100,4 +102,58 @@ BENCHMARK_TEMPLATE(BM_malloc_free_loop, scudo::FuchsiaConfig)
     ->Range(MinIters, MaxIters);
 #endif
 
+// Many threads sharing one allocator, each repeatedly allocating and freeing a
+// small batch of chunks. This exercises the TSD selection and the contention
+// on the shared contexts. The peak RSS of the process is reported as a counter.
+template <typename Config>
+static void BM_malloc_free_threads(benchmark::State &State) {
+  using AllocatorT = scudo::Allocator<Config>;
+  static AllocatorT *Allocator;
+  if (State.thread_index == 0) {
+    Allocator = new AllocatorT;
+    Allocator->reset();
+  }
+
+  const size_t NumChunks = 16;
+  void *Ptrs[NumChunks];
+
+  for (auto _ : State) {
+    for (size_t I = 0; I < NumChunks; I++) {
+      Ptrs[I] =
+          Allocator->allocate(16U << (I % 8), scudo::Chunk::Origin::Malloc);
+      benchmark::DoNotOptimize(Ptrs[I]);
+    }
+    for (void *Ptr : Ptrs)
+      Allocator->deallocate(Ptr, scudo::Chunk::Origin::Malloc);
+  }
+
+  State.SetItemsProcessed(uint64_t(State.iterations()) * NumChunks);
+
+  if (State.thread_index == 0) {
+    struct rusage Usage;
+    if (getrusage(RUSAGE_SELF, &Usage) == 0)
+      State.counters["MaxRSSKiB"] = static_cast<double>(Usage.ru_maxrss);
+    Allocator->unmapTestOnly();
+    delete Allocator;
+    Allocator = nullptr;
+  }
+}
+
+// FIXME: Add DefaultConfig here once we can tear down the exclusive TSD
+// cleanly.
+BENCHMARK_TEMPLATE(BM_malloc_free_threads, scudo::AndroidConfig)
+    ->ThreadRange(1, 64)
+    ->Threads(2000)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_malloc_free_threads, scudo::AndroidSvelteConfig)
+    ->ThreadRange(1, 64)
+    ->Threads(2000)
+    ->UseRealTime();
+#if SCUDO_CAN_USE_PRIMARY64
+BENCHMARK_TEMPLATE(BM_malloc_free_threads, scudo::FuchsiaConfig)
+    ->ThreadRange(1, 64)
+    ->Threads(2000)
+    ->UseRealTime();
+#endif
+
 BENCHMARK_MAIN();
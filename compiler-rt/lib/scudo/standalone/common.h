@@ -135,6 +135,11 @@ u64 getMonotonicTime();
 
 u32 getThreadID();
 
+// Returns the CPU the calling thread is currently running on, or ~0U if it
+// could not be determined. The result is only a hint, as the thread can be
+// migrated at any point.
+u32 getCurrentCPU();
+
 // Our randomness gathering function is limited to 256 bytes to ensure we get
 // as many bytes as requested, and avoid interruptions (on Linux).
 constexpr uptr MaxRandomLength = 256U;
@@ -181,6 +181,8 @@ u32 getNumberOfCPUs() { return _zx_system_get_num_cpus(); }
 
 u32 getThreadID() { return 0; }
 
+u32 getCurrentCPU() { return ~0U; }
+
 bool getRandom(void *Buffer, uptr Length, UNUSED bool Blocking) {
   static_assert(MaxRandomLength <= ZX_CPRNG_DRAW_MAX_LEN, "");
   if (UNLIKELY(!Buffer || !Length || Length > MaxRandomLength))
@@ -153,6 +153,13 @@ u32 getThreadID() {
 #endif
 }
 
+u32 getCurrentCPU() {
+  // Recent versions of glibc and Bionic serve this from the rseq area or the
+  // vDSO, so it doesn't require a syscall.
+  const int CPU = sched_getcpu();
+  return CPU < 0 ? ~0U : static_cast<u32>(CPU);
+}
+
 // Blocking is possibly unused if the getrandom block is not compiled in.
 bool getRandom(void *Buffer, uptr Length, UNUSED bool Blocking) {
   if (!Buffer || !Length || Length > MaxRandomLength)
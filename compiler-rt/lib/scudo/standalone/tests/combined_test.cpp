@@ -448,6 +448,37 @@ TEST(ScudoCombinedTest, ReleaseToOS) {
   Allocator->releaseToOS();
 }
 
+template <class Config> static void testDeallocateBatch() {
+  using AllocatorT = TestAllocator<Config>;
+  auto Allocator = std::unique_ptr<AllocatorT>(new AllocatorT());
+
+  // Mix primary and secondary backed chunks, as well as null pointers, which
+  // are expected to be ignored.
+  std::vector<void *> V;
+  for (scudo::uptr I = 0; I < 256U; I++) {
+    const scudo::uptr Size = (I % 4 == 3) ? 1U << 20 : (I + 1) * 16U;
+    void *P = Allocator->allocate(Size, Origin);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0xaa, Size);
+    V.push_back(P);
+  }
+  V.push_back(nullptr);
+  Allocator->deallocateBatch(V.data(), V.size(), Origin);
+  // The chunks are not allocated anymore, so freeing one again must fail.
+  EXPECT_DEATH(Allocator->deallocate(V[0], Origin), "");
+  Allocator->releaseToOS();
+}
+
+TEST(ScudoCombinedTest, DeallocateBatch) {
+  UseQuarantine = false;
+  testDeallocateBatch<DeathConfig>();
+#if !SCUDO_FUCHSIA
+  UseQuarantine = true;
+  testDeallocateBatch<scudo::AndroidConfig>();
+  UseQuarantine = false;
+#endif
+}
+
 // Verify that when a region gets full, the allocator will still manage to
 // fulfill the allocation through a larger size class.
 TEST(ScudoCombinedTest, FullRegion) {
@@ -148,8 +148,12 @@ private:
 
   NOINLINE void initThread(Allocator *Instance) {
     initOnceMaybe(Instance);
-    // Initial context assignment is done in a plain round-robin fashion.
-    const u32 Index = atomic_fetch_add(&CurrentIndex, 1U, memory_order_relaxed);
+    // Initial context assignment is based on the CPU the thread is running on,
+    // so that threads running concurrently start out on different contexts.
+    // If the CPU is unknown, fall back to a plain round-robin fashion.
+    u32 Index = getCurrentCPU();
+    if (Index == ~0U)
+      Index = atomic_fetch_add(&CurrentIndex, 1U, memory_order_relaxed);
     setCurrentTSD(&TSDs[Index % NumberOfTSDs]);
     Instance->callPostInitCallback();
   }
@@ -167,6 +171,17 @@ private:
       Inc = CoPrimes[R % NumberOfCoPrimes];
     }
     if (N > 1U) {
+      // The thread might have migrated since it was last associated with a
+      // context: try the context of the CPU it's running on first, as threads
+      // running on other CPUs are less likely to be holding it.
+      const u32 CPU = getCurrentCPU();
+      if (CPU != ~0U) {
+        TSD<Allocator> *CPUTSD = &TSDs[CPU % N];
+        if (CPUTSD != CurrentTSD && CPUTSD->tryLock()) {
+          setCurrentTSD(CPUTSD);
+          return CPUTSD;
+        }
+      }
       u32 Index = R % N;
       uptr LowestPrecedence = UINTPTR_MAX;
       TSD<Allocator> *CandidateTSD = nullptr;
@@ -0,0 +1,106 @@
+// Mini-benchmark for tsan: mutex-heavy workload with many live threads.
+// Idea:
+// 1) Spawn N worker threads (N in the hundreds), all of them stay alive.
+// 2) Each worker repeatedly pops a task from a shared queue protected by a
+//    global mutex, then updates one of a small set of striped counters, each
+//    protected by its own mutex. This mimics a thread-pool based service.
+//
+// Unlike vts_many_threads_bench.cpp, all the threads remain active, so every
+// acquire/release involves vector clocks with N live elements. This makes the
+// benchmark a good proxy for the O(threads) cost of the clock operations.
+//
+// Usage: mutex_pool_bench [n_threads n_stripes n_tasks]
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+class __attribute__((aligned(64))) Mutex {
+ public:
+  Mutex()  { pthread_mutex_init(&m_, NULL); }
+  ~Mutex() { pthread_mutex_destroy(&m_); }
+  void Lock() { pthread_mutex_lock(&m_); }
+  void Unlock() { pthread_mutex_unlock(&m_); }
+
+ private:
+  pthread_mutex_t m_;
+};
+
+struct __attribute__((aligned(64))) Stripe {
+  Mutex mu;
+  long value = 0;
+};
+
+int n_threads, n_stripes, n_tasks;
+Stripe *stripes;
+
+Mutex queue_mu;
+int next_task;
+
+pthread_barrier_t all_threads_ready;
+
+void *Thread(void *arg) {
+  pthread_barrier_wait(&all_threads_ready);
+  for (;;) {
+    queue_mu.Lock();
+    int task = next_task < n_tasks ? next_task++ : -1;
+    queue_mu.Unlock();
+    if (task < 0)
+      break;
+    Stripe &s = stripes[task % n_stripes];
+    s.mu.Lock();
+    s.value += task;
+    s.mu.Unlock();
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc == 1) {
+    n_threads = 500;
+    n_stripes = 16;
+    n_tasks = 2000000;
+  } else if (argc == 4) {
+    n_threads = atoi(argv[1]);
+    assert(n_threads > 0 && n_threads <= 8000);
+    n_stripes = atoi(argv[2]);
+    assert(n_stripes > 0);
+    n_tasks = atoi(argv[3]);
+  } else {
+    printf("Usage: %s n_threads n_stripes n_tasks\n", argv[0]);
+    return 1;
+  }
+  printf("%s: n_threads=%d n_stripes=%d n_tasks=%d\n",
+         __FILE__, n_threads, n_stripes, n_tasks);
+
+  stripes = new Stripe[n_stripes];
+  pthread_barrier_init(&all_threads_ready, NULL, n_threads + 1);
+
+  pthread_t *t = new pthread_t[n_threads];
+  for (int i = 0; i < n_threads; i++) {
+    int status = pthread_create(&t[i], 0, Thread, NULL);
+    assert(status == 0);
+  }
+
+  timespec start, end;
+  pthread_barrier_wait(&all_threads_ready);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < n_threads; i++)
+    pthread_join(t[i], 0);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  long sum = 0;
+  for (int i = 0; i < n_stripes; i++)
+    sum += stripes[i].value;
+  assert(sum == (long)n_tasks * (n_tasks - 1) / 2);
+
+  double secs =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  printf("%.3fs, %.0f tasks/s\n", secs, n_tasks / secs);
+
+  delete [] t;
+  delete [] stripes;
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include <future>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 namespace __xray {
 namespace {
@@ -106,6 +107,101 @@ TEST(BufferQueueTest, MultiThreaded) {
   F();
 }
 
+TEST(BufferQueueTest, MultiThreadedExclusiveBuffers) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 4, Success);
+  ASSERT_TRUE(Success);
+
+  // Every thread marks the buffers it holds, to check that no buffer is handed
+  // out to two threads at once.
+  std::atomic<bool> Failed{false};
+  auto F = [&] {
+    for (int I = 0; I < 10000; ++I) {
+      BufferQueue::Buffer B;
+      if (Buffers.getBuffer(B) != BufferQueue::ErrorCode::Ok)
+        continue;
+      auto *Owner = reinterpret_cast<std::atomic<bool> *>(B.Data);
+      if (Owner->exchange(true, std::memory_order_acq_rel))
+        Failed.store(true, std::memory_order_relaxed);
+      Owner->store(false, std::memory_order_release);
+      ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+    }
+  };
+  auto T0 = std::async(std::launch::async, F);
+  auto T1 = std::async(std::launch::async, F);
+  auto T2 = std::async(std::launch::async, F);
+  F();
+  T0.get();
+  T1.get();
+  T2.get();
+  EXPECT_FALSE(Failed.load());
+
+  auto Count = 0;
+  Buffers.apply([&](const BufferQueue::Buffer &B) { ++Count; });
+  EXPECT_EQ(Count, 4);
+}
+
+TEST(BufferQueueTest, MultiThreadedGetAndReleaseNeverFail) {
+  // With as many buffers as threads, and every thread holding at most one
+  // buffer at a time, a getBuffer racing with a releaseBuffer must neither
+  // fail nor drop the buffer being released.
+  constexpr size_t kThreads = 4;
+  bool Success = false;
+  BufferQueue Buffers(kSize, kThreads, Success);
+  ASSERT_TRUE(Success);
+
+  std::atomic<int> GetFailures{0};
+  std::atomic<int> ReleaseFailures{0};
+  auto F = [&] {
+    for (int I = 0; I < 100000; ++I) {
+      BufferQueue::Buffer B;
+      if (Buffers.getBuffer(B) != BufferQueue::ErrorCode::Ok) {
+        GetFailures.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      if (Buffers.releaseBuffer(B) != BufferQueue::ErrorCode::Ok)
+        ReleaseFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+  std::vector<std::future<void>> Threads;
+  for (size_t I = 1; I < kThreads; ++I)
+    Threads.push_back(std::async(std::launch::async, F));
+  F();
+  for (auto &T : Threads)
+    T.get();
+  EXPECT_EQ(GetFailures.load(), 0);
+  EXPECT_EQ(ReleaseFailures.load(), 0);
+
+  // None of the entries of the queue may have been lost.
+  BufferQueue::Buffer Held[kThreads];
+  for (auto &B : Held)
+    ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  BufferQueue::Buffer Extra;
+  EXPECT_EQ(Buffers.getBuffer(Extra), BufferQueue::ErrorCode::NotEnoughMemory);
+  for (auto &B : Held)
+    ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+}
+
+TEST(BufferQueueTest, DoubleReleaseIsRejected) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 2, Success);
+  ASSERT_TRUE(Success);
+  BufferQueue::Buffer Buf;
+  ASSERT_EQ(Buffers.getBuffer(Buf), BufferQueue::ErrorCode::Ok);
+  BufferQueue::Buffer Copy = Buf;
+  ASSERT_EQ(Buffers.releaseBuffer(Buf), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(Buffers.releaseBuffer(Copy),
+            BufferQueue::ErrorCode::UnrecognizedBuffer);
+
+  // The queue still hands out exactly two buffers.
+  BufferQueue::Buffer B0, B1, B2;
+  ASSERT_EQ(Buffers.getBuffer(B0), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.getBuffer(B1), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(Buffers.getBuffer(B2), BufferQueue::ErrorCode::NotEnoughMemory);
+  ASSERT_EQ(Buffers.releaseBuffer(B0), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B1), BufferQueue::ErrorCode::Ok);
+}
+
 TEST(BufferQueueTest, Apply) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
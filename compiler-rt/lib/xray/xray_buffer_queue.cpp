@@ -67,12 +67,20 @@ constexpr size_t kExtentsSize = sizeof(ExtentsPadded);
 
 } // namespace
 
+void BufferQueue::waitForInFlight() {
+  while (atomic_load(&InFlight, memory_order_seq_cst) != 0)
+    internal_sched_yield();
+}
+
 BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
   SpinMutexLock Guard(&Mutex);
 
   if (!finalizing())
     return BufferQueue::ErrorCode::AlreadyInitialized;
 
+  // Operations which started before the queue was finalized may still be
+  // using the buffers; later ones serialize on the mutex.
+  waitForInFlight();
   cleanupBuffers();
 
   bool Success = false;
@@ -132,11 +140,12 @@ BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
     Buf.ExtentsBackingStore = ExtentsBackingStore;
     Buf.Count = BufferCount;
     T.Used = false;
+    // All the buffers start out available to getBuffer.
+    atomic_store(&T.Sequence, i + 1, memory_order_relaxed);
   }
 
-  Next = Buffers;
-  First = Buffers;
-  LiveBuffers = 0;
+  atomic_store(&NextTicket, 0, memory_order_relaxed);
+  atomic_store(&FirstTicket, BufferCount, memory_order_relaxed);
   atomic_store(&Finalizing, 0, memory_order_release);
   Success = true;
   return BufferQueue::ErrorCode::Ok;
@@ -151,26 +160,52 @@ BufferQueue::BufferQueue(size_t B, size_t N,
       BackingStore(nullptr),
       ExtentsBackingStore(nullptr),
       Buffers(nullptr),
-      Next(Buffers),
-      First(Buffers),
-      LiveBuffers(0),
+      NextTicket{0},
+      FirstTicket{0},
+      InFlight{0},
       Generation{0} {
   Success = init(B, N) == BufferQueue::ErrorCode::Ok;
 }
 
+// The buffers are handed out and returned through a bounded multi-producer,
+// multi-consumer queue in the style of Dmitry Vyukov's: each entry carries a
+// sequence number which tells whether the entry is waiting for the getBuffer
+// or for the releaseBuffer with a given ticket, so that threads only contend
+// on the ticket counters, and never on a lock.
+
 BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   if (atomic_load(&Finalizing, memory_order_acquire))
     return ErrorCode::QueueFinalizing;
 
+  // Check again once init can see us, so that the buffers can't be recycled
+  // while we use them.
+  atomic_fetch_add(&InFlight, 1, memory_order_seq_cst);
+  auto Leave = at_scope_exit(
+      [this] { atomic_fetch_sub(&InFlight, 1, memory_order_release); });
+  if (atomic_load(&Finalizing, memory_order_seq_cst))
+    return ErrorCode::QueueFinalizing;
+
   BufferRep *B = nullptr;
-  {
-    SpinMutexLock Guard(&Mutex);
-    if (LiveBuffers == BufferCount)
-      return ErrorCode::NotEnoughMemory;
-    B = Next++;
-    if (Next == (Buffers + BufferCount))
-      Next = Buffers;
-    ++LiveBuffers;
+  u64 Ticket = atomic_load(&NextTicket, memory_order_relaxed);
+  for (;;) {
+    B = &Buffers[Ticket % BufferCount];
+    u64 Sequence = atomic_load(&B->Sequence, memory_order_acquire);
+    auto Diff = static_cast<s64>(Sequence - (Ticket + 1));
+    if (Diff == 0) {
+      if (atomic_compare_exchange_weak(&NextTicket, &Ticket, Ticket + 1,
+                                       memory_order_relaxed))
+        break;
+    } else if (Diff < 0) {
+      // Either all the buffers are live, or the releaseBuffer that claimed
+      // this entry hasn't stored the buffer into it yet, in which case we wait
+      // for it rather than failing.
+      if (atomic_load(&FirstTicket, memory_order_acquire) == Ticket)
+        return ErrorCode::NotEnoughMemory;
+      internal_sched_yield();
+      Ticket = atomic_load(&NextTicket, memory_order_relaxed);
+    } else {
+      Ticket = atomic_load(&NextTicket, memory_order_relaxed);
+    }
   }
 
   incRefCount(BackingStore);
@@ -178,30 +213,65 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   Buf = B->Buff;
   Buf.Generation = generation();
   B->Used = true;
+  atomic_store(&B->Sequence, Ticket + BufferCount, memory_order_release);
   return ErrorCode::Ok;
 }
 
 BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
+  atomic_fetch_add(&InFlight, 1, memory_order_seq_cst);
+  if (atomic_load(&Finalizing, memory_order_seq_cst)) {
+    // Once finalizing, releases are serialized with apply and init through the
+    // mutex.
+    atomic_fetch_sub(&InFlight, 1, memory_order_release);
+    SpinMutexLock Guard(&Mutex);
+    return releaseBufferImpl(Buf);
+  }
+  auto Leave = at_scope_exit(
+      [this] { atomic_fetch_sub(&InFlight, 1, memory_order_release); });
+  return releaseBufferImpl(Buf);
+}
+
+BufferQueue::ErrorCode BufferQueue::releaseBufferImpl(Buffer &Buf) {
+  auto ReleaseStale = [&] {
+    decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
+    decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
+    Buf = {};
+    return BufferQueue::ErrorCode::Ok;
+  };
+
+  if (Buf.Generation != generation())
+    return ReleaseStale();
+
   // Check whether the buffer being referred to is within the bounds of the
   // backing store's range.
+  if (Buf.Data < &BackingStore->Data ||
+      Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
+    return BufferQueue::ErrorCode::UnrecognizedBuffer;
+
   BufferRep *B = nullptr;
-  {
-    SpinMutexLock Guard(&Mutex);
-    if (Buf.Generation != generation() || LiveBuffers == 0) {
-      Buf = {};
-      decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
-      decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
-      return BufferQueue::ErrorCode::Ok;
+  u64 Ticket = atomic_load(&FirstTicket, memory_order_relaxed);
+  for (;;) {
+    B = &Buffers[Ticket % BufferCount];
+    u64 Sequence = atomic_load(&B->Sequence, memory_order_acquire);
+    auto Diff = static_cast<s64>(Sequence - Ticket);
+    if (Diff == 0) {
+      if (atomic_compare_exchange_weak(&FirstTicket, &Ticket, Ticket + 1,
+                                       memory_order_relaxed))
+        break;
+    } else if (Diff < 0) {
+      // Either the getBuffer that claimed this entry hasn't marked it free yet,
+      // in which case we wait for it, or every buffer is already back in the
+      // queue and this one is being released twice. The references were
+      // dropped by the first release, so we must not drop them again.
+      auto Available = static_cast<s64>(
+          Ticket - atomic_load(&NextTicket, memory_order_acquire));
+      if (Available >= static_cast<s64>(BufferCount))
+        return ErrorCode::UnrecognizedBuffer;
+      internal_sched_yield();
+      Ticket = atomic_load(&FirstTicket, memory_order_relaxed);
+    } else {
+      Ticket = atomic_load(&FirstTicket, memory_order_relaxed);
     }
-
-    if (Buf.Data < &BackingStore->Data ||
-        Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
-      return BufferQueue::ErrorCode::UnrecognizedBuffer;
-
-    --LiveBuffers;
-    B = First++;
-    if (First == (Buffers + BufferCount))
-      First = Buffers;
   }
 
   // Now that the buffer has been released, we mark it as "used".
@@ -211,12 +281,13 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
   decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
   atomic_store(B->Buff.Extents, atomic_load(Buf.Extents, memory_order_acquire),
                memory_order_release);
+  atomic_store(&B->Sequence, Ticket + 1, memory_order_release);
   Buf = {};
   return ErrorCode::Ok;
 }
 
 BufferQueue::ErrorCode BufferQueue::finalize() {
-  if (atomic_exchange(&Finalizing, 1, memory_order_acq_rel))
+  if (atomic_exchange(&Finalizing, 1, memory_order_seq_cst))
     return ErrorCode::QueueFinalizing;
   return ErrorCode::Ok;
 }
@@ -71,6 +71,11 @@ public:
     // This is true if the buffer has been returned to the available queue, and
     // is considered "used" by another thread.
     bool Used = false;
+
+    // The ticket of the getBuffer (when equal to the ticket plus one) or
+    // releaseBuffer (when equal to the ticket) operation that may use this
+    // entry next.
+    atomic_uint64_t Sequence;
   };
 
 private:
@@ -149,15 +154,17 @@ private:
   // A dynamically allocated array of BufferRep instances.
   BufferRep *Buffers;
 
-  // Pointer to the next buffer to be handed out.
-  BufferRep *Next;
+  // Ticket of the next buffer to be handed out. The buffer is the one in the
+  // entry at the ticket modulo BufferCount.
+  atomic_uint64_t NextTicket;
 
-  // Pointer to the entry in the array where the next released buffer will be
+  // Ticket of the entry in the array where the next released buffer will be
   // placed.
-  BufferRep *First;
+  atomic_uint64_t FirstTicket;
 
-  // Count of buffers that have been handed out through 'getBuffer'.
-  size_t LiveBuffers;
+  // Count of getBuffer and releaseBuffer operations in progress without
+  // holding the mutex, which init and apply wait for.
+  atomic_uint32_t InFlight;
 
   // We use a generation number to identify buffers and which generation they're
   // associated with.
@@ -166,6 +173,9 @@ private:
   /// Releases references to the buffers backed by the current buffer queue.
   void cleanupBuffers();
 
+  /// Waits for the operations that don't hold the mutex to complete.
+  void waitForInFlight();
+
 public:
   enum class ErrorCode : unsigned {
     Ok,
@@ -200,7 +210,7 @@ public:
 
   /// Updates |Buf| to contain the pointer to an appropriate buffer. Returns an
   /// error in case there are no available buffers to return when we will run
-  /// over the upper bound for the total buffers.
+  /// over the upper bound for the total buffers. This doesn't take a lock.
   ///
   /// Requirements:
   ///   - BufferQueue is not finalising.
@@ -212,12 +222,14 @@ public:
   ///     a finalizing/finalized BufferQueue.
   ErrorCode getBuffer(Buffer &Buf);
 
-  /// Updates |Buf| to point to nullptr, with size 0.
+  /// Updates |Buf| to point to nullptr, with size 0. This only takes a lock
+  /// when the queue is finalizing.
   ///
   /// Returns:
   ///   - ErrorCode::Ok when we successfully release the buffer.
   ///   - ErrorCode::UnrecognizedBuffer for when this BufferQueue does not own
-  ///     the buffer being released.
+  ///     the buffer being released, or when all of its buffers are already
+  ///     back in the queue.
   ErrorCode releaseBuffer(Buffer &Buf);
 
   /// Initializes the buffer queue, starting a new generation. We can re-set the
@@ -252,8 +264,12 @@ public:
   /// Applies the provided function F to each Buffer in the queue, only if the
   /// Buffer is marked 'used' (i.e. has been the result of getBuffer(...) and a
   /// releaseBuffer(...) operation).
+  ///
+  /// Buffers are only released concurrently with F while the queue is not
+  /// finalizing.
   template <class F> void apply(F Fn) XRAY_NEVER_INSTRUMENT {
     SpinMutexLock G(&Mutex);
+    waitForInFlight();
     for (auto I = begin(), E = end(); I != E; ++I)
       Fn(*I);
   }
@@ -273,6 +289,9 @@ public:
 
   // Cleans up allocated buffers.
   ~BufferQueue();
+
+private:
+  ErrorCode releaseBufferImpl(Buffer &Buf);
 };
 
 } // namespace __xray
@@ -191,6 +191,9 @@ private:
   bool debugModuleWriter_{false};
   const evaluate::IntrinsicProcTable intrinsics_;
   Scope globalScope_;
+  // The program unit scope that contained the last FindScope() result;
+  // consecutive lookups usually fall within the same program unit.
+  Scope *lastProgramUnitScope_{nullptr};
   parser::Messages messages_;
   evaluate::FoldingContext foldingContext_;
   ConstructStack constructStack_;
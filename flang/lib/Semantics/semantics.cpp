@@ -251,7 +251,22 @@ const Scope &SemanticsContext::FindScope(parser::CharBlock source) const {
 }
 
 Scope &SemanticsContext::FindScope(parser::CharBlock source) {
+  // Avoid a search through all of the program units in the global scope,
+  // which makes semantics quadratic in the number of program units.
+  if (lastProgramUnitScope_ &&
+      lastProgramUnitScope_->sourceRange().Contains(source)) {
+    if (auto *scope{lastProgramUnitScope_->FindScope(source)}) {
+      return *scope;
+    }
+  }
   if (auto *scope{globalScope_.FindScope(source)}) {
+    Scope *unit{scope};
+    while (!unit->IsGlobal() && !unit->parent().IsGlobal()) {
+      unit = &unit->parent();
+    }
+    if (!unit->IsGlobal() && !unit->IsModuleFile()) {
+      lastProgramUnitScope_ = unit;
+    }
     return *scope;
   } else {
     common::die("SemanticsContext::FindScope(): invalid source location");
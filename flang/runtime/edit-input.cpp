@@ -10,6 +10,7 @@
 #include "flang/Common/real.h"
 #include "flang/Common/uint128.h"
 #include <algorithm>
+#include <cfloat>
 
 namespace Fortran::runtime::io {
 
@@ -260,6 +261,46 @@ static int ScanRealInput(char *buffer, int bufferSize, IoStatementState &io,
   return got;
 }
 
+// Converts a normalized fraction from ScanRealInput with few enough
+// significant digits and a small enough power of ten that a single correctly
+// rounded host floating-point multiplication or division yields the correctly
+// rounded result (Clinger's fast path), avoiding the general conversion.
+template <typename REAL, int MAX_DIGITS, int MAX_POWER>
+static bool TryFastRealInput(
+    const char *buffer, int got, int exponent, void *n) {
+  static constexpr REAL powersOfTen[]{1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+      1e20, 1e21, 1e22};
+  static_assert(MAX_POWER < sizeof powersOfTen / sizeof powersOfTen[0]);
+  const char *p{buffer};
+  const char *end{buffer + got};
+  bool isNegative{*p == '-'};
+  p += isNegative;
+  if (p == end || *p++ != '.') {
+    return false; // NaN or Inf
+  }
+  while (end > p && end[-1] == '0') {
+    --end; // trailing zeroes of the fraction don't count
+  }
+  int digits{static_cast<int>(end - p)};
+  if (digits == 0 || digits > MAX_DIGITS) {
+    return false;
+  }
+  std::uint64_t significand{0};
+  for (; p < end; ++p) {
+    significand = 10 * significand + (*p - '0');
+  }
+  // The value is 0.DIGITS * 10**exponent.
+  int power{exponent - digits};
+  if (power < -MAX_POWER || power > MAX_POWER) {
+    return false;
+  }
+  REAL x{static_cast<REAL>(significand)}; // exact
+  x = power < 0 ? x / powersOfTen[-power] : x * powersOfTen[power];
+  *reinterpret_cast<REAL *>(n) = isNegative ? -x : x;
+  return true;
+}
+
 template <int KIND>
 bool EditCommonRealInput(IoStatementState &io, const DataEdit &edit, void *n) {
   constexpr int binaryPrecision{common::PrecisionOfRealKind(KIND)};
@@ -278,6 +319,20 @@ bool EditCommonRealInput(IoStatementState &io, const DataEdit &edit, void *n) {
     return false;
   }
   bool hadExtra{got > maxDigits};
+#if FLT_EVAL_METHOD == 0
+  // The fast paths rely on host arithmetic in the default rounding mode.
+  if (edit.modes.round == decimal::RoundNearest && !hadExtra) {
+    if constexpr (KIND == 4) {
+      if (TryFastRealInput<float, 7, 10>(buffer, got, exponent, n)) {
+        return true;
+      }
+    } else if constexpr (KIND == 8) {
+      if (TryFastRealInput<double, 15, 22>(buffer, got, exponent, n)) {
+        return true;
+      }
+    }
+  }
+#endif
   if (exponent != 0) {
     got += std::snprintf(&buffer[got], bufferSize - got, "e%d", exponent);
   }
@@ -9,9 +9,15 @@
 #include "edit-output.h"
 #include "flang/Common/uint128.h"
 #include <algorithm>
+#include <cstring>
 
 namespace Fortran::runtime::io {
 
+static constexpr char decimalDigitPairs[]{
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "7475767778798081828384858687888990919293949596979899"};
+
 template <typename INT, typename UINT>
 bool EditIntegerOutput(IoStatementState &io, const DataEdit &edit, INT n) {
   char buffer[130], *end = &buffer[sizeof buffer], *p = end;
@@ -30,11 +36,17 @@ bool EditIntegerOutput(IoStatementState &io, const DataEdit &edit, INT n) {
     if (isNegative || (edit.modes.editingFlags & signPlus)) {
       signChars = 1; // '-' or '+'
     }
-    while (un > 0) {
-      auto quotient{un / 10u};
-      *--p = '0' + static_cast<int>(un - UINT{10} * quotient);
+    // Two digits per division
+    while (un >= 10) {
+      auto quotient{un / 100u};
+      int pair{static_cast<int>(un - UINT{100} * quotient)};
+      p -= 2;
+      std::memcpy(p, &decimalDigitPairs[2 * pair], 2);
       un = quotient;
     }
+    if (un > 0) {
+      *--p = '0' + static_cast<int>(un);
+    }
     break;
   case 'B':
     for (; un > 0; un >>= 1) {
@@ -162,6 +174,10 @@ decimal::ConversionToDecimalResult RealOutputEditing<binaryPrecision>::Convert(
   if (edit.modes.editingFlags & signPlus) {
     flags |= decimal::AlwaysSign;
   }
+  if (significantDigits == lastSignificantDigits_ && flags == lastFlags_ &&
+      edit.modes.round == lastRounding_) {
+    return lastConversion_;
+  }
   auto converted{decimal::ConvertToDecimal<binaryPrecision>(buffer_,
       sizeof buffer_, static_cast<enum decimal::DecimalConversionFlags>(flags),
       significantDigits, edit.modes.round, x_)};
@@ -170,6 +186,10 @@ decimal::ConversionToDecimalResult RealOutputEditing<binaryPrecision>::Convert(
         "RealOutputEditing::Convert : buffer size %zd was insufficient",
         sizeof buffer_);
   }
+  lastConversion_ = converted;
+  lastSignificantDigits_ = significantDigits;
+  lastFlags_ = flags;
+  lastRounding_ = edit.modes.round;
   return converted;
 }
 
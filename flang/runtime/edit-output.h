@@ -88,6 +88,13 @@ private:
   BinaryFloatingPoint x_;
   char buffer_[BinaryFloatingPoint::maxDecimalConversionDigits +
       EXTRA_DECIMAL_CONVERSION_SPACE];
+  // The most recent conversion result, which remains valid in buffer_ until
+  // the next conversion; F0, E0, and list-directed editing often request
+  // the same conversion more than once.
+  decimal::ConversionToDecimalResult lastConversion_;
+  int lastSignificantDigits_{-1};
+  int lastFlags_{0};
+  enum decimal::FortranRounding lastRounding_ { decimal::RoundNearest };
 };
 
 bool ListDirectedLogicalOutput(
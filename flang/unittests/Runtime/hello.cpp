@@ -518,6 +518,12 @@ int main() {
   realInTest("(BZ,F18.0)", "              125 ", 0x4093880000000000); // 1250
   realInTest("(BZ,F18.0)", "       125 . e +1 ", 0x42a6bcc41e900000); // 1.25e13
   realInTest("(DC,F18.0)", "              12,5", 0x4029000000000000);
+  realInTest("(F18.0)", "               0.1", 0x3fb999999999999a);
+  realInTest("(F18.0)", "   123456789012345", 0x42dc12218377de40);
+  realInTest("(F18.0)", "  1234567890123456", 0x43118b54f22aeb00);
+  realInTest("(F18.0)", "              1E22", 0x4480f0cf064dd592);
+  realInTest("(F18.0)", "              1E23", 0x44b52d02c7e14af6);
+  realInTest("(F18.0)", "       3.14159E-20", 0x3be28b6fc3d76b89);
 
   listInputTest();
   descrOutputTest();
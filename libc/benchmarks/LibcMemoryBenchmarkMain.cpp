@@ -10,6 +10,7 @@
 #include "LibcBenchmark.h"
 #include "LibcMemoryBenchmark.h"
 #include "MemorySizeDistributions.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
@@ -17,6 +18,8 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <limits>
+
 namespace __llvm_libc {
 
 extern void *memcpy(void *__restrict, const void *__restrict, size_t);
@@ -42,6 +45,12 @@ static cl::opt<std::string>
     SizeDistributionName("size-distribution-name",
                          cl::desc("The name of the distribution to use"));
 
+static cl::opt<std::string> SizeDistributionFile(
+    "size-distribution-file",
+    cl::desc("A file of recorded sizes, one per line, to build the "
+             "distribution from"),
+    cl::value_desc("filename"));
+
 static cl::opt<bool>
     SweepMode("sweep-mode",
               cl::desc("If set, benchmark all sizes from 0 to sweep-max-size"));
@@ -170,12 +179,18 @@ template <typename Benchmark> struct MemfunctionBenchmark : IBenchmark {
                          Twine(" must be a power of two or zero"));
 
     const bool HasDistributionName = !SizeDistributionName.empty();
-    if (SweepMode && HasDistributionName)
+    const bool HasDistributionFile = !SizeDistributionFile.empty();
+    if (bool(SweepMode) + HasDistributionName + HasDistributionFile > 1)
       report_fatal_error("Select only one of `--" + Twine(SweepMode.ArgStr) +
-                         "` or `--" + Twine(SizeDistributionName.ArgStr) + "`");
+                         "`, `--" + Twine(SizeDistributionName.ArgStr) +
+                         "` or `--" + Twine(SizeDistributionFile.ArgStr) +
+                         "`");
 
     if (SweepMode) {
       MaxSizeValue = SweepMaxSize;
+    } else if (HasDistributionFile) {
+      loadSizeDistribution(SizeDistributionFile);
+      MaxSizeValue = SizeDistribution.Probabilities.size() - 1;
     } else {
       std::map<StringRef, MemorySizeDistribution> Map;
       for (MemorySizeDistribution Distribution : Benchmark::GetDistributions())
@@ -215,7 +230,7 @@ template <typename Benchmark> struct MemfunctionBenchmark : IBenchmark {
     if (SweepMode)
       SC.SweepModeMaxSize = SweepMaxSize;
     else
-      SC.SizeDistributionName = SizeDistributionName;
+      SC.SizeDistributionName = SizeDistribution.Name.str();
     SC.AccessAlignment = MaybeAlign(AlignedAccess);
 
     // Delegate specific flags and configuration.
@@ -236,6 +251,8 @@ private:
   const size_t BatchParameterCount;
   size_t MaxSizeValue = 0;
   MemorySizeDistribution SizeDistribution;
+  // Backing storage when the distribution is read from a file.
+  std::vector<double> LoadedProbabilities;
   Study Study;
   std::mt19937_64 Gen;
 
@@ -243,6 +260,42 @@ private:
     return (Value & (Value - 1U)) == 0;
   }
 
+  // Builds SizeDistribution from the sizes recorded in Filename, e.g. by a
+  // shim that logs the size argument of every call in a production binary.
+  // The probability of each size is its frequency in the file, so replaying
+  // the distribution reproduces the observed mix of sizes.
+  void loadSizeDistribution(StringRef Filename) {
+    auto MB = MemoryBuffer::getFileOrSTDIN(Filename);
+    if (!MB)
+      report_fatal_error(Twine("Could not open file: ")
+                             .concat(MB.getError().message())
+                             .concat(", ")
+                             .concat(Filename));
+    SmallVector<StringRef, 0> Lines;
+    (*MB)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+    for (StringRef Line : Lines) {
+      Line = Line.trim();
+      if (Line.empty() || Line.startswith("#"))
+        continue;
+      size_t Size;
+      if (Line.getAsInteger(10, Size))
+        report_fatal_error("Invalid size '" + Line + "' in " + Filename);
+      // Sizes are stored in 16 bits and must fit in the benchmark buffers.
+      const size_t Limit =
+          std::min<size_t>(BufferSize, std::numeric_limits<uint16_t>::max());
+      if (Size > Limit)
+        report_fatal_error("Size " + Twine(Size) + " in " + Filename +
+                           " exceeds the maximum of " + Twine(Limit));
+      if (Size >= LoadedProbabilities.size())
+        LoadedProbabilities.resize(Size + 1);
+      LoadedProbabilities[Size] += 1;
+    }
+    if (LoadedProbabilities.empty())
+      report_fatal_error(Twine("No sizes in ") + Filename);
+    SizeDistribution.Name = Filename;
+    SizeDistribution.Probabilities = LoadedProbabilities;
+  }
+
   std::function<unsigned()> geOffsetSampler() {
     return [this]() {
       static OffsetDistribution OD(BufferSize, MaxSizeValue,
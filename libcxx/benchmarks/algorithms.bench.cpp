@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <map>
+#include <numeric>
 #include <random>
 #include <string>
 #include <utility>
@@ -12,6 +13,12 @@
 #include "benchmark/benchmark.h"
 #include "test_macros.h"
 
+#if defined(_LIBCPP_HAS_PARALLEL_ALGORITHMS) ||                                  \
+    defined(_LIBCPP_HAS_THREAD_POOL_ALGORITHMS)
+#include <execution>
+#define HAS_EXECUTION_POLICIES
+#endif
+
 namespace {
 
 enum class ValueType { Uint32, Uint64, Pair, Tuple, String };
@@ -309,6 +316,107 @@ struct PopHeap {
   };
 };
 
+#ifdef HAS_EXECUTION_POLICIES
+enum class Policy { Seq, Par };
+struct AllPolicies : EnumValuesAsTuple<AllPolicies, Policy, 2> {
+  static constexpr const char* Names[] = {"Seq", "Par"};
+};
+
+struct AllIntegerTypes : EnumValuesAsTuple<AllIntegerTypes, ValueType, 2> {
+  static constexpr const char* Names[] = {"uint32", "uint64"};
+};
+
+template <class P, class F>
+TEST_ALWAYS_INLINE void withPolicy(F Body) {
+  if constexpr (P() == Policy::Seq)
+    Body(std::execution::seq);
+  else
+    Body(std::execution::par);
+}
+
+template <class ValueType, class Order, class Policy>
+struct ExecSort {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(
+        state, Quantity, Order(), BatchSize::CountElements, [](auto& Copy) {
+          withPolicy<Policy>([&](const auto& P) {
+            std::sort(P, Copy.begin(), Copy.end());
+          });
+        });
+  }
+
+  bool skip() const { return Order() == ::Order::Heap; }
+
+  std::string name() const {
+    return "BM_ExecSort" + ValueType::name() + Order::name() + Policy::name() +
+           "_" + std::to_string(Quantity);
+  };
+};
+
+template <class ValueType, class Policy>
+struct ExecForEach {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(
+        state, Quantity, Order::Random, BatchSize::CountElements,
+        [](auto& Copy) {
+          withPolicy<Policy>([&](const auto& P) {
+            std::for_each(P, Copy.begin(), Copy.end(),
+                          [](auto& V) { V = V * 3 + 1; });
+          });
+        });
+  }
+
+  std::string name() const {
+    return "BM_ExecForEach" + ValueType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+
+template <class ValueType, class Policy>
+struct ExecReduce {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(
+        state, Quantity, Order::Random, BatchSize::CountElements,
+        [](auto& Copy) {
+          withPolicy<Policy>([&](const auto& P) {
+            benchmark::DoNotOptimize(std::reduce(P, Copy.begin(), Copy.end()));
+          });
+        });
+  }
+
+  std::string name() const {
+    return "BM_ExecReduce" + ValueType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+
+template <class ValueType, class Policy>
+struct ExecInclusiveScan {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(
+        state, Quantity, Order::Random, BatchSize::CountElements,
+        [](auto& Copy) {
+          withPolicy<Policy>([&](const auto& P) {
+            std::inclusive_scan(P, Copy.begin(), Copy.end(), Copy.begin());
+          });
+        });
+  }
+
+  std::string name() const {
+    return "BM_ExecInclusiveScan" + ValueType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+#endif // HAS_EXECUTION_POLICIES
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -333,5 +441,15 @@ int main(int argc, char** argv) {
       Quantities);
   makeCartesianProductBenchmark<PushHeap, AllValueTypes, AllOrders>(Quantities);
   makeCartesianProductBenchmark<PopHeap, AllValueTypes>(Quantities);
+#ifdef HAS_EXECUTION_POLICIES
+  makeCartesianProductBenchmark<ExecSort, AllValueTypes, AllOrders,
+                                AllPolicies>(Quantities);
+  makeCartesianProductBenchmark<ExecForEach, AllIntegerTypes, AllPolicies>(
+      Quantities);
+  makeCartesianProductBenchmark<ExecReduce, AllIntegerTypes, AllPolicies>(
+      Quantities);
+  makeCartesianProductBenchmark<ExecInclusiveScan, AllIntegerTypes,
+                                AllPolicies>(Quantities);
+#endif
   benchmark::RunSpecifiedBenchmarks();
 }
\ No newline at end of file
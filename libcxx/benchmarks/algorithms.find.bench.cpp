@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "CartesianBenchmarks.h"
+#include "GenerateInput.h"
+
+namespace {
+
+template <class IntT>
+struct TestIntBase {
+  // All the elements are zero but the last one, so that find and mismatch
+  // scan the whole range.
+  static std::vector<IntT> generateInput(size_t size) {
+    std::vector<IntT> Res(size, IntT(0));
+    Res.back() = IntT(1);
+    return Res;
+  }
+};
+
+struct TestInt8 : TestIntBase<std::int8_t> {
+  static constexpr const char* Name = "TestInt8";
+};
+
+struct TestInt16 : TestIntBase<std::int16_t> {
+  static constexpr const char* Name = "TestInt16";
+};
+
+struct TestInt32 : TestIntBase<std::int32_t> {
+  static constexpr const char* Name = "TestInt32";
+};
+
+struct TestInt64 : TestIntBase<std::int64_t> {
+  static constexpr const char* Name = "TestInt64";
+};
+
+using AllTestTypes = std::tuple<TestInt8, TestInt16, TestInt32, TestInt64>;
+
+struct FindAlg {
+  template <class V>
+  static void run(const V& Data, V& Copy) {
+    benchmark::DoNotOptimize(std::find(Data.begin(), Data.end(), Data.back()));
+  }
+
+  static constexpr const char* Name = "FindAlg";
+};
+
+struct CountAlg {
+  template <class V>
+  static void run(const V& Data, V& Copy) {
+    benchmark::DoNotOptimize(std::count(Data.begin(), Data.end(), Data.back()));
+  }
+
+  static constexpr const char* Name = "CountAlg";
+};
+
+struct MismatchAlg {
+  template <class V>
+  static void run(const V& Data, V& Copy) {
+    benchmark::DoNotOptimize(
+        std::mismatch(Data.begin(), Data.end(), Copy.begin()));
+  }
+
+  static constexpr const char* Name = "MismatchAlg";
+};
+
+struct EqualAlg {
+  template <class V>
+  static void run(const V& Data, V& Copy) {
+    benchmark::DoNotOptimize(std::equal(Data.begin(), Data.end(), Copy.begin()));
+  }
+
+  static constexpr const char* Name = "EqualAlg";
+};
+
+using AllAlgs = std::tuple<FindAlg, CountAlg, MismatchAlg, EqualAlg>;
+
+template <class Alg, class TestType>
+struct FindBench {
+  size_t Quantity;
+
+  std::string name() const {
+    return std::string("FindBench_") + Alg::Name + "_" + TestType::Name + '/' +
+           std::to_string(Quantity);
+  }
+
+  void run(benchmark::State& state) const {
+    auto Data = TestType::generateInput(Quantity);
+    auto Copy = Data;
+    Copy.back() = 0;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(Data.data());
+      benchmark::DoNotOptimize(Copy.data());
+      Alg::run(Data, Copy);
+    }
+    state.SetBytesProcessed(state.iterations() * Quantity *
+                            sizeof(Data.front()));
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  const std::vector<size_t> Quantities = {1 << 4, 1 << 8, 1 << 12, 1 << 16};
+  makeCartesianProductBenchmark<FindBench, AllAlgs, AllTestTypes>(Quantities);
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <barrier>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+struct EmptyCompletion {
+  void operator()() noexcept {}
+};
+
+// std::barrier<> uses the central barrier specialized for the empty
+// completion, any other completion function selects the tree barrier.
+template <class Barrier>
+void BM_BarrierArriveAndWait(benchmark::State& state) {
+  static Barrier* b;
+  if (state.thread_index == 0)
+    b = new Barrier(state.threads);
+  for (auto _ : state)
+    b->arrive_and_wait();
+  if (state.thread_index == 0)
+    delete b;
+}
+BENCHMARK_TEMPLATE(BM_BarrierArriveAndWait, std::barrier<>)
+    ->ThreadRange(2, 128)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_BarrierArriveAndWait, std::barrier<EmptyCompletion>)
+    ->ThreadRange(2, 128)
+    ->UseRealTime();
+
+// Two threads hand a token back and forth through atomic::wait/notify_one.
+template <class T>
+void BM_AtomicWaitNotifyPingPong(benchmark::State& state) {
+  static std::atomic<T> token;
+  T const parity = T(state.thread_index);
+  if (state.thread_index == 0)
+    token.store(0);
+  for (auto _ : state) {
+    T value = token.load(std::memory_order_acquire);
+    while (value % 2 != parity) {
+      token.wait(value, std::memory_order_acquire);
+      value = token.load(std::memory_order_acquire);
+    }
+    token.store(value + 1, std::memory_order_release);
+    token.notify_one();
+  }
+}
+// On Linux, int is the futex word size and is waited on directly. The other
+// sizes go through the contention table.
+BENCHMARK_TEMPLATE(BM_AtomicWaitNotifyPingPong, int)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AtomicWaitNotifyPingPong, unsigned char)
+    ->Threads(2)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AtomicWaitNotifyPingPong, long long)
+    ->Threads(2)
+    ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
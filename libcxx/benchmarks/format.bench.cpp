@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <format>
+#include <sstream>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+// A typical log line: a few integers, a floating-point value and a string.
+static void BM_FormatTo(benchmark::State& state) {
+  char Buffer[256];
+  for (auto _ : state) {
+    char* End = std::format_to(Buffer, "request {} from {} took {:.3f} ms: {}",
+                               state.iterations(), 42, 1.5, "ok");
+    benchmark::DoNotOptimize(Buffer);
+    benchmark::DoNotOptimize(End);
+  }
+}
+BENCHMARK(BM_FormatTo);
+
+static void BM_Format(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(std::format("request {} from {} took {:.3f} ms: {}",
+                                         state.iterations(), 42, 1.5, "ok"));
+}
+BENCHMARK(BM_Format);
+
+static void BM_Snprintf(benchmark::State& state) {
+  char Buffer[256];
+  for (auto _ : state) {
+    int Size = std::snprintf(Buffer, sizeof(Buffer),
+                             "request %lld from %d took %.3f ms: %s",
+                             static_cast<long long>(state.iterations()), 42,
+                             1.5, "ok");
+    benchmark::DoNotOptimize(Buffer);
+    benchmark::DoNotOptimize(Size);
+  }
+}
+BENCHMARK(BM_Snprintf);
+
+static void BM_Stringstream(benchmark::State& state) {
+  for (auto _ : state) {
+    std::ostringstream Stream;
+    Stream.setf(std::ios::fixed);
+    Stream.precision(3);
+    Stream << "request " << state.iterations() << " from " << 42 << " took "
+           << 1.5 << " ms: " << "ok";
+    benchmark::DoNotOptimize(Stream.str());
+  }
+}
+BENCHMARK(BM_Stringstream);
+
+static void BM_FormatToInt(benchmark::State& state) {
+  char Buffer[32];
+  int Value = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::format_to(Buffer, "{}", Value++));
+    benchmark::DoNotOptimize(Buffer);
+  }
+}
+BENCHMARK(BM_FormatToInt);
+
+static void BM_SnprintfInt(benchmark::State& state) {
+  char Buffer[32];
+  int Value = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::snprintf(Buffer, sizeof(Buffer), "%d", Value++));
+    benchmark::DoNotOptimize(Buffer);
+  }
+}
+BENCHMARK(BM_SnprintfInt);
+
+BENCHMARK_MAIN();
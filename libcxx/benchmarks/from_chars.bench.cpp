@@ -0,0 +1,54 @@
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// Numbers as they commonly appear in JSON or CSV files, with a few digits of
+// precision, and numbers printed with enough digits to round-trip.
+std::vector<std::string> generateInput(int Precision) {
+  std::mt19937_64 Gen(42);
+  std::uniform_real_distribution<double> Dist(-1e6, 1e6);
+  std::vector<std::string> Res;
+  char Buf[32];
+  for (int I = 0; I < 1024; ++I) {
+    std::snprintf(Buf, sizeof(Buf), "%.*g", Precision, Dist(Gen));
+    Res.push_back(Buf);
+  }
+  return Res;
+}
+
+void BM_FromChars(benchmark::State& State) {
+  std::vector<std::string> Input = generateInput(State.range(0));
+  double Value;
+  for (auto _ : State) {
+    for (const std::string& S : Input) {
+      std::from_chars(S.data(), S.data() + S.size(), Value);
+      benchmark::DoNotOptimize(Value);
+    }
+  }
+  State.SetItemsProcessed(State.iterations() * Input.size());
+}
+BENCHMARK(BM_FromChars)->Arg(6)->Arg(17);
+
+void BM_Strtod(benchmark::State& State) {
+  std::vector<std::string> Input = generateInput(State.range(0));
+  double Value;
+  for (auto _ : State) {
+    for (const std::string& S : Input) {
+      Value = std::strtod(S.c_str(), nullptr);
+      benchmark::DoNotOptimize(Value);
+    }
+  }
+  State.SetItemsProcessed(State.iterations() * Input.size());
+}
+BENCHMARK(BM_Strtod)->Arg(6)->Arg(17);
+
+} // namespace
+
+BENCHMARK_MAIN();
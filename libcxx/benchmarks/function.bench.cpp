@@ -24,17 +24,19 @@ enum class FunctionType {
   MemberPointer,
   SmallTrivialFunctor,
   SmallNonTrivialFunctor,
+  MediumFunctor,
   LargeTrivialFunctor,
   LargeNonTrivialFunctor
 };
 
-struct AllFunctionTypes : EnumValuesAsTuple<AllFunctionTypes, FunctionType, 8> {
+struct AllFunctionTypes : EnumValuesAsTuple<AllFunctionTypes, FunctionType, 9> {
   static constexpr const char* Names[] = {"Null",
                                           "FuncPtr",
                                           "MemFuncPtr",
                                           "MemPtr",
                                           "SmallTrivialFunctor",
                                           "SmallNonTrivialFunctor",
+                                          "MediumFunctor",
                                           "LargeTrivialFunctor",
                                           "LargeNonTrivialFunctor"};
 };
@@ -61,6 +63,13 @@ struct SmallNonTrivialFunctor {
   ~SmallNonTrivialFunctor() {}
   int operator()(const S*) const { return 0; }
 };
+// Typical of a lambda capturing a few references and a std::shared_ptr. Only
+// stored inline when std::function uses the larger small buffer.
+struct MediumFunctor {
+  void* captures[3] = {};
+  std::shared_ptr<int> state;
+  int operator()(const S*) const { return 0; }
+};
 struct LargeTrivialFunctor {
   LargeTrivialFunctor() {
       // Do not spend time initializing the padding.
@@ -95,6 +104,8 @@ inline Function MakeFunction(FunctionType type, bool opaque = false) {
       return maybeOpaque(SmallTrivialFunctor{}, opaque);
     case FunctionType::SmallNonTrivialFunctor:
       return maybeOpaque(SmallNonTrivialFunctor{}, opaque);
+    case FunctionType::MediumFunctor:
+      return maybeOpaque(MediumFunctor{}, opaque);
     case FunctionType::LargeTrivialFunctor:
       return maybeOpaque(LargeTrivialFunctor{}, opaque);
     case FunctionType::LargeNonTrivialFunctor:
@@ -212,6 +223,50 @@ struct InvokeInlined {
   }
 };
 
+#if TEST_STD_VER > 20
+template <class FunctionType>
+struct MoveOnlyConstructAndDestroy {
+  static void run(benchmark::State& state) {
+    for (auto _ : state) {
+      std::move_only_function<int(const S*) const> f;
+      switch (FunctionType()) {
+        case ::FunctionType::Null:
+          break;
+        case ::FunctionType::FunctionPointer:
+          f = FunctionWithS;
+          break;
+        case ::FunctionType::MemberFunctionPointer:
+          f = &S::function;
+          break;
+        case ::FunctionType::MemberPointer:
+          f = &S::field;
+          break;
+        case ::FunctionType::SmallTrivialFunctor:
+          f = SmallTrivialFunctor{};
+          break;
+        case ::FunctionType::SmallNonTrivialFunctor:
+          f = SmallNonTrivialFunctor{};
+          break;
+        case ::FunctionType::MediumFunctor:
+          f = MediumFunctor{};
+          break;
+        case ::FunctionType::LargeTrivialFunctor:
+          f = LargeTrivialFunctor{};
+          break;
+        case ::FunctionType::LargeNonTrivialFunctor:
+          f = LargeNonTrivialFunctor{};
+          break;
+      }
+      benchmark::DoNotOptimize(f);
+    }
+  }
+
+  static std::string name() {
+    return "BM_MoveOnlyConstructAndDestroy" + FunctionType::name();
+  }
+};
+#endif
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -227,5 +282,9 @@ int main(int argc, char** argv) {
   makeCartesianProductBenchmark<OperatorBool, AllFunctionTypes>();
   makeCartesianProductBenchmark<Invoke, AllFunctionTypes>();
   makeCartesianProductBenchmark<InvokeInlined, AllFunctionTypes>();
+#if TEST_STD_VER > 20
+  makeCartesianProductBenchmark<MoveOnlyConstructAndDestroy,
+                                AllFunctionTypes>();
+#endif
   benchmark::RunSpecifiedBenchmarks();
 }
@@ -2,6 +2,7 @@
 #include "test_macros.h"
 
 #include <sstream>
+#include <string>
 
 TEST_NOINLINE double istream_numbers();
 
@@ -37,4 +38,34 @@ static void BM_Istream_numbers(benchmark::State &state) {
 }
 
 BENCHMARK(BM_Istream_numbers)->RangeMultiplier(2)->Range(1024, 4096);
+
+static void BM_Istream_ints(benchmark::State &state) {
+  std::string input;
+  for (int i = 0; i < 1000; ++i)
+    input += std::to_string(i * 7919 - 3000000) + ' ';
+  for (auto _ : state) {
+    std::istringstream s(input);
+    long v, sum = 0;
+    while (s >> v)
+      sum += v;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_Istream_ints);
+
+template <class T>
+static void BM_Ostream_number(benchmark::State &state) {
+  std::ostringstream s;
+  for (auto _ : state) {
+    s.str(std::string());
+    for (int i = 0; i < 1000; ++i)
+      s << static_cast<T>(i * 7919 - 3000000) << ' ';
+    benchmark::DoNotOptimize(s.str());
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK_TEMPLATE(BM_Ostream_number, int);
+BENCHMARK_TEMPLATE(BM_Ostream_number, unsigned long long);
+BENCHMARK_TEMPLATE(BM_Ostream_number, double);
 BENCHMARK_MAIN();
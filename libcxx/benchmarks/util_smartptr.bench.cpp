@@ -38,4 +38,30 @@ static void BM_WeakPtrIncDecRef(benchmark::State& st) {
 }
 BENCHMARK(BM_WeakPtrIncDecRef);
 
+// All threads copy the same shared_ptr, so they contend on one control block.
+static void BM_SharedPtrIncDecRefContended(benchmark::State& st) {
+  static std::shared_ptr<int> sp;
+  if (st.thread_index == 0)
+    sp = std::make_shared<int>(42);
+  for (auto _ : st) {
+    std::shared_ptr<int> sp2(sp);
+    benchmark::ClobberMemory();
+  }
+  if (st.thread_index == 0)
+    sp.reset();
+}
+BENCHMARK(BM_SharedPtrIncDecRefContended)->ThreadRange(1, 8);
+
+// Each thread owns its own object, but consecutive make_shared allocations may
+// place the control blocks on the same cache line.
+static void BM_SharedPtrIncDecRefFalseSharing(benchmark::State& st) {
+  auto sp = std::make_shared<int>(42);
+  benchmark::DoNotOptimize(sp.get());
+  for (auto _ : st) {
+    std::shared_ptr<int> sp2(sp);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SharedPtrIncDecRefFalseSharing)->ThreadRange(1, 8);
+
 BENCHMARK_MAIN();
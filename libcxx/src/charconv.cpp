@@ -7,6 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "charconv"
+#include <cfloat>
+#include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 
 _LIBCPP_BEGIN_NAMESPACE_STD
@@ -157,4 +160,260 @@ __u64toa(uint64_t value, char* buffer) noexcept
 
 }  // namespace __itoa
 
+namespace
+{
+
+// The number of significant digits kept when parsing a floating-point number.
+// Any digit after the 767th significant decimal digit of a double can only
+// matter through being nonzero, which is recorded by a trailing '1' digit.
+constexpr size_t max_significant_digits = 800;
+
+// Whether floating-point arithmetic is done in the precision of its type, so
+// that a product or quotient of exact values is correctly rounded.
+constexpr bool exact_arithmetic = FLT_EVAL_METHOD == 0;
+
+template <class T>
+struct fp_traits;
+
+template <>
+struct fp_traits<float>
+{
+    static constexpr uint64_t max_exact_integer = uint64_t(1) << 24;
+    static constexpr int max_exact_pow10 = 10;
+
+    static float pow10(int e)
+    {
+        static constexpr float table[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                          1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        return table[e];
+    }
+
+    static float parse(const char* str, char** end) { return strtof(str, end); }
+};
+
+template <>
+struct fp_traits<double>
+{
+    static constexpr uint64_t max_exact_integer = uint64_t(1) << 53;
+    static constexpr int max_exact_pow10 = 22;
+
+    static double pow10(int e)
+    {
+        static constexpr double table[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        return table[e];
+    }
+
+    static double parse(const char* str, char** end) { return strtod(str, end); }
+};
+
+// Advances p past the lowercase literal lit if [p, last) starts with it,
+// ignoring case.
+bool
+consume_literal(const char*& p, const char* last, const char* lit) noexcept
+{
+    const char* q = p;
+    for (; *lit; ++lit, ++q)
+        if (q == last || (*q | 0x20) != *lit)
+            return false;
+    p = q;
+    return true;
+}
+
+bool
+is_digit(char c, bool hex) noexcept
+{
+    if ('0' <= c && c <= '9')
+        return true;
+    return hex && 'a' <= (c | 0x20) && (c | 0x20) <= 'f';
+}
+
+template <class T>
+from_chars_result
+from_chars_floating_point(const char* first, const char* last, T& value,
+                          chars_format fmt) noexcept
+{
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    if (negative)
+        ++p;
+
+    if (consume_literal(p, last, "inf"))
+    {
+        consume_literal(p, last, "inity");
+        value = negative ? -numeric_limits<T>::infinity()
+                         : numeric_limits<T>::infinity();
+        return {p, {}};
+    }
+    if (consume_literal(p, last, "nan"))
+    {
+        const char* q = p;
+        if (q != last && *q == '(')
+        {
+            for (++q; q != last && (is_digit(*q, true) ||
+                                    ('a' <= (*q | 0x20) && (*q | 0x20) <= 'z') ||
+                                    *q == '_');
+                 ++q)
+                ;
+            if (q != last && *q == ')')
+                p = q + 1;
+        }
+        value = negative ? -numeric_limits<T>::quiet_NaN()
+                         : numeric_limits<T>::quiet_NaN();
+        return {p, {}};
+    }
+
+    // Collect the significant digits, leaving room for a "0x" prefix, the
+    // trailing nonzero digit, and the exponent.
+    const bool hex = fmt == chars_format::hex;
+    char buffer[2 + max_significant_digits + 1 + 16];
+    char* digits = buffer + 2;
+    size_t num_digits = 0;
+    bool dropped_nonzero = false;
+    bool any_digits = false;
+    long long exponent = 0;
+
+    for (; p != last && is_digit(*p, hex); ++p)
+    {
+        any_digits = true;
+        if (num_digits == 0 && *p == '0')
+            continue;
+        if (num_digits < max_significant_digits)
+            digits[num_digits++] = *p;
+        else
+        {
+            ++exponent;
+            dropped_nonzero |= *p != '0';
+        }
+    }
+    if (p != last && *p == '.')
+    {
+        for (++p; p != last && is_digit(*p, hex); ++p)
+        {
+            any_digits = true;
+            if (num_digits == 0 && *p == '0')
+                --exponent;
+            else if (num_digits < max_significant_digits)
+            {
+                digits[num_digits++] = *p;
+                --exponent;
+            }
+            else
+                dropped_nonzero |= *p != '0';
+        }
+    }
+    if (!any_digits)
+        return {first, errc::invalid_argument};
+
+    // Hexadecimal digits are scaled by powers of two.
+    if (hex)
+        exponent *= 4;
+
+    bool has_exponent = false;
+    if (fmt != chars_format::fixed && p != last &&
+        (*p | 0x20) == (hex ? 'p' : 'e'))
+    {
+        const char* q = p + 1;
+        bool exponent_negative = q != last && *q == '-';
+        if (q != last && (*q == '+' || *q == '-'))
+            ++q;
+        if (q != last && '0' <= *q && *q <= '9')
+        {
+            long long explicit_exponent = 0;
+            for (; q != last && '0' <= *q && *q <= '9'; ++q)
+                if (explicit_exponent < 100000000)
+                    explicit_exponent = explicit_exponent * 10 + (*q - '0');
+            exponent += exponent_negative ? -explicit_exponent
+                                          : explicit_exponent;
+            has_exponent = true;
+            p = q;
+        }
+    }
+    if (fmt == chars_format::scientific && !has_exponent)
+        return {first, errc::invalid_argument};
+
+    if (num_digits == 0)
+    {
+        value = negative ? -T(0) : T(0);
+        return {p, {}};
+    }
+
+    // Fast path: an integer and a power of ten which are both exactly
+    // representable give a correctly rounded result with one operation.
+    if (exact_arithmetic && !hex && !dropped_nonzero && num_digits <= 19 &&
+        -fp_traits<T>::max_exact_pow10 <= exponent &&
+        exponent <= fp_traits<T>::max_exact_pow10)
+    {
+        uint64_t mantissa = 0;
+        for (size_t i = 0; i < num_digits; ++i)
+            mantissa = mantissa * 10 + (digits[i] - '0');
+        if (mantissa <= fp_traits<T>::max_exact_integer)
+        {
+            T result = static_cast<T>(mantissa);
+            if (exponent < 0)
+                result /= fp_traits<T>::pow10(static_cast<int>(-exponent));
+            else
+                result *= fp_traits<T>::pow10(static_cast<int>(exponent));
+            value = negative ? -result : result;
+            return {p, {}};
+        }
+    }
+
+    // Otherwise leave the rounding to strtod, passing it the significant
+    // digits as an integer, which avoids the locale-dependent radix character.
+    char* q = digits + num_digits;
+    if (dropped_nonzero)
+    {
+        *q++ = '1';
+        exponent -= hex ? 4 : 1;
+    }
+    *q++ = hex ? 'p' : 'e';
+    if (exponent < 0)
+    {
+        *q++ = '-';
+        exponent = -exponent;
+    }
+    // Beyond this, the value is zero or infinite anyway.
+    if (exponent > 100000000)
+        exponent = 100000000;
+    q = __itoa::__u64toa(static_cast<uint64_t>(exponent), q);
+    *q = '\0';
+
+    char* start = digits;
+    if (hex)
+    {
+        start = buffer;
+        buffer[0] = '0';
+        buffer[1] = 'x';
+    }
+    int saved_errno = errno;
+    T result = fp_traits<T>::parse(start, nullptr);
+    errno = saved_errno;
+
+    // The significand is nonzero, so a zero or infinite result means that the
+    // value is out of range.
+    if (result == 0 || result == numeric_limits<T>::infinity())
+        return {p, errc::result_out_of_range};
+    value = negative ? -result : result;
+    return {p, {}};
+}
+
+}  // namespace
+
+from_chars_result
+from_chars(const char* first, const char* last, float& value,
+           chars_format fmt)
+{
+    return from_chars_floating_point(first, last, value, fmt);
+}
+
+from_chars_result
+from_chars(const char* first, const char* last, double& value,
+           chars_format fmt)
+{
+    return from_chars_floating_point(first, last, value, fmt);
+}
+
 _LIBCPP_END_NAMESPACE_STD
@@ -0,0 +1,169 @@
+//===------------------------ parallel_algorithms.cpp ---------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "__config"
+
+#if defined(_LIBCPP_HAS_THREAD_POOL_ALGORITHMS)
+
+#include "execution"
+#include "thread"
+
+#if defined(_LIBCPP_THREAD_POOL_USE_LIBDISPATCH)
+#  include <dispatch/dispatch.h>
+#else
+#  include "algorithm"
+#  include "atomic"
+#  include "condition_variable"
+#  include "mutex"
+#  include "vector"
+#endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if defined(_LIBCPP_THREAD_POOL_USE_LIBDISPATCH)
+
+unsigned __libcpp_parallel_concurrency()
+{
+    unsigned __n = thread::hardware_concurrency();
+    return __n == 0 ? 1 : __n;
+}
+
+void __libcpp_parallel_for(size_t __chunks, void* __context, void (*__body)(void*, size_t))
+{
+    ::dispatch_apply_f(__chunks, ::dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0),
+                       __context, __body);
+}
+
+#else // defined(_LIBCPP_THREAD_POOL_USE_LIBDISPATCH)
+
+namespace {
+
+// One call of __libcpp_parallel_for. The calling thread and the workers take
+// chunks from it until there are none left.
+struct __parallel_job
+{
+    size_t __chunks_;
+    void* __context_;
+    void (*__body_)(void*, size_t);
+    atomic<size_t> __next_{0};
+    // The following are guarded by the mutex of the pool.
+    size_t __done_ = 0;
+    // Workers that took the job and may still access it.
+    unsigned __workers_ = 0;
+
+    // Runs chunks until there are none left, and returns how many it ran.
+    size_t __run()
+    {
+        size_t __ran = 0;
+        for (size_t __i; (__i = __next_.fetch_add(1, memory_order_relaxed)) < __chunks_; ++__ran)
+            __body_(__context_, __i);
+        return __ran;
+    }
+};
+
+// Threads that are started with the first parallel algorithm and live until
+// the process exits. Since the calling thread also runs chunks of its own job,
+// a chunk may run a nested parallel algorithm without deadlocking.
+class __thread_pool
+{
+    mutex __mut_;
+    condition_variable __work_cv_;
+    condition_variable __done_cv_;
+    vector<__parallel_job*> __jobs_;
+    unsigned __concurrency_;
+
+    void __worker()
+    {
+        unique_lock<mutex> __lk(__mut_);
+        while (true) {
+            __work_cv_.wait(__lk, [this] { return !__jobs_.empty(); });
+            __parallel_job* __job = __jobs_.back();
+            if (__job->__next_.load(memory_order_relaxed) >= __job->__chunks_) {
+                __jobs_.pop_back();
+                continue;
+            }
+            ++__job->__workers_;
+            __lk.unlock();
+            size_t __ran = __job->__run();
+            __lk.lock();
+            __job->__done_ += __ran;
+            --__job->__workers_;
+            if (__job->__done_ == __job->__chunks_ && __job->__workers_ == 0)
+                __done_cv_.notify_all();
+        }
+    }
+
+public:
+    __thread_pool()
+    {
+        unsigned __n = thread::hardware_concurrency();
+        __concurrency_ = __n == 0 ? 1 : __n;
+#ifndef _LIBCPP_NO_EXCEPTIONS
+        try {
+#endif
+            for (unsigned __i = 1; __i < __concurrency_; ++__i)
+                thread([this] { __worker(); }).detach();
+#ifndef _LIBCPP_NO_EXCEPTIONS
+        } catch (...) {
+            // Run with the threads that could be started.
+        }
+#endif
+    }
+
+    unsigned __concurrency() const { return __concurrency_; }
+
+    void __run(__parallel_job& __job)
+    {
+        {
+            lock_guard<mutex> __lk(__mut_);
+            __jobs_.push_back(&__job);
+        }
+        __work_cv_.notify_all();
+        size_t __ran = __job.__run();
+
+        unique_lock<mutex> __lk(__mut_);
+        __job.__done_ += __ran;
+        auto __it = _VSTD::find(__jobs_.begin(), __jobs_.end(), &__job);
+        if (__it != __jobs_.end())
+            __jobs_.erase(__it);
+        __done_cv_.wait(__lk, [&] {
+            return __job.__done_ == __job.__chunks_ && __job.__workers_ == 0;
+        });
+    }
+};
+
+__thread_pool& __get_thread_pool()
+{
+    // Never destroyed, the workers may still wait on it while the process
+    // exits.
+    static __thread_pool* __pool = new __thread_pool;
+    return *__pool;
+}
+
+} // namespace
+
+unsigned __libcpp_parallel_concurrency()
+{
+    return __get_thread_pool().__concurrency();
+}
+
+void __libcpp_parallel_for(size_t __chunks, void* __context, void (*__body)(void*, size_t))
+{
+    if (__chunks == 1) {
+        __body(__context, 0);
+        return;
+    }
+    __parallel_job __job{__chunks, __context, __body};
+    __get_thread_pool().__run(__job);
+}
+
+#endif // defined(_LIBCPP_THREAD_POOL_USE_LIBDISPATCH)
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // defined(_LIBCPP_HAS_THREAD_POOL_ALGORITHMS)
@@ -0,0 +1,184 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-threads
+
+// <execution>
+
+// The execution policy overloads of LIBCXX_ENABLE_THREAD_POOL_ALGORITHMS give
+// the results of the serial algorithms, whether or not the range is split into
+// chunks.
+
+#include <execution>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "test_macros.h"
+
+#if defined(_LIBCPP_HAS_THREAD_POOL_ALGORITHMS)
+
+// Composition of x -> a * x + b, which is associative but not commutative.
+struct Affine {
+  long a;
+  long b;
+};
+
+Affine compose(Affine f, Affine g) { return {f.a * g.a, f.b * g.a + g.b}; }
+
+bool operator==(Affine f, Affine g) { return f.a == g.a && f.b == g.b; }
+
+std::vector<int> make_values(std::size_t n) {
+  std::vector<int> v(n);
+  for (std::size_t i = 0; i != n; ++i)
+    v[i] = static_cast<int>((i * 7919) % 1009) - 500;
+  return v;
+}
+
+template <class Policy>
+void test_for_each(Policy&& policy, std::size_t n) {
+  std::vector<int> v(n, 1);
+  std::for_each(policy, v.begin(), v.end(), [](int& x) { x += 1; });
+  assert(std::count(v.begin(), v.end(), 2) == static_cast<std::ptrdiff_t>(n));
+
+  std::vector<int>::iterator it = std::for_each_n(policy, v.begin(), n / 2, [](int& x) { x = 0; });
+  assert(it == v.begin() + n / 2);
+  assert(std::count(v.begin(), v.end(), 0) == static_cast<std::ptrdiff_t>(n / 2));
+
+  // Forward iterators always run the serial algorithm.
+  std::list<int> l(n, 1);
+  std::for_each(policy, l.begin(), l.end(), [](int& x) { x += 1; });
+  assert(std::count(l.begin(), l.end(), 2) == static_cast<std::ptrdiff_t>(n));
+}
+
+template <class Policy>
+void test_sort(Policy&& policy, std::size_t n) {
+  std::vector<int> v = make_values(n);
+  std::vector<int> expected = v;
+  std::sort(expected.begin(), expected.end());
+  std::sort(policy, v.begin(), v.end());
+  assert(v == expected);
+
+  std::sort(policy, v.begin(), v.end(), std::greater<int>());
+  std::reverse(expected.begin(), expected.end());
+  assert(v == expected);
+
+  // Sort on the value only, the index tells whether the order of equal
+  // values was kept.
+  std::vector<std::pair<int, std::size_t> > p;
+  for (std::size_t i = 0; i != n; ++i)
+    p.push_back(std::make_pair(static_cast<int>(i % 13), i));
+  std::vector<std::pair<int, std::size_t> > stable = p;
+  auto by_value = [](const std::pair<int, std::size_t>& x, const std::pair<int, std::size_t>& y) {
+    return x.first < y.first;
+  };
+  std::stable_sort(stable.begin(), stable.end(), by_value);
+  std::stable_sort(policy, p.begin(), p.end(), by_value);
+  assert(p == stable);
+}
+
+template <class Policy>
+void test_reduce(Policy&& policy, std::size_t n) {
+  std::vector<int> v = make_values(n);
+  long sum = std::accumulate(v.begin(), v.end(), 0L);
+  assert(std::reduce(policy, v.begin(), v.end()) == sum);
+  assert(std::reduce(policy, v.begin(), v.end(), 10L) == sum + 10);
+  assert(std::reduce(policy, v.begin(), v.end(), 0L, std::plus<long>()) == sum);
+
+  long squares = 0;
+  for (int x : v)
+    squares += long(x) * x;
+  assert(std::transform_reduce(policy, v.begin(), v.end(), v.begin(), 0L) == squares);
+  assert(std::transform_reduce(policy, v.begin(), v.end(), 0L, std::plus<long>(),
+                               [](int x) { return long(x) * x; }) == squares);
+
+  std::list<int> l(v.begin(), v.end());
+  assert(std::reduce(policy, l.begin(), l.end(), 0L) == sum);
+}
+
+template <class Policy>
+void test_scan(Policy&& policy, std::size_t n) {
+  std::vector<int> v = make_values(n);
+  std::vector<long> expected(n);
+  std::vector<long> out(n);
+
+  std::inclusive_scan(v.begin(), v.end(), expected.begin());
+  assert(std::inclusive_scan(policy, v.begin(), v.end(), out.begin()) == out.end());
+  assert(out == expected);
+
+  std::inclusive_scan(v.begin(), v.end(), expected.begin(), std::plus<>(), 5L);
+  std::inclusive_scan(policy, v.begin(), v.end(), out.begin(), std::plus<>(), 5L);
+  assert(out == expected);
+
+  std::exclusive_scan(v.begin(), v.end(), expected.begin(), 5L);
+  assert(std::exclusive_scan(policy, v.begin(), v.end(), out.begin(), 5L) == out.end());
+  assert(out == expected);
+
+  // In place.
+  std::vector<int> in_place = v;
+  std::vector<int> in_place_expected(n);
+  std::inclusive_scan(v.begin(), v.end(), in_place_expected.begin());
+  std::inclusive_scan(policy, in_place.begin(), in_place.end(), in_place.begin());
+  assert(in_place == in_place_expected);
+
+  // The chunks are combined in order.
+  std::vector<Affine> f;
+  for (std::size_t i = 0; i != n; ++i)
+    f.push_back(Affine{static_cast<long>(i % 3) - 1, static_cast<long>(i % 5)});
+  std::vector<Affine> f_expected(n, Affine{0, 0});
+  std::vector<Affine> f_out(n, Affine{0, 0});
+  std::inclusive_scan(f.begin(), f.end(), f_expected.begin(), compose);
+  std::inclusive_scan(policy, f.begin(), f.end(), f_out.begin(), compose);
+  assert(f_out == f_expected);
+  std::exclusive_scan(f.begin(), f.end(), f_expected.begin(), Affine{1, 0}, compose);
+  std::exclusive_scan(policy, f.begin(), f.end(), f_out.begin(), Affine{1, 0}, compose);
+  assert(f_out == f_expected);
+}
+
+template <class Policy>
+void test_policy(Policy&& policy) {
+  static_assert(std::is_execution_policy_v<std::remove_cv_t<std::remove_reference_t<Policy> > >, "");
+  // Too small to split, a few chunks, and more chunks than threads.
+  for (std::size_t n : {0, 1, 2, 1000, 5000, 200000}) {
+    test_for_each(policy, n);
+    test_sort(policy, n);
+    test_reduce(policy, n);
+    test_scan(policy, n);
+  }
+}
+
+void test_nested() {
+  // A chunk running a parallel algorithm itself must not deadlock.
+  std::vector<std::vector<int> > v(64, std::vector<int>(4096, 1));
+  std::atomic<long> sum(0);
+  std::for_each(std::execution::par, v.begin(), v.end(), [&](std::vector<int>& inner) {
+    sum += std::reduce(std::execution::par, inner.begin(), inner.end(), 0L);
+  });
+  assert(sum == 64 * 4096);
+}
+
+#endif // defined(_LIBCPP_HAS_THREAD_POOL_ALGORITHMS)
+
+int main(int, char**) {
+#if defined(_LIBCPP_HAS_THREAD_POOL_ALGORITHMS)
+  static_assert(!std::is_execution_policy_v<int>, "");
+  test_policy(std::execution::seq);
+  test_policy(std::execution::par);
+  test_policy(std::execution::par_unseq);
+  test_nested();
+#endif
+
+  return 0;
+}
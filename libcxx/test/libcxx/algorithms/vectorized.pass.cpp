@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <algorithm>
+
+// find, count, mismatch and equal use vectorized kernels for pointers to
+// integral and pointer types that fit a vector lane. Check them around the
+// block boundaries, and that wider types such as __int128 still compile.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#include "test_macros.h"
+
+template <class T>
+void test() {
+    static_assert(std::__libcpp_is_bitwise_equality_comparable<T>::value ==
+                      (sizeof(T) <= 8), "");
+
+    const int N = 67;
+    for (int n = 0; n <= N; ++n) {
+        T a[N + 1];
+        T b[N + 1];
+        for (int i = 0; i != n; ++i)
+            a[i] = b[i] = T(i % 3 + 1);
+
+        for (int i = 0; i <= n; ++i) {
+            if (i != n)
+                a[i] = T(0);
+            assert(std::find(a, a + n, T(0)) == a + i);
+            assert(std::count(a, a + n, T(0)) == (i != n ? 1 : 0));
+            assert(std::mismatch(a, a + n, b).first == a + i);
+            assert(std::equal(a, a + n, b) == (i == n));
+            if (i != n)
+                a[i] = b[i];
+        }
+        assert(std::count(a, a + n, T(1)) == (n + 2) / 3);
+    }
+}
+
+int main(int, char**)
+{
+    test<char>();
+    test<unsigned char>();
+    test<short>();
+    test<int>();
+    test<long>();
+    test<long long>();
+#ifndef _LIBCPP_HAS_NO_INT128
+    test<__int128_t>();
+    test<__uint128_t>();
+#endif
+
+    return 0;
+}
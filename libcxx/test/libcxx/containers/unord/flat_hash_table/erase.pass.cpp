@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// UNSUPPORTED: c++03
+
+// Not a portable test
+
+// <__flat_hash_table>
+
+// template <class Value, class Hash, class Pred, class Alloc>
+//   class __flat_unordered_set;
+
+// iterator erase(const_iterator p);
+// size_type erase(const key_type& k);
+// void clear();
+
+#include <__flat_hash_table>
+#include <cassert>
+#include <cstddef>
+
+#include "test_macros.h"
+
+struct ConstantHash {
+  std::size_t operator()(int) const { return 0; }
+};
+
+template <class Set>
+void test() {
+  {
+    Set s;
+    assert(s.erase(1) == 0);
+    for (int i = 0; i < 1000; ++i)
+      s.insert(i);
+    assert(s.erase(1000) == 0);
+    for (int i = 0; i < 1000; i += 2)
+      assert(s.erase(i) == 1);
+    assert(s.size() == 500);
+    for (int i = 0; i < 1000; ++i)
+      assert(s.contains(i) == (i % 2 == 1));
+  }
+  {
+    // erase(p) returns the iterator following p, so that the whole table can
+    // be walked while erasing.
+    Set s;
+    for (int i = 0; i < 1000; ++i)
+      s.insert(i);
+    std::size_t visited = 0;
+    for (typename Set::const_iterator it = s.begin(); it != s.end();) {
+      ++visited;
+      if (*it % 3 == 0)
+        it = s.erase(it);
+      else
+        ++it;
+    }
+    assert(visited == 1000);
+    assert(s.size() == 666);
+    for (int i = 0; i < 1000; ++i)
+      assert(s.contains(i) == (i % 3 != 0));
+  }
+  {
+    // Erasing and inserting over and over leaves deleted slots behind, which
+    // must neither hide elements nor make the table grow without bound.
+    Set s;
+    for (int i = 0; i < 50; ++i)
+      s.insert(i);
+    for (int round = 0; round < 2000; ++round) {
+      assert(s.erase(round) == 1);
+      assert(s.insert(round + 50).second);
+      assert(s.size() == 50);
+    }
+    for (int i = 0; i < 2050; ++i)
+      assert(s.contains(i) == (i >= 2000));
+    assert(s.load_factor() > 0.1f);
+  }
+  {
+    Set s;
+    for (int i = 0; i < 100; ++i)
+      s.insert(i);
+    s.clear();
+    assert(s.empty());
+    assert(s.begin() == s.end());
+    assert(!s.contains(5));
+    assert(s.insert(5).second);
+    assert(s.size() == 1);
+  }
+}
+
+int main(int, char**) {
+  test<std::__flat_unordered_set<int> >();
+  test<std::__flat_unordered_set<int, ConstantHash> >();
+
+  return 0;
+}
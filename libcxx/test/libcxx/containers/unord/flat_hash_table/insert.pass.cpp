@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// UNSUPPORTED: c++03
+
+// Not a portable test
+
+// <__flat_hash_table>
+
+// template <class Value, class Hash, class Pred, class Alloc>
+//   class __flat_unordered_set;
+
+// pair<iterator, bool> insert(const value_type& x);
+// pair<iterator, bool> emplace(Args&&... args);
+
+#include <__flat_hash_table>
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+#include "test_macros.h"
+
+// Sends every key to the same slot, so that lookups have to probe over full
+// groups of control bytes.
+struct ConstantHash {
+  std::size_t operator()(int) const { return 0; }
+};
+
+int main(int, char**) {
+  {
+    std::__flat_unordered_set<int> s;
+    assert(s.empty());
+    assert(s.find(1) == s.end());
+    assert(s.begin() == s.end());
+
+    for (int i = 0; i < 10000; ++i) {
+      std::pair<std::__flat_unordered_set<int>::iterator, bool> r = s.insert(i);
+      assert(r.second);
+      assert(*r.first == i);
+    }
+    assert(s.size() == 10000);
+    assert(s.load_factor() <= 0.875f);
+    for (int i = 0; i < 10000; ++i) {
+      assert(s.count(i) == 1);
+      assert(*s.find(i) == i);
+    }
+    assert(!s.contains(-1));
+    assert(!s.contains(10000));
+
+    // Inserting a present key returns the existing element.
+    std::pair<std::__flat_unordered_set<int>::iterator, bool> r = s.insert(42);
+    assert(!r.second);
+    assert(*r.first == 42);
+    assert(s.size() == 10000);
+
+    // Every element is visited once.
+    std::size_t n = 0;
+    long long sum = 0;
+    for (int x : s) {
+      ++n;
+      sum += x;
+    }
+    assert(n == 10000);
+    assert(sum == 10000LL * 9999 / 2);
+  }
+  {
+    std::__flat_unordered_set<std::string> s;
+    assert(s.emplace(3, 'a').second);
+    assert(s.insert(std::string("aaa")).second == false);
+    assert(s.insert("b").second);
+    assert(s.size() == 2);
+    assert(s.contains("aaa"));
+    assert(s.contains("b"));
+  }
+  {
+    std::__flat_unordered_set<int, ConstantHash> s;
+    for (int i = 0; i < 100; ++i)
+      assert(s.insert(i).second);
+    for (int i = 0; i < 100; ++i)
+      assert(s.contains(i));
+    assert(!s.contains(100));
+  }
+  {
+    std::__flat_unordered_set<int> s = {1, 2, 3, 2, 1};
+    assert(s.size() == 3);
+    s.insert({3, 4, 5});
+    assert(s.size() == 5);
+  }
+
+  return 0;
+}
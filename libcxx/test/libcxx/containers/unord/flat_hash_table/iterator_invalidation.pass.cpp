@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// UNSUPPORTED: c++03
+
+// Not a portable test
+
+// <__flat_hash_table>
+
+// template <class Value, class Hash, class Pred, class Alloc>
+//   class __flat_unordered_set;
+
+// Inserting an element may move all the others, but erasing one doesn't move
+// the others, and inserting into a table with reserved room moves nothing.
+
+#include <__flat_hash_table>
+#include <cassert>
+#include <vector>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  {
+    std::__flat_unordered_set<int> s;
+    for (int i = 0; i < 1000; ++i)
+      s.insert(i);
+    std::vector<const int*> ptrs(1000);
+    for (int i = 0; i < 1000; ++i)
+      ptrs[i] = &*s.find(i);
+    for (int i = 0; i < 1000; i += 2)
+      s.erase(i);
+    for (int i = 1; i < 1000; i += 2) {
+      assert(*ptrs[i] == i);
+      assert(&*s.find(i) == ptrs[i]);
+    }
+  }
+  {
+    std::__flat_unordered_set<int> s;
+    s.reserve(1000);
+    s.insert(0);
+    const int* first = &*s.find(0);
+    std::__flat_unordered_set<int>::iterator it = s.find(0);
+    for (int i = 1; i < 1000; ++i)
+      s.insert(i);
+    assert(&*s.find(0) == first);
+    assert(it == s.find(0));
+    assert(*it == 0);
+  }
+  {
+    // Growing moves the elements, but the iterators returned afterwards see
+    // all of them.
+    std::__flat_unordered_set<int> s;
+    std::__flat_unordered_set<int>::iterator it = s.insert(7).first;
+    assert(*it == 7);
+    for (int i = 0; i < 1000; ++i)
+      s.insert(100 + i);
+    it = s.find(7);
+    assert(it != s.end());
+    assert(*it == 7);
+  }
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// UNSUPPORTED: c++03
+
+// Not a portable test
+
+// <__flat_hash_table>
+
+// template <class Key, class T, class Hash, class Pred, class Alloc>
+//   class __flat_unordered_map;
+
+#include <__flat_hash_table>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  {
+    std::__flat_unordered_map<int, std::string> m;
+    m[1] = "one";
+    m[2] = "two";
+    assert(m.size() == 2);
+    assert(m[1] == "one");
+    assert(m[3].empty());
+    assert(m.size() == 3);
+
+    std::__flat_unordered_map<int, std::string>::iterator it = m.find(2);
+    assert(it != m.end());
+    it->second = "deux";
+    assert(m.find(2)->second == "deux");
+
+    assert(!m.insert(std::make_pair(1, std::string("uno"))).second);
+    assert(m[1] == "one");
+    assert(m.emplace(4, "four").second);
+    assert(m.erase(4) == 1);
+    assert(!m.contains(4));
+  }
+  {
+    // try_emplace doesn't move from its arguments if the key is present.
+    std::__flat_unordered_map<int, std::unique_ptr<int> > m;
+    std::unique_ptr<int> p(new int(1));
+    assert(m.try_emplace(1, std::move(p)).second);
+    assert(!p);
+    std::unique_ptr<int> q(new int(2));
+    assert(!m.try_emplace(1, std::move(q)).second);
+    assert(q);
+    assert(*m[1] == 1);
+  }
+  {
+    std::__flat_unordered_map<std::string, int> m;
+    for (int i = 0; i < 1000; ++i)
+      m[std::to_string(i)] = i;
+    std::__flat_unordered_map<std::string, int> copy(m);
+    assert(copy.size() == 1000);
+    for (int i = 0; i < 1000; ++i)
+      assert(copy[std::to_string(i)] == i);
+
+    std::__flat_unordered_map<std::string, int> moved(std::move(copy));
+    assert(moved.size() == 1000);
+    assert(copy.empty());
+    assert(copy.find("1") == copy.end());
+
+    std::__flat_unordered_map<std::string, int> assigned;
+    assigned["x"] = 1;
+    assigned = m;
+    assert(assigned.size() == 1000);
+    assert(!assigned.contains("x"));
+
+    assigned.swap(moved);
+    moved.clear();
+    assert(moved.empty());
+    assert(assigned.size() == 1000);
+  }
+  {
+    const std::__flat_unordered_map<int, int> m = {{1, 2}, {3, 4}};
+    assert(m.size() == 2);
+    assert(m.find(3)->second == 4);
+    int sum = 0;
+    for (const auto& kv : m)
+      sum += kv.first * kv.second;
+    assert(sum == 14);
+  }
+
+  return 0;
+}
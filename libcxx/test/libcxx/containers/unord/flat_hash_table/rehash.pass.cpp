@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// UNSUPPORTED: c++03
+
+// Not a portable test
+
+// <__flat_hash_table>
+
+// template <class Value, class Hash, class Pred, class Alloc>
+//   class __flat_unordered_set;
+
+// void rehash(size_type n);
+// void reserve(size_type n);
+
+#include <__flat_hash_table>
+#include <cassert>
+#include <stdexcept>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  {
+    std::__flat_unordered_set<int> s;
+    s.rehash(0);
+    assert(s.empty());
+    s.reserve(0);
+    assert(s.load_factor() == 0.0f);
+
+    s.rehash(1000);
+    assert(s.empty());
+    for (int i = 0; i < 100; ++i)
+      s.insert(i);
+    float sparse = s.load_factor();
+    assert(sparse <= 100.0f / 1000);
+
+    // Rehashing to fewer slots than the elements need keeps all of them.
+    s.rehash(0);
+    assert(s.size() == 100);
+    assert(s.load_factor() > sparse);
+    assert(s.load_factor() <= 0.875f);
+    for (int i = 0; i < 100; ++i)
+      assert(s.contains(i));
+
+    s.rehash(100000);
+    assert(s.size() == 100);
+    for (int i = 0; i < 100; ++i)
+      assert(s.contains(i));
+  }
+  {
+    std::__flat_unordered_set<int> s(500);
+    assert(s.empty());
+    for (int i = 0; i < 500; ++i)
+      s.insert(i);
+    assert(s.size() == 500);
+  }
+  {
+    // Rehashing a table full of deleted slots empties them.
+    std::__flat_unordered_set<int> s;
+    s.reserve(100);
+    for (int i = 0; i < 100; ++i)
+      s.insert(i);
+    for (int i = 0; i < 90; ++i)
+      s.erase(i);
+    s.rehash(0);
+    assert(s.size() == 10);
+    for (int i = 0; i < 100; ++i)
+      assert(s.contains(i) == (i >= 90));
+  }
+  {
+    // Rehashing an empty table frees its slots, and reserve() still makes
+    // room afterwards.
+    std::__flat_unordered_set<int> s;
+    for (int i = 0; i < 100; ++i)
+      s.insert(i);
+    s.clear();
+    s.rehash(0);
+    assert(s.load_factor() == 0.0f);
+    s.reserve(100);
+    s.insert(1);
+    assert(s.load_factor() <= 1.0f / 100);
+  }
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  {
+    std::__flat_unordered_set<int> s;
+    s.insert(1);
+    try {
+      s.reserve(s.max_size());
+      assert(false);
+    } catch (const std::length_error&) {
+    }
+    assert(s.size() == 1);
+    assert(s.contains(1));
+  }
+#endif
+
+  return 0;
+}
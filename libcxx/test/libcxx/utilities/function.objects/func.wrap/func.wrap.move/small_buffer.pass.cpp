@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// Not a portable test
+
+// libc++ keeps callables of up to six pointers which can be moved without
+// throwing inside move_only_function, and leaves a moved-from
+// move_only_function empty.
+
+#include <functional>
+#include <cassert>
+#include <utility>
+
+#include "count_new.h"
+#include "test_macros.h"
+
+struct Small {
+  void* p[6];
+  int operator()() const { return 1; }
+};
+
+struct Large {
+  void* p[7];
+  int operator()() const { return 2; }
+};
+
+struct ThrowingMove {
+  ThrowingMove() = default;
+  ThrowingMove(ThrowingMove&&) {}
+  int operator()() const { return 3; }
+};
+
+// Counts the moves and destructions of a small, non-trivial callable.
+struct Tracked {
+  static int moves;
+  static int destroyed;
+  Tracked() = default;
+  Tracked(Tracked&&) noexcept { ++moves; }
+  ~Tracked() { ++destroyed; }
+  int operator()() const { return 4; }
+};
+int Tracked::moves = 0;
+int Tracked::destroyed = 0;
+
+int main(int, char**) {
+  globalMemCounter.reset();
+  {
+    std::move_only_function<int()> f = Small();
+    assert(globalMemCounter.checkOutstandingNewEq(0));
+    std::move_only_function<int()> g = std::move(f);
+    assert(globalMemCounter.checkOutstandingNewEq(0));
+    assert(!f);
+    assert(g() == 1);
+  }
+  {
+    std::move_only_function<int()> f = Large();
+    assert(globalMemCounter.checkOutstandingNewEq(1));
+    // Moving a heap-allocated target only moves the pointer.
+    std::move_only_function<int()> g = std::move(f);
+    assert(globalMemCounter.checkOutstandingNewEq(1));
+    assert(globalMemCounter.checkNewCalledEq(1));
+    assert(!f);
+    assert(g() == 2);
+    g = nullptr;
+    assert(globalMemCounter.checkOutstandingNewEq(0));
+  }
+  {
+    std::move_only_function<int()> f = ThrowingMove();
+    assert(globalMemCounter.checkOutstandingNewEq(1));
+    assert(f() == 3);
+  }
+  assert(globalMemCounter.checkOutstandingNewEq(0));
+  {
+    std::move_only_function<int()> f = Tracked();
+    assert(globalMemCounter.checkOutstandingNewEq(0));
+    Tracked::moves = 0;
+    Tracked::destroyed = 0;
+    std::move_only_function<int()> g = std::move(f);
+    assert(Tracked::moves == 1);
+    assert(Tracked::destroyed == 1);
+    assert(!f);
+    assert(g() == 4);
+
+    // A moved-from object can be reused.
+    f = Tracked();
+    assert(f() == 4);
+  }
+
+  return 0;
+}
@@ -0,0 +1,270 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// Not shipped in any dylib yet.
+// XFAIL: with_system_cxx_lib=macosx10.15
+// XFAIL: with_system_cxx_lib=macosx10.14
+// XFAIL: with_system_cxx_lib=macosx10.13
+// XFAIL: with_system_cxx_lib=macosx10.12
+// XFAIL: with_system_cxx_lib=macosx10.11
+// XFAIL: with_system_cxx_lib=macosx10.10
+// XFAIL: with_system_cxx_lib=macosx10.9
+
+// <charconv>
+
+// from_chars_result from_chars(const char* first, const char* last,
+//                              float& value,
+//                              chars_format fmt = chars_format::general);
+// from_chars_result from_chars(const char* first, const char* last,
+//                              double& value,
+//                              chars_format fmt = chars_format::general);
+
+#include <charconv>
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include "test_macros.h"
+
+// Parses the whole of s and checks that it gives expected.
+template <class T>
+void test_value(const char* s, T expected,
+                std::chars_format fmt = std::chars_format::general) {
+  T value = 0;
+  const char* last = s + std::strlen(s);
+  std::from_chars_result r = std::from_chars(s, last, value, fmt);
+  assert(r.ec == std::errc{});
+  assert(r.ptr == last);
+  assert(value == expected);
+  assert(std::signbit(value) == std::signbit(expected));
+}
+
+// Parses s, which only matches the pattern up to s + length.
+template <class T>
+void test_prefix(const char* s, std::size_t length, T expected,
+                 std::chars_format fmt = std::chars_format::general) {
+  T value = 0;
+  std::from_chars_result r = std::from_chars(s, s + std::strlen(s), value, fmt);
+  assert(r.ec == std::errc{});
+  assert(r.ptr == s + length);
+  assert(value == expected);
+}
+
+template <class T>
+void test_invalid(const char* s,
+                  std::chars_format fmt = std::chars_format::general) {
+  T value = 42;
+  std::from_chars_result r = std::from_chars(s, s + std::strlen(s), value, fmt);
+  assert(r.ec == std::errc::invalid_argument);
+  assert(r.ptr == s);
+  assert(value == 42);
+}
+
+template <class T>
+void test_out_of_range(const char* s,
+                       std::chars_format fmt = std::chars_format::general) {
+  T value = 42;
+  const char* last = s + std::strlen(s);
+  errno = 0;
+  std::from_chars_result r = std::from_chars(s, last, value, fmt);
+  assert(r.ec == std::errc::result_out_of_range);
+  assert(r.ptr == last);
+  assert(value == 42);
+  assert(errno == 0);
+}
+
+template <class T>
+void test_basics() {
+  test_value<T>("0", 0);
+  test_value<T>("-0", -T(0));
+  test_value<T>("1.5", T(1.5));
+  test_value<T>("-0.25", T(-0.25));
+  test_value<T>(".5", T(0.5));
+  test_value<T>("5.", 5);
+  test_value<T>("000123.4500", T(123.45));
+  test_value<T>("1e3", 1000);
+  test_value<T>("1E+3", 1000);
+  test_value<T>("2500e-3", T(2.5));
+  test_value<T>("0e99999999999", 0);
+
+  // The longest matching prefix is parsed.
+  test_prefix<T>("1.5x", 3, T(1.5));
+  test_prefix<T>("1e", 1, 1);
+  test_prefix<T>("1e+", 1, 1);
+  test_prefix<T>("1e-x", 1, 1);
+  test_prefix<T>("1..2", 2, 1);
+  test_prefix<T>("1 2", 1, 1);
+
+  test_invalid<T>("");
+  test_invalid<T>("-");
+  test_invalid<T>(".");
+  test_invalid<T>("-.");
+  test_invalid<T>("e5");
+  test_invalid<T>("+1");
+  test_invalid<T>(" 1");
+  test_prefix<T>("0x1", 1, 0);
+
+  test_value<T>("inf", std::numeric_limits<T>::infinity());
+  test_value<T>("INF", std::numeric_limits<T>::infinity());
+  test_value<T>("-Infinity", -std::numeric_limits<T>::infinity());
+  test_prefix<T>("infinit", 3, std::numeric_limits<T>::infinity());
+  test_invalid<T>("in");
+  {
+    const char* nans[] = {"nan", "-NaN", "nan()", "nan(abc_123)"};
+    for (const char* s : nans) {
+      T value = 0;
+      const char* last = s + std::strlen(s);
+      std::from_chars_result r = std::from_chars(s, last, value);
+      assert(r.ec == std::errc{});
+      assert(r.ptr == last);
+      assert(std::isnan(value));
+      assert(std::signbit(value) == (s[0] == '-'));
+    }
+    T value = 0;
+    const char* s = "nan(a b)";
+    std::from_chars_result r = std::from_chars(s, s + std::strlen(s), value);
+    assert(r.ec == std::errc{});
+    assert(r.ptr == s + 3);
+    assert(std::isnan(value));
+  }
+}
+
+template <class T>
+void test_formats() {
+  // fixed doesn't allow an exponent.
+  test_value<T>("123.5", T(123.5), std::chars_format::fixed);
+  test_prefix<T>("1.5e3", 3, T(1.5), std::chars_format::fixed);
+
+  // scientific requires one.
+  test_value<T>("1.5e3", 1500, std::chars_format::scientific);
+  test_value<T>("15E-1", T(1.5), std::chars_format::scientific);
+  test_invalid<T>("1.5", std::chars_format::scientific);
+  test_invalid<T>("1.5e", std::chars_format::scientific);
+  test_invalid<T>("1.5e+", std::chars_format::scientific);
+
+  // general allows both.
+  test_value<T>("1.5", T(1.5), std::chars_format::general);
+  test_value<T>("1.5e3", 1500, std::chars_format::general);
+  test_prefix<T>("1p3", 1, 1, std::chars_format::general);
+
+  // hex has no "0x" prefix and a binary exponent, which is optional.
+  test_value<T>("1.8p1", 3, std::chars_format::hex);
+  test_value<T>("ff", 255, std::chars_format::hex);
+  test_value<T>("A.8P0", T(10.5), std::chars_format::hex);
+  test_value<T>("1.8", T(1.5), std::chars_format::hex);
+  test_value<T>("-.8p-2", T(-0.125), std::chars_format::hex);
+  test_value<T>("1e1", 481, std::chars_format::hex);
+  test_prefix<T>("0x10", 1, 0, std::chars_format::hex);
+  test_prefix<T>("1p", 1, 1, std::chars_format::hex);
+  test_invalid<T>("p1", std::chars_format::hex);
+  test_invalid<T>("g", std::chars_format::hex);
+  test_value<T>("inf", std::numeric_limits<T>::infinity(),
+                std::chars_format::hex);
+}
+
+void test_double() {
+  // Correct rounding, on both the fast path and the slow path.
+  test_value<double>("0.1", 0.1);
+  test_value<double>("0.30000000000000004", 0.30000000000000004);
+  test_value<double>("123456789012345678901234567890", 1.2345678901234568e29);
+  test_value<double>("9007199254740993", 9007199254740992.0);
+  test_value<double>("9007199254740995", 9007199254740996.0);
+  test_value<double>("1e22", 1e22);
+  test_value<double>("1e23", 1e23);
+  test_value<double>("8.41e21", 8.41e21);
+  test_value<double>("3.14159265358979323846264338327950288", 3.141592653589793);
+
+  // 1 + 2^-53 lies halfway between 1 and the next double, and rounds to even.
+  const char* halfway =
+      "1.00000000000000011102230246251565404236316680908203125";
+  const double above_one = std::nextafter(1.0, 2.0);
+  test_value<double>(halfway, 1.0);
+  test_value<double>(
+      "1.000000000000000111022302462515654042363166809082031251", above_one);
+  test_value<double>(
+      "1.000000000000000111022302462515654042363166809082031249", 1.0);
+  // A nonzero digit far beyond the significant digits that are kept still
+  // breaks the tie.
+  {
+    std::string s = std::string(halfway) + std::string(1000, '0');
+    test_value<double>(s.c_str(), 1.0);
+    s += '1';
+    test_value<double>(s.c_str(), above_one);
+    std::string integer = "1" + std::string(1000, '0');
+    test_value<double>((integer + "e-1000").c_str(), 1.0);
+  }
+
+  // Subnormals.
+  test_value<double>("4.9406564584124654e-324",
+                     std::numeric_limits<double>::denorm_min());
+  test_value<double>("2.5e-324", std::numeric_limits<double>::denorm_min());
+  test_value<double>("2.2250738585072014e-308",
+                     std::numeric_limits<double>::min());
+  test_value<double>("2.2250738585072009e-308",
+                     std::nextafter(std::numeric_limits<double>::min(), 0.0));
+  test_value<double>("1p-1074", std::numeric_limits<double>::denorm_min(),
+                     std::chars_format::hex);
+  test_value<double>("-1p-1074", -std::numeric_limits<double>::denorm_min(),
+                     std::chars_format::hex);
+
+  // The largest values.
+  test_value<double>("1.7976931348623157e308",
+                     std::numeric_limits<double>::max());
+  test_value<double>("1.fffffffffffffp1023", std::numeric_limits<double>::max(),
+                     std::chars_format::hex);
+
+  // Out of range, in either direction.
+  test_out_of_range<double>("1e309");
+  test_out_of_range<double>("-1e309");
+  test_out_of_range<double>("1.7976931348623159e308");
+  test_out_of_range<double>("1e99999999999");
+  test_out_of_range<double>("1e-400");
+  test_out_of_range<double>("-1e-99999999999");
+  test_out_of_range<double>("1p1024", std::chars_format::hex);
+  test_out_of_range<double>("1p-1080", std::chars_format::hex);
+  {
+    std::string s = "1" + std::string(400, '0');
+    test_out_of_range<double>(s.c_str(), std::chars_format::fixed);
+  }
+}
+
+void test_float() {
+  test_value<float>("0.1", 0.1f);
+  test_value<float>("16777217", 16777216.0f);
+  test_value<float>("16777219", 16777220.0f);
+  test_value<float>("3.14159265358979", 3.14159265f);
+  test_value<float>("1.00000005960464477539062501", std::nextafter(1.0f, 2.0f));
+  test_value<float>("1.00000005960464477539062500", 1.0f);
+
+  test_value<float>("1.4e-45", std::numeric_limits<float>::denorm_min());
+  test_value<float>("1.17549435e-38", std::numeric_limits<float>::min());
+  test_value<float>("1p-149", std::numeric_limits<float>::denorm_min(),
+                    std::chars_format::hex);
+  test_value<float>("3.4028235e38", std::numeric_limits<float>::max());
+
+  test_out_of_range<float>("3.5e38");
+  test_out_of_range<float>("1e-50");
+  test_out_of_range<float>("1p128", std::chars_format::hex);
+}
+
+int main(int, char**) {
+  test_basics<float>();
+  test_basics<double>();
+  test_formats<float>();
+  test_formats<double>();
+  test_double();
+  test_float();
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// This test requires the dylib support introduced in D92214.
+// XFAIL: with_system_cxx_lib=macosx10.15
+// XFAIL: with_system_cxx_lib=macosx10.14
+// XFAIL: with_system_cxx_lib=macosx10.13
+// XFAIL: with_system_cxx_lib=macosx10.12
+// XFAIL: with_system_cxx_lib=macosx10.11
+// XFAIL: with_system_cxx_lib=macosx10.10
+// XFAIL: with_system_cxx_lib=macosx10.9
+
+// <format>
+
+// Formatting of float, double and long double.
+
+#include <format>
+#include <cassert>
+#include <limits>
+#include <string>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  // Without a presentation type and precision: the shortest representation
+  // that reads back as the value.
+  assert(std::format("{}", 0.0) == "0");
+  assert(std::format("{}", -0.0) == "-0");
+  assert(std::format("{}", 1.0) == "1");
+  assert(std::format("{}", 1.5) == "1.5");
+  assert(std::format("{}", 0.1) == "0.1");
+  assert(std::format("{}", 100.0) == "100");
+  assert(std::format("{}", 1e20) == "1e+20");
+  assert(std::format("{}", 1e-7) == "1e-07");
+  assert(std::format("{}", 0.1f) == "0.1");
+  assert(std::format("{}", 0.30000000000000004) == "0.30000000000000004");
+  assert(std::format("{}", 1.5L) == "1.5");
+
+  // Without a presentation type but with a precision: like %g.
+  assert(std::format("{:.3}", 3.14159) == "3.14");
+  assert(std::format("{:.3}", 1.0) == "1");
+  assert(std::format("{:.2}", 1234.0) == "1.2e+03");
+
+  // The presentation types.
+  assert(std::format("{:f}", 1.5) == "1.500000");
+  assert(std::format("{:.2f}", 3.14159) == "3.14");
+  assert(std::format("{:F}", 1.5) == "1.500000");
+  assert(std::format("{:e}", 1.5) == "1.500000e+00");
+  assert(std::format("{:.1E}", 1.5) == "1.5E+00");
+  assert(std::format("{:g}", 1.5) == "1.5");
+  assert(std::format("{:G}", 1e-10) == "1E-10");
+  assert(std::format("{:a}", 1.0) == "1p+0");
+  assert(std::format("{:.2a}", 1.0) == "1.00p+0");
+  assert(std::format("{:A}", 1.0) == "1P+0");
+
+  // The alternate form always has a decimal point. Only g and G also keep
+  // the trailing zeros.
+  assert(std::format("{:#}", 1.0) == "1.");
+  assert(std::format("{:#}", 1.5) == "1.5");
+  assert(std::format("{:#}", 1e20) == "1.e+20");
+  assert(std::format("{:#.3}", 1.0) == "1.");
+  assert(std::format("{:#.3}", 1.5) == "1.5");
+  assert(std::format("{:#g}", 1.0) == "1.00000");
+  assert(std::format("{:#.3g}", 1.0) == "1.00");
+  assert(std::format("{:#.0f}", 1.0) == "1.");
+  assert(std::format("{:#.0e}", 1.0) == "1.e+00");
+  assert(std::format("{:#a}", 1.0) == "1.p+0");
+
+  // Sign, width, alignment and zero padding.
+  assert(std::format("{:+}", 1.5) == "+1.5");
+  assert(std::format("{: }", 1.5) == " 1.5");
+  assert(std::format("{:8}", -1.5) == "    -1.5");
+  assert(std::format("{:<8}", 1.5) == "1.5     ");
+  assert(std::format("{:*^9}", 1.5) == "***1.5***");
+  assert(std::format("{:08.2f}", -3.14159) == "-0003.14");
+  assert(std::format("{:+08}", 1.5) == "+00001.5");
+  assert(std::format("{:{}.{}f}", 3.14159, 7, 2) == "   3.14");
+
+  // Infinity and NaN are never zero padded.
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  assert(std::format("{}", inf) == "inf");
+  assert(std::format("{}", -inf) == "-inf");
+  assert(std::format("{:+}", inf) == "+inf");
+  assert(std::format("{:E}", inf) == "INF");
+  assert(std::format("{}", nan) == "nan");
+  assert(std::format("{:G}", nan) == "NAN");
+  assert(std::format("{:06}", inf) == "   inf");
+
+  // Results that don't fit in the internal buffer.
+  {
+    std::string s = std::format("{:.300f}", 1.0);
+    assert(s.size() == 302);
+    assert(s.substr(0, 4) == "1.00");
+    assert(std::format("{:f}", 1e300).size() == 308);
+  }
+
+  return 0;
+}
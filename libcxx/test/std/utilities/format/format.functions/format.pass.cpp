@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// This test requires the dylib support introduced in D92214.
+// XFAIL: with_system_cxx_lib=macosx10.15
+// XFAIL: with_system_cxx_lib=macosx10.14
+// XFAIL: with_system_cxx_lib=macosx10.13
+// XFAIL: with_system_cxx_lib=macosx10.12
+// XFAIL: with_system_cxx_lib=macosx10.11
+// XFAIL: with_system_cxx_lib=macosx10.10
+// XFAIL: with_system_cxx_lib=macosx10.9
+
+// <format>
+
+// template<class... Args>
+//   string format(format-string<Args...> fmt, const Args&... args);
+// template<class... Args>
+//   wstring format(wformat-string<Args...> fmt, const Args&... args);
+
+#include <format>
+#include <cassert>
+#include <string>
+#include <string_view>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  // Replacement fields and escaped braces.
+  assert(std::format("") == "");
+  assert(std::format("text") == "text");
+  assert(std::format("{{}}") == "{}");
+  assert(std::format("{}", 42) == "42");
+  assert(std::format("{} {}", "a", 'b') == "a b");
+  assert(std::format("{1} {0} {1}", 1, 2) == "2 1 2");
+
+  // Fill and alignment; numbers are right aligned and text is left aligned
+  // by default.
+  assert(std::format("{:5}", 42) == "   42");
+  assert(std::format("{:5}", "ab") == "ab   ");
+  assert(std::format("{:5}", 'x') == "x    ");
+  assert(std::format("{:<5}", 42) == "42   ");
+  assert(std::format("{:*^7}", "abc") == "**abc**");
+  assert(std::format("{:*^6}", "abc") == "*abc**");
+  assert(std::format("{:->5}", 'x') == "----x");
+
+  // Dynamic width and precision.
+  assert(std::format("{:{}}", 7, 3) == "  7");
+  assert(std::format("{0:{1}}", 7, 3) == "  7");
+  assert(std::format("{:.{}}", "hello", 3) == "hel");
+
+  // Integers.
+  assert(std::format("{:+}", 5) == "+5");
+  assert(std::format("{: }", 5) == " 5");
+  assert(std::format("{:-}", -5) == "-5");
+  assert(std::format("{:b}", 5) == "101");
+  assert(std::format("{:#b}", 5) == "0b101");
+  assert(std::format("{:#B}", 5) == "0B101");
+  assert(std::format("{:o}", 8) == "10");
+  assert(std::format("{:#o}", 8) == "010");
+  assert(std::format("{:#o}", 0) == "0");
+  assert(std::format("{:x}", 255) == "ff");
+  assert(std::format("{:#x}", 255) == "0xff");
+  assert(std::format("{:#X}", 255) == "0XFF");
+  assert(std::format("{:08}", -42) == "-0000042");
+  assert(std::format("{:#010x}", 255) == "0x000000ff");
+  assert(std::format("{:<08}", 42) == "42      ");
+  assert(std::format("{:c}", 65) == "A");
+  assert(std::format("{}", -9223372036854775807LL - 1) ==
+         "-9223372036854775808");
+  assert(std::format("{}", 18446744073709551615ULL) == "18446744073709551615");
+
+  // Characters and bool.
+  assert(std::format("{:d}", 'A') == "65");
+  assert(std::format("{:#x}", 'A') == "0x41");
+  assert(std::format("{}", true) == "true");
+  assert(std::format("{:s}", false) == "false");
+  assert(std::format("{:d}", true) == "1");
+  assert(std::format("{:^7}", true) == " true  ");
+
+  // Strings.
+  assert(std::format("{}", std::string("str")) == "str");
+  assert(std::format("{}", std::string_view("view")) == "view");
+  assert(std::format("{:.2}", "hello") == "he");
+  assert(std::format("{:>6.2}", "hello") == "    he");
+  {
+    const char* cstr = "cstr";
+    assert(std::format("{:s}", cstr) == "cstr");
+  }
+
+  // Pointers.
+  assert(std::format("{}", nullptr) == "0x0");
+  assert(std::format("{:p}", static_cast<const void*>(nullptr)) == "0x0");
+  assert(std::format("{:>5}", nullptr) == "  0x0");
+
+  // Output longer than the internal buffer is flushed in pieces.
+  {
+    std::string long_string(1000, 'x');
+    assert(std::format("<{}>", long_string) == "<" + long_string + ">");
+    assert(std::format("{:y>1000}", 1) == std::string(999, 'y') + "1");
+  }
+
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  assert(std::format(L"{} {}", 42, L"wide") == L"42 wide");
+  assert(std::format(L"{:*^7}", L'c') == L"***c***");
+  assert(std::format(L"{:#x}", 255) == L"0xff");
+  assert(std::format(L"{}", 1.5) == L"1.5");
+#endif
+
+  return 0;
+}
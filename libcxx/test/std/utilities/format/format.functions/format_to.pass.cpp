@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// This test requires the dylib support introduced in D92214.
+// XFAIL: with_system_cxx_lib=macosx10.15
+// XFAIL: with_system_cxx_lib=macosx10.14
+// XFAIL: with_system_cxx_lib=macosx10.13
+// XFAIL: with_system_cxx_lib=macosx10.12
+// XFAIL: with_system_cxx_lib=macosx10.11
+// XFAIL: with_system_cxx_lib=macosx10.10
+// XFAIL: with_system_cxx_lib=macosx10.9
+
+// <format>
+
+// template<class Out, class... Args>
+//   Out format_to(Out out, format-string<Args...> fmt, const Args&... args);
+// template<class Out, class... Args>
+//   Out format_to(Out out, wformat-string<Args...> fmt, const Args&... args);
+
+#include <format>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  {
+    char buffer[16];
+    char* end = std::format_to(buffer, "{}-{}", 1, "two");
+    assert(std::string(buffer, end) == "1-two");
+  }
+  {
+    std::string out;
+    std::format_to(std::back_inserter(out), "{:>4}", 42);
+    std::format_to(std::back_inserter(out), "{}", '!');
+    assert(out == "  42!");
+  }
+  {
+    std::list<char> out;
+    std::format_to(std::back_inserter(out), "{:x}", 255);
+    assert(std::string(out.begin(), out.end()) == "ff");
+  }
+  {
+    // More output than the internal buffer holds.
+    std::vector<char> out;
+    std::format_to(std::back_inserter(out), "{:a>600}", 'b');
+    assert(out.size() == 600);
+    assert(std::count(out.begin(), out.end(), 'a') == 599);
+    assert(out.back() == 'b');
+  }
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  {
+    std::wstring out;
+    std::format_to(std::back_inserter(out), L"{} {}", 1.5, L"x");
+    assert(out == L"1.5 x");
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// This test requires the dylib support introduced in D92214.
+// XFAIL: with_system_cxx_lib=macosx10.15
+// XFAIL: with_system_cxx_lib=macosx10.14
+// XFAIL: with_system_cxx_lib=macosx10.13
+// XFAIL: with_system_cxx_lib=macosx10.12
+// XFAIL: with_system_cxx_lib=macosx10.11
+// XFAIL: with_system_cxx_lib=macosx10.10
+// XFAIL: with_system_cxx_lib=macosx10.9
+
+// <format>
+
+// template<class Out, class... Args>
+//   format_to_n_result<Out> format_to_n(Out out, iter_difference_t<Out> n,
+//                                       format-string<Args...> fmt, const Args&... args);
+
+#include <format>
+#include <cassert>
+#include <string>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  {
+    char buffer[8] = {};
+    std::format_to_n_result<char*> result =
+        std::format_to_n(buffer, 3, "{}", 123456);
+    assert(result.out == buffer + 3);
+    assert(result.size == 6);
+    assert(std::string(buffer) == "123");
+  }
+  {
+    char buffer[8] = {};
+    auto result = std::format_to_n(buffer, 7, "{}", 12);
+    assert(result.out == buffer + 2);
+    assert(result.size == 2);
+    assert(std::string(buffer) == "12");
+  }
+  {
+    char buffer[1] = {'z'};
+    auto result = std::format_to_n(buffer, 0, "{}", "abc");
+    assert(result.out == buffer);
+    assert(result.size == 3);
+    assert(buffer[0] == 'z');
+  }
+  {
+    // A negative size writes nothing.
+    char buffer[1] = {'z'};
+    auto result = std::format_to_n(buffer, -1, "{}", "abc");
+    assert(result.out == buffer);
+    assert(result.size == 3);
+    assert(buffer[0] == 'z');
+  }
+  {
+    // The size counts past the internal buffer.
+    std::string out(10, ' ');
+    auto result = std::format_to_n(out.begin(), 10, "{:x>1000}", 1);
+    assert(result.out == out.end());
+    assert(result.size == 1000);
+    assert(out == std::string(10, 'x'));
+  }
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  {
+    wchar_t buffer[8] = {};
+    auto result = std::format_to_n(buffer, 2, L"{}", L"wide");
+    assert(result.out == buffer + 2);
+    assert(result.size == 4);
+    assert(std::wstring(buffer) == L"wi");
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// This test requires the dylib support introduced in D92214.
+// XFAIL: with_system_cxx_lib=macosx10.15
+// XFAIL: with_system_cxx_lib=macosx10.14
+// XFAIL: with_system_cxx_lib=macosx10.13
+// XFAIL: with_system_cxx_lib=macosx10.12
+// XFAIL: with_system_cxx_lib=macosx10.11
+// XFAIL: with_system_cxx_lib=macosx10.10
+// XFAIL: with_system_cxx_lib=macosx10.9
+
+// <format>
+
+// string vformat(string_view fmt, format_args args);
+// wstring vformat(wstring_view fmt, wformat_args args);
+// template<class Out>
+//   Out vformat_to(Out out, string_view fmt, format_args args);
+
+#include <format>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "test_macros.h"
+
+#ifndef TEST_HAS_NO_EXCEPTIONS
+// Format strings are only checked at run time by the v functions.
+static void test_exception(std::string_view fmt, int value) {
+  try {
+    (void)std::vformat(fmt, std::make_format_args(value));
+    assert(false);
+  } catch (const std::format_error&) {
+  }
+}
+#endif
+
+int main(int, char**) {
+  {
+    int i = 42;
+    const char* s = "str";
+    assert(std::vformat("{} {}", std::make_format_args(i, s)) == "42 str");
+  }
+  {
+    std::string out;
+    double d = 1.5;
+    std::vformat_to(std::back_inserter(out), "{:+}", std::make_format_args(d));
+    assert(out == "+1.5");
+  }
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+  {
+    int i = 7;
+    assert(std::vformat(L"{:03}", std::make_wformat_args(i)) == L"007");
+  }
+#endif
+
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  test_exception("{", 0);
+  test_exception("}", 0);
+  test_exception("{1}", 0);
+  test_exception("{} {}", 0);
+  test_exception("{0} {}", 0);
+  test_exception("{:s}", 0);
+  test_exception("{:.2}", 0);
+  test_exception("{:L}", 0);
+  test_exception("{:{}}", 0);
+#endif
+
+  return 0;
+}
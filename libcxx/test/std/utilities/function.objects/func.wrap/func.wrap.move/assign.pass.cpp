@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// move_only_function& operator=(move_only_function&& f);
+// move_only_function& operator=(nullptr_t) noexcept;
+// template<class F> move_only_function& operator=(F&& f);
+// void swap(move_only_function& other) noexcept;
+// friend void swap(move_only_function& f1, move_only_function& f2) noexcept;
+
+#include <functional>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include "test_macros.h"
+
+// Counts the live instances, so that the tests can check that targets are
+// destroyed.
+struct Counted {
+  static int live;
+  int value;
+  explicit Counted(int v) : value(v) { ++live; }
+  Counted(Counted&& other) noexcept : value(other.value) { ++live; }
+  ~Counted() { --live; }
+  int operator()() const { return value; }
+};
+int Counted::live = 0;
+
+// Too large for any small buffer.
+struct LargeCounted : Counted {
+  char padding[256];
+  explicit LargeCounted(int v) : Counted(v) {}
+};
+
+template <class F>
+void test(int base) {
+  using MOF = std::move_only_function<int()>;
+  {
+    MOF f = F(base + 1);
+    assert(Counted::live == 1);
+    f = nullptr;
+    assert(!f);
+    assert(Counted::live == 0);
+  }
+  {
+    MOF f = F(base + 1);
+    MOF g = F(base + 2);
+    f = std::move(g);
+    assert(Counted::live == 1);
+    assert(f() == base + 2);
+
+    f = F(base + 3);
+    assert(Counted::live == 1);
+    assert(f() == base + 3);
+
+    f = [] { return -1; };
+    assert(Counted::live == 0);
+    assert(f() == -1);
+  }
+  assert(Counted::live == 0);
+  {
+    MOF f = F(base + 1);
+    MOF g = F(base + 2);
+    f.swap(g);
+    assert(f() == base + 2);
+    assert(g() == base + 1);
+    swap(f, g);
+    assert(f() == base + 1);
+    assert(g() == base + 2);
+    assert(Counted::live == 2);
+
+    MOF empty;
+    swap(f, empty);
+    assert(!f);
+    assert(empty() == base + 1);
+
+    f.swap(f);
+    assert(!f);
+    empty.swap(empty);
+    assert(empty() == base + 1);
+  }
+  assert(Counted::live == 0);
+}
+
+int main(int, char**) {
+  static_assert(std::is_nothrow_assignable_v<std::move_only_function<void()>&, std::nullptr_t>);
+  static_assert(std::is_nothrow_swappable_v<std::move_only_function<void()>>);
+  static_assert(!std::is_copy_assignable_v<std::move_only_function<void()>>);
+
+  test<Counted>(0);
+  test<LargeCounted>(100);
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// R operator()(ArgTypes...) cv ref noexcept(noex);
+
+#include <functional>
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "test_macros.h"
+
+// Reports the qualifiers it is invoked with.
+enum Quals { Lvalue, ConstLvalue, Rvalue, ConstRvalue };
+struct QualsCallable {
+  Quals operator()() & { return Lvalue; }
+  Quals operator()() const& { return ConstLvalue; }
+  Quals operator()() && { return Rvalue; }
+  Quals operator()() const&& { return ConstRvalue; }
+};
+
+struct NonConstOnly {
+  int operator()() { return 1; }
+};
+
+struct NothrowCallable {
+  int operator()() noexcept { return 1; }
+};
+
+int main(int, char**) {
+  {
+    std::move_only_function<Quals()> f = QualsCallable();
+    assert(f() == Lvalue);
+    std::move_only_function<Quals() &> g = QualsCallable();
+    assert(g() == Lvalue);
+    std::move_only_function<Quals() &&> h = QualsCallable();
+    assert(std::move(h)() == Rvalue);
+    std::move_only_function<Quals() const> cf = QualsCallable();
+    assert(cf() == ConstLvalue);
+    std::move_only_function<Quals() const&> cg = QualsCallable();
+    assert(cg() == ConstLvalue);
+    std::move_only_function<Quals() const&&> ch = QualsCallable();
+    assert(std::move(ch)() == ConstRvalue);
+  }
+  {
+    std::move_only_function<Quals() noexcept> f;
+    static_assert(noexcept(f()));
+    static_assert(!noexcept(std::declval<std::move_only_function<int()>&>()()));
+  }
+
+  // The signature restricts how the object can be called.
+  static_assert(std::is_invocable_v<std::move_only_function<void()>&>);
+  static_assert(!std::is_invocable_v<const std::move_only_function<void()>&>);
+  static_assert(std::is_invocable_v<const std::move_only_function<void() const>&>);
+  static_assert(!std::is_invocable_v<std::move_only_function<void() &>>);
+  static_assert(std::is_invocable_v<std::move_only_function<void() &&>>);
+  static_assert(!std::is_invocable_v<std::move_only_function<void() &&>&>);
+
+  // ...and which callables it accepts.
+  static_assert(std::is_constructible_v<std::move_only_function<int()>, NonConstOnly>);
+  static_assert(!std::is_constructible_v<std::move_only_function<int() const>, NonConstOnly>);
+  static_assert(!std::is_constructible_v<std::move_only_function<int() noexcept>, NonConstOnly>);
+  static_assert(std::is_constructible_v<std::move_only_function<int() noexcept>, NothrowCallable>);
+  static_assert(!std::is_constructible_v<std::move_only_function<int() const noexcept>, NothrowCallable>);
+  {
+    std::move_only_function<int() noexcept> f = NothrowCallable();
+    assert(f() == 1);
+  }
+
+  // Arguments are forwarded and the result converted.
+  {
+    std::move_only_function<int(std::unique_ptr<int>)> f =
+        [](std::unique_ptr<int> p) { return *p; };
+    assert(f(std::make_unique<int>(3)) == 3);
+
+    std::move_only_function<void(int&)> g = [](int& x) { return ++x; };
+    int i = 0;
+    g(i);
+    assert(i == 1);
+
+    std::move_only_function<long(short)> h = [](int x) { return x * 2; };
+    static_assert(std::is_same_v<decltype(h(1)), long>);
+    assert(h(21) == 42);
+
+    std::move_only_function<int&(int&)> r = [](int& x) -> int& { return x; };
+    assert(&r(i) == &i);
+  }
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+// <functional>
+
+// move_only_function() noexcept;
+// move_only_function(nullptr_t) noexcept;
+// move_only_function(move_only_function&&) noexcept;
+// template<class F> move_only_function(F&&);
+// template<class T, class... Args>
+//   explicit move_only_function(in_place_type_t<T>, Args&&...);
+// template<class T, class U, class... Args>
+//   explicit move_only_function(in_place_type_t<T>, initializer_list<U>, Args&&...);
+
+#include <functional>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "test_macros.h"
+
+static int twice(int x) { return 2 * x; }
+
+struct S {
+  int value;
+  int get() const { return value; }
+};
+
+struct Sum {
+  int total;
+  Sum(std::initializer_list<int> il, int extra) : total(extra) {
+    for (int x : il)
+      total += x;
+  }
+  int operator()() const { return total; }
+};
+
+int main(int, char**) {
+  static_assert(std::is_nothrow_default_constructible_v<std::move_only_function<void()>>);
+  static_assert(std::is_nothrow_constructible_v<std::move_only_function<void()>, std::nullptr_t>);
+  static_assert(std::is_nothrow_move_constructible_v<std::move_only_function<void()>>);
+  static_assert(!std::is_copy_constructible_v<std::move_only_function<void()>>);
+  static_assert(std::is_same_v<std::move_only_function<long(int)>::result_type, long>);
+
+  {
+    std::move_only_function<void()> f;
+    assert(!f);
+    assert(f == nullptr);
+    std::move_only_function<void()> g(nullptr);
+    assert(!g);
+  }
+  {
+    std::move_only_function<int(int)> f = [](int x) { return x + 1; };
+    assert(f);
+    assert(f != nullptr);
+    assert(f(1) == 2);
+  }
+  {
+    // A callable that can only be moved.
+    auto p = std::make_unique<int>(42);
+    std::move_only_function<int()> f = [p = std::move(p)] { return *p; };
+    assert(f() == 42);
+  }
+  {
+    std::move_only_function<int(int)> f = twice;
+    assert(f(3) == 6);
+    std::move_only_function<int(int)> g = &twice;
+    assert(g(4) == 8);
+
+    int (*null_fp)(int) = nullptr;
+    std::move_only_function<int(int)> h = null_fp;
+    assert(!h);
+  }
+  {
+    std::move_only_function<int(const S&)> f = &S::get;
+    assert(f(S{7}) == 7);
+    std::move_only_function<int(S&)> g = &S::value;
+    S s{8};
+    assert(g(s) == 8);
+
+    int (S::*null_mp)() const = nullptr;
+    std::move_only_function<int(const S&)> h = null_mp;
+    assert(!h);
+  }
+  {
+    // A move_only_function without a target gives one without a target.
+    std::move_only_function<int()> empty;
+    std::move_only_function<long()> f = std::move(empty);
+    assert(!f);
+
+    std::move_only_function<int()> full = [] { return 5; };
+    std::move_only_function<long()> g = std::move(full);
+    assert(g);
+    assert(g() == 5);
+  }
+  {
+    std::move_only_function<int()> f = [] { return 9; };
+    std::move_only_function<int()> g = std::move(f);
+    assert(g);
+    assert(g() == 9);
+  }
+  {
+    struct AddN {
+      int n;
+      int operator()(int x) const { return x + n; }
+    };
+    std::move_only_function<int(int)> f(std::in_place_type<AddN>, 10);
+    assert(f(1) == 11);
+
+    std::move_only_function<int()> g(std::in_place_type<Sum>, {1, 2, 3}, 4);
+    assert(g() == 10);
+  }
+
+  // Callables that aren't invocable with the signature are rejected.
+  static_assert(!std::is_constructible_v<std::move_only_function<void(int)>, void (*)()>);
+  static_assert(!std::is_constructible_v<std::move_only_function<int*()>, int (*)()>);
+  static_assert(std::is_constructible_v<std::move_only_function<void()>, int (*)()>);
+
+  return 0;
+}
@@ -45,6 +45,9 @@ SingleStringMatcher::SingleStringMatcher(StringRef Pattern) {
     ExactMatch = false;
     GlobPatternMatcher = *Glob;
   }
+  LiteralPrefix = ExactMatch
+                      ? ExactPattern
+                      : Pattern.substr(0, Pattern.find_first_of("?*[\\"));
 }
 
 bool SingleStringMatcher::match(StringRef s) const {
@@ -58,6 +61,15 @@ bool StringMatcher::match(StringRef s) const {
   return false;
 }
 
+bool StringMatcher::getLiteralPrefixes(std::vector<StringRef> &prefixes) const {
+  for (const SingleStringMatcher &pat : patterns) {
+    if (pat.getLiteralPrefix().empty())
+      return false;
+    prefixes.push_back(pat.getLiteralPrefix());
+  }
+  return true;
+}
+
 // Converts a hex string (e.g. "deadbeef") to a vector.
 std::vector<uint8_t> lld::parseHex(StringRef s) {
   std::vector<uint8_t> hex;
@@ -9,6 +9,7 @@
 #include "lld/Common/Timer.h"
 #include "lld/Common/ErrorHandler.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/TimeProfiler.h"
 
 using namespace lld;
 using namespace llvm;
@@ -26,6 +27,39 @@ void ScopedTimer::stop() {
 
 ScopedTimer::~ScopedTimer() { stop(); }
 
+void lld::addParallelTimeTrace(StringRef name,
+                               ArrayRef<ParallelShard> shards) {
+  using namespace std::chrono;
+
+  struct ThreadStats {
+    steady_clock::time_point start = steady_clock::time_point::max();
+    steady_clock::time_point end = steady_clock::time_point::min();
+    steady_clock::duration busy{0};
+    size_t items = 0;
+    uint64_t bytes = 0;
+  };
+
+  // Use a std::map so that threads are reported in a stable order.
+  std::map<uint64_t, ThreadStats> threads;
+  for (const ParallelShard &shard : shards) {
+    ThreadStats &t = threads[shard.tid];
+    t.start = std::min(t.start, shard.start);
+    t.end = std::max(t.end, shard.end);
+    t.busy += shard.end - shard.start;
+    t.items += shard.items;
+    t.bytes += shard.bytes;
+  }
+
+  for (const auto &it : threads) {
+    const ThreadStats &t = it.second;
+    std::string detail =
+        "items: " + std::to_string(t.items) +
+        ", bytes: " + std::to_string(t.bytes) + ", busy us: " +
+        std::to_string(duration_cast<microseconds>(t.busy).count());
+    timeTraceProfilerAddThreadSection(name, detail, it.first, t.start, t.end);
+  }
+}
+
 Timer::Timer(llvm::StringRef name) : name(std::string(name)) {}
 Timer::Timer(llvm::StringRef name, Timer &parent) : name(std::string(name)) {
   parent.children.push_back(this);
@@ -103,6 +103,7 @@ struct Configuration {
   llvm::StringRef emulation;
   llvm::StringRef fini;
   llvm::StringRef init;
+  llvm::StringRef layoutState;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
   llvm::StringRef ltoNewPmPasses;
@@ -121,6 +122,7 @@ struct Configuration {
   llvm::StringRef sysroot;
   llvm::StringRef thinLTOCacheDir;
   llvm::StringRef thinLTOIndexOnlyArg;
+  llvm::StringRef thinLTOSharedCacheDir;
   llvm::StringRef ltoBasicBlockSections;
   std::pair<llvm::StringRef, llvm::StringRef> thinLTOObjectSuffixReplace;
   std::pair<llvm::StringRef, llvm::StringRef> thinLTOPrefixReplace;
@@ -181,6 +183,7 @@ struct Configuration {
   bool mergeArmExidx;
   bool mipsN32Abi = false;
   bool mmapOutputFile;
+  bool releaseOutputPages;
   bool nmagic;
   bool noDynamicLinker = false;
   bool noinhibitExec;
@@ -209,6 +212,7 @@ struct Configuration {
   bool thinLTOEmitImportsFiles;
   bool thinLTOIndexOnly;
   bool timeTraceEnabled;
+  bool timeTraceMemory;
   bool tocOptimize;
   bool pcRelOptimize;
   bool undefinedVersion;
@@ -268,6 +272,7 @@ struct Configuration {
   unsigned ltoo;
   unsigned optimize;
   StringRef thinLTOJobs;
+  uint64_t thinLTOMemoryBudget;
   unsigned timeTraceGranularity;
   int32_t splitStackAdjustSize;
 
@@ -532,7 +532,8 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
   // Initialize time trace profiler.
   if (config->timeTraceEnabled)
-    timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName);
+    timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName,
+                                config->timeTraceMemory);
 
   {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
@@ -1028,12 +1029,15 @@ static void readConfigs(opt::InputArgList &args) {
   config->ltoUniqueBasicBlockSectionNames =
       args.hasFlag(OPT_lto_unique_basic_block_section_names,
                    OPT_no_lto_unique_basic_block_section_names, false);
+  config->layoutState = args.getLastArgValue(OPT_layout_state);
   config->mapFile = args.getLastArgValue(OPT_Map);
   config->mipsGotSize = args::getInteger(args, OPT_mips_got_size, 0xfff0);
   config->mergeArmExidx =
       args.hasFlag(OPT_merge_exidx_entries, OPT_no_merge_exidx_entries, true);
   config->mmapOutputFile =
       args.hasFlag(OPT_mmap_output_file, OPT_no_mmap_output_file, true);
+  config->releaseOutputPages = args.hasFlag(
+      OPT_release_output_pages, OPT_no_release_output_pages, false);
   config->nmagic = args.hasFlag(OPT_nmagic, OPT_no_nmagic, false);
   config->noinhibitExec = args.hasArg(OPT_noinhibit_exec);
   config->nostdlib = args.hasArg(OPT_nostdlib);
@@ -1084,6 +1088,10 @@ static void readConfigs(opt::InputArgList &args) {
       parseCachePruningPolicy(args.getLastArgValue(OPT_thinlto_cache_policy)),
       "--thinlto-cache-policy: invalid cache policy");
   config->thinLTOEmitImportsFiles = args.hasArg(OPT_thinlto_emit_imports_files);
+  config->thinLTOSharedCacheDir =
+      args.getLastArgValue(OPT_thinlto_shared_cache_dir);
+  if (!config->thinLTOSharedCacheDir.empty() && config->thinLTOCacheDir.empty())
+    error("--thinlto-shared-cache-dir= requires --thinlto-cache-dir=");
   config->thinLTOIndexOnly = args.hasArg(OPT_thinlto_index_only) ||
                              args.hasArg(OPT_thinlto_index_only_eq);
   config->thinLTOIndexOnlyArg = args.getLastArgValue(OPT_thinlto_index_only_eq);
@@ -1096,6 +1104,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->timeTraceEnabled = args.hasArg(OPT_time_trace);
   config->timeTraceGranularity =
       args::getInteger(args, OPT_time_trace_granularity, 500);
+  config->timeTraceMemory = args.hasArg(OPT_time_trace_memory);
   config->trace = args.hasArg(OPT_trace);
   config->undefined = args::getStrings(args, OPT_undefined);
   config->undefinedVersion =
@@ -1228,6 +1237,13 @@ static void readConfigs(opt::InputArgList &args) {
     error("--lto-partitions: number of threads must be > 0");
   if (!get_threadpool_strategy(config->thinLTOJobs))
     error("--thinlto-jobs: invalid job count: " + config->thinLTOJobs);
+  if (auto *arg = args.getLastArg(OPT_thinlto_memory_budget)) {
+    uint64_t megabytes = 0;
+    if (!llvm::to_integer(arg->getValue(), megabytes, 0) || megabytes == 0)
+      error(arg->getSpelling() + ": expected a positive integer, but got '" +
+            arg->getValue() + "'");
+    config->thinLTOMemoryBudget = megabytes << 20;
+  }
 
   if (config->splitStackAdjustSize < 0)
     error("--split-stack-adjust-size: size must be >= 0");
@@ -2124,6 +2140,14 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // appended to the Files vector.
   {
     llvm::TimeTraceScope timeScope("Parse input files");
+    // Symbol resolution below is inherently serial because its result depends
+    // on the order of files, but hashing the symbol names of the object files
+    // we already know about is not.
+    parallelForEach(files, [](InputFile *file) {
+      if (file->kind() == InputFile::ObjKind &&
+          cast<ELFFileBase>(file)->ekind == config->ekind)
+        cast<ObjFile<ELFT>>(file)->hashGlobalSymbolNames();
+    });
     for (size_t i = 0; i < files.size(); ++i) {
       llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
       parseFile(files[i]);
@@ -81,6 +81,7 @@
 #include "Symbols.h"
 #include "SyntheticSections.h"
 #include "Writer.h"
+#include "lld/Common/Timer.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Object/ELF.h"
@@ -89,6 +90,7 @@
 #include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <atomic>
+#include <tuple>
 
 using namespace llvm;
 using namespace llvm::ELF;
@@ -122,6 +124,10 @@ private:
 
   void forEachClass(llvm::function_ref<void(size_t, size_t)> fn);
 
+  void dropSingletons(
+      uint32_t &uniqueId,
+      llvm::function_ref<bool(const InputSection *, const InputSection *)> eq);
+
   std::vector<InputSection *> sections;
 
   // We repeat the main loop while `Repeat` is true.
@@ -433,6 +439,28 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Sections is partitioned into runs of sections that are equal in terms of
+// Eq. Remove the sections that form a run of their own and give them unique
+// IDs, i.e. each of them belongs to an equivalence class of its own.
+template <class ELFT>
+void ICF<ELFT>::dropSingletons(
+    uint32_t &uniqueId,
+    llvm::function_ref<bool(const InputSection *, const InputSection *)> eq) {
+  size_t out = 0;
+  for (size_t i = 0, e = sections.size(); i != e;) {
+    size_t j = i + 1;
+    while (j != e && eq(sections[i], sections[j]))
+      ++j;
+    if (j - i == 1)
+      sections[i]->eqClass[0] = sections[i]->eqClass[1] = ++uniqueId;
+    else
+      for (size_t k = i; k != j; ++k)
+        sections[out++] = sections[k];
+    i = j;
+  }
+  sections.resize(out);
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class ELFT, class RelTy>
@@ -488,12 +516,33 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   }
 
-  // Initially, we use hash values to partition sections.
-  parallelForEach(sections, [&](InputSection *s) {
-    // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxHash64(s->data()) | (1U << 31);
+  // Two sections can only be folded if they have the same size, flags and
+  // number of relocations. Group sections by that key first; a section that
+  // is alone in its group cannot be folded, so assign it a unique ID instead
+  // of hashing its contents and carrying it through the rest of the rounds.
+  // The sort is stable so that the section picked as the representative of
+  // an equivalence class is still the first one in input order.
+  auto bucketKey = [](const InputSection *s) {
+    return std::make_tuple(s->getSize(), s->flags, s->numRelocations);
+  };
+  llvm::stable_sort(sections,
+                    [&](const InputSection *a, const InputSection *b) {
+                      return bucketKey(a) < bucketKey(b);
+                    });
+  dropSingletons(uniqueId, [&](const InputSection *a, const InputSection *b) {
+    return bucketKey(a) == bucketKey(b);
   });
 
+  // Initially, we use hash values to partition sections.
+  tracedParallelForEachN(
+      "ICF: hash sections", 0, sections.size(),
+      [&](size_t i) {
+        // Set MSB to 1 to avoid collisions with unique IDs.
+        InputSection *s = sections[i];
+        s->eqClass[0] = xxHash64(s->data()) | (1U << 31);
+      },
+      [&](size_t i) { return sections[i]->data().size(); });
+
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
   // reduce the average sizes of equivalence classes, i.e. segregate() which has
   // a large time complexity will have less work to do.
@@ -512,6 +561,12 @@ template <class ELFT> void ICF<ELFT>::run() {
     return a->eqClass[0] < b->eqClass[0];
   });
 
+  // Sections whose hash is unique cannot be identical to any other section.
+  // Take them out before the quadratic segregate() rounds.
+  dropSingletons(uniqueId, [](const InputSection *a, const InputSection *b) {
+    return a->eqClass[0] == b->eqClass[0];
+  });
+
   // Compare static contents and assign unique equivalence class IDs for each
   // static content. Use a base offset for these IDs to ensure no overlap with
   // the unique IDs already assigned.
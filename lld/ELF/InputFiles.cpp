@@ -122,6 +122,11 @@ Optional<MemoryBufferRef> elf::readFile(StringRef path) {
   }
 
   std::unique_ptr<MemoryBuffer> &mb = *mbOrErr;
+  // Input files are parsed long after they are read, start reading them from
+  // disk in the background. Only some members of an archive are usually
+  // needed, so leave these alone.
+  if (identify_magic(mb->getBuffer()) != file_magic::archive)
+    mb->willNeedIfMmap(0, mb->getBufferSize());
   MemoryBufferRef mbref = mb->getMemBufferRef();
   make<std::unique_ptr<MemoryBuffer>>(std::move(mb)); // take MB ownership
 
@@ -1077,6 +1082,28 @@ StringRef ObjFile<ELFT>::getSectionName(const Elf_Shdr &sec) {
   return CHECK(getObj().getSectionName(sec, sectionStringTable), this);
 }
 
+template <class ELFT> void ObjFile<ELFT>::hashGlobalSymbolNames() {
+  // Files given with --just-symbols are parsed differently.
+  if (this->justSymbols)
+    return;
+
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  if (eSyms.size() <= firstGlobal)
+    return;
+
+  globalNames.reserve(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    // STB_LOCAL symbols at or after sh_info are diagnosed and handled in
+    // initializeSymbols().
+    if (eSyms[i].getBinding() == STB_LOCAL) {
+      globalNames.emplace_back(StringRef(), 0);
+      continue;
+    }
+    StringRef name = CHECK(eSyms[i].getName(this->stringTable), this);
+    globalNames.emplace_back(SymbolTable::stripDefaultVersion(name));
+  }
+}
+
 // Initialize this->Symbols. this->Symbols is a parallel array as
 // its corresponding ELF symbol table.
 template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
@@ -1097,8 +1124,11 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
         error(toString(this) + ": non-local symbol (" + Twine(i) +
               ") found at index < .symtab's sh_info (" + Twine(firstGlobal) +
               ")");
-      this->symbols[i] =
-          symtab->insert(CHECK(eSyms[i].getName(this->stringTable), this));
+      if (i >= firstGlobal && !globalNames.empty())
+        this->symbols[i] = symtab->insert(globalNames[i - firstGlobal]);
+      else
+        this->symbols[i] =
+            symtab->insert(CHECK(eSyms[i].getName(this->stringTable), this));
       continue;
     }
 
@@ -1130,6 +1160,8 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
                                        type, eSym.st_value, eSym.st_size, sec);
   }
 
+  globalNames = std::vector<CachedHashStringRef>();
+
   // Symbol resolution of non-local symbols.
   SmallVector<unsigned, 32> unds;
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
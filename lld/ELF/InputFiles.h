@@ -207,6 +207,11 @@ public:
 
   void parse(bool ignoreComdats = false);
 
+  // Computes the hashes of the names of global symbols so that parse() does
+  // not have to. Unlike parse(), this does not touch the symbol table, so it
+  // can be called for many files in parallel.
+  void hashGlobalSymbolNames();
+
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
 
@@ -283,6 +288,11 @@ private:
   // .shstrtab contents.
   StringRef sectionStringTable;
 
+  // Names of global symbols with precomputed hashes, indexed by symbol index
+  // minus firstGlobal. Filled by hashGlobalSymbolNames() and released once the
+  // symbols have been added to the symbol table.
+  std::vector<llvm::CachedHashStringRef> globalNames;
+
   // Debugging information to retrieve source file and line for error
   // reporting. Linker may find reasonable number of errors in a
   // single object file, so we cache debugging information in order to
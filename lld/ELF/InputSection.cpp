@@ -1361,6 +1361,13 @@ void MergeInputSection::splitStrings(ArrayRef<uint8_t> data, size_t entSize) {
   bool isAlloc = flags & SHF_ALLOC;
   StringRef s = toStringRef(data);
 
+  // Sections such as .debug_str can contain millions of strings. Count them
+  // first so that the piece vector is allocated once with the exact size
+  // instead of being grown (and over-allocated by up to 2x) one string at a
+  // time. Counting NUL bytes is cheap compared to hashing the strings.
+  if (entSize == 1)
+    pieces.reserve(s.count('\0'));
+
   while (!s.empty()) {
     size_t end = findNull(s, entSize);
     if (end == StringRef::npos)
@@ -1381,6 +1388,7 @@ void MergeInputSection::splitNonStrings(ArrayRef<uint8_t> data,
   assert((size % entSize) == 0);
   bool isAlloc = flags & SHF_ALLOC;
 
+  pieces.reserve(size / entSize);
   for (size_t i = 0; i != size; i += entSize)
     pieces.emplace_back(i, xxHash64(data.slice(i, entSize)), !isAlloc);
 }
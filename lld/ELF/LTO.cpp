@@ -158,8 +158,10 @@ static lto::Config createConfig() {
   for (const llvm::StringRef &name : config->thinLTOModulesToCompile)
     c.ThinLTOModulesToCompile.emplace_back(name);
 
+  c.ThinLTOMemoryBudget = config->thinLTOMemoryBudget;
   c.TimeTraceEnabled = config->timeTraceEnabled;
   c.TimeTraceGranularity = config->timeTraceGranularity;
+  c.TimeTraceMemory = config->timeTraceMemory;
 
   c.CSIRProfile = std::string(config->ltoCSProfileFile);
   c.RunCSIRInstr = config->ltoCSProfileGenerate;
@@ -304,13 +306,23 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
   // The --thinlto-cache-dir option specifies the path to a directory in which
   // to cache native object files for ThinLTO incremental builds. If a path was
   // specified, configure LTO to use it as the cache directory.
+  //
+  // --thinlto-shared-cache-dir adds a second level of caching in a directory
+  // that is usually shared between machines. Objects found there are copied
+  // into the local cache, and newly built objects are published to it.
   lto::NativeObjectCache cache;
-  if (!config->thinLTOCacheDir.empty())
+  if (!config->thinLTOCacheDir.empty()) {
+    std::shared_ptr<lto::SharedObjectStore> shared;
+    if (!config->thinLTOSharedCacheDir.empty())
+      shared = check(lto::createDirectoryObjectStore(
+          config->thinLTOSharedCacheDir));
     cache = check(
         lto::localCache(config->thinLTOCacheDir,
                         [&](size_t task, std::unique_ptr<MemoryBuffer> mb) {
                           files[task] = std::move(mb);
-                        }));
+                        },
+                        std::move(shared)));
+  }
 
   if (!bitcodeFiles.empty())
     checkError(ltoObj->run(
@@ -421,6 +421,49 @@ static void sortInputSections(MutableArrayRef<InputSectionBase *> vec,
   sortSections(vec, outer);
 }
 
+// Finds the indexes of the sections in sections whose name starts with a
+// literal prefix of pat, in ascending order. Returns false if there is no
+// index for sections or if pat starts with a wildcard, or if the candidates
+// are not much fewer than the sections, in which case all sections should be
+// tested.
+bool LinkerScript::findCandidateSections(
+    const SectionPattern &pat, ArrayRef<InputSectionBase *> sections,
+    std::vector<size_t> &candidates) const {
+  if (sections.data() != indexedSections.data() ||
+      sections.size() != indexedSections.size())
+    return false;
+
+  std::vector<StringRef> prefixes;
+  if (!pat.sectionPat.getLiteralPrefixes(prefixes))
+    return false;
+
+  using Entry = std::pair<StringRef, size_t>;
+  SmallVector<ArrayRef<Entry>, 4> ranges;
+  size_t numCandidates = 0;
+  for (StringRef prefix : prefixes) {
+    auto begin = llvm::partition_point(
+        sectionNameIndex, [&](const Entry &e) { return e.first < prefix; });
+    auto end = std::partition_point(begin, sectionNameIndex.end(),
+                                    [&](const Entry &e) {
+                                      return e.first.startswith(prefix);
+                                    });
+    ranges.push_back(makeArrayRef(sectionNameIndex)
+                         .slice(begin - sectionNameIndex.begin(), end - begin));
+    numCandidates += end - begin;
+  }
+  if (numCandidates > sections.size() / 4)
+    return false;
+
+  candidates.clear();
+  for (ArrayRef<Entry> range : ranges)
+    for (const Entry &e : range)
+      candidates.push_back(e.second);
+  llvm::sort(candidates);
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  return true;
+}
+
 // Compute and remember which sections the InputSectionDescription matches.
 std::vector<InputSectionBase *>
 LinkerScript::computeInputSections(const InputSectionDescription *cmd,
@@ -439,15 +482,16 @@ LinkerScript::computeInputSections(const InputSectionDescription *cmd,
 
   // Collects all sections that satisfy constraints of Cmd.
   size_t sizeAfterPrevSort = 0;
+  std::vector<size_t> candidates;
   for (const SectionPattern &pat : cmd->sectionPatterns) {
     size_t sizeBeforeCurrPat = ret.size();
 
-    for (size_t i = 0, e = sections.size(); i != e; ++i) {
+    auto addIfMatches = [&](size_t i) {
       // Skip if the section is dead or has been matched by a previous input
       // section description or a previous pattern.
       InputSectionBase *sec = sections[i];
       if (!sec->isLive() || sec->parent || seen.contains(i))
-        continue;
+        return;
 
       // For -emit-relocs we have to ignore entries like
       //   .rela.dyn : { *(.rela.data) }
@@ -456,20 +500,30 @@ LinkerScript::computeInputSections(const InputSectionDescription *cmd,
       // want to support scripts that do custom layout for them.
       if (isa<InputSection>(sec) &&
           cast<InputSection>(sec)->getRelocatedSection())
-        continue;
+        return;
 
       // Check the name early to improve performance in the common case.
       if (!pat.sectionPat.match(sec->name))
-        continue;
+        return;
 
       if (!cmd->matchesFile(sec->file) || pat.excludesFile(sec->file) ||
           (sec->flags & cmd->withFlags) != cmd->withFlags ||
           (sec->flags & cmd->withoutFlags) != 0)
-        continue;
+        return;
 
       ret.push_back(sec);
       indexes.push_back(i);
       seen.insert(i);
+    };
+
+    // Candidates are in input order, so the result is the same as testing
+    // every input section.
+    if (findCandidateSections(pat, sections, candidates)) {
+      for (size_t i : candidates)
+        addIfMatches(i);
+    } else {
+      for (size_t i = 0, e = sections.size(); i != e; ++i)
+        addIfMatches(i);
     }
 
     if (pat.sortOuter == SortSectionPolicy::Default)
@@ -547,6 +601,18 @@ LinkerScript::createInputSectionList(OutputSection &outCmd) {
 
 // Create output sections described by SECTIONS commands.
 void LinkerScript::processSectionCommands() {
+  // Index the input sections by name. Sections with equal names stay in input
+  // order, which findCandidateSections() relies on.
+  indexedSections = inputSections;
+  sectionNameIndex.clear();
+  sectionNameIndex.reserve(inputSections.size());
+  for (size_t i = 0, e = inputSections.size(); i != e; ++i)
+    sectionNameIndex.push_back({inputSections[i]->name, i});
+  parallelSort(sectionNameIndex, [](const std::pair<StringRef, size_t> &a,
+                                    const std::pair<StringRef, size_t> &b) {
+    return a < b;
+  });
+
   size_t i = 0;
   for (BaseCommand *base : sectionCommands) {
     if (auto *sec = dyn_cast<OutputSection>(base)) {
@@ -593,6 +659,9 @@ void LinkerScript::processSectionCommands() {
       sec->sectionIndex = i++;
     }
   }
+
+  indexedSections = {};
+  sectionNameIndex = {};
 }
 
 void LinkerScript::processSymbolAssignments() {
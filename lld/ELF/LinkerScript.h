@@ -266,6 +266,16 @@ class LinkerScript final {
   computeInputSections(const InputSectionDescription *,
                        ArrayRef<InputSectionBase *>);
 
+  bool findCandidateSections(const SectionPattern &pat,
+                             ArrayRef<InputSectionBase *> sections,
+                             std::vector<size_t> &candidates) const;
+
+  // Input sections sorted by name, with their indexes in indexedSections.
+  // Used by processSectionCommands() so that section patterns with a literal
+  // prefix do not need to test every input section.
+  std::vector<std::pair<StringRef, size_t>> sectionNameIndex;
+  ArrayRef<InputSectionBase *> indexedSections;
+
   std::vector<InputSectionBase *> createInputSectionList(OutputSection &cmd);
 
   void discardSynthetic(OutputSection &);
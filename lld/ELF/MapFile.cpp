@@ -28,9 +28,12 @@
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace llvm;
 using namespace llvm::object;
@@ -279,3 +282,79 @@ void elf::writeArchiveStats() {
     os << f->getMemberCount() << '\t' << f->getFetchedMemberCount() << '\t'
        << f->getName() << '\n';
 }
+
+// Write a JSON description of the output layout for --layout-state=. For each
+// input file it records a hash of its contents, and for each output section
+// the location of every input section placed in it. A tool that wants to
+// relink only the inputs that changed can compare the hashes against the new
+// inputs and use the recorded placement to decide whether the changed sections
+// still fit where they are.
+//
+//   {"version": 1, "output": "a.out",
+//    "files": [{"path": "a.o", "hash": "..."}, ...],
+//    "sections": [{"name": ".text", "addr": 2101248, "offset": 4096,
+//                  "size": 42, "inputs": [{"file": 0, "name": ".text",
+//                  "offset": 0, "size": 21, "align": 16}, ...]}, ...]}
+void elf::writeLayoutState() {
+  if (config->layoutState.empty())
+    return;
+
+  llvm::TimeTraceScope timeScope("Write layout state");
+
+  std::error_code ec;
+  raw_fd_ostream os(config->layoutState, ec, sys::fs::OF_None);
+  if (ec) {
+    error("--layout-state=: cannot open " + config->layoutState + ": " +
+          ec.message());
+    return;
+  }
+
+  // Hashing the contents of all input files is not free, so do it in
+  // parallel.
+  std::vector<uint64_t> hashes(objectFiles.size());
+  parallelForEachN(0, objectFiles.size(), [&](size_t i) {
+    hashes[i] = xxHash64(objectFiles[i]->mb.getBuffer());
+  });
+  DenseMap<const InputFile *, size_t> fileIndex;
+  for (size_t i = 0, e = objectFiles.size(); i != e; ++i)
+    fileIndex[objectFiles[i]] = i;
+
+  json::OStream json(os);
+  json.object([&] {
+    json.attribute("version", 1);
+    json.attribute("output", config->outputFile);
+    json.attributeArray("files", [&] {
+      for (size_t i = 0, e = objectFiles.size(); i != e; ++i)
+        json.object([&] {
+          json.attribute("path", toString(objectFiles[i]));
+          json.attribute("hash", utohexstr(hashes[i]));
+        });
+    });
+    json.attributeArray("sections", [&] {
+      for (OutputSection *osec : outputSections) {
+        json.object([&] {
+          json.attribute("name", osec->name);
+          json.attribute("addr", int64_t(osec->addr));
+          json.attribute("offset", int64_t(osec->offset));
+          json.attribute("size", int64_t(osec->size));
+          json.attributeArray("inputs", [&] {
+            for (InputSection *isec : getInputSections(osec)) {
+              // Synthetic sections have no file and are always rebuilt.
+              auto it = fileIndex.find(isec->file);
+              if (it == fileIndex.end())
+                continue;
+              json.object([&] {
+                json.attribute("file", int64_t(it->second));
+                json.attribute("name", isec->name);
+                json.attribute("offset", int64_t(isec->outSecOff));
+                json.attribute("size", int64_t(isec->getSize()));
+                json.attribute("align", int64_t(isec->alignment));
+              });
+            }
+          });
+        });
+      }
+    });
+  });
+  os << '\n';
+}
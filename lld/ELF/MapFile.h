@@ -14,6 +14,7 @@ namespace elf {
 void writeMapFile();
 void writeCrossReferenceTable();
 void writeArchiveStats();
+void writeLayoutState();
 } // namespace elf
 } // namespace lld
 
@@ -14,7 +14,9 @@
 #include "Target.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
+#include "lld/Common/Timer.h"
 #include "llvm/BinaryFormat/Dwarf.h"
+#include "llvm/Config/config.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/MathExtras.h"
@@ -23,6 +25,9 @@
 #include "llvm/Support/TimeProfiler.h"
 #include <regex>
 #include <unordered_set>
+#if LLVM_ENABLE_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace llvm;
 using namespace llvm::dwarf;
@@ -277,8 +282,43 @@ static void fill(uint8_t *buf, size_t size,
   memcpy(buf + i, filler.data(), size - i);
 }
 
+#if LLVM_ENABLE_ZLIB
+// Deflates one shard of a section into a raw deflate stream (no zlib header
+// or trailer). All shards but the last end with a sync flush so that they
+// are byte aligned and can simply be concatenated.
+static SmallVector<uint8_t, 0> deflateShard(ArrayRef<uint8_t> in, int level,
+                                            int flush) {
+  // 15 and 8 are default. windowBits=-15 is negative to generate raw deflate
+  // data with no zlib header or trailer.
+  z_stream s = {};
+  deflateInit2(&s, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  s.next_in = const_cast<uint8_t *>(in.data());
+  s.avail_in = in.size();
+
+  // Allocate a buffer of half of the input size, and grow it by 1.5x if
+  // insufficient.
+  SmallVector<uint8_t, 0> out;
+  size_t pos = 0;
+  out.resize(std::max<size_t>(in.size() / 2, 64));
+  do {
+    if (pos == out.size())
+      out.resize(out.size() * 3 / 2);
+    s.next_out = out.data() + pos;
+    s.avail_out = out.size() - pos;
+    (void)deflate(&s, flush);
+    pos = s.next_out - out.data();
+  } while (s.avail_out == 0);
+  assert(s.avail_in == 0);
+
+  out.resize(pos);
+  deflateEnd(&s);
+  return out;
+}
+#endif
+
 // Compress section contents if this section contains debug info.
 template <class ELFT> void OutputSection::maybeCompress() {
+#if LLVM_ENABLE_ZLIB
   using Elf_Chdr = typename ELFT::Chdr;
 
   // Compress only DWARF debug sections.
@@ -295,20 +335,48 @@ template <class ELFT> void OutputSection::maybeCompress() {
   hdr->ch_size = size;
   hdr->ch_addralign = alignment;
 
-  // Write section contents to a temporary buffer and compress it.
+  // Write section contents to a temporary buffer.
   std::vector<uint8_t> buf(size);
   writeTo<ELFT>(buf.data());
+
   // We chose 1 as the default compression level because it is the fastest. If
   // -O2 is given, we use level 6 to compress debug info more by ~15%. We found
   // that level 7 to 9 doesn't make much difference (~1% more compression) while
   // they take significant amount of time (~2x), so level 6 seems enough.
-  if (Error e = zlib::compress(toStringRef(buf), compressedData,
-                               config->optimize >= 2 ? 6 : 1))
-    fatal("compress failed: " + llvm::toString(std::move(e)));
+  const int level = config->optimize >= 2 ? 6 : 1;
+
+  // Compress 1 MiB shards in parallel. Each shard is compressed on its own,
+  // which costs a little compression ratio but lets large debug sections use
+  // all threads. The Adler-32 checksums of the shards are combined afterwards.
+  constexpr size_t shardSize = 1 << 20;
+  const size_t numShards =
+      std::max<size_t>(1, divideCeil(buf.size(), shardSize));
+  auto shardIn = [&](size_t i) {
+    return makeArrayRef(buf).slice(
+        i * shardSize, std::min(shardSize, buf.size() - i * shardSize));
+  };
+  auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+  auto shardsAdler = std::make_unique<uint32_t[]>(numShards);
+  parallelForEachN(0, numShards, [&](size_t i) {
+    ArrayRef<uint8_t> in = shardIn(i);
+    shardsOut[i] = deflateShard(in, level,
+                                i != numShards - 1 ? Z_SYNC_FLUSH : Z_FINISH);
+    shardsAdler[i] = adler32(1, in.data(), in.size());
+  });
 
-  // Update section headers.
-  size = sizeof(Elf_Chdr) + compressedData.size();
+  // Update section headers and combine the Adler-32 checksums.
+  uint32_t checksum = 1;       // Initial Adler-32 value
+  size = sizeof(Elf_Chdr) + 2; // Elf_Chdr and zlib header
+  for (size_t i = 0; i != numShards; ++i) {
+    size += shardsOut[i].size();
+    checksum = adler32_combine(checksum, shardsAdler[i], shardIn(i).size());
+  }
+  size += 4; // Adler-32 checksum
+  compressed.shards = std::move(shardsOut);
+  compressed.numShards = numShards;
+  compressed.checksum = checksum;
   flags |= SHF_COMPRESSED;
+#endif
 }
 
 static void writeInt(uint8_t *buf, uint64_t data, uint64_t size) {
@@ -330,11 +398,25 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
 
   // If -compress-debug-section is specified and if this is a debug section,
   // we've already compressed section contents. If that's the case,
-  // just write it down.
-  if (!compressedData.empty()) {
+  // just write it down: the zlib header, the shards and the checksum.
+  if (compressed.shards) {
     memcpy(buf, zDebugHeader.data(), zDebugHeader.size());
-    memcpy(buf + zDebugHeader.size(), compressedData.data(),
-           compressedData.size());
+    buf += zDebugHeader.size();
+    buf[0] = 0x78; // CMF: deflate with a 32 KiB window
+    buf[1] = 0x01; // FLG: no dictionary, fastest level hint
+    buf += 2;
+
+    auto offsets = std::make_unique<size_t[]>(compressed.numShards);
+    for (size_t i = 1; i != compressed.numShards; ++i)
+      offsets[i] = offsets[i - 1] + compressed.shards[i - 1].size();
+    parallelForEachN(0, compressed.numShards, [&](size_t i) {
+      memcpy(buf + offsets[i], compressed.shards[i].data(),
+             compressed.shards[i].size());
+    });
+
+    write32be(buf + offsets[compressed.numShards - 1] +
+                  compressed.shards[compressed.numShards - 1].size(),
+              compressed.checksum);
     return;
   }
 
@@ -345,7 +427,7 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
   if (nonZeroFiller)
     fill(buf, sections.empty() ? size : sections[0]->outSecOff, filler);
 
-  parallelForEachN(0, sections.size(), [&](size_t i) {
+  auto writeSection = [&](size_t i) {
     InputSection *isec = sections[i];
     isec->writeTo<ELFT>(buf);
 
@@ -363,7 +445,10 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
       } else
         fill(start, end - start, filler);
     }
-  });
+  };
+  tracedParallelForEachN(
+      "Write input sections", 0, sections.size(), writeSection,
+      [&](size_t i) { return sections[i]->getSize(); });
 
   // Linker scripts may have BYTE()-family commands with which you
   // can write arbitrary bytes to the output. Process them if any.
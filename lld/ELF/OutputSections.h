@@ -109,9 +109,15 @@ public:
   void sortCtorsDtors();
 
 private:
-  // Used for implementation of --compress-debug-sections option.
+  // Used for implementation of --compress-debug-sections option. The section
+  // contents are deflated in independent shards, which are concatenated into
+  // a single zlib stream by writeTo.
   std::vector<uint8_t> zDebugHeader;
-  llvm::SmallVector<char, 0> compressedData;
+  struct {
+    std::unique_ptr<llvm::SmallVector<uint8_t, 0>[]> shards;
+    size_t numShards = 0;
+    uint32_t checksum = 0;
+  } compressed;
 
   std::array<uint8_t, 4> getFiller();
 };
@@ -55,6 +55,7 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 
@@ -1284,10 +1285,55 @@ static void processRelocAux(InputSectionBase &sec, RelExpr expr, RelType type,
               getLocation(sec, sym, offset));
 }
 
+namespace {
+// The part of scanning a relocation which does not depend on the order in
+// which relocations are visited: the RelExpr the target picks for it and its
+// addend. These only read the relocation record, the section contents and the
+// type of the referenced symbol, so they can be computed for many sections in
+// parallel. Everything else scanReloc does (creating GOT/PLT entries, copy
+// relocations and dynamic relocations) mutates shared state and is still done
+// serially in input order, which keeps the output identical to a serial scan.
+struct PrecomputedReloc {
+  RelExpr expr;
+  bool valid;
+  int64_t addend;
+};
+} // namespace
+
+template <class ELFT, class RelTy>
+static void precomputeRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels,
+                             MutableArrayRef<PrecomputedReloc> out) {
+  const uint8_t *data = sec.data().begin();
+  for (size_t i = 0, e = rels.size(); i != e; ++i) {
+    const RelTy &rel = rels[i];
+    Symbol &sym =
+        sec.getFile<ELFT>()->getSymbol(rel.getSymbol(config->isMips64EL));
+
+    // References to undefined symbols may be diagnosed by
+    // maybeReportUndefined(), after which the relocation is not looked at
+    // again. Leave them to scanReloc so that we don't report anything the
+    // serial path would not.
+    if (sym.isUndefined()) {
+      out[i].valid = false;
+      continue;
+    }
+
+    RelType type = rel.getType(config->isMips64EL);
+    RelExpr expr = target->getRelExpr(type, sym, data + rel.r_offset);
+    int64_t addend = 0;
+    if (expr != R_NONE)
+      addend = computeAddend<ELFT>(rel, rels.end(), sec, expr, sym.isLocal());
+    out[i] = {expr, true, addend};
+  }
+}
+
 template <class ELFT, class RelTy>
 static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
-                      RelTy *start, RelTy *end) {
+                      RelTy *start, RelTy *end,
+                      ArrayRef<PrecomputedReloc> precomputed) {
   const RelTy &rel = *i;
+  const PrecomputedReloc *pre =
+      precomputed.empty() ? nullptr : &precomputed[i - start];
   uint32_t symIndex = rel.getSymbol(config->isMips64EL);
   Symbol &sym = sec.getFile<ELFT>()->getSymbol(symIndex);
   RelType type;
@@ -1311,14 +1357,19 @@ static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
     return;
 
   const uint8_t *relocatedAddr = sec.data().begin() + rel.r_offset;
-  RelExpr expr = target->getRelExpr(type, sym, relocatedAddr);
+  RelExpr expr = pre && pre->valid
+                     ? pre->expr
+                     : target->getRelExpr(type, sym, relocatedAddr);
 
   // Ignore R_*_NONE and other marker relocations.
   if (expr == R_NONE)
     return;
 
   // Read an addend.
-  int64_t addend = computeAddend<ELFT>(rel, end, sec, expr, sym.isLocal());
+  int64_t addend =
+      pre && pre->valid
+          ? pre->addend
+          : computeAddend<ELFT>(rel, end, sec, expr, sym.isLocal());
 
   if (config->emachine == EM_PPC64) {
     // We can separate the small code model relocations into 2 categories:
@@ -1567,7 +1618,8 @@ static void checkPPC64TLSRelax(InputSectionBase &sec, ArrayRef<RelTy> rels) {
 }
 
 template <class ELFT, class RelTy>
-static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
+static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels,
+                       ArrayRef<PrecomputedReloc> precomputed) {
   OffsetGetter getOffset(sec);
 
   // Not all relocations end up in Sec.Relocations, but a lot do.
@@ -1577,7 +1629,7 @@ static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
     checkPPC64TLSRelax<RelTy>(sec, rels);
 
   for (auto i = rels.begin(), end = rels.end(); i != end;)
-    scanReloc<ELFT>(sec, getOffset, i, rels.begin(), end);
+    scanReloc<ELFT>(sec, getOffset, i, rels.begin(), end, precomputed);
 
   // Sort relocations by offset for more efficient searching for
   // R_RISCV_PCREL_HI20 and R_PPC64_ADDR64.
@@ -1589,11 +1641,55 @@ static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
                       });
 }
 
-template <class ELFT> void elf::scanRelocations(InputSectionBase &s) {
+template <class ELFT>
+static void scanSection(InputSectionBase &s,
+                        ArrayRef<PrecomputedReloc> precomputed) {
   if (s.areRelocsRela)
-    scanRelocs<ELFT>(s, s.relas<ELFT>());
+    scanRelocs<ELFT>(s, s.relas<ELFT>(), precomputed);
   else
-    scanRelocs<ELFT>(s, s.rels<ELFT>());
+    scanRelocs<ELFT>(s, s.rels<ELFT>(), precomputed);
+}
+
+template <class ELFT>
+void elf::scanRelocations(ArrayRef<InputSectionBase *> sections) {
+  // MIPS computes addends from paired relocations and N32 combines several
+  // relocation records into one, so scan it the simple way. Do the same if we
+  // don't have threads to spare.
+  if (config->emachine == EM_MIPS ||
+      parallel::strategy.ThreadsRequested == 1) {
+    for (InputSectionBase *s : sections)
+      scanSection<ELFT>(*s, {});
+    return;
+  }
+
+  // Process sections in batches so that the precomputed results for a huge
+  // link don't have to be kept in memory all at once.
+  const size_t batchSize = 1 << 20;
+  std::vector<PrecomputedReloc> precomputed;
+  std::vector<size_t> begins;
+  for (size_t i = 0, e = sections.size(); i != e;) {
+    size_t j = i;
+    begins.assign(1, 0);
+    while (j != e && begins.back() < batchSize)
+      begins.push_back(begins.back() + sections[j++]->numRelocations);
+    precomputed.resize(begins.back());
+
+    parallelForEachN(i, j, [&](size_t k) {
+      InputSectionBase &s = *sections[k];
+      MutableArrayRef<PrecomputedReloc> out(
+          precomputed.data() + begins[k - i], s.numRelocations);
+      if (s.areRelocsRela)
+        precomputeRelocs<ELFT>(s, s.relas<ELFT>(), out);
+      else
+        precomputeRelocs<ELFT>(s, s.rels<ELFT>(), out);
+    });
+
+    for (size_t k = i; k != j; ++k)
+      scanSection<ELFT>(*sections[k],
+                        makeArrayRef(precomputed.data() + begins[k - i],
+                                     sections[k]->numRelocations));
+    i = j;
+  }
 }
 
 static bool mergeCmp(const InputSection *a, const InputSection *b) {
@@ -2115,10 +2211,14 @@ void elf::hexagonTLSSymbolUpdate(ArrayRef<OutputSection *> outputSections) {
       });
 }
 
-template void elf::scanRelocations<ELF32LE>(InputSectionBase &);
-template void elf::scanRelocations<ELF32BE>(InputSectionBase &);
-template void elf::scanRelocations<ELF64LE>(InputSectionBase &);
-template void elf::scanRelocations<ELF64BE>(InputSectionBase &);
+template void
+elf::scanRelocations<ELF32LE>(ArrayRef<InputSectionBase *>);
+template void
+elf::scanRelocations<ELF32BE>(ArrayRef<InputSectionBase *>);
+template void
+elf::scanRelocations<ELF64LE>(ArrayRef<InputSectionBase *>);
+template void
+elf::scanRelocations<ELF64BE>(ArrayRef<InputSectionBase *>);
 template void elf::reportUndefinedSymbols<ELF32LE>();
 template void elf::reportUndefinedSymbols<ELF32BE>();
 template void elf::reportUndefinedSymbols<ELF64LE>();
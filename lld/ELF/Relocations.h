@@ -122,8 +122,9 @@ struct JumpInstrMod {
 
 // This function writes undefined symbol diagnostics to an internal buffer.
 // Call reportUndefinedSymbols() after calling scanRelocations() to emit
-// the diagnostics.
-template <class ELFT> void scanRelocations(InputSectionBase &);
+// the diagnostics. Sections are processed in the given order; the parts of
+// the scan that are independent of that order run in parallel.
+template <class ELFT> void scanRelocations(ArrayRef<InputSectionBase *>);
 
 template <class ELFT> void reportUndefinedSymbols();
 
@@ -47,6 +47,23 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as above, but takes a name whose default version suffix has already
+  // been stripped and whose hash has already been computed. This lets callers
+  // hash names ahead of time, possibly in parallel.
+  Symbol *insert(llvm::CachedHashStringRef name);
+
+  // <name>@@<version> means the symbol is the default version. In that case
+  // <name>@@<version> will be used to resolve references to <name>.
+  static StringRef stripDefaultVersion(StringRef name) {
+    // Since this is a hot path, the following string search code is
+    // optimized for speed. StringRef::find(char) is much faster than
+    // StringRef::find(StringRef).
+    size_t pos = name.find('@');
+    if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
+      return name.take_front(pos);
+    return name;
+  }
+
   Symbol *addSymbol(const Symbol &newSym);
 
   void scanVersionScript();
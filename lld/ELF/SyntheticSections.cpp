@@ -26,6 +26,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
+#include "lld/Common/Timer.h"
 #include "lld/Common/Version.h"
 #include "llvm/ADT/SetOperations.h"
 #include "llvm/ADT/StringExtras.h"
@@ -350,14 +351,7 @@ EhFrameSection::EhFrameSection()
 // Search for an existing CIE record or create a new one.
 // CIE records from input object files are uniquified by their contents
 // and where their relocations point to.
-template <class ELFT, class RelTy>
-CieRecord *EhFrameSection::addCie(EhSectionPiece &cie, ArrayRef<RelTy> rels) {
-  Symbol *personality = nullptr;
-  unsigned firstRelI = cie.firstRelocation;
-  if (firstRelI != (unsigned)-1)
-    personality =
-        &cie.sec->template getFile<ELFT>()->getRelocTargetSym(rels[firstRelI]);
-
+CieRecord *EhFrameSection::addCie(EhSectionPiece &cie, Symbol *personality) {
   // Search for an existing CIE by CIE contents/relocation target pair.
   CieRecord *&rec = cieMap[{cie.data(), personality}];
 
@@ -396,22 +390,56 @@ Defined *EhFrameSection::isFdeLive(EhSectionPiece &fde, ArrayRef<RelTy> rels) {
   return nullptr;
 }
 
-// .eh_frame is a sequence of CIE or FDE records. In general, there
-// is one CIE record per input object file which is followed by
-// a list of FDEs. This function searches an existing CIE or create a new
-// one and associates FDEs to the CIE.
+// Resolves the first relocation of each record of an input .eh_frame section:
+// the personality function for a CIE, or the function for a live FDE (null if
+// the FDE is dead). This only reads the input, so it is run for all sections
+// in parallel.
 template <class ELFT, class RelTy>
-void EhFrameSection::addRecords(EhInputSection *sec, ArrayRef<RelTy> rels) {
-  offsetToCie.clear();
+void EhFrameSection::scanRecords(EhInputSection *sec, ArrayRef<RelTy> rels,
+                                 std::vector<Symbol *> &syms) {
+  syms.reserve(sec->pieces.size());
   for (EhSectionPiece &piece : sec->pieces) {
     // The empty record is the end marker.
     if (piece.size == 4)
       return;
 
+    if (read32(piece.data().data() + 4) != 0) {
+      syms.push_back(isFdeLive<ELFT>(piece, rels));
+      continue;
+    }
+    unsigned firstRelI = piece.firstRelocation;
+    if (firstRelI == (unsigned)-1)
+      syms.push_back(nullptr);
+    else
+      syms.push_back(
+          &sec->template getFile<ELFT>()->getRelocTargetSym(rels[firstRelI]));
+  }
+}
+
+template <class ELFT>
+void EhFrameSection::scanSection(EhInputSection *sec,
+                                 std::vector<Symbol *> &syms) {
+  if (!sec->isLive())
+    return;
+  if (sec->areRelocsRela)
+    scanRecords<ELFT>(sec, sec->template relas<ELFT>(), syms);
+  else
+    scanRecords<ELFT>(sec, sec->template rels<ELFT>(), syms);
+}
+
+// .eh_frame is a sequence of CIE or FDE records. In general, there
+// is one CIE record per input object file which is followed by
+// a list of FDEs. This function searches an existing CIE or create a new
+// one and associates FDEs to the CIE. syms is what scanRecords() computed
+// for the section.
+void EhFrameSection::addRecords(EhInputSection *sec, ArrayRef<Symbol *> syms) {
+  offsetToCie.clear();
+  for (size_t i = 0, e = syms.size(); i != e; ++i) {
+    EhSectionPiece &piece = sec->pieces[i];
     size_t offset = piece.inputOff;
     uint32_t id = read32(piece.data().data() + 4);
     if (id == 0) {
-      offsetToCie[offset] = addCie<ELFT>(piece, rels);
+      offsetToCie[offset] = addCie(piece, syms[i]);
       continue;
     }
 
@@ -420,23 +448,13 @@ void EhFrameSection::addRecords(EhInputSection *sec, ArrayRef<RelTy> rels) {
     if (!rec)
       fatal(toString(sec) + ": invalid CIE reference");
 
-    if (!isFdeLive<ELFT>(piece, rels))
+    if (!syms[i])
       continue;
     rec->fdes.push_back(&piece);
     numFdes++;
   }
 }
 
-template <class ELFT>
-void EhFrameSection::addSectionAux(EhInputSection *sec) {
-  if (!sec->isLive())
-    return;
-  if (sec->areRelocsRela)
-    addRecords<ELFT>(sec, sec->template relas<ELFT>());
-  else
-    addRecords<ELFT>(sec, sec->template rels<ELFT>());
-}
-
 void EhFrameSection::addSection(EhInputSection *sec) {
   sec->parent = this;
 
@@ -507,26 +525,30 @@ static void writeCieFde(uint8_t *buf, ArrayRef<uint8_t> d) {
 void EhFrameSection::finalizeContents() {
   assert(!this->size); // Not finalized.
 
-  switch (config->ekind) {
-  case ELFNoneKind:
-    llvm_unreachable("invalid ekind");
-  case ELF32LEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF32LE>(sec);
-    break;
-  case ELF32BEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF32BE>(sec);
-    break;
-  case ELF64LEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF64LE>(sec);
-    break;
-  case ELF64BEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF64BE>(sec);
-    break;
-  }
+  // Resolving relocations is the expensive part and is independent for each
+  // input section. CIEs are then uniquified serially in input order, so that
+  // the output does not depend on the thread count.
+  std::vector<std::vector<Symbol *>> syms(sections.size());
+  parallelForEachN(0, sections.size(), [&](size_t i) {
+    switch (config->ekind) {
+    case ELFNoneKind:
+      llvm_unreachable("invalid ekind");
+    case ELF32LEKind:
+      scanSection<ELF32LE>(sections[i], syms[i]);
+      break;
+    case ELF32BEKind:
+      scanSection<ELF32BE>(sections[i], syms[i]);
+      break;
+    case ELF64LEKind:
+      scanSection<ELF64LE>(sections[i], syms[i]);
+      break;
+    case ELF64BEKind:
+      scanSection<ELF64BE>(sections[i], syms[i]);
+      break;
+    }
+  });
+  for (size_t i = 0, e = sections.size(); i != e; ++i)
+    addRecords(sections[i], syms[i]);
 
   size_t off = 0;
   for (CieRecord *rec : cieRecords) {
@@ -571,10 +593,12 @@ std::vector<EhFrameSection::FdeData> EhFrameSection::getFdeData() const {
   // Sort the FDE list by their PC and uniqueify. Usually there is only
   // one FDE for a PC (i.e. function), but if ICF merges two functions
   // into one, there can be more than one FDEs pointing to the address.
+  // fdeVARel increases in the order FDEs were added, so using it as a
+  // tie-breaker keeps the first FDE as a stable sort would.
   auto less = [](const FdeData &a, const FdeData &b) {
-    return a.pcRel < b.pcRel;
+    return std::tie(a.pcRel, a.fdeVARel) < std::tie(b.pcRel, b.fdeVARel);
   };
-  llvm::stable_sort(ret, less);
+  parallelSort(ret, less);
   auto eq = [](const FdeData &a, const FdeData &b) {
     return a.pcRel == b.pcRel;
   };
@@ -2781,10 +2805,11 @@ readPubNamesAndTypes(const LLDDwarfObj<ELFT> &obj,
 }
 
 // Create a list of symbols from a given list of symbol names and types
-// by uniquifying them by name.
-static std::vector<GdbIndexSection::GdbSymbol>
-createSymbols(ArrayRef<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
-              const std::vector<GdbIndexSection::GdbChunk> &chunks) {
+// by uniquifying them by name. nameAttrs is consumed to keep peak memory
+// usage low.
+static std::vector<GdbIndexSection::GdbSymbol> createSymbols(
+    std::vector<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
+    const std::vector<GdbIndexSection::GdbChunk> &chunks) {
   using GdbSymbol = GdbIndexSection::GdbSymbol;
   using NameAttrEntry = GdbIndexSection::NameAttrEntry;
 
@@ -2833,6 +2858,11 @@ createSymbols(ArrayRef<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
     }
   });
 
+  // The name entries and the uniquifying maps are no longer needed. Free them
+  // before allocating the flattened vector below.
+  nameAttrs.clear();
+  map.clear();
+
   size_t numSymbols = 0;
   for (ArrayRef<GdbSymbol> v : symbols)
     numSymbols += v.size();
@@ -2907,7 +2937,7 @@ template <class ELFT> GdbIndexSection *GdbIndexSection::create() {
 
   auto *ret = make<GdbIndexSection>();
   ret->chunks = std::move(chunks);
-  ret->symbols = createSymbols(nameAttrs, ret->chunks);
+  ret->symbols = createSymbols(std::move(nameAttrs), ret->chunks);
   ret->initOutputSize();
   return ret;
 }
@@ -2964,21 +2994,19 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
 
   buf += symtabSize * 8;
 
-  // Write the string pool.
+  // Write the constant pool, which consists of the CU vectors followed by the
+  // string pool. Offsets of both were computed by createSymbols(), so each
+  // symbol can be written independently.
   hdr->constantPoolOff = buf - start;
   parallelForEach(symbols, [&](GdbSymbol &sym) {
-    memcpy(buf + sym.nameOff, sym.name.data(), sym.name.size());
-  });
-
-  // Write the CU vectors.
-  for (GdbSymbol &sym : symbols) {
-    write32le(buf, sym.cuVector.size());
-    buf += 4;
+    uint8_t *p = buf + sym.cuVectorOff;
+    write32le(p, sym.cuVector.size());
     for (uint32_t val : sym.cuVector) {
-      write32le(buf, val);
-      buf += 4;
+      p += 4;
+      write32le(p, val);
     }
-  }
+    memcpy(buf + sym.nameOff, sym.name.data(), sym.name.size());
+  });
 }
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
@@ -3224,6 +3252,29 @@ size_t MergeTailSection::getSize() const { return builder.getSize(); }
 
 void MergeTailSection::writeTo(uint8_t *buf) { builder.write(buf); }
 
+void MergeSyntheticSection::logMergeStats() const {
+  if (!errorHandler().verbose)
+    return;
+
+  size_t numPieces = 0;
+  size_t numLive = 0;
+  uint64_t liveSize = 0;
+  uint64_t pieceMemory = 0;
+  for (MergeInputSection *sec : sections) {
+    numPieces += sec->pieces.size();
+    pieceMemory += sec->pieces.capacity() * sizeof(SectionPiece);
+    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+      if (!sec->pieces[i].live)
+        continue;
+      ++numLive;
+      liveSize += sec->getData(i).size();
+    }
+  }
+  log(name + ": merged " + Twine(numLive) + " of " + Twine(numPieces) +
+      " pieces (" + Twine(liveSize) + " bytes) into " + Twine(getSize()) +
+      " bytes; " + Twine(pieceMemory) + " bytes used for pieces");
+}
+
 void MergeTailSection::finalizeContents() {
   // Add all string pieces to the string table builder to create section
   // contents.
@@ -3242,6 +3293,8 @@ void MergeTailSection::finalizeContents() {
     for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
       if (sec->pieces[i].live)
         sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+
+  logMergeStats();
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
@@ -3301,6 +3354,8 @@ void MergeNoTailSection::finalizeContents() {
         sec->pieces[i].outputOff +=
             shardOffsets[getShardId(sec->pieces[i].hash)];
   });
+
+  logMergeStats();
 }
 
 MergeSyntheticSection *elf::createMergeSynthetic(StringRef name, uint32_t type,
@@ -3316,12 +3371,21 @@ template <class ELFT> void elf::splitSections() {
   llvm::TimeTraceScope timeScope("Split sections");
   // splitIntoPieces needs to be called on each MergeInputSection
   // before calling finalizeContents().
-  parallelForEach(inputSections, [](InputSectionBase *sec) {
-    if (auto *s = dyn_cast<MergeInputSection>(sec))
-      s->splitIntoPieces();
-    else if (auto *eh = dyn_cast<EhInputSection>(sec))
-      eh->split<ELFT>();
-  });
+  tracedParallelForEachN(
+      "Split sections", 0, inputSections.size(),
+      [](size_t i) {
+        InputSectionBase *sec = inputSections[i];
+        if (auto *s = dyn_cast<MergeInputSection>(sec))
+          s->splitIntoPieces();
+        else if (auto *eh = dyn_cast<EhInputSection>(sec))
+          eh->split<ELFT>();
+      },
+      [](size_t i) {
+        InputSectionBase *sec = inputSections[i];
+        return isa<MergeInputSection>(sec) || isa<EhInputSection>(sec)
+                   ? sec->data().size()
+                   : 0;
+      });
 }
 
 MipsRldMapSection::MipsRldMapSection()
@@ -100,15 +100,17 @@ private:
   uint64_t size = 0;
 
   template <class ELFT, class RelTy>
-  void addRecords(EhInputSection *s, llvm::ArrayRef<RelTy> rels);
-  template <class ELFT> void addSectionAux(EhInputSection *s);
+  void scanRecords(EhInputSection *s, llvm::ArrayRef<RelTy> rels,
+                   std::vector<Symbol *> &syms);
+  template <class ELFT>
+  void scanSection(EhInputSection *s, std::vector<Symbol *> &syms);
+  void addRecords(EhInputSection *s, llvm::ArrayRef<Symbol *> syms);
   template <class ELFT, class RelTy>
   void iterateFDEWithLSDAAux(EhInputSection &sec, ArrayRef<RelTy> rels,
                              llvm::DenseSet<size_t> &ciesWithLSDA,
                              llvm::function_ref<void(InputSection &)> fn);
 
-  template <class ELFT, class RelTy>
-  CieRecord *addCie(EhSectionPiece &piece, ArrayRef<RelTy> rels);
+  CieRecord *addCie(EhSectionPiece &piece, Symbol *personality);
 
   template <class ELFT, class RelTy>
   Defined *isFdeLive(EhSectionPiece &piece, ArrayRef<RelTy> rels);
@@ -750,7 +752,9 @@ public:
 
   struct GdbSymbol {
     llvm::CachedHashStringRef name;
-    std::vector<uint32_t> cuVector;
+    // Most names are defined in only one or two compilation units, so avoid a
+    // heap allocation per symbol in the common case.
+    SmallVector<uint32_t, 2> cuVector;
     uint32_t nameOff;
     uint32_t cuVectorOff;
   };
@@ -882,6 +886,9 @@ public:
   std::vector<MergeInputSection *> sections;
 
 protected:
+  // With --verbose, reports how much input data was merged into this section.
+  void logMergeStats() const;
+
   MergeSyntheticSection(StringRef name, uint32_t type, uint64_t flags,
                         uint32_t alignment)
       : SyntheticSection(flags, type, alignment, name) {}
@@ -22,6 +22,7 @@
 #include "lld/Common/Filesystem.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
+#include "lld/Common/Timer.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Parallel.h"
@@ -621,13 +622,14 @@ template <class ELFT> void Writer<ELFT>::run() {
     for (OutputSection *sec : outputSections)
       sec->addr = 0;
 
-  // Handle --print-map(-M)/--Map, --cref and --print-archive-stats=. Dump them
-  // before checkSections() because the files may be useful in case
-  // checkSections() or openFile() fails, for example, due to an erroneous file
-  // size.
+  // Handle --print-map(-M)/--Map, --cref, --print-archive-stats= and
+  // --layout-state=. Dump them before checkSections() because the files may be
+  // useful in case checkSections() or openFile() fails, for example, due to an
+  // erroneous file size.
   writeMapFile();
   writeCrossReferenceTable();
   writeArchiveStats();
+  writeLayoutState();
 
   if (config->checkSections)
     checkSections();
@@ -1994,7 +1996,9 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
     // a linker-script-defined symbol is absolute.
     ppc64noTocRelax.clear();
     if (!config->relocatable) {
-      forEachRelSec(scanRelocations<ELFT>);
+      std::vector<InputSectionBase *> relSecs;
+      forEachRelSec([&](InputSectionBase &sec) { relSecs.push_back(&sec); });
+      scanRelocations<ELFT>(relSecs);
       reportUndefinedSymbols<ELFT>();
     }
   }
@@ -2967,9 +2971,18 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
     if (sec->type == SHT_REL || sec->type == SHT_RELA)
       sec->writeTo<ELFT>(Out::bufferStart + sec->offset);
 
-  for (OutputSection *sec : outputSections)
-    if (sec->type != SHT_REL && sec->type != SHT_RELA)
-      sec->writeTo<ELFT>(Out::bufferStart + sec->offset);
+  // With --release-output-pages, the memory backing a section is given back
+  // once it has been written, so that the resident size of the output is
+  // bounded by the largest section rather than by the whole file. The
+  // contents are kept in the file and are paged back in if something (e.g.
+  // .eh_frame_hdr or the build ID) touches them again.
+  for (OutputSection *sec : outputSections) {
+    if (sec->type == SHT_REL || sec->type == SHT_RELA)
+      continue;
+    sec->writeTo<ELFT>(Out::bufferStart + sec->offset);
+    if (config->releaseOutputPages && sec->type != SHT_NOBITS)
+      buffer->releaseRange(sec->offset, sec->size);
+  }
 }
 
 // Split one uint8 array into small pieces of uint8 arrays.
@@ -2988,18 +3001,25 @@ static std::vector<ArrayRef<uint8_t>> split(ArrayRef<uint8_t> arr,
 // Computes a hash value of Data using a given hash function.
 // In order to utilize multiple cores, we first split data into 1MB
 // chunks, compute a hash for each chunk, and then compute a hash value
-// of the hash values.
+// of the hash values. If releaseFn is given, it is called for each chunk
+// once it has been hashed.
 static void
 computeHash(llvm::MutableArrayRef<uint8_t> hashBuf,
             llvm::ArrayRef<uint8_t> data,
-            std::function<void(uint8_t *dest, ArrayRef<uint8_t> arr)> hashFn) {
+            std::function<void(uint8_t *dest, ArrayRef<uint8_t> arr)> hashFn,
+            std::function<void(ArrayRef<uint8_t> arr)> releaseFn = nullptr) {
   std::vector<ArrayRef<uint8_t>> chunks = split(data, 1024 * 1024);
   std::vector<uint8_t> hashes(chunks.size() * hashBuf.size());
 
   // Compute hash values.
-  parallelForEachN(0, chunks.size(), [&](size_t i) {
-    hashFn(hashes.data() + i * hashBuf.size(), chunks[i]);
-  });
+  tracedParallelForEachN(
+      "Compute build ID", 0, chunks.size(),
+      [&](size_t i) {
+        hashFn(hashes.data() + i * hashBuf.size(), chunks[i]);
+        if (releaseFn)
+          releaseFn(chunks[i]);
+      },
+      [&](size_t i) { return chunks[i].size(); });
 
   // Write to the final output buffer.
   hashFn(hashBuf.data(), hashes);
@@ -3020,21 +3040,36 @@ template <class ELFT> void Writer<ELFT>::writeBuildId() {
   std::vector<uint8_t> buildId(hashSize);
   llvm::ArrayRef<uint8_t> buf{Out::bufferStart, size_t(fileSize)};
 
+  std::function<void(ArrayRef<uint8_t>)> release;
+  if (config->releaseOutputPages)
+    release = [&](ArrayRef<uint8_t> arr) {
+      buffer->releaseRange(arr.data() - Out::bufferStart, arr.size());
+    };
+
   switch (config->buildId) {
   case BuildIdKind::Fast:
-    computeHash(buildId, buf, [](uint8_t *dest, ArrayRef<uint8_t> arr) {
-      write64le(dest, xxHash64(arr));
-    });
+    computeHash(
+        buildId, buf,
+        [](uint8_t *dest, ArrayRef<uint8_t> arr) {
+          write64le(dest, xxHash64(arr));
+        },
+        release);
     break;
   case BuildIdKind::Md5:
-    computeHash(buildId, buf, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
-      memcpy(dest, MD5::hash(arr).data(), hashSize);
-    });
+    computeHash(
+        buildId, buf,
+        [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
+          memcpy(dest, MD5::hash(arr).data(), hashSize);
+        },
+        release);
     break;
   case BuildIdKind::Sha1:
-    computeHash(buildId, buf, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
-      memcpy(dest, SHA1::hash(arr).data(), hashSize);
-    });
+    computeHash(
+        buildId, buf,
+        [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
+          memcpy(dest, SHA1::hash(arr).data(), hashSize);
+        },
+        release);
     break;
   case BuildIdKind::Uuid:
     if (auto ec = llvm::getRandomBytes(buildId.data(), hashSize))
@@ -38,7 +38,9 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -394,6 +396,42 @@ static void addFileList(StringRef path) {
     addFile(path, false);
 }
 
+// Input files are parsed one at a time, in command line order, because
+// symbol resolution depends on that order. Reading them does not: fault in
+// every page of the named inputs on all threads up front, so that parsing
+// does not wait on the disk once per file. Errors are ignored here and
+// reported by addFile().
+static void pageInInputFiles(const InputArgList &args) {
+  llvm::TimeTraceScope timeScope("Page in input files");
+  std::vector<StringRef> paths;
+  std::vector<std::unique_ptr<MemoryBuffer>> fileLists;
+  for (const Arg *arg :
+       args.filtered(OPT_INPUT, OPT_weak_library, OPT_force_load))
+    paths.push_back(arg->getValue());
+  for (const Arg *arg : args.filtered(OPT_filelist)) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+        MemoryBuffer::getFile(arg->getValue());
+    if (!mbOrErr)
+      continue;
+    for (StringRef path : args::getLines((*mbOrErr)->getMemBufferRef()))
+      paths.push_back(path);
+    fileLists.push_back(std::move(*mbOrErr));
+  }
+
+  const size_t pageSize = Process::getPageSizeEstimate();
+  parallelForEach(paths, [&](StringRef path) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr = MemoryBuffer::getFile(
+        path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+    if (!mbOrErr)
+      return;
+    StringRef buf = (*mbOrErr)->getBuffer();
+    volatile char sink;
+    for (size_t i = 0, e = buf.size(); i < e; i += pageSize)
+      sink = buf[i];
+    (void)sink;
+  });
+}
+
 // An order file has one entry per line, in the following format:
 //
 //   <cpu>:<object file>:<symbol name>
@@ -949,6 +987,7 @@ bool macho::link(ArrayRef<const char *> argsArr, bool canExitEarly,
     llvm::TimeTraceScope timeScope("Link", StringRef("ExecuteLinker"));
 
     initLLVM(); // must be run before any call to addFile()
+    pageInInputFiles(args);
 
     // This loop should be reserved for options whose exact ordering matters.
     // Other options should be handled via filtered() and/or getLastArg().
@@ -21,6 +21,7 @@
 #include "lld/Common/Memory.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/BinaryFormat/MachO.h"
+#include "llvm/Support/Parallel.h"
 
 using namespace llvm;
 using namespace llvm::MachO;
@@ -171,10 +172,11 @@ static void checkTextSegment(InputSection *isec) {
 // We need to apply the relocations to the pre-link compact unwind section
 // before converting it to post-link form. There should only be absolute
 // relocations here: since we are not emitting the pre-link CU section, there
-// is no source address to make a relative location meaningful.
+// is no source address to make a relative location meaningful. Each input
+// section fills its own slice of cuVector, so they are done in parallel.
 static void relocateCompactUnwind(MergedOutputSection *compactUnwindSection,
                                   std::vector<CompactUnwindEntry64> &cuVector) {
-  for (const InputSection *isec : compactUnwindSection->inputs) {
+  parallelForEach(compactUnwindSection->inputs, [&](const InputSection *isec) {
     uint8_t *buf =
         reinterpret_cast<uint8_t *>(cuVector.data()) + isec->outSecFileOff;
     memcpy(buf, isec->data.data(), isec->data.size());
@@ -197,7 +199,7 @@ static void relocateCompactUnwind(MergedOutputSection *compactUnwindSection,
       }
       support::endian::write64le(buf + r.offset, referentVA);
     }
-  }
+  });
 }
 
 // There should only be a handful of unique personality pointers, so we can
@@ -251,10 +253,11 @@ void UnwindInfoSection::finalize() {
   cuPtrVector.reserve(cuCount);
   for (CompactUnwindEntry64 &cuEntry : cuVector)
     cuPtrVector.emplace_back(&cuEntry);
-  std::sort(cuPtrVector.begin(), cuPtrVector.end(),
-            [](const CompactUnwindEntry64 *a, const CompactUnwindEntry64 *b) {
-              return a->functionAddress < b->functionAddress;
-            });
+  parallelSort(
+      cuPtrVector.begin(), cuPtrVector.end(),
+      [](const CompactUnwindEntry64 *a, const CompactUnwindEntry64 *b) {
+        return a->functionAddress < b->functionAddress;
+      });
 
   // Fold adjacent entries with matching encoding+personality+lsda
   // We use three iterators on the same cuPtrVector to fold in-situ:
@@ -436,10 +439,13 @@ void UnwindInfoSection::writeTo(uint8_t *buf) const {
   if (lsdaBytes > 0)
     memcpy(iep, lsdaEntries.data(), lsdaBytes);
 
-  // Level-2 pages
-  auto *pp = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(iep) +
-                                          lsdaBytes);
-  for (const SecondLevelPage &page : secondLevelPages) {
+  // Level-2 pages. They are independent of each other and each one has a
+  // fixed size, so encode them in parallel.
+  auto *pagesBegin = reinterpret_cast<uint32_t *>(
+      reinterpret_cast<uint8_t *>(iep) + lsdaBytes);
+  parallelForEachN(0, secondLevelPages.size(), [&](size_t pageIdx) {
+    const SecondLevelPage &page = secondLevelPages[pageIdx];
+    uint32_t *pp = pagesBegin + pageIdx * SECOND_LEVEL_PAGE_WORDS;
     if (page.kind == UNWIND_SECOND_LEVEL_COMPRESSED) {
       uintptr_t functionAddressBase =
           cuPtrVector[page.entryIndex]->functionAddress;
@@ -479,6 +485,5 @@ void UnwindInfoSection::writeTo(uint8_t *buf) const {
         *ep++ = cuep->encoding;
       }
     }
-    pp += SECOND_LEVEL_PAGE_WORDS;
-  }
+  });
 }
@@ -44,6 +44,10 @@ public:
     return !ExactMatch && GlobPatternMatcher.isTrivialMatchAll();
   }
 
+  // Returns the literal characters every matched string starts with. This is
+  // empty if the pattern starts with a wildcard.
+  llvm::StringRef getLiteralPrefix() const { return LiteralPrefix; }
+
 private:
   // Whether to do an exact match regardless of wildcard characters.
   bool ExactMatch;
@@ -53,6 +57,9 @@ private:
 
   // StringRef to match exactly if doing an exact match.
   llvm::StringRef ExactPattern;
+
+  // The part of the pattern before the first wildcard.
+  llvm::StringRef LiteralPrefix;
 };
 
 // This class represents multiple patterns to match against. A pattern can
@@ -77,6 +84,11 @@ public:
 
   // Match s against the patterns.
   bool match(llvm::StringRef s) const;
+
+  // Collects in prefixes the literal prefixes of the patterns, so that every
+  // matched string starts with one of them. Returns false if a pattern starts
+  // with a wildcard, in which case matched strings can start with anything.
+  bool getLiteralPrefixes(std::vector<llvm::StringRef> &prefixes) const;
 };
 
 } // namespace lld
@@ -9,8 +9,13 @@
 #ifndef LLD_COMMON_TIMER_H
 #define LLD_COMMON_TIMER_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/TimeProfiler.h"
+#include <algorithm>
 #include <assert.h>
 #include <atomic>
 #include <chrono>
@@ -53,6 +58,56 @@ private:
   std::string name;
 };
 
+// The work one task of a traced parallel loop did, see
+// tracedParallelForEachN().
+struct ParallelShard {
+  uint64_t tid = 0;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+  size_t items = 0;
+  uint64_t bytes = 0;
+};
+
+// Add one --time-trace section per thread that ran any of the given shards.
+// Each section spans from the first shard the thread started to the last one
+// it finished, and records the number of items and bytes the thread processed
+// and how long it was actually busy.
+void addParallelTimeTrace(llvm::StringRef name,
+                          llvm::ArrayRef<ParallelShard> shards);
+
+// Like parallelForEachN, but if --time-trace is enabled, the trace gets one
+// section named `name` for each thread that took part in the loop, so that
+// load imbalance between threads is visible. `sizeFn(i)` returns the number
+// of bytes that `fn(i)` processes.
+template <class FuncTy, class SizeFuncTy>
+void tracedParallelForEachN(llvm::StringRef name, size_t begin, size_t end,
+                            FuncTy fn, SizeFuncTy sizeFn) {
+  if (!llvm::timeTraceProfilerEnabled() || begin >= end) {
+    llvm::parallelForEachN(begin, end, fn);
+    return;
+  }
+
+  // Split the range ourselves, the same way parallelForEachN does, so that
+  // each task can record which thread ran it.
+  size_t numItems = end - begin;
+  size_t numShards = std::min<size_t>(numItems, 1024);
+  std::vector<ParallelShard> shards(numShards);
+  llvm::parallelForEachN(0, numShards, [&](size_t i) {
+    ParallelShard &shard = shards[i];
+    shard.tid = llvm::get_threadid();
+    shard.start = std::chrono::steady_clock::now();
+    size_t first = begin + numItems * i / numShards;
+    size_t last = begin + numItems * (i + 1) / numShards;
+    for (size_t j = first; j != last; ++j) {
+      fn(j);
+      shard.bytes += sizeFn(j);
+    }
+    shard.items = last - first;
+    shard.end = std::chrono::steady_clock::now();
+  });
+  addParallelTimeTrace(name, shards);
+}
+
 } // namespace lld
 
 #endif
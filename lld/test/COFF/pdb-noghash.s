@@ -0,0 +1,95 @@
+# REQUIRES: x86
+# RUN: split-file %s %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64-windows-msvc %t/a.s -o %t/a.obj
+# RUN: llvm-mc -filetype=obj -triple=x86_64-windows-msvc %t/b.s -o %t/b.obj
+
+## /debug merges types with global type hashes, like /debug:ghash.
+## /debug:noghash selects the serial type merger, which is the only one that
+## reports the most duplicated input types in /summary.
+# RUN: lld-link /entry:main /nodefaultlib /out:%t/full.exe /pdb:%t/full.pdb \
+# RUN:   /debug /summary %t/a.obj %t/b.obj | FileCheck --check-prefix=SUMMARY %s
+# RUN: lld-link /entry:main /nodefaultlib /out:%t/ghash.exe /pdb:%t/ghash.pdb \
+# RUN:   /debug:ghash /summary %t/a.obj %t/b.obj | FileCheck --check-prefix=SUMMARY %s
+# RUN: lld-link /entry:main /nodefaultlib /out:%t/noghash.exe /pdb:%t/noghash.pdb \
+# RUN:   /debug:noghash /summary %t/a.obj %t/b.obj \
+# RUN:   | FileCheck --check-prefixes=SUMMARY,NOGHASH %s
+
+# SUMMARY:              2 Input OBJ files
+# SUMMARY:              6 Input type records
+# SUMMARY:              4 Merged TPI records
+# SUMMARY-NOT: Top 10 types
+# NOGHASH:     Top 10 types responsible for the most TPI input:
+
+## Both mergers produce the same type stream.
+# RUN: llvm-pdbutil dump -types %t/full.pdb | FileCheck --check-prefix=TYPES %s
+# RUN: llvm-pdbutil dump -types %t/ghash.pdb | FileCheck --check-prefix=TYPES %s
+# RUN: llvm-pdbutil dump -types %t/noghash.pdb | FileCheck --check-prefix=TYPES %s
+
+# TYPES:      Showing 4 records
+# TYPES-NEXT: 0x1000 | LF_ARGLIST [size = 8]
+# TYPES-NEXT: 0x1001 | LF_PROCEDURE [size = 16]
+# TYPES-NEXT:          return type = 0x0074 (int), # args = 0, param list = 0x1000
+# TYPES-NEXT:          calling conv = cdecl, options = None
+# TYPES-NEXT: 0x1002 | LF_POINTER [size = 12]
+# TYPES-NEXT:          referent = 0x1001, mode = pointer, opts = None, kind = ptr64
+# TYPES-NEXT: 0x1003 | LF_PROCEDURE [size = 16]
+# TYPES-NEXT:          return type = 0x0075 (unsigned), # args = 0, param list = 0x1000
+# TYPES-NEXT:          calling conv = cdecl, options = None
+
+#--- a.s
+        .text
+        .globl  main
+main:
+        xorl    %eax, %eax
+        retq
+
+        .section        .debug$T,"dr"
+        .p2align        2
+        .long   4
+        # 0x1000: LF_ARGLIST ()
+        .short  0x6
+        .short  0x1201
+        .long   0
+        # 0x1001: LF_PROCEDURE int ()
+        .short  0xe
+        .short  0x1008
+        .long   0x74
+        .byte   0
+        .byte   0
+        .short  0
+        .long   0x1000
+        # 0x1002: LF_POINTER int (*)()
+        .short  0xa
+        .short  0x1002
+        .long   0x1001
+        .long   0x1000c
+
+#--- b.s
+        .text
+        .globl  f
+f:
+        retq
+
+        .section        .debug$T,"dr"
+        .p2align        2
+        .long   4
+        # 0x1000: LF_ARGLIST ()
+        .short  0x6
+        .short  0x1201
+        .long   0
+        # 0x1001: LF_PROCEDURE unsigned ()
+        .short  0xe
+        .short  0x1008
+        .long   0x75
+        .byte   0
+        .byte   0
+        .short  0
+        .long   0x1000
+        # 0x1002: LF_PROCEDURE int ()
+        .short  0xe
+        .short  0x1008
+        .long   0x74
+        .byte   0
+        .byte   0
+        .short  0
+        .long   0x1000
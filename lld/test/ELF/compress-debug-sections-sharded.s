@@ -0,0 +1,36 @@
+# REQUIRES: x86, zlib
+
+## Sections larger than a shard are deflated in parallel shards that are
+## joined into one zlib stream. Check that the result decompresses in one go,
+## checksum included, to the uncompressed contents.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld %t.o -o %t.plain
+# RUN: ld.lld %t.o --compress-debug-sections=zlib -o %t.zlib
+# RUN: llvm-readelf -S %t.zlib | FileCheck %s
+# RUN: llvm-objcopy --decompress-debug-sections %t.zlib %t.decompressed
+# RUN: llvm-objcopy --dump-section=.debug_line=%t.plain.line \
+# RUN:   --dump-section=.debug_info=%t.plain.info %t.plain %t.unused
+# RUN: llvm-objcopy --dump-section=.debug_line=%t.decompressed.line \
+# RUN:   --dump-section=.debug_info=%t.decompressed.info %t.decompressed %t.unused
+# RUN: cmp %t.plain.line %t.decompressed.line
+# RUN: cmp %t.plain.info %t.decompressed.info
+
+# CHECK: .debug_info PROGBITS {{.*}} C
+# CHECK: .debug_line PROGBITS {{.*}} C
+
+.globl _start
+_start:
+  ret
+
+## Smaller than a shard.
+.section .debug_info,"",@progbits
+.rept 0x1000
+.quad 0x0123456789abcdef
+.endr
+
+## 2.5 MiB, so that the last of the three shards is partial.
+.section .debug_line,"",@progbits
+.rept 0x28000
+.ascii "0123456789abcdef"
+.endr
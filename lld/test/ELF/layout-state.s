@@ -0,0 +1,96 @@
+# REQUIRES: x86
+## --layout-state= writes the hash of every input file and the placement of
+## every input section in the output as JSON.
+
+# RUN: rm -rf %t && split-file %s %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %t/a.s -o %t/a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %t/b.s -o %t/b.o
+# RUN: ld.lld %t/a.o %t/b.o --layout-state=%t/layout.json -o %t/out
+# RUN: %python -m json.tool %t/layout.json | FileCheck %s
+
+## The hash only depends on the contents of the file.
+# RUN: cp %t/a.o %t/c.o
+# RUN: ld.lld %t/c.o %t/b.o --layout-state=%t/layout2.json -o %t/out2
+# RUN: cat %t/layout.json %t/layout2.json | FileCheck %s --check-prefix=HASH
+
+# RUN: not ld.lld %t/a.o %t/b.o --layout-state=%t -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=ERR -DFILE=%t
+
+# CHECK:      "version": 1,
+# CHECK-NEXT: "output": "{{.*}}out",
+# CHECK-NEXT: "files": [
+# CHECK-NEXT:     {
+# CHECK-NEXT:         "path": "{{.*}}a.o",
+# CHECK-NEXT:         "hash": "{{[0-9A-F]+}}"
+# CHECK-NEXT:     },
+# CHECK-NEXT:     {
+# CHECK-NEXT:         "path": "{{.*}}b.o",
+# CHECK-NEXT:         "hash": "{{[0-9A-F]+}}"
+# CHECK-NEXT:     }
+# CHECK-NEXT: ],
+# CHECK-NEXT: "sections": [
+# CHECK-NEXT:     {
+# CHECK-NEXT:         "name": ".text",
+# CHECK-NEXT:         "addr": [[#%u,TEXT:]],
+# CHECK-NEXT:         "offset": [[#%u,TEXT - 0x200000]],
+# CHECK-NEXT:         "size": 17,
+# CHECK-NEXT:         "inputs": [
+# CHECK-NEXT:             {
+# CHECK-NEXT:                 "file": 0,
+# CHECK-NEXT:                 "name": ".text",
+# CHECK-NEXT:                 "offset": 0,
+# CHECK-NEXT:                 "size": 6,
+# CHECK-NEXT:                 "align": 4
+# CHECK-NEXT:             },
+# CHECK-NEXT:             {
+# CHECK-NEXT:                 "file": 1,
+# CHECK-NEXT:                 "name": ".text",
+# CHECK-NEXT:                 "offset": 16,
+# CHECK-NEXT:                 "size": 1,
+# CHECK-NEXT:                 "align": 16
+# CHECK-NEXT:             }
+# CHECK-NEXT:         ]
+# CHECK-NEXT:     },
+# CHECK-NEXT:     {
+# CHECK-NEXT:         "name": ".data",
+# CHECK-NEXT:         "addr": [[#%u,]],
+# CHECK-NEXT:         "offset": [[#%u,]],
+# CHECK-NEXT:         "size": 8,
+# CHECK-NEXT:         "inputs": [
+# CHECK-NEXT:             {
+# CHECK-NEXT:                 "file": 0,
+# CHECK-NEXT:                 "name": ".data",
+# CHECK-NEXT:                 "offset": 0,
+# CHECK-NEXT:                 "size": 8,
+# CHECK-NEXT:                 "align": 1
+# CHECK-NEXT:             }
+# CHECK-NEXT:         ]
+# CHECK-NEXT:     },
+## Synthetic sections have no input file and list no inputs.
+# CHECK-NEXT:     {
+# CHECK-NEXT:         "name": ".comment",
+# CHECK-NEXT:         "addr": 0,
+# CHECK-NEXT:         "offset": [[#%u,]],
+# CHECK-NEXT:         "size": [[#%u,]],
+# CHECK-NEXT:         "inputs": []
+# CHECK-NEXT:     },
+
+# HASH:      "files":[{"path":"{{.*}}a.o","hash":"[[HASH:[0-9A-F]+]]"}
+# HASH:      "files":[{"path":"{{.*}}c.o","hash":"[[HASH]]"}
+
+# ERR: error: --layout-state=: cannot open [[FILE]]: {{.*}}
+
+#--- a.s
+.globl _start
+_start:
+  call foo
+  ret
+
+.data
+.quad 1
+
+#--- b.s
+.globl foo
+.p2align 4
+foo:
+  ret
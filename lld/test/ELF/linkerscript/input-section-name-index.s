@@ -0,0 +1,50 @@
+# REQUIRES: x86
+## Input section patterns that start with a literal prefix are matched through
+## an index of the section names when they select few sections. Check that the
+## result is the same as with a linear scan: sections keep the input order,
+## sections consumed by an earlier pattern are not matched again, and the file
+## and flag filters still apply.
+
+# RUN: rm -rf %t && split-file %s %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %t/a.s -o %t/a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %t/b.s -o %t/b.o
+# RUN: ld.lld -T %t/script %t/a.o %t/b.o -o %t/out
+# RUN: llvm-readelf -x .first -x .second -x .rest %t/out | FileCheck %s
+
+# CHECK:      Hex dump of section '.first':
+# CHECK-NEXT: 0x{{[0-9a-f]+}} a1a3b1{{ }}
+# CHECK:      Hex dump of section '.second':
+# CHECK-NEXT: 0x{{[0-9a-f]+}} b3b5a2{{ }}
+# CHECK:      Hex dump of section '.rest':
+# CHECK-NEXT: 0x{{[0-9a-f]+}} a0a5ffff ffffffff ffffffff ffffffff
+# CHECK-NEXT: 0x{{[0-9a-f]+}} ffffffff ffffffff ffffffff ffffffff
+# CHECK-NEXT: 0x{{[0-9a-f]+}} ffffffff ffffffff ffffb0{{ }}
+
+#--- a.s
+.irp name,a0,a1,a2,a3,a5
+.section .data.\name,"aw"
+.byte 0x\name
+.endr
+
+## Make the sections selected by the patterns a small fraction of all sections.
+.irp i,00,01,02,03,04,05,06,07,08,09,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39
+.section .data.f\i,"aw"
+.byte 0xff
+.endr
+
+#--- b.s
+.section .data.a1,"aw"
+.byte 0xb1
+.section .data.a3,"awx"
+.byte 0xb3
+.section .data.a5,"aw"
+.byte 0xb5
+.section .data.b0,"aw"
+.byte 0xb0
+
+#--- script
+SECTIONS {
+  .first : { INPUT_SECTION_FLAGS(!SHF_EXECINSTR) *(.data.a1 .data.a3) }
+  .second : { *b.o(.data.a*) *(.data.a2*) }
+  .rest : { *(.data.*) }
+}
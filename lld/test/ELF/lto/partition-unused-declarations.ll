@@ -0,0 +1,36 @@
+; REQUIRES: x86
+;; Each LTO partition drops the declarations it does not reference, but keeps
+;; the ones that are only referenced from metadata.
+
+; RUN: llvm-as %s -o %t.o
+; RUN: ld.lld --lto-partitions=2 -save-temps -shared %t.o -o %t.so
+; RUN: llvm-dis %t.so.0.5.precodegen.bc -o - | FileCheck %s --check-prefix=CHECK0
+; RUN: llvm-dis %t.so.1.5.precodegen.bc -o - | FileCheck %s --check-prefix=CHECK1
+
+; CHECK0:     define void @foo()
+; CHECK0:     declare void @bar()
+; CHECK0-NOT: @baz
+; CHECK0:     !0 = !{void ()* @foo, void ()* @bar}
+
+; CHECK1:     declare void @foo()
+; CHECK1:     define void @bar()
+; CHECK1:     define void @baz()
+; CHECK1:     !0 = !{void ()* @foo, void ()* @bar}
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @foo() {
+  ret void
+}
+
+define void @bar() {
+  ret void
+}
+
+define void @baz() {
+  ret void
+}
+
+!refs = !{!0}
+!0 = !{void ()* @foo, void ()* @bar}
@@ -0,0 +1,60 @@
+; REQUIRES: x86
+;; --thinlto-memory-budget= only delays ThinLTO backends, so the output must be
+;; the same with or without it. A budget smaller than any backend still lets
+;; one backend run at a time.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-summary a.ll -o a.o
+; RUN: opt -module-summary b.ll -o b.o
+; RUN: opt -module-summary c.ll -o c.o
+
+; RUN: ld.lld --thinlto-jobs=4 -shared a.o b.o c.o -o out1
+; RUN: ld.lld --thinlto-jobs=4 --thinlto-memory-budget=1 -shared a.o b.o c.o \
+; RUN:   -o out2
+; RUN: ld.lld --thinlto-jobs=4 --thinlto-memory-budget=4096 -shared a.o b.o \
+; RUN:   c.o -o out3
+; RUN: cmp out1 out2
+; RUN: cmp out1 out3
+; RUN: llvm-nm out2 | FileCheck %s
+
+; CHECK: T f
+; CHECK: T g
+; CHECK: T h
+
+; RUN: not ld.lld --thinlto-memory-budget=0 -shared a.o -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=ERR -DVALUE=0
+; RUN: not ld.lld --thinlto-memory-budget=big -shared a.o -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=ERR -DVALUE=big
+; ERR: error: --thinlto-memory-budget=: expected a positive integer, but got '[[VALUE]]'
+
+;--- a.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @f(i32 %x) {
+  %r = call i32 @g(i32 %x)
+  ret i32 %r
+}
+
+declare i32 @g(i32)
+
+;--- b.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @g(i32 %x) {
+  %r = call i32 @h(i32 %x)
+  %s = add i32 %r, 1
+  ret i32 %s
+}
+
+declare i32 @h(i32)
+
+;--- c.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @h(i32 %x) {
+  %r = mul i32 %x, 3
+  ret i32 %r
+}
@@ -0,0 +1,69 @@
+; REQUIRES: x86
+;; --thinlto-shared-cache-dir= backs the local ThinLTO cache with a directory
+;; shared between links. Objects built locally are published to it, and a miss
+;; in the local cache is served from it.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-hash -module-summary a.ll -o a.o
+; RUN: opt -module-hash -module-summary b.ll -o b.o
+
+;; The first link builds both objects and adds them to both caches.
+; RUN: ld.lld -shared --thinlto-cache-dir=local1 \
+; RUN:   --thinlto-shared-cache-dir=shared a.o b.o -o out1
+; RUN: ls shared | count 2
+; RUN: ls local1 | count 3
+; RUN: llvm-readelf -x .rodata out1 | FileCheck %s --check-prefix=BUILT
+
+;; Change the marker in the shared objects. A link with an empty local cache
+;; uses them and copies them into its local cache.
+; RUN: %python patch.py shared
+; RUN: ld.lld -shared --thinlto-cache-dir=local2 \
+; RUN:   --thinlto-shared-cache-dir=shared a.o b.o -o out2
+; RUN: ls local2 | count 3
+; RUN: llvm-readelf -x .rodata out2 | FileCheck %s --check-prefix=SHARED
+; RUN: ld.lld -shared --thinlto-cache-dir=local2 a.o b.o -o out3
+; RUN: llvm-readelf -x .rodata out3 | FileCheck %s --check-prefix=SHARED
+
+;; Hits in the local cache take precedence over the shared cache.
+; RUN: ld.lld -shared --thinlto-cache-dir=local1 \
+; RUN:   --thinlto-shared-cache-dir=shared a.o b.o -o out4
+; RUN: llvm-readelf -x .rodata out4 | FileCheck %s --check-prefix=BUILT
+
+; BUILT:  AAAA
+; SHARED: BBBB
+
+; RUN: not ld.lld -shared --thinlto-shared-cache-dir=shared a.o b.o \
+; RUN:   -o /dev/null 2>&1 | FileCheck %s --check-prefix=ERR
+; ERR: error: --thinlto-shared-cache-dir= requires --thinlto-cache-dir=
+
+;--- a.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+@marker = constant [4 x i8] c"AAAA"
+
+define void @f() {
+  call void @g()
+  ret void
+}
+
+declare void @g()
+
+;--- b.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @g() {
+  ret void
+}
+
+;--- patch.py
+import os
+import sys
+
+for name in os.listdir(sys.argv[1]):
+    path = os.path.join(sys.argv[1], name)
+    with open(path, 'rb') as f:
+        data = f.read()
+    with open(path, 'wb') as f:
+        f.write(data.replace(b'AAAA', b'BBBB'))
@@ -0,0 +1,42 @@
+# REQUIRES: x86
+## --release-output-pages gives back the memory of output sections once they
+## have been written. The contents stay in the file, so the output, including
+## .eh_frame_hdr and the build ID that read back earlier sections, must not
+## change.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld %t.o --eh-frame-hdr --build-id=sha1 -o %t1
+# RUN: ld.lld %t.o --eh-frame-hdr --build-id=sha1 --release-output-pages -o %t2
+# RUN: cmp %t1 %t2
+# RUN: ld.lld %t.o --eh-frame-hdr --build-id=fast --no-mmap-output-file \
+# RUN:   --release-output-pages -o %t3
+# RUN: ld.lld %t.o --eh-frame-hdr --build-id=fast -o %t4
+# RUN: cmp %t3 %t4
+# RUN: ld.lld %t.o --eh-frame-hdr --release-output-pages \
+# RUN:   --no-release-output-pages -o %t5
+# RUN: ld.lld %t.o --eh-frame-hdr -o %t6
+# RUN: cmp %t5 %t6
+
+# RUN: llvm-readelf -x .data -n %t2 | FileCheck %s
+# CHECK:      Hex dump of section '.data':
+# CHECK-NEXT: 0x{{[0-9a-f]+}} 01000000 00000000
+# CHECK:      Build ID: {{[0-9a-f]+$}}
+
+.globl _start
+_start:
+  .cfi_startproc
+  call foo
+  ret
+  .cfi_endproc
+
+foo:
+  .cfi_startproc
+  ret
+  .cfi_endproc
+
+## Make the output span several pages.
+.section .text.big,"ax",@progbits
+.fill 0x3000, 1, 0xcc
+
+.data
+.quad 1
@@ -86,10 +86,14 @@ void CodeSection::finalizeContents() {
   os.flush();
   bodySize = codeSectionHeader.size();
 
+  // With --compress-relocations, sizing a function means computing all of its
+  // relocated values, so do that in parallel before assigning the offsets.
+  parallelForEach(functions,
+                  [](InputFunction *func) { func->calculateSize(); });
+
   for (InputFunction *func : functions) {
     func->outputSec = this;
     func->outSecOff = bodySize;
-    func->calculateSize();
     // All functions should have a non-empty body at this point
     assert(func->getSize());
     bodySize += func->getSize();
@@ -112,9 +116,10 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Their offsets were fixed by finalizeContents,
+  // so they can be copied and relocated in parallel.
+  parallelForEach(functions,
+                  [&](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -200,9 +205,9 @@ void DataSection::writeTo(uint8_t *buf) {
   // Write data section headers
   memcpy(buf, dataSectionHeader.data(), dataSectionHeader.size());
 
-  for (const OutputSegment *segment : segments) {
+  parallelForEach(segments, [&](const OutputSegment *segment) {
     if (segment->isBss)
-      continue;
+      return;
     // Write data segment header
     uint8_t *segStart = buf + segment->sectionOffset;
     memcpy(segStart, segment->header.data(), segment->header.size());
@@ -210,7 +215,7 @@ void DataSection::writeTo(uint8_t *buf) {
     // Write segment data payload
     for (const InputChunk *chunk : segment->inputSegments)
       chunk->writeTo(buf);
-  }
+  });
 }
 
 uint32_t DataSection::getNumRelocations() const {
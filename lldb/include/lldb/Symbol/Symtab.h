@@ -215,10 +215,22 @@ private:
   void SymbolIndicesToSymbolContextList(std::vector<uint32_t> &symbol_indexes,
                                         SymbolContextList &sc_list);
 
+  /// The parts of a demangled function name that InitNameIndexes() needs.
+  struct DemangledNameInfo {
+    ConstString base_name;
+    ConstString decl_context;
+    bool is_ctor_or_dtor = false;
+  };
+
+  /// Demangle the names of all code symbols, in parallel for large symbol
+  /// tables. Returns one entry per symbol; the entry has an empty base name
+  /// if the symbol should not be registered as a function.
+  std::vector<DemangledNameInfo> DemangleFunctionNames();
+
   void RegisterMangledNameEntry(
-      uint32_t value, std::set<const char *> &class_contexts,
-      std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-      RichManglingContext &rmc);
+      uint32_t value, const DemangledNameInfo &info,
+      std::set<const char *> &class_contexts,
+      std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog);
 
   void RegisterBacklogEntry(const NameToIndexMap::Entry &entry,
                             const char *decl_context,
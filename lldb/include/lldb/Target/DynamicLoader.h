@@ -271,6 +271,14 @@ protected:
                                     lldb::addr_t base_addr,
                                     bool base_addr_is_offset);
 
+  /// Gets the modules of \p files from the shared module cache and preloads
+  /// their symbols on a thread pool of target.module-load-threads threads, so
+  /// that loading them one by one with LoadModuleAtAddress afterwards finds
+  /// them ready. Creating a module holds the shared module list lock, so only
+  /// the symbol preloading runs in parallel. Only done for the host platform,
+  /// where module paths name local files.
+  void PreloadModules(llvm::ArrayRef<lldb_private::FileSpec> files);
+
   // Utility method so base classes can share implementation of
   // UpdateLoadedSections
   void UpdateLoadedSectionsCommon(lldb::ModuleSP module, lldb::addr_t base_addr,
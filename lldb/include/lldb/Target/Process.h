@@ -1453,6 +1453,29 @@ public:
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  /// Read several independent ranges of memory from a process.
+  ///
+  /// Like ReadMemoryFromInferior, this bypasses caching and removes any traps
+  /// that may have been inserted into the memory. Subclasses that can read
+  /// several ranges with a single request to the target should override
+  /// DoReadMemoryRanges.
+  ///
+  /// \param[in] ranges
+  ///     The ranges of virtual load addresses to read.
+  ///
+  /// \param[out] buffer
+  ///     A byte buffer that is at least as large as the sum of the sizes of
+  ///     \p ranges. The bytes for each range are stored consecutively, in
+  ///     the order of \p ranges.
+  ///
+  /// \return
+  ///     One slice of \p buffer per range, holding the bytes that were
+  ///     actually read. A slice is shorter than its range, or empty, if the
+  ///     range could not be read completely.
+  std::vector<llvm::MutableArrayRef<uint8_t>>
+  ReadMemoryRanges(llvm::ArrayRef<Range<lldb::addr_t, size_t>> ranges,
+                   llvm::MutableArrayRef<uint8_t> buffer);
+
   /// Read a NULL terminated string from memory
   ///
   /// This function will read a cache page at a time until a NULL string
@@ -2561,6 +2584,15 @@ protected:
   virtual size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                               Status &error) = 0;
 
+  /// Actually do the reading of several ranges of memory from a process.
+  ///
+  /// The default implementation reads each range in turn with DoReadMemory.
+  /// See ReadMemoryRanges for the meaning of the arguments and the return
+  /// value. Traps are removed by the caller.
+  virtual std::vector<llvm::MutableArrayRef<uint8_t>>
+  DoReadMemoryRanges(llvm::ArrayRef<Range<lldb::addr_t, size_t>> ranges,
+                     llvm::MutableArrayRef<uint8_t> buffer);
+
   void SetState(lldb::EventSP &event_sp);
 
   lldb::StateType GetPrivateState();
@@ -96,6 +96,8 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  uint64_t GetModuleLoadThreads() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -145,6 +147,8 @@ public:
 
   bool GetEnableAutoApplyFixIts() const;
 
+  bool GetCacheParsedExpressions() const;
+
   uint64_t GetNumberOfRetriesWithFixits() const;
 
   bool GetEnableNotifyAboutFixIts() const;
@@ -1071,6 +1075,20 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  /// Removes and returns the parsed user expression stored under \a key by
+  /// CacheUserExpression, or returns an empty pointer if there is none.
+  lldb::UserExpressionSP TakeCachedUserExpression(const std::string &key);
+
+  /// Remember a parsed user expression so that it can be executed again
+  /// without reparsing it. \a key must identify everything that influenced
+  /// how the expression was parsed.
+  void CacheUserExpression(const std::string &key,
+                           lldb::UserExpressionSP expr_sp);
+
+  /// Drop all cached user expressions, e.g. because the declarations visible
+  /// to them may have changed.
+  void ClearUserExpressionCache();
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1425,6 +1443,8 @@ protected:
   bool m_suppress_stop_hooks;
   bool m_is_dummy_target;
   unsigned m_next_persistent_variable_index = 0;
+  std::mutex m_user_expression_cache_mutex;
+  std::map<std::string, lldb::UserExpressionSP> m_user_expression_cache;
   /// An optional \a lldb_private::Trace object containing processor trace
   /// information of this target.
   lldb::TraceSP m_trace_sp;
@@ -112,6 +112,7 @@ public:
     eServerPacketType_qGDBServerVersion,
     eServerPacketType_qMemoryRegionInfo,
     eServerPacketType_qMemoryRegionInfoSupported,
+    eServerPacketType_qMultiMemRead,
     eServerPacketType_qProcessInfo,
     eServerPacketType_qRcmd,
     eServerPacketType_qRegisterInfo,
@@ -15,12 +15,14 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/lldb-private-interfaces.h"
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 
@@ -147,6 +149,34 @@ DynamicLoader::GetSectionListFromModule(const ModuleSP module) const {
   return sections;
 }
 
+void DynamicLoader::PreloadModules(llvm::ArrayRef<FileSpec> files) {
+  Target &target = m_process->GetTarget();
+  const uint64_t num_threads = target.GetModuleLoadThreads();
+  PlatformSP platform_sp = target.GetPlatform();
+  if (num_threads == 1 || files.size() < 2 || !platform_sp ||
+      !platform_sp->IsHost())
+    return;
+
+  const ArchSpec &arch = target.GetArchitecture();
+  const FileSpecList search_paths = target.GetExecutableSearchPaths();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  auto preload_fn = [&](const FileSpec &file) {
+    ModuleSpec module_spec(file, arch);
+    if (target.GetImages().FindFirstModule(module_spec))
+      return;
+    ModuleSP module_sp;
+    platform_sp->GetSharedModule(module_spec, m_process, module_sp,
+                                 &search_paths, nullptr, nullptr);
+    if (module_sp && preload_symbols)
+      module_sp->PreloadSymbols();
+  };
+
+  llvm::ThreadPool pool(llvm::hardware_concurrency(num_threads));
+  for (const FileSpec &file : files)
+    pool.async([&preload_fn, &file] { preload_fn(file); });
+  pool.wait();
+}
+
 ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
                                             addr_t link_map_addr,
                                             addr_t base_addr,
@@ -38,11 +38,13 @@
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadPlan.h"
 #include "lldb/Target/ThreadPlanCallUserExpression.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace lldb_private;
 
@@ -139,6 +141,53 @@ lldb::addr_t UserExpression::GetObjectPointer(lldb::StackFrameSP frame_sp,
   return ret;
 }
 
+/// Returns the key under which a parsed user expression is cached by the
+/// target, or an empty string if the expression shouldn't be cached.
+static std::string GetUserExpressionCacheKey(
+    ExecutionContext &exe_ctx, const EvaluateExpressionOptions &options,
+    llvm::StringRef expr, llvm::StringRef prefix, lldb::LanguageType language,
+    UserExpression::ResultType desired_type, ExecutionPolicy execution_policy,
+    ValueObject *ctx_obj) {
+  Target *target = exe_ctx.GetTargetPtr();
+  if (!target->GetCacheParsedExpressions() || ctx_obj ||
+      execution_policy == eExecutionPolicyTopLevel ||
+      options.GetPoundLineFilePath())
+    return std::string();
+
+  // Persistent variables can be declared, redeclared and change type between
+  // evaluations, so don't try to cache expressions that might use them.
+  if (expr.contains('$') || prefix.contains('$'))
+    return std::string();
+
+  // The scope of the frame determines which local variables the expression
+  // refers to. An expression is only reused in the frame and thread it was
+  // parsed in, as they determine where the variables are and how to call
+  // functions.
+  const void *scope = nullptr;
+  lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+  lldb::addr_t cfa = LLDB_INVALID_ADDRESS;
+  if (StackFrame *frame = exe_ctx.GetFramePtr()) {
+    const SymbolContext &sc = frame->GetSymbolContext(
+        eSymbolContextFunction | eSymbolContextBlock | eSymbolContextSymbol);
+    if (sc.block)
+      scope = sc.block;
+    else if (sc.function)
+      scope = sc.function;
+    else
+      scope = sc.symbol;
+    cfa = frame->GetStackID().GetCallFrameAddress();
+  }
+  if (Thread *thread = exe_ctx.GetThreadPtr())
+    tid = thread->GetID();
+
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  os << language << ',' << desired_type << ',' << execution_policy << ','
+     << options.GetGenerateDebugInfo() << ',' << scope << ',' << tid << ','
+     << cfa << ',' << prefix.size() << ':' << prefix << expr;
+  return os.str();
+}
+
 lldb::ExpressionResults
 UserExpression::Evaluate(ExecutionContext &exe_ctx,
                          const EvaluateExpressionOptions &options,
@@ -224,18 +273,33 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
+  // Parsing is usually the most expensive part of evaluating an expression,
+  // so reuse the expression from an earlier evaluation in the same scope.
+  std::string cache_key = GetUserExpressionCacheKey(
+      exe_ctx, options, expr, full_prefix, language, desired_type,
+      execution_policy, ctx_obj);
+  lldb::UserExpressionSP user_expression_sp;
+  if (!cache_key.empty()) {
+    // Take the expression out of the cache while it runs, so that a nested
+    // evaluation of the same expression doesn't try to materialize it twice.
+    user_expression_sp = target->TakeCachedUserExpression(cache_key);
+    if (user_expression_sp && !user_expression_sp->MatchesContext(exe_ctx))
+      user_expression_sp.reset();
+  }
+  const bool reused_expression = bool(user_expression_sp);
+
+  if (!reused_expression) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail()) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
   }
 
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
+  LLDB_LOG(log, "== [UserExpression::Evaluate] {0} expression {1} ==",
+           reused_expression ? "Reusing parsed" : "Parsing", expr.str());
 
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
@@ -250,6 +314,7 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      reused_expression ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -267,6 +332,8 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
     // Delete the expression that failed to parse before attempting to parse
     // the next expression.
     user_expression_sp.reset();
+    // Don't cache a fixed expression under the text the user wrote.
+    cache_key.clear();
 
     execution_results = lldb::eExpressionParseError;
     if (fixed_expression && !fixed_expression->empty() &&
@@ -330,6 +397,8 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
         error.SetExpressionError(lldb::eExpressionSetupError,
                                  "expression needed to run but couldn't");
     } else if (execution_policy == eExecutionPolicyTopLevel) {
+      // The new declarations may change the meaning of cached expressions.
+      target->ClearUserExpressionCache();
       error.SetError(UserExpression::kNoResult, lldb::eErrorTypeGeneric);
       return lldb::eExpressionCompleted;
     } else {
@@ -350,6 +419,12 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
           user_expression_sp->Execute(diagnostic_manager, exe_ctx, options,
                                       user_expression_sp, expr_result);
 
+      // Only cache expressions that ran to completion. An expression that
+      // stopped part way through is still materialized and can't be run
+      // again until it is cleaned up.
+      if (!cache_key.empty() && execution_results == lldb::eExpressionCompleted)
+        target->CacheUserExpression(cache_key, user_expression_sp);
+
       if (execution_results != lldb::eExpressionCompleted) {
         LLDB_LOG(log, "== [UserExpression::Evaluate] Execution completed "
                       "abnormally ==");
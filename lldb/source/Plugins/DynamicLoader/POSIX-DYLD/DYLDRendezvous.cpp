@@ -367,18 +367,15 @@ bool DYLDRendezvous::RemoveSOEntriesFromRemote(
 }
 
 bool DYLDRendezvous::AddSOEntries() {
-  SOEntry entry;
+  SOEntryList entry_list;
   iterator pos;
 
   assert(m_previous.state == eAdd);
 
-  if (m_current.map_addr == 0)
+  if (!ReadSOEntriesFromMemory(entry_list))
     return false;
 
-  for (addr_t cursor = m_current.map_addr; cursor != 0; cursor = entry.next) {
-    if (!ReadSOEntryFromMemory(cursor, entry))
-      return false;
-
+  for (const SOEntry &entry : entry_list) {
     // Only add shared libraries and not the executable.
     if (SOEntryIsMainExecutable(entry))
       continue;
@@ -431,6 +428,18 @@ bool DYLDRendezvous::SOEntryIsMainExecutable(const SOEntry &entry) {
 }
 
 bool DYLDRendezvous::TakeSnapshot(SOEntryList &entry_list) {
+  if (!ReadSOEntriesFromMemory(entry_list))
+    return false;
+
+  // Only add shared libraries and not the executable.
+  llvm::erase_if(entry_list, [this](const SOEntry &entry) {
+    return SOEntryIsMainExecutable(entry);
+  });
+
+  return true;
+}
+
+bool DYLDRendezvous::ReadSOEntriesFromMemory(SOEntryList &entry_list) {
   SOEntry entry;
 
   if (m_current.map_addr == 0)
@@ -442,14 +451,36 @@ bool DYLDRendezvous::TakeSnapshot(SOEntryList &entry_list) {
   for (addr_t cursor = m_current.map_addr; cursor != 0; cursor = entry.next) {
     if (!ReadSOEntryFromMemory(cursor, entry))
       return false;
-
-    // Only add shared libraries and not the executable.
-    if (SOEntryIsMainExecutable(entry))
-      continue;
-
     entry_list.push_back(entry);
   }
 
+  // Each entry needs its own read of the link map, but the paths are
+  // independent of each other. Read the start of all of them at once and
+  // only read a path on its own if it is longer than that.
+  const size_t path_prefix_size = 256;
+  std::vector<Range<addr_t, size_t>> ranges;
+  ranges.reserve(entry_list.size());
+  for (const SOEntry &entry : entry_list)
+    ranges.emplace_back(entry.path_addr, entry.path_addr == LLDB_INVALID_ADDRESS
+                                             ? 0
+                                             : path_prefix_size);
+  std::vector<uint8_t> buffer(ranges.size() * path_prefix_size);
+  std::vector<llvm::MutableArrayRef<uint8_t>> prefixes =
+      m_process->ReadMemoryRanges(ranges, buffer);
+
+  for (size_t i = 0; i < entry_list.size(); ++i) {
+    SOEntry &entry = entry_list[i];
+    llvm::StringRef prefix(reinterpret_cast<const char *>(prefixes[i].data()),
+                           prefixes[i].size());
+    size_t length = prefix.find('\0');
+    std::string file_path = length != llvm::StringRef::npos
+                                ? prefix.take_front(length).str()
+                                : ReadStringFromMemory(entry.path_addr);
+    entry.file_spec.SetFile(file_path, FileSpec::Style::native);
+
+    UpdateBaseAddrIfNecessary(entry, file_path);
+  }
+
   return true;
 }
 
@@ -546,11 +577,6 @@ bool DYLDRendezvous::ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry) {
   if (!(addr = ReadPointer(addr, &entry.prev)))
     return false;
 
-  std::string file_path = ReadStringFromMemory(entry.path_addr);
-  entry.file_spec.SetFile(file_path, FileSpec::Style::native);
-
-  UpdateBaseAddrIfNecessary(entry, file_path);
-
   return true;
 }
 
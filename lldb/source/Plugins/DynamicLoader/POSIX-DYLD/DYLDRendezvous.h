@@ -220,9 +220,13 @@ protected:
   /// addr.
   std::string ReadStringFromMemory(lldb::addr_t addr);
 
-  /// Reads an SOEntry starting at \p addr.
+  /// Reads an SOEntry starting at \p addr, without its path.
   bool ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry);
 
+  /// Reads all entries of the link map, including the executable, and their
+  /// paths.
+  bool ReadSOEntriesFromMemory(SOEntryList &entry_list);
+
   /// Updates the current set of SOEntries, the set of added entries, and the
   /// set of removed entries.
   bool UpdateSOEntries();
@@ -88,6 +88,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_qMultiMemRead(eLazyBoolCalculate),
       m_supports_error_string_reply(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
@@ -157,6 +158,13 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetMultiMemReadSupported() {
+  if (m_supports_qMultiMemRead == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_qMultiMemRead == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -433,6 +441,11 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "qMultiMemRead+"))
+      m_supports_qMultiMemRead = eLazyBoolYes;
+    else
+      m_supports_qMultiMemRead = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -3648,6 +3661,42 @@ llvm::Optional<QOffsets> GDBRemoteCommunicationClient::GetQOffsets() {
   return llvm::None;
 }
 
+std::vector<size_t> GDBRemoteCommunicationClient::ReadMemoryRanges(
+    llvm::ArrayRef<std::pair<addr_t, llvm::MutableArrayRef<uint8_t>>> reads) {
+  StreamString packet;
+  packet.PutCString("qMultiMemRead:ranges:");
+  for (size_t i = 0; i < reads.size(); ++i)
+    packet.Printf("%s%" PRIx64 ",%" PRIx64, i == 0 ? "" : ",",
+                  (uint64_t)reads[i].first, (uint64_t)reads[i].second.size());
+  packet.PutChar(';');
+
+  std::vector<size_t> bytes_read(reads.size(), 0);
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response,
+                                   /*send_async=*/true) !=
+          PacketResult::Success ||
+      !response.IsNormalResponse())
+    return bytes_read;
+
+  // The reply is "<bytes read>[,<bytes read>]*;" followed by the bytes of all
+  // ranges, in order.
+  llvm::StringRef lengths, data;
+  std::tie(lengths, data) = response.GetStringRef().split(';');
+  for (size_t i = 0; i < reads.size(); ++i) {
+    llvm::StringRef length;
+    std::tie(length, lengths) = lengths.split(',');
+    size_t size;
+    // Don't trust the rest of a malformed reply.
+    if (length.getAsInteger(16, size) || size > reads[i].second.size() ||
+        size > data.size())
+      break;
+    memcpy(reads[i].second.data(), data.data(), size);
+    data = data.drop_front(size);
+    bytes_read[i] = size;
+  }
+  return bytes_read;
+}
+
 bool GDBRemoteCommunicationClient::GetModuleInfo(
     const FileSpec &module_file_spec, const lldb_private::ArchSpec &arch_spec,
     ModuleSpec &module_spec) {
@@ -352,6 +352,8 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  bool GetMultiMemReadSupported();
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -451,6 +453,15 @@ public:
   /// one value in the offsets field.
   llvm::Optional<QOffsets> GetQOffsets();
 
+  /// Use qMultiMemRead to read several ranges of memory with a single packet.
+  /// Each element of \p reads is the address to read from and the buffer to
+  /// read into, whose size is the number of bytes to read. Returns the number
+  /// of bytes read for each element, which is zero for all of them if the
+  /// packet fails.
+  std::vector<size_t> ReadMemoryRanges(
+      llvm::ArrayRef<std::pair<lldb::addr_t, llvm::MutableArrayRef<uint8_t>>>
+          reads);
+
   bool GetModuleInfo(const FileSpec &module_file_spec,
                      const ArchSpec &arch_spec, ModuleSpec &module_spec);
 
@@ -557,6 +568,7 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_qMultiMemRead;
   LazyBool m_supports_error_string_reply;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
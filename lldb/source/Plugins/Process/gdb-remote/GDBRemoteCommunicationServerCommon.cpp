@@ -33,8 +33,10 @@
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/StructuredData.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/JSON.h"
 
 #include "ProcessGDBRemoteLog.h"
@@ -832,24 +834,30 @@ GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerCommon::Handle_qSupported(
     StringExtractorGDBRemote &packet) {
   StreamGDBRemote response;
+  response.PutCString(llvm::join(GetSupportedFeatures(), ";"));
+  return SendPacketNoLock(response.GetString());
+}
 
+std::vector<std::string>
+GDBRemoteCommunicationServerCommon::GetSupportedFeatures() {
   // Features common to lldb-platform and llgs.
   uint32_t max_packet_size = 128 * 1024; // 128KBytes is a reasonable max packet
                                          // size--debugger can always use less
-  response.Printf("PacketSize=%x", max_packet_size);
-
-  response.PutCString(";QStartNoAckMode+");
-  response.PutCString(";QThreadSuffixSupported+");
-  response.PutCString(";QListThreadsInStopReply+");
-  response.PutCString(";qEcho+");
-  response.PutCString(";qXfer:features:read+");
+  std::vector<std::string> features = {
+      llvm::formatv("PacketSize={0:x}", max_packet_size).str(),
+      "QStartNoAckMode+",
+      "QThreadSuffixSupported+",
+      "QListThreadsInStopReply+",
+      "qEcho+",
+      "qXfer:features:read+",
+  };
 #if defined(__linux__) || defined(__NetBSD__) || defined(__FreeBSD__)
-  response.PutCString(";QPassSignals+");
-  response.PutCString(";qXfer:auxv:read+");
-  response.PutCString(";qXfer:libraries-svr4:read+");
+  features.push_back("QPassSignals+");
+  features.push_back("qXfer:auxv:read+");
+  features.push_back("qXfer:libraries-svr4:read+");
 #endif
 
-  return SendPacketNoLock(response.GetString());
+  return features;
 }
 
 GDBRemoteCommunication::PacketResult
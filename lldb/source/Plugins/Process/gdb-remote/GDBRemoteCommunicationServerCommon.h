@@ -10,6 +10,7 @@
 #define LLDB_SOURCE_PLUGINS_PROCESS_GDB_REMOTE_GDBREMOTECOMMUNICATIONSERVERCOMMON_H
 
 #include <string>
+#include <vector>
 
 #include "lldb/Host/ProcessLaunchInfo.h"
 #include "lldb/lldb-private-forward.h"
@@ -145,6 +146,10 @@ protected:
   virtual FileSpec FindModuleFile(const std::string &module_path,
                                   const ArchSpec &arch);
 
+  /// The features to report in the qSupported reply. Servers that handle
+  /// further packets add them to the list.
+  virtual std::vector<std::string> GetSupportedFeatures();
+
 private:
   ModuleSpec GetModuleInfo(llvm::StringRef module_path, llvm::StringRef triple);
 };
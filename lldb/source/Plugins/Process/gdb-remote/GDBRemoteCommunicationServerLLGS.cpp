@@ -91,6 +91,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_m,
       &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_qMultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_qMultiMemRead);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                 &GDBRemoteCommunicationServerLLGS::Handle_M);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__M,
@@ -2399,6 +2402,66 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qMultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // The packet is "qMultiMemRead:ranges:<addr>,<size>[,<addr>,<size>]*;".
+  llvm::StringRef ranges = packet.GetStringRef();
+  if (!ranges.consume_front("qMultiMemRead:ranges:") ||
+      !ranges.consume_back(";"))
+    return SendIllFormedResponse(packet, "Invalid qMultiMemRead packet");
+
+  llvm::SmallVector<llvm::StringRef, 16> fields;
+  ranges.split(fields, ',');
+  if (fields.size() % 2 != 0)
+    return SendIllFormedResponse(packet, "Odd number of qMultiMemRead fields");
+
+  // The reply is "<bytes read>[,<bytes read>]*;" followed by the escaped
+  // bytes of all ranges, in order. A range that can't be read reports zero
+  // bytes instead of failing the whole packet.
+  StreamGDBRemote response;
+  std::string data;
+  for (size_t i = 0; i < fields.size(); i += 2) {
+    lldb::addr_t read_addr;
+    uint64_t byte_count;
+    if (fields[i].getAsInteger(16, read_addr) ||
+        fields[i + 1].getAsInteger(16, byte_count))
+      return SendIllFormedResponse(packet, "Invalid qMultiMemRead range");
+
+    size_t bytes_read = 0;
+    if (byte_count > 0) {
+      const size_t offset = data.size();
+      data.resize(offset + byte_count);
+      Status error = m_debugged_process_up->ReadMemoryWithoutTrap(
+          read_addr, &data[offset], byte_count, bytes_read);
+      if (error.Fail()) {
+        LLDB_LOGF(log,
+                  "GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64
+                  " mem 0x%" PRIx64 ": failed to read. Error: %s",
+                  __FUNCTION__, m_debugged_process_up->GetID(), read_addr,
+                  error.AsCString());
+        bytes_read = 0;
+      }
+      data.resize(offset + bytes_read);
+    }
+    response.Printf(i == 0 ? "%" PRIx64 : ",%" PRIx64, (uint64_t)bytes_read);
+  }
+  response.PutChar(';');
+  response.PutEscapedBytes(data.data(), data.size());
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle__M(StringExtractorGDBRemote &packet) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
@@ -3629,6 +3692,14 @@ GDBRemoteCommunicationServerLLGS::FindModuleFile(const std::string &module_path,
   return GDBRemoteCommunicationServerCommon::FindModuleFile(module_path, arch);
 }
 
+std::vector<std::string>
+GDBRemoteCommunicationServerLLGS::GetSupportedFeatures() {
+  std::vector<std::string> features =
+      GDBRemoteCommunicationServerCommon::GetSupportedFeatures();
+  features.push_back("qMultiMemRead+");
+  return features;
+}
+
 std::string GDBRemoteCommunicationServerLLGS::XMLEncodeAttributeValue(
     llvm::StringRef value) {
   std::string result;
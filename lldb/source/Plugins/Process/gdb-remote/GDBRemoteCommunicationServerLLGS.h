@@ -148,6 +148,8 @@ protected:
   // Handles $m and $x packets.
   PacketResult Handle_memory_read(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_qMultiMemRead(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_M(StringExtractorGDBRemote &packet);
   PacketResult Handle__M(StringExtractorGDBRemote &packet);
   PacketResult Handle__m(StringExtractorGDBRemote &packet);
@@ -214,6 +216,8 @@ protected:
   FileSpec FindModuleFile(const std::string &module_path,
                           const ArchSpec &arch) override;
 
+  std::vector<std::string> GetSupportedFeatures() override;
+
   llvm::Expected<std::unique_ptr<llvm::MemoryBuffer>>
   ReadXferObject(llvm::StringRef object, llvm::StringRef annex);
 
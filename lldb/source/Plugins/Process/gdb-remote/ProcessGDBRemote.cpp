@@ -2766,6 +2766,44 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   return 0;
 }
 
+std::vector<llvm::MutableArrayRef<uint8_t>>
+ProcessGDBRemote::DoReadMemoryRanges(
+    llvm::ArrayRef<Range<addr_t, size_t>> ranges,
+    llvm::MutableArrayRef<uint8_t> buffer) {
+  if (!m_gdb_comm.GetMultiMemReadSupported())
+    return Process::DoReadMemoryRanges(ranges, buffer);
+
+  GetMaxMemorySize();
+  std::vector<llvm::MutableArrayRef<uint8_t>> results;
+  results.reserve(ranges.size());
+  size_t offset = 0;
+  size_t begin = 0;
+  while (begin < ranges.size()) {
+    // Send as many ranges in one packet as fit in a single memory read reply.
+    // Ranges that don't fit by themselves are truncated, like in DoReadMemory.
+    std::vector<std::pair<addr_t, llvm::MutableArrayRef<uint8_t>>> reads;
+    size_t batch_size = 0;
+    size_t end = begin;
+    for (; end < ranges.size(); ++end) {
+      size_t size = ranges[end].GetByteSize();
+      if (end != begin && batch_size + size > m_max_memory_size)
+        break;
+      reads.emplace_back(ranges[end].GetRangeBase(),
+                         llvm::MutableArrayRef<uint8_t>(
+                             buffer.data() + offset,
+                             std::min<size_t>(size, m_max_memory_size)));
+      offset += size;
+      batch_size += reads.back().second.size();
+    }
+
+    std::vector<size_t> bytes_read = m_gdb_comm.ReadMemoryRanges(reads);
+    for (size_t i = 0; i < reads.size(); ++i)
+      results.push_back(reads[i].second.take_front(bytes_read[i]));
+    begin = end;
+  }
+  return results;
+}
+
 Status ProcessGDBRemote::WriteObjectFile(
     std::vector<ObjectFile::LoadableData> entries) {
   Status error;
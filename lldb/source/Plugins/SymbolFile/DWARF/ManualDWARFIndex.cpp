@@ -13,14 +13,71 @@
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace lldb_private;
 using namespace lldb;
 
+namespace {
+/// Identifies the index cache file for a module and the modification time
+/// the cached index was built from.
+struct IndexCacheKey {
+  std::string path;
+  uint64_t mod_time;
+};
+} // namespace
+
+static constexpr llvm::StringLiteral g_index_cache_magic = "LLDBNIDX";
+static constexpr uint32_t g_index_cache_version = 1;
+
+static llvm::Optional<IndexCacheKey>
+GetIndexCacheKey(Module &module, SymbolFileDWARF &dwarf) {
+  const ModuleListProperties &props =
+      ModuleList::GetGlobalModuleListProperties();
+  if (!props.GetEnableLLDBIndexCache())
+    return llvm::None;
+  FileSpec cache_dir = props.GetLLDBIndexCachePath();
+  ObjectFile *objfile = dwarf.GetObjectFile();
+  if (!cache_dir || !objfile)
+    return llvm::None;
+
+  // Modules read from memory have no file to key or date the cache by.
+  const FileSpec &file = objfile->GetFileSpec();
+  if (!file)
+    return llvm::None;
+
+  // Key the file by the module's UUID and path so that different binaries
+  // never share a cache file. The modification time is checked on load so a
+  // rebuilt binary without a UUID is re-indexed.
+  std::string file_path = file.GetPath();
+  llvm::hash_code hash = llvm::hash_combine(
+      file_path, module.GetObjectName().GetStringRef());
+  std::string name = file.GetFilename().GetStringRef().str();
+  const UUID &uuid = module.GetUUID();
+  if (uuid.IsValid())
+    name += "-" + uuid.GetAsString("");
+  name += "-" + llvm::utohexstr(static_cast<size_t>(hash)) + ".dwarf-index";
+
+  llvm::SmallString<256> path(cache_dir.GetPath());
+  llvm::sys::path::append(path, name);
+  auto mod_time = FileSystem::Instance().GetModificationTime(file_path);
+  return IndexCacheKey{
+      std::string(path),
+      static_cast<uint64_t>(mod_time.time_since_epoch().count())};
+}
+
 void ManualDWARFIndex::Index() {
   if (!m_dwarf)
     return;
@@ -30,6 +87,9 @@ void ManualDWARFIndex::Index() {
 
   LLDB_SCOPED_TIMERF("%p", static_cast<void *>(&main_dwarf));
 
+  if (LoadFromCache(main_dwarf))
+    return;
+
   DWARFDebugInfo &main_info = main_dwarf.DebugInfo();
   SymbolFileDWARFDwo *dwp_dwarf = main_dwarf.GetDwpSymbolFile().get();
   DWARFDebugInfo *dwp_info = dwp_dwarf ? &dwp_dwarf->DebugInfo() : nullptr;
@@ -108,6 +168,82 @@ void ManualDWARFIndex::Index() {
   pool.async(finalize_fn, &IndexSet::types);
   pool.async(finalize_fn, &IndexSet::namespaces);
   pool.wait();
+
+  SaveToCache(main_dwarf);
+}
+
+std::vector<NameToDIE *> ManualDWARFIndex::GetIndexesForCache() {
+  return {&m_set.function_basenames, &m_set.function_fullnames,
+          &m_set.function_methods, &m_set.function_selectors,
+          &m_set.objc_class_selectors, &m_set.globals,
+          &m_set.types, &m_set.namespaces};
+}
+
+bool ManualDWARFIndex::LoadFromCache(SymbolFileDWARF &dwarf) {
+  // The cached index doesn't record which units were skipped.
+  if (!m_units_to_avoid.empty())
+    return false;
+  llvm::Optional<IndexCacheKey> key = GetIndexCacheKey(m_module, dwarf);
+  if (!key)
+    return false;
+  auto buffer_or_err = llvm::MemoryBuffer::getFile(
+      key->path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (!buffer_or_err)
+    return false;
+
+  llvm::DataExtractor data((*buffer_or_err)->getBuffer(),
+                           /*IsLittleEndian=*/true, /*AddressSize=*/8);
+  llvm::DataExtractor::Cursor cursor(0);
+  bool success = data.getBytes(cursor, g_index_cache_magic.size()) ==
+                     g_index_cache_magic &&
+                 data.getU32(cursor) == g_index_cache_version &&
+                 data.getU64(cursor) == key->mod_time;
+  for (NameToDIE *index : GetIndexesForCache()) {
+    if (!success)
+      break;
+    success = index->Decode(data, cursor);
+  }
+  llvm::consumeError(cursor.takeError());
+  if (!success) {
+    m_set = IndexSet();
+    return false;
+  }
+  return true;
+}
+
+void ManualDWARFIndex::SaveToCache(SymbolFileDWARF &dwarf) {
+  if (!m_units_to_avoid.empty())
+    return;
+  llvm::Optional<IndexCacheKey> key = GetIndexCacheKey(m_module, dwarf);
+  if (!key)
+    return;
+  if (llvm::sys::fs::create_directories(
+          llvm::sys::path::parent_path(key->path)))
+    return;
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // sessions never see a partially written index.
+  int fd;
+  llvm::SmallString<256> temp_path;
+  if (llvm::sys::fs::createUniqueFile(key->path + "-%%%%%%%%", fd, temp_path))
+    return;
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    llvm::support::endian::Writer writer(os, llvm::support::little);
+    os << g_index_cache_magic;
+    writer.write<uint32_t>(g_index_cache_version);
+    writer.write<uint64_t>(key->mod_time);
+    for (NameToDIE *index : GetIndexesForCache())
+      index->Encode(os);
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(temp_path, key->path))
+    llvm::sys::fs::remove(temp_path);
 }
 
 void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp,
@@ -73,6 +73,16 @@ private:
                             const lldb::LanguageType cu_language,
                             IndexSet &set);
 
+  /// The name indexes in m_set, in the order they are stored in the index
+  /// cache.
+  std::vector<NameToDIE *> GetIndexesForCache();
+
+  /// Load m_set from the on-disk index cache, if enabled and up to date.
+  bool LoadFromCache(SymbolFileDWARF &dwarf);
+
+  /// Save m_set to the on-disk index cache, if enabled.
+  void SaveToCache(SymbolFileDWARF &dwarf);
+
   /// The DWARF file which we are indexing. Set to nullptr after the index is
   /// built.
   SymbolFileDWARF *m_dwarf;
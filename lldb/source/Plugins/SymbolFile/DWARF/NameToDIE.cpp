@@ -13,6 +13,7 @@
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StreamString.h"
+#include "llvm/Support/EndianStream.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -86,3 +87,47 @@ void NameToDIE::Append(const NameToDIE &other) {
                  other.m_map.GetValueAtIndexUnchecked(i));
   }
 }
+
+void NameToDIE::Encode(llvm::raw_ostream &os) const {
+  llvm::support::endian::Writer writer(os, llvm::support::little);
+  const uint32_t size = m_map.GetSize();
+  writer.write<uint32_t>(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    os << m_map.GetCStringAtIndexUnchecked(i).GetStringRef() << '\0';
+    const DIERef &die_ref = m_map.GetValueAtIndexUnchecked(i);
+    llvm::Optional<uint32_t> dwo_num = die_ref.dwo_num();
+    writer.write<uint8_t>((dwo_num ? 1 : 0) | (die_ref.section() << 1));
+    writer.write<uint32_t>(dwo_num.getValueOr(0));
+    writer.write<uint32_t>(die_ref.die_offset());
+  }
+}
+
+bool NameToDIE::Decode(const llvm::DataExtractor &data,
+                       llvm::DataExtractor::Cursor &cursor) {
+  m_map.Clear();
+  // Don't reserve based on the encoded size, it may be garbage.
+  const uint32_t size = data.getU32(cursor);
+  for (uint32_t i = 0; i < size && cursor; ++i) {
+    ConstString name(data.getCStrRef(cursor));
+    const uint8_t flags = data.getU8(cursor);
+    const uint32_t dwo_num = data.getU32(cursor);
+    const dw_offset_t die_offset = data.getU32(cursor);
+    // DIERef only has room for 30 bits of dwo number.
+    if (!cursor || flags > 3 || dwo_num >= (1u << 30)) {
+      m_map.Clear();
+      return false;
+    }
+    llvm::Optional<uint32_t> opt_dwo_num;
+    if (flags & 1)
+      opt_dwo_num = dwo_num;
+    m_map.Append(name, DIERef(opt_dwo_num, DIERef::Section(flags >> 1),
+                              die_offset));
+  }
+  if (!cursor) {
+    m_map.Clear();
+    return false;
+  }
+  // The map is sorted by string pool address, which differs between runs.
+  Finalize();
+  return true;
+}
@@ -15,6 +15,7 @@
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/Support/DataExtractor.h"
 
 class DWARFUnit;
 
@@ -42,6 +43,16 @@ public:
   FindAllEntriesForUnit(const DWARFUnit &unit,
                         llvm::function_ref<bool(DIERef ref)> callback) const;
 
+  /// Write the contents of the map to \a os so they can be read back with
+  /// Decode().
+  void Encode(llvm::raw_ostream &os) const;
+
+  /// Replace the contents of the map with entries written by Encode(),
+  /// reading them from \a data at \a cursor. Returns false, leaving the map
+  /// empty, if the data is truncated or malformed.
+  bool Decode(const llvm::DataExtractor &data,
+              llvm::DataExtractor::Cursor &cursor);
+
   void
   ForEach(std::function<bool(lldb_private::ConstString name,
                              const DIERef &die_ref)> const
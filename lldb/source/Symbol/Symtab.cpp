@@ -23,6 +23,7 @@
 #include "lldb/Utility/Timer.h"
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -262,9 +263,9 @@ void Symtab::InitNameIndexes() {
     std::vector<std::pair<NameToIndexMap::Entry, const char *>> backlog;
     backlog.reserve(num_symbols / 2);
 
-    // Instantiation of the demangler is expensive, so better use a single one
-    // for all entries during batch processing.
-    RichManglingContext rmc;
+    // Demangling is by far the most expensive part of building the indexes,
+    // so do it for all symbols up front.
+    std::vector<DemangledNameInfo> demangled_infos = DemangleFunctionNames();
     for (uint32_t value = 0; value < num_symbols; ++value) {
       Symbol *symbol = &m_symbols[value];
 
@@ -289,11 +290,8 @@ void Symtab::InitNameIndexes() {
           m_name_to_index.Append(stripped, value);
         }
 
-        const SymbolType type = symbol->GetType();
-        if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
-          if (mangled.DemangleWithRichManglingInfo(rmc, lldb_skip_name))
-            RegisterMangledNameEntry(value, class_contexts, backlog, rmc);
-        }
+        RegisterMangledNameEntry(value, demangled_infos[value], class_contexts,
+                                 backlog);
       }
 
       // Symbol name strings that didn't match a Mangled::ManglingScheme, are
@@ -337,24 +335,68 @@ void Symtab::InitNameIndexes() {
   }
 }
 
+std::vector<Symtab::DemangledNameInfo> Symtab::DemangleFunctionNames() {
+  const size_t num_symbols = m_symbols.size();
+  std::vector<DemangledNameInfo> infos(num_symbols);
+
+  auto demangle_fn = [this, &infos](size_t begin, size_t end) {
+    // Instantiation of the demangler is expensive, so better use a single one
+    // for all entries in the range.
+    RichManglingContext rmc;
+    for (size_t i = begin; i < end; ++i) {
+      Symbol &symbol = m_symbols[i];
+      if (symbol.IsTrampoline())
+        continue;
+      const SymbolType type = symbol.GetType();
+      if (type != eSymbolTypeCode && type != eSymbolTypeResolver)
+        continue;
+      Mangled &mangled = symbol.GetMangled();
+      if (!mangled.GetMangledName() ||
+          !mangled.DemangleWithRichManglingInfo(rmc, lldb_skip_name))
+        continue;
+
+      // Only register functions that have a base name.
+      rmc.ParseFunctionBaseName();
+      llvm::StringRef base_name = rmc.GetBufferRef();
+      if (base_name.empty())
+        continue;
+
+      DemangledNameInfo &info = infos[i];
+      info.base_name = ConstString(base_name);
+      rmc.ParseFunctionDeclContextName();
+      info.decl_context = ConstString(rmc.GetBufferRef());
+      info.is_ctor_or_dtor = rmc.IsCtorOrDtor();
+    }
+  };
+
+  // Each symbol only touches its own Mangled object and the string pool is
+  // thread safe, so ranges of symbols can be demangled independently.
+  const size_t range_size = 4096;
+  if (num_symbols <= range_size) {
+    demangle_fn(0, num_symbols);
+    return infos;
+  }
+  const size_t num_ranges = (num_symbols + range_size - 1) / range_size;
+  llvm::ThreadPool pool(llvm::optimal_concurrency(num_ranges));
+  for (size_t begin = 0; begin < num_symbols; begin += range_size)
+    pool.async(demangle_fn, begin, std::min(begin + range_size, num_symbols));
+  pool.wait();
+  return infos;
+}
+
 void Symtab::RegisterMangledNameEntry(
-    uint32_t value, std::set<const char *> &class_contexts,
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-    RichManglingContext &rmc) {
+    uint32_t value, const DemangledNameInfo &info,
+    std::set<const char *> &class_contexts,
+    std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog) {
   // Only register functions that have a base name.
-  rmc.ParseFunctionBaseName();
-  llvm::StringRef base_name = rmc.GetBufferRef();
-  if (base_name.empty())
+  if (info.base_name.IsEmpty())
     return;
 
   // The base name will be our entry's name.
-  NameToIndexMap::Entry entry(ConstString(base_name), value);
-
-  rmc.ParseFunctionDeclContextName();
-  llvm::StringRef decl_context = rmc.GetBufferRef();
+  NameToIndexMap::Entry entry(info.base_name, value);
 
   // Register functions with no context.
-  if (decl_context.empty()) {
+  if (info.decl_context.IsEmpty()) {
     // This has to be a basename
     m_basename_to_index.Append(entry);
     // If there is no context (no namespaces or class scopes that come before
@@ -363,14 +405,13 @@ void Symtab::RegisterMangledNameEntry(
     return;
   }
 
-  // Make sure we have a pool-string pointer and see if we already know the
-  // context name.
-  const char *decl_context_ccstr = ConstString(decl_context).GetCString();
+  // See if we already know the context name.
+  const char *decl_context_ccstr = info.decl_context.GetCString();
   auto it = class_contexts.find(decl_context_ccstr);
 
   // Register constructors and destructors. They are methods and create
   // declaration contexts.
-  if (rmc.IsCtorOrDtor()) {
+  if (info.is_ctor_or_dtor) {
     m_method_to_index.Append(entry);
     if (it == class_contexts.end())
       class_contexts.insert(it, decl_context_ccstr);
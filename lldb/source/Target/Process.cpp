@@ -2040,6 +2040,52 @@ size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
   return bytes_read;
 }
 
+std::vector<llvm::MutableArrayRef<uint8_t>>
+Process::ReadMemoryRanges(llvm::ArrayRef<Range<addr_t, size_t>> ranges,
+                          llvm::MutableArrayRef<uint8_t> buffer) {
+  std::vector<llvm::MutableArrayRef<uint8_t>> results =
+      DoReadMemoryRanges(ranges, buffer);
+  assert(results.size() == ranges.size());
+
+  // Replace any software breakpoint opcodes that fall into these ranges back
+  // into the buffer before we return
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (!results[i].empty())
+      RemoveBreakpointOpcodesFromBuffer(ranges[i].GetRangeBase(),
+                                        results[i].size(), results[i].data());
+  }
+  return results;
+}
+
+std::vector<llvm::MutableArrayRef<uint8_t>>
+Process::DoReadMemoryRanges(llvm::ArrayRef<Range<addr_t, size_t>> ranges,
+                            llvm::MutableArrayRef<uint8_t> buffer) {
+  std::vector<llvm::MutableArrayRef<uint8_t>> results;
+  results.reserve(ranges.size());
+  size_t offset = 0;
+  for (const Range<addr_t, size_t> &range : ranges) {
+    const addr_t addr = range.GetRangeBase();
+    const size_t size = range.GetByteSize();
+    uint8_t *bytes = buffer.data() + offset;
+    offset += size;
+
+    size_t bytes_read = 0;
+    while (bytes_read < size) {
+      Status error;
+      const size_t curr_size = size - bytes_read;
+      const size_t curr_bytes_read =
+          DoReadMemory(addr + bytes_read, bytes + bytes_read, curr_size, error);
+      if (error.Fail())
+        break;
+      bytes_read += curr_bytes_read;
+      if (curr_bytes_read == curr_size || curr_bytes_read == 0)
+        break;
+    }
+    results.emplace_back(bytes, bytes_read);
+  }
+  return results;
+}
+
 uint64_t Process::ReadUnsignedIntegerFromMemory(lldb::addr_t vm_addr,
                                                 size_t integer_byte_size,
                                                 uint64_t fail_value,
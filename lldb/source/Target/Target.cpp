@@ -185,6 +185,7 @@ void Target::CleanupProcess() {
 
 void Target::DeleteCurrentProcess() {
   if (m_process_sp) {
+    ClearUserExpressionCache();
     m_section_load_history.Clear();
     if (m_process_sp->IsAlive())
       m_process_sp->Destroy(false);
@@ -1390,6 +1391,7 @@ void Target::ClearModules(bool delete_locations) {
 
 void Target::DidExec() {
   // When a process exec's we need to know about it so we can do some cleanup.
+  ClearUserExpressionCache();
   m_breakpoint_list.RemoveInvalidLocations(m_arch.GetSpec());
   m_internal_breakpoint_list.RemoveInvalidLocations(m_arch.GetSpec());
 }
@@ -1613,6 +1615,7 @@ void Target::NotifyModulesRemoved(lldb_private::ModuleList &module_list) {
 void Target::ModulesDidLoad(ModuleList &module_list) {
   const size_t num_images = module_list.GetSize();
   if (m_valid && num_images) {
+    ClearUserExpressionCache();
     for (size_t idx = 0; idx < num_images; ++idx) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
@@ -1629,6 +1632,7 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
 
 void Target::SymbolsDidLoad(ModuleList &module_list) {
   if (m_valid && module_list.GetSize()) {
+    ClearUserExpressionCache();
     if (m_process_sp) {
       for (LanguageRuntime *runtime : m_process_sp->GetLanguageRuntimes()) {
         runtime->SymbolsDidLoad(module_list);
@@ -1644,6 +1648,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
+    ClearUserExpressionCache();
     UnloadModuleSections(module_list);
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, false,
@@ -2271,6 +2276,38 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+lldb::UserExpressionSP
+Target::TakeCachedUserExpression(const std::string &key) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  auto pos = m_user_expression_cache.find(key);
+  if (pos == m_user_expression_cache.end())
+    return lldb::UserExpressionSP();
+  lldb::UserExpressionSP expr_sp = std::move(pos->second);
+  m_user_expression_cache.erase(pos);
+  return expr_sp;
+}
+
+void Target::CacheUserExpression(const std::string &key,
+                                 lldb::UserExpressionSP expr_sp) {
+  // Every cached expression keeps its JIT'ed code alive in the process, so
+  // don't let the cache grow without bound.
+  static const size_t g_max_cached_user_expressions = 64;
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  if (m_user_expression_cache.size() >= g_max_cached_user_expressions)
+    m_user_expression_cache.clear();
+  m_user_expression_cache[key] = std::move(expr_sp);
+}
+
+void Target::ClearUserExpressionCache() {
+  // Destroy the expressions outside the lock, as that may need to talk to the
+  // process.
+  std::map<std::string, lldb::UserExpressionSP> cache;
+  {
+    std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+    cache.swap(m_user_expression_cache);
+  }
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
@@ -3805,6 +3842,12 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   m_collection_sp->SetPropertyAtIndexAsBoolean(nullptr, idx, b);
 }
 
+uint64_t TargetProperties::GetModuleLoadThreads() const {
+  const uint32_t idx = ePropertyModuleLoadThreads;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -3997,6 +4040,12 @@ bool TargetProperties::GetEnableAutoApplyFixIts() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+bool TargetProperties::GetCacheParsedExpressions() const {
+  const uint32_t idx = ePropertyCacheParsedExpressions;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 uint64_t TargetProperties::GetNumberOfRetriesWithFixits() const {
   const uint32_t idx = ePropertyRetriesWithFixIts;
   return m_collection_sp->GetPropertyAtIndexAsUInt64(
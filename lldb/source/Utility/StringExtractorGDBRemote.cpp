@@ -220,6 +220,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_qMemoryRegionInfoSupported;
       if (PACKET_STARTS_WITH("qModuleInfo:"))
         return eServerPacketType_qModuleInfo;
+      if (PACKET_STARTS_WITH("qMultiMemRead:"))
+        return eServerPacketType_qMultiMemRead;
       break;
 
     case 'P':
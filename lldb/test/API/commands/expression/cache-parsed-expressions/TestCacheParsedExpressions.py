@@ -0,0 +1,69 @@
+"""
+Test that parsed expressions are only reused in the frame and thread they were
+parsed in, and only when target.cache-parsed-expressions is set.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class CacheParsedExpressionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        TestBase.setUp(self)
+        self.log_file = self.getBuildArtifact("expr.log")
+
+    def enable_log(self):
+        self.runCmd("log enable -f '%s' lldb expr" % self.log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr"))
+
+    def count_reused(self):
+        self.runCmd("log disable lldb expr")
+        with open(self.log_file, "r") as f:
+            count = f.read().count("Reusing parsed expression")
+        self.runCmd("log enable -f '%s' lldb expr" % self.log_file)
+        return count
+
+    def test_disabled_by_default(self):
+        self.expect("settings show target.cache-parsed-expressions",
+                    substrs=["target.cache-parsed-expressions (boolean) = false"])
+
+        self.build()
+        _, _, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"))
+        self.enable_log()
+
+        frame = thread.GetFrameAtIndex(0)
+        for _ in range(2):
+            self.assertEqual(frame.EvaluateExpression("local + 1").GetValue(),
+                             "1")
+        self.assertEqual(self.count_reused(), 0)
+
+    def test_reused_in_same_frame_only(self):
+        self.build()
+        self.runCmd("settings set target.cache-parsed-expressions true")
+        _, _, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"))
+        self.enable_log()
+
+        # The frames of recurse share the same block, but not their locals.
+        frames = [thread.GetFrameAtIndex(i) for i in range(3)]
+        for i, frame in enumerate(frames):
+            self.assertEqual(frame.EvaluateExpression("local + 1").GetValue(),
+                             str(i * 10 + 1))
+        self.assertEqual(self.count_reused(), 0)
+
+        # Evaluating them again reuses the expression parsed for each frame.
+        for i, frame in enumerate(frames):
+            self.assertEqual(frame.EvaluateExpression("local + 1").GetValue(),
+                             str(i * 10 + 1))
+        self.assertEqual(self.count_reused(), 3)
+
+        # A changed value is picked up by the reused expression.
+        frames[0].EvaluateExpression("local = 5")
+        self.assertEqual(frames[0].EvaluateExpression("local + 1").GetValue(),
+                         "6")
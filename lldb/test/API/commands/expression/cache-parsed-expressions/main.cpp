@@ -0,0 +1,8 @@
+int recurse(int n) {
+  int local = n * 10;
+  if (n == 0)
+    return local; // break here
+  return recurse(n - 1) + local;
+}
+
+int main() { return recurse(2); }
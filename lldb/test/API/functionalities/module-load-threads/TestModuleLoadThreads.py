@@ -0,0 +1,46 @@
+"""
+Test that modules preloaded on several threads are loaded like modules loaded
+one at a time.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ModuleLoadThreadsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def test_default_is_serial(self):
+        self.expect("settings show target.module-load-threads",
+                    substrs=["target.module-load-threads (unsigned) = 1"])
+
+    def load_modules(self, num_threads):
+        self.runCmd("settings set target.module-load-threads %d" % num_threads)
+        (target, process, _, _) = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.c"),
+            extra_images=["one", "two", "three"])
+
+        # The functions of every library resolve through its symbols.
+        for name in ["one", "two", "three"]:
+            functions = target.FindFunctions(name + "_function")
+            self.assertEqual(functions.GetSize(), 1)
+            self.assertIn(name, functions[0].GetModule().GetFileSpec()
+                          .GetFilename())
+
+        modules = sorted(module.GetFileSpec().GetFilename()
+                         for module in target.module_iter())
+        process.Kill()
+        return modules
+
+    # The POSIX dynamic loader is the only one that preloads modules.
+    @skipUnlessPlatform(["linux", "freebsd", "netbsd"])
+    def test_parallel_preload(self):
+        self.build()
+        serial = self.load_modules(1)
+        parallel = self.load_modules(4)
+        self.assertEqual(serial, parallel)
@@ -0,0 +1,7 @@
+int one_function(int x);
+int two_function(int x);
+int three_function(int x);
+
+int main(int argc, char **argv) {
+  return one_function(argc) + two_function(argc) + three_function(argc); // break here
+}
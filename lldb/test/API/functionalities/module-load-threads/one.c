@@ -0,0 +1 @@
+int one_function(int x) { return x + 1; }
@@ -0,0 +1 @@
+int three_function(int x) { return x + 1; }
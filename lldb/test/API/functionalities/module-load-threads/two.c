@@ -0,0 +1 @@
+int two_function(int x) { return x + 1; }
@@ -575,6 +575,68 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase, DwarfOpcod
         read_contents = seven.unhexlify(context.get("read_contents"))
         self.assertEqual(read_contents, MEMORY_CONTENTS)
 
+    @skipIfWindows # No pty support to test any inferior output
+    @add_test_categories(["llgs"])
+    def test_qMultiMemRead_reads_memory(self):
+        self.build()
+        self.set_inferior_startup_launch()
+        MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"
+
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "set-message:%s" %
+                MEMORY_CONTENTS,
+                "get-data-address-hex:g_message",
+                "sleep:5"])
+        self.add_qSupported_packets()
+
+        # Run the process
+        self.test_sequence.add_log_lines(
+            [
+                # Start running after initial stop.
+                "read packet: $c#63",
+                # Match output line that prints the memory address of the message buffer within the inferior.
+                {"type": "output_match", "regex": self.maybe_strict_output_regex(r"data address: 0x([0-9a-fA-F]+)\r\n"),
+                 "capture": {1: "message_address"}},
+                # Now stop the inferior.
+                "read packet: {}".format(chr(3)),
+                # And wait for the stop notification.
+                {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        supported_dict = self.parse_qSupported_response(context)
+        self.assertEqual(supported_dict.get("qMultiMemRead"), "+")
+
+        # Grab the message address.
+        self.assertIsNotNone(context.get("message_address"))
+        message_address = int(context.get("message_address"), 16)
+
+        # Read the message in two pieces, with an unreadable range between
+        # them that must not fail the other two.
+        half = len(MEMORY_CONTENTS) // 2
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $qMultiMemRead:ranges:{0:x},{1:x},0,8,{2:x},{3:x};#00".format(
+                message_address, half, message_address + half,
+                len(MEMORY_CONTENTS) - half),
+             {"direction": "send", "regex": r"^\$([0-9a-fA-F]+),([0-9a-fA-F]+),([0-9a-fA-F]+);(.*)#[0-9a-fA-F]{2}$",
+              "capture": {1: "size0", 2: "size1", 3: "size2", 4: "read_contents"}}],
+            True)
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        self.assertEqual(int(context.get("size0"), 16), half)
+        self.assertEqual(int(context.get("size1"), 16), 0)
+        self.assertEqual(int(context.get("size2"), 16),
+                         len(MEMORY_CONTENTS) - half)
+        self.assertEqual(context.get("read_contents"), MEMORY_CONTENTS)
+
     def test_qMemoryRegionInfo_is_supported(self):
         self.build()
         self.set_inferior_startup_launch()
@@ -632,6 +632,47 @@ TEST_F(GDBRemoteCommunicationClientTest, SendGetTraceConfigPacket) {
   ASSERT_FALSE(result4.get().Success());
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, ReadMemoryRanges) {
+  uint8_t buffer[8];
+  const auto &ReadMemoryRanges = [&](llvm::StringRef response) {
+    memset(buffer, 0, sizeof(buffer));
+    std::pair<addr_t, MutableArrayRef<uint8_t>> reads[] = {
+        {0x1000, MutableArrayRef<uint8_t>(buffer, 4)},
+        {0x2000, MutableArrayRef<uint8_t>(buffer + 4, 2)},
+        {0x3000, MutableArrayRef<uint8_t>(buffer + 6, 2)}};
+    std::future<std::vector<size_t>> result = std::async(
+        std::launch::async, [&] { return client.ReadMemoryRanges(reads); });
+
+    HandlePacket(server, "qMultiMemRead:ranges:1000,4,2000,2,3000,2;",
+                 response);
+    return result.get();
+  };
+
+  EXPECT_THAT(ReadMemoryRanges("4,2,2;abcdefgh"),
+              testing::ElementsAre(4u, 2u, 2u));
+  EXPECT_EQ(0, memcmp(buffer, "abcdefgh", 8));
+
+  // A range that can't be read doesn't prevent reading the others.
+  EXPECT_THAT(ReadMemoryRanges("4,0,1;abcdg"),
+              testing::ElementsAre(4u, 0u, 1u));
+  EXPECT_EQ(0, memcmp(buffer, "abcd\0\0g\0", 8));
+
+  // The data after the first ';' may contain ';'.
+  EXPECT_THAT(ReadMemoryRanges("1,2,0;;;;"),
+              testing::ElementsAre(1u, 2u, 0u));
+  EXPECT_EQ(0, memcmp(buffer, ";\0\0\0;;\0\0", 8));
+
+  EXPECT_THAT(ReadMemoryRanges("E05"), testing::ElementsAre(0u, 0u, 0u));
+  // Lengths that are malformed, larger than requested, or not backed by data
+  // stop the parsing.
+  EXPECT_THAT(ReadMemoryRanges("4,x,2;abcdefgh"),
+              testing::ElementsAre(4u, 0u, 0u));
+  EXPECT_THAT(ReadMemoryRanges("4,3,2;abcdefgh"),
+              testing::ElementsAre(4u, 0u, 0u));
+  EXPECT_THAT(ReadMemoryRanges("4,2,2;abcdef"),
+              testing::ElementsAre(4u, 2u, 0u));
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, GetQOffsets) {
   const auto &GetQOffsets = [&](llvm::StringRef response) {
     std::future<Optional<QOffsets>> result = std::async(
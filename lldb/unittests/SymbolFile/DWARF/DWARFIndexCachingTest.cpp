@@ -0,0 +1,267 @@
+//===-- DWARFIndexCachingTest.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/SymbolFile/DWARF/DIERef.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
+#include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
+#include "Plugins/TypeSystem/Clang/TypeSystemClang.h"
+#include "TestingSupport/SubsystemRAII.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Utility/StreamString.h"
+#include "llvm/ObjectYAML/yaml2obj.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/YAMLTraits.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static std::string DumpNameToDIE(NameToDIE &map) {
+  StreamString s;
+  map.Dump(&s);
+  return std::string(s.GetString());
+}
+
+static std::string EncodeNameToDIE(const NameToDIE &map) {
+  std::string data;
+  llvm::raw_string_ostream os(data);
+  map.Encode(os);
+  return os.str();
+}
+
+TEST(DWARFIndexCachingTest, NameToDIEEncodeDecode) {
+  NameToDIE map;
+  map.Insert(ConstString("simple"),
+             DIERef(llvm::None, DIERef::Section::DebugInfo, 0x10));
+  map.Insert(ConstString("dwo"), DIERef(7u, DIERef::Section::DebugInfo, 0x20));
+  map.Insert(ConstString("type_unit"),
+             DIERef(llvm::None, DIERef::Section::DebugTypes, 0x30));
+  map.Insert(ConstString("simple"),
+             DIERef(llvm::None, DIERef::Section::DebugInfo, 0x40));
+  map.Finalize();
+
+  std::string data = EncodeNameToDIE(map);
+  llvm::DataExtractor extractor(data, /*IsLittleEndian=*/true,
+                                /*AddressSize=*/8);
+  llvm::DataExtractor::Cursor cursor(0);
+  NameToDIE decoded;
+  ASSERT_TRUE(decoded.Decode(extractor, cursor));
+  EXPECT_THAT_ERROR(cursor.takeError(), llvm::Succeeded());
+  EXPECT_EQ(cursor.tell(), data.size());
+  EXPECT_EQ(DumpNameToDIE(decoded), DumpNameToDIE(map));
+}
+
+TEST(DWARFIndexCachingTest, NameToDIEDecodeTruncated) {
+  NameToDIE map;
+  map.Insert(ConstString("name"),
+             DIERef(llvm::None, DIERef::Section::DebugInfo, 0x10));
+  map.Finalize();
+  std::string data = EncodeNameToDIE(map);
+
+  for (size_t size = 0; size != data.size(); ++size) {
+    llvm::DataExtractor extractor(llvm::StringRef(data).take_front(size),
+                                  /*IsLittleEndian=*/true, /*AddressSize=*/8);
+    llvm::DataExtractor::Cursor cursor(0);
+    NameToDIE decoded;
+    decoded.Insert(ConstString("stale"),
+                   DIERef(llvm::None, DIERef::Section::DebugInfo, 0x20));
+    EXPECT_FALSE(decoded.Decode(extractor, cursor)) << size;
+    EXPECT_EQ(DumpNameToDIE(decoded), "") << size;
+    llvm::consumeError(cursor.takeError());
+  }
+}
+
+TEST(DWARFIndexCachingTest, NameToDIEDecodeMalformed) {
+  NameToDIE map;
+  map.Insert(ConstString("name"),
+             DIERef(llvm::None, DIERef::Section::DebugInfo, 0x10));
+  map.Finalize();
+  std::string data = EncodeNameToDIE(map);
+
+  // The flags byte follows the entry count and the name.
+  data[sizeof(uint32_t) + sizeof("name")] = 0x7f;
+  llvm::DataExtractor extractor(data, /*IsLittleEndian=*/true,
+                                /*AddressSize=*/8);
+  llvm::DataExtractor::Cursor cursor(0);
+  NameToDIE decoded;
+  EXPECT_FALSE(decoded.Decode(extractor, cursor));
+  EXPECT_EQ(DumpNameToDIE(decoded), "");
+  llvm::consumeError(cursor.takeError());
+}
+
+namespace {
+class DWARFIndexCacheTest : public testing::Test {
+  SubsystemRAII<FileSystem, HostInfo, ObjectFileELF, SymbolFileDWARF,
+                TypeSystemClang>
+      subsystems;
+
+public:
+  void SetUp() override {
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("lldb-index-cache",
+                                                      m_temp_dir));
+    llvm::SmallString<128> cache_dir(m_temp_dir);
+    llvm::sys::path::append(cache_dir, "cache");
+    m_cache_dir = std::string(cache_dir);
+    ModuleListProperties &props = ModuleList::GetGlobalModuleListProperties();
+    props.SetEnableLLDBIndexCache(true);
+    props.SetLLDBIndexCachePath(FileSpec(m_cache_dir));
+  }
+
+  void TearDown() override {
+    ModuleList::GetGlobalModuleListProperties().SetEnableLLDBIndexCache(false);
+    llvm::sys::fs::remove_directories(m_temp_dir);
+  }
+
+protected:
+  /// Write an ELF file with a single compile unit that has a base type
+  /// called "int", and return its path.
+  std::string WriteObjectFile() {
+    const char *yamldata = R"(
+--- !ELF
+FileHeader:
+  Class:   ELFCLASS64
+  Data:    ELFDATA2LSB
+  Type:    ET_EXEC
+  Machine: EM_X86_64
+DWARF:
+  debug_abbrev:
+    - Table:
+        - Code:            0x00000001
+          Tag:             DW_TAG_compile_unit
+          Children:        DW_CHILDREN_yes
+          Attributes:
+            - Attribute:       DW_AT_language
+              Form:            DW_FORM_data2
+        - Code:            0x00000002
+          Tag:             DW_TAG_base_type
+          Children:        DW_CHILDREN_no
+          Attributes:
+            - Attribute:       DW_AT_name
+              Form:            DW_FORM_string
+            - Attribute:       DW_AT_encoding
+              Form:            DW_FORM_data1
+            - Attribute:       DW_AT_byte_size
+              Form:            DW_FORM_data1
+  debug_info:
+    - Version:         4
+      AddrSize:        8
+      Entries:
+        - AbbrCode:        0x00000001
+          Values:
+            - Value:           0x000000000000000C
+        - AbbrCode:        0x00000002
+          Values:
+            - CStr:            int
+            - Value:           0x0000000000000005 # DW_ATE_signed
+            - Value:           0x0000000000000004
+        - AbbrCode:        0x00000000
+)";
+    llvm::SmallString<128> path(m_temp_dir);
+    llvm::sys::path::append(path, "test.elf");
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec);
+    EXPECT_FALSE(ec);
+    llvm::yaml::Input yin(yamldata);
+    EXPECT_TRUE(llvm::yaml::convertYAML(yin, os, [](const llvm::Twine &) {}));
+    return std::string(path);
+  }
+
+  /// Index the module at \a path and return the dump of its index.
+  static std::string IndexModule(const std::string &path) {
+    auto module_sp = std::make_shared<Module>(ModuleSpec(FileSpec(path)));
+    SymbolFile *symfile = module_sp->GetSymbolFile();
+    EXPECT_NE(symfile, nullptr);
+    if (!symfile)
+      return "";
+    symfile->PreloadSymbols();
+    StreamString s;
+    symfile->Dump(s);
+    return std::string(s.GetString());
+  }
+
+  /// Return the paths of all files in the cache directory.
+  std::vector<std::string> GetCacheFiles() {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(m_cache_dir, ec), end;
+         !ec && it != end; it.increment(ec))
+      files.push_back(it->path());
+    return files;
+  }
+
+  /// Rename the "int" type in the index cache file at \a path to "inx".
+  static void RenameTypeInCache(const std::string &path) {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    ASSERT_TRUE(bool(buffer));
+    std::string contents = (*buffer)->getBuffer().str();
+    size_t pos = contents.find(llvm::StringRef("int", 4));
+    ASSERT_NE(pos, std::string::npos);
+    contents[pos + 2] = 'x';
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec);
+    ASSERT_FALSE(ec);
+    os << contents;
+  }
+
+  llvm::SmallString<128> m_temp_dir;
+  std::string m_cache_dir;
+};
+} // namespace
+
+TEST_F(DWARFIndexCacheTest, SaveAndLoad) {
+  std::string path = WriteObjectFile();
+
+  // The first session indexes the module and saves the index.
+  std::string dump = IndexModule(path);
+  EXPECT_NE(dump.find("\"int\""), std::string::npos) << dump;
+  std::vector<std::string> files = GetCacheFiles();
+  ASSERT_EQ(files.size(), 1u);
+
+  // A later session shows the type renamed in the cache file, which proves
+  // that it loaded the index instead of rebuilding it.
+  RenameTypeInCache(files[0]);
+  dump = IndexModule(path);
+  EXPECT_NE(dump.find("\"inx\""), std::string::npos) << dump;
+  EXPECT_EQ(dump.find("\"int\""), std::string::npos) << dump;
+}
+
+TEST_F(DWARFIndexCacheTest, StaleCacheIsRebuilt) {
+  std::string path = WriteObjectFile();
+  std::string dump = IndexModule(path);
+  std::vector<std::string> files = GetCacheFiles();
+  ASSERT_EQ(files.size(), 1u);
+
+  // Give the object file a new modification time. The next session must
+  // ignore the cache file, index the module again and rewrite the file.
+  RenameTypeInCache(files[0]);
+  llvm::sys::fs::file_status status;
+  ASSERT_FALSE(llvm::sys::fs::status(path, status));
+  int fd;
+  ASSERT_FALSE(llvm::sys::fs::openFileForReadWrite(
+      path, fd, llvm::sys::fs::CD_OpenExisting, llvm::sys::fs::OF_None));
+  std::chrono::seconds later(60);
+  EXPECT_FALSE(llvm::sys::fs::setLastAccessAndModificationTime(
+      fd, status.getLastAccessedTime() + later,
+      status.getLastModificationTime() + later));
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+
+  EXPECT_EQ(IndexModule(path), dump);
+  EXPECT_EQ(GetCacheFiles(), files);
+  EXPECT_EQ(IndexModule(path), dump);
+}
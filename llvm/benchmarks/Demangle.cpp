@@ -0,0 +1,87 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Demangle/Demangle.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+namespace {
+
+// Symbols exported by libstdc++, a mix of short and deeply templated names
+// like the ones llvm-nm, llvm-symbolizer and lldb's symbol table see.
+const char *const Symbols[] = {
+    "_ZNKRSt7__cxx1119basic_ostringstreamIcSt11char_traitsIcESaIcEE3strEv",
+    "_ZNKSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE6rbeginEv",
+    "_ZNKSt7__cxx118messagesIcE18_M_convert_to_charERKNS_12basic_stringIcSt11"
+    "char_traitsIcESaIcEEE",
+    "_ZNKSt7num_getIcSt19istreambuf_iteratorIcSt11char_traitsIcEEE6do_getES3_"
+    "S3_RSt8ios_baseRSt12_Ios_IostateRb",
+    "_ZNKSt8time_getIcSt19istreambuf_iteratorIcSt11char_traitsIcEEE14_M_"
+    "extract_numES3_S3_RiiimRSt8ios_baseRSt12_Ios_Iostate",
+    "_ZNSbIwSt11char_traitsIwESaIwEEC1IN9__gnu_cxx17__normal_iteratorIPwS2_"
+    "EEEET_S8_RKS1_",
+    "_ZNSt10moneypunctIwLb1EE24_M_initialize_moneypunctEP15__locale_structPKc",
+    "_ZNSt13basic_istreamIwSt11char_traitsIwEErsEPFRSt8ios_baseS4_E",
+    "_ZNSt15basic_stringbufIwSt11char_traitsIwESaIwEEC1ERKSbIwS1_S2_ESt13_Ios_"
+    "Openmode",
+    "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE10_M_replaceEmmPKcm",
+    "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE9push_backEc",
+    "_ZNSt7__cxx1115basic_stringbufIcSt11char_traitsIcESaIcEEC1EOS4_RKS3_",
+    "_ZNSt9basic_iosIcSt11char_traitsIcEE5rdbufEPSt15basic_streambufIcS1_E",
+    "_ZN10__cxxabiv120__si_class_type_infoD0Ev",
+    "_Z1fv",
+};
+
+constexpr size_t NumSymbols = sizeof(Symbols) / sizeof(Symbols[0]);
+
+// A fresh demangler and output buffer for every symbol.
+void BM_ItaniumDemangle(benchmark::State &State) {
+  for (auto _ : State) {
+    for (const char *S : Symbols) {
+      char *Res = itaniumDemangle(S, nullptr, nullptr, nullptr);
+      benchmark::DoNotOptimize(Res);
+      std::free(Res);
+    }
+  }
+  State.SetItemsProcessed(State.iterations() * NumSymbols);
+}
+
+// One demangler and one output buffer for all symbols, as tools processing a
+// whole symbol table should use it.
+void BM_PartialDemangleFull(benchmark::State &State) {
+  ItaniumPartialDemangler D;
+  size_t N = 0;
+  char *Buf = nullptr;
+  for (auto _ : State) {
+    for (const char *S : Symbols) {
+      if (!D.partialDemangle(S))
+        Buf = D.finishDemangle(Buf, &N);
+      benchmark::DoNotOptimize(Buf);
+    }
+  }
+  std::free(Buf);
+  State.SetItemsProcessed(State.iterations() * NumSymbols);
+}
+
+// Only the base name, as needed to index functions by name.
+void BM_PartialDemangleBaseName(benchmark::State &State) {
+  ItaniumPartialDemangler D;
+  size_t N = 0;
+  char *Buf = nullptr;
+  for (auto _ : State) {
+    for (const char *S : Symbols) {
+      if (!D.partialDemangle(S) && D.isFunction())
+        Buf = D.getFunctionBaseName(Buf, &N);
+      benchmark::DoNotOptimize(Buf);
+    }
+  }
+  std::free(Buf);
+  State.SetItemsProcessed(State.iterations() * NumSymbols);
+}
+
+} // namespace
+
+BENCHMARK(BM_ItaniumDemangle);
+BENCHMARK(BM_PartialDemangleFull);
+BENCHMARK(BM_PartialDemangleBaseName);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+// Pointers to separately allocated objects, like most pointer keyed maps.
+struct PointerKeys {
+  using KeyT = const int *;
+
+  explicit PointerKeys(size_t N) {
+    for (size_t I = 0; I < 2 * N; ++I)
+      Storage.push_back(std::make_unique<int>(I));
+    std::shuffle(Storage.begin(), Storage.end(), std::mt19937(0));
+  }
+
+  // The first N keys are inserted, the last N ones are only looked up.
+  KeyT get(size_t I) const { return Storage[I].get(); }
+
+  std::vector<std::unique_ptr<int>> Storage;
+};
+
+struct StringRefKeys {
+  using KeyT = StringRef;
+
+  explicit StringRefKeys(size_t N) {
+    for (size_t I = 0; I < 2 * N; ++I)
+      Storage.push_back("some::qualified::name" + std::to_string(I));
+  }
+
+  KeyT get(size_t I) const { return Storage[I]; }
+
+  std::vector<std::string> Storage;
+};
+
+template <typename MapT, typename KeysT>
+void BM_Insert(benchmark::State &State) {
+  size_t N = State.range(0);
+  KeysT Keys(N);
+  for (auto _ : State) {
+    MapT Map;
+    for (size_t I = 0; I < N; ++I)
+      Map[Keys.get(I)] = I;
+    benchmark::DoNotOptimize(Map);
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+template <typename MapT, typename KeysT>
+void BM_LookupHit(benchmark::State &State) {
+  size_t N = State.range(0);
+  KeysT Keys(N);
+  MapT Map;
+  for (size_t I = 0; I < N; ++I)
+    Map[Keys.get(I)] = I;
+  for (auto _ : State)
+    for (size_t I = 0; I < N; ++I)
+      benchmark::DoNotOptimize(Map.find(Keys.get(I)));
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+template <typename MapT, typename KeysT>
+void BM_LookupMiss(benchmark::State &State) {
+  size_t N = State.range(0);
+  KeysT Keys(N);
+  MapT Map;
+  for (size_t I = 0; I < N; ++I)
+    Map[Keys.get(I)] = I;
+  for (auto _ : State)
+    for (size_t I = N; I < 2 * N; ++I)
+      benchmark::DoNotOptimize(Map.find(Keys.get(I)));
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+template <typename MapT, typename KeysT>
+void BM_EraseInsert(benchmark::State &State) {
+  size_t N = State.range(0);
+  KeysT Keys(N);
+  MapT Map;
+  for (size_t I = 0; I < N; ++I)
+    Map[Keys.get(I)] = I;
+  size_t Next = 0;
+  for (auto _ : State) {
+    // Replace one key with another one, so the size stays the same.
+    Map.erase(Keys.get(Next));
+    Map[Keys.get(Next + N)] = Next;
+    std::swap(Keys.Storage[Next], Keys.Storage[Next + N]);
+    Next = (Next + 1) % N;
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+
+using PointerDenseMap = DenseMap<const int *, unsigned>;
+using PointerFlatHashMap = FlatHashMap<const int *, unsigned>;
+using StringRefDenseMap = DenseMap<StringRef, unsigned>;
+using StringRefFlatHashMap = FlatHashMap<StringRef, unsigned>;
+
+} // namespace
+
+#define MAP_BENCHMARKS(Map, Keys)                                              \
+  BENCHMARK_TEMPLATE(BM_Insert, Map, Keys)->Range(16, 1 << 18);                \
+  BENCHMARK_TEMPLATE(BM_LookupHit, Map, Keys)->Range(16, 1 << 18);             \
+  BENCHMARK_TEMPLATE(BM_LookupMiss, Map, Keys)->Range(16, 1 << 18);            \
+  BENCHMARK_TEMPLATE(BM_EraseInsert, Map, Keys)->Range(16, 1 << 18);
+
+MAP_BENCHMARKS(PointerDenseMap, PointerKeys)
+MAP_BENCHMARKS(PointerFlatHashMap, PointerKeys)
+MAP_BENCHMARKS(StringRefDenseMap, StringRefKeys)
+MAP_BENCHMARKS(StringRefFlatHashMap, StringRefKeys)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include "benchmark/benchmark.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+// A function with a single block of N additions. The instructions are always
+// allocated one after the other, but when Scattered is set they are placed
+// in the block in a random order, so that walking the block jumps around in
+// memory like it does after a few passes moved and recreated instructions.
+struct TestFunction {
+  TestFunction(size_t N, bool Scattered) : M("bench", Ctx) {
+    Type *I32 = Type::getInt32Ty(Ctx);
+    F = Function::Create(FunctionType::get(I32, {I32}, false),
+                         GlobalValue::ExternalLinkage, "f", M);
+    BasicBlock *BB = BasicBlock::Create(Ctx, "entry", F);
+    Value *Arg = F->getArg(0);
+
+    std::vector<Instruction *> Insts;
+    for (size_t I = 0; I < N; ++I)
+      Insts.push_back(BinaryOperator::CreateAdd(Arg, Arg));
+    if (Scattered)
+      std::shuffle(Insts.begin(), Insts.end(), std::mt19937(0));
+    for (Instruction *I : Insts)
+      BB->getInstList().push_back(I);
+    ReturnInst::Create(Ctx, Arg, BB);
+  }
+
+  LLVMContext Ctx;
+  Module M;
+  Function *F;
+};
+
+void BM_IterateInstructions(benchmark::State &State, bool Scattered) {
+  size_t N = State.range(0);
+  TestFunction T(N, Scattered);
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    for (const BasicBlock &BB : *T.F)
+      for (const Instruction &I : BB)
+        Sum += I.getOpcode() + I.getNumOperands();
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+void BM_IterateInOrder(benchmark::State &State) {
+  BM_IterateInstructions(State, /*Scattered=*/false);
+}
+
+void BM_IterateScattered(benchmark::State &State) {
+  BM_IterateInstructions(State, /*Scattered=*/true);
+}
+
+} // namespace
+
+BENCHMARK(BM_IterateInOrder)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_IterateScattered)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
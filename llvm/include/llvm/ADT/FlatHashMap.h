@@ -0,0 +1,650 @@
+//===- llvm/ADT/FlatHashMap.h - Group probed hash table ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the FlatHashMap and FlatHashSet classes, open addressing
+// hash tables that keep a control byte per slot and probe the control bytes of
+// a whole group of slots at a time ("Swiss tables").
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_FLATHASHMAP_USE_SSE2 1
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// The slots of a group that match some condition, as a bit mask with one bit
+/// per slot (or per byte of the mask, if \p Shift is 3). Iterating over it
+/// yields the indices of the matching slots in the group.
+template <typename T, unsigned Shift> class FlatHashBitMask {
+public:
+  explicit FlatHashBitMask(T Mask) : Mask(Mask) {}
+
+  explicit operator bool() const { return Mask != 0; }
+
+  /// Returns the index of the first matching slot. The mask must not be empty.
+  unsigned lowest() const {
+    return countTrailingZeros(Mask, ZB_Undefined) >> Shift;
+  }
+
+  FlatHashBitMask begin() const { return *this; }
+  FlatHashBitMask end() const { return FlatHashBitMask(0); }
+  unsigned operator*() const { return lowest(); }
+  FlatHashBitMask &operator++() {
+    Mask &= Mask - 1;
+    return *this;
+  }
+  bool operator!=(const FlatHashBitMask &RHS) const { return Mask != RHS.Mask; }
+
+private:
+  T Mask;
+};
+
+// The control byte of a full slot holds the top 7 bits of the hash of its
+// key, so it is never negative.
+
+/// The control byte of an unused slot.
+constexpr int8_t FlatHashCtrlEmpty = -128;
+/// The control byte of a slot whose value was erased. Lookups must probe past
+/// it, as the slot may have been full when a later key was inserted.
+constexpr int8_t FlatHashCtrlDeleted = -2;
+
+#ifdef LLVM_FLATHASHMAP_USE_SSE2
+/// The control bytes of a group of consecutive slots, compared all at once
+/// with SSE2 instructions.
+class FlatHashGroup {
+public:
+  static constexpr unsigned Width = 16;
+  using BitMask = FlatHashBitMask<uint32_t, 0>;
+
+  explicit FlatHashGroup(const int8_t *Pos)
+      : Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Pos))) {}
+
+  /// Returns the full slots whose control byte is \p H2.
+  BitMask match(int8_t H2) const {
+    return BitMask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl))));
+  }
+
+  BitMask matchEmpty() const { return match(FlatHashCtrlEmpty); }
+
+  /// Returns the empty and deleted slots, whose control bytes are negative.
+  BitMask matchEmptyOrDeleted() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(Ctrl)));
+  }
+
+private:
+  __m128i Ctrl;
+};
+#else
+/// The control bytes of a group of consecutive slots, compared all at once
+/// as a 64-bit integer.
+class FlatHashGroup {
+  static constexpr uint64_t LSBs = 0x0101010101010101ULL;
+  static constexpr uint64_t MSBs = 0x8080808080808080ULL;
+
+public:
+  static constexpr unsigned Width = 8;
+  using BitMask = FlatHashBitMask<uint64_t, 3>;
+
+  explicit FlatHashGroup(const int8_t *Pos)
+      : Ctrl(support::endian::read64le(Pos)) {}
+
+  /// Returns the full slots whose control byte is \p H2. This may also return
+  /// full slots that directly follow a matching slot, which only costs an
+  /// extra key comparison.
+  BitMask match(int8_t H2) const {
+    uint64_t X = Ctrl ^ (LSBs * static_cast<uint8_t>(H2));
+    return BitMask((X - LSBs) & ~X & MSBs);
+  }
+
+  /// Returns the empty slots: their top bit is set, unlike full slots, and
+  /// their second lowest bit is clear, unlike deleted slots.
+  BitMask matchEmpty() const { return BitMask(Ctrl & (~Ctrl << 6) & MSBs); }
+
+  /// Returns the empty and deleted slots, whose control bytes are negative.
+  BitMask matchEmptyOrDeleted() const { return BitMask(Ctrl & MSBs); }
+
+private:
+  uint64_t Ctrl;
+};
+#endif
+
+struct FlatHashMapGetKey {
+  template <typename KeyT, typename ValueT>
+  static const KeyT &getKey(const DenseMapPair<KeyT, ValueT> &Slot) {
+    return Slot.getFirst();
+  }
+};
+
+struct FlatHashSetGetKey {
+  template <typename ValueT> static const ValueT &getKey(const ValueT &Slot) {
+    return Slot;
+  }
+};
+
+/// The implementation shared by FlatHashMap and FlatHashSet.
+///
+/// Slots are stored in a power of two sized array, along with an array of
+/// control bytes that tell whether each slot is empty, deleted, or full, and
+/// in that case holds 7 bits of the hash of its key. A lookup finds its first
+/// candidate slot with the remaining bits of the hash and compares the control
+/// bytes of the whole group of slots starting at it to its 7 bits, which
+/// usually leaves at most one key to compare. Probing stops at the first group
+/// with an empty slot. The first control bytes are mirrored after the last
+/// ones so that a group can start at any slot.
+///
+/// Unlike DenseMap, no key values are reserved for empty or erased slots, so
+/// only KeyInfoT::getHashValue() and KeyInfoT::isEqual() are used.
+template <typename SlotT, typename KeyT, typename KeyInfoT, typename GetKeyT>
+class FlatHashTable {
+  using Group = FlatHashGroup;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using value_type = SlotT;
+
+  template <bool IsConst> class Iterator {
+    friend class FlatHashTable;
+    template <bool> friend class Iterator;
+    using SlotPtrT = std::conditional_t<IsConst, const SlotT *, SlotT *>;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = SlotT;
+    using pointer = SlotPtrT;
+    using reference = std::conditional_t<IsConst, const SlotT &, SlotT &>;
+    using iterator_category = std::forward_iterator_tag;
+
+    Iterator() = default;
+
+    // Allow conversion from iterator to const_iterator.
+    template <bool WasConst,
+              typename = std::enable_if_t<IsConst && !WasConst>>
+    Iterator(const Iterator<WasConst> &I)
+        : Ctrl(I.Ctrl), End(I.End), Slot(I.Slot) {}
+
+    reference operator*() const { return *Slot; }
+    pointer operator->() const { return Slot; }
+
+    Iterator &operator++() {
+      ++Ctrl;
+      ++Slot;
+      skipUnused();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+
+    friend bool operator==(const Iterator &LHS, const Iterator &RHS) {
+      return LHS.Slot == RHS.Slot;
+    }
+    friend bool operator!=(const Iterator &LHS, const Iterator &RHS) {
+      return LHS.Slot != RHS.Slot;
+    }
+
+  private:
+    Iterator(const int8_t *Ctrl, const int8_t *End, SlotPtrT Slot)
+        : Ctrl(Ctrl), End(End), Slot(Slot) {
+      skipUnused();
+    }
+    // Iterator to a full slot.
+    struct FullSlotTag {};
+    Iterator(const int8_t *Ctrl, const int8_t *End, SlotPtrT Slot, FullSlotTag)
+        : Ctrl(Ctrl), End(End), Slot(Slot) {}
+
+    void skipUnused() {
+      while (Ctrl != End && *Ctrl < 0) {
+        ++Ctrl;
+        ++Slot;
+      }
+    }
+
+    const int8_t *Ctrl = nullptr;
+    const int8_t *End = nullptr;
+    SlotPtrT Slot = nullptr;
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatHashTable() = default;
+  FlatHashTable(const FlatHashTable &Other) { copyFrom(Other); }
+  FlatHashTable(FlatHashTable &&Other) { swap(Other); }
+  ~FlatHashTable() { destroyAll(); }
+
+  FlatHashTable &operator=(const FlatHashTable &Other) {
+    if (&Other != this) {
+      destroyAll();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+  FlatHashTable &operator=(FlatHashTable &&Other) {
+    FlatHashTable Tmp(std::move(Other));
+    swap(Tmp);
+    return *this;
+  }
+
+  iterator begin() { return iterator(Ctrl, Ctrl + Capacity, Slots); }
+  iterator end() {
+    return iterator(Ctrl + Capacity, Ctrl + Capacity, Slots + Capacity);
+  }
+  const_iterator begin() const {
+    return const_iterator(Ctrl, Ctrl + Capacity, Slots);
+  }
+  const_iterator end() const {
+    return const_iterator(Ctrl + Capacity, Ctrl + Capacity, Slots + Capacity);
+  }
+
+  LLVM_NODISCARD bool empty() const { return Size == 0; }
+  unsigned size() const { return Size; }
+
+  /// Grow the table so that it can hold \p NumEntries entries without being
+  /// rehashed.
+  void reserve(size_t NumEntries) {
+    size_t NewCapacity = capacityFor(NumEntries);
+    if (NewCapacity > Capacity)
+      rehash(NewCapacity);
+  }
+
+  /// Erase all the entries, but keep the memory allocated for them.
+  void clear() {
+    if (!Capacity)
+      return;
+    destroySlots();
+    std::memset(Ctrl, FlatHashCtrlEmpty, Capacity + Group::Width);
+    Size = 0;
+    GrowthLeft = maxLoad(Capacity);
+  }
+
+  iterator find(const KeyT &Key) {
+    size_t Idx;
+    return findIndex(Key, Idx) ? iteratorAt(Idx) : end();
+  }
+  const_iterator find(const KeyT &Key) const {
+    size_t Idx;
+    if (!findIndex(Key, Idx))
+      return end();
+    return const_iterator(Ctrl + Idx, Ctrl + Capacity, Slots + Idx,
+                          typename const_iterator::FullSlotTag());
+  }
+
+  /// Return 1 if the specified key is in the table, 0 otherwise.
+  size_type count(const KeyT &Key) const {
+    size_t Idx;
+    return findIndex(Key, Idx) ? 1 : 0;
+  }
+
+  bool erase(const KeyT &Key) {
+    size_t Idx;
+    if (!findIndex(Key, Idx))
+      return false;
+    eraseIndex(Idx);
+    return true;
+  }
+  /// Erase the entry at \p I. Other iterators remain valid.
+  void erase(iterator I) { eraseIndex(I.Slot - Slots); }
+
+  void swap(FlatHashTable &RHS) {
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Slots, RHS.Slots);
+    std::swap(Capacity, RHS.Capacity);
+    std::swap(Size, RHS.Size);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  /// Return the approximate size (in bytes) of the actual table.
+  /// If entries are pointers to objects, the sizes of the referenced objects
+  /// are not included.
+  size_t getMemorySize() const {
+    return Capacity ? allocationSize(Capacity) : 0;
+  }
+
+protected:
+  /// Look up \p Key, and if it is not in the table, insert a slot constructed
+  /// from \p Args, which must hold a key equal to \p Key.
+  template <typename... Ts>
+  std::pair<iterator, bool> emplaceKey(const KeyT &Key, Ts &&... Args) {
+    uint64_t Hash = mixHash(KeyInfoT::getHashValue(Key));
+    size_t Idx;
+    if (findIndex(Key, Hash, Idx))
+      return {iteratorAt(Idx), false};
+    if (!Capacity)
+      grow();
+    Idx = findInsertIndex(Hash);
+    if (Ctrl[Idx] == FlatHashCtrlEmpty && GrowthLeft == 0) {
+      grow();
+      Idx = findInsertIndex(Hash);
+    }
+    ::new (&Slots[Idx]) SlotT(std::forward<Ts>(Args)...);
+    // Reusing a deleted slot doesn't bring the table closer to needing a
+    // rehash: probe sequences already had to skip it.
+    if (Ctrl[Idx] == FlatHashCtrlEmpty)
+      --GrowthLeft;
+    setCtrl(Idx, h2(Hash));
+    ++Size;
+    return {iteratorAt(Idx), true};
+  }
+
+private:
+  /// Spread the bits of the DenseMapInfo hash, which is often weak (e.g. for
+  /// pointers), across a 64-bit value.
+  static uint64_t mixHash(unsigned Hash) {
+    return static_cast<uint64_t>(Hash) * 0x9E3779B97F4A7C15ULL;
+  }
+  /// The bits of the hash that select the first slot to probe.
+  static size_t h1(uint64_t Hash) { return static_cast<size_t>(Hash >> 25); }
+  /// The bits of the hash that are stored in the control byte of full slots.
+  static int8_t h2(uint64_t Hash) { return static_cast<int8_t>(Hash >> 57); }
+
+  /// The number of entries (full or deleted slots) that a table of the given
+  /// capacity can hold before being rehashed.
+  static size_t maxLoad(size_t Capacity) { return Capacity - Capacity / 8; }
+
+  static size_t capacityFor(size_t NumEntries) {
+    if (!NumEntries)
+      return 0;
+    size_t NewCapacity = Group::Width;
+    while (maxLoad(NewCapacity) < NumEntries)
+      NewCapacity *= 2;
+    return NewCapacity;
+  }
+
+  iterator iteratorAt(size_t Idx) {
+    return iterator(Ctrl + Idx, Ctrl + Capacity, Slots + Idx,
+                    typename iterator::FullSlotTag());
+  }
+
+  void setCtrl(size_t Idx, int8_t Value) {
+    Ctrl[Idx] = Value;
+    if (Idx < Group::Width)
+      Ctrl[Capacity + Idx] = Value;
+  }
+
+  bool findIndex(const KeyT &Key, size_t &Idx) const {
+    if (!Capacity)
+      return false;
+    return findIndex(Key, mixHash(KeyInfoT::getHashValue(Key)), Idx);
+  }
+
+  bool findIndex(const KeyT &Key, uint64_t Hash, size_t &Idx) const {
+    if (!Capacity)
+      return false;
+    size_t Mask = Capacity - 1;
+    size_t Pos = h1(Hash) & Mask;
+    // Triangular probing over groups visits every group of a power of two
+    // sized table.
+    for (size_t Step = Group::Width;; Step += Group::Width) {
+      Group G(Ctrl + Pos);
+      for (unsigned I : G.match(h2(Hash))) {
+        size_t Candidate = (Pos + I) & Mask;
+        if (LLVM_LIKELY(
+                KeyInfoT::isEqual(GetKeyT::getKey(Slots[Candidate]), Key))) {
+          Idx = Candidate;
+          return true;
+        }
+      }
+      // The key would have been inserted in the empty slot.
+      if (LLVM_LIKELY(G.matchEmpty()))
+        return false;
+      Pos = (Pos + Step) & Mask;
+    }
+  }
+
+  /// Returns the first empty or deleted slot in the probe sequence of \p Hash.
+  size_t findInsertIndex(uint64_t Hash) const {
+    size_t Mask = Capacity - 1;
+    size_t Pos = h1(Hash) & Mask;
+    for (size_t Step = Group::Width;; Step += Group::Width) {
+      if (auto Unused = Group(Ctrl + Pos).matchEmptyOrDeleted())
+        return (Pos + Unused.lowest()) & Mask;
+      Pos = (Pos + Step) & Mask;
+    }
+  }
+
+  void eraseIndex(size_t Idx) {
+    assert(Ctrl[Idx] >= 0 && "erasing an unused slot");
+    Slots[Idx].~SlotT();
+    setCtrl(Idx, FlatHashCtrlDeleted);
+    --Size;
+  }
+
+  /// Make room for at least one more entry. If most slots in use are deleted,
+  /// rehash into a table of the same size to drop them.
+  void grow() {
+    // Like DenseMap, start with 64 slots unless a size was reserved: growing
+    // tiny tables dominates the cost of filling them.
+    if (!Capacity)
+      rehash(64);
+    else if (Size * 2 < maxLoad(Capacity))
+      rehash(Capacity);
+    else
+      rehash(Capacity * 2);
+  }
+
+  void rehash(size_t NewCapacity) {
+    const int8_t *OldCtrl = Ctrl;
+    SlotT *OldSlots = Slots;
+    size_t OldCapacity = Capacity;
+    allocate(NewCapacity);
+    for (size_t I = 0; I != OldCapacity; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      uint64_t Hash =
+          mixHash(KeyInfoT::getHashValue(GetKeyT::getKey(OldSlots[I])));
+      size_t Idx = findInsertIndex(Hash);
+      ::new (&Slots[Idx]) SlotT(std::move(OldSlots[I]));
+      OldSlots[I].~SlotT();
+      setCtrl(Idx, h2(Hash));
+    }
+    GrowthLeft -= Size;
+    deallocate(OldSlots, OldCapacity);
+  }
+
+  /// The slots and the control bytes share an allocation, slots first.
+  static size_t allocationSize(size_t Capacity) {
+    return sizeof(SlotT) * Capacity + Capacity + Group::Width;
+  }
+
+  void allocate(size_t NewCapacity) {
+    assert(isPowerOf2_64(NewCapacity) && NewCapacity >= Group::Width);
+    Capacity = NewCapacity;
+    Slots = static_cast<SlotT *>(
+        allocate_buffer(allocationSize(Capacity), alignof(SlotT)));
+    Ctrl = reinterpret_cast<int8_t *>(Slots + Capacity);
+    std::memset(Ctrl, FlatHashCtrlEmpty, Capacity + Group::Width);
+    GrowthLeft = maxLoad(Capacity);
+  }
+
+  static void deallocate(SlotT *Slots, size_t Capacity) {
+    if (Capacity)
+      deallocate_buffer(Slots, allocationSize(Capacity), alignof(SlotT));
+  }
+
+  void destroySlots() {
+    if (std::is_trivially_destructible<SlotT>::value)
+      return;
+    for (size_t I = 0; I != Capacity; ++I)
+      if (Ctrl[I] >= 0)
+        Slots[I].~SlotT();
+  }
+
+  void destroyAll() {
+    destroySlots();
+    deallocate(Slots, Capacity);
+    Ctrl = nullptr;
+    Slots = nullptr;
+    Capacity = 0;
+    Size = 0;
+    GrowthLeft = 0;
+  }
+
+  void copyFrom(const FlatHashTable &Other) {
+    if (!Other.Capacity)
+      return;
+    allocate(Other.Capacity);
+    // The same capacity gives the same layout, so copy it as is.
+    std::memcpy(Ctrl, Other.Ctrl, Capacity + Group::Width);
+    for (size_t I = 0; I != Capacity; ++I)
+      if (Ctrl[I] >= 0)
+        ::new (&Slots[I]) SlotT(Other.Slots[I]);
+    Size = Other.Size;
+    GrowthLeft = Other.GrowthLeft;
+  }
+
+  int8_t *Ctrl = nullptr;
+  SlotT *Slots = nullptr;
+  size_t Capacity = 0;
+  unsigned Size = 0;
+  /// The number of empty slots that can still be used before rehashing.
+  size_t GrowthLeft = 0;
+};
+
+} // end namespace detail
+
+/// A hash map with the interface of DenseMap, that is faster for large tables
+/// and doesn't reserve any key values. Inserting invalidates iterators and
+/// references, erasing only invalidates those to the erased entry.
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap
+    : public detail::FlatHashTable<detail::DenseMapPair<KeyT, ValueT>, KeyT,
+                                   KeyInfoT, detail::FlatHashMapGetKey> {
+  using BaseT =
+      detail::FlatHashTable<detail::DenseMapPair<KeyT, ValueT>, KeyT,
+                            KeyInfoT, detail::FlatHashMapGetKey>;
+
+public:
+  using mapped_type = ValueT;
+  using iterator = typename BaseT::iterator;
+  using const_iterator = typename BaseT::const_iterator;
+
+  FlatHashMap() = default;
+
+  /// Create a FlatHashMap that can hold \p InitialReserve entries without
+  /// growing.
+  explicit FlatHashMap(unsigned InitialReserve) {
+    this->reserve(InitialReserve);
+  }
+
+  FlatHashMap(std::initializer_list<typename BaseT::value_type> Vals) {
+    this->reserve(Vals.size());
+    for (const auto &KV : Vals)
+      insert(KV);
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const KeyT &Key) const {
+    auto I = this->find(Key);
+    return I == this->end() ? ValueT() : I->getSecond();
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // The value is constructed in-place if the key is not in the map, otherwise
+  // it is not moved.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&... Args) {
+    return this->emplaceKey(Key, std::piecewise_construct,
+                            std::forward_as_tuple(Key),
+                            std::forward_as_tuple(std::forward<Ts>(Args)...));
+  }
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&... Args) {
+    return this->emplaceKey(Key, std::piecewise_construct,
+                            std::forward_as_tuple(std::move(Key)),
+                            std::forward_as_tuple(std::forward<Ts>(Args)...));
+  }
+
+  ValueT &operator[](const KeyT &Key) {
+    return try_emplace(Key).first->getSecond();
+  }
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->getSecond();
+  }
+};
+
+/// A hash set with the interface of DenseSet, implemented like FlatHashMap.
+template <typename ValueT, typename ValueInfoT = DenseMapInfo<ValueT>>
+class FlatHashSet : public detail::FlatHashTable<ValueT, ValueT, ValueInfoT,
+                                                 detail::FlatHashSetGetKey> {
+  using BaseT = detail::FlatHashTable<ValueT, ValueT, ValueInfoT,
+                                      detail::FlatHashSetGetKey>;
+
+public:
+  using iterator = typename BaseT::iterator;
+  using const_iterator = typename BaseT::const_iterator;
+
+  FlatHashSet() = default;
+
+  explicit FlatHashSet(unsigned InitialReserve) {
+    this->reserve(InitialReserve);
+  }
+
+  FlatHashSet(std::initializer_list<ValueT> Elems) {
+    this->reserve(Elems.size());
+    insert(Elems.begin(), Elems.end());
+  }
+
+  template <typename InputIt> FlatHashSet(const InputIt &I, const InputIt &E) {
+    insert(I, E);
+  }
+
+  std::pair<iterator, bool> insert(const ValueT &V) {
+    return this->emplaceKey(V, V);
+  }
+  std::pair<iterator, bool> insert(ValueT &&V) {
+    return this->emplaceKey(V, std::move(V));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_FLATHASHMAP_H
@@ -336,6 +336,13 @@ struct CGSCCUpdateResult {
 /// \c CGSCCAnalysisManagerModuleProxy analysis prior to running the CGSCC
 /// pass over the module to enable a \c FunctionAnalysisManager to be used
 /// within this run safely.
+///
+/// The SCCs are visited one at a time, even when they do not call each other.
+/// Transforming two SCCs concurrently would race on the use-lists of the
+/// constants, globals and metadata they share (see \c LLVMContext), on the
+/// analysis managers, and on the \c LazyCallGraph, whose RefSCCs may be split
+/// or merged by any update. Clients wanting parallelism across a module can
+/// split it and optimize the parts in separate contexts, as ThinLTO does.
 class ModuleToPostOrderCGSCCPassAdaptor
     : public PassInfoMixin<ModuleToPostOrderCGSCCPassAdaptor> {
 public:
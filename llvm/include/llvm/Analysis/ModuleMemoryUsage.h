@@ -0,0 +1,102 @@
+//=- ModuleMemoryUsage.h - Estimate the memory used by a module --*- C++ -*-=//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the ModuleMemoryUsage and ModuleMemoryUsageAnalysis
+// classes, which estimate how much memory the IR of a module takes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_MODULEMEMORYUSAGE_H
+#define LLVM_ANALYSIS_MODULEMEMORYUSAGE_H
+
+#include "llvm/IR/PassManager.h"
+#include <cstdint>
+
+namespace llvm {
+class Module;
+class raw_ostream;
+
+/// An estimate of the memory taken by the IR objects of a module, broken down
+/// by kind. The sizes are the sizeof of the objects and of their operands,
+/// they don't include allocator overhead, attributes or metadata other than
+/// debug locations.
+///
+/// Constants and debug locations are owned by the LLVMContext and may be
+/// shared with other modules, the ones used by the module are counted here
+/// anyway.
+class ModuleMemoryUsage {
+public:
+  static ModuleMemoryUsage compute(const Module &M);
+
+  void print(raw_ostream &OS) const;
+
+  /// The total of all the sizes below.
+  uint64_t getTotalBytes() const;
+
+  uint64_t Functions = 0;
+  uint64_t FunctionBytes = 0;
+
+  uint64_t Arguments = 0;
+  uint64_t ArgumentBytes = 0;
+
+  uint64_t BasicBlocks = 0;
+  uint64_t BasicBlockBytes = 0;
+
+  /// Global variables, aliases and ifuncs.
+  uint64_t GlobalValues = 0;
+  uint64_t GlobalValueBytes = 0;
+
+  /// The instructions, not counting their operands.
+  uint64_t Instructions = 0;
+  uint64_t InstructionBytes = 0;
+
+  /// The distinct constants used by the module, not counting their operands.
+  uint64_t Constants = 0;
+  uint64_t ConstantBytes = 0;
+
+  /// The operands of all the users above.
+  uint64_t Uses = 0;
+  uint64_t UseBytes = 0;
+
+  /// The part of UseBytes taken by the links of the use-lists.
+  uint64_t UseListBytes = 0;
+
+  /// The names of the values and their symbol table entries.
+  uint64_t NameBytes = 0;
+
+  /// The distinct DILocations attached to instructions, including the ones
+  /// they were inlined at.
+  uint64_t DILocations = 0;
+  uint64_t DILocationBytes = 0;
+};
+
+/// Analysis pass computing ModuleMemoryUsage.
+class ModuleMemoryUsageAnalysis
+    : public AnalysisInfoMixin<ModuleMemoryUsageAnalysis> {
+  friend AnalysisInfoMixin<ModuleMemoryUsageAnalysis>;
+  static AnalysisKey Key;
+
+public:
+  using Result = ModuleMemoryUsage;
+
+  Result run(Module &M, ModuleAnalysisManager &MAM);
+};
+
+/// Printer pass for the ModuleMemoryUsageAnalysis results.
+class ModuleMemoryUsagePrinterPass
+    : public PassInfoMixin<ModuleMemoryUsagePrinterPass> {
+  raw_ostream &OS;
+
+public:
+  explicit ModuleMemoryUsagePrinterPass(raw_ostream &OS) : OS(OS) {}
+
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &MAM);
+};
+
+} // namespace llvm
+#endif // LLVM_ANALYSIS_MODULEMEMORYUSAGE_H
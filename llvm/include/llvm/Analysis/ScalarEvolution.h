@@ -1059,6 +1059,11 @@ public:
                            const SCEV *ElementSize);
 
   void print(raw_ostream &OS) const;
+
+  /// Print the number of entries in each of the memoization tables, to help
+  /// diagnose the memory usage of the analysis on large functions.
+  void printCacheSizes(raw_ostream &OS) const;
+
   void verify() const;
   bool invalidate(Function &F, const PreservedAnalyses &PA,
                   FunctionAnalysisManager::Invalidator &Inv);
@@ -1539,17 +1544,11 @@ private:
   /// Used to parameterize getRange
   enum RangeSignHint { HINT_RANGE_UNSIGNED, HINT_RANGE_SIGNED };
 
-  /// Set the memoized range for the given SCEV.
+  /// Set the memoized range for the given SCEV. If this would grow the range
+  /// caches past -scalar-evolution-max-range-cache-entries, they are flushed
+  /// first.
   const ConstantRange &setRange(const SCEV *S, RangeSignHint Hint,
-                                ConstantRange CR) {
-    DenseMap<const SCEV *, ConstantRange> &Cache =
-        Hint == HINT_RANGE_UNSIGNED ? UnsignedRanges : SignedRanges;
-
-    auto Pair = Cache.try_emplace(S, std::move(CR));
-    if (!Pair.second)
-      Pair.first->second = std::move(CR);
-    return Pair.first->second;
-  }
+                                ConstantRange CR);
 
   /// Determine the range for a particular SCEV.
   /// NOTE: This returns a reference to an entry in a cache. It must be
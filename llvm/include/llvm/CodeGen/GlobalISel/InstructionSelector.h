@@ -404,6 +404,11 @@ enum {
   /// - RuleID - The ID of the rule that was covered.
   GIR_Coverage,
 
+  /// Attribute the opcodes executed until the rule is rejected or done to
+  /// the rule's profile counter.
+  /// - RuleID - The ID of the rule being tried.
+  GIR_ProfileRule,
+
   /// Keeping track of the number of the GI opcodes. Must be the last entry.
   GIU_NumOpcodes,
 };
@@ -63,10 +63,24 @@ bool InstructionSelector::executeMatchTable(
 
   const uint16_t Flags = State.MIs[0]->getFlags();
 
+  // The rule GIR_ProfileRule started counting for, if any, and the number of
+  // opcodes it executed so far. Opcodes are only counted within a profiled
+  // rule, so tables generated without profiling never touch the counter.
+  int64_t ProfiledRuleID = -1;
+  uint64_t ProfiledRuleOpcodes = 0;
+  auto endProfiledRule = [&]() {
+    if (ProfiledRuleID < 0)
+      return;
+    CoverageInfo.addExecutedOpcodes(ProfiledRuleID, ProfiledRuleOpcodes);
+    ProfiledRuleID = -1;
+  };
+
   enum RejectAction { RejectAndGiveUp, RejectAndResume };
   auto handleReject = [&]() -> RejectAction {
     DEBUG_WITH_TYPE(TgtInstructionSelector::getName(),
                     dbgs() << CurrentIdx << ": Rejected\n");
+    // Rules do not nest try-blocks, so a rejection always leaves the rule.
+    endProfiledRule();
     if (OnFailResumeAt.empty())
       return RejectAndGiveUp;
     CurrentIdx = OnFailResumeAt.pop_back_val();
@@ -92,6 +106,8 @@ bool InstructionSelector::executeMatchTable(
   while (true) {
     assert(CurrentIdx != ~0u && "Invalid MatchTable index");
     int64_t MatcherOpcode = MatchTable[CurrentIdx++];
+    if (ProfiledRuleID >= 0)
+      ++ProfiledRuleOpcodes;
     switch (MatcherOpcode) {
     case GIM_Try: {
       DEBUG_WITH_TYPE(TgtInstructionSelector::getName(),
@@ -1135,9 +1151,22 @@ bool InstructionSelector::executeMatchTable(
       break;
     }
 
+    case GIR_ProfileRule: {
+      int64_t RuleID = MatchTable[CurrentIdx++];
+      endProfiledRule();
+      ProfiledRuleID = RuleID;
+      ProfiledRuleOpcodes = 0;
+
+      DEBUG_WITH_TYPE(TgtInstructionSelector::getName(),
+                      dbgs() << CurrentIdx << ": GIR_ProfileRule(" << RuleID
+                             << ")\n");
+      break;
+    }
+
     case GIR_Done:
       DEBUG_WITH_TYPE(TgtInstructionSelector::getName(),
                       dbgs() << CurrentIdx << ": GIR_Done\n");
+      endProfiledRule();
       propagateFlags(OutMIs);
       return true;
 
@@ -362,6 +362,16 @@ private:
   /// This stack is maintained by DAGUpdateListener RAII.
   DAGUpdateListener *UpdateListeners = nullptr;
 
+  /// The nodes created or modified since startTrackingModifiedNodes() was
+  /// last called, if TrackModifiedNodes is set.
+  DenseSet<SDNode *> ModifiedNodes;
+  bool TrackModifiedNodes = false;
+
+  void noteModifiedNode(SDNode *N) {
+    if (TrackModifiedNodes)
+      ModifiedNodes.insert(N);
+  }
+
   /// Implementation of setSubgraphColor.
   /// Return whether we had to truncate the search.
   bool setSubgraphColorHelper(SDNode *N, const char *Color,
@@ -541,6 +551,17 @@ public:
   void Combine(CombineLevel Level, AAResults *AA,
                CodeGenOpt::Level OptLevel);
 
+  /// Start recording the nodes that are created, or whose operands are
+  /// changed, from now on, forgetting the ones recorded so far. This lets a
+  /// later Combine revisit only the nodes that changed since the previous one.
+  /// Tracking stops when the DAG is cleared.
+  void startTrackingModifiedNodes() {
+    ModifiedNodes.clear();
+    TrackModifiedNodes = true;
+  }
+  bool isTrackingModifiedNodes() const { return TrackModifiedNodes; }
+  bool isModifiedNode(SDNode *N) const { return ModifiedNodes.count(N); }
+
   /// This transforms the SelectionDAG into a SelectionDAG that
   /// only uses types natively supported by the target.
   /// Returns "true" if it made any changes.
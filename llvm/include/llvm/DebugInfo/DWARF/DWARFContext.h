@@ -230,6 +230,12 @@ public:
     return DWOUnits.getNumTypesUnits();
   }
 
+  /// Extract the DIEs of all the units in this context, using up to
+  /// \p NumThreads threads (0 means one per hardware thread). Clients that
+  /// walk every unit, like the verifier, can call this first so that the
+  /// units are parsed concurrently rather than on first use.
+  void extractAllUnitDIEs(unsigned NumThreads = 0);
+
   /// Get the unit at the specified index.
   DWARFUnit *getUnitAtIndex(unsigned index) {
     parseNormalUnits();
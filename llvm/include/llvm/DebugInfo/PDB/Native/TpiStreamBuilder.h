@@ -23,6 +23,7 @@
 
 namespace llvm {
 class BinaryByteStream;
+class BinaryStreamWriter;
 class WritableBinaryStreamRef;
 
 template <> struct BinaryItemTraits<llvm::codeview::CVType> {
@@ -71,6 +72,7 @@ private:
   uint32_t calculateHashBufferSize() const;
   uint32_t calculateIndexOffsetSize() const;
   Error finalize();
+  Error commitHashValues(BinaryStreamWriter &Writer) const;
 
   msf::MSFBuilder &Msf;
   BumpPtrAllocator &Allocator;
@@ -83,7 +85,6 @@ private:
   std::vector<uint32_t> TypeHashes;
   std::vector<codeview::TypeIndexOffset> TypeIndexOffsets;
   uint32_t HashStreamIndex = kInvalidStreamIndex;
-  std::unique_ptr<BinaryByteStream> HashValueStream;
 
   const TpiStreamHeader *Header;
   uint32_t Idx;
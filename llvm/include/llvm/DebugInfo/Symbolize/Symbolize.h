@@ -13,6 +13,9 @@
 #ifndef LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 #define LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/ilist_node.h"
+#include "llvm/ADT/simple_ilist.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
@@ -20,6 +23,7 @@
 #include "llvm/Support/Error.h"
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -34,6 +38,27 @@ using namespace object;
 using FunctionNameKind = DILineInfoSpecifier::FunctionNameKind;
 using FileLineInfoKind = DILineInfoSpecifier::FileLineInfoKind;
 
+/// A binary loaded by LLVMSymbolizer, together with the actions that drop
+/// the cached state derived from it when it is evicted from the cache.
+class CachedBinary : public ilist_node<CachedBinary> {
+public:
+  OwningBinary<Binary> &operator*() { return Bin; }
+  OwningBinary<Binary> *operator->() { return &Bin; }
+
+  /// Add an action to run when the binary is evicted. Actions run in the
+  /// reverse of the order in which they were added.
+  void pushEvictor(std::function<void()> NewEvictor);
+
+  /// Run the eviction actions.
+  void evict();
+
+  size_t size() { return Bin.getBinary()->getData().size(); }
+
+private:
+  OwningBinary<Binary> Bin;
+  std::function<void()> Evictor;
+};
+
 class LLVMSymbolizer {
 public:
   struct Options {
@@ -49,6 +74,9 @@ public:
     std::string FallbackDebugPath;
     std::string DWPName;
     std::vector<std::string> DebugFileDirectory;
+    /// The total size of the binaries kept loaded by pruneCache().
+    size_t MaxCacheSize =
+        sizeof(size_t) == 4 ? 512ULL * 1024 * 1024 : 4ULL * 1024 * 1024 * 1024;
   };
 
   LLVMSymbolizer() = default;
@@ -81,6 +109,12 @@ public:
                  object::SectionedAddress ModuleOffset);
   void flush();
 
+  /// Evict the least recently used binaries, and everything loaded from them,
+  /// until the loaded binaries fit in Options::MaxCacheSize. The most recently
+  /// used binary is always kept. Long-running clients can call this between
+  /// queries to bound their memory use.
+  void pruneCache();
+
   static std::string
   DemangleName(const std::string &Name,
                const SymbolizableModule *DbiModuleDescriptor);
@@ -90,6 +124,12 @@ private:
   // corresponding debug info. These objects can be the same.
   using ObjectPair = std::pair<const ObjectFile *, const ObjectFile *>;
 
+  /// A symbolizable module and the objects it was created from.
+  struct CachedModule {
+    std::unique_ptr<SymbolizableModule> Module;
+    ObjectPair Objects;
+  };
+
   template <typename T>
   Expected<DILineInfo>
   symbolizeCodeCommon(const T &ModuleSpecifier,
@@ -119,6 +159,14 @@ private:
                    std::unique_ptr<DIContext> Context,
                    StringRef ModuleName);
 
+  /// Returns the cached binary that owns \p Obj, or null if \p Obj was not
+  /// loaded by this symbolizer.
+  CachedBinary *getCachedBinary(const ObjectFile *Obj);
+
+  /// Mark the binaries owning \p Objects as the most recently used.
+  void recordAccess(const ObjectPair &Objects);
+  void recordAccess(CachedBinary &Bin);
+
   ObjectFile *lookUpDsymFile(const std::string &Path,
                              const MachOObjectFile *ExeObj,
                              const std::string &ArchName);
@@ -139,15 +187,23 @@ private:
   Expected<ObjectFile *> getOrCreateObject(const std::string &Path,
                                           const std::string &ArchName);
 
-  std::map<std::string, std::unique_ptr<SymbolizableModule>, std::less<>>
-      Modules;
+  std::map<std::string, CachedModule, std::less<>> Modules;
 
   /// Contains cached results of getOrCreateObjectPair().
   std::map<std::pair<std::string, std::string>, ObjectPair>
       ObjectPairForPathArch;
 
   /// Contains parsed binary for each path, or parsing error.
-  std::map<std::string, OwningBinary<Binary>> BinaryForPath;
+  std::map<std::string, CachedBinary> BinaryForPath;
+
+  /// The cached binary owning each object file returned by
+  /// getOrCreateObject().
+  DenseMap<const ObjectFile *, CachedBinary *> BinaryForObject;
+
+  /// The loaded binaries, from least to most recently used, and their total
+  /// size.
+  simple_ilist<CachedBinary> LRUBinaries;
+  size_t CacheSize = 0;
 
   /// Parsed object file for path/architecture pair, where "path" refers
   /// to Mach-O universal binary.
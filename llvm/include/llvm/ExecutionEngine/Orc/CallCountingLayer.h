@@ -0,0 +1,77 @@
+//===- CallCountingLayer.h - Detect hot functions at runtime ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An IR layer that counts the calls to the functions it emits, and reports
+// the ones that become hot.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_CALLCOUNTINGLAYER_H
+#define LLVM_EXECUTIONENGINE_ORC_CALLCOUNTINGLAYER_H
+
+#include "llvm/ADT/FunctionExtras.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+namespace orc {
+
+/// Instruments every function with external linkage defined in the modules it
+/// emits with a call counter, and calls a handler, once per function, when the
+/// function has been called HotThreshold times.
+///
+/// This is the profiling half of tiered compilation: the modules are compiled
+/// quickly first, and the handler can recompile the hot functions with more
+/// optimization, then redirect their stubs to the new bodies with
+/// IndirectStubsManager::updatePointer.
+///
+/// The handler runs on the thread of the JIT'd code that made the call, and
+/// may run concurrently from several threads; it should hand the actual
+/// recompilation off to another thread.
+class CallCountingLayer : public IRLayer {
+public:
+  /// Called with the JITDylib and the mangled name of a function that became
+  /// hot.
+  using HotFunctionHandler =
+      unique_function<void(JITDylib &JD, SymbolStringPtr Name)>;
+
+  CallCountingLayer(ExecutionSession &ES, IRLayer &BaseLayer,
+                    MangleAndInterner &Mangle, uint64_t HotThreshold,
+                    HotFunctionHandler OnHotFunction);
+
+  /// Define the symbols the instrumentation calls (__orc_call_counter and
+  /// __orc_hot_function) in the given JITDylib.
+  Error addRuntime(JITDylib &JD);
+
+  void emit(std::unique_ptr<MaterializationResponsibility> R,
+            ThreadSafeModule TSM) override;
+
+private:
+  static void hotFunctionEntryPoint(CallCountingLayer *Layer,
+                                    uint64_t FunctionId);
+
+  IRLayer &BaseLayer;
+  MangleAndInterner &Mangle;
+  uint64_t HotThreshold;
+  HotFunctionHandler OnHotFunction;
+
+  /// The instrumented functions, indexed by the id passed to
+  /// __orc_hot_function.
+  std::mutex FunctionsMutex;
+  std::vector<std::pair<JITDylib *, SymbolStringPtr>> Functions;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_CALLCOUNTINGLAYER_H
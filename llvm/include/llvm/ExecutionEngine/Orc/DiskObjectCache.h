@@ -0,0 +1,70 @@
+//===- DiskObjectCache.h - Persistent cache of JIT'd objects ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps the objects compiled by the JIT in a directory, so
+// that they can be reused across processes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_DISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_DISKOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+/// An ObjectCache that stores objects in a directory, under a key computed
+/// from the bitcode of the module and from the target configuration of the
+/// compiler: a module is found in the cache only if it was compiled, by any
+/// process, from the same IR for the same target, CPU, features, relocation
+/// model, code model and optimization level.
+///
+/// The key is computed when the compiler asks for a module in getObject, before
+/// code generation changes the module, and reused when the compiled object is
+/// stored by notifyObjectCompiled.
+///
+/// Entries are written atomically, so one cache directory can be shared by
+/// concurrent compile threads and processes. Failures to read or write the
+/// cache are not errors: the module is simply compiled.
+class DiskObjectCache : public ObjectCache {
+public:
+  /// Create a cache in CacheDir, which is created if it does not exist, for
+  /// objects compiled by the given target machine builder.
+  static Expected<std::unique_ptr<DiskObjectCache>>
+  Create(StringRef CacheDir, const JITTargetMachineBuilder &JTMB);
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+private:
+  DiskObjectCache(StringRef CacheDir, std::string TargetKey);
+
+  /// Returns the path of the cache entry for M.
+  SmallString<128> getEntryPath(const Module &M) const;
+
+  std::string CacheDir;
+  std::string TargetKey;
+
+  /// Entry paths of the modules that missed the cache and are being compiled.
+  std::mutex PendingEntriesMutex;
+  DenseMap<const Module *, SmallString<128>> PendingEntries;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_DISKOBJECTCACHE_H
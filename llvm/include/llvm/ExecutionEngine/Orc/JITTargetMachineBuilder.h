@@ -79,6 +79,9 @@ public:
     return *this;
   }
 
+  /// Get the CPU string.
+  const std::string &getCPU() const { return CPU; }
+
   /// Set the relocation model.
   JITTargetMachineBuilder &setRelocationModel(Optional<Reloc::Model> RM) {
     this->RM = std::move(RM);
@@ -103,6 +106,9 @@ public:
     return *this;
   }
 
+  /// Get the LLVM CodeGen optimization level.
+  CodeGenOpt::Level getCodeGenOptLevel() const { return OptLevel; }
+
   /// Set subtarget features.
   JITTargetMachineBuilder &setFeatures(StringRef FeatureString) {
     Features = SubtargetFeatures(FeatureString);
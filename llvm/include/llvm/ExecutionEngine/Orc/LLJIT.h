@@ -268,6 +268,7 @@ public:
   PlatformSetupFunction SetUpPlatform;
   unsigned NumCompileThreads = 0;
   TargetProcessControl *TPC = nullptr;
+  ObjectCache *ObjCache = nullptr;
 
   /// Called prior to JIT class construcion to fix up defaults.
   Error prepareForConstruction();
@@ -350,6 +351,16 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache to query before compiling, e.g. a DiskObjectCache to
+  /// reuse the objects compiled by previous runs.
+  ///
+  /// The cache is used by the default compile function only, and must outlive
+  /// the JIT.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set a TargetProcessControl object.
   ///
   /// If the platform uses ObjectLinkingLayer by default and no
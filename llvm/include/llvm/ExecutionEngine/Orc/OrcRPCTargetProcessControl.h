@@ -19,6 +19,8 @@
 #include "llvm/ExecutionEngine/Orc/TargetProcessControl.h"
 #include "llvm/Support/MSVCErrorWorkarounds.h"
 
+#include <mutex>
+
 namespace llvm {
 namespace orc {
 
@@ -98,27 +100,35 @@ public:
                  << " -> target " << formatv("{0:x16}", B.Address) << "\n";
         }
       });
-      if (auto Err =
-              Parent.Parent.getMemoryAccess().writeBuffers(BufferWrites)) {
-        OnFinalize(std::move(Err));
-        return;
-      }
+
+      // Don't wait for the writes to complete before requesting finalization:
+      // the remote handles calls in order, so the content is in place before
+      // permissions are applied, and the link only pays for one round trip.
+      auto WriteResultP = std::make_shared<WriteResult>();
+      auto WriteResultF = WriteResultP->P.get_future();
+      Parent.Parent.getMemoryAccess().writeBuffers(
+          BufferWrites,
+          [WriteResultP](Error Err) { WriteResultP->set(std::move(Err)); });
 
       DEBUG_WITH_TYPE("orc", dbgs() << " Applying permissions...\n");
       if (auto Err =
               Parent.getEndpoint().template callAsync<orcrpctpc::FinalizeMem>(
-                  [OF = std::move(OnFinalize)](Error Err2) {
+                  [OF = std::move(OnFinalize),
+                   WF = std::move(WriteResultF)](Error Err2) mutable {
                     // FIXME: Dispatch to work queue.
-                    std::thread([OF = std::move(OF),
+                    std::thread([OF = std::move(OF), WF = std::move(WF),
                                  Err3 = std::move(Err2)]() mutable {
                       DEBUG_WITH_TYPE(
                           "orc", { dbgs() << "  finalizeAsync complete\n"; });
-                      OF(std::move(Err3));
+                      OF(joinErrors(WF.get(), std::move(Err3)));
                     }).detach();
                     return Error::success();
                   },
                   FMR)) {
         DEBUG_WITH_TYPE("orc", dbgs() << "    failed.\n");
+        // Don't leave the continuation waiting for a write response that may
+        // never arrive.
+        WriteResultP->set(make_error<shared::ResponseAbandoned>());
         Parent.getEndpoint().abandonPendingResponses();
         Parent.reportError(std::move(Err));
       }
@@ -140,6 +150,20 @@ public:
     }
 
   private:
+    /// The result of the content writes of finalizeAsync. It is set by the
+    /// write's completion handler, or with an error if the finalize request
+    /// can't be sent, whichever comes first.
+    struct WriteResult {
+      std::promise<MSVCPError> P;
+      std::once_flag IsSet;
+
+      void set(Error Err) {
+        std::call_once(IsSet, [&]() { P.set_value(std::move(Err)); });
+        // Only the first result is kept.
+        consumeError(std::move(Err));
+      }
+    };
+
     OrcRPCTPCJITLinkMemoryManager<OrcRPCTPCImplT> &Parent;
     HostAllocMap HostAllocs;
     TargetAllocMap TargetAllocs;
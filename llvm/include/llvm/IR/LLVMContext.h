@@ -65,6 +65,13 @@ enum {
 /// infrastructure, including the type and constant uniquing tables.
 /// LLVMContext itself provides no locking guarantees, so you should be careful
 /// to have one context per thread.
+///
+/// Locking the uniquing tables would not be enough to share a context between
+/// threads: constants and metadata are shared by all the modules and functions
+/// of the context, and creating or deleting any instruction that uses one of
+/// them updates its use-list. Clients that need to move IR between threads can
+/// either clone it into another context, or serialize all the accesses to a
+/// context, as orc::ThreadSafeContext does.
 class LLVMContext {
 public:
   LLVMContextImpl *const pImpl;
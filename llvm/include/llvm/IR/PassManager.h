@@ -1228,6 +1228,14 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// The functions are visited one at a time. Even with the exclusive access
+/// described above the pipeline cannot run on several functions concurrently:
+/// constants, types and uniqued metadata created by function passes live in the
+/// module's LLVMContext, which is not thread-safe, and all function analyses
+/// are cached in the one FunctionAnalysisManager. To use several threads,
+/// partition the module with SplitModule and process each partition in its own
+/// context, as LTO's parallel code generation does.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
@@ -7,28 +7,35 @@
 //===----------------------------------------------------------------------===//
 //
 // This file provides hashing of the LLVM IR structure to be used to check
-// Passes modification status.
+// Passes modification status, and to fingerprint functions.
 //
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_IR_STRUCTURALHASH_H
 #define LLVM_IR_STRUCTURALHASH_H
 
-#ifdef EXPENSIVE_CHECKS
-
 #include <cstdint>
 
-// This header is only meant to be used when -DEXPENSIVE_CHECKS is set
 namespace llvm {
 
 class Function;
 class Module;
 
-uint64_t StructuralHash(const Function &F);
-uint64_t StructuralHash(const Module &M);
+/// Hash the structure of a function or a module.
+///
+/// By default, only the control flow graph and the opcodes are hashed, which
+/// is what the pass managers compare in EXPENSIVE_CHECKS builds. With
+/// \p DetailedHash, the types and operands of the instructions, the values of
+/// the integer and floating point constants, the names of the referenced
+/// globals, and the predicates and flags of the instructions are hashed too.
+/// This gives a fingerprint that changes with almost every modification a
+/// pass makes. For example, a JIT that keeps its analysis managers alive
+/// across pipeline runs can use it to find the functions whose cached
+/// analyses must be invalidated. Hashes are only comparable within one
+/// process.
+uint64_t StructuralHash(const Function &F, bool DetailedHash = false);
+uint64_t StructuralHash(const Module &M, bool DetailedHash = false);
 
 } // end namespace llvm
 
-#endif
-
 #endif // LLVM_IR_STRUCTURALHASH_H
@@ -7,7 +7,8 @@
 //===----------------------------------------------------------------------===//
 //
 // This file defines the localCache function, which allows clients to add a
-// filesystem cache to ThinLTO.
+// filesystem cache to ThinLTO, optionally backed by an object store that is
+// shared between machines.
 //
 //===----------------------------------------------------------------------===//
 
@@ -27,11 +28,41 @@ namespace lto {
 using AddBufferFn =
     std::function<void(unsigned Task, std::unique_ptr<MemoryBuffer> MB)>;
 
+/// A content-addressed store of native object files that can be shared by
+/// many links, e.g. between the machines of a build fleet. Objects are keyed
+/// by the same ThinLTO cache key as the local cache, so an object fetched from
+/// the store is interchangeable with one built locally.
+///
+/// The store is only a cache: failing to fetch or store an object never fails
+/// the link. Methods may be called from multiple threads concurrently.
+class SharedObjectStore {
+public:
+  virtual ~SharedObjectStore() = default;
+
+  /// Return the object stored under \p Key, or nullptr if there is none.
+  virtual Expected<std::unique_ptr<MemoryBuffer>> fetch(StringRef Key) = 0;
+
+  /// Store \p Object under \p Key.
+  virtual Error store(StringRef Key, MemoryBufferRef Object) = 0;
+};
+
+/// Create a SharedObjectStore that keeps objects as files in the given
+/// directory, e.g. on a network file system. New objects are written to a
+/// temporary file and renamed into place, so concurrent writers are safe. The
+/// directory is created if it does not already exist.
+Expected<std::unique_ptr<SharedObjectStore>>
+createDirectoryObjectStore(StringRef DirectoryPath);
+
 /// Create a local file system cache which uses the given cache directory and
 /// file callback. This function also creates the cache directory if it does not
 /// already exist.
-Expected<NativeObjectCache> localCache(StringRef CacheDirectoryPath,
-                                       AddBufferFn AddBuffer);
+///
+/// If \p Shared is given, it is consulted on a miss in the local cache. Hits
+/// are copied into the local cache, and objects built locally are also added
+/// to \p Shared.
+Expected<NativeObjectCache>
+localCache(StringRef CacheDirectoryPath, AddBufferFn AddBuffer,
+           std::shared_ptr<SharedObjectStore> Shared = nullptr);
 
 } // namespace lto
 } // namespace llvm
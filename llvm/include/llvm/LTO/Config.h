@@ -162,12 +162,21 @@ struct Config {
   /// Specific thinLTO modules to compile.
   std::vector<std::string> ThinLTOModulesToCompile;
 
+  /// If non-zero, the amount of memory in bytes the in-process ThinLTO
+  /// backends may use at once. A backend is only started once its estimated
+  /// memory use fits in the budget next to the backends already running. At
+  /// least one backend always runs, even if its estimate exceeds the budget.
+  uint64_t ThinLTOMemoryBudget = 0;
+
   /// Time trace enabled.
   bool TimeTraceEnabled = false;
 
   /// Time trace granularity.
   unsigned TimeTraceGranularity = 500;
 
+  /// Whether the time trace records the change in heap usage of each section.
+  bool TimeTraceMemory = false;
+
   bool ShouldDiscardValueNames = true;
   DiagnosticHandlerFunction DiagHandler;
 
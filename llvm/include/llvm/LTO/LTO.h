@@ -92,8 +92,12 @@ Expected<std::unique_ptr<ToolOutputFile>>
 setupStatsFile(StringRef StatsFilename);
 
 /// Produces a container ordering for optimal multi-threaded processing. Returns
-/// ordered indices to elements in the input array.
-std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R);
+/// ordered indices to elements in the input array. If \p Costs is given, it
+/// holds an estimate of the backend work for each module; modules are ordered
+/// by decreasing cost, and by decreasing bitcode size among equal costs.
+/// Otherwise only the bitcode size is used.
+std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R,
+                                         ArrayRef<uint64_t> Costs = None);
 
 class LTO;
 struct SymbolResolution;
@@ -329,6 +333,8 @@ private:
     struct AddedModule {
       std::unique_ptr<Module> M;
       std::vector<GlobalValue *> Keep;
+      /// The bitcode that M is lazily loaded from.
+      StringRef Buffer;
     };
     std::vector<AddedModule> ModsWithSummaries;
     bool EmptyCombinedModule = true;
@@ -433,6 +433,10 @@ protected:
   /// Compress DWARF debug sections. Defaults to no compression.
   DebugCompressionType CompressDebugSections = DebugCompressionType::None;
 
+  /// The number of threads used to compress debug sections, or 0 to use all
+  /// the hardware threads. Defaults to compressing them serially.
+  unsigned CompressDebugSectionsThreads = 1;
+
   /// True if the integrated assembler should interpret 'a >> b' constant
   /// expressions as logical rather than arithmetic.
   bool UseLogicalShr = true;
@@ -727,6 +731,14 @@ public:
     this->CompressDebugSections = CompressDebugSections;
   }
 
+  unsigned compressDebugSectionsThreads() const {
+    return CompressDebugSectionsThreads;
+  }
+
+  void setCompressDebugSectionsThreads(unsigned Threads) {
+    CompressDebugSectionsThreads = Threads;
+  }
+
   bool shouldUseLogicalShr() const { return UseLogicalShr; }
 
   bool canRelaxRelocations() const { return RelaxELFRelocations; }
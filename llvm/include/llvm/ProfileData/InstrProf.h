@@ -159,6 +159,18 @@ inline StringRef getInstrProfCounterBiasVarName() {
   return "__llvm_profile_counter_bias";
 }
 
+/// Return the name of the variable holding the number of copies of the
+/// counters of each function, when counters are sharded between threads.
+inline StringRef getInstrProfCounterShardsVarName() {
+  return "__llvm_profile_counter_shards";
+}
+
+/// Return the name of the thread local variable whose address is used to pick
+/// the counter shard of the current thread.
+inline StringRef getInstrProfCounterShardAnchorVarName() {
+  return "__llvm_profile_counter_shard_anchor";
+}
+
 /// Return the marker used to separate PGO names during serialization.
 inline StringRef getInstrProfNameSeparator() { return "\01"; }
 
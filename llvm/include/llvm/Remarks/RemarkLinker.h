@@ -13,6 +13,7 @@
 #ifndef LLVM_REMARKS_REMARKLINKER_H
 #define LLVM_REMARKS_REMARKLINKER_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Remarks/Remark.h"
 #include "llvm/Remarks/RemarkFormat.h"
@@ -63,6 +64,10 @@ public:
   /// metadata. This takes care of uniquing and merging the remarks.
   Error link(StringRef Buffer, Optional<Format> RemarkFormat = None);
 
+  /// Link the remarks found in each of \p Buffers, as if calling the method
+  /// above for each of them in order. The buffers are parsed in parallel.
+  Error link(ArrayRef<StringRef> Buffers, Optional<Format> RemarkFormat = None);
+
   /// Link the remarks found in \p Obj by looking for the right section and
   /// calling the method above.
   Error link(const object::ObjectFile &Obj,
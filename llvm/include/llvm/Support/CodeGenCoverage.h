@@ -11,15 +11,20 @@
 #ifndef LLVM_SUPPORT_CODEGENCOVERAGE_H
 #define LLVM_SUPPORT_CODEGENCOVERAGE_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
 
 namespace llvm {
 class LLVMContext;
 class MemoryBuffer;
+class raw_ostream;
 
 class CodeGenCoverage {
 protected:
   BitVector RuleCoverage;
+  /// The number of match table opcodes each rule executed, indexed by rule ID.
+  SmallVector<uint64_t, 0> RuleOpcodes;
 
 public:
   using const_covered_iterator = BitVector::const_set_bits_iterator;
@@ -30,6 +35,11 @@ public:
   bool isCovered(uint64_t RuleID) const;
   iterator_range<const_covered_iterator> covered() const;
 
+  void addExecutedOpcodes(uint64_t RuleID, uint64_t NumOpcodes);
+  ArrayRef<uint64_t> executedOpcodes() const { return RuleOpcodes; }
+  /// Print " id<RuleID>=<NumOpcodes>" for each rule that executed opcodes.
+  void printExecutedOpcodes(raw_ostream &OS) const;
+
   bool parse(MemoryBuffer &Buffer, StringRef BackendName);
   bool emit(StringRef FilePrefix, StringRef BackendName) const;
   void reset();
@@ -345,7 +345,7 @@ protected:
   inline void setNumAdditionalVals(unsigned n) { AdditionalVals = n; }
 
 public:
-  virtual ~Option() = default;
+  virtual ~Option();
 
   // addArgument - Register this argument with the commandline system.
   //
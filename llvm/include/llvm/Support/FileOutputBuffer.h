@@ -76,6 +76,14 @@ public:
   /// but keeps the memory mapping alive.
   virtual void discard() {}
 
+  /// Tells the buffer that the bytes in [Offset, Offset + Size) have been
+  /// written and are not expected to be accessed again soon, so that the
+  /// memory backing them can be given back to the OS. The contents are not
+  /// lost and the range may still be read or written, at the cost of paging
+  /// it back in. This is a no-op for buffers that are not backed by a file
+  /// mapping.
+  virtual void releaseRange(size_t Offset, size_t Size) {}
+
 protected:
   FileOutputBuffer(StringRef Path) : FinalPath(Path) {}
 
@@ -1221,6 +1221,14 @@ public:
     priv ///< May modify via data, but changes are lost on destruction.
   };
 
+  /// How the mapping is going to be accessed, so that the operating system
+  /// can tune its readahead.
+  enum advice {
+    normal,     ///< No particular access pattern.
+    sequential, ///< Accessed in order, pages may be read far ahead.
+    random      ///< Accessed in no particular order, readahead is wasted.
+  };
+
 private:
   /// Platform-specific mapping state.
   size_t Size;
@@ -1250,6 +1258,15 @@ public:
   /// behavior.
   const char *const_data() const;
 
+  /// Hint how the mapping is going to be accessed. This is only a hint, it
+  /// may be ignored.
+  void advise(advice Advice) const;
+
+  /// Hint that the \p Length bytes at \p Offset of the mapping are going to
+  /// be accessed soon, so that reading them from disk can start now. This is
+  /// only a hint, it may be ignored.
+  void willNeed(size_t Offset, size_t Length) const;
+
   /// \returns The minimum alignment offset must be.
   static int alignment();
 };
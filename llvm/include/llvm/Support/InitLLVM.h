@@ -29,6 +29,9 @@
 //     encoding, so that you can assume that command line arguments are
 //     always encoded in UTF-8 on any platform.
 //
+//  4. If the LLVM_SAMPLING_PROFILE environment variable is set, start the
+//     sampling profiler (see SamplingProfiler.h).
+//
 // InitLLVM calls llvm_shutdown() on destruction, which cleans up
 // ManagedStatic objects.
 namespace llvm {
@@ -46,6 +49,7 @@ private:
   BumpPtrAllocator Alloc;
   SmallVector<const char *, 0> Args;
   Optional<PrettyStackTraceProgram> StackPrinter;
+  std::string SamplingProfilePath;
 };
 } // namespace llvm
 
@@ -133,6 +133,12 @@ namespace sys {
     /// that has been emitted it must invalidate the instruction cache on some
     /// platforms.
     static void InvalidateInstructionCache(const void *Addr, size_t Len);
+
+    /// Tell the operating system that the pages of [Addr, Addr + Len) are
+    /// going to be read soon, so that it can start reading memory mapped file
+    /// contents in the background. This is only a hint: it has no effect on
+    /// the contents of the memory, and is a no-op where unsupported.
+    static void adviseWillNeed(const void *Addr, size_t Len);
   };
 
   /// Owning version of MemoryBlock.
@@ -151,6 +151,18 @@ public:
   /// MemoryBuffer.
   virtual BufferKind getBufferKind() const = 0;
 
+  /// How the buffer is going to be accessed. Mirrors
+  /// sys::fs::mapped_file_region::advice to avoid a dependency.
+  enum AccessHint { AccessNormal, AccessSequential, AccessRandom };
+
+  /// For buffers that map a file, hint the operating system how the buffer is
+  /// going to be accessed, so it can tune its readahead.
+  virtual void adviseIfMmap(AccessHint Hint) {}
+
+  /// For buffers that map a file, hint that the \p Length bytes at \p Offset
+  /// in the buffer are going to be accessed soon.
+  virtual void willNeedIfMmap(size_t Offset, size_t Length) {}
+
   MemoryBufferRef getMemBufferRef() const;
 };
 
@@ -0,0 +1,87 @@
+//===- PerThreadBumpPtrAllocator.h - Thread-safe bump allocator -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the PerThreadBumpPtrAllocator class, a bump pointer
+/// allocator that may be used by several threads at once.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_PERTHREADBUMPPTRALLOCATOR_H
+#define LLVM_SUPPORT_PERTHREADBUMPPTRALLOCATOR_H
+
+#include "llvm/Support/Allocator.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace llvm {
+
+/// A bump pointer allocator that gives each thread its own BumpPtrAllocator
+/// arena, so that the tasks of llvm::parallelForEach and similar loops can
+/// allocate from it without locking. Like BumpPtrAllocator, all the memory is
+/// only freed by Reset() or the destructor, and may be used by any thread.
+///
+/// Each thread remembers the last allocator it used, so finding the arena of
+/// the calling thread only takes a lock the first time a thread allocates
+/// from an allocator, or when it alternates between several of them.
+class PerThreadBumpPtrAllocator
+    : public AllocatorBase<PerThreadBumpPtrAllocator> {
+public:
+  PerThreadBumpPtrAllocator();
+  PerThreadBumpPtrAllocator(const PerThreadBumpPtrAllocator &) = delete;
+  PerThreadBumpPtrAllocator &
+  operator=(const PerThreadBumpPtrAllocator &) = delete;
+
+  /// Allocate space from the arena of the calling thread.
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                size_t Alignment) {
+    return getThreadArena().Allocate(Size, Align(Alignment));
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<PerThreadBumpPtrAllocator>::Allocate;
+
+  // Bump pointer allocators are expected to never free their storage; and
+  // clients expect pointers to remain valid for non-dereferencing uses even
+  // after deallocation.
+  void Deallocate(const void *Ptr, size_t Size, size_t /*Alignment*/) {
+    __asan_poison_memory_region(Ptr, Size);
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<PerThreadBumpPtrAllocator>::Deallocate;
+
+  /// Free the memory of all the arenas. No other thread may use the allocator
+  /// at the same time.
+  void Reset();
+
+  /// Returns the arena of the calling thread.
+  BumpPtrAllocator &getThreadArena();
+
+  size_t getBytesAllocated() const;
+  size_t getTotalMemory() const;
+
+private:
+  struct Arena {
+    std::thread::id Owner;
+    BumpPtrAllocator Alloc;
+  };
+
+  /// Identifies this allocator in the per-thread caches; unlike its address,
+  /// it is never reused by another allocator.
+  const uint64_t ID;
+  mutable std::mutex Mu;
+  std::vector<std::unique_ptr<Arena>> Arenas;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_PERTHREADBUMPPTRALLOCATOR_H
@@ -0,0 +1,55 @@
+//===- llvm/Support/SamplingProfiler.h - In-process sampling ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A statistical profiler that periodically records the call stack of the
+// running process. Unlike Timer and TimeProfiler it needs no instrumented
+// scopes, so it also accounts for time spent outside passes.
+//
+// Tools that use InitLLVM can be profiled without any change by setting the
+// LLVM_SAMPLING_PROFILE environment variable to the path of the output file.
+// A "%p" in the path is replaced by the process ID, so that each process of
+// e.g. a clang driver invocation writes its own file. The file is written when
+// InitLLVM is destroyed.
+//
+// The output is in "folded stacks" format: one line per distinct call stack,
+// frames from outermost to innermost separated by ';', followed by a space and
+// the number of samples. This is what flamegraph.pl, speedscope and most other
+// flame graph viewers read. Frames that cannot be named are printed as
+// "module+0xoffset", which llvm-symbolizer can resolve offline.
+//
+// The call stacks are recovered by following frame pointers, which is the only
+// way of walking the stack that is safe in a signal handler. Code built without
+// frame pointers (e.g. without -fno-omit-frame-pointer on x86-64) only shows
+// up as the innermost frames. The profiler is available on Linux on x86-64 and
+// AArch64.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_SAMPLINGPROFILER_H
+#define LLVM_SUPPORT_SAMPLINGPROFILER_H
+
+namespace llvm {
+class raw_ostream;
+
+namespace sys {
+
+/// Start recording the call stack of the thread that is running \p Frequency
+/// times per second of CPU time used by the process.
+///
+/// \returns false if sampling is not supported on this platform or the
+/// profiler is already running.
+bool startSamplingProfiler(unsigned Frequency = 100);
+
+/// Stop the profiler and write the recorded samples to \p OS. Does nothing if
+/// the profiler is not running.
+void stopSamplingProfiler(raw_ostream &OS);
+
+} // namespace sys
+} // namespace llvm
+
+#endif // LLVM_SUPPORT_SAMPLINGPROFILER_H
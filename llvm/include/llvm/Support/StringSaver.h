@@ -9,10 +9,13 @@
 #ifndef LLVM_SUPPORT_STRINGSAVER_H
 #define LLVM_SUPPORT_STRINGSAVER_H
 
+#include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/Allocator.h"
+#include <memory>
+#include <mutex>
 
 namespace llvm {
 
@@ -53,5 +56,47 @@ public:
   StringRef save(const std::string &S) { return save(StringRef(S)); }
 };
 
+/// A UniqueStringSaver that may be used by several threads at once, e.g. from
+/// llvm::parallelForEach. Strings are split into shards by hash, and each
+/// shard has its own lock, set of strings and allocator, so that threads
+/// saving different strings rarely wait for each other.
+///
+/// The saved strings live as long as the saver.
+class ConcurrentUniqueStringSaver final {
+public:
+  /// \p NumShards is rounded up to a power of two.
+  explicit ConcurrentUniqueStringSaver(unsigned NumShards = 64);
+
+  // All returned strings are null-terminated: *save(S).end() == 0.
+  StringRef save(const char *S) { return save(StringRef(S)); }
+  StringRef save(StringRef S) { return save(CachedHashStringRef(S)); }
+  StringRef save(const Twine &S) { return save(StringRef(S.str())); }
+  StringRef save(const std::string &S) { return save(StringRef(S)); }
+  /// Save a string whose hash has already been computed, e.g. by the caller's
+  /// own hash table.
+  StringRef save(CachedHashStringRef S);
+
+  /// Returns the total number of bytes allocated for the saved strings.
+  size_t getBytesAllocated() const;
+
+private:
+  struct Shard {
+    mutable std::mutex Mu;
+    BumpPtrAllocator Alloc;
+    DenseSet<CachedHashStringRef> Unique;
+  };
+
+  Shard &getShard(uint32_t Hash) {
+    // The low bits of the hash select buckets within the shard's set, so use
+    // the high ones here. Shift as 64 bits, as ShardShift is 32 for a single
+    // shard.
+    return Shards[static_cast<uint64_t>(Hash) >> ShardShift];
+  }
+
+  std::unique_ptr<Shard[]> Shards;
+  unsigned NumShards;
+  unsigned ShardShift;
+};
+
 }
 #endif
@@ -29,21 +29,65 @@
 
 namespace llvm {
 
+/// A flag shared between the submitter of a task and the task itself. The
+/// submitter calls cancel() when the result of the task is no longer needed.
+/// A ThreadPool skips tasks whose token has been cancelled before they
+/// started, and a long running task may poll isCancelled() to stop early.
+/// Copies of a token share the same flag. A default constructed token can
+/// never be cancelled.
+class CancellationToken {
+public:
+  CancellationToken() = default;
+
+  /// Create a token that can be cancelled.
+  static CancellationToken create() {
+    CancellationToken Token;
+    Token.Flag = std::make_shared<std::atomic<bool>>(false);
+    return Token;
+  }
+
+  void cancel() {
+    if (Flag)
+      Flag->store(true, std::memory_order_relaxed);
+  }
+
+  bool isCancelled() const {
+    return Flag && Flag->load(std::memory_order_relaxed);
+  }
+
+  explicit operator bool() const { return Flag != nullptr; }
+
+private:
+  std::shared_ptr<std::atomic<bool>> Flag;
+};
+
 /// A ThreadPool for asynchronous parallel execution on a defined number of
 /// threads.
 ///
 /// The pool keeps a vector of threads alive, waiting on a condition variable
 /// for some work to become available.
+///
+/// Tasks are queued at one of several priorities. A thread that becomes free
+/// takes the oldest task of the highest priority that has any queued, so
+/// tasks of the same priority run in FIFO order.
 class ThreadPool {
 public:
   using TaskTy = std::function<void()>;
   using PackagedTaskTy = std::packaged_task<void()>;
 
+  enum class Priority { Low, Default, High };
+
   /// Construct a pool using the hardware strategy \p S for mapping hardware
   /// execution resources (threads, cores, CPUs)
   /// Defaults to using the maximum execution resources in the system, but
   /// accounting for the affinity mask.
-  ThreadPool(ThreadPoolStrategy S = hardware_concurrency());
+  ///
+  /// If \p MaxQueuedTasks is non-zero, async() blocks while that many tasks
+  /// are already waiting to be picked up, so that a producer can't get
+  /// arbitrarily far ahead of the workers. Tasks submitted from a thread of
+  /// the pool itself are never blocked, as that could deadlock the pool.
+  ThreadPool(ThreadPoolStrategy S = hardware_concurrency(),
+             unsigned MaxQueuedTasks = 0);
 
   /// Blocking destructor: the pool will wait for all the threads to complete.
   ~ThreadPool();
@@ -54,14 +98,25 @@ public:
   inline std::shared_future<void> async(Function &&F, Args &&... ArgList) {
     auto Task =
         std::bind(std::forward<Function>(F), std::forward<Args>(ArgList)...);
-    return asyncImpl(std::move(Task));
+    return asyncImpl(std::move(Task), Priority::Default, CancellationToken());
   }
 
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
   template <typename Function>
   inline std::shared_future<void> async(Function &&F) {
-    return asyncImpl(std::forward<Function>(F));
+    return asyncImpl(std::forward<Function>(F), Priority::Default,
+                     CancellationToken());
+  }
+
+  /// Like async(), but queue the task at priority \p P. If \p Token is
+  /// cancelled before a thread picks up the task, the task doesn't run and
+  /// the returned future becomes ready as if it had.
+  template <typename Function>
+  inline std::shared_future<void>
+  asyncWithPriority(Priority P, Function &&F,
+                    CancellationToken Token = CancellationToken()) {
+    return asyncImpl(std::forward<Function>(F), P, std::move(Token));
   }
 
   /// Blocking wait for all the threads to complete and the queue to be empty.
@@ -71,17 +126,29 @@ public:
   unsigned getThreadCount() const { return ThreadCount; }
 
 private:
-  bool workCompletedUnlocked() { return !ActiveThreads && Tasks.empty(); }
+  static constexpr unsigned NumPriorities = unsigned(Priority::High) + 1;
+
+  bool workCompletedUnlocked() { return !ActiveThreads && NumQueued == 0; }
+
+  /// Pop the oldest task of the highest non-empty priority.
+  PackagedTaskTy popTaskUnlocked();
 
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
-  std::shared_future<void> asyncImpl(TaskTy F);
+  std::shared_future<void> asyncImpl(TaskTy F, Priority P,
+                                     CancellationToken Token);
 
   /// Threads in flight
   std::vector<llvm::thread> Threads;
 
-  /// Tasks waiting for execution in the pool.
-  std::queue<PackagedTaskTy> Tasks;
+  /// Tasks waiting for execution in the pool, one queue per priority.
+  std::queue<PackagedTaskTy> Tasks[NumPriorities];
+
+  /// The number of tasks in all of the queues.
+  size_t NumQueued = 0;
+
+  /// If non-zero, the number of queued tasks at which async() blocks.
+  unsigned MaxQueuedTasks;
 
   /// Locking and signaling for accessing the Tasks queue.
   std::mutex QueueLock;
@@ -90,6 +157,9 @@ private:
   /// Signaling for job completion
   std::condition_variable CompletionCondition;
 
+  /// Signaling for room in the queues when MaxQueuedTasks is set.
+  std::condition_variable SpaceCondition;
+
   /// Keep track of the number of thread actually busy
   unsigned ActiveThreads = 0;
 
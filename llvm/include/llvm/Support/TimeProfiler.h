@@ -12,6 +12,8 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <chrono>
+
 namespace llvm {
 
 struct TimeTraceProfiler;
@@ -20,8 +22,11 @@ TimeTraceProfiler *getTimeTraceProfilerInstance();
 /// Initialize the time trace profiler.
 /// This sets up the global \p TimeTraceProfilerInstance
 /// variable to be the profiler instance.
+/// If \p TimeTraceMemory is set, the change in heap usage over each section is
+/// recorded along with its duration.
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                 StringRef ProcName);
+                                 StringRef ProcName,
+                                 bool TimeTraceMemory = false);
 
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
@@ -58,6 +63,17 @@ void timeTraceProfilerBegin(StringRef Name,
 /// Manually end the last time section.
 void timeTraceProfilerEnd();
 
+/// Add a time section that ran on thread \p Tid from \p Start to \p End to
+/// the profiler of the calling thread. This is meant for work that the calling
+/// thread handed to worker threads which have no profiler of their own, e.g.
+/// the tasks of a parallelForEach. The section is written under \p Tid so
+/// that the trace shows how the work was spread across threads. It is not
+/// counted in the per-name totals.
+void timeTraceProfilerAddThreadSection(
+    StringRef Name, StringRef Detail, uint64_t Tid,
+    std::chrono::steady_clock::time_point Start,
+    std::chrono::steady_clock::time_point End);
+
 /// The TimeTraceScope is a helper class to call the begin and end functions
 /// of the time trace profiler.  When the object is constructed, it begins
 /// the section; and when it is destroyed, it stops it. If the time profiler
@@ -18,6 +18,7 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/ErrorOr.h"
@@ -28,6 +29,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <stack>
 #include <string>
 #include <system_error>
@@ -405,6 +407,81 @@ private:
   virtual void anchor();
 };
 
+/// A file system that remembers the results of \p status() and \p dir_begin()
+/// on the underlying file system, including lookups of missing files. This
+/// saves the many repeated stats of header search, which are expensive on
+/// network file systems. File contents are not cached.
+///
+/// The cache lives in a \p SharedCache, which several CachingFileSystems,
+/// e.g. one per thread, can use at the same time. Each CachingFileSystem has
+/// its own working directory, like the file system returned by
+/// createPhysicalFileSystem(), and only passes absolute paths to the
+/// underlying file system, so that they don't depend on its working directory.
+///
+/// Nothing is invalidated automatically: a client that watches the file
+/// system for changes must call \p SharedCache::invalidate() for the paths
+/// that changed.
+class CachingFileSystem : public ProxyFileSystem {
+public:
+  /// The thread-safe cache of statuses and directory listings. Entries are
+  /// keyed by absolute paths with '.' components removed.
+  class SharedCache {
+  public:
+    /// Forget what is cached for \p Path, for anything below it, and for its
+    /// parent directory. \p Path must be absolute.
+    void invalidate(StringRef Path);
+
+    /// Forget everything that is cached.
+    void invalidateAll();
+
+  private:
+    friend class CachingFileSystem;
+
+    /// The name and type of each entry of a directory.
+    using DirectoryListing = std::vector<directory_entry>;
+
+    std::mutex Mutex;
+    llvm::StringMap<llvm::ErrorOr<Status>> StatCache;
+    llvm::StringMap<std::shared_ptr<const DirectoryListing>> DirCache;
+  };
+
+  /// Cache the results of \p FS in \p Cache. The working directory starts
+  /// out as that of \p FS.
+  CachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS,
+                    std::shared_ptr<SharedCache> Cache =
+                        std::make_shared<SharedCache>());
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  llvm::ErrorOr<std::unique_ptr<File>>
+  openFileForRead(const Twine &Path) override;
+  directory_iterator dir_begin(const Twine &Dir, std::error_code &EC) override;
+  llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override;
+  std::error_code setCurrentWorkingDirectory(const Twine &Path) override;
+  std::error_code getRealPath(const Twine &Path,
+                              SmallVectorImpl<char> &Output) const override;
+  std::error_code isLocal(const Twine &Path, bool &Result) override;
+
+  /// The cache used by this file system.
+  const std::shared_ptr<SharedCache> &getSharedCache() const { return Cache; }
+
+  /// Forget what is cached for \p Path, for anything below it, and for its
+  /// parent directory.
+  void invalidate(const Twine &Path);
+
+  /// Forget everything that is cached.
+  void invalidateAll() { Cache->invalidateAll(); }
+
+private:
+  /// Make \p Path absolute against the working directory of this file system
+  /// and remove its '.' components.
+  std::string getAbsolutePath(const Twine &Path) const;
+
+  std::shared_ptr<SharedCache> Cache;
+  /// The working directory, or empty if it is unknown. In that case relative
+  /// paths are passed on as they are.
+  std::string WorkingDirectory;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
@@ -0,0 +1,82 @@
+//===- raw_async_fd_ostream.h - Asynchronous file output stream -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the raw_async_fd_ostream class.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_RAW_ASYNC_FD_OSTREAM_H
+#define LLVM_SUPPORT_RAW_ASYNC_FD_OSTREAM_H
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+
+namespace llvm {
+
+/// A raw_pwrite_stream that writes a file in large chunks from a background
+/// thread, so that the thread producing the output is not blocked in write(2)
+/// while the previous chunk reaches the file. It is meant for large outputs,
+/// such as object files, and only supports regular files.
+///
+/// The output is double buffered: a full chunk is handed to the writer thread
+/// and production continues into the other one. pwrite() waits for all the
+/// pending output to be written, then writes synchronously.
+///
+/// Errors are only reported once the writer thread has seen them; they are
+/// guaranteed to be detected once the stream has been closed.
+class raw_async_fd_ostream : public raw_pwrite_stream {
+  class AsyncWriter;
+
+  int FD = -1;
+  std::error_code EC;
+  uint64_t Pos = 0;
+  std::unique_ptr<AsyncWriter> Writer;
+
+  /// See raw_ostream::write_impl.
+  void write_impl(const char *Ptr, size_t Size) override;
+
+  void pwrite_impl(const char *Ptr, size_t Size, uint64_t Offset) override;
+
+  /// Return the current position within the stream, not counting the bytes
+  /// currently in the buffer.
+  uint64_t current_pos() const override { return Pos; }
+
+  /// The size of the chunks handed to the writer thread.
+  size_t preferred_buffer_size() const override;
+
+  /// Wait for the writer thread to write all the chunks it was handed, and
+  /// collect its errors.
+  void drain();
+
+public:
+  /// Open the specified file for writing. If an error occurs, information
+  /// about the error is put into EC, and the stream should be immediately
+  /// destroyed.
+  raw_async_fd_ostream(StringRef Filename, std::error_code &EC,
+                       sys::fs::OpenFlags Flags = sys::fs::OF_None);
+
+  ~raw_async_fd_ostream() override;
+
+  /// Flush the stream, wait for all the output to be written and close the
+  /// file.
+  void close();
+
+  std::error_code error() const { return EC; }
+
+  /// Return whether an output error has been encountered. If the error flag
+  /// is set when the stream is destroyed, report_fatal_error is called.
+  bool has_error() const { return bool(EC); }
+
+  /// Set the flag read by has_error() to false.
+  void clear_error() { EC = std::error_code(); }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_RAW_ASYNC_FD_OSTREAM_H
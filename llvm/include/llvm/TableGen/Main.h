@@ -13,6 +13,10 @@
 #ifndef LLVM_TABLEGEN_MAIN_H
 #define LLVM_TABLEGEN_MAIN_H
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include <string>
+
 namespace llvm {
 
 class raw_ostream;
@@ -22,7 +26,21 @@ class RecordKeeper;
 /// Returns true on error, false otherwise.
 using TableGenMainFn = bool (raw_ostream &OS, RecordKeeper &Records);
 
-int TableGenMain(const char *argv0, TableGenMainFn *MainFn);
+/// A further output of a tblgen run, produced from the records parsed for
+/// the main one.
+struct TableGenOutput {
+  std::string Filename;
+  /// Like TableGenMainFn.
+  function_ref<bool(raw_ostream &OS, RecordKeeper &Records)> Emit;
+};
+
+/// Parse the input, run MainFn on it and write the result to the -o file.
+/// Each of ExtraOutputs also runs on the same records, so that backends
+/// reading the same input only pay for parsing it once. The -o file is
+/// written last, and rewritten whenever an extra output changes, so that a
+/// build system can depend on it for all of them.
+int TableGenMain(const char *argv0, TableGenMainFn *MainFn,
+                 ArrayRef<TableGenOutput> ExtraOutputs = None);
 
 } // end namespace llvm
 
@@ -1771,6 +1771,10 @@ class RecordKeeper {
   Timer *LastTimer = nullptr;
   bool BackendTimer = false;
 
+  /// The objects returned by getCached(). Declared last so that they are
+  /// destroyed before the records they point into.
+  DenseMap<const void *, std::shared_ptr<void>> Cached;
+
 public:
   /// Get the main TableGen input file's name.
   const std::string getInputFilename() const { return InputFilename; }
@@ -1867,6 +1871,17 @@ public:
   std::vector<Record *> getAllDerivedDefinitions(
       ArrayRef<StringRef> ClassNames) const;
 
+  /// Return the T built from these records, constructing it with T(*this)
+  /// the first time. Backends run on the same records share it, and it lives
+  /// as long as the records.
+  template <typename T> T &getCached() {
+    static const char Key = 0;
+    std::shared_ptr<void> &Entry = Cached[&Key];
+    if (!Entry)
+      Entry = std::make_shared<T>(*this);
+    return *static_cast<T *>(Entry.get());
+  }
+
   void dump() const;
 };
 
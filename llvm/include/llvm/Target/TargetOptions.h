@@ -240,6 +240,10 @@ namespace llvm {
     /// Compress DWARF debug sections.
     DebugCompressionType CompressDebugSections = DebugCompressionType::None;
 
+    /// The number of threads used to compress DWARF debug sections, or 0 to
+    /// use all the hardware threads.
+    unsigned CompressDebugSectionsThreads = 1;
+
     unsigned RelaxELFRelocations : 1;
 
     /// Emit functions into separate sections.
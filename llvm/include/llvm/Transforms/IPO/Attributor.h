@@ -1736,6 +1736,19 @@ private:
   /// The current initialization chain length. Tracked to avoid stack overflows.
   unsigned InitializationChainLength = 0;
 
+  /// The number of abstract attribute updates performed so far. Checked
+  /// against the update budget in `Attributor::runTillFixpoint`.
+  unsigned NumUpdates = 0;
+
+  /// The number of updates per kind of abstract attribute, keyed by the
+  /// address of their ID, with one of the attributes of the kind to name it.
+  /// Only collected if requested, see `Attributor::printUpdateCounts`.
+  MapVector<const char *, std::pair<const AbstractAttribute *, unsigned>>
+      UpdatesPerKind;
+
+  /// Print the number of updates per kind of abstract attribute.
+  void printUpdateCounts(raw_ostream &OS) const;
+
   /// Functions, blocks, and instructions we delete after manifest is done.
   ///
   ///{
@@ -69,6 +69,11 @@ private:
   // vector of counter load/store pairs to be register promoted.
   std::vector<LoadStorePair> PromotionCandidates;
 
+  // The load of the counter bias and the current thread's counter shard,
+  // computed once in the entry block of each function.
+  DenseMap<const Function *, LoadInst *> FunctionToProfileBiasMap;
+  DenseMap<const Function *, Instruction *> FunctionToCounterShardMap;
+
   int64_t TotalCountersPromoted = 0;
 
   /// Lower instrumentation intrinsics in the function. Returns true if there
@@ -81,6 +86,16 @@ private:
   /// Returns true if relocating counters at runtime is enabled.
   bool isRuntimeCounterRelocationEnabled() const;
 
+  /// Returns the number of copies of the counters of each function.
+  unsigned getNumCounterShards() const;
+
+  /// Returns the load of the counter bias in the entry block of \p F.
+  LoadInst *getCounterBias(Function *F);
+
+  /// Returns the current thread's counter shard, computed in the entry block
+  /// of \p F.
+  Instruction *getCounterShard(Function *F);
+
   /// Returns true if profile counter update register promotion is enabled.
   bool isCounterPromotionEnabled() const;
 
@@ -0,0 +1,57 @@
+//===- CodeLayout.h - Code layout/placement algorithms ----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// Declares methods and data structures for code layout algorithms.
+///
+/// The Extended TSP (ext-TSP) objective rewards an ordering of the nodes of a
+/// weighted directed graph, such as the basic blocks of a function, for every
+/// jump that becomes a fallthrough, and to a lesser extent for every short
+/// forward or backward jump. Maximizing it improves the i-cache and i-TLB
+/// utilization of the code. See "Improved Basic Block Reordering" by A. Newell
+/// and S. Pupyrev, IEEE Transactions on Computers, 2020.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRANSFORMS_UTILS_CODELAYOUT_H
+#define LLVM_TRANSFORMS_UTILS_CODELAYOUT_H
+
+#include "llvm/ADT/DenseMap.h"
+#include <cstdint>
+#include <vector>
+
+namespace llvm {
+
+/// The weight of a jump from a node to another, indexed by their numbers.
+using EdgeCountMap = DenseMap<std::pair<uint64_t, uint64_t>, uint64_t>;
+
+/// Find a layout of the nodes of a graph maximizing the ext-TSP score. Node
+/// 0 is the entry point and is always placed first.
+///
+/// \param NodeSizes The size of each node, in bytes.
+/// \param NodeCounts The execution count of each node.
+/// \param EdgeCounts The execution count of each jump between nodes.
+/// \returns The nodes, in their new order.
+std::vector<uint64_t> applyExtTspLayout(const std::vector<uint64_t> &NodeSizes,
+                                        const std::vector<uint64_t> &NodeCounts,
+                                        const EdgeCountMap &EdgeCounts);
+
+/// Compute the ext-TSP score of the nodes of a graph laid out in \p Order.
+double calcExtTspScore(const std::vector<uint64_t> &Order,
+                       const std::vector<uint64_t> &NodeSizes,
+                       const std::vector<uint64_t> &NodeCounts,
+                       const EdgeCountMap &EdgeCounts);
+
+/// Compute the ext-TSP score of the nodes of a graph in their original order.
+double calcExtTspScore(const std::vector<uint64_t> &NodeSizes,
+                       const std::vector<uint64_t> &NodeCounts,
+                       const EdgeCountMap &EdgeCounts);
+
+} // end namespace llvm
+
+#endif // LLVM_TRANSFORMS_UTILS_CODELAYOUT_H
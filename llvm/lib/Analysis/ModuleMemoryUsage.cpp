@@ -0,0 +1,191 @@
+//===- ModuleMemoryUsage.cpp - Estimate the memory used by a module -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the ModuleMemoryUsage and ModuleMemoryUsageAnalysis
+// classes, which estimate how much memory the IR of a module takes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/ModuleMemoryUsage.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/GlobalAlias.h"
+#include "llvm/IR/GlobalIFunc.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+static uint64_t getInstructionSize(const Instruction &I) {
+  switch (I.getOpcode()) {
+#define HANDLE_INST(N, OPC, CLASS)                                             \
+  case Instruction::OPC:                                                       \
+    return sizeof(CLASS);
+#include "llvm/IR/Instruction.def"
+  }
+  llvm_unreachable("Unknown instruction");
+}
+
+static uint64_t getConstantSize(const Constant &C) {
+  switch (C.getValueID()) {
+#define HANDLE_CONSTANT(NAME)                                                  \
+  case Value::NAME##Val:                                                       \
+    return sizeof(NAME);
+#include "llvm/IR/Value.def"
+  default:
+    llvm_unreachable("Unknown constant");
+  }
+}
+
+namespace {
+class MemoryUsageCounter {
+public:
+  explicit MemoryUsageCounter(ModuleMemoryUsage &Usage) : Usage(Usage) {}
+
+  void addName(const Value &V) {
+    if (V.hasName())
+      Usage.NameBytes += sizeof(ValueName) + V.getName().size() + 1;
+  }
+
+  /// Count the operands of \p U, and the constants among them that were not
+  /// seen yet.
+  void addOperands(const User &U) {
+    addUses(U.getNumOperands());
+    for (const Use &Op : U.operands())
+      if (auto *C = dyn_cast<Constant>(Op.get()))
+        if (!isa<GlobalValue>(C))
+          addConstant(*C);
+  }
+
+  /// Count the debug location of \p I and its inlined-at chain, up to the
+  /// first location that was already seen.
+  void addDebugLoc(const Instruction &I) {
+    for (const DILocation *DL = I.getDebugLoc().get();
+         DL && SeenLocations.insert(DL).second; DL = DL->getInlinedAt()) {
+      ++Usage.DILocations;
+      Usage.DILocationBytes +=
+          sizeof(DILocation) + DL->getNumOperands() * sizeof(MDOperand);
+    }
+  }
+
+private:
+  void addUses(uint64_t N) {
+    Usage.Uses += N;
+    Usage.UseBytes += N * sizeof(Use);
+    // Each Use links to the next one and back to the previous one.
+    Usage.UseListBytes += N * 2 * sizeof(void *);
+  }
+
+  void addConstant(const Constant &C) {
+    if (!Seen.insert(&C).second)
+      return;
+    SmallVector<const Constant *, 8> Worklist = {&C};
+    while (!Worklist.empty()) {
+      const Constant *Current = Worklist.pop_back_val();
+      ++Usage.Constants;
+      Usage.ConstantBytes += getConstantSize(*Current);
+      addUses(Current->getNumOperands());
+      for (const Use &Op : Current->operands()) {
+        auto *OpC = cast<Constant>(Op.get());
+        if (!isa<GlobalValue>(OpC) && Seen.insert(OpC).second)
+          Worklist.push_back(OpC);
+      }
+    }
+  }
+
+  ModuleMemoryUsage &Usage;
+  DenseSet<const Constant *> Seen;
+  DenseSet<const DILocation *> SeenLocations;
+};
+} // namespace
+
+ModuleMemoryUsage ModuleMemoryUsage::compute(const Module &M) {
+  ModuleMemoryUsage Usage;
+  MemoryUsageCounter Counter(Usage);
+
+  auto AddGlobalValue = [&](const GlobalValue &GV, uint64_t Size) {
+    ++Usage.GlobalValues;
+    Usage.GlobalValueBytes += Size;
+    Counter.addName(GV);
+    Counter.addOperands(GV);
+  };
+  for (const GlobalVariable &GV : M.globals())
+    AddGlobalValue(GV, sizeof(GlobalVariable));
+  for (const GlobalAlias &GA : M.aliases())
+    AddGlobalValue(GA, sizeof(GlobalAlias));
+  for (const GlobalIFunc &GI : M.ifuncs())
+    AddGlobalValue(GI, sizeof(GlobalIFunc));
+
+  for (const Function &F : M) {
+    ++Usage.Functions;
+    Usage.FunctionBytes += sizeof(Function);
+    Counter.addName(F);
+    // Personality, prefix and prologue data.
+    Counter.addOperands(F);
+
+    Usage.Arguments += F.arg_size();
+    Usage.ArgumentBytes += F.arg_size() * sizeof(Argument);
+    for (const Argument &A : F.args())
+      Counter.addName(A);
+
+    for (const BasicBlock &BB : F) {
+      ++Usage.BasicBlocks;
+      Usage.BasicBlockBytes += sizeof(BasicBlock);
+      Counter.addName(BB);
+      for (const Instruction &I : BB) {
+        ++Usage.Instructions;
+        Usage.InstructionBytes += getInstructionSize(I);
+        Counter.addName(I);
+        Counter.addOperands(I);
+        Counter.addDebugLoc(I);
+      }
+    }
+  }
+  return Usage;
+}
+
+uint64_t ModuleMemoryUsage::getTotalBytes() const {
+  return FunctionBytes + ArgumentBytes + BasicBlockBytes + GlobalValueBytes +
+         InstructionBytes + ConstantBytes + UseBytes + NameBytes +
+         DILocationBytes;
+}
+
+void ModuleMemoryUsage::print(raw_ostream &OS) const {
+  auto PrintRow = [&](StringRef Kind, uint64_t Count, uint64_t Bytes) {
+    OS << Kind << ": " << Count << " (" << Bytes << " bytes)\n";
+  };
+  PrintRow("Functions", Functions, FunctionBytes);
+  PrintRow("Arguments", Arguments, ArgumentBytes);
+  PrintRow("BasicBlocks", BasicBlocks, BasicBlockBytes);
+  PrintRow("GlobalValues", GlobalValues, GlobalValueBytes);
+  PrintRow("Instructions", Instructions, InstructionBytes);
+  PrintRow("Constants", Constants, ConstantBytes);
+  PrintRow("Uses", Uses, UseBytes);
+  PrintRow("DILocations", DILocations, DILocationBytes);
+  OS << "UseListBytes: " << UseListBytes << "\n"
+     << "NameBytes: " << NameBytes << "\n"
+     << "TotalBytes: " << getTotalBytes() << "\n";
+}
+
+AnalysisKey ModuleMemoryUsageAnalysis::Key;
+
+ModuleMemoryUsage ModuleMemoryUsageAnalysis::run(Module &M,
+                                                 ModuleAnalysisManager &MAM) {
+  return ModuleMemoryUsage::compute(M);
+}
+
+PreservedAnalyses
+ModuleMemoryUsagePrinterPass::run(Module &M, ModuleAnalysisManager &MAM) {
+  OS << "Memory usage of module '" << M.getModuleIdentifier() << "':\n";
+  MAM.getResult<ModuleMemoryUsageAnalysis>(M).print(OS);
+  return PreservedAnalyses::all();
+}
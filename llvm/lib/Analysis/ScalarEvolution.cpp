@@ -147,6 +147,10 @@ STATISTIC(NumTripCountsNotComputed,
           "Number of loops without predictable loop counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumRangeCacheFlushes,
+          "Number of times the range caches were flushed to stay in budget");
+STATISTIC(NumRangeCacheEntriesFlushed,
+          "Number of range cache entries dropped to stay in budget");
 
 static cl::opt<unsigned>
 MaxBruteForceIterations("scalar-evolution-max-iterations", cl::ReallyHidden,
@@ -227,6 +231,13 @@ ClassifyExpressions("scalar-evolution-classify-expressions",
     cl::Hidden, cl::init(true),
     cl::desc("When printing analysis, include information on every instruction"));
 
+namespace llvm {
+cl::opt<unsigned> MaxRangeCacheEntries(
+    "scalar-evolution-max-range-cache-entries", cl::Hidden, cl::init(0),
+    cl::desc("Maximum number of memoized signed and unsigned ranges, beyond "
+             "which they are recomputed on demand (0 = unlimited)"));
+} // namespace llvm
+
 static cl::opt<bool> UseExpensiveRangeSharpening(
     "scalar-evolution-use-expensive-range-sharpening", cl::Hidden,
     cl::init(false),
@@ -5645,6 +5656,32 @@ void ScalarEvolution::setNoWrapFlags(SCEVAddRecExpr *AddRec,
   }
 }
 
+const ConstantRange &ScalarEvolution::setRange(const SCEV *S,
+                                               RangeSignHint Hint,
+                                               ConstantRange CR) {
+  DenseMap<const SCEV *, ConstantRange> &Cache =
+      Hint == HINT_RANGE_UNSIGNED ? UnsignedRanges : SignedRanges;
+
+  // Ranges are only memoized, so they can be dropped at any time without
+  // changing the results. Dropping all of them at once is much cheaper than
+  // tracking their use, and the ones that are still needed are recomputed
+  // quickly from their operands. References returned by getRangeRef are
+  // already invalidated by any insertion, so nobody holds on to them.
+  if (MaxRangeCacheEntries &&
+      UnsignedRanges.size() + SignedRanges.size() >= MaxRangeCacheEntries &&
+      !Cache.count(S)) {
+    ++NumRangeCacheFlushes;
+    NumRangeCacheEntriesFlushed += UnsignedRanges.size() + SignedRanges.size();
+    UnsignedRanges.clear();
+    SignedRanges.clear();
+  }
+
+  auto Pair = Cache.try_emplace(S, std::move(CR));
+  if (!Pair.second)
+    Pair.first->second = std::move(CR);
+  return Pair.first->second;
+}
+
 /// Determine the range for a particular SCEV.  If SignHint is
 /// HINT_RANGE_UNSIGNED (resp. HINT_RANGE_SIGNED) then getRange prefers ranges
 /// with a "cleaner" unsigned (resp. signed) representation.
@@ -12563,6 +12600,25 @@ void ScalarEvolution::addToLoopUseLists(const SCEV *S) {
     LoopUsers[L].push_back(S);
 }
 
+void ScalarEvolution::printCacheSizes(raw_ostream &OS) const {
+  OS << "ScalarEvolution cache sizes for ";
+  F.printAsOperand(OS, /*PrintType=*/false);
+  OS << ":\n";
+  OS << "  UniqueSCEVs: " << UniqueSCEVs.size() << "\n";
+  OS << "  ValueExprMap: " << ValueExprMap.size() << "\n";
+  OS << "  ExprValueMap: " << ExprValueMap.size() << "\n";
+  OS << "  BackedgeTakenCounts: " << BackedgeTakenCounts.size() << "\n";
+  OS << "  PredicatedBackedgeTakenCounts: "
+     << PredicatedBackedgeTakenCounts.size() << "\n";
+  OS << "  ConstantEvolutionLoopExitValue: "
+     << ConstantEvolutionLoopExitValue.size() << "\n";
+  OS << "  ValuesAtScopes: " << ValuesAtScopes.size() << "\n";
+  OS << "  LoopDispositions: " << LoopDispositions.size() << "\n";
+  OS << "  BlockDispositions: " << BlockDispositions.size() << "\n";
+  OS << "  UnsignedRanges: " << UnsignedRanges.size() << "\n";
+  OS << "  SignedRanges: " << SignedRanges.size() << "\n";
+}
+
 void ScalarEvolution::verify() const {
   ScalarEvolution &SE = *const_cast<ScalarEvolution *>(this);
   ScalarEvolution SE2(F, TLI, AC, DT, LI);
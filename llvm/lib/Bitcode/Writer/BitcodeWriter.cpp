@@ -4413,8 +4413,11 @@ void ModuleBitcodeWriter::write() {
   writeOperandBundleTags();
   writeSyncScopeNames();
 
-  // Emit function bodies.
+  // Emit function bodies. Size the offset map up front; it gets one entry per
+  // definition and is otherwise rehashed repeatedly for large modules.
   DenseMap<const Function *, uint64_t> FunctionToBitcodeIndex;
+  FunctionToBitcodeIndex.reserve(
+      count_if(M, [](const Function &F) { return !F.isDeclaration(); }));
   for (Module::const_iterator F = M.begin(), E = M.end(); F != E; ++F)
     if (!F->isDeclaration())
       writeFunction(*F, FunctionToBitcodeIndex);
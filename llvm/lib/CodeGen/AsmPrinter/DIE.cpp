@@ -14,6 +14,7 @@
 #include "DwarfCompileUnit.h"
 #include "DwarfDebug.h"
 #include "DwarfUnit.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/CodeGen/AsmPrinter.h"
 #include "llvm/Config/llvm-config.h"
@@ -33,6 +34,8 @@ using namespace llvm;
 
 #define DEBUG_TYPE "dwarfdebug"
 
+STATISTIC(NumDIEs, "Number of DIEs laid out for emission");
+
 //===----------------------------------------------------------------------===//
 // DIEAbbrevData Implementation
 //===----------------------------------------------------------------------===//
@@ -283,6 +286,7 @@ unsigned DIE::computeOffsetsAndAbbrevs(const AsmPrinter *AP,
 
   // Set compile/type unit relative offset of this DIE.
   setOffset(CUOffset);
+  ++NumDIEs;
 
   // Add the byte size of the abbreviation code.
   CUOffset += getULEB128Size(getAbbrevNumber());
@@ -66,6 +66,7 @@ using namespace llvm;
 #define DEBUG_TYPE "dwarfdebug"
 
 STATISTIC(NumCSParams, "Number of dbg call site params created");
+STATISTIC(DIEBytes, "Bytes allocated for DIEs, their values and strings");
 
 static cl::opt<bool> UseDwarfRangesBaseAddressSpecifier(
     "use-dwarf-ranges-base-address-specifier", cl::Hidden,
@@ -1497,6 +1498,10 @@ void DwarfDebug::endModule() {
   // Emit the pubnames and pubtypes sections if requested.
   emitDebugPubSections();
 
+  // All DIEs are kept alive until the module is emitted, so this is also the
+  // peak memory used for them.
+  DIEBytes += DIEValueAllocator.getBytesAllocated();
+
   // clean up.
   // FIXME: AbstractVariables.clear();
 }
@@ -48,6 +48,11 @@ static cl::opt<std::string>
 static const std::string CoveragePrefix;
 #endif
 
+static cl::opt<bool> PrintRuleProfile(
+    "gisel-print-rule-profile", cl::Hidden,
+    cl::desc("Print the number of match table opcodes each rule executed, if "
+             "profiling instrumentation was generated"));
+
 char InstructionSelect::ID = 0;
 INITIALIZE_PASS_BEGIN(InstructionSelect, DEBUG_TYPE,
                       "Select target instructions out of generic instructions",
@@ -301,6 +306,13 @@ bool InstructionSelect::runOnMachineFunction(MachineFunction &MF) {
   CoverageInfo.emit(CoveragePrefix,
                     TLI.getTargetMachine().getTarget().getBackendName());
 
+  if (PrintRuleProfile && !CoverageInfo.executedOpcodes().empty()) {
+    errs() << "Match table opcodes executed by rule in " << MF.getName()
+           << ":";
+    CoverageInfo.printExecutedOpcodes(errs());
+    errs() << "\n";
+  }
+
   // If we successfully selected the function nothing is going to use the vreg
   // types after us (otherwise MIRPrinter would need them). Make sure the types
   // disappear.
@@ -70,6 +70,8 @@ void LLVMTargetMachine::initAsmInfo() {
   TmpAsmInfo->setPreserveAsmComments(Options.MCOptions.PreserveAsmComments);
 
   TmpAsmInfo->setCompressDebugSections(Options.CompressDebugSections);
+  TmpAsmInfo->setCompressDebugSectionsThreads(
+      Options.CompressDebugSectionsThreads);
 
   TmpAsmInfo->setRelaxELFRelocations(Options.RelaxELFRelocations);
 
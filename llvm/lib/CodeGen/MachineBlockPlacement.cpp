@@ -59,8 +59,10 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
+#include "llvm/Transforms/Utils/CodeLayout.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
@@ -193,6 +195,17 @@ static cl::opt<unsigned> TriangleChainCount(
     cl::init(2),
     cl::Hidden);
 
+// Use the ext-TSP algorithm to refine the layout of the blocks.
+static cl::opt<bool> EnableExtTspBlockPlacement(
+    "enable-ext-tsp-block-placement", cl::Hidden, cl::init(false),
+    cl::desc("Enable machine block placement based on the ext-tsp model, "
+             "optimizing I-cache utilization."));
+
+static cl::opt<unsigned> ExtTspBlockPlacementMaxBlocks(
+    "ext-tsp-block-placement-max-blocks", cl::Hidden, cl::init(1000),
+    cl::desc("Maximum number of basic blocks in a function to run ext-TSP "
+             "block placement."));
+
 extern cl::opt<unsigned> StaticLikelyProb;
 extern cl::opt<unsigned> ProfileLikelyProb;
 
@@ -518,6 +531,15 @@ class MachineBlockPlacement : public MachineFunctionPass {
   void buildCFGChains();
   void optimizeBranches();
   void alignBlocks();
+  /// Reorder the blocks to maximize the ext-TSP score of the layout, if it
+  /// improves on the current one. Returns true if the layout was changed.
+  bool applyExtTsp();
+  /// Put the blocks in the order given by \p NewOrder, and update their
+  /// terminators accordingly.
+  void assignBlockOrder(const std::vector<const MachineBasicBlock *> &NewOrder);
+  /// Create a single chain with the blocks in their current order, for the
+  /// steps that follow the placement.
+  void createCFGChainExtTsp();
   /// Returns true if a block should be tail-duplicated to increase fallthrough
   /// opportunities.
   bool shouldTailDuplicate(MachineBasicBlock *BB);
@@ -3290,6 +3312,110 @@ void MachineBlockPlacement::initDupThreshold() {
   UseProfileCount = false;
 }
 
+bool MachineBlockPlacement::applyExtTsp() {
+  // Number the blocks in their current order.
+  DenseMap<const MachineBasicBlock *, uint64_t> BlockIndex;
+  BlockIndex.reserve(F->size());
+  std::vector<const MachineBasicBlock *> CurrentBlockOrder;
+  CurrentBlockOrder.reserve(F->size());
+  for (const MachineBasicBlock &MBB : *F) {
+    BlockIndex[&MBB] = CurrentBlockOrder.size();
+    CurrentBlockOrder.push_back(&MBB);
+  }
+
+  std::vector<uint64_t> BlockSizes(F->size());
+  std::vector<uint64_t> BlockCounts(F->size());
+  EdgeCountMap JumpCounts;
+  SmallVector<MachineOperand, 4> Cond; // For analyzeBranch.
+  for (MachineBasicBlock &MBB : *F) {
+    // Blocks whose fallthrough cannot be analyzed must stay where they are.
+    Cond.clear();
+    MachineBasicBlock *TBB = nullptr, *FBB = nullptr; // For analyzeBranch.
+    if (TII->analyzeBranch(MBB, TBB, FBB, Cond) && MBB.canFallThrough())
+      return false;
+
+    // Estimate the size of the block, as the layout happens before the
+    // instructions are final.
+    uint64_t NumInsts = std::count_if(
+        MBB.instr_begin(), MBB.instr_end(),
+        [](const MachineInstr &MI) { return !MI.isMetaInstruction(); });
+    uint64_t Index = BlockIndex[&MBB];
+    BlockSizes[Index] = 4 * std::max<uint64_t>(NumInsts, 1);
+    BlockFrequency BlockFreq = MBFI->getBlockFreq(&MBB);
+    BlockCounts[Index] = BlockFreq.getFrequency();
+    for (MachineBasicBlock *Succ : MBB.successors()) {
+      BlockFrequency JumpFreq =
+          BlockFreq * MBPI->getEdgeProbability(&MBB, Succ);
+      JumpCounts[std::make_pair(Index, BlockIndex[Succ])] +=
+          JumpFreq.getFrequency();
+    }
+  }
+
+  LLVM_DEBUG(dbgs() << "Applying ext-tsp layout for |V| = " << F->size()
+                    << " with profile = " << F->getFunction().hasProfileData()
+                    << " (" << F->getName().str() << ")"
+                    << "\n");
+  std::vector<uint64_t> NewOrder =
+      applyExtTspLayout(BlockSizes, BlockCounts, JumpCounts);
+
+  // Keep the current layout unless the new one is better.
+  double OrgScore = calcExtTspScore(BlockSizes, BlockCounts, JumpCounts);
+  double NewScore =
+      calcExtTspScore(NewOrder, BlockSizes, BlockCounts, JumpCounts);
+  LLVM_DEBUG(dbgs() << format("  original  layout score: %0.2f\n", OrgScore)
+                    << format("  optimized layout score: %0.2f\n", NewScore));
+  if (NewScore <= OrgScore)
+    return false;
+
+  std::vector<const MachineBasicBlock *> NewBlockOrder;
+  NewBlockOrder.reserve(F->size());
+  for (uint64_t Node : NewOrder)
+    NewBlockOrder.push_back(CurrentBlockOrder[Node]);
+  assignBlockOrder(NewBlockOrder);
+  return true;
+}
+
+void MachineBlockPlacement::assignBlockOrder(
+    const std::vector<const MachineBasicBlock *> &NewBlockOrder) {
+  assert(F->size() == NewBlockOrder.size() && "Incorrect size of block order");
+  F->RenumberBlocks();
+
+  // Remember the original layout successors, to update the terminators.
+  SmallVector<MachineBasicBlock *, 4> OriginalLayoutSuccessors(
+      F->getNumBlockIDs());
+  for (auto MBI = F->begin(), MBE = F->end(); MBI != MBE; ++MBI)
+    OriginalLayoutSuccessors[MBI->getNumber()] =
+        std::next(MBI) == MBE ? nullptr : &*std::next(MBI);
+
+  DenseMap<const MachineBasicBlock *, size_t> NewIndex;
+  for (const MachineBasicBlock *MBB : NewBlockOrder)
+    NewIndex[MBB] = NewIndex.size();
+  F->sort([&](MachineBasicBlock &L, MachineBasicBlock &R) {
+    return NewIndex[&L] < NewIndex[&R];
+  });
+
+  SmallVector<MachineOperand, 4> Cond; // For analyzeBranch.
+  for (MachineBasicBlock &MBB : *F) {
+    Cond.clear();
+    MachineBasicBlock *TBB = nullptr, *FBB = nullptr; // For analyzeBranch.
+    if (!TII->analyzeBranch(MBB, TBB, FBB, Cond))
+      MBB.updateTerminator(OriginalLayoutSuccessors[MBB.getNumber()]);
+  }
+}
+
+void MachineBlockPlacement::createCFGChainExtTsp() {
+  BlockToChain.clear();
+  ComputedEdges.clear();
+  ChainAllocator.DestroyAll();
+
+  MachineBasicBlock *HeadBB = &F->front();
+  BlockChain *FunctionChain =
+      new (ChainAllocator.Allocate()) BlockChain(BlockToChain, HeadBB);
+  for (MachineBasicBlock &MBB : *F)
+    if (&MBB != HeadBB)
+      FunctionChain->merge(&MBB, nullptr);
+}
+
 bool MachineBlockPlacement::runOnMachineFunction(MachineFunction &MF) {
   if (skipFunction(MF.getFunction()))
     return false;
@@ -3383,6 +3509,12 @@ bool MachineBlockPlacement::runOnMachineFunction(MachineFunction &MF) {
     }
   }
 
+  // Refine the layout found above, which is a good starting point as it is
+  // mostly made of fallthroughs, with the ext-TSP model.
+  if (EnableExtTspBlockPlacement && MF.size() >= 3 &&
+      MF.size() <= ExtTspBlockPlacementMaxBlocks && applyExtTsp())
+    createCFGChainExtTsp();
+
   optimizeBranches();
   alignBlocks();
 
@@ -77,7 +77,7 @@ void llvm::splitCodeGen(
           llvm::raw_pwrite_stream *ThreadOS = OSs[ThreadCount++];
           // Enqueue the task
           CodegenThreadPool.async(
-              [TMFactory, FileType, ThreadOS](const SmallString<0> &BC) {
+              [TMFactory, FileType, ThreadOS](SmallString<0> &BC) {
                 LLVMContext Ctx;
                 Expected<std::unique_ptr<Module>> MOrErr = parseBitcodeFile(
                     MemoryBufferRef(StringRef(BC.data(), BC.size()),
@@ -87,6 +87,10 @@ void llvm::splitCodeGen(
                   report_fatal_error("Failed to read bitcode");
                 std::unique_ptr<Module> MPartInCtx = std::move(MOrErr.get());
 
+                // The partition is fully materialized and no longer refers to
+                // its bitcode, so don't keep it alive during code generation.
+                SmallString<0>().swap(BC);
+
                 codegen(MPartInCtx.get(), *ThreadOS, TMFactory, FileType);
               },
               // Pass BC using std::move to ensure that it get moved rather than
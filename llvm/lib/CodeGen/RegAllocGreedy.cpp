@@ -84,6 +84,11 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumSplitSearchesCut,
+          "Number of region split searches cut short by the candidate limit");
+STATISTIC(NumGlobalSplitsSkipped,
+          "Number of global live ranges spilled without splitting in huge "
+          "functions");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -136,6 +141,19 @@ static cl::opt<bool> ConsiderLocalIntervalCost(
              "candidate when choosing the best split candidate."),
     cl::init(false));
 
+static cl::opt<unsigned> RegionSplitMaxCandidates(
+    "regalloc-region-split-max-candidates", cl::Hidden,
+    cl::desc("Maximum number of physical registers evaluated as region split "
+             "candidates for a live range (0 = no limit)"),
+    cl::init(0));
+
+static cl::opt<unsigned> HugeFunctionVirtRegs(
+    "regalloc-huge-function-vregs", cl::Hidden,
+    cl::desc("In functions with more virtual registers than this, spill the "
+             "global live ranges that cannot be assigned instead of splitting "
+             "them, trading code quality for allocation time (0 = never)"),
+    cl::init(0));
+
 static RegisterRegAlloc greedyRegAlloc("greedy", "greedy register allocator",
                                        createGreedyRegisterAllocator);
 
@@ -403,6 +421,10 @@ class RAGreedy : public MachineFunctionPass,
   /// by a split candidate when choosing the best split candidate.
   bool EnableAdvancedRASplitCost;
 
+  /// Whether the function has so many virtual registers that global live
+  /// ranges are spilled rather than split, see -regalloc-huge-function-vregs.
+  bool IsHugeFunction;
+
   /// Set of broken hints that may be reconciled later because of eviction.
   SmallSetVector<LiveInterval *, 8> SetOfBrokenHints;
 
@@ -1864,11 +1886,20 @@ unsigned RAGreedy::calculateRegionSplitCost(LiveInterval &VirtReg,
                                             unsigned &NumCands, bool IgnoreCSR,
                                             bool *CanCauseEvictionChain) {
   unsigned BestCand = NoCand;
+  unsigned NumEvaluated = 0;
   for (MCPhysReg PhysReg : Order) {
     assert(PhysReg);
     if (IgnoreCSR && isUnusedCalleeSavedReg(PhysReg))
       continue;
 
+    // Growing the region of each candidate is the expensive part of the
+    // search; stop once enough candidates have been evaluated.
+    if (RegionSplitMaxCandidates && NumEvaluated == RegionSplitMaxCandidates) {
+      ++NumSplitSearchesCut;
+      break;
+    }
+    ++NumEvaluated;
+
     // Discard bad candidates before we run out of interference cache cursors.
     // This will only affect register classes with a lot of registers (>32).
     if (NumCands == IntfCache.getMaxCursors()) {
@@ -2463,6 +2494,13 @@ unsigned RAGreedy::trySplit(LiveInterval &VirtReg, AllocationOrder &Order,
     return tryInstructionSplit(VirtReg, Order, NewVRegs);
   }
 
+  // In huge functions, global splitting dominates the allocation time. Spill
+  // the live range instead, as a linear scan allocator would.
+  if (IsHugeFunction) {
+    ++NumGlobalSplitsSkipped;
+    return 0;
+  }
+
   NamedRegionTimer T("global_split", "Global Splitting", TimerGroupName,
                      TimerGroupDescription, TimePassesIsEnabled);
 
@@ -3215,6 +3253,9 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
           ? ConsiderLocalIntervalCost
           : MF->getSubtarget().enableAdvancedRASplitCost();
 
+  IsHugeFunction = HugeFunctionVirtRegs &&
+                   MF->getRegInfo().getNumVirtRegs() > HugeFunctionVirtRegs;
+
   if (VerifyEnabled)
     MF->verify(this, "Before greedy register allocator");
 
@@ -29,6 +29,7 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/MemoryLocation.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
@@ -60,9 +61,13 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/KnownBits.h"
 #include "llvm/Support/MachineValueType.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
@@ -86,6 +91,8 @@ STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
 STATISTIC(LdStFP2Int      , "Number of fp load/store pairs transformed to int");
 STATISTIC(SlicedLoads, "Number of load sliced");
 STATISTIC(NumFPLogicOpsConv, "Number of logic ops converted to fp ops");
+STATISTIC(NodesNotRevisited,
+          "Number of unmodified nodes not added back to the worklist");
 
 static cl::opt<bool>
 CombinerGlobalAA("combiner-global-alias-analysis", cl::Hidden,
@@ -137,6 +144,66 @@ static cl::opt<bool> EnableShrinkLoadReplaceStoreWithStore(
     cl::desc("DAG cominber enable load/<replace bytes>/store with "
              "a narrower store"));
 
+static cl::opt<bool> CombinerOnlyModifiedNodes(
+    "combiner-only-modified-nodes", cl::Hidden, cl::init(false),
+    cl::desc("DAG combiner only revisits the nodes created or modified since "
+             "its previous run on the same DAG, and their operands and users, "
+             "instead of every node"));
+
+static cl::opt<bool> CombinerOpcodeStats(
+    "combiner-opcode-stats", cl::Hidden, cl::init(false),
+    cl::desc("Count the DAG combines attempted and succeeded per opcode, "
+             "print them on exit, and time them per opcode with "
+             "-time-passes"));
+
+namespace {
+
+/// The number of combines attempted and succeeded per opcode name, printed to
+/// the -info-output-file stream when destroyed. Functions may be compiled on
+/// several threads, so the counts are guarded by a mutex.
+class CombineOpcodeCounts {
+  sys::SmartMutex<true> Lock;
+  StringMap<std::pair<uint64_t, uint64_t>> Counts;
+
+public:
+  void record(StringRef OpName, bool Succeeded) {
+    sys::SmartScopedLock<true> Guard(Lock);
+    auto &Entry = Counts[OpName];
+    ++Entry.first;
+    if (Succeeded)
+      ++Entry.second;
+  }
+
+  ~CombineOpcodeCounts() {
+    if (Counts.empty())
+      return;
+    std::vector<std::pair<StringRef, std::pair<uint64_t, uint64_t>>> Sorted;
+    for (const auto &Entry : Counts)
+      Sorted.emplace_back(Entry.first(), Entry.second);
+    llvm::sort(Sorted, [](const decltype(Sorted)::value_type &L,
+                          const decltype(Sorted)::value_type &R) {
+      if (L.second.first != R.second.first)
+        return L.second.first > R.second.first;
+      return L.first < R.first;
+    });
+
+    std::unique_ptr<raw_ostream> OS = CreateInfoOutputFile();
+    *OS << "===" << std::string(73, '-') << "===\n"
+        << "                      DAG combines per opcode\n"
+        << "===" << std::string(73, '-') << "===\n"
+        << "  Attempts  Successes  Opcode\n";
+    for (const auto &Entry : Sorted)
+      *OS << format("%10" PRIu64 " %10" PRIu64 "  ", Entry.second.first,
+                    Entry.second.second)
+          << Entry.first << "\n";
+    *OS << "\n";
+  }
+};
+
+} // end anonymous namespace
+
+static ManagedStatic<CombineOpcodeCounts> CombineCounts;
+
 namespace {
 
   class DAGCombiner {
@@ -1510,9 +1577,29 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
 
   WorklistInserter AddNodes(*this);
 
-  // Add all the dag nodes to the worklist.
-  for (SDNode &Node : DAG.allnodes())
+  // Add all the dag nodes to the worklist. If the DAG was combined before and
+  // only the nodes that changed since then are to be revisited, add those and
+  // their operands and users, which may now be combined differently.
+  bool OnlyModified =
+      CombinerOnlyModifiedNodes && DAG.isTrackingModifiedNodes();
+  auto IsAffected = [&](SDNode &Node) {
+    if (DAG.isModifiedNode(&Node))
+      return true;
+    for (const SDValue &Op : Node.op_values())
+      if (DAG.isModifiedNode(Op.getNode()))
+        return true;
+    for (SDNode *User : Node.uses())
+      if (DAG.isModifiedNode(User))
+        return true;
+    return false;
+  };
+  for (SDNode &Node : DAG.allnodes()) {
+    if (OnlyModified && !IsAffected(Node)) {
+      ++NodesNotRevisited;
+      continue;
+    }
     AddToWorklist(&Node);
+  }
 
   // Create a dummy node (which is not added to allnodes), that adds a reference
   // to the root node, preventing it from being deleted, and tracking any
@@ -1552,7 +1639,16 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
       if (!CombinedNodes.count(ChildN.getNode()))
         AddToWorklist(ChildN.getNode());
 
-    SDValue RV = combine(N);
+    SDValue RV;
+    if (LLVM_UNLIKELY(CombinerOpcodeStats)) {
+      std::string OpName = N->getOperationName(&DAG);
+      NamedRegionTimer T(OpName, OpName, "dagcombine", "DAG Combiner",
+                         TimePassesIsEnabled);
+      RV = combine(N);
+      CombineCounts->record(OpName, RV.getNode());
+    } else {
+      RV = combine(N);
+    }
 
     if (!RV.getNode())
       continue;
@@ -1600,6 +1696,11 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
   // If the root changed (e.g. it was a dead load, update the root).
   DAG.setRoot(Dummy.getValue());
   DAG.RemoveDeadNodes();
+
+  // Everything left has been combined; the next run only needs to look at
+  // what changes from now on.
+  if (CombinerOnlyModifiedNodes)
+    DAG.startTrackingModifiedNodes();
 }
 
 SDValue DAGCombiner::visit(SDNode *N) {
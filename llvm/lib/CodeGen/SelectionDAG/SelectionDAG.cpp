@@ -904,6 +904,7 @@ void SelectionDAG::DeallocateNode(SDNode *N) {
   removeOperands(N);
 
   NodeAllocator.Deallocate(AllNodes.remove(N));
+  ModifiedNodes.erase(N);
 
   // Set the opcode to DELETED_NODE to help catch bugs when node
   // memory is reallocated.
@@ -967,6 +968,7 @@ void SelectionDAG::InsertNode(SDNode *N) {
   N->PersistentId = NextPersistentId++;
   VerifySDNode(N);
 #endif
+  noteModifiedNode(N);
   for (DAGUpdateListener *DUL = UpdateListeners; DUL; DUL = DUL->Next)
     DUL->NodeInserted(N);
 }
@@ -1055,6 +1057,7 @@ SelectionDAG::AddModifiedNodeToCSEMaps(SDNode *N) {
   }
 
   // If the node doesn't already exist, we updated it.  Inform listeners.
+  noteModifiedNode(N);
   for (DAGUpdateListener *DUL = UpdateListeners; DUL; DUL = DUL->Next)
     DUL->NodeUpdated(N);
 }
@@ -1229,6 +1232,9 @@ void SelectionDAG::clear() {
   std::fill(ValueTypeNodes.begin(), ValueTypeNodes.end(),
             static_cast<SDNode*>(nullptr));
 
+  ModifiedNodes.clear();
+  TrackModifiedNodes = false;
+
   EntryNode.UseList = nullptr;
   InsertNode(&EntryNode);
   Root = getEntryNode();
@@ -7969,6 +7975,7 @@ SDNode *SelectionDAG::UpdateNodeOperands(SDNode *N, SDValue Op) {
   N->OperandList[0].set(Op);
 
   updateDivergence(N);
+  noteModifiedNode(N);
   // If this gets put into a CSE map, add it.
   if (InsertPos) CSEMap.InsertNode(N, InsertPos);
   return N;
@@ -7998,6 +8005,7 @@ SDNode *SelectionDAG::UpdateNodeOperands(SDNode *N, SDValue Op1, SDValue Op2) {
     N->OperandList[1].set(Op2);
 
   updateDivergence(N);
+  noteModifiedNode(N);
   // If this gets put into a CSE map, add it.
   if (InsertPos) CSEMap.InsertNode(N, InsertPos);
   return N;
@@ -8049,6 +8057,7 @@ UpdateNodeOperands(SDNode *N, ArrayRef<SDValue> Ops) {
       N->OperandList[i].set(Ops[i]);
 
   updateDivergence(N);
+  noteModifiedNode(N);
   // If this gets put into a CSE map, add it.
   if (InsertPos) CSEMap.InsertNode(N, InsertPos);
   return N;
@@ -8246,6 +8255,7 @@ SDNode *SelectionDAG::MorphNodeTo(SDNode *N, unsigned Opc,
 
   if (IP)
     CSEMap.InsertNode(N, IP);   // Memoize the new node.
+  noteModifiedNode(N);
   return N;
 }
 
@@ -2434,6 +2434,13 @@ bool DWARFLinker::link() {
   std::condition_variable ProcessedFilesConditionVariable;
   BitVector ProcessedFiles(NumObjects, false);
 
+  // When running multithreaded, the DIEs of the compile units of an object
+  // file are extracted in parallel before its context info is analyzed.
+  std::unique_ptr<ThreadPool> ExtractPool;
+  if (Options.Threads != 1)
+    ExtractPool =
+        std::make_unique<ThreadPool>(hardware_concurrency(Options.Threads));
+
   //  Analyzing the context info is particularly expensive so it is executed in
   //  parallel with emitting the previous compile unit.
   auto AnalyzeLambda = [&](size_t I) {
@@ -2442,6 +2449,17 @@ bool DWARFLinker::link() {
     if (Context.Skip || !Context.File.Dwarf)
       return;
 
+    if (ExtractPool) {
+      // The DWARF parser is not thread-safe, but extracting the DIEs of
+      // different units is once the abbreviations of every unit have been
+      // parsed, so do that sequentially first.
+      for (const auto &CU : Context.File.Dwarf->compile_units())
+        CU->getAbbreviations();
+      for (const auto &CU : Context.File.Dwarf->compile_units())
+        ExtractPool->async([&CU]() { CU->getUnitDIE(false /*CUDieOnly*/); });
+      ExtractPool->wait();
+    }
+
     for (const auto &CU : Context.File.Dwarf->compile_units()) {
       updateDwarfVersion(CU->getVersion());
       // The !registerModuleReference() condition effectively skips
@@ -45,6 +45,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstdint>
@@ -984,6 +985,24 @@ void DWARFContext::parseDWOUnits(bool Lazy) {
   });
 }
 
+void DWARFContext::extractAllUnitDIEs(unsigned NumThreads) {
+  // The DWARF parser is not thread-safe, but the units only share their
+  // abbreviation tables, which are parsed lazily. Parse those sequentially
+  // first; extracting the DIEs of different units is then independent.
+  SmallVector<DWARFUnit *, 0> Units;
+  for (const auto &U : normal_units())
+    Units.push_back(U.get());
+  for (const auto &U : dwo_units())
+    Units.push_back(U.get());
+  for (DWARFUnit *U : Units)
+    U->getAbbreviations();
+
+  ThreadPool Pool(hardware_concurrency(NumThreads));
+  for (DWARFUnit *U : Units)
+    Pool.async([U]() { U->getUnitDIE(false /*CUDieOnly*/); });
+  Pool.wait();
+}
+
 DWARFCompileUnit *DWARFContext::getCompileUnitForOffset(uint64_t Offset) {
   parseNormalUnits();
   return dyn_cast_or_null<DWARFCompileUnit>(
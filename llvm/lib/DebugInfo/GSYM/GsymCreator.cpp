@@ -10,6 +10,7 @@
 #include "llvm/DebugInfo/GSYM/Header.h"
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
@@ -168,8 +169,9 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
                              "already finalized");
   Finalized = true;
 
-  // Sort function infos so we can emit sorted functions.
-  llvm::sort(Funcs);
+  // Sort function infos so we can emit sorted functions. Large binaries can
+  // have millions of entries, so sort them in parallel.
+  llvm::parallelSort(Funcs);
 
   // Don't let the string table indexes change by finalizing in order.
   StrTab.finalizeInOrder();
@@ -194,10 +196,14 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
   // Note that in case of (b), we cannot include Y in the result because then
   // we wouldn't find any function for range (end of Y, end of X)
   // with binary search
+  //
+  // Entries are compacted in place: Prev is the last entry we kept and
+  // removing it means overwriting it with Curr. Erasing from the middle of
+  // Funcs would make this loop quadratic in the number of pruned entries.
   auto NumBefore = Funcs.size();
-  auto Curr = Funcs.begin();
   auto Prev = Funcs.end();
-  while (Curr != Funcs.end()) {
+  for (auto Curr = Funcs.begin(); Curr != Funcs.end(); ++Curr) {
+    bool RemovePrev = false;
     // Can't check for overlaps or same address ranges if we don't have a
     // previous entry
     if (Prev != Funcs.end()) {
@@ -212,18 +218,18 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
             // FunctionInfo entries match exactly (range, lines, inlines)
             OS << "warning: duplicate function info entries for range: "
                << Curr->Range << '\n';
-            Curr = Funcs.erase(Prev);
+            RemovePrev = true;
           } else {
             if (!Prev->hasRichInfo() && Curr->hasRichInfo()) {
               // Same address range, one with no debug info (symbol) and the
               // next with debug info. Keep the latter.
-              Curr = Funcs.erase(Prev);
+              RemovePrev = true;
             } else {
               OS << "warning: same address range contains different debug "
                  << "info. Removing:\n"
                  << *Prev << "\nIn favor of this one:\n"
                  << *Curr << "\n";
-              Curr = Funcs.erase(Prev);
+              RemovePrev = true;
             }
           }
         } else {
@@ -237,13 +243,16 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
         OS << "warning: removing symbol:\n"
            << *Prev << "\nKeeping:\n"
            << *Curr << "\n";
-        Curr = Funcs.erase(Prev);
+        RemovePrev = true;
       }
     }
-    if (Curr == Funcs.end())
-      break;
-    Prev = Curr++;
+    if (!RemovePrev)
+      Prev = Prev == Funcs.end() ? Funcs.begin() : std::next(Prev);
+    if (Prev != Curr)
+      *Prev = std::move(*Curr);
   }
+  Funcs.erase(Prev == Funcs.end() ? Funcs.begin() : std::next(Prev),
+              Funcs.end());
 
   // If our last function info entry doesn't have a size and if we have valid
   // text ranges, we should set the size of the last entry since any search for
@@ -158,17 +158,23 @@ Error TpiStreamBuilder::finalizeMsfLayout() {
   if (!ExpectedIndex)
     return ExpectedIndex.takeError();
   HashStreamIndex = *ExpectedIndex;
-  if (!TypeHashes.empty()) {
-    ulittle32_t *H = Allocator.Allocate<ulittle32_t>(TypeHashes.size());
-    MutableArrayRef<ulittle32_t> HashBuffer(H, TypeHashes.size());
-    for (uint32_t I = 0; I < TypeHashes.size(); ++I) {
-      HashBuffer[I] = TypeHashes[I] % (MaxTpiHashBuckets - 1);
-    }
-    ArrayRef<uint8_t> Bytes(
-        reinterpret_cast<const uint8_t *>(HashBuffer.data()),
-        calculateHashBufferSize());
-    HashValueStream =
-        std::make_unique<BinaryByteStream>(Bytes, llvm::support::little);
+  return Error::success();
+}
+
+Error TpiStreamBuilder::commitHashValues(BinaryStreamWriter &Writer) const {
+  // The bucket numbers are computed while writing instead of being kept in a
+  // second copy of the hashes for the lifetime of the builder. They are staged
+  // in a small buffer, since every write into the mapped stream has a fixed
+  // overhead.
+  constexpr size_t ChunkSize = 4096;
+  ulittle32_t Chunk[ChunkSize];
+  for (size_t Begin = 0, E = TypeHashes.size(); Begin < E;
+       Begin += ChunkSize) {
+    size_t N = std::min(ChunkSize, E - Begin);
+    for (size_t I = 0; I < N; ++I)
+      Chunk[I] = TypeHashes[Begin + I] % (MaxTpiHashBuckets - 1);
+    if (auto EC = Writer.writeArray(makeArrayRef(Chunk, N)))
+      return EC;
   }
   return Error::success();
 }
@@ -199,10 +205,8 @@ Error TpiStreamBuilder::commit(const msf::MSFLayout &Layout,
     auto HVS = WritableMappedBlockStream::createIndexedStream(
         Layout, Buffer, HashStreamIndex, Allocator);
     BinaryStreamWriter HW(*HVS);
-    if (HashValueStream) {
-      if (auto EC = HW.writeStreamRef(*HashValueStream))
-        return EC;
-    }
+    if (auto EC = commitHashValues(HW))
+      return EC;
 
     for (auto &IndexOffset : TypeIndexOffsets) {
       if (auto EC = HW.writeObject(IndexOffset))
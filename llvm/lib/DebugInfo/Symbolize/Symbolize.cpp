@@ -199,11 +199,67 @@ LLVMSymbolizer::symbolizeFrame(const std::string &ModuleName,
 
 void LLVMSymbolizer::flush() {
   ObjectForUBPathAndArch.clear();
+  LRUBinaries.clear();
+  CacheSize = 0;
+  BinaryForObject.clear();
   BinaryForPath.clear();
   ObjectPairForPathArch.clear();
   Modules.clear();
 }
 
+void LLVMSymbolizer::pruneCache() {
+  // Keep the most recently used binary even if it is larger than the cache on
+  // its own, so that a large binary is not reloaded for every query.
+  while (CacheSize > Opts.MaxCacheSize && !LRUBinaries.empty() &&
+         std::next(LRUBinaries.begin()) != LRUBinaries.end()) {
+    CachedBinary &Bin = LRUBinaries.front();
+    CacheSize -= Bin.size();
+    LRUBinaries.pop_front();
+    Bin.evict();
+  }
+}
+
+CachedBinary *LLVMSymbolizer::getCachedBinary(const ObjectFile *Obj) {
+  if (!Obj)
+    return nullptr;
+  auto I = BinaryForObject.find(Obj);
+  return I != BinaryForObject.end() ? I->second : nullptr;
+}
+
+void LLVMSymbolizer::recordAccess(const ObjectPair &Objects) {
+  if (CachedBinary *Bin = getCachedBinary(Objects.first))
+    recordAccess(*Bin);
+  if (CachedBinary *Bin = getCachedBinary(Objects.second))
+    recordAccess(*Bin);
+}
+
+void LLVMSymbolizer::recordAccess(CachedBinary &Bin) {
+  // Binaries that failed to load are cached but not part of the LRU list.
+  if (Bin->getBinary())
+    LRUBinaries.splice(LRUBinaries.end(), LRUBinaries, Bin.getIterator());
+}
+
+void CachedBinary::pushEvictor(std::function<void()> NewEvictor) {
+  if (!Evictor) {
+    Evictor = std::move(NewEvictor);
+    return;
+  }
+  Evictor = [OldEvictor = std::move(Evictor),
+             NewEvictor = std::move(NewEvictor)]() {
+    NewEvictor();
+    OldEvictor();
+  };
+}
+
+void CachedBinary::evict() {
+  // The last action erases this binary from the cache, so run the actions
+  // from a local copy.
+  std::function<void()> Actions = std::move(Evictor);
+  Evictor = nullptr;
+  if (Actions)
+    Actions();
+}
+
 namespace {
 
 // For Path="/path/to/foo" and Basename="foo" assume that debug info is in
@@ -466,8 +522,10 @@ Expected<LLVMSymbolizer::ObjectPair>
 LLVMSymbolizer::getOrCreateObjectPair(const std::string &Path,
                                       const std::string &ArchName) {
   auto I = ObjectPairForPathArch.find(std::make_pair(Path, ArchName));
-  if (I != ObjectPairForPathArch.end())
+  if (I != ObjectPairForPathArch.end()) {
+    recordAccess(I->second);
     return I->second;
+  }
 
   auto ObjOrErr = getOrCreateObject(Path, ArchName);
   if (!ObjOrErr) {
@@ -489,7 +547,12 @@ LLVMSymbolizer::getOrCreateObjectPair(const std::string &Path,
   if (!DbgObj)
     DbgObj = Obj;
   ObjectPair Res = std::make_pair(Obj, DbgObj);
-  ObjectPairForPathArch.emplace(std::make_pair(Path, ArchName), Res);
+  auto Key = std::make_pair(Path, ArchName);
+  ObjectPairForPathArch.emplace(Key, Res);
+  // Drop the pair when either of its objects is evicted.
+  for (const ObjectFile *O : {Res.first, Res.second})
+    if (CachedBinary *Bin = getCachedBinary(O))
+      Bin->pushEvictor([this, Key]() { ObjectPairForPathArch.erase(Key); });
   return Res;
 }
 
@@ -497,15 +560,20 @@ Expected<ObjectFile *>
 LLVMSymbolizer::getOrCreateObject(const std::string &Path,
                                   const std::string &ArchName) {
   Binary *Bin;
-  auto Pair = BinaryForPath.emplace(Path, OwningBinary<Binary>());
+  auto Pair = BinaryForPath.emplace(Path, CachedBinary());
+  CachedBinary &CachedBin = Pair.first->second;
   if (!Pair.second) {
-    Bin = Pair.first->second.getBinary();
+    Bin = CachedBin->getBinary();
+    recordAccess(CachedBin);
   } else {
     Expected<OwningBinary<Binary>> BinOrErr = createBinary(Path);
     if (!BinOrErr)
       return BinOrErr.takeError();
-    Pair.first->second = std::move(BinOrErr.get());
-    Bin = Pair.first->second.getBinary();
+    *CachedBin = std::move(BinOrErr.get());
+    CachedBin.pushEvictor([this, Path]() { BinaryForPath.erase(Path); });
+    LRUBinaries.push_back(CachedBin);
+    CacheSize += CachedBin.size();
+    Bin = CachedBin->getBinary();
   }
 
   if (!Bin)
@@ -524,12 +592,20 @@ LLVMSymbolizer::getOrCreateObject(const std::string &Path,
       return ObjOrErr.takeError();
     }
     ObjectFile *Res = ObjOrErr->get();
-    ObjectForUBPathAndArch.emplace(std::make_pair(Path, ArchName),
-                                   std::move(ObjOrErr.get()));
+    auto Key = std::make_pair(Path, ArchName);
+    ObjectForUBPathAndArch.emplace(Key, std::move(ObjOrErr.get()));
+    CachedBin.pushEvictor([this, Key, Res]() {
+      BinaryForObject.erase(Res);
+      ObjectForUBPathAndArch.erase(Key);
+    });
+    BinaryForObject[Res] = &CachedBin;
     return Res;
   }
   if (Bin->isObject()) {
-    return cast<ObjectFile>(Bin);
+    ObjectFile *Res = cast<ObjectFile>(Bin);
+    if (BinaryForObject.try_emplace(Res, &CachedBin).second)
+      CachedBin.pushEvictor([this, Res]() { BinaryForObject.erase(Res); });
+    return Res;
   }
   return errorCodeToError(object_error::arch_not_found);
 }
@@ -543,19 +619,21 @@ LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
   std::unique_ptr<SymbolizableModule> SymMod;
   if (InfoOrErr)
     SymMod = std::move(*InfoOrErr);
-  auto InsertResult = Modules.insert(
-      std::make_pair(std::string(ModuleName), std::move(SymMod)));
+  auto InsertResult = Modules.insert(std::make_pair(
+      std::string(ModuleName), CachedModule{std::move(SymMod), {Obj, Obj}}));
   assert(InsertResult.second);
   if (!InfoOrErr)
     return InfoOrErr.takeError();
-  return InsertResult.first->second.get();
+  return InsertResult.first->second.Module.get();
 }
 
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   auto I = Modules.find(ModuleName);
-  if (I != Modules.end())
-    return I->second.get();
+  if (I != Modules.end()) {
+    recordAccess(I->second.Objects);
+    return I->second.Module.get();
+  }
 
   std::string BinaryName = ModuleName;
   std::string ArchName = Opts.DefaultArch;
@@ -571,7 +649,7 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   auto ObjectsOrErr = getOrCreateObjectPair(BinaryName, ArchName);
   if (!ObjectsOrErr) {
     // Failed to find valid object file.
-    Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+    Modules.emplace(ModuleName, CachedModule());
     return ObjectsOrErr.takeError();
   }
   ObjectPair Objects = ObjectsOrErr.get();
@@ -591,7 +669,7 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
           Opts.UseDIA ? PDB_ReaderType::DIA : PDB_ReaderType::Native;
       if (auto Err = loadDataForEXE(ReaderType, Objects.first->getFileName(),
                                     Session)) {
-        Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+        Modules.emplace(ModuleName, CachedModule());
         // Return along the PDB filename to provide more context
         return createFileError(PDBFileName, std::move(Err));
       }
@@ -600,7 +678,16 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   }
   if (!Context)
     Context = DWARFContext::create(*Objects.second, nullptr, Opts.DWPName);
-  return createModuleInfo(Objects.first, std::move(Context), ModuleName);
+  auto ModuleOrErr =
+      createModuleInfo(Objects.first, std::move(Context), ModuleName);
+
+  // Drop the module when either of the objects it was created from is
+  // evicted.
+  Modules.find(ModuleName)->second.Objects = Objects;
+  for (const ObjectFile *O : {Objects.first, Objects.second})
+    if (CachedBinary *Bin = getCachedBinary(O))
+      Bin->pushEvictor([this, ModuleName]() { Modules.erase(ModuleName); });
+  return ModuleOrErr;
 }
 
 Expected<SymbolizableModule *>
@@ -608,7 +695,7 @@ LLVMSymbolizer::getOrCreateModuleInfo(const ObjectFile &Obj) {
   StringRef ObjName = Obj.getFileName();
   auto I = Modules.find(ObjName);
   if (I != Modules.end())
-    return I->second.get();
+    return I->second.Module.get();
 
   std::unique_ptr<DIContext> Context = DWARFContext::create(Obj);
   // FIXME: handle COFF object with PDB info to use PDBContext
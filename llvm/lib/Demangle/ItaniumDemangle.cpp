@@ -252,13 +252,26 @@ class BumpPointerAllocator {
   static constexpr size_t AllocSize = 4096;
   static constexpr size_t UsableAllocSize = AllocSize - sizeof(BlockMeta);
 
+  // Marks blocks made by allocateMassive, which are never reused.
+  static constexpr size_t MassiveBlock = ~size_t(0);
+
   alignas(long double) char InitialBuffer[AllocSize];
   BlockMeta* BlockList = nullptr;
+  // Blocks released by reset(). They are handed out again by grow(), so that
+  // an ItaniumPartialDemangler demangling many names only calls malloc when a
+  // name needs more memory than any before it.
+  BlockMeta* FreeList = nullptr;
 
   void grow() {
-    char* NewMeta = static_cast<char *>(std::malloc(AllocSize));
-    if (NewMeta == nullptr)
-      std::terminate();
+    char* NewMeta;
+    if (FreeList) {
+      NewMeta = reinterpret_cast<char*>(FreeList);
+      FreeList = FreeList->Next;
+    } else {
+      NewMeta = static_cast<char *>(std::malloc(AllocSize));
+      if (NewMeta == nullptr)
+        std::terminate();
+    }
     BlockList = new (NewMeta) BlockMeta{BlockList, 0};
   }
 
@@ -267,7 +280,7 @@ class BumpPointerAllocator {
     BlockMeta* NewMeta = reinterpret_cast<BlockMeta*>(std::malloc(NBytes));
     if (NewMeta == nullptr)
       std::terminate();
-    BlockList->Next = new (NewMeta) BlockMeta{BlockList->Next, 0};
+    BlockList->Next = new (NewMeta) BlockMeta{BlockList->Next, MassiveBlock};
     return static_cast<void*>(NewMeta + 1);
   }
 
@@ -291,13 +304,26 @@ public:
     while (BlockList) {
       BlockMeta* Tmp = BlockList;
       BlockList = BlockList->Next;
-      if (reinterpret_cast<char*>(Tmp) != InitialBuffer)
+      if (reinterpret_cast<char*>(Tmp) == InitialBuffer)
+        continue;
+      if (Tmp->Current == MassiveBlock) {
         std::free(Tmp);
+        continue;
+      }
+      Tmp->Next = FreeList;
+      FreeList = Tmp;
     }
     BlockList = new (InitialBuffer) BlockMeta{nullptr, 0};
   }
 
-  ~BumpPointerAllocator() { reset(); }
+  ~BumpPointerAllocator() {
+    reset();
+    while (FreeList) {
+      BlockMeta* Tmp = FreeList;
+      FreeList = FreeList->Next;
+      std::free(Tmp);
+    }
+  }
 };
 
 class DefaultAllocator {
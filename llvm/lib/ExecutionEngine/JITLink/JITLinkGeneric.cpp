@@ -14,6 +14,7 @@
 
 #include "llvm/Support/BinaryStreamReader.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -350,6 +351,8 @@ void JITLinkerBase::copyBlockContentToWorkingMemory(
         Alloc.getWorkingMemory(static_cast<sys::Memory::ProtectionFlags>(Prot));
     char *LastBlockEnd = SegMem.data();
     char *BlockDataPtr = LastBlockEnd;
+    std::vector<char *> BlockDataPtrs;
+    BlockDataPtrs.reserve(SegLayout.ContentBlocks.size());
 
     LLVM_DEBUG({
       dbgs() << "  Processing segment "
@@ -381,23 +384,28 @@ void JITLinkerBase::copyBlockContentToWorkingMemory(
       while (LastBlockEnd != BlockDataPtr)
         *LastBlockEnd++ = 0;
 
-      // Copy initial block content.
       LLVM_DEBUG({
         dbgs() << "      Copying block " << *B << " content, "
                << B->getContent().size() << " bytes, from "
                << (const void *)B->getContent().data() << " to "
                << (const void *)BlockDataPtr << "\n";
       });
-      memcpy(BlockDataPtr, B->getContent().data(), B->getContent().size());
-
-      // Point the block's content to the fixed up buffer.
-      B->setContent(StringRef(BlockDataPtr, B->getContent().size()));
+      BlockDataPtrs.push_back(BlockDataPtr);
 
       // Update block end pointer.
       LastBlockEnd = BlockDataPtr + B->getContent().size();
       BlockDataPtr = LastBlockEnd;
     }
 
+    // Copy initial block content and point each block's content to the fixed
+    // up buffer. Blocks occupy disjoint ranges of the segment, so they can be
+    // copied in parallel.
+    parallelForEachN(0, SegLayout.ContentBlocks.size(), [&](size_t I) {
+      auto *B = SegLayout.ContentBlocks[I];
+      memcpy(BlockDataPtrs[I], B->getContent().data(), B->getContent().size());
+      B->setContent(StringRef(BlockDataPtrs[I], B->getContent().size()));
+    });
+
     // Zero pad the rest of the segment.
     LLVM_DEBUG({
       dbgs() << "    Zero padding end of segment from "
@@ -15,6 +15,7 @@
 
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -141,11 +142,11 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
-    for (auto *B : G.blocks()) {
-      LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-      // Copy Block data and apply fixups.
-      LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    // Each fixup only writes to the working memory of the block that contains
+    // it, so blocks can be fixed up in parallel.
+    std::vector<Block *> Blocks(G.blocks().begin(), G.blocks().end());
+    return parallelForEachError(Blocks, [&](Block *B) -> Error {
+      LLVM_DEBUG(dbgs() << "  " << *B << ": applying fixups.\n");
       for (auto &E : B->edges()) {
 
         // Skip non-relocation edges.
@@ -157,9 +158,8 @@ private:
         if (auto Err = impl().applyFixup(G, *B, E, BlockData))
           return Err;
       }
-    }
-
-    return Error::success();
+      return Error::success();
+    });
   }
 };
 
@@ -0,0 +1,128 @@
+//===- CallCountingLayer.cpp - Detect hot functions at runtime ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CallCountingLayer.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Type.h"
+#include "llvm/IR/Verifier.h"
+
+namespace llvm {
+namespace orc {
+
+CallCountingLayer::CallCountingLayer(ExecutionSession &ES, IRLayer &BaseLayer,
+                                     MangleAndInterner &Mangle,
+                                     uint64_t HotThreshold,
+                                     HotFunctionHandler OnHotFunction)
+    : IRLayer(ES, BaseLayer.getManglingOptions()), BaseLayer(BaseLayer),
+      Mangle(Mangle), HotThreshold(HotThreshold),
+      OnHotFunction(std::move(OnHotFunction)) {
+  assert(HotThreshold > 0 && "A function is hot after at least one call");
+}
+
+void CallCountingLayer::hotFunctionEntryPoint(CallCountingLayer *Layer,
+                                              uint64_t FunctionId) {
+  assert(Layer && "Null layer received in __orc_hot_function");
+  std::pair<JITDylib *, SymbolStringPtr> Function;
+  {
+    std::lock_guard<std::mutex> Lock(Layer->FunctionsMutex);
+    assert(FunctionId < Layer->Functions.size() && "Unknown function id");
+    Function = Layer->Functions[FunctionId];
+  }
+  Layer->OnHotFunction(*Function.first, std::move(Function.second));
+}
+
+Error CallCountingLayer::addRuntime(JITDylib &JD) {
+  JITEvaluatedSymbol ThisPtr(pointerToJITTargetAddress(this),
+                             JITSymbolFlags::Exported);
+  JITEvaluatedSymbol HotFunctionEntryPtr(
+      pointerToJITTargetAddress(&hotFunctionEntryPoint),
+      JITSymbolFlags::Exported);
+  return JD.define(absoluteSymbols({
+      {Mangle("__orc_call_counter"), ThisPtr},            // Data Symbol
+      {Mangle("__orc_hot_function"), HotFunctionEntryPtr} // Callable Symbol
+  }));
+}
+
+// If two modules share the same LLVMContext, different threads must not access
+// them concurrently without locking the associated LLVMContext; the
+// instrumentation is done under the module lock.
+void CallCountingLayer::emit(std::unique_ptr<MaterializationResponsibility> R,
+                             ThreadSafeModule TSM) {
+  assert(TSM && "Call counting layer received a null module");
+
+  TSM.withModuleDo([this, &R](Module &M) {
+    LLVMContext &Ctx = M.getContext();
+    Type *Int8Ty = Type::getInt8Ty(Ctx);
+    Type *Int64Ty = Type::getInt64Ty(Ctx);
+    FunctionType *RuntimeCallTy = FunctionType::get(
+        Type::getVoidTy(Ctx), {Int8Ty->getPointerTo(), Int64Ty}, false);
+    FunctionCallee RuntimeCall =
+        M.getOrInsertFunction("__orc_hot_function", RuntimeCallTy);
+    Constant *LayerAddr = M.getOrInsertGlobal("__orc_call_counter", Int8Ty);
+
+    IRBuilder<> Builder(Ctx);
+    for (Function &Fn : M) {
+      // Functions with local linkage cannot be looked up, and so cannot be
+      // redirected either.
+      if (Fn.isDeclaration() || Fn.hasLocalLinkage())
+        continue;
+
+      uint64_t FunctionId;
+      {
+        std::lock_guard<std::mutex> Lock(FunctionsMutex);
+        FunctionId = Functions.size();
+        Functions.emplace_back(&R->getTargetJITDylib(), Mangle(Fn.getName()));
+      }
+
+      auto *Counter = new GlobalVariable(
+          M, Int64Ty, false, GlobalValue::InternalLinkage,
+          ConstantInt::get(Int64Ty, 0), "__orc_call_count.for." + Fn.getName());
+      Counter->setAlignment(Align(8));
+      Counter->setUnnamedAddr(GlobalValue::UnnamedAddr::Local);
+
+      // Keep the static allocas in the entry block, and count the call right
+      // after them.
+      BasicBlock &Entry = Fn.getEntryBlock();
+      BasicBlock::iterator SplitPt = Entry.begin();
+      while (isa<AllocaInst>(SplitPt))
+        ++SplitPt;
+      BasicBlock *Body =
+          Entry.splitBasicBlock(SplitPt, "__orc_call_count.body");
+      Entry.getTerminator()->eraseFromParent();
+      BasicBlock *Notify =
+          BasicBlock::Create(Ctx, "__orc_call_count.hot", &Fn, Body);
+
+      // Only the call that reaches the threshold reports the function.
+      Builder.SetInsertPoint(&Entry);
+      Value *Count = Builder.CreateAtomicRMW(
+          AtomicRMWInst::Add, Counter, ConstantInt::get(Int64Ty, 1),
+          MaybeAlign(8), AtomicOrdering::Monotonic);
+      Value *IsHot = Builder.CreateICmpEQ(
+          Count, ConstantInt::get(Int64Ty, HotThreshold - 1), "is.hot");
+      Builder.CreateCondBr(IsHot, Notify, Body);
+
+      Builder.SetInsertPoint(Notify);
+      Builder.CreateCall(RuntimeCall,
+                         {LayerAddr, ConstantInt::get(Int64Ty, FunctionId)});
+      Builder.CreateBr(Body);
+    }
+  });
+
+  assert(!TSM.withModuleDo([](const Module &M) { return verifyModule(M); }) &&
+         "Call counting instrumentation breaks IR?");
+
+  BaseLayer.emit(std::move(R), std::move(TSM));
+}
+
+} // end namespace orc
+} // end namespace llvm
@@ -0,0 +1,126 @@
+//===--------- DiskObjectCache.cpp - Persistent cache of JIT'd objects ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/DiskObjectCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+Expected<std::unique_ptr<DiskObjectCache>>
+DiskObjectCache::Create(StringRef CacheDir,
+                        const JITTargetMachineBuilder &JTMB) {
+  if (std::error_code EC = sys::fs::create_directories(CacheDir))
+    return createFileError(CacheDir, EC);
+
+  // Everything besides the IR that changes the generated code.
+  std::string TargetKey;
+  raw_string_ostream OS(TargetKey);
+  OS << JTMB.getTargetTriple().str() << '\0' << JTMB.getCPU() << '\0'
+     << JTMB.getFeatures().getString() << '\0'
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << '\0';
+  if (JTMB.getRelocationModel())
+    OS << static_cast<int>(*JTMB.getRelocationModel());
+  OS << '\0';
+  if (JTMB.getCodeModel())
+    OS << static_cast<int>(*JTMB.getCodeModel());
+  OS << '\0' << JTMB.getOptions().EmulatedTLS;
+  OS.flush();
+
+  return std::unique_ptr<DiskObjectCache>(
+      new DiskObjectCache(CacheDir, std::move(TargetKey)));
+}
+
+DiskObjectCache::DiskObjectCache(StringRef CacheDir, std::string TargetKey)
+    : CacheDir(CacheDir.str()), TargetKey(std::move(TargetKey)) {}
+
+SmallString<128> DiskObjectCache::getEntryPath(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, "orc-" + toHex(Hasher.final()) + ".o");
+  return Path;
+}
+
+std::unique_ptr<MemoryBuffer> DiskObjectCache::getObject(const Module *M) {
+  SmallString<128> EntryPath = getEntryPath(*M);
+  auto Buffer = MemoryBuffer::getFile(EntryPath, /*FileSize=*/-1,
+                                      /*RequiresNullTerminator=*/false);
+  if (!Buffer) {
+    // Code generation changes the module, so remember the key of the IR we
+    // were asked for until the compiled object is stored.
+    std::lock_guard<std::mutex> Lock(PendingEntriesMutex);
+    PendingEntries[M] = std::move(EntryPath);
+    return nullptr;
+  }
+  LLVM_DEBUG({
+    dbgs() << "Loaded " << M->getModuleIdentifier() << " from the cache\n";
+  });
+  return std::move(*Buffer);
+}
+
+void DiskObjectCache::notifyObjectCompiled(const Module *M,
+                                           MemoryBufferRef Obj) {
+  SmallString<128> EntryPath;
+  {
+    std::lock_guard<std::mutex> Lock(PendingEntriesMutex);
+    auto It = PendingEntries.find(M);
+    // Without a key computed by getObject, we can't tell which IR the object
+    // was compiled from.
+    if (It == PendingEntries.end())
+      return;
+    EntryPath = std::move(It->second);
+    PendingEntries.erase(It);
+  }
+
+  // Write a temporary file and rename it, so that another process looking at
+  // the entry never sees it partially written.
+  SmallString<128> TempModel(CacheDir);
+  sys::path::append(TempModel, "orc-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+    OS.flush();
+    if (OS.has_error()) {
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return;
+    }
+  }
+
+  if (Error Err = Temp->keep(EntryPath))
+    consumeError(std::move(Err));
+}
+
+} // end namespace orc
+} // end namespace llvm
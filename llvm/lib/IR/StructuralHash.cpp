@@ -7,10 +7,11 @@
 //===----------------------------------------------------------------------===//
 //
 
-#ifdef EXPENSIVE_CHECKS
-
 #include "llvm/IR/StructuralHash.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Module.h"
 
 using namespace llvm;
@@ -24,11 +25,53 @@ namespace details {
 
 class StructuralHash {
   uint64_t Hash = 0x6acaa36bef8325c5ULL;
+  bool DetailedHash;
+
+  /// Numbers of the blocks and instructions of the function being hashed, in
+  /// layout order, so that operands can be hashed by position.
+  DenseMap<const Value *, unsigned> LocalNumbers;
 
   void update(uint64_t V) { Hash = hashing::detail::hash_16_bytes(Hash, V); }
 
+  void update(const Type *T) {
+    update(T->getTypeID());
+    if (T->isIntegerTy() || T->isFloatingPointTy() || T->isVectorTy())
+      update(T->getPrimitiveSizeInBits().getKnownMinSize());
+  }
+
+  void update(const Value *V) {
+    update(V->getValueID());
+    if (auto *A = dyn_cast<Argument>(V))
+      return update(A->getArgNo());
+    if (auto *GV = dyn_cast<GlobalValue>(V))
+      return update(hash_value(GV->getName()));
+    if (auto *CI = dyn_cast<ConstantInt>(V))
+      return update(hash_value(CI->getValue()));
+    if (auto *CFP = dyn_cast<ConstantFP>(V))
+      return update(hash_value(CFP->getValueAPF()));
+    update(V->getType());
+    auto It = LocalNumbers.find(V);
+    if (It != LocalNumbers.end())
+      update(It->second);
+    // Other constants are only hashed by kind and type, and their operands.
+    if (auto *C = dyn_cast<ConstantExpr>(V)) {
+      update(C->getOpcode());
+      for (const Value *Op : C->operands())
+        update(Op);
+    }
+  }
+
+  void updateDetails(const Instruction &I) {
+    update(I.getType());
+    update(I.getRawSubclassOptionalData());
+    if (auto *Cmp = dyn_cast<CmpInst>(&I))
+      update(Cmp->getPredicate());
+    for (const Value *Op : I.operands())
+      update(Op);
+  }
+
 public:
-  StructuralHash() = default;
+  explicit StructuralHash(bool DetailedHash) : DetailedHash(DetailedHash) {}
 
   void update(const Function &F) {
     if (F.empty())
@@ -40,13 +83,26 @@ public:
     SmallVector<const BasicBlock *, 8> BBs;
     SmallPtrSet<const BasicBlock *, 16> VisitedBBs;
 
+    if (DetailedHash) {
+      // Number everything first, operands may refer to later instructions.
+      LocalNumbers.clear();
+      for (const BasicBlock &BB : F) {
+        LocalNumbers[&BB] = LocalNumbers.size();
+        for (const Instruction &I : BB)
+          LocalNumbers[&I] = LocalNumbers.size();
+      }
+    }
+
     BBs.push_back(&F.getEntryBlock());
     VisitedBBs.insert(BBs[0]);
     while (!BBs.empty()) {
       const BasicBlock *BB = BBs.pop_back_val();
       update(45798); // Block header
-      for (auto &Inst : *BB)
+      for (auto &Inst : *BB) {
         update(Inst.getOpcode());
+        if (DetailedHash)
+          updateDetails(Inst);
+      }
 
       const Instruction *Term = BB->getTerminator();
       for (unsigned i = 0, e = Term->getNumSuccessors(); i != e; ++i) {
@@ -69,16 +125,14 @@ public:
 
 } // namespace
 
-uint64_t llvm::StructuralHash(const Function &F) {
-  details::StructuralHash H;
+uint64_t llvm::StructuralHash(const Function &F, bool DetailedHash) {
+  details::StructuralHash H(DetailedHash);
   H.update(F);
   return H.getHash();
 }
 
-uint64_t llvm::StructuralHash(const Module &M) {
-  details::StructuralHash H;
+uint64_t llvm::StructuralHash(const Module &M, bool DetailedHash) {
+  details::StructuralHash H(DetailedHash);
   H.update(M);
   return H.getHash();
 }
-
-#endif
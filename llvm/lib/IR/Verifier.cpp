@@ -105,6 +105,7 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -120,6 +121,11 @@ static cl::opt<bool> VerifyNoAliasScopeDomination(
     cl::desc("Ensure that llvm.experimental.noalias.scope.decl for identical "
              "scopes are not dominating"));
 
+static cl::opt<bool> VerifyParallelDomTrees(
+    "verify-parallel-domtrees", cl::Hidden, cl::init(false),
+    cl::desc("Build the dominator trees of functions in parallel when "
+             "verifying a whole module"));
+
 namespace llvm {
 
 struct VerifierSupport {
@@ -332,7 +338,9 @@ public:
 
   bool hasBrokenDebugInfo() const { return BrokenDebugInfo; }
 
-  bool verify(const Function &F) {
+  /// Verify \p F. If \p PrecomputedDT is given, it must be the dominator tree
+  /// of \p F, and is used instead of computing one.
+  bool verify(const Function &F, DominatorTree *PrecomputedDT = nullptr) {
     assert(F.getParent() == &M &&
            "An instance of this class only works with a specific module!");
 
@@ -342,7 +350,9 @@ public:
     // out-of-date dominator tree and makes it significantly more complex to run
     // this code outside of a pass manager.
     // FIXME: It's really gross that we have to cast away constness here.
-    if (!F.empty())
+    if (PrecomputedDT)
+      DT = std::move(*PrecomputedDT);
+    else if (!F.empty())
       DT.recalculate(const_cast<Function &>(F));
 
     for (const BasicBlock &BB : F) {
@@ -5649,8 +5659,37 @@ bool llvm::verifyModule(const Module &M, raw_ostream *OS,
   Verifier V(OS, /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo, M);
 
   bool Broken = false;
-  for (const Function &F : M)
-    Broken |= !V.verify(F);
+  if (VerifyParallelDomTrees) {
+    // Building a dominator tree only reads the CFG of its function, unlike
+    // the checks themselves, which may create constants and types in the
+    // LLVMContext. So the trees are built in parallel, a batch of functions
+    // at a time to bound memory, and the functions are then checked in order
+    // as usual. Trees are only built for functions that will get past the
+    // terminator check in Verifier::verify.
+    constexpr size_t BatchSize = 256;
+    std::vector<const Function *> Functions;
+    for (const Function &F : M)
+      Functions.push_back(&F);
+    std::vector<Optional<DominatorTree>> DTs(BatchSize);
+    for (size_t Begin = 0, E = Functions.size(); Begin < E;
+         Begin += BatchSize) {
+      size_t N = std::min(BatchSize, E - Begin);
+      parallelForEachN(0, N, [&](size_t I) {
+        const Function &F = *Functions[Begin + I];
+        DTs[I].reset();
+        if (!F.empty() && all_of(F, [](const BasicBlock &BB) {
+              return !BB.empty() && BB.back().isTerminator();
+            }))
+          DTs[I].emplace(const_cast<Function &>(F));
+      });
+      for (size_t I = 0; I != N; ++I)
+        Broken |= !V.verify(*Functions[Begin + I],
+                            DTs[I] ? DTs[I].getPointer() : nullptr);
+    }
+  } else {
+    for (const Function &F : M)
+      Broken |= !V.verify(F);
+  }
 
   Broken |= !V.verify();
   if (BrokenDebugInfo)
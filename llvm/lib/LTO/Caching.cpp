@@ -28,8 +28,74 @@
 using namespace llvm;
 using namespace llvm::lto;
 
-Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
-                                            AddBufferFn AddBuffer) {
+// Atomically write Data to Path, going through a temporary file in the same
+// directory so that readers never see a partially written file.
+static Error writeFileAtomically(StringRef Dir, const Twine &Path,
+                                 StringRef Data) {
+  SmallString<64> TempFilenameModel;
+  sys::path::append(TempFilenameModel, Dir, "Thin-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp)
+    return Temp.takeError();
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Data;
+    OS.flush();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return errorCodeToError(EC);
+    }
+  }
+  return Temp->keep(Path);
+}
+
+namespace {
+class DirectoryObjectStore : public SharedObjectStore {
+public:
+  explicit DirectoryObjectStore(StringRef Path) : Path(Path) {}
+
+  Expected<std::unique_ptr<MemoryBuffer>> fetch(StringRef Key) override {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr = MemoryBuffer::getFile(
+        getEntryPath(Key), /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+    if (MBOrErr)
+      return std::move(*MBOrErr);
+    if (MBOrErr.getError() == errc::no_such_file_or_directory)
+      return nullptr;
+    return errorCodeToError(MBOrErr.getError());
+  }
+
+  Error store(StringRef Key, MemoryBufferRef Object) override {
+    std::string EntryPath = getEntryPath(Key);
+    // Objects are content-addressed, so an existing entry is already correct.
+    if (sys::fs::exists(EntryPath))
+      return Error::success();
+    return writeFileAtomically(Path, EntryPath, Object.getBuffer());
+  }
+
+private:
+  std::string getEntryPath(StringRef Key) const {
+    SmallString<64> EntryPath;
+    sys::path::append(EntryPath, Path, "llvmcache-" + Key);
+    return std::string(EntryPath.str());
+  }
+
+  std::string Path;
+};
+} // namespace
+
+Expected<std::unique_ptr<SharedObjectStore>>
+lto::createDirectoryObjectStore(StringRef DirectoryPath) {
+  if (std::error_code EC = sys::fs::create_directories(DirectoryPath))
+    return errorCodeToError(EC);
+  return std::make_unique<DirectoryObjectStore>(DirectoryPath);
+}
+
+Expected<NativeObjectCache>
+lto::localCache(StringRef CacheDirectoryPath, AddBufferFn AddBuffer,
+                std::shared_ptr<SharedObjectStore> Shared) {
   if (std::error_code EC = sys::fs::create_directories(CacheDirectoryPath))
     return errorCodeToError(EC);
 
@@ -68,6 +134,21 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       report_fatal_error(Twine("Failed to open cache file ") + EntryPath +
                          ": " + EC.message() + "\n");
 
+    // Then try the shared store. A hit is copied into the local cache so that
+    // the next link on this machine doesn't need to go to the store again.
+    // Errors just mean that we build the object ourselves.
+    if (Shared) {
+      Expected<std::unique_ptr<MemoryBuffer>> MBOrErr = Shared->fetch(Key);
+      if (MBOrErr && *MBOrErr) {
+        consumeError(writeFileAtomically(CacheDirectoryPath, EntryPath,
+                                         (*MBOrErr)->getBuffer()));
+        AddBuffer(Task, std::move(*MBOrErr));
+        return AddStreamFn();
+      }
+      if (!MBOrErr)
+        consumeError(MBOrErr.takeError());
+    }
+
     // This native object stream is responsible for commiting the resulting
     // file to the cache and calling AddBuffer to add it to the link.
     struct CacheStream : NativeObjectStream {
@@ -75,13 +156,16 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       sys::fs::TempFile TempFile;
       std::string EntryPath;
       unsigned Task;
+      std::shared_ptr<SharedObjectStore> Shared;
+      std::string Key;
 
       CacheStream(std::unique_ptr<raw_pwrite_stream> OS, AddBufferFn AddBuffer,
                   sys::fs::TempFile TempFile, std::string EntryPath,
-                  unsigned Task)
+                  unsigned Task, std::shared_ptr<SharedObjectStore> Shared,
+                  std::string Key)
           : NativeObjectStream(std::move(OS)), AddBuffer(std::move(AddBuffer)),
             TempFile(std::move(TempFile)), EntryPath(std::move(EntryPath)),
-            Task(Task) {}
+            Task(Task), Shared(std::move(Shared)), Key(std::move(Key)) {}
 
       ~CacheStream() {
         // Make sure the stream is closed before committing it.
@@ -127,11 +211,15 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                              TempFile.TmpName + " to " + EntryPath + ": " +
                              toString(std::move(E)) + "\n");
 
+        if (Shared)
+          consumeError(Shared->store(Key, **MBOrErr));
+
         AddBuffer(Task, std::move(*MBOrErr));
       }
     };
 
-    return [=](size_t Task) -> std::unique_ptr<NativeObjectStream> {
+    return [=, Key = Key.str()](
+               size_t Task) -> std::unique_ptr<NativeObjectStream> {
       // Write to a temporary to avoid race condition
       SmallString<64> TempFilenameModel;
       sys::path::append(TempFilenameModel, CacheDirectoryPath, "Thin-%%%%%%.tmp.o");
@@ -145,7 +233,8 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       // This CacheStream will move the temporary file into the cache when done.
       return std::make_unique<CacheStream>(
           std::make_unique<raw_fd_ostream>(Temp->FD, /* ShouldClose */ false),
-          AddBuffer, std::move(*Temp), std::string(EntryPath.str()), Task);
+          AddBuffer, std::move(*Temp), std::string(EntryPath.str()), Task,
+          Shared, Key);
     };
   };
 }
@@ -36,8 +36,10 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Memory.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
@@ -54,6 +56,8 @@
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <set>
 
 using namespace llvm;
@@ -717,6 +721,7 @@ LTO::addRegularLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
     return MOrErr.takeError();
   Module &M = **MOrErr;
   Mod.M = std::move(*MOrErr);
+  Mod.Buffer = BM.getBuffer();
 
   if (Error Err = M.materializeMetadata())
     return std::move(Err);
@@ -994,34 +999,38 @@ Error LTO::checkPartiallySplit() {
 Error LTO::run(AddStreamFn AddStream, NativeObjectCache Cache) {
   // Compute "dead" symbols, we don't want to import/export these!
   DenseSet<GlobalValue::GUID> GUIDPreservedSymbols;
-  DenseMap<GlobalValue::GUID, PrevailingType> GUIDPrevailingResolutions;
-  for (auto &Res : GlobalResolutions) {
-    // Normally resolution have IR name of symbol. We can do nothing here
-    // otherwise. See comments in GlobalResolution struct for more details.
-    if (Res.second.IRName.empty())
-      continue;
+  {
+    // GUIDPrevailingResolutions is only needed for dead symbol computation.
+    // Scope it so that it is freed before the backends run.
+    DenseMap<GlobalValue::GUID, PrevailingType> GUIDPrevailingResolutions;
+    for (auto &Res : GlobalResolutions) {
+      // Normally resolution have IR name of symbol. We can do nothing here
+      // otherwise. See comments in GlobalResolution struct for more details.
+      if (Res.second.IRName.empty())
+        continue;
 
-    GlobalValue::GUID GUID = GlobalValue::getGUID(
-        GlobalValue::dropLLVMManglingEscape(Res.second.IRName));
+      GlobalValue::GUID GUID = GlobalValue::getGUID(
+          GlobalValue::dropLLVMManglingEscape(Res.second.IRName));
 
-    if (Res.second.VisibleOutsideSummary && Res.second.Prevailing)
-      GUIDPreservedSymbols.insert(GUID);
+      if (Res.second.VisibleOutsideSummary && Res.second.Prevailing)
+        GUIDPreservedSymbols.insert(GUID);
 
-    if (Res.second.ExportDynamic)
-      DynamicExportSymbols.insert(GUID);
+      if (Res.second.ExportDynamic)
+        DynamicExportSymbols.insert(GUID);
 
-    GUIDPrevailingResolutions[GUID] =
-        Res.second.Prevailing ? PrevailingType::Yes : PrevailingType::No;
-  }
+      GUIDPrevailingResolutions[GUID] =
+          Res.second.Prevailing ? PrevailingType::Yes : PrevailingType::No;
+    }
 
-  auto isPrevailing = [&](GlobalValue::GUID G) {
-    auto It = GUIDPrevailingResolutions.find(G);
-    if (It == GUIDPrevailingResolutions.end())
-      return PrevailingType::Unknown;
-    return It->second;
-  };
-  computeDeadSymbolsWithConstProp(ThinLTO.CombinedIndex, GUIDPreservedSymbols,
-                                  isPrevailing, Conf.OptLevel > 0);
+    auto isPrevailing = [&](GlobalValue::GUID G) {
+      auto It = GUIDPrevailingResolutions.find(G);
+      if (It == GUIDPrevailingResolutions.end())
+        return PrevailingType::Unknown;
+      return It->second;
+    };
+    computeDeadSymbolsWithConstProp(ThinLTO.CombinedIndex, GUIDPreservedSymbols,
+                                    isPrevailing, Conf.OptLevel > 0);
+  }
 
   // Setup output file to emit statistics.
   auto StatsFileOrErr = setupStatsFile(Conf.StatsFile);
@@ -1048,6 +1057,13 @@ Error LTO::runRegularLTO(AddStreamFn AddStream) {
   if (!DiagFileOrErr)
     return DiagFileOrErr.takeError();
 
+  // Function bodies of these modules are parsed lazily, one module after
+  // another, as IRMover needs them. Parsing has to happen on this thread as
+  // all modules share one LLVMContext, but ask the OS to read in all of their
+  // bitcode up front so that parsing doesn't stall on page faults.
+  for (auto &M : RegularLTO.ModsWithSummaries)
+    sys::Memory::adviseWillNeed(M.Buffer.data(), M.Buffer.size());
+
   // Finalize linking of regular LTO modules containing summaries now that
   // we have computed liveness information.
   for (auto &M : RegularLTO.ModsWithSummaries)
@@ -1148,6 +1164,33 @@ ArrayRef<const char*> LTO::getRuntimeLibcallSymbols() {
   return makeArrayRef(libcallRoutineNames);
 }
 
+// Estimate how much work the backend for a module has to do, as the number of
+// instructions in the functions it defines and imports.
+static uint64_t
+estimateBackendCost(const ModuleSummaryIndex &Index,
+                    const GVSummaryMapTy &DefinedGVSummaries,
+                    const FunctionImporter::ImportMapTy &ImportList) {
+  auto getInstCount = [](const GlobalValueSummary *S) -> uint64_t {
+    if (!S)
+      return 0;
+    if (auto *FS = dyn_cast<FunctionSummary>(S->getBaseObject()))
+      return FS->instCount();
+    return 0;
+  };
+
+  uint64_t Cost = 0;
+  for (const auto &Def : DefinedGVSummaries)
+    Cost += getInstCount(Def.second);
+  for (const auto &FromModule : ImportList)
+    for (GlobalValue::GUID GUID : FromModule.second)
+      Cost += getInstCount(Index.findSummaryInModule(GUID, FromModule.first()));
+  return Cost;
+}
+
+// Rough peak memory a backend needs for each instruction it optimizes,
+// covering the IR, its analyses and the code generator's per-function state.
+static const uint64_t BackendBytesPerInstruction = 1024;
+
 /// This class defines the interface to the ThinLTO backend.
 class lto::ThinBackendProc {
 protected:
@@ -1183,6 +1226,39 @@ class InProcessThinBackend : public ThinBackendProc {
   Optional<Error> Err;
   std::mutex ErrMu;
 
+  // Memory accounting for Conf.ThinLTOMemoryBudget. MemoryInUse is the sum
+  // of the estimates of the running backends. MallocBaseline is the heap in
+  // use before any backend started, so that what the backends actually use
+  // can be observed as well.
+  uint64_t MemoryInUse = 0;
+  size_t MallocBaseline = 0;
+  std::mutex MemoryMu;
+  std::condition_variable MemoryCond;
+
+  // Wait until a backend estimated to need \p Estimate bytes fits in the
+  // memory budget, then account for it. When the backends' heap usage
+  // exceeds their estimates, trust the observed usage instead.
+  void acquireMemory(uint64_t Estimate) {
+    std::unique_lock<std::mutex> Lock(MemoryMu);
+    MemoryCond.wait(Lock, [&] {
+      if (MemoryInUse == 0)
+        return true;
+      size_t Malloc = sys::Process::GetMallocUsage();
+      uint64_t Observed = Malloc > MallocBaseline ? Malloc - MallocBaseline : 0;
+      return std::max(MemoryInUse, Observed) + Estimate <=
+             Conf.ThinLTOMemoryBudget;
+    });
+    MemoryInUse += Estimate;
+  }
+
+  void releaseMemory(uint64_t Estimate) {
+    {
+      std::lock_guard<std::mutex> Lock(MemoryMu);
+      MemoryInUse -= Estimate;
+    }
+    MemoryCond.notify_all();
+  }
+
 public:
   InProcessThinBackend(
       const Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1198,6 +1274,8 @@ public:
     for (auto &Name : CombinedIndex.cfiFunctionDecls())
       CfiFunctionDecls.insert(
           GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
+    if (Conf.ThinLTOMemoryBudget)
+      MallocBaseline = sys::Process::GetMallocUsage();
   }
 
   Error runThinLTOBackendThread(
@@ -1248,6 +1326,13 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
+    uint64_t MemoryEstimate = 0;
+    if (Conf.ThinLTOMemoryBudget) {
+      MemoryEstimate =
+          estimateBackendCost(CombinedIndex, DefinedGlobals, ImportList) *
+          BackendBytesPerInstruction;
+      acquireMemory(MemoryEstimate);
+    }
     BackendThreadPool.async(
         [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
             const FunctionImporter::ImportMapTy &ImportList,
@@ -1258,7 +1343,7 @@ public:
             MapVector<StringRef, BitcodeModule> &ModuleMap) {
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerInitialize(Conf.TimeTraceGranularity,
-                                        "thin backend");
+                                        "thin backend", Conf.TimeTraceMemory);
           Error E = runThinLTOBackendThread(
               AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
               ResolvedODR, DefinedGlobals, ModuleMap);
@@ -1269,6 +1354,8 @@ public:
             else
               Err = std::move(E);
           }
+          if (MemoryEstimate)
+            releaseMemory(MemoryEstimate);
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerFinishThread();
         },
@@ -1474,6 +1561,11 @@ Error LTO::runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache,
       ExportedGUIDs.insert(GUID);
   }
 
+  // This was the last use of the symbol resolutions, which hold a copy of the
+  // name of every IR symbol. Free them now rather than keeping them alive while
+  // the backends run, which is when peak memory usage is reached.
+  GlobalResolutions = StringMap<GlobalResolution>();
+
   // Any functions referenced by the jump table in the regular LTO object must
   // be exported.
   for (auto &Def : ThinLTO.CombinedIndex.cfiFunctionDefs())
@@ -1506,6 +1598,12 @@ Error LTO::runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache,
   thinLTOResolvePrevailingInIndex(Conf, ThinLTO.CombinedIndex, isPrevailing,
                                   recordNewLinkage, GUIDPreservedSymbols);
 
+  // The thin-link analyses are done. Release the state that only they needed
+  // before starting the backends.
+  ThinLTO.PrevailingModuleForGUID.shrink_and_clear();
+  ExportedGUIDs.clear();
+  LocalWPDTargetsMap.clear();
+
   generateParamAccessSummary(ThinLTO.CombinedIndex);
 
   std::unique_ptr<ThinBackendProc> BackendProc =
@@ -1534,15 +1632,24 @@ Error LTO::runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache,
       if (Error E = ProcessOneModule(I))
         return E;
   } else {
-    // When executing in parallel, process largest bitsize modules first to
+    // When executing in parallel, process the most expensive modules first to
     // improve parallelism, and avoid starving the thread pool near the end.
-    // This saves about 15 sec on a 36-core machine while link `clang.exe` (out
-    // of 100 sec).
+    // Ordering by bitsize saves about 15 sec on a 36-core machine while link
+    // `clang.exe` (out of 100 sec). Bitsize is a poor proxy for modules that
+    // import a lot, though, so estimate the cost of a backend by the number
+    // of instructions it optimizes: those of the functions it defines and
+    // those of the functions it imports.
     std::vector<BitcodeModule *> ModulesVec;
+    std::vector<uint64_t> Costs;
     ModulesVec.reserve(ModuleMap.size());
-    for (auto &Mod : ModuleMap)
+    Costs.reserve(ModuleMap.size());
+    for (auto &Mod : ModuleMap) {
       ModulesVec.push_back(&Mod.second);
-    for (int I : generateModulesOrdering(ModulesVec))
+      Costs.push_back(estimateBackendCost(ThinLTO.CombinedIndex,
+                                          ModuleToDefinedGVSummaries[Mod.first],
+                                          ImportLists[Mod.first]));
+    }
+    for (int I : generateModulesOrdering(ModulesVec, Costs))
       if (Error E = ProcessOneModule(I))
         return E;
   }
@@ -1593,11 +1700,16 @@ lto::setupStatsFile(StringRef StatsFilename) {
 // Compute the ordering we will process the inputs: the rough heuristic here
 // is to sort them per size so that the largest module get schedule as soon as
 // possible. This is purely a compile-time optimization.
-std::vector<int> lto::generateModulesOrdering(ArrayRef<BitcodeModule *> R) {
+std::vector<int> lto::generateModulesOrdering(ArrayRef<BitcodeModule *> R,
+                                              ArrayRef<uint64_t> Costs) {
+  assert((Costs.empty() || Costs.size() == R.size()) &&
+         "need one cost per module");
   std::vector<int> ModulesOrdering;
   ModulesOrdering.resize(R.size());
   std::iota(ModulesOrdering.begin(), ModulesOrdering.end(), 0);
   llvm::sort(ModulesOrdering, [&](int LeftIndex, int RightIndex) {
+    if (!Costs.empty() && Costs[LeftIndex] != Costs[RightIndex])
+      return Costs[LeftIndex] > Costs[RightIndex];
     auto LSize = R[LeftIndex]->getBuffer().size();
     auto RSize = R[RightIndex]->getBuffer().size();
     return LSize > RSize;
@@ -413,6 +413,25 @@ static void codegen(const Config &Conf, TargetMachine *TM,
     DwoOut->keep();
 }
 
+/// Partitions start out with a declaration of every global value of the
+/// module. Drop the ones a partition doesn't reference, so that neither its
+/// bitcode nor the copy parsed by the codegen thread grows with the size of
+/// the whole module. Declarations referenced from metadata, such as the
+/// "CG Profile" module flag or debug info, are kept.
+static void dropUnusedDeclarations(Module &M) {
+  auto DropIfUnused = [](GlobalValue &GV) {
+    if (!GV.isDeclaration())
+      return;
+    GV.removeDeadConstantUsers();
+    if (GV.use_empty() && !GV.isUsedByMetadata())
+      GV.eraseFromParent();
+  };
+  for (Function &F : make_early_inc_range(M))
+    DropIfUnused(F);
+  for (GlobalVariable &GV : make_early_inc_range(M.globals()))
+    DropIfUnused(GV);
+}
+
 static void splitCodeGen(const Config &C, TargetMachine *TM,
                          AddStreamFn AddStream,
                          unsigned ParallelCodeGenParallelismLevel, Module &Mod,
@@ -431,6 +450,7 @@ static void splitCodeGen(const Config &C, TargetMachine *TM,
         // spinning up new threads which deserialize the partitions into
         // separate contexts.
         // FIXME: Provide a more direct way to do this in LLVM.
+        dropUnusedDeclarations(*MPart);
         SmallString<0> BC;
         raw_svector_ostream BCOS(BC);
         WriteBitcodeToFile(*MPart, BCOS);
@@ -49,6 +49,7 @@
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/SwapByteOrder.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -140,6 +141,21 @@ struct ELFWriter {
   std::vector<const MCSectionELF *> SectionTable;
   unsigned addToSectionTable(const MCSectionELF *Sec);
 
+  // The contents of a debug section to compress, and the result.
+  struct CompressedSection {
+    SmallVector<char, 0> Uncompressed;
+    SmallVector<char, 0> Compressed;
+    bool CompressionFailed = false;
+  };
+  // When debug sections are compressed on several threads, the debug sections
+  // to compress in the order they are written. They are compressed a window at
+  // a time, so that only as many sections as there are threads are held in
+  // memory.
+  std::vector<const MCSectionELF *> SectionsToCompress;
+  size_t NextSectionToCompress = 0;
+  DenseMap<const MCSectionELF *, CompressedSection> CompressedSections;
+  std::unique_ptr<ThreadPool> CompressionPool;
+
   // TargetObjectWriter wrappers.
   bool is64Bit() const;
   bool hasRelocationAddend() const;
@@ -198,6 +214,12 @@ public:
                           const SectionIndexMapTy &SectionIndexMap,
                           const SectionOffsetsTy &SectionOffsets);
 
+  bool shouldCompressSection(const MCAssembler &Asm,
+                             const MCSectionELF &Section) const;
+  void collectSectionsToCompress(const MCAssembler &Asm);
+  CompressedSection &getCompressedSection(const MCAssembler &Asm,
+                                          const MCSectionELF &Section,
+                                          const MCAsmLayout &Layout);
   void writeSectionData(const MCAssembler &Asm, MCSection &Sec,
                         const MCAsmLayout &Layout);
 
@@ -840,6 +862,83 @@ bool ELFWriter::maybeWriteCompression(
   return true;
 }
 
+bool ELFWriter::shouldCompressSection(const MCAssembler &Asm,
+                                      const MCSectionELF &Section) const {
+  const MCAsmInfo *MAI = Asm.getContext().getAsmInfo();
+  if (MAI->compressDebugSections() == DebugCompressionType::None)
+    return false;
+
+  // Compressing debug_frame requires handling alignment fragments which is
+  // more work (possibly generalizing MCAssembler.cpp:writeFragment to allow
+  // for writing to arbitrary buffers) for little benefit.
+  StringRef SectionName = Section.getName();
+  return SectionName.startswith(".debug_") && SectionName != ".debug_frame";
+}
+
+static void compressSection(ELFWriter::CompressedSection &CS) {
+  if (Error E = zlib::compress(
+          StringRef(CS.Uncompressed.data(), CS.Uncompressed.size()),
+          CS.Compressed)) {
+    consumeError(std::move(E));
+    CS.CompressionFailed = true;
+  }
+}
+
+void ELFWriter::collectSectionsToCompress(const MCAssembler &Asm) {
+  unsigned Threads =
+      Asm.getContext().getAsmInfo()->compressDebugSectionsThreads();
+  if (Threads == 1)
+    return;
+
+  for (const MCSection &Sec : Asm) {
+    const auto &Section = static_cast<const MCSectionELF &>(Sec);
+    if (Mode == NonDwoOnly && isDwoSection(Section))
+      continue;
+    if (Mode == DwoOnly && !isDwoSection(Section))
+      continue;
+    if (shouldCompressSection(Asm, Section))
+      SectionsToCompress.push_back(&Section);
+  }
+  if (SectionsToCompress.size() < 2) {
+    SectionsToCompress.clear();
+    return;
+  }
+  CompressionPool =
+      std::make_unique<ThreadPool>(llvm::hardware_concurrency(Threads));
+}
+
+ELFWriter::CompressedSection &
+ELFWriter::getCompressedSection(const MCAssembler &Asm,
+                                const MCSectionELF &Section,
+                                const MCAsmLayout &Layout) {
+  auto It = CompressedSections.find(&Section);
+  if (It != CompressedSections.end())
+    return It->second;
+
+  // The previous window has been written out, compress the next one. The
+  // sections are compressed independently of each other, and written out in
+  // section order, so the output does not depend on the number of threads.
+  assert(NextSectionToCompress < SectionsToCompress.size() &&
+         SectionsToCompress[NextSectionToCompress] == &Section &&
+         "debug sections written out of order");
+  CompressedSections.clear();
+  size_t End = std::min<size_t>(SectionsToCompress.size(),
+                                NextSectionToCompress +
+                                    CompressionPool->getThreadCount());
+  for (size_t I = NextSectionToCompress; I != End; ++I) {
+    CompressedSection &CS = CompressedSections[SectionsToCompress[I]];
+    raw_svector_ostream VecOS(CS.Uncompressed);
+    Asm.writeSectionData(VecOS, SectionsToCompress[I], Layout);
+  }
+  NextSectionToCompress = End;
+  for (auto &Entry : CompressedSections) {
+    CompressedSection &CS = Entry.second;
+    CompressionPool->async([&CS] { compressSection(CS); });
+  }
+  CompressionPool->wait();
+  return CompressedSections[&Section];
+}
+
 void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
                                  const MCAsmLayout &Layout) {
   MCSectionELF &Section = static_cast<MCSectionELF &>(Sec);
@@ -848,13 +947,7 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
   auto &MC = Asm.getContext();
   const auto &MAI = MC.getAsmInfo();
 
-  // Compressing debug_frame requires handling alignment fragments which is
-  // more work (possibly generalizing MCAssembler.cpp:writeFragment to allow
-  // for writing to arbitrary buffers) for little benefit.
-  bool CompressionEnabled =
-      MAI->compressDebugSections() != DebugCompressionType::None;
-  if (!CompressionEnabled || !SectionName.startswith(".debug_") ||
-      SectionName == ".debug_frame") {
+  if (!shouldCompressSection(Asm, Section)) {
     Asm.writeSectionData(W.OS, &Section, Layout);
     return;
   }
@@ -863,23 +956,24 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
           MAI->compressDebugSections() == DebugCompressionType::GNU) &&
          "expected zlib or zlib-gnu style compression");
 
-  SmallVector<char, 128> UncompressedData;
-  raw_svector_ostream VecOS(UncompressedData);
-  Asm.writeSectionData(VecOS, &Section, Layout);
-
-  SmallVector<char, 128> CompressedContents;
-  if (Error E = zlib::compress(
-          StringRef(UncompressedData.data(), UncompressedData.size()),
-          CompressedContents)) {
-    consumeError(std::move(E));
-    W.OS << UncompressedData;
+  CompressedSection SerialCS;
+  if (!CompressionPool) {
+    raw_svector_ostream VecOS(SerialCS.Uncompressed);
+    Asm.writeSectionData(VecOS, &Section, Layout);
+    compressSection(SerialCS);
+  }
+  CompressedSection &CS = CompressionPool
+                              ? getCompressedSection(Asm, Section, Layout)
+                              : SerialCS;
+  if (CS.CompressionFailed) {
+    W.OS << CS.Uncompressed;
     return;
   }
 
   bool ZlibStyle = MAI->compressDebugSections() == DebugCompressionType::Z;
-  if (!maybeWriteCompression(UncompressedData.size(), CompressedContents,
-                             ZlibStyle, Sec.getAlignment())) {
-    W.OS << UncompressedData;
+  if (!maybeWriteCompression(CS.Uncompressed.size(), CS.Compressed, ZlibStyle,
+                             Sec.getAlignment())) {
+    W.OS << CS.Uncompressed;
     return;
   }
 
@@ -893,7 +987,7 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
     // Add "z" prefix to section name. This is zlib-gnu style.
     MC.renameELFSection(&Section, (".z" + SectionName.drop_front(1)).str());
   }
-  W.OS << CompressedContents;
+  W.OS << CS.Compressed;
 }
 
 void ELFWriter::WriteSecHdrEntry(uint32_t Name, uint32_t Type, uint64_t Flags,
@@ -1081,6 +1175,7 @@ uint64_t ELFWriter::writeObject(MCAssembler &Asm, const MCAsmLayout &Layout) {
   writeHeader(Asm);
 
   // ... then the sections ...
+  collectSectionsToCompress(Asm);
   SectionOffsetsTy SectionOffsets;
   std::vector<MCSectionELF *> Groups;
   std::vector<MCSectionELF *> Relocations;
@@ -69,6 +69,9 @@ STATISTIC(FragmentLayouts, "Number of fragment layouts");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
+STATISTIC(FragmentBytes, "Number of bytes of assembler fragment objects");
+STATISTIC(FragmentHeapBytes, "Number of bytes of assembler fragment contents "
+                             "and fixups allocated out of line");
 
 } // end namespace stats
 } // end anonymous namespace
@@ -942,11 +945,100 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
   }
 }
 
+/// Return the number of bytes allocated for the elements of \p Vec outside of
+/// the object holding it, which happens once it outgrows its \p InlineSize
+/// inline elements.
+template <typename T>
+static uint64_t getHeapBytes(const SmallVectorImpl<T> &Vec,
+                             unsigned InlineSize) {
+  return Vec.capacity() > InlineSize ? Vec.capacity() * sizeof(T) : 0;
+}
+
+template <unsigned ContentsSize, unsigned FixupsSize>
+static uint64_t getHeapBytes(
+    const MCEncodedFragmentWithFixups<ContentsSize, FixupsSize> &F) {
+  return getHeapBytes(F.getContents(), ContentsSize) +
+         getHeapBytes(F.getFixups(), FixupsSize);
+}
+
+/// Add the memory used by the fragments of \p Sec to the statistics.
+static void recordFragmentMemory(const MCSection &Sec) {
+  for (const MCFragment &F : Sec) {
+    switch (F.getKind()) {
+    case MCFragment::FT_Align:
+      stats::FragmentBytes += sizeof(MCAlignFragment);
+      break;
+    case MCFragment::FT_Data:
+      stats::FragmentBytes += sizeof(MCDataFragment);
+      stats::FragmentHeapBytes += getHeapBytes(cast<MCDataFragment>(F));
+      break;
+    case MCFragment::FT_CompactEncodedInst:
+      stats::FragmentBytes += sizeof(MCCompactEncodedInstFragment);
+      stats::FragmentHeapBytes +=
+          getHeapBytes(cast<MCCompactEncodedInstFragment>(F).getContents(), 4);
+      break;
+    case MCFragment::FT_Fill:
+      stats::FragmentBytes += sizeof(MCFillFragment);
+      break;
+    case MCFragment::FT_Nops:
+      stats::FragmentBytes += sizeof(MCNopsFragment);
+      break;
+    case MCFragment::FT_Relaxable:
+      stats::FragmentBytes += sizeof(MCRelaxableFragment);
+      stats::FragmentHeapBytes += getHeapBytes(cast<MCRelaxableFragment>(F));
+      break;
+    case MCFragment::FT_Org:
+      stats::FragmentBytes += sizeof(MCOrgFragment);
+      break;
+    case MCFragment::FT_Dwarf:
+      stats::FragmentBytes += sizeof(MCDwarfLineAddrFragment);
+      stats::FragmentHeapBytes +=
+          getHeapBytes(cast<MCDwarfLineAddrFragment>(F));
+      break;
+    case MCFragment::FT_DwarfFrame:
+      stats::FragmentBytes += sizeof(MCDwarfCallFrameFragment);
+      stats::FragmentHeapBytes +=
+          getHeapBytes(cast<MCDwarfCallFrameFragment>(F));
+      break;
+    case MCFragment::FT_LEB:
+      stats::FragmentBytes += sizeof(MCLEBFragment);
+      stats::FragmentHeapBytes +=
+          getHeapBytes(cast<MCLEBFragment>(F).getContents(), 8);
+      break;
+    case MCFragment::FT_BoundaryAlign:
+      stats::FragmentBytes += sizeof(MCBoundaryAlignFragment);
+      break;
+    case MCFragment::FT_SymbolId:
+      stats::FragmentBytes += sizeof(MCSymbolIdFragment);
+      break;
+    case MCFragment::FT_CVInlineLines:
+      stats::FragmentBytes += sizeof(MCCVInlineLineTableFragment);
+      break;
+    case MCFragment::FT_CVDefRange:
+      stats::FragmentBytes += sizeof(MCCVDefRangeFragment);
+      stats::FragmentHeapBytes += getHeapBytes(cast<MCCVDefRangeFragment>(F));
+      break;
+    case MCFragment::FT_PseudoProbe:
+      stats::FragmentBytes += sizeof(MCPseudoProbeAddrFragment);
+      stats::FragmentHeapBytes +=
+          getHeapBytes(cast<MCPseudoProbeAddrFragment>(F));
+      break;
+    case MCFragment::FT_Dummy:
+      stats::FragmentBytes += sizeof(MCDummyFragment);
+      break;
+    }
+  }
+}
+
 void MCAssembler::Finish() {
   // Create the layout object.
   MCAsmLayout Layout(*this);
   layout(Layout);
 
+  if (AreStatisticsEnabled())
+    for (const MCSection &Sec : *this)
+      recordFragmentMemory(Sec);
+
   // Write the object file.
   stats::ObjectBytes += getWriter().writeObject(*this, Layout);
 }
@@ -12,6 +12,8 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
@@ -25,6 +27,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -242,6 +245,13 @@ struct MemberData {
   StringRef Data;
   StringRef Padding;
 };
+
+struct MemberSymbols {
+  /// Offsets of the member's archive symbols into Names.
+  Optional<Expected<std::vector<unsigned>>> Offsets;
+  SmallString<0> Names;
+  bool HasObject = false;
+};
 } // namespace
 
 static MemberData computeStringTable(StringRef Names) {
@@ -470,7 +480,28 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
-  for (const NewArchiveMember &M : NewMembers) {
+  // Reading the symbol tables of the members is the expensive part of writing
+  // an archive, and the members are independent of each other. Collect each
+  // member's names into its own buffer in parallel; they are concatenated in
+  // member order below, so the output is the same as a serial run.
+  std::vector<MemberSymbols> MemberSyms(NeedSymbols ? NewMembers.size() : 0);
+  parallelForEachN(0, MemberSyms.size(), [&](size_t I) {
+    MemberSymbols &MS = MemberSyms[I];
+    raw_svector_ostream Names(MS.Names);
+    MS.Offsets.emplace(
+        getSymbols(NewMembers[I].Buf->getMemBufferRef(), Names, MS.HasObject));
+  });
+  // Report the first failing member, as a serial run would.
+  for (size_t I = 0, E = MemberSyms.size(); I != E; ++I) {
+    if (Error Err = MemberSyms[I].Offsets->takeError()) {
+      for (MemberSymbols &Rest : drop_begin(MemberSyms, I + 1))
+        consumeError(Rest.Offsets->takeError());
+      return std::move(Err);
+    }
+  }
+
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+    const NewArchiveMember &M = NewMembers[I];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -508,11 +539,14 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(Buf, SymNames, HasObject);
-      if (auto E = SymbolsOrErr.takeError())
-        return std::move(E);
-      Symbols = std::move(*SymbolsOrErr);
+      MemberSymbols &MS = MemberSyms[I];
+      // Rebase the member's name offsets onto the combined name table.
+      uint64_t Base = SymNames.tell();
+      Symbols = std::move(**MS.Offsets);
+      for (unsigned &Offset : Symbols)
+        Offset += Base;
+      SymNames << MS.Names;
+      HasObject |= MS.HasObject;
     }
 
     Pos += Header.size() + Data.size() + Padding.size();
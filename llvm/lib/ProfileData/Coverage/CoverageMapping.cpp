@@ -27,6 +27,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -281,18 +282,96 @@ Error CoverageMapping::loadFunctionRecord(
   return Error::success();
 }
 
+namespace {
+
+/// A CoverageMappingRecord that owns the arrays a reader reuses between
+/// records.
+struct DecodedMappingRecord {
+  StringRef FunctionName;
+  uint64_t FunctionHash;
+  std::vector<StringRef> Filenames;
+  std::vector<CounterExpression> Expressions;
+  std::vector<CounterMappingRegion> MappingRegions;
+
+  explicit DecodedMappingRecord(const CoverageMappingRecord &Record)
+      : FunctionName(Record.FunctionName), FunctionHash(Record.FunctionHash),
+        Filenames(Record.Filenames.begin(), Record.Filenames.end()),
+        Expressions(Record.Expressions.begin(), Record.Expressions.end()),
+        MappingRegions(Record.MappingRegions.begin(),
+                       Record.MappingRegions.end()) {}
+
+  CoverageMappingRecord getRecord() const {
+    return {FunctionName, FunctionHash, Filenames, Expressions,
+            MappingRegions};
+  }
+};
+
+} // end anonymous namespace
+
+/// Decode all of the records of \p CoverageReader.
+static Expected<std::vector<DecodedMappingRecord>>
+decodeMappingRecords(CoverageMappingReader &CoverageReader) {
+  std::vector<DecodedMappingRecord> Records;
+  for (auto RecordOrErr : CoverageReader) {
+    if (Error E = RecordOrErr.takeError())
+      return std::move(E);
+    Records.emplace_back(*RecordOrErr);
+  }
+  return std::move(Records);
+}
+
 Expected<std::unique_ptr<CoverageMapping>> CoverageMapping::load(
     ArrayRef<std::unique_ptr<CoverageMappingReader>> CoverageReaders,
     IndexedInstrProfReader &ProfileReader) {
   auto Coverage = std::unique_ptr<CoverageMapping>(new CoverageMapping());
 
-  for (const auto &CoverageReader : CoverageReaders) {
-    for (auto RecordOrErr : *CoverageReader) {
-      if (Error E = RecordOrErr.takeError())
-        return std::move(E);
-      const auto &Record = *RecordOrErr;
-      if (Error E = Coverage->loadFunctionRecord(Record, ProfileReader))
-        return std::move(E);
+  // Decoding the mapping regions is independent for each reader, so do that in
+  // parallel. The profile lookups and the function records have to be done
+  // serially, in reader order, to keep the result deterministic. Readers are
+  // decoded in batches of one reader per thread, so that only the decoded
+  // records of one batch are alive at a time.
+  const size_t BatchSize =
+      std::max(1u, parallel::strategy.compute_thread_count());
+  for (size_t Begin = 0, End = CoverageReaders.size(); Begin < End;
+       Begin += BatchSize) {
+    ArrayRef<std::unique_ptr<CoverageMappingReader>> Batch =
+        CoverageReaders.slice(Begin, std::min(BatchSize, End - Begin));
+
+    // A batch of one reader gains nothing from decoding ahead, so load its
+    // records as they are read, without copying them.
+    if (Batch.size() == 1) {
+      for (auto RecordOrErr : *Batch.front()) {
+        if (Error E = RecordOrErr.takeError())
+          return std::move(E);
+        if (Error E = Coverage->loadFunctionRecord(*RecordOrErr, ProfileReader))
+          return std::move(E);
+      }
+      continue;
+    }
+
+    std::vector<Optional<Expected<std::vector<DecodedMappingRecord>>>> Decoded(
+        Batch.size());
+    parallelForEachN(0, Batch.size(), [&](size_t I) {
+      Decoded[I].emplace(decodeMappingRecords(*Batch[I]));
+    });
+
+    for (size_t I = 0, E = Decoded.size(); I != E; ++I) {
+      Expected<std::vector<DecodedMappingRecord>> &RecordsOrErr = *Decoded[I];
+      Error Err = RecordsOrErr.takeError();
+      if (!Err) {
+        for (const DecodedMappingRecord &Record : *RecordsOrErr)
+          if ((Err = Coverage->loadFunctionRecord(Record.getRecord(),
+                                                  ProfileReader)))
+            break;
+        // Drop the decoded records as soon as they have been loaded.
+        RecordsOrErr->clear();
+        RecordsOrErr->shrink_to_fit();
+      }
+      if (Err) {
+        for (auto &Rest : drop_begin(Decoded, I + 1))
+          consumeError(Rest->takeError());
+        return std::move(Err);
+      }
     }
   }
 
@@ -317,27 +396,47 @@ CoverageMapping::load(ArrayRef<StringRef> ObjectFilenames,
     return std::move(E);
   auto ProfileReader = std::move(ProfileReaderOrErr.get());
 
+  // Reading the objects and indexing their coverage sections is independent
+  // for each object, so do it in parallel and collect the readers in order.
+  struct ObjectReaders {
+    std::unique_ptr<MemoryBuffer> CovMappingBuf;
+    SmallVector<std::unique_ptr<MemoryBuffer>, 1> Buffers;
+    Optional<Expected<std::vector<std::unique_ptr<BinaryCoverageReader>>>>
+        ReadersOrErr;
+  };
+  std::vector<ObjectReaders> Objects(ObjectFilenames.size());
+  parallelForEachN(0, ObjectFilenames.size(), [&](size_t I) {
+    ObjectReaders &Object = Objects[I];
+    auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(ObjectFilenames[I]);
+    if (std::error_code EC = CovMappingBufOrErr.getError()) {
+      Object.ReadersOrErr.emplace(errorCodeToError(EC));
+      return;
+    }
+    Object.CovMappingBuf = std::move(CovMappingBufOrErr.get());
+    StringRef Arch = Arches.empty() ? StringRef() : Arches[I];
+    Object.ReadersOrErr.emplace(BinaryCoverageReader::create(
+        Object.CovMappingBuf->getMemBufferRef(), Arch, Object.Buffers));
+  });
+
   SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
   SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
-  for (const auto &File : llvm::enumerate(ObjectFilenames)) {
-    auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(File.value());
-    if (std::error_code EC = CovMappingBufOrErr.getError())
-      return errorCodeToError(EC);
-    StringRef Arch = Arches.empty() ? StringRef() : Arches[File.index()];
-    MemoryBufferRef CovMappingBufRef =
-        CovMappingBufOrErr.get()->getMemBufferRef();
-    auto CoverageReadersOrErr =
-        BinaryCoverageReader::create(CovMappingBufRef, Arch, Buffers);
-    if (Error E = CoverageReadersOrErr.takeError()) {
-      E = handleMaybeNoDataFoundError(std::move(E));
-      if (E)
-        return std::move(E);
-      // E == success (originally a no_data_found error).
+  for (size_t I = 0, E = Objects.size(); I != E; ++I) {
+    ObjectReaders &Object = Objects[I];
+    if (Error Err = Object.ReadersOrErr->takeError()) {
+      Err = handleMaybeNoDataFoundError(std::move(Err));
+      if (Err) {
+        for (ObjectReaders &Rest : drop_begin(Objects, I + 1))
+          consumeError(Rest.ReadersOrErr->takeError());
+        return std::move(Err);
+      }
+      // Err == success (originally a no_data_found error).
       continue;
     }
-    for (auto &Reader : CoverageReadersOrErr.get())
+    for (auto &Reader : **Object.ReadersOrErr)
       Readers.push_back(std::move(Reader));
-    Buffers.push_back(std::move(CovMappingBufOrErr.get()));
+    for (auto &Buffer : Object.Buffers)
+      Buffers.push_back(std::move(Buffer));
+    Buffers.push_back(std::move(Object.CovMappingBuf));
   }
   // If no readers were created, either no objects were provided or none of them
   // had coverage data. Return an error in the latter case.
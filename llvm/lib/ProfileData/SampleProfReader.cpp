@@ -38,7 +38,6 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
-#include <set>
 #include <system_error>
 #include <vector>
 
@@ -709,44 +708,45 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
           return EC;
       }
     } else if (FunctionSamples::ProfileIsCS) {
-      // Compute the ordered set of names, so we can
-      // get all context profiles under a subtree by
-      // iterating through the ordered names.
-      struct Comparer {
+      // Sort the context names, so that all the context profiles under a
+      // subtree are adjacent and follow the root of the subtree. A sorted
+      // vector is much cheaper to build than a set for the millions of
+      // contexts of a large profile.
+      std::vector<std::pair<StringRef, uint64_t>> OrderedContexts(
+          FuncOffsetTable.begin(), FuncOffsetTable.end());
+      llvm::sort(OrderedContexts, [](const std::pair<StringRef, uint64_t> &L,
+                                     const std::pair<StringRef, uint64_t> &R) {
         // Ignore the closing ']' when ordering context
-        bool operator()(const StringRef &L, const StringRef &R) const {
-          return L.substr(0, L.size() - 1) < R.substr(0, R.size() - 1);
-        }
-      };
-      std::set<StringRef, Comparer> OrderedNames;
-      for (auto Name : FuncOffsetTable) {
-        OrderedNames.insert(Name.first);
-      }
+        return L.first.drop_back() < R.first.drop_back();
+      });
 
       // For each function in current module, load all
       // context profiles for the function.
-      for (auto NameOffset : FuncOffsetTable) {
-        StringRef ContextName = NameOffset.first;
+      size_t I = 0;
+      while (I < OrderedContexts.size()) {
+        StringRef ContextName = OrderedContexts[I].first;
         SampleContext FContext(ContextName);
         auto FuncName = FContext.getNameWithoutContext();
         if (!FuncsToUse.count(FuncName) &&
-            (!Remapper || !Remapper->exist(FuncName)))
+            (!Remapper || !Remapper->exist(FuncName))) {
+          ++I;
           continue;
+        }
 
         // For each context profile we need, try to load
         // all context profile in the subtree. This can
-        // help profile guided importing for ThinLTO.
-        auto It = OrderedNames.find(ContextName);
-        while (It != OrderedNames.end() &&
-               It->startswith(ContextName.substr(0, ContextName.size() - 1))) {
-          const uint8_t *FuncProfileAddr = Start + FuncOffsetTable[*It];
+        // help profile guided importing for ThinLTO. The
+        // subtree contains the contexts under it, so skip
+        // past it afterwards to load each profile once.
+        StringRef Prefix = ContextName.drop_back();
+        do {
+          const uint8_t *FuncProfileAddr = Start + OrderedContexts[I].second;
           assert(FuncProfileAddr < End && "out of LBRProfile section");
           if (std::error_code EC = readFuncProfile(FuncProfileAddr))
             return EC;
-          // Remove loaded context profile so we won't
-          // load it repeatedly.
-          It = OrderedNames.erase(It);
-        }
+          ++I;
+        } while (I < OrderedContexts.size() &&
+                 OrderedContexts[I].first.startswith(Prefix));
       }
     } else {
       for (auto NameOffset : FuncOffsetTable) {
@@ -16,6 +16,7 @@
 #include "llvm/Remarks/RemarkParser.h"
 #include "llvm/Remarks/RemarkSerializer.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Parallel.h"
 
 using namespace llvm;
 using namespace llvm::remarks;
@@ -63,7 +64,18 @@ void RemarkLinker::setExternalFilePrependPath(StringRef PrependPathIn) {
 // Discard remarks with no source location.
 static bool shouldKeepRemark(const Remark &R) { return R.Loc.hasValue(); }
 
-Error RemarkLinker::link(StringRef Buffer, Optional<Format> RemarkFormat) {
+namespace {
+/// The remarks parsed from one buffer. The parser is kept alive because the
+/// remarks may reference strings it owns.
+struct ParsedRemarks {
+  std::unique_ptr<RemarkParser> Parser;
+  std::vector<std::unique_ptr<Remark>> Remarks;
+};
+} // namespace
+
+static Expected<ParsedRemarks> parseRemarks(StringRef Buffer,
+                                            Optional<Format> RemarkFormat,
+                                            Optional<StringRef> PrependPath) {
   if (!RemarkFormat) {
     Expected<Format> ParserFormat = magicToFormat(Buffer);
     if (!ParserFormat)
@@ -72,29 +84,66 @@ Error RemarkLinker::link(StringRef Buffer, Optional<Format> RemarkFormat) {
   }
 
   Expected<std::unique_ptr<RemarkParser>> MaybeParser =
-      createRemarkParserFromMeta(
-          *RemarkFormat, Buffer, /*StrTab=*/None,
-          PrependPath ? Optional<StringRef>(StringRef(*PrependPath))
-                      : Optional<StringRef>(None));
+      createRemarkParserFromMeta(*RemarkFormat, Buffer, /*StrTab=*/None,
+                                 PrependPath);
   if (!MaybeParser)
     return MaybeParser.takeError();
 
-  RemarkParser &Parser = **MaybeParser;
+  ParsedRemarks Result;
+  Result.Parser = std::move(*MaybeParser);
 
   while (true) {
-    Expected<std::unique_ptr<Remark>> Next = Parser.next();
+    Expected<std::unique_ptr<Remark>> Next = Result.Parser->next();
     if (Error E = Next.takeError()) {
       if (E.isA<EndOfFileError>()) {
         consumeError(std::move(E));
         break;
       }
-      return E;
+      return std::move(E);
     }
 
     assert(*Next != nullptr);
 
     if (shouldKeepRemark(**Next))
-      keep(std::move(*Next));
+      Result.Remarks.push_back(std::move(*Next));
+  }
+  return std::move(Result);
+}
+
+Error RemarkLinker::link(StringRef Buffer, Optional<Format> RemarkFormat) {
+  Expected<ParsedRemarks> Parsed = parseRemarks(
+      Buffer, RemarkFormat,
+      PrependPath ? Optional<StringRef>(StringRef(*PrependPath))
+                  : Optional<StringRef>(None));
+  if (!Parsed)
+    return Parsed.takeError();
+
+  for (std::unique_ptr<Remark> &R : Parsed->Remarks)
+    keep(std::move(R));
+  return Error::success();
+}
+
+Error RemarkLinker::link(ArrayRef<StringRef> Buffers,
+                         Optional<Format> RemarkFormat) {
+  // Parsing is where the time goes and each buffer has its own parser, so
+  // parse them all in parallel. The results are merged in the order of
+  // Buffers.
+  Optional<StringRef> Prepend =
+      PrependPath ? Optional<StringRef>(StringRef(*PrependPath))
+                  : Optional<StringRef>(None);
+  std::vector<Optional<Expected<ParsedRemarks>>> Parsed(Buffers.size());
+  parallelForEachN(0, Buffers.size(), [&](size_t I) {
+    Parsed[I].emplace(parseRemarks(Buffers[I], RemarkFormat, Prepend));
+  });
+
+  for (size_t I = 0, E = Parsed.size(); I != E; ++I) {
+    if (Error Err = Parsed[I]->takeError()) {
+      for (auto &Rest : drop_begin(Parsed, I + 1))
+        consumeError(Rest->takeError());
+      return Err;
+    }
+    for (std::unique_ptr<Remark> &R : (*Parsed[I])->Remarks)
+      keep(std::move(R));
   }
   return Error::success();
 }
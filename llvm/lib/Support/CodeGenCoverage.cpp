@@ -37,6 +37,19 @@ bool CodeGenCoverage::isCovered(uint64_t RuleID) const {
   return RuleCoverage[RuleID];
 }
 
+void CodeGenCoverage::addExecutedOpcodes(uint64_t RuleID,
+                                         uint64_t NumOpcodes) {
+  if (RuleOpcodes.size() <= RuleID)
+    RuleOpcodes.resize(RuleID + 1, 0);
+  RuleOpcodes[RuleID] += NumOpcodes;
+}
+
+void CodeGenCoverage::printExecutedOpcodes(raw_ostream &OS) const {
+  for (auto I : enumerate(RuleOpcodes))
+    if (I.value())
+      OS << " id" << I.index() << "=" << I.value();
+}
+
 iterator_range<CodeGenCoverage::const_covered_iterator>
 CodeGenCoverage::covered() const {
   return RuleCoverage.set_bits();
@@ -108,4 +121,7 @@ bool CodeGenCoverage::emit(StringRef CoveragePrefix,
   return true;
 }
 
-void CodeGenCoverage::reset() { RuleCoverage.resize(0); }
+void CodeGenCoverage::reset() {
+  RuleCoverage.resize(0);
+  RuleOpcodes.clear();
+}
@@ -43,6 +43,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <cstdlib>
 #include <map>
+#include <mutex>
 #include <string>
 using namespace llvm;
 using namespace cl;
@@ -164,6 +165,17 @@ public:
   // This collects the different subcommands that have been registered.
   SmallPtrSet<SubCommand *, 4> RegisteredSubCommands;
 
+  // Top-level options that have been constructed but not yet added to the
+  // top-level subcommand. A program linking all of LLVM constructs thousands of
+  // options during static initialization, and processes that never parse or
+  // look up any of them, such as programs embedding LLVM as a library, don't
+  // need to build the maps. They are added in construction order when the
+  // parser is first needed, which gives the same result as adding each one
+  // right away. An option that is removed or destroyed while pending is
+  // dropped from the list.
+  std::vector<Option *> PendingOptions;
+  std::mutex PendingOptionsMutex;
+
   CommandLineParser() : ActiveSubCommand(nullptr) {
     registerSubCommand(&*TopLevelSubCommand);
     registerSubCommand(&*AllSubCommands);
@@ -196,6 +208,7 @@ public:
   }
 
   void addLiteralOption(Option &Opt, StringRef Name) {
+    addPendingOptions();
     if (Opt.Subs.empty())
       addLiteralOption(Opt, &*TopLevelSubCommand, Name);
     else {
@@ -251,6 +264,41 @@ public:
     }
   }
 
+  void addOptionLater(Option *O) {
+    // Options of explicit subcommands, such as MLIR's pass options, are
+    // created and destroyed at run time, possibly on several threads, and
+    // their subcommand may be searched directly. Add them right away.
+    if (!O->Subs.empty())
+      return addOption(O);
+    std::lock_guard<std::mutex> Lock(PendingOptionsMutex);
+    PendingOptions.push_back(O);
+  }
+
+  void addPendingOptions() {
+    // Take the options off the list before adding them. addOption reports
+    // duplicate options with report_fatal_error, and the exit it leads to
+    // destroys options, which takes the lock again in dropPendingOption.
+    std::vector<Option *> Options;
+    {
+      std::lock_guard<std::mutex> Lock(PendingOptionsMutex);
+      Options.swap(PendingOptions);
+    }
+    for (Option *O : Options)
+      addOption(O);
+  }
+
+  // Remove \p O from the pending options. Returns false if it isn't pending.
+  bool dropPendingOption(Option *O) {
+    std::lock_guard<std::mutex> Lock(PendingOptionsMutex);
+    // Options are mostly destroyed in the reverse order of their
+    // construction, so search from the back.
+    auto I = std::find(PendingOptions.rbegin(), PendingOptions.rend(), O);
+    if (I == PendingOptions.rend())
+      return false;
+    PendingOptions.erase(std::next(I).base());
+    return true;
+  }
+
   void addOption(Option *O, bool ProcessDefaultOption = false) {
     if (!ProcessDefaultOption && O->isDefaultOption()) {
       DefaultOptions.push_back(O);
@@ -299,6 +347,10 @@ public:
   }
 
   void removeOption(Option *O) {
+    // A pending option isn't in any subcommand yet.
+    if (dropPendingOption(O))
+      return;
+    addPendingOptions();
     if (O->Subs.empty())
       removeOption(O, &*TopLevelSubCommand);
     else {
@@ -338,6 +390,7 @@ public:
   }
 
   void updateArgStr(Option *O, StringRef NewName) {
+    addPendingOptions();
     if (O->Subs.empty())
       updateArgStr(O, NewName, &*TopLevelSubCommand);
     else {
@@ -370,6 +423,7 @@ public:
                              (Sub->getName() == sub->getName());
                     }) == 0 &&
            "Duplicate subcommands");
+    addPendingOptions();
     RegisteredSubCommands.insert(sub);
 
     // For all options that have been registered for all subcommands, add the
@@ -387,11 +441,13 @@ public:
   }
 
   void unregisterSubCommand(SubCommand *sub) {
+    addPendingOptions();
     RegisteredSubCommands.erase(sub);
   }
 
   iterator_range<typename SmallPtrSet<SubCommand *, 4>::iterator>
   getRegisteredSubcommands() {
+    addPendingOptions();
     return make_range(RegisteredSubCommands.begin(),
                       RegisteredSubCommands.end());
   }
@@ -442,12 +498,20 @@ extrahelp::extrahelp(StringRef Help) : morehelp(Help) {
 }
 
 void Option::addArgument() {
-  GlobalParser->addOption(this);
+  GlobalParser->addOptionLater(this);
   FullyInitialized = true;
 }
 
 void Option::removeArgument() { GlobalParser->removeOption(this); }
 
+Option::~Option() {
+  // Options that are never added to the parser, such as those of a plugin
+  // that is unloaded before any option is parsed, must not be left on the
+  // pending list. The parser may already be gone during shutdown.
+  if (GlobalParser.isConstructed())
+    GlobalParser->dropPendingOption(this);
+}
+
 void Option::setArgStr(StringRef S) {
   if (FullyInitialized)
     GlobalParser->updateArgStr(this, S);
@@ -1312,6 +1376,7 @@ bool cl::ParseCommandLineOptions(int argc, const char *const *argv,
 void CommandLineParser::ResetAllOptionOccurrences() {
   // So that we can parse different command lines multiple times in succession
   // we reset all option values to look like they have never been seen before.
+  addPendingOptions();
   for (auto *SC : RegisteredSubCommands) {
     for (auto &O : SC->OptionsMap)
       O.second->reset();
@@ -1323,6 +1388,7 @@ bool CommandLineParser::ParseCommandLineOptions(int argc,
                                                 StringRef Overview,
                                                 raw_ostream *Errs,
                                                 bool LongOptionsUseDoubleDash) {
+  addPendingOptions();
   assert(hasOptions() && "No options specified!");
 
   // Expand response files.
@@ -1434,6 +1500,10 @@ bool CommandLineParser::ParseCommandLineOptions(int argc,
     StringRef ArgName = "";
     bool HaveDoubleDash = false;
 
+    // Options created while parsing, such as those of a plugin loaded by an
+    // earlier argument, must be visible to the following arguments.
+    addPendingOptions();
+
     // Check to see if this is a positional argument.  This argument is
     // considered to be positional if it doesn't start with '-', if it is "-"
     // itself, or if we have seen "--" already.
@@ -2446,6 +2516,7 @@ void cl::PrintOptionValues() { GlobalParser->printOptionValues(); }
 void CommandLineParser::printOptionValues() {
   if (!PrintOptions && !PrintAllOptions)
     return;
+  addPendingOptions();
 
   SmallVector<std::pair<const char *, Option *>, 128> Opts;
   sortOpts(ActiveSubCommand->OptionsMap, Opts, /*ShowHidden*/ true);
@@ -2551,6 +2622,7 @@ static cl::opt<VersionPrinter, true, parser<bool>>
 
 // Utility function for printing the help message.
 void cl::PrintHelpMessage(bool Hidden, bool Categorized) {
+  GlobalParser->addPendingOptions();
   if (!Hidden && !Categorized)
     UncategorizedNormalPrinter.printHelp();
   else if (!Hidden && Categorized)
@@ -2574,6 +2646,7 @@ void cl::AddExtraVersionPrinter(VersionPrinterTy func) {
 }
 
 StringMap<Option *> &cl::getRegisteredOptions(SubCommand &Sub) {
+  GlobalParser->addPendingOptions();
   auto &Subs = GlobalParser->RegisteredSubCommands;
   (void)Subs;
   assert(is_contained(Subs, &Sub));
@@ -2586,6 +2659,7 @@ cl::getRegisteredSubcommands() {
 }
 
 void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
+  GlobalParser->addPendingOptions();
   for (auto &I : Sub.OptionsMap) {
     for (auto &Cat : I.second->Categories) {
       if (Cat != &Category &&
@@ -2597,6 +2671,7 @@ void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
 
 void cl::HideUnrelatedOptions(ArrayRef<const cl::OptionCategory *> Categories,
                               SubCommand &Sub) {
+  GlobalParser->addPendingOptions();
   for (auto &I : Sub.OptionsMap) {
     for (auto &Cat : I.second->Categories) {
       if (!is_contained(Categories, Cat) && Cat != &GenericCategory)
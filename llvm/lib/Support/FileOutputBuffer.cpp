@@ -14,8 +14,10 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Memory.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include <system_error>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
@@ -24,6 +26,10 @@
 #include <io.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 using namespace llvm;
 using namespace llvm::sys;
 
@@ -66,6 +72,22 @@ public:
     consumeError(Temp.discard());
   }
 
+  void releaseRange(size_t Offset, size_t Size) override {
+#if defined(__linux__)
+    // Only whole pages can be released. Pages that are only partially covered
+    // are left alone because their other part may still be being written.
+    // On Linux, MADV_DONTNEED on a shared file mapping only drops the pages
+    // from this process's page tables; dirty data stays in the page cache.
+    // Other systems do not guarantee that, so this is Linux-only.
+    uintptr_t PageSize = sys::Process::getPageSizeEstimate();
+    uintptr_t Start = alignTo((uintptr_t)getBufferStart() + Offset, PageSize);
+    uintptr_t End =
+        alignDown((uintptr_t)getBufferStart() + Offset + Size, PageSize);
+    if (Start < End)
+      ::madvise((void *)Start, End - Start, MADV_DONTNEED);
+#endif
+  }
+
 private:
   std::unique_ptr<fs::mapped_file_region> Buffer;
   fs::TempFile Temp;
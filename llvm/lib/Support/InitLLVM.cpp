@@ -7,11 +7,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/SamplingProfiler.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdlib>
 #include <string>
 
 #ifdef _WIN32
@@ -36,6 +41,18 @@ InitLLVM::InitLLVM(int &Argc, const char **&Argv,
   sys::PrintStackTraceOnErrorSignal(Argv[0]);
   install_out_of_memory_new_handler();
 
+  if (const char *Path = std::getenv("LLVM_SAMPLING_PROFILE")) {
+    StringRef Pattern(Path);
+    std::string Pid = std::to_string(sys::Process::getProcessId());
+    for (size_t Pos; (Pos = Pattern.find("%p")) != StringRef::npos;) {
+      SamplingProfilePath += Pattern.take_front(Pos).str() + Pid;
+      Pattern = Pattern.drop_front(Pos + 2);
+    }
+    SamplingProfilePath += Pattern.str();
+    if (!sys::startSamplingProfiler())
+      SamplingProfilePath.clear();
+  }
+
 #ifdef _WIN32
   // We use UTF-8 as the internal character encoding. On Windows,
   // arguments passed to main() may not be encoded in UTF-8. In order
@@ -60,4 +77,15 @@ InitLLVM::InitLLVM(int &Argc, const char **&Argv,
 #endif
 }
 
-InitLLVM::~InitLLVM() { llvm_shutdown(); }
+InitLLVM::~InitLLVM() {
+  if (!SamplingProfilePath.empty()) {
+    std::error_code EC;
+    raw_fd_ostream OS(SamplingProfilePath, EC, sys::fs::OF_Text);
+    if (EC)
+      errs() << "error: could not open " << SamplingProfilePath << ": "
+             << EC.message() << '\n';
+    else
+      sys::stopSamplingProfiler(OS);
+  }
+  llvm_shutdown();
+}
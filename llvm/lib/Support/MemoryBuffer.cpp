@@ -17,6 +17,7 @@
 #include "llvm/Support/Errno.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Memory.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
@@ -218,6 +219,27 @@ public:
   MemoryBuffer::BufferKind getBufferKind() const override {
     return MemoryBuffer::MemoryBuffer_MMap;
   }
+
+  void adviseIfMmap(MemoryBuffer::AccessHint Hint) override {
+    switch (Hint) {
+    case MemoryBuffer::AccessNormal:
+      MFR.advise(sys::fs::mapped_file_region::normal);
+      break;
+    case MemoryBuffer::AccessSequential:
+      MFR.advise(sys::fs::mapped_file_region::sequential);
+      break;
+    case MemoryBuffer::AccessRandom:
+      MFR.advise(sys::fs::mapped_file_region::random);
+      break;
+    default:
+      llvm_unreachable("unknown MemoryBuffer::AccessHint");
+    }
+  }
+
+  void willNeedIfMmap(size_t Offset, size_t Length) override {
+    assert(Offset + Length <= this->getBufferSize() && "Invalid range!");
+    sys::Memory::adviseWillNeed(this->getBufferStart() + Offset, Length);
+  }
 };
 } // namespace
 
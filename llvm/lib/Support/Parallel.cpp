@@ -12,8 +12,8 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <future>
-#include <stack>
 #include <thread>
 #include <vector>
 
@@ -36,12 +36,24 @@ public:
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Each worker thread owns a queue of tasks. Tasks added by a worker go to the
+/// back of its own queue and are run from there in filo order, which keeps
+/// recursively spawned work (e.g. parallel_quick_sort) close to the data it
+/// touches. Tasks added from other threads are distributed round-robin across
+/// the queues. A worker whose queue is empty steals from the front of the
+/// other queues, so one thread that got a few long-running tasks doesn't leave
+/// the other threads idle while work is still queued behind them.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
     unsigned ThreadCount = S.compute_thread_count();
+    // Create all the queues up front so that tasks can be added before the
+    // threads that own them have started.
+    Queues.reserve(ThreadCount);
+    for (unsigned I = 0; I < ThreadCount; ++I)
+      Queues.push_back(std::make_unique<WorkQueue>());
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -87,36 +99,85 @@ public:
   };
 
   void add(std::function<void()> F) override {
+    unsigned QueueID = CurrentExecutor == this
+                           ? CurrentQueueID
+                           : NextQueueID++ % Queues.size();
+    {
+      WorkQueue &Q = *Queues[QueueID];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.push_back(std::move(F));
+    }
     {
       std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push(F);
+      ++NumQueued;
     }
     Cond.notify_one();
   }
 
 private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
+  // Take a task from the back of our own queue, or failing that, from the
+  // front of somebody else's.
+  bool getTask(unsigned ThreadID, std::function<void()> &Task) {
+    for (unsigned I = 0, E = Queues.size(); I != E; ++I) {
+      WorkQueue &Q = *Queues[(ThreadID + I) % E];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (Q.Tasks.empty())
+        continue;
+      if (I == 0) {
+        Task = std::move(Q.Tasks.back());
+        Q.Tasks.pop_back();
+      } else {
+        Task = std::move(Q.Tasks.front());
+        Q.Tasks.pop_front();
+      }
+      --NumQueued;
+      return true;
+    }
+    return false;
+  }
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     S.apply_thread_strategy(ThreadID);
+    CurrentExecutor = this;
+    CurrentQueueID = ThreadID;
+    std::function<void()> Task;
     while (true) {
+      if (getTask(ThreadID, Task)) {
+        Task();
+        Task = nullptr;
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
+      Cond.wait(Lock, [&] { return Stop || NumQueued != 0; });
       if (Stop)
         break;
-      auto Task = WorkStack.top();
-      WorkStack.pop();
-      Lock.unlock();
-      Task();
     }
   }
 
+  static LLVM_THREAD_LOCAL ThreadPoolExecutor *CurrentExecutor;
+  static LLVM_THREAD_LOCAL unsigned CurrentQueueID;
+
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
+  // The number of tasks in all queues. Only incremented with Mutex held so
+  // that a worker going to sleep can't miss a newly added task.
+  std::atomic<size_t> NumQueued{0};
+  std::atomic<unsigned> NextQueueID{0};
+  std::vector<std::unique_ptr<WorkQueue>> Queues;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
   std::vector<std::thread> Threads;
 };
 
+LLVM_THREAD_LOCAL ThreadPoolExecutor *ThreadPoolExecutor::CurrentExecutor =
+    nullptr;
+LLVM_THREAD_LOCAL unsigned ThreadPoolExecutor::CurrentQueueID = 0;
+
 Executor *Executor::getDefaultExecutor() {
   // The ManagedStatic enables the ThreadPoolExecutor to be stopped via
   // llvm_shutdown() which allows a "clean" fast exit, e.g. via _exit(). This
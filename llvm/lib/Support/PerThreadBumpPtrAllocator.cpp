@@ -0,0 +1,71 @@
+//===- PerThreadBumpPtrAllocator.cpp - Thread-safe bump allocator ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/ADT/STLExtras.h"
+#include <atomic>
+
+using namespace llvm;
+
+namespace {
+// The arena of the allocator that the current thread used last.
+struct CachedArena {
+  uint64_t AllocatorID;
+  BumpPtrAllocator *Arena;
+};
+} // namespace
+
+static LLVM_THREAD_LOCAL CachedArena LastArena;
+
+// 0 is never used, so that the zero-initialized cache never matches.
+static std::atomic<uint64_t> NextAllocatorID(1);
+
+PerThreadBumpPtrAllocator::PerThreadBumpPtrAllocator()
+    : ID(NextAllocatorID++) {}
+
+BumpPtrAllocator &PerThreadBumpPtrAllocator::getThreadArena() {
+  if (LLVM_LIKELY(LastArena.AllocatorID == ID))
+    return *LastArena.Arena;
+
+  std::lock_guard<std::mutex> Lock(Mu);
+  std::thread::id Self = std::this_thread::get_id();
+  auto It = llvm::find_if(Arenas, [&](const std::unique_ptr<Arena> &A) {
+    return A->Owner == Self;
+  });
+  if (It == Arenas.end()) {
+    Arenas.push_back(std::make_unique<Arena>());
+    Arenas.back()->Owner = Self;
+    It = std::prev(Arenas.end());
+  }
+  LastArena.AllocatorID = ID;
+  LastArena.Arena = &(*It)->Alloc;
+  return (*It)->Alloc;
+}
+
+void PerThreadBumpPtrAllocator::Reset() {
+  std::lock_guard<std::mutex> Lock(Mu);
+  // Keep the arenas, the threads may have cached them.
+  for (const std::unique_ptr<Arena> &A : Arenas)
+    A->Alloc.Reset();
+}
+
+size_t PerThreadBumpPtrAllocator::getBytesAllocated() const {
+  std::lock_guard<std::mutex> Lock(Mu);
+  size_t Total = 0;
+  for (const std::unique_ptr<Arena> &A : Arenas)
+    Total += A->Alloc.getBytesAllocated();
+  return Total;
+}
+
+size_t PerThreadBumpPtrAllocator::getTotalMemory() const {
+  std::lock_guard<std::mutex> Lock(Mu);
+  size_t Total = 0;
+  for (const std::unique_ptr<Arena> &A : Arenas)
+    Total += A->Alloc.getTotalMemory();
+  return Total;
+}
@@ -16,11 +16,17 @@
 
 #include "llvm/Support/SHA1.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/Host.h"
 #include <string.h>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA1_HAS_SHA_NI
+#include <immintrin.h>
+#endif
+
 using namespace llvm;
 
 #if defined(BYTE_ORDER) && defined(BIG_ENDIAN) && BYTE_ORDER == BIG_ENDIAN
@@ -92,7 +98,91 @@ void SHA1::init() {
   InternalState.BufferOffset = 0;
 }
 
+#ifdef SHA1_HAS_SHA_NI
+// Four rounds of SHA-1 with the SHA extensions. Rounds are grouped the way
+// the sha1rnds4 instruction executes them, and the message schedule for the
+// next groups is computed with sha1msg1/sha1msg2 along the way. The template
+// parameter keeps the round function selector a compile time constant.
+template <int Group>
+__attribute__((target("sha"), always_inline)) static inline void
+shaNiRounds(__m128i &ABCD, __m128i (&E)[2], __m128i (&Msg)[4]) {
+  __m128i &ECur = E[Group % 2];
+  __m128i &MCur = Msg[Group % 4];
+  if (Group == 0)
+    ECur = _mm_add_epi32(ECur, MCur);
+  else
+    ECur = _mm_sha1nexte_epu32(ECur, MCur);
+  E[(Group + 1) % 2] = ABCD;
+  if (Group >= 3 && Group <= 18)
+    Msg[(Group + 1) % 4] = _mm_sha1msg2_epu32(Msg[(Group + 1) % 4], MCur);
+  ABCD = _mm_sha1rnds4_epu32(ABCD, ECur, Group / 5);
+  if (Group >= 1 && Group <= 16)
+    Msg[(Group + 3) % 4] = _mm_sha1msg1_epu32(Msg[(Group + 3) % 4], MCur);
+  if (Group >= 2 && Group <= 17)
+    Msg[(Group + 2) % 4] = _mm_xor_si128(Msg[(Group + 2) % 4], MCur);
+}
+
+// The buffer already holds the message words in host byte order, and the
+// instructions want the first word of each group (and A, E) in the highest
+// lane, hence the word reversal on load and store.
+__attribute__((target("sha"))) static void
+shaNiHashBlock(uint32_t *State, const uint32_t *Block) {
+  __m128i ABCD = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(State)), 0x1B);
+  __m128i E[2] = {_mm_set_epi32(State[4], 0, 0, 0), _mm_setzero_si128()};
+  __m128i Msg[4];
+  for (int I = 0; I < 4; ++I)
+    Msg[I] = _mm_shuffle_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(Block + 4 * I)),
+        0x1B);
+  const __m128i SavedABCD = ABCD;
+  const __m128i SavedE = E[0];
+
+  shaNiRounds<0>(ABCD, E, Msg);
+  shaNiRounds<1>(ABCD, E, Msg);
+  shaNiRounds<2>(ABCD, E, Msg);
+  shaNiRounds<3>(ABCD, E, Msg);
+  shaNiRounds<4>(ABCD, E, Msg);
+  shaNiRounds<5>(ABCD, E, Msg);
+  shaNiRounds<6>(ABCD, E, Msg);
+  shaNiRounds<7>(ABCD, E, Msg);
+  shaNiRounds<8>(ABCD, E, Msg);
+  shaNiRounds<9>(ABCD, E, Msg);
+  shaNiRounds<10>(ABCD, E, Msg);
+  shaNiRounds<11>(ABCD, E, Msg);
+  shaNiRounds<12>(ABCD, E, Msg);
+  shaNiRounds<13>(ABCD, E, Msg);
+  shaNiRounds<14>(ABCD, E, Msg);
+  shaNiRounds<15>(ABCD, E, Msg);
+  shaNiRounds<16>(ABCD, E, Msg);
+  shaNiRounds<17>(ABCD, E, Msg);
+  shaNiRounds<18>(ABCD, E, Msg);
+  shaNiRounds<19>(ABCD, E, Msg);
+
+  E[0] = _mm_sha1nexte_epu32(E[0], SavedE);
+  ABCD = _mm_add_epi32(ABCD, SavedABCD);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(State),
+                   _mm_shuffle_epi32(ABCD, 0x1B));
+  State[4] = _mm_cvtsi128_si32(_mm_shuffle_epi32(E[0], 0xFF));
+}
+
+static bool hostHasShaNi() {
+  static const bool HasShaNi = [] {
+    StringMap<bool> Features;
+    return sys::getHostCPUFeatures(Features) && Features.lookup("sha");
+  }();
+  return HasShaNi;
+}
+#endif
+
 void SHA1::hashBlock() {
+#ifdef SHA1_HAS_SHA_NI
+  if (hostHasShaNi()) {
+    shaNiHashBlock(InternalState.State, InternalState.Buffer.L);
+    return;
+  }
+#endif
+
   uint32_t A = InternalState.State[0];
   uint32_t B = InternalState.State[1];
   uint32_t C = InternalState.State[2];
@@ -0,0 +1,215 @@
+//===- SamplingProfiler.cpp - In-process sampling profiler ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a SIGPROF based sampling profiler.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/SamplingProfiler.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/raw_ostream.h"
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__)) &&    \
+    HAVE_DLFCN_H && HAVE_DLADDR
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Demangle/Demangle.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Memory.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <dlfcn.h>
+#include <map>
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+// Deeper frames are dropped. Compiler stacks are rarely deeper than this in
+// the parts worth looking at, and it bounds the memory needed per sample.
+constexpr int MaxDepth = 64;
+// Number of samples kept; at the default frequency this covers about 10
+// minutes of CPU time. Samples past this are dropped.
+constexpr size_t MaxSamples = 1 << 16;
+// Frame records further apart than this are assumed not to be frame records.
+constexpr uintptr_t MaxFrameSize = 100000;
+
+struct Sample {
+  // Set last, once Frames is filled in, so that a sample still being written
+  // by another thread when the profiler stops is skipped.
+  std::atomic<int> Depth;
+  void *Frames[MaxDepth];
+};
+} // namespace
+
+// The samples live in memory mapped pages, which are zero-filled and only
+// take up memory once a sample is written to them.
+static sys::MemoryBlock SampleMemory;
+static Sample *Samples;
+static std::atomic<size_t> NumSamples;
+static std::atomic<bool> Running;
+static struct sigaction OldAction;
+
+/// Get the program counter, stack pointer, and frame pointer of the
+/// interrupted code out of the signal context.
+static void getRegisters(const void *Context, uintptr_t &PC, uintptr_t &SP,
+                         uintptr_t &FP) {
+  const mcontext_t &MC = static_cast<const ucontext_t *>(Context)->uc_mcontext;
+#if defined(__x86_64__)
+  PC = MC.gregs[REG_RIP];
+  SP = MC.gregs[REG_RSP];
+  FP = MC.gregs[REG_RBP];
+#else
+  PC = MC.pc;
+  SP = MC.sp;
+  FP = MC.regs[29];
+#endif
+}
+
+// backtrace() is not async-signal-safe: it may allocate, and it takes the
+// dynamic loader's lock, which the interrupted thread may hold. Instead, follow
+// the frame records, each of which holds the caller's frame pointer followed by
+// the return address into the caller. Only plain loads are needed.
+static void sampleHandler(int, siginfo_t *, void *Context) {
+  if (!Running.load(std::memory_order_relaxed))
+    return;
+  size_t I = NumSamples.fetch_add(1, std::memory_order_relaxed);
+  if (I >= MaxSamples)
+    return;
+
+  uintptr_t PC, SP, FP;
+  getRegisters(Context, PC, SP, FP);
+  Sample &S = Samples[I];
+  int Depth = 0;
+  S.Frames[Depth++] = reinterpret_cast<void *>(PC);
+  // Code built without frame pointers uses the register for other values, so
+  // only follow records that are aligned, and above and close to the previous
+  // one on the stack.
+  for (uintptr_t Low = SP; Depth != MaxDepth && FP >= Low &&
+                           FP - Low <= MaxFrameSize &&
+                           FP % alignof(uintptr_t) == 0;) {
+    const uintptr_t *Record = reinterpret_cast<const uintptr_t *>(FP);
+    if (!Record[1])
+      break;
+    S.Frames[Depth++] = reinterpret_cast<void *>(Record[1]);
+    Low = FP + 2 * sizeof(uintptr_t);
+    FP = Record[0];
+  }
+  S.Depth.store(Depth, std::memory_order_release);
+}
+
+static void setTimer(unsigned Frequency) {
+  struct itimerval Timer = {};
+  if (Frequency) {
+    unsigned PeriodUs = 1000000 / Frequency;
+    Timer.it_interval.tv_sec = PeriodUs / 1000000;
+    Timer.it_interval.tv_usec = PeriodUs % 1000000;
+    Timer.it_value = Timer.it_interval;
+  }
+  setitimer(ITIMER_PROF, &Timer, nullptr);
+}
+
+bool llvm::sys::startSamplingProfiler(unsigned Frequency) {
+  if (Running || Frequency == 0 || Frequency > 1000000)
+    return false;
+
+  // The handler of the previous run is no longer installed, so its samples
+  // can be unmapped.
+  if (Samples)
+    sys::Memory::releaseMappedMemory(SampleMemory);
+  std::error_code EC;
+  SampleMemory = sys::Memory::allocateMappedMemory(
+      MaxSamples * sizeof(Sample), nullptr,
+      sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  if (EC)
+    return false;
+  Samples = static_cast<Sample *>(SampleMemory.base());
+  NumSamples = 0;
+
+  struct sigaction Action = {};
+  Action.sa_sigaction = sampleHandler;
+  Action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&Action.sa_mask);
+  if (sigaction(SIGPROF, &Action, &OldAction) != 0)
+    return false;
+
+  Running = true;
+  setTimer(Frequency);
+  return true;
+}
+
+/// Name \p Addr after its symbol if it has one, or else after its module.
+static std::string getFrameName(void *Addr) {
+  Dl_info Info;
+  if (!dladdr(Addr, &Info) || !Info.dli_fname)
+    return "[unknown]";
+  if (Info.dli_sname)
+    return demangle(Info.dli_sname);
+  std::string Name;
+  raw_string_ostream OS(Name);
+  OS << Info.dli_fname << '+'
+     << format_hex(uintptr_t(Addr) - uintptr_t(Info.dli_fbase), 0);
+  return OS.str();
+}
+
+void llvm::sys::stopSamplingProfiler(raw_ostream &OS) {
+  if (!Running)
+    return;
+  setTimer(0);
+  Running = false;
+  // A tick may still be pending. Ignoring the signal discards it, whereas
+  // restoring the default action first would let it terminate the process.
+  struct sigaction Ignore = {};
+  Ignore.sa_handler = SIG_IGN;
+  sigemptyset(&Ignore.sa_mask);
+  sigaction(SIGPROF, &Ignore, nullptr);
+  sigaction(SIGPROF, &OldAction, nullptr);
+
+  std::map<std::vector<void *>, unsigned> Counts;
+  size_t N = std::min<size_t>(NumSamples, MaxSamples);
+  for (size_t I = 0; I != N; ++I) {
+    const Sample &S = Samples[I];
+    int Depth = S.Depth.load(std::memory_order_acquire);
+    if (Depth == 0)
+      continue;
+    ++Counts[std::vector<void *>(S.Frames, S.Frames + Depth)];
+  }
+
+  // The innermost frame is the exact address that was interrupted, so stacks
+  // that only differ in addresses within the same functions are merged by
+  // name.
+  DenseMap<void *, std::string> Names;
+  std::map<std::string, unsigned> FoldedCounts;
+  for (const auto &StackAndCount : Counts) {
+    const std::vector<void *> &Stack = StackAndCount.first;
+    std::string Folded;
+    for (auto It = Stack.rbegin(), E = Stack.rend(); It != E; ++It) {
+      std::string &Name = Names[*It];
+      if (Name.empty())
+        Name = getFrameName(*It);
+      if (It != Stack.rbegin())
+        Folded += ';';
+      Folded += Name;
+    }
+    FoldedCounts[Folded] += StackAndCount.second;
+  }
+  for (const auto &StackAndCount : FoldedCounts)
+    OS << StackAndCount.first << ' ' << StackAndCount.second << '\n';
+}
+
+#else
+
+bool llvm::sys::startSamplingProfiler(unsigned Frequency) { return false; }
+
+void llvm::sys::stopSamplingProfiler(raw_ostream &OS) {}
+
+#endif
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/MathExtras.h"
 
 using namespace llvm;
 
@@ -24,3 +25,28 @@ StringRef UniqueStringSaver::save(StringRef S) {
     *R.first = Strings.save(S); // safe replacement with equal value
   return *R.first;
 }
+
+ConcurrentUniqueStringSaver::ConcurrentUniqueStringSaver(unsigned NumShards)
+    : NumShards(PowerOf2Ceil(std::max(NumShards, 1u))) {
+  Shards.reset(new Shard[this->NumShards]);
+  ShardShift = 32 - Log2_32(this->NumShards);
+}
+
+StringRef ConcurrentUniqueStringSaver::save(CachedHashStringRef S) {
+  Shard &Sh = getShard(S.hash());
+  std::lock_guard<std::mutex> Lock(Sh.Mu);
+  auto R = Sh.Unique.insert(S);
+  if (R.second) // cache miss, need to actually save the string
+    *R.first = CachedHashStringRef(StringSaver(Sh.Alloc).save(S.val()),
+                                   S.hash());
+  return R.first->val();
+}
+
+size_t ConcurrentUniqueStringSaver::getBytesAllocated() const {
+  size_t Total = 0;
+  for (unsigned I = 0; I != NumShards; ++I) {
+    std::lock_guard<std::mutex> Lock(Shards[I].Mu);
+    Total += Shards[I].Alloc.getBytesAllocated();
+  }
+  return Total;
+}
@@ -13,30 +13,59 @@
 #include "llvm/Support/ThreadPool.h"
 
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace llvm;
 
+ThreadPool::PackagedTaskTy ThreadPool::popTaskUnlocked() {
+  for (unsigned I = NumPriorities; I != 0; --I) {
+    std::queue<PackagedTaskTy> &Q = Tasks[I - 1];
+    if (Q.empty())
+      continue;
+    PackagedTaskTy Task = std::move(Q.front());
+    Q.pop();
+    --NumQueued;
+    return Task;
+  }
+  llvm_unreachable("no task queued");
+}
+
+// Wrap a task so that it does nothing once its token has been cancelled.
+static ThreadPool::TaskTy wrapCancellable(ThreadPool::TaskTy Task,
+                                          CancellationToken Token) {
+  if (!Token)
+    return Task;
+  return [Task = std::move(Task), Token = std::move(Token)] {
+    if (!Token.isCancelled())
+      Task();
+  };
+}
+
 #if LLVM_ENABLE_THREADS
 
-ThreadPool::ThreadPool(ThreadPoolStrategy S)
-    : ThreadCount(S.compute_thread_count()) {
+// The pool whose worker is the current thread, if any.
+static LLVM_THREAD_LOCAL ThreadPool *CurrentPool = nullptr;
+
+ThreadPool::ThreadPool(ThreadPoolStrategy S, unsigned MaxQueuedTasks)
+    : MaxQueuedTasks(MaxQueuedTasks), ThreadCount(S.compute_thread_count()) {
   // Create ThreadCount threads that will loop forever, wait on QueueCondition
   // for tasks to be queued or the Pool to be destroyed.
   Threads.reserve(ThreadCount);
   for (unsigned ThreadID = 0; ThreadID < ThreadCount; ++ThreadID) {
     Threads.emplace_back([S, ThreadID, this] {
       S.apply_thread_strategy(ThreadID);
+      CurrentPool = this;
       while (true) {
         PackagedTaskTy Task;
         {
           std::unique_lock<std::mutex> LockGuard(QueueLock);
           // Wait for tasks to be pushed in the queue
           QueueCondition.wait(LockGuard,
-                              [&] { return !EnableFlag || !Tasks.empty(); });
+                              [&] { return !EnableFlag || NumQueued != 0; });
           // Exit condition
-          if (!EnableFlag && Tasks.empty())
+          if (!EnableFlag && NumQueued == 0)
             return;
           // Yeah, we have a task, grab it and release the lock on the queue
 
@@ -44,9 +73,10 @@ ThreadPool::ThreadPool(ThreadPoolStrategy S)
           // in order for wait() to properly detect that even if the queue is
           // empty, there is still a task in flight.
           ++ActiveThreads;
-          Task = std::move(Tasks.front());
-          Tasks.pop();
+          Task = popTaskUnlocked();
         }
+        if (this->MaxQueuedTasks)
+          SpaceCondition.notify_one();
         // Run the task we just grabbed
         Task();
 
@@ -72,9 +102,11 @@ void ThreadPool::wait() {
   CompletionCondition.wait(LockGuard, [&] { return workCompletedUnlocked(); });
 }
 
-std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
+std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task, Priority P,
+                                               CancellationToken Token) {
   /// Wrap the Task in a packaged_task to return a future object.
-  PackagedTaskTy PackagedTask(std::move(Task));
+  PackagedTaskTy PackagedTask(
+      wrapCancellable(std::move(Task), std::move(Token)));
   auto Future = PackagedTask.get_future();
   {
     // Lock the queue and push the new task
@@ -83,7 +115,14 @@ std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
     // Don't allow enqueueing after disabling the pool
     assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
 
-    Tasks.push(std::move(PackagedTask));
+    // Apply back-pressure if the queues are full, unless we are one of the
+    // workers, which can't wait for themselves to make room.
+    if (MaxQueuedTasks && CurrentPool != this)
+      SpaceCondition.wait(LockGuard,
+                          [&] { return NumQueued < MaxQueuedTasks; });
+
+    Tasks[unsigned(P)].push(std::move(PackagedTask));
+    ++NumQueued;
   }
   QueueCondition.notify_one();
   return Future.share();
@@ -103,8 +142,8 @@ ThreadPool::~ThreadPool() {
 #else // LLVM_ENABLE_THREADS Disabled
 
 // No threads are launched, issue a warning if ThreadCount is not 0
-ThreadPool::ThreadPool(ThreadPoolStrategy S)
-    : ThreadCount(S.compute_thread_count()) {
+ThreadPool::ThreadPool(ThreadPoolStrategy S, unsigned MaxQueuedTasks)
+    : MaxQueuedTasks(MaxQueuedTasks), ThreadCount(S.compute_thread_count()) {
   if (ThreadCount != 1) {
     errs() << "Warning: request a ThreadPool with " << ThreadCount
            << " threads, but LLVM_ENABLE_THREADS has been turned off\n";
@@ -113,20 +152,22 @@ ThreadPool::ThreadPool(ThreadPoolStrategy S)
 
 void ThreadPool::wait() {
   // Sequential implementation running the tasks
-  while (!Tasks.empty()) {
-    auto Task = std::move(Tasks.front());
-    Tasks.pop();
-    Task();
-  }
+  while (NumQueued != 0)
+    popTaskUnlocked()();
 }
 
-std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
+std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task, Priority P,
+                                               CancellationToken Token) {
   // Get a Future with launch::deferred execution using std::async
-  auto Future = std::async(std::launch::deferred, std::move(Task)).share();
+  auto Future = std::async(std::launch::deferred,
+                           wrapCancellable(std::move(Task), std::move(Token)))
+                    .share();
   // Wrap the future so that both ThreadPool::wait() can operate and the
-  // returned future can be sync'ed on.
+  // returned future can be sync'ed on. There is no other thread to wait for,
+  // so MaxQueuedTasks doesn't apply.
   PackagedTaskTy PackagedTask([Future]() { Future.get(); });
-  Tasks.push(std::move(PackagedTask));
+  Tasks[unsigned(P)].push(std::move(PackagedTask));
+  ++NumQueued;
   return Future;
 }
 
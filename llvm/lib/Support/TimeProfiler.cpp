@@ -19,6 +19,7 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <mutex>
@@ -35,6 +36,13 @@ static std::vector<TimeTraceProfiler *>
 // Per Thread instance
 static LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
 
+// Heap usage is a process-wide number, so a section's change in it can only be
+// attributed to that section while no other thread tracks memory. Count the
+// live profilers that do, and bump the epoch whenever one starts or stops so
+// that a section can tell whether another one came and went while it ran.
+static std::atomic<unsigned> NumMemoryProfilers(0);
+static std::atomic<uint64_t> MemoryProfilerEpoch(0);
+
 TimeTraceProfiler *llvm::getTimeTraceProfilerInstance() {
   return TimeTraceProfilerInstance;
 }
@@ -51,6 +59,13 @@ struct Entry {
   TimePointType End;
   const std::string Name;
   const std::string Detail;
+  // Heap usage when the section began and how much it changed by the end,
+  // when the profiler tracks memory. HasMemDelta is false when another thread
+  // tracked memory at some point during the section.
+  size_t StartMem = 0;
+  uint64_t StartEpoch = 0;
+  int64_t MemDelta = 0;
+  bool HasMemDelta = false;
 
   Entry(TimePointType &&S, TimePointType &&E, std::string &&N, std::string &&Dt)
       : Start(std::move(S)), End(std::move(E)), Name(std::move(N)),
@@ -74,22 +89,67 @@ struct Entry {
 } // namespace
 
 struct llvm::TimeTraceProfiler {
-  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
+  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "",
+                    bool TimeTraceMemory = false)
       : BeginningOfTime(system_clock::now()), StartTime(steady_clock::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        TimeTraceMemory(TimeTraceMemory) {
     llvm::get_thread_name(ThreadName);
+    if (TimeTraceMemory) {
+      ++NumMemoryProfilers;
+      ++MemoryProfilerEpoch;
+    }
+  }
+
+  ~TimeTraceProfiler() { stopTrackingMemory(); }
+
+  // Stop counting this profiler as one that tracks memory. Called once the
+  // thread it belongs to is done profiling.
+  void stopTrackingMemory() {
+    if (!TimeTraceMemory || !TrackingMemory)
+      return;
+    TrackingMemory = false;
+    --NumMemoryProfilers;
+    ++MemoryProfilerEpoch;
+  }
+
+  // Returns the current heap usage. GetMallocUsage walks the allocator's
+  // arenas, so a sample is reused until it is older than the granularity:
+  // sections shorter than that are not emitted anyway.
+  size_t getMallocUsage(TimePointType Now, uint64_t Epoch) {
+    if (!HasMemSample || Epoch != MemSampleEpoch ||
+        duration_cast<microseconds>(Now - MemSampleTime).count() >=
+            TimeTraceGranularity) {
+      MemSample = sys::Process::GetMallocUsage();
+      MemSampleTime = Now;
+      MemSampleEpoch = Epoch;
+      HasMemSample = true;
+    }
+    return MemSample;
   }
 
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
     Stack.emplace_back(steady_clock::now(), TimePointType(), std::move(Name),
                        Detail());
+    if (TimeTraceMemory) {
+      Entry &E = Stack.back();
+      E.StartEpoch = MemoryProfilerEpoch;
+      E.StartMem = getMallocUsage(E.Start, E.StartEpoch);
+    }
   }
 
   void end() {
     assert(!Stack.empty() && "Must call begin() first");
     Entry &E = Stack.back();
     E.End = steady_clock::now();
+    if (TimeTraceMemory) {
+      uint64_t Epoch = MemoryProfilerEpoch;
+      E.HasMemDelta = NumMemoryProfilers == 1 && Epoch == E.StartEpoch;
+      if (E.HasMemDelta)
+        E.MemDelta =
+            int64_t(getMallocUsage(E.End, Epoch)) - int64_t(E.StartMem);
+    }
 
     // Check that end times monotonically increase.
     assert((Entries.empty() ||
@@ -116,11 +176,22 @@ struct llvm::TimeTraceProfiler {
       auto &CountAndTotal = CountAndTotalPerName[E.Name];
       CountAndTotal.first++;
       CountAndTotal.second += Duration;
+      if (E.HasMemDelta)
+        MemDeltaPerName[E.Name] += E.MemDelta;
     }
 
     Stack.pop_back();
   }
 
+  void addThreadSection(std::string Name, std::string Detail, uint64_t Tid,
+                        TimePointType Start, TimePointType End) {
+    Entry E(std::move(Start), std::move(End), std::move(Name),
+            std::move(Detail));
+    if (duration_cast<microseconds>(E.End - E.Start).count() >=
+        TimeTraceGranularity)
+      ThreadEntries.emplace_back(Tid, std::move(E));
+  }
+
   // Write events from this TimeTraceProfilerInstance and
   // ThreadTimeTraceProfilerInstances.
   void write(raw_pwrite_stream &OS) {
@@ -149,8 +220,13 @@ struct llvm::TimeTraceProfiler {
         J.attribute("ts", StartUs);
         J.attribute("dur", DurUs);
         J.attribute("name", E.Name);
-        if (!E.Detail.empty()) {
-          J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
+        if (!E.Detail.empty() || E.HasMemDelta) {
+          J.attributeObject("args", [&] {
+            if (!E.Detail.empty())
+              J.attribute("detail", E.Detail);
+            if (E.HasMemDelta)
+              J.attribute("mem delta", E.MemDelta);
+          });
         }
       });
     };
@@ -159,6 +235,8 @@ struct llvm::TimeTraceProfiler {
     for (const TimeTraceProfiler *TTP : ThreadTimeTraceProfilerInstances)
       for (const Entry &E : TTP->Entries)
         writeEvent(E, TTP->Tid);
+    for (const auto &TidAndEntry : ThreadEntries)
+      writeEvent(TidAndEntry.second, TidAndEntry.first);
 
     // Emit totals by section name as additional "thread" events, sorted from
     // longest one.
@@ -166,6 +244,8 @@ struct llvm::TimeTraceProfiler {
     uint64_t MaxTid = this->Tid;
     for (const TimeTraceProfiler *TTP : ThreadTimeTraceProfilerInstances)
       MaxTid = std::max(MaxTid, TTP->Tid);
+    for (const auto &TidAndEntry : ThreadEntries)
+      MaxTid = std::max(MaxTid, TidAndEntry.first);
 
     // Combine all CountAndTotalPerName from threads into one.
     StringMap<CountAndDurationType> AllCountAndTotalPerName;
@@ -182,6 +262,14 @@ struct llvm::TimeTraceProfiler {
       for (const auto &Stat : TTP->CountAndTotalPerName)
         combineStat(Stat);
 
+    // Sum the heap usage changes of the sections that have one.
+    StringMap<int64_t> AllMemDeltaPerName;
+    for (const auto &Stat : MemDeltaPerName)
+      AllMemDeltaPerName[Stat.getKey()] += Stat.getValue();
+    for (const TimeTraceProfiler *TTP : ThreadTimeTraceProfilerInstances)
+      for (const auto &Stat : TTP->MemDeltaPerName)
+        AllMemDeltaPerName[Stat.getKey()] += Stat.getValue();
+
     std::vector<NameAndCountAndDurationType> SortedTotals;
     SortedTotals.reserve(AllCountAndTotalPerName.size());
     for (const auto &Total : AllCountAndTotalPerName)
@@ -208,6 +296,9 @@ struct llvm::TimeTraceProfiler {
         J.attributeObject("args", [&] {
           J.attribute("count", int64_t(Count));
           J.attribute("avg ms", int64_t(DurUs / Count / 1000));
+          auto MemDelta = AllMemDeltaPerName.find(Total.first);
+          if (MemDelta != AllMemDeltaPerName.end())
+            J.attribute("mem delta", MemDelta->getValue());
         });
       });
 
@@ -248,7 +339,10 @@ struct llvm::TimeTraceProfiler {
 
   SmallVector<Entry, 16> Stack;
   SmallVector<Entry, 128> Entries;
+  // Sections added on behalf of other threads, with their thread IDs.
+  SmallVector<std::pair<uint64_t, Entry>, 0> ThreadEntries;
   StringMap<CountAndDurationType> CountAndTotalPerName;
+  StringMap<int64_t> MemDeltaPerName;
   const time_point<system_clock> BeginningOfTime;
   const TimePointType StartTime;
   const std::string ProcName;
@@ -258,14 +352,27 @@ struct llvm::TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  // Whether to record the change in heap usage of each section.
+  const bool TimeTraceMemory;
+  bool TrackingMemory = true;
+
+  // The last heap usage sample, when and in which epoch it was taken.
+  size_t MemSample = 0;
+  TimePointType MemSampleTime;
+  uint64_t MemSampleEpoch = 0;
+  bool HasMemSample = false;
 };
 
 void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                       StringRef ProcName) {
+                                       StringRef ProcName,
+                                       bool TimeTraceMemory) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
-  TimeTraceProfilerInstance = new TimeTraceProfiler(
-      TimeTraceGranularity, llvm::sys::path::filename(ProcName));
+  TimeTraceProfilerInstance =
+      new TimeTraceProfiler(TimeTraceGranularity,
+                            llvm::sys::path::filename(ProcName),
+                            TimeTraceMemory);
 }
 
 // Removes all TimeTraceProfilerInstances.
@@ -283,6 +390,7 @@ void llvm::timeTraceProfilerCleanup() {
 void llvm::timeTraceProfilerFinishThread() {
   std::lock_guard<std::mutex> Lock(Mu);
   ThreadTimeTraceProfilerInstances.push_back(TimeTraceProfilerInstance);
+  TimeTraceProfilerInstance->stopTrackingMemory();
   TimeTraceProfilerInstance = nullptr;
 }
 
@@ -328,3 +436,12 @@ void llvm::timeTraceProfilerEnd() {
   if (TimeTraceProfilerInstance != nullptr)
     TimeTraceProfilerInstance->end();
 }
+
+void llvm::timeTraceProfilerAddThreadSection(StringRef Name, StringRef Detail,
+                                             uint64_t Tid,
+                                             TimePointType Start,
+                                             TimePointType End) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->addThreadSection(
+        std::string(Name), std::string(Detail), Tid, Start, End);
+}
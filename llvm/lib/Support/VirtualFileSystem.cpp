@@ -541,6 +541,227 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+//===-----------------------------------------------------------------------===/
+// CachingFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+namespace {
+
+/// Iterates over a cached directory listing, whose entries only hold names.
+class CachedDirIterImpl : public llvm::vfs::detail::DirIterImpl {
+  std::shared_ptr<const std::vector<directory_entry>> Listing;
+  std::string Dir;
+  size_t Index = 0;
+
+  void setCurrentEntry() {
+    if (Index == Listing->size()) {
+      CurrentEntry = directory_entry();
+      return;
+    }
+    const directory_entry &Entry = (*Listing)[Index];
+    SmallString<256> Path(Dir);
+    llvm::sys::path::append(Path, Entry.path());
+    CurrentEntry = directory_entry(std::string(Path.str()), Entry.type());
+  }
+
+public:
+  CachedDirIterImpl(std::shared_ptr<const std::vector<directory_entry>> Listing,
+                    std::string Dir)
+      : Listing(std::move(Listing)), Dir(std::move(Dir)) {
+    setCurrentEntry();
+  }
+
+  std::error_code increment() override {
+    ++Index;
+    setCurrentEntry();
+    return {};
+  }
+};
+
+/// A file opened by its absolute path, whose status keeps the name it was
+/// asked for.
+class NamedFile : public File {
+  std::unique_ptr<File> InnerFile;
+  std::string Name;
+
+public:
+  NamedFile(std::unique_ptr<File> InnerFile, std::string Name)
+      : InnerFile(std::move(InnerFile)), Name(std::move(Name)) {}
+
+  llvm::ErrorOr<Status> status() override {
+    llvm::ErrorOr<Status> S = InnerFile->status();
+    if (!S)
+      return S;
+    return Status::copyWithNewName(*S, Name);
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+  getBuffer(const Twine &Name, int64_t FileSize, bool RequiresNullTerminator,
+            bool IsVolatile) override {
+    return InnerFile->getBuffer(Name, FileSize, RequiresNullTerminator,
+                                IsVolatile);
+  }
+  std::error_code close() override { return InnerFile->close(); }
+};
+
+} // namespace
+
+CachingFileSystem::CachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS,
+                                     std::shared_ptr<SharedCache> Cache)
+    : ProxyFileSystem(std::move(FS)), Cache(std::move(Cache)) {
+  if (llvm::ErrorOr<std::string> WD =
+          getUnderlyingFS().getCurrentWorkingDirectory())
+    WorkingDirectory = std::move(*WD);
+}
+
+std::string CachingFileSystem::getAbsolutePath(const Twine &Path) const {
+  SmallString<256> AbsPath;
+  Path.toVector(AbsPath);
+  if (!WorkingDirectory.empty() && !llvm::sys::path::is_absolute(AbsPath)) {
+    SmallString<256> Relative(AbsPath);
+    AbsPath = WorkingDirectory;
+    llvm::sys::path::append(AbsPath, Relative);
+  }
+  llvm::sys::path::remove_dots(AbsPath);
+  return std::string(AbsPath.str());
+}
+
+llvm::ErrorOr<Status> CachingFileSystem::status(const Twine &Path) {
+  std::string AbsPath = getAbsolutePath(Path);
+  {
+    std::lock_guard<std::mutex> Lock(Cache->Mutex);
+    auto I = Cache->StatCache.find(AbsPath);
+    if (I != Cache->StatCache.end()) {
+      if (!I->second)
+        return I->second.getError();
+      return Status::copyWithNewName(*I->second, Path);
+    }
+  }
+
+  llvm::ErrorOr<Status> S = getUnderlyingFS().status(AbsPath);
+  // Only remember that a file is missing, not transient errors.
+  if (S || S.getError() == errc::no_such_file_or_directory ||
+      S.getError() == errc::not_a_directory) {
+    std::lock_guard<std::mutex> Lock(Cache->Mutex);
+    Cache->StatCache.try_emplace(AbsPath, S);
+  }
+  if (!S)
+    return S;
+  return Status::copyWithNewName(*S, Path);
+}
+
+llvm::ErrorOr<std::unique_ptr<File>>
+CachingFileSystem::openFileForRead(const Twine &Path) {
+  std::string AbsPath = getAbsolutePath(Path);
+  {
+    std::lock_guard<std::mutex> Lock(Cache->Mutex);
+    auto I = Cache->StatCache.find(AbsPath);
+    if (I != Cache->StatCache.end() && !I->second)
+      return I->second.getError();
+  }
+  llvm::ErrorOr<std::unique_ptr<File>> F =
+      getUnderlyingFS().openFileForRead(AbsPath);
+  if (!F)
+    return F;
+  return std::unique_ptr<File>(
+      std::make_unique<NamedFile>(std::move(*F), Path.str()));
+}
+
+directory_iterator CachingFileSystem::dir_begin(const Twine &Dir,
+                                                std::error_code &EC) {
+  std::string AbsPath = getAbsolutePath(Dir);
+  std::shared_ptr<const SharedCache::DirectoryListing> Listing;
+  {
+    std::lock_guard<std::mutex> Lock(Cache->Mutex);
+    auto I = Cache->DirCache.find(AbsPath);
+    if (I != Cache->DirCache.end())
+      Listing = I->second;
+  }
+
+  if (!Listing) {
+    auto NewListing = std::make_shared<SharedCache::DirectoryListing>();
+    directory_iterator It = getUnderlyingFS().dir_begin(AbsPath, EC);
+    for (directory_iterator End; !EC && It != End; It.increment(EC))
+      NewListing->emplace_back(
+          std::string(llvm::sys::path::filename(It->path())), It->type());
+    // Errors are not cached. If the listing failed part way, let the caller
+    // see the error where the underlying iterator reports it.
+    if (EC)
+      return getUnderlyingFS().dir_begin(AbsPath, EC);
+
+    std::lock_guard<std::mutex> Lock(Cache->Mutex);
+    Listing =
+        Cache->DirCache.try_emplace(AbsPath, std::move(NewListing)).first->second;
+  }
+
+  EC = {};
+  return directory_iterator(
+      std::make_shared<CachedDirIterImpl>(std::move(Listing), Dir.str()));
+}
+
+llvm::ErrorOr<std::string>
+CachingFileSystem::getCurrentWorkingDirectory() const {
+  if (WorkingDirectory.empty())
+    return ProxyFileSystem::getCurrentWorkingDirectory();
+  return WorkingDirectory;
+}
+
+std::error_code
+CachingFileSystem::setCurrentWorkingDirectory(const Twine &Path) {
+  std::string AbsPath = getAbsolutePath(Path);
+  if (!llvm::sys::path::is_absolute(AbsPath))
+    return errc::operation_not_permitted;
+  llvm::ErrorOr<Status> S = status(AbsPath);
+  if (!S)
+    return S.getError();
+  if (!S->isDirectory())
+    return errc::not_a_directory;
+  WorkingDirectory = std::move(AbsPath);
+  return {};
+}
+
+std::error_code
+CachingFileSystem::getRealPath(const Twine &Path,
+                               SmallVectorImpl<char> &Output) const {
+  return ProxyFileSystem::getRealPath(getAbsolutePath(Path), Output);
+}
+
+std::error_code CachingFileSystem::isLocal(const Twine &Path, bool &Result) {
+  return ProxyFileSystem::isLocal(getAbsolutePath(Path), Result);
+}
+
+void CachingFileSystem::invalidate(const Twine &Path) {
+  Cache->invalidate(getAbsolutePath(Path));
+}
+
+void CachingFileSystem::SharedCache::invalidate(StringRef Path) {
+  StringRef Parent = llvm::sys::path::parent_path(Path);
+
+  auto IsAffected = [&](StringRef K) {
+    return K == Parent ||
+           (K.startswith(Path) &&
+            (K.size() == Path.size() ||
+             llvm::sys::path::is_separator(K[Path.size()])));
+  };
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  for (auto I = StatCache.begin(), E = StatCache.end(); I != E;) {
+    auto Cur = I++;
+    if (IsAffected(Cur->first()))
+      StatCache.erase(Cur);
+  }
+  for (auto I = DirCache.begin(), E = DirCache.end(); I != E;) {
+    auto Cur = I++;
+    if (IsAffected(Cur->first()))
+      DirCache.erase(Cur);
+  }
+}
+
+void CachingFileSystem::SharedCache::invalidateAll() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  StatCache.clear();
+  DirCache.clear();
+}
+
 namespace llvm {
 namespace vfs {
 
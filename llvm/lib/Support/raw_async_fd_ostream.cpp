@@ -0,0 +1,225 @@
+//===- raw_async_fd_ostream.cpp - Asynchronous file output stream ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/raw_async_fd_ostream.h"
+#include "llvm/Config/config.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Process.h"
+#include <cerrno>
+#include <vector>
+
+#if LLVM_ENABLE_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <io.h>
+#endif
+
+using namespace llvm;
+
+// The chunks are large enough to amortize the cost of handing them over, and
+// small enough that writing the last one does not take long.
+static const size_t ChunkSize = 1024 * 1024;
+
+static std::error_code writeAll(int FD, const char *Ptr, size_t Size) {
+  while (Size > 0) {
+    ssize_t Ret = ::write(FD, Ptr, Size);
+    if (Ret < 0) {
+      if (errno == EINTR || errno == EAGAIN)
+        continue;
+      return std::error_code(errno, std::generic_category());
+    }
+    Ptr += Ret;
+    Size -= Ret;
+  }
+  return std::error_code();
+}
+
+static std::error_code seekTo(int FD, uint64_t Offset) {
+#ifdef _WIN32
+  uint64_t Ret = ::_lseeki64(FD, Offset, SEEK_SET);
+#elif defined(HAVE_LSEEK64)
+  uint64_t Ret = ::lseek64(FD, Offset, SEEK_SET);
+#else
+  uint64_t Ret = ::lseek(FD, Offset, SEEK_SET);
+#endif
+  if (Ret == (uint64_t)-1)
+    return std::error_code(errno, std::generic_category());
+  return std::error_code();
+}
+
+/// Writes the chunks it is handed to the file, one at a time, from its own
+/// thread. Without threads, it writes them right away.
+class raw_async_fd_ostream::AsyncWriter {
+public:
+  explicit AsyncWriter(int FD) : FD(FD) {
+#if LLVM_ENABLE_THREADS
+    Thread = std::thread([this] { run(); });
+#endif
+  }
+
+  ~AsyncWriter() {
+#if LLVM_ENABLE_THREADS
+    {
+      std::lock_guard<std::mutex> Lock(Mu);
+      ShuttingDown = true;
+    }
+    CV.notify_all();
+    Thread.join();
+#endif
+  }
+
+  /// Hand a copy of [Ptr, Ptr+Size) over to the writer thread, once it is
+  /// done with the previous chunk.
+  void submit(const char *Ptr, size_t Size) {
+#if LLVM_ENABLE_THREADS
+    // Copy while the writer thread may still be busy with the other buffer.
+    Spare.assign(Ptr, Ptr + Size);
+    std::unique_lock<std::mutex> Lock(Mu);
+    CV.wait(Lock, [this] { return !HasPending; });
+    std::swap(Spare, Pending);
+    HasPending = true;
+    Lock.unlock();
+    CV.notify_all();
+#else
+    if (!EC)
+      EC = writeAll(FD, Ptr, Size);
+#endif
+  }
+
+  /// Wait until all the chunks are written and return the first error.
+  std::error_code drain() {
+#if LLVM_ENABLE_THREADS
+    std::unique_lock<std::mutex> Lock(Mu);
+    CV.wait(Lock, [this] { return !HasPending; });
+#endif
+    std::error_code Result = EC;
+    EC = std::error_code();
+    return Result;
+  }
+
+private:
+#if LLVM_ENABLE_THREADS
+  void run() {
+    std::unique_lock<std::mutex> Lock(Mu);
+    while (true) {
+      CV.wait(Lock, [this] { return HasPending || ShuttingDown; });
+      if (!HasPending)
+        return;
+      // The producer leaves Pending alone until HasPending is reset.
+      Lock.unlock();
+      std::error_code WriteEC;
+      if (!HasError)
+        WriteEC = writeAll(FD, Pending.data(), Pending.size());
+      Lock.lock();
+      if (WriteEC) {
+        EC = WriteEC;
+        HasError = true;
+      }
+      HasPending = false;
+      CV.notify_all();
+    }
+  }
+
+  std::mutex Mu;
+  std::condition_variable CV;
+  std::thread Thread;
+  /// The chunk being written, owned by the writer thread while HasPending.
+  std::vector<char> Pending;
+  /// The buffer the next chunk is copied into.
+  std::vector<char> Spare;
+  bool HasPending = false;
+  bool ShuttingDown = false;
+  /// Stop writing after the first error, as later chunks would land at the
+  /// wrong offset.
+  bool HasError = false;
+#endif
+
+  int FD;
+  std::error_code EC;
+};
+
+raw_async_fd_ostream::raw_async_fd_ostream(StringRef Filename,
+                                           std::error_code &EC,
+                                           sys::fs::OpenFlags Flags) {
+  EC = sys::fs::openFileForWrite(Filename, FD, sys::fs::CD_CreateAlways,
+                                 Flags);
+  if (EC) {
+    FD = -1;
+    return;
+  }
+  Writer = std::make_unique<AsyncWriter>(FD);
+  SetBuffered();
+}
+
+raw_async_fd_ostream::~raw_async_fd_ostream() {
+  if (FD >= 0)
+    close();
+
+  // If there are any pending errors, report them now. Clients wishing to
+  // avoid report_fatal_error calls should check for errors with has_error()
+  // and clear the error flag with clear_error() before destructing the stream.
+  if (has_error())
+    report_fatal_error("IO failure on output stream: " + error().message(),
+                       /*gen_crash_diag=*/false);
+}
+
+void raw_async_fd_ostream::close() {
+  assert(FD >= 0 && "File already closed.");
+  flush();
+  drain();
+  Writer.reset();
+  if (auto CloseEC = sys::Process::SafelyCloseFileDescriptor(FD))
+    if (!EC)
+      EC = CloseEC;
+  FD = -1;
+}
+
+void raw_async_fd_ostream::write_impl(const char *Ptr, size_t Size) {
+  assert(FD >= 0 && "File already closed.");
+  Pos += Size;
+  // raw_ostream writes strings larger than the buffer directly, split them so
+  // the copies stay small.
+  while (Size > 0) {
+    size_t Chunk = std::min(Size, ChunkSize);
+    Writer->submit(Ptr, Chunk);
+    Ptr += Chunk;
+    Size -= Chunk;
+  }
+}
+
+void raw_async_fd_ostream::drain() {
+  if (std::error_code WriterEC = Writer->drain())
+    if (!EC)
+      EC = WriterEC;
+}
+
+void raw_async_fd_ostream::pwrite_impl(const char *Ptr, size_t Size,
+                                       uint64_t Offset) {
+  // The range may still be in the buffer or with the writer thread, so write
+  // everything out first. Back-patching is rare enough that waiting is fine.
+  flush();
+  drain();
+  if (EC)
+    return;
+  if ((EC = seekTo(FD, Offset)))
+    return;
+  if ((EC = writeAll(FD, Ptr, Size)))
+    return;
+  EC = seekTo(FD, Pos);
+}
+
+size_t raw_async_fd_ostream::preferred_buffer_size() const { return ChunkSize; }
@@ -83,7 +83,35 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
-int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
+/// Write \p Contents to \p Filename. With -write-if-changed, a file that
+/// already holds them is left alone unless \p Force is set. \p Written is
+/// set when the file is written.
+static int writeOutput(const char *argv0, StringRef Filename,
+                       StringRef Contents, bool Force = false,
+                       bool *Written = nullptr) {
+  if (WriteIfChanged && !Force) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+  if (Written)
+    *Written = true;
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_None);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ": " +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+  if (ErrorsPrinted == 0)
+    OutFile.keep();
+  return 0;
+}
+
+int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn,
+                       ArrayRef<TableGenOutput> ExtraOutputs) {
   RecordKeeper Records;
 
   if (TimePhases)
@@ -131,28 +159,33 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
       return Ret;
   }
 
-  Records.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr = MemoryBuffer::getFile(OutputFilename))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_None);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << Out.str();
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
+  bool ExtraWritten = false;
+  for (const TableGenOutput &Extra : ExtraOutputs) {
+    if (ErrorsPrinted > 0)
+      break;
+    Records.startBackendTimer("Backend " + Extra.Filename);
+    std::string ExtraString;
+    raw_string_ostream ExtraOut(ExtraString);
+    bool Failed = Extra.Emit(ExtraOut, Records);
+    Records.stopBackendTimer();
+    if (Failed)
+      return 1;
+
+    Records.startTimer("Write " + Extra.Filename);
+    if (int Ret = writeOutput(argv0, Extra.Filename, ExtraOut.str(),
+                              /*Force=*/false, &ExtraWritten))
+      return Ret;
+    Records.stopTimer();
   }
-  
+
+  // Build systems only know the -o file and the depfile as outputs of this
+  // run, so the -o file is written last and whenever an extra output
+  // changed, even with -write-if-changed.
+  Records.startTimer("Write output");
+  if (int Ret = writeOutput(argv0, OutputFilename, Out.str(), ExtraWritten))
+    return Ret;
   Records.stopTimer();
+
   Records.stopPhaseTiming();
 
   if (ErrorsPrinted > 0)
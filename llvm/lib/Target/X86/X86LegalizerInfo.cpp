@@ -165,6 +165,19 @@ void X86LegalizerInfo::setLegalizerInfo32bit() {
   // Control-flow
   setAction({G_BRCOND, s1}, Legal);
 
+  // Selects, which are selected to CMOV.
+  if (Subtarget.hasCMov()) {
+    const LLT MaxSelectTy = Subtarget.is64Bit() ? s64 : s32;
+    getActionDefinitionsBuilder(G_SELECT)
+        .legalFor({{s16, s1}, {s32, s1}, {p0, s1}})
+        .legalIf([=](const LegalityQuery &Query) {
+          return Subtarget.is64Bit() && Query.Types[0] == s64 &&
+                 Query.Types[1] == s1;
+        })
+        .widenScalarToNextPow2(0, /*Min*/ 16)
+        .clampScalar(0, s16, MaxSelectTy);
+  }
+
   // Constants
   for (auto Ty : {s8, s16, s32, p0})
     setAction({TargetOpcode::G_CONSTANT, Ty}, Legal);
@@ -9,18 +9,24 @@
 #include "llvm/Transforms/Coroutines/CoroElide.h"
 #include "CoroInternal.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/InstructionSimplify.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/InstIterator.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 
 using namespace llvm;
 
 #define DEBUG_TYPE "coro-elide"
 
+STATISTIC(NumElided, "Number of coroutine frame allocations elided");
+STATISTIC(NumNotElided,
+          "Number of coroutine frame allocations that could not be elided");
+
 namespace {
 // Created on demand if the coro-elide pass has work to do.
 struct Lowerer : coro::LowererBase {
@@ -326,6 +332,14 @@ bool Lowerer::processCoroId(CoroIdInst *CoroId, AAResults &AA,
   replaceWithConstant(ResumeAddrConstant, ResumeAddr);
 
   bool ShouldElide = shouldElide(CoroId->getFunction(), DT);
+  if (ShouldElide)
+    ++NumElided;
+  else
+    ++NumNotElided;
+  LLVM_DEBUG(dbgs() << (ShouldElide ? "Eliding" : "Not eliding")
+                    << " the frame allocation of '"
+                    << CoroId->getCoroutine()->getName() << "' in '"
+                    << CoroId->getFunction()->getName() << "'\n");
 
   auto *DestroyAddrConstant = ConstantExpr::getExtractValue(
       Resumers,
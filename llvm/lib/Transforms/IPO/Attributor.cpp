@@ -63,6 +63,9 @@ STATISTIC(NumAttributesValidFixpoint,
           "Number of abstract attributes in a valid fixpoint state");
 STATISTIC(NumAttributesManifested,
           "Number of abstract attributes manifested in IR");
+STATISTIC(NumAttributeUpdates, "Number of abstract attribute updates");
+STATISTIC(NumUpdateBudgetExhausted,
+          "Number of fixpoint iterations stopped by the update budget");
 STATISTIC(NumAttributesFixedDueToRequiredDependences,
           "Number of abstract attributes fixed due to required dependences");
 
@@ -79,6 +82,21 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+// The number of iterations alone does not bound the work, as a single
+// iteration may update every abstract attribute in the module. A budget on the
+// number of updates does, and unlike a time limit it keeps the results
+// reproducible across machines.
+static cl::opt<unsigned>
+    MaxUpdates("attributor-max-updates", cl::Hidden,
+               cl::desc("Maximal number of abstract attribute updates during "
+                        "the fixpoint iteration (0 = unlimited)."),
+               cl::init(0));
+
+static cl::opt<bool> PrintUpdateCounts(
+    "attributor-print-update-counts", cl::Hidden,
+    cl::desc("Print the number of updates per kind of abstract attribute"),
+    cl::init(false));
+
 static cl::opt<unsigned, true> MaxInitializationChainLengthX(
     "attributor-max-initialization-chain-length", cl::Hidden,
     cl::desc(
@@ -1079,12 +1097,21 @@ void Attributor::runTillFixpoint() {
     Worklist.clear();
     Worklist.insert(ChangedAAs.begin(), ChangedAAs.end());
 
+    // The budget is only checked between iterations, so all the attributes
+    // that are not in a sound fixpoint are in ChangedAAs, or depend on one
+    // that is, when we stop.
+    if (MaxUpdates && NumUpdates >= MaxUpdates && !Worklist.empty()) {
+      ++NumUpdateBudgetExhausted;
+      LLVM_DEBUG(dbgs() << "[Attributor] Update budget exhausted after "
+                        << NumUpdates << " updates\n");
+      break;
+    }
   } while (!Worklist.empty() && (IterationCounter++ < MaxFixpointIterations ||
                                  VerifyMaxFixpointIterations));
 
   LLVM_DEBUG(dbgs() << "\n[Attributor] Fixpoint iteration done after: "
                     << IterationCounter << "/" << MaxFixpointIterations
-                    << " iterations\n");
+                    << " iterations, " << NumUpdates << " updates\n");
 
   // Reset abstract arguments not settled in a sound fixpoint by now. This
   // happens when we stopped the fixpoint iteration early. Note that only the
@@ -1434,6 +1461,9 @@ ChangeStatus Attributor::run() {
   if (PrintDependencies)
     DG.print();
 
+  if (PrintUpdateCounts)
+    printUpdateCounts(errs());
+
   Phase = AttributorPhase::MANIFEST;
   ChangeStatus ManifestChange = manifestAttributes();
 
@@ -1450,6 +1480,14 @@ ChangeStatus Attributor::updateAA(AbstractAttribute &AA) {
   assert(Phase == AttributorPhase::UPDATE &&
          "We can update AA only in the update stage!");
 
+  ++NumUpdates;
+  ++NumAttributeUpdates;
+  if (PrintUpdateCounts) {
+    auto &Entry = UpdatesPerKind[AA.getIdAddr()];
+    Entry.first = &AA;
+    ++Entry.second;
+  }
+
   // Use a new dependence vector for this update.
   DependenceVector DV;
   DependenceStack.push_back(&DV);
@@ -1477,6 +1515,13 @@ ChangeStatus Attributor::updateAA(AbstractAttribute &AA) {
   return CS;
 }
 
+void Attributor::printUpdateCounts(raw_ostream &OS) const {
+  OS << "[Attributor] Updates per abstract attribute kind:\n";
+  for (auto &It : UpdatesPerKind)
+    OS << "  " << It.second.first->getName() << ": " << It.second.second
+       << "\n";
+}
+
 void Attributor::createShallowWrapper(Function &F) {
   assert(!F.isDeclaration() && "Cannot create a wrapper around a declaration!");
 
@@ -42,12 +42,14 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <set>
@@ -384,7 +386,8 @@ static void computeImportForFunction(
     FunctionImporter::ImportThresholdsTy &ImportThresholds) {
   computeImportForReferencedGlobals(Summary, Index, DefinedGVSummaries,
                                     Worklist, ImportList, ExportLists);
-  static int ImportCount = 0;
+  // Shared by all modules, which may be processed concurrently.
+  static std::atomic<int> ImportCount(0);
   for (auto &Edge : Summary.calls()) {
     ValueInfo VI = Edge.first;
     LLVM_DEBUG(dbgs() << " edge -> " << VI << " Threshold:" << Threshold
@@ -679,15 +682,44 @@ void llvm::ComputeCrossModuleImport(
     StringMap<FunctionImporter::ImportMapTy> &ImportLists,
     StringMap<FunctionImporter::ExportSetTy> &ExportLists) {
   // For each module that has function defined, compute the import/export lists.
-  for (auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first()];
-    LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first() << "'\n");
-    ComputeImportForModule(DefinedGVSummaries.second, Index,
-                           DefinedGVSummaries.first(), ImportList,
-                           &ExportLists);
+  // The index is only read while doing so, which lets the modules be processed
+  // concurrently. Each module records the values it exports from other modules
+  // in its own map, which are merged below in module order. Stay serial when
+  // the output or the result depends on the order modules are visited in.
+  struct ModuleImportState {
+    StringRef ModulePath;
+    const GVSummaryMapTy *DefinedGVSummaries;
+    FunctionImporter::ImportMapTy *ImportList;
+    StringMap<FunctionImporter::ExportSetTy> ExportLists;
+  };
+  std::vector<ModuleImportState> Modules;
+  Modules.reserve(ModuleToDefinedGVSummaries.size());
+  for (auto &DefinedGVSummaries : ModuleToDefinedGVSummaries)
+    Modules.push_back({DefinedGVSummaries.first(), &DefinedGVSummaries.second,
+                       &ImportLists[DefinedGVSummaries.first()],
+                       StringMap<FunctionImporter::ExportSetTy>()});
+
+  auto ComputeForModule = [&](size_t I) {
+    ModuleImportState &MS = Modules[I];
+    LLVM_DEBUG(dbgs() << "Computing import for Module '" << MS.ModulePath
+                      << "'\n");
+    ComputeImportForModule(*MS.DefinedGVSummaries, Index, MS.ModulePath,
+                           *MS.ImportList, &MS.ExportLists);
+  };
+  bool Serial = PrintImportFailures || ImportCutoff >= 0;
+  LLVM_DEBUG(Serial = true);
+  if (Serial) {
+    for (size_t I = 0, E = Modules.size(); I != E; ++I)
+      ComputeForModule(I);
+  } else {
+    parallelForEachN(0, Modules.size(), ComputeForModule);
   }
 
+  for (ModuleImportState &MS : Modules)
+    for (auto &ELI : MS.ExportLists)
+      ExportLists[ELI.first()].insert(ELI.second.begin(), ELI.second.end());
+  Modules.clear();
+
   // When computing imports we only added the variables and functions being
   // imported to the export list. We also need to mark any references and calls
   // they make as exported as well. We do this here, as it is more efficient
@@ -342,6 +342,12 @@ static cl::opt<bool> ClOptSameTemp(
     "asan-opt-same-temp", cl::desc("Instrument the same temp just once"),
     cl::Hidden, cl::init(true));
 
+static cl::opt<bool> ClOptSameBase(
+    "asan-opt-same-base",
+    cl::desc("Don't instrument accesses covered by an earlier access to the "
+             "same base pointer in the same basic block"),
+    cl::Hidden, cl::init(true));
+
 static cl::opt<bool> ClOptGlobals("asan-opt-globals",
                                   cl::desc("Don't instrument scalar globals"),
                                   cl::Hidden, cl::init(true));
@@ -2702,6 +2708,36 @@ bool AddressSanitizer::suppressInstrumentationSiteForDebug(int &Instrumented) {
   return !ShouldInstrument;
 }
 
+// Returns true if the access described by \p Operand lies entirely within a
+// byte range already checked in the current basic block. Otherwise, records
+// the range checked by \p Operand in \p CheckedRanges when that check is exact,
+// and returns false.
+static bool isCoveredByCheckedRange(
+    InterestingMemoryOperand &Operand,
+    DenseMap<Value *, SmallVector<std::pair<int64_t, uint64_t>, 4>>
+        &CheckedRanges,
+    const DataLayout &DL) {
+  if (Operand.TypeSize % 8 != 0)
+    return false;
+  const uint64_t Size = Operand.TypeSize / 8;
+  int64_t Offset = 0;
+  Value *Base =
+      GetPointerBaseWithConstantOffset(Operand.getPtr(), Offset, DL);
+  auto &Ranges = CheckedRanges[Base];
+  for (const auto &Range : Ranges)
+    if (Range.first <= Offset &&
+        Offset + static_cast<int64_t>(Size) <=
+            Range.first + static_cast<int64_t>(Range.second))
+      return true;
+  // Only naturally aligned accesses of up to 16 bytes are checked with a
+  // single shadow load covering every byte. Wider or misaligned accesses only
+  // get their first and last bytes checked, so they can't cover anything.
+  if (Size <= 16 && isPowerOf2_64(Size) && Operand.Alignment &&
+      Operand.Alignment->value() >= Size)
+    Ranges.emplace_back(Offset, Size);
+  return false;
+}
+
 bool AddressSanitizer::instrumentFunction(Function &F,
                                           const TargetLibraryInfo *TLI) {
   if (F.getLinkage() == GlobalValue::AvailableExternallyLinkage) return false;
@@ -2734,6 +2770,10 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   // We want to instrument every address only once per basic block (unless there
   // are calls between uses).
   SmallPtrSet<Value *, 16> TempsToInstrument;
+  // Byte ranges, relative to a base pointer, that are fully checked by an
+  // access already instrumented in the current basic block.
+  DenseMap<Value *, SmallVector<std::pair<int64_t, uint64_t>, 4>> CheckedRanges;
+  const DataLayout &DL = F.getParent()->getDataLayout();
   SmallVector<InterestingMemoryOperand, 16> OperandsToInstrument;
   SmallVector<MemIntrinsic *, 16> IntrinToInstrument;
   SmallVector<Instruction *, 8> NoReturnCalls;
@@ -2745,6 +2785,7 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   for (auto &BB : F) {
     AllBlocks.push_back(&BB);
     TempsToInstrument.clear();
+    CheckedRanges.clear();
     int NumInsnsPerBB = 0;
     for (auto &Inst : BB) {
       if (LooksLikeCodeInBug11395(&Inst)) return false;
@@ -2766,6 +2807,9 @@ bool AddressSanitizer::instrumentFunction(Function &F,
                 continue; // We've seen this temp in the current BB.
             }
           }
+          if (ClOpt && ClOptSameBase && !Operand.MaybeMask &&
+              isCoveredByCheckedRange(Operand, CheckedRanges, DL))
+            continue; // An earlier access in the current BB checked it all.
           OperandsToInstrument.push_back(Operand);
           NumInsnsPerBB++;
         }
@@ -2783,6 +2827,7 @@ bool AddressSanitizer::instrumentFunction(Function &F,
         if (auto *CB = dyn_cast<CallBase>(&Inst)) {
           // A call inside BB.
           TempsToInstrument.clear();
+          CheckedRanges.clear();
           if (CB->doesNotReturn() && !CB->hasMetadata("nosanitize"))
             NoReturnCalls.push_back(CB);
         }
@@ -2796,7 +2841,6 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   bool UseCalls = (ClInstrumentationWithCallsThreshold >= 0 &&
                    OperandsToInstrument.size() + IntrinToInstrument.size() >
                        (unsigned)ClInstrumentationWithCallsThreshold);
-  const DataLayout &DL = F.getParent()->getDataLayout();
   ObjectSizeOpts ObjSizeOpts;
   ObjSizeOpts.RoundToAlign = true;
   ObjectSizeOffsetVisitor ObjSizeVis(DL, TLI, F.getContext(), ObjSizeOpts);
@@ -36,6 +36,7 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/NoFolder.h"
 #include "llvm/IR/Type.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
@@ -44,6 +45,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "llvm/Transforms/Utils/SSAUpdater.h"
@@ -69,6 +71,16 @@ cl::opt<bool> RuntimeCounterRelocation(
     cl::desc("Enable relocating counters at runtime."),
     cl::init(false));
 
+cl::opt<unsigned> CounterShards(
+    "instrprof-counter-shards",
+    cl::desc("Number of copies of the profile counters of each function. "
+             "Threads update the copy selected by a hash of their thread "
+             "local storage address, and the runtime folds the copies "
+             "together when writing the profile. This reduces cache line "
+             "contention in multi-threaded programs. Must be a power of two, "
+             "and the same for all the objects linked into a binary."),
+    cl::init(1));
+
 cl::opt<bool> ValueProfileStaticAlloc(
     "vp-static-alloc",
     cl::desc("Do static counter allocation for value profiler"),
@@ -473,6 +485,14 @@ bool InstrProfiling::isRuntimeCounterRelocationEnabled() const {
   return TT.isOSFuchsia();
 }
 
+unsigned InstrProfiling::getNumCounterShards() const {
+  // Continuous mode maps the counters straight into the profile, so there is
+  // no point at which the shards could be folded.
+  if (CounterShards <= 1 || isRuntimeCounterRelocationEnabled())
+    return 1;
+  return PowerOf2Floor(CounterShards);
+}
+
 bool InstrProfiling::isCounterPromotionEnabled() const {
   if (DoCounterPromotion.getNumOccurrences() > 0)
     return DoCounterPromotion;
@@ -541,6 +561,8 @@ bool InstrProfiling::run(
   ProfileDataMap.clear();
   CompilerUsedVars.clear();
   UsedVars.clear();
+  FunctionToProfileBiasMap.clear();
+  FunctionToCounterShardMap.clear();
   TT = Triple(M.getTargetTriple());
 
   // Emit the runtime hook even if no counters are present.
@@ -671,6 +693,62 @@ void InstrProfiling::lowerValueProfileInst(InstrProfValueProfileInst *Ind) {
   Ind->eraseFromParent();
 }
 
+LoadInst *InstrProfiling::getCounterBias(Function *F) {
+  LoadInst *&LI = FunctionToProfileBiasMap[F];
+  if (LI)
+    return LI;
+  IRBuilder<> Builder(&*F->getEntryBlock().getFirstInsertionPt());
+  Type *Int64Ty = Type::getInt64Ty(M->getContext());
+  GlobalVariable *Bias = M->getGlobalVariable(getInstrProfCounterBiasVarName());
+  if (!Bias) {
+    Bias = new GlobalVariable(*M, Int64Ty, false,
+                              GlobalValue::LinkOnceODRLinkage,
+                              Constant::getNullValue(Int64Ty),
+                              getInstrProfCounterBiasVarName());
+    Bias->setVisibility(GlobalVariable::HiddenVisibility);
+  }
+  LI = Builder.CreateLoad(Int64Ty, Bias);
+  return LI;
+}
+
+Instruction *InstrProfiling::getCounterShard(Function *F) {
+  Instruction *&Shard = FunctionToCounterShardMap[F];
+  if (Shard)
+    return Shard;
+
+  LLVMContext &Ctx = M->getContext();
+  Type *Int8Ty = Type::getInt8Ty(Ctx);
+  Type *Int32Ty = Type::getInt32Ty(Ctx);
+  GlobalVariable *Anchor =
+      M->getGlobalVariable(getInstrProfCounterShardAnchorVarName());
+  if (!Anchor) {
+    Anchor = new GlobalVariable(
+        *M, Int8Ty, false, GlobalValue::LinkOnceODRLinkage,
+        Constant::getNullValue(Int8Ty), getInstrProfCounterShardAnchorVarName(),
+        nullptr, GlobalVariable::InitialExecTLSModel);
+    Anchor->setVisibility(GlobalVariable::HiddenVisibility);
+    // Let the runtime know that it has to fold the shards.
+    auto *Shards = new GlobalVariable(
+        *M, Int32Ty, true, GlobalValue::LinkOnceODRLinkage,
+        ConstantInt::get(Int32Ty, getNumCounterShards()),
+        getInstrProfCounterShardsVarName());
+    Shards->setVisibility(GlobalVariable::HiddenVisibility);
+    CompilerUsedVars.push_back(Shards);
+  }
+
+  // The thread local storage blocks of different threads are typically far
+  // apart but share their low bits, so hash the page number of the anchor to
+  // pick the shard. The anchor address is a constant expression, so use a
+  // builder that doesn't fold, to compute the hash only once per call.
+  IRBuilder<NoFolder> Builder(&*F->getEntryBlock().getFirstInsertionPt());
+  Value *TLSAddr = Builder.CreatePtrToInt(Anchor, Builder.getInt64Ty());
+  Value *Hash = Builder.CreateMul(Builder.CreateLShr(TLSAddr, 12),
+                                  Builder.getInt64(0x9E3779B97F4A7C15ULL));
+  Shard = cast<Instruction>(
+      Builder.CreateLShr(Hash, 64 - Log2_32(getNumCounterShards())));
+  return Shard;
+}
+
 void InstrProfiling::lowerIncrement(InstrProfIncrementInst *Inc) {
   GlobalVariable *Counters = getOrCreateRegionCounters(Inc);
 
@@ -679,24 +757,26 @@ void InstrProfiling::lowerIncrement(InstrProfIncrementInst *Inc) {
   Value *Addr = Builder.CreateConstInBoundsGEP2_64(Counters->getValueType(),
                                                    Counters, 0, Index);
 
+  if (getNumCounterShards() > 1) {
+    // Compute the address in the entry block, so that it dominates the loop
+    // exits counter promotion sinks the updates to. Increments inlined from
+    // other functions have their own number of counters, so only the shard is
+    // shared.
+    Instruction *Shard = getCounterShard(Inc->getParent()->getParent());
+    IRBuilder<> EntryBuilder(Shard->getNextNode());
+    uint64_t NumCounters = Inc->getNumCounters()->getZExtValue();
+    Value *ShardIndex = EntryBuilder.CreateAdd(
+        EntryBuilder.CreateMul(Shard, EntryBuilder.getInt64(NumCounters)),
+        EntryBuilder.getInt64(Index));
+    Addr = EntryBuilder.CreateInBoundsGEP(
+        Counters->getValueType(), Counters,
+        {EntryBuilder.getInt64(0), ShardIndex});
+  }
+
   if (isRuntimeCounterRelocationEnabled()) {
     Type *Int64Ty = Type::getInt64Ty(M->getContext());
     Type *Int64PtrTy = Type::getInt64PtrTy(M->getContext());
-    Function *Fn = Inc->getParent()->getParent();
-    Instruction &I = Fn->getEntryBlock().front();
-    LoadInst *LI = dyn_cast<LoadInst>(&I);
-    if (!LI) {
-      IRBuilder<> Builder(&I);
-      Type *Int64Ty = Type::getInt64Ty(M->getContext());
-      GlobalVariable *Bias = M->getGlobalVariable(getInstrProfCounterBiasVarName());
-      if (!Bias) {
-        Bias = new GlobalVariable(*M, Int64Ty, false, GlobalValue::LinkOnceODRLinkage,
-                                  Constant::getNullValue(Int64Ty),
-                                  getInstrProfCounterBiasVarName());
-        Bias->setVisibility(GlobalVariable::HiddenVisibility);
-      }
-      LI = Builder.CreateLoad(Int64Ty, Bias);
-    }
+    LoadInst *LI = getCounterBias(Inc->getParent()->getParent());
     auto *Add = Builder.CreateAdd(Builder.CreatePtrToInt(Addr, Int64Ty), LI);
     Addr = Builder.CreateIntToPtr(Add, Int64PtrTy);
   }
@@ -848,7 +928,8 @@ InstrProfiling::getOrCreateRegionCounters(InstrProfIncrementInst *Inc) {
 
   uint64_t NumCounters = Inc->getNumCounters()->getZExtValue();
   LLVMContext &Ctx = M->getContext();
-  ArrayType *CounterTy = ArrayType::get(Type::getInt64Ty(Ctx), NumCounters);
+  ArrayType *CounterTy = ArrayType::get(Type::getInt64Ty(Ctx),
+                                        NumCounters * getNumCounterShards());
 
   // Create the counters variable.
   auto *CounterPtr =
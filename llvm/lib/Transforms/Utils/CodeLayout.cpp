@@ -0,0 +1,289 @@
+//===- CodeLayout.cpp - Implementation of code layout algorithms ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The ext-TSP layout is computed greedily: every node starts in a chain of its
+// own, and the two chains whose concatenation increases the score the most are
+// merged, until no merge increases the score. The remaining chains are then
+// ordered by decreasing density, with the entry chain first.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/Utils/CodeLayout.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/CommandLine.h"
+#include <algorithm>
+
+using namespace llvm;
+
+static cl::opt<double> FallthroughWeight(
+    "ext-tsp-fallthrough-weight", cl::Hidden, cl::init(1.0),
+    cl::desc("The weight of a fallthrough jump in the ext-TSP score"));
+
+static cl::opt<double> ForwardWeight(
+    "ext-tsp-forward-weight", cl::Hidden, cl::init(0.1),
+    cl::desc("The weight of a short forward jump in the ext-TSP score"));
+
+static cl::opt<double> BackwardWeight(
+    "ext-tsp-backward-weight", cl::Hidden, cl::init(0.1),
+    cl::desc("The weight of a short backward jump in the ext-TSP score"));
+
+static cl::opt<unsigned> ForwardDistance(
+    "ext-tsp-forward-distance", cl::Hidden, cl::init(1024),
+    cl::desc("The maximum distance, in bytes, of a scored forward jump"));
+
+static cl::opt<unsigned> BackwardDistance(
+    "ext-tsp-backward-distance", cl::Hidden, cl::init(640),
+    cl::desc("The maximum distance, in bytes, of a scored backward jump"));
+
+namespace {
+
+/// The score of a jump executed \p Count times, from the end of a node at
+/// \p SrcEnd to the beginning of a node at \p DstAddr.
+double jumpScore(uint64_t SrcEnd, uint64_t DstAddr, uint64_t Count) {
+  if (DstAddr == SrcEnd)
+    return FallthroughWeight * Count;
+  if (DstAddr > SrcEnd) {
+    uint64_t Dist = DstAddr - SrcEnd;
+    if (Dist <= ForwardDistance)
+      return ForwardWeight * Count * (1.0 - double(Dist) / ForwardDistance);
+    return 0;
+  }
+  uint64_t Dist = SrcEnd - DstAddr;
+  if (Dist <= BackwardDistance)
+    return BackwardWeight * Count * (1.0 - double(Dist) / BackwardDistance);
+  return 0;
+}
+
+struct Chain {
+  std::vector<uint64_t> Nodes;
+  uint64_t Size = 0;
+  uint64_t Count = 0;
+  /// The score of the jumps within the chain.
+  double Score = 0;
+  bool HasEntry = false;
+  bool Merged = false;
+};
+
+/// The gain of merging two chains, and in which order.
+struct MergeGain {
+  double Gain;
+  bool KeepOrder;
+};
+
+class ExtTSPLayout {
+public:
+  ExtTSPLayout(const std::vector<uint64_t> &NodeSizes,
+               const std::vector<uint64_t> &NodeCounts,
+               const EdgeCountMap &EdgeCounts)
+      : NodeSizes(NodeSizes), Succs(NodeSizes.size()), Preds(NodeSizes.size()),
+        ChainOf(NodeSizes.size()), Addr(NodeSizes.size()),
+        Stamp(NodeSizes.size()), Chains(NodeSizes.size()) {
+    for (const auto &Edge : EdgeCounts) {
+      uint64_t Src = Edge.first.first, Dst = Edge.first.second;
+      if (Edge.second == 0)
+        continue;
+      Succs[Src].push_back({Dst, Edge.second});
+      Preds[Dst].push_back(Src);
+    }
+    // Make the result independent of the hash map iteration order.
+    for (auto &S : Succs)
+      llvm::sort(S);
+    for (auto &P : Preds)
+      llvm::sort(P);
+
+    for (uint64_t I = 0, E = NodeSizes.size(); I != E; ++I) {
+      Chain &C = Chains[I];
+      C.Nodes.push_back(I);
+      C.Size = NodeSizes[I];
+      C.Count = NodeCounts[I];
+      C.HasEntry = I == 0;
+      ChainOf[I] = I;
+      C.Score = score({&C.Nodes});
+    }
+  }
+
+  std::vector<uint64_t> run() {
+    for (uint64_t I = 0, E = Chains.size(); I != E; ++I)
+      updateGains(I);
+
+    while (true) {
+      // Find the best merge; break ties on the chain numbers, to be
+      // deterministic. Gains that are only rounding errors are ignored.
+      const std::pair<uint64_t, uint64_t> *BestKey = nullptr;
+      MergeGain Best = {0, true};
+      for (const auto &It : Gains) {
+        if (It.second.Gain <= 1e-9)
+          continue;
+        if (BestKey && (It.second.Gain < Best.Gain ||
+                        (It.second.Gain == Best.Gain && *BestKey < It.first)))
+          continue;
+        BestKey = &It.first;
+        Best = It.second;
+      }
+      if (!BestKey)
+        break;
+      mergeChains(BestKey->first, BestKey->second, Best.KeepOrder);
+    }
+
+    std::vector<const Chain *> Sorted;
+    for (const Chain &C : Chains)
+      if (!C.Merged)
+        Sorted.push_back(&C);
+    llvm::stable_sort(Sorted, [](const Chain *L, const Chain *R) {
+      if (L->HasEntry != R->HasEntry)
+        return L->HasEntry;
+      // Place denser chains first, and empty ones last.
+      double LDensity = L->Size ? double(L->Count) / L->Size : 0;
+      double RDensity = R->Size ? double(R->Count) / R->Size : 0;
+      return LDensity > RDensity;
+    });
+
+    std::vector<uint64_t> Order;
+    Order.reserve(NodeSizes.size());
+    for (const Chain *C : Sorted)
+      Order.insert(Order.end(), C->Nodes.begin(), C->Nodes.end());
+    return Order;
+  }
+
+private:
+  /// Compute the score of the jumps between the nodes of \p Parts, laid out
+  /// one after the other.
+  double score(ArrayRef<const std::vector<uint64_t> *> Parts) {
+    ++Epoch;
+    uint64_t Offset = 0;
+    for (const std::vector<uint64_t> *Part : Parts)
+      for (uint64_t N : *Part) {
+        Addr[N] = Offset;
+        Stamp[N] = Epoch;
+        Offset += NodeSizes[N];
+      }
+    double Score = 0;
+    for (const std::vector<uint64_t> *Part : Parts)
+      for (uint64_t N : *Part)
+        for (const auto &Succ : Succs[N])
+          if (Stamp[Succ.first] == Epoch)
+            Score += jumpScore(Addr[N] + NodeSizes[N], Addr[Succ.first],
+                               Succ.second);
+    return Score;
+  }
+
+  /// Compute the gain of merging chains \p X and \p Y.
+  MergeGain computeGain(uint64_t X, uint64_t Y) {
+    const Chain &CX = Chains[X], &CY = Chains[Y];
+    MergeGain Result = {0, true};
+    double Base = CX.Score + CY.Score;
+    if (!CY.HasEntry)
+      Result.Gain = score({&CX.Nodes, &CY.Nodes}) - Base;
+    if (!CX.HasEntry) {
+      double Gain = score({&CY.Nodes, &CX.Nodes}) - Base;
+      if (CY.HasEntry || Gain > Result.Gain)
+        Result = {Gain, false};
+    }
+    return Result;
+  }
+
+  /// Compute the gains of merging chain \p X with each chain it jumps to or
+  /// that jumps to it.
+  void updateGains(uint64_t X) {
+    auto Update = [&](uint64_t Node) {
+      uint64_t Y = ChainOf[Node];
+      if (Y == X)
+        return;
+      auto Key = std::make_pair(std::min(X, Y), std::max(X, Y));
+      if (Gains.count(Key))
+        return;
+      Gains[Key] = computeGain(Key.first, Key.second);
+    };
+    for (uint64_t N : Chains[X].Nodes) {
+      for (const auto &Succ : Succs[N])
+        Update(Succ.first);
+      for (uint64_t Pred : Preds[N])
+        Update(Pred);
+    }
+  }
+
+  /// Merge chains \p X and \p Y into \p X, with \p X first if \p KeepOrder.
+  void mergeChains(uint64_t X, uint64_t Y, bool KeepOrder) {
+    Chain &CX = Chains[X], &CY = Chains[Y];
+    for (uint64_t N : CY.Nodes)
+      ChainOf[N] = X;
+    if (KeepOrder)
+      CX.Nodes.insert(CX.Nodes.end(), CY.Nodes.begin(), CY.Nodes.end());
+    else
+      CX.Nodes.insert(CX.Nodes.begin(), CY.Nodes.begin(), CY.Nodes.end());
+    CX.Size += CY.Size;
+    CX.Count += CY.Count;
+    CX.HasEntry |= CY.HasEntry;
+    CX.Score = score({&CX.Nodes});
+    CY.Merged = true;
+    CY.Nodes.clear();
+
+    // Drop the gains that the merge made stale, and compute the new ones.
+    SmallVector<std::pair<uint64_t, uint64_t>, 8> Stale;
+    for (const auto &It : Gains)
+      if (It.first.first == X || It.first.second == X ||
+          It.first.first == Y || It.first.second == Y)
+        Stale.push_back(It.first);
+    for (const auto &Key : Stale)
+      Gains.erase(Key);
+    updateGains(X);
+  }
+
+  const std::vector<uint64_t> &NodeSizes;
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> Succs;
+  std::vector<std::vector<uint64_t>> Preds;
+  std::vector<uint64_t> ChainOf;
+
+  /// Scratch space for score().
+  std::vector<uint64_t> Addr;
+  std::vector<uint64_t> Stamp;
+  uint64_t Epoch = 0;
+
+  std::vector<Chain> Chains;
+  DenseMap<std::pair<uint64_t, uint64_t>, MergeGain> Gains;
+};
+
+} // end anonymous namespace
+
+std::vector<uint64_t>
+llvm::applyExtTspLayout(const std::vector<uint64_t> &NodeSizes,
+                        const std::vector<uint64_t> &NodeCounts,
+                        const EdgeCountMap &EdgeCounts) {
+  assert(NodeSizes.size() == NodeCounts.size() &&
+         "Expected a size and a count for every node");
+  if (NodeSizes.empty())
+    return {};
+  return ExtTSPLayout(NodeSizes, NodeCounts, EdgeCounts).run();
+}
+
+double llvm::calcExtTspScore(const std::vector<uint64_t> &Order,
+                             const std::vector<uint64_t> &NodeSizes,
+                             const std::vector<uint64_t> &NodeCounts,
+                             const EdgeCountMap &EdgeCounts) {
+  std::vector<uint64_t> Addr(NodeSizes.size());
+  uint64_t Offset = 0;
+  for (uint64_t N : Order) {
+    Addr[N] = Offset;
+    Offset += NodeSizes[N];
+  }
+  double Score = 0;
+  for (const auto &Edge : EdgeCounts) {
+    uint64_t Src = Edge.first.first, Dst = Edge.first.second;
+    Score += jumpScore(Addr[Src] + NodeSizes[Src], Addr[Dst], Edge.second);
+  }
+  return Score;
+}
+
+double llvm::calcExtTspScore(const std::vector<uint64_t> &NodeSizes,
+                             const std::vector<uint64_t> &NodeCounts,
+                             const EdgeCountMap &EdgeCounts) {
+  std::vector<uint64_t> Order(NodeSizes.size());
+  for (uint64_t I = 0, E = NodeSizes.size(); I != E; ++I)
+    Order[I] = I;
+  return calcExtTspScore(Order, NodeSizes, NodeCounts, EdgeCounts);
+}
@@ -1116,6 +1116,27 @@ bool LoopVectorizationLegality::canVectorizeLoopCFG(Loop *Lp,
     else
       return false;
   }
+
+  // Loops that may exit before their trip count is reached, such as searches,
+  // would need the exit condition of the remaining iterations of a vector
+  // iteration to be masked or speculated, which is not supported. Identify
+  // them separately from other uncomputable trip counts, which are reported
+  // by the memory dependence checks. Use a local predicate, the ones needed
+  // for the trip count are added to PSE later, with the memory checks.
+  SCEVUnionPredicate BackedgePred;
+  if (Lp == TheLoop && !Lp->getExitingBlock() &&
+      isa<SCEVCouldNotCompute>(
+          PSE.getSE()->getPredicatedBackedgeTakenCount(Lp, BackedgePred))) {
+    reportVectorizationFailure(
+        "Cannot vectorize a loop with an uncountable early exit",
+        "could not determine number of loop iterations because the loop has "
+        "an early exit",
+        "UncountableEarlyExit", ORE, TheLoop);
+    if (DoExtraAnalysis)
+      Result = false;
+    else
+      return false;
+  }
   return Result;
 }
 
@@ -6110,31 +6110,85 @@ bool SLPVectorizerPass::vectorizeStores(ArrayRef<StoreInst *> Stores,
   SmallVector<int, 16> ConsecutiveChain(E, E + 1);
   int MaxIter = MaxStoreLookup.getValue();
   int IterCnt;
-  auto &&FindConsecutiveAccess = [this, &Stores, &Tails, &IterCnt, MaxIter,
-                                  &ConsecutiveChain](int K, int Idx) {
-    if (IterCnt >= MaxIter)
-      return true;
+  auto &&IsConsecutiveAccess = [this, &Stores, &IterCnt](int K, int Idx) {
     ++IterCnt;
-    if (!isConsecutiveAccess(Stores[K], Stores[Idx], *DL, *SE))
-      return false;
+    return isConsecutiveAccess(Stores[K], Stores[Idx], *DL, *SE);
+  };
 
-    Tails.set(Idx);
-    ConsecutiveChain[K] = Idx;
-    return true;
+  // Index the stores by the base and the constant offset of their pointer, so
+  // that the closest store that another one follows can be found directly in
+  // the common case, instead of only within the lookup limit.
+  using OffsetKey = std::tuple<const Value *, Type *, int64_t>;
+  DenseMap<OffsetKey, SmallVector<int, 1>> StoresByOffset;
+  SmallVector<Optional<OffsetKey>, 16> Keys(E);
+  for (int Idx = 0; Idx < E; ++Idx) {
+    Value *Ptr = Stores[Idx]->getPointerOperand();
+    APInt Offset(DL->getIndexTypeSizeInBits(Ptr->getType()), 0);
+    const Value *Base =
+        Ptr->stripAndAccumulateInBoundsConstantOffsets(*DL, Offset);
+    if (Offset.getMinSignedBits() > 64)
+      continue;
+    Keys[Idx] = OffsetKey(Base, Ptr->getType(), Offset.getSExtValue());
+    StoresByOffset[*Keys[Idx]].push_back(Idx);
+  }
+  auto &&FindIndexedPredecessor = [&](int Idx) -> Optional<int> {
+    if (!Keys[Idx])
+      return None;
+    const Value *Base;
+    Type *PtrTy;
+    int64_t Offset;
+    std::tie(Base, PtrTy, Offset) = *Keys[Idx];
+    int64_t Size = DL->getTypeStoreSize(
+        cast<PointerType>(PtrTy)->getElementType());
+    auto It = StoresByOffset.find(OffsetKey(Base, PtrTy, Offset - Size));
+    if (It == StoresByOffset.end())
+      return None;
+    // Pick the closest candidate, preferring the preceding one on ties.
+    const SmallVectorImpl<int> &Candidates = It->second;
+    auto After = llvm::lower_bound(Candidates, Idx);
+    if (After == Candidates.begin())
+      return *After;
+    int Before = *std::prev(After);
+    if (After == Candidates.end() || Idx - Before <= *After - Idx)
+      return Before;
+    return *After;
   };
-  // Do a quadratic search on all of the given stores in reverse order and find
-  // all of the pairs of stores that follow each other.
+
+  // Find, for each store, the closest store that it follows.
   for (int Idx = E - 1; Idx >= 0; --Idx) {
-    // If a store has multiple consecutive store candidates, search according
-    // to the sequence: Idx-1, Idx+1, Idx-2, Idx+2, ...
+    // The indexed predecessor is the closest one with the same base. The ones
+    // with other bases can only be proven consecutive with SCEV, so we still
+    // search for a closer one, in the sequence Idx-1, Idx+1, Idx-2, Idx+2, ...
     // This is because usually pairing with immediate succeeding or preceding
     // candidate create the best chance to find slp vectorization opportunity.
-    const int MaxLookDepth = std::max(E - Idx, Idx + 1);
+    int MaxLookDepth = std::max(E - Idx, Idx + 1);
+    Optional<int> Indexed = FindIndexedPredecessor(Idx);
+    if (Indexed &&
+        !isConsecutiveAccess(Stores[*Indexed], Stores[Idx], *DL, *SE))
+      Indexed = None;
+    int Depth = Indexed ? std::abs(*Indexed - Idx) : MaxLookDepth;
+
     IterCnt = 0;
-    for (int Offset = 1, F = MaxLookDepth; Offset < F; ++Offset)
-      if ((Idx >= Offset && FindConsecutiveAccess(Idx - Offset, Idx)) ||
-          (Idx + Offset < E && FindConsecutiveAccess(Idx + Offset, Idx)))
-        break;
+    int Pred = -1;
+    for (int Offset = 1; Offset < Depth && Pred < 0 && IterCnt < MaxIter;
+         ++Offset) {
+      if (Idx >= Offset && IsConsecutiveAccess(Idx - Offset, Idx))
+        Pred = Idx - Offset;
+      else if (Idx + Offset < E && IterCnt < MaxIter &&
+               IsConsecutiveAccess(Idx + Offset, Idx))
+        Pred = Idx + Offset;
+    }
+    if (Pred < 0 && Indexed) {
+      Pred = *Indexed;
+      if (*Indexed > Idx && Idx >= Depth && IterCnt < MaxIter &&
+          IsConsecutiveAccess(Idx - Depth, Idx))
+        Pred = Idx - Depth;
+    }
+    if (Pred < 0)
+      continue;
+
+    Tails.set(Idx);
+    ConsecutiveChain[Pred] = Idx;
   }
 
   // For stores that start but don't end a link in the chain:
@@ -0,0 +1,91 @@
+; Test that an access fully checked by an earlier access to the same base
+; pointer in the same basic block is not instrumented again.
+; RUN: opt < %s -asan -enable-new-pm=0 -asan-instrumentation-with-call-threshold=0 -S \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,ON
+; RUN: opt < %s -passes='require<asan-globals-md>,function(asan)' -asan-instrumentation-with-call-threshold=0 -S \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,ON
+; RUN: opt < %s -asan -enable-new-pm=0 -asan-instrumentation-with-call-threshold=0 -asan-opt-same-base=0 -S \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,OFF
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @g()
+
+; The 8-byte load checks the bytes of the 4-byte load that follows it.
+define i32 @covered(i8* %p) sanitize_address {
+; CHECK-LABEL: @covered
+; CHECK:       call void @__asan_load8
+; OFF:         call void @__asan_load4
+; ON-NOT:      call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %p64 = bitcast i8* %p to i64*
+  %a = load i64, i64* %p64, align 8
+  %q = getelementptr i8, i8* %p, i64 4
+  %q32 = bitcast i8* %q to i32*
+  %b = load i32, i32* %q32, align 4
+  ret i32 %b
+}
+
+; Neighbouring fields don't cover each other.
+define i32 @uncovered(i8* %p) sanitize_address {
+; CHECK-LABEL: @uncovered
+; CHECK:       call void @__asan_load4
+; CHECK:       call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %p32 = bitcast i8* %p to i32*
+  %a = load i32, i32* %p32, align 4
+  %q = getelementptr i8, i8* %p, i64 4
+  %q32 = bitcast i8* %q to i32*
+  %b = load i32, i32* %q32, align 4
+  ret i32 %b
+}
+
+; A misaligned access only gets its first and last bytes checked, so it
+; covers nothing.
+define i32 @misaligned(i8* %p) sanitize_address {
+; CHECK-LABEL: @misaligned
+; CHECK:       call void @__asan_loadN
+; CHECK:       call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %p64 = bitcast i8* %p to i64*
+  %a = load i64, i64* %p64, align 4
+  %q = getelementptr i8, i8* %p, i64 4
+  %q32 = bitcast i8* %q to i32*
+  %b = load i32, i32* %q32, align 4
+  ret i32 %b
+}
+
+; An access that extends past a checked range is instrumented.
+define i64 @partial(i8* %p) sanitize_address {
+; CHECK-LABEL: @partial
+; CHECK:       call void @__asan_load4
+; CHECK:       call void @__asan_load8
+; CHECK:       ret i64
+entry:
+  %p32 = bitcast i8* %p to i32*
+  %a = load i32, i32* %p32, align 4
+  %p64 = bitcast i8* %p to i64*
+  %b = load i64, i64* %p64, align 8
+  ret i64 %b
+}
+
+; A call may free the object, so the ranges checked before it are forgotten.
+define i32 @call_between(i8* %p) sanitize_address {
+; CHECK-LABEL: @call_between
+; CHECK:       call void @__asan_load8
+; CHECK:       call void @g()
+; CHECK:       call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %p64 = bitcast i8* %p to i64*
+  %a = load i64, i64* %p64, align 8
+  call void @g()
+  %q = getelementptr i8, i8* %p, i64 4
+  %q32 = bitcast i8* %q to i32*
+  %b = load i32, i32* %q32, align 4
+  ret i32 %b
+}
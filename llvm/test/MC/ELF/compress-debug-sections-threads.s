@@ -0,0 +1,49 @@
+// REQUIRES: zlib
+
+// Compressing debug sections on several threads produces the same object as
+// compressing them serially, with either compression style.
+
+// RUN: llvm-mc -filetype=obj -compress-debug-sections=zlib -triple x86_64-pc-linux-gnu %s -o %t.1.o
+// RUN: llvm-mc -filetype=obj -compress-debug-sections=zlib -compress-debug-sections-threads=2 -triple x86_64-pc-linux-gnu %s -o %t.2.o
+// RUN: llvm-mc -filetype=obj -compress-debug-sections=zlib -compress-debug-sections-threads=0 -triple x86_64-pc-linux-gnu %s -o %t.0.o
+// RUN: cmp %t.1.o %t.2.o
+// RUN: cmp %t.1.o %t.0.o
+// RUN: llvm-readelf -S %t.2.o | FileCheck %s --check-prefix=ZLIB
+
+// RUN: llvm-mc -filetype=obj -compress-debug-sections=zlib-gnu -triple x86_64-pc-linux-gnu %s -o %t.gnu.1.o
+// RUN: llvm-mc -filetype=obj -compress-debug-sections=zlib-gnu -compress-debug-sections-threads=2 -triple x86_64-pc-linux-gnu %s -o %t.gnu.2.o
+// RUN: cmp %t.gnu.1.o %t.gnu.2.o
+// RUN: llvm-readelf -S %t.gnu.2.o | FileCheck %s --check-prefix=GNU
+
+// ZLIB: .debug_str  PROGBITS {{.*}} MSC
+// ZLIB: .debug_info PROGBITS {{.*}}  C
+// ZLIB: .debug_abbrev PROGBITS {{.*}}  C
+// ZLIB: .debug_frame PROGBITS
+// ZLIB-NOT: .zdebug_
+
+// GNU: .zdebug_str
+// GNU: .zdebug_info
+// GNU: .zdebug_abbrev
+// GNU: .debug_frame
+
+	.section	.debug_str,"MS",@progbits,1
+.Linfo_string0:
+	.asciz	"perfectly compressable data sample *****************************************"
+.Linfo_string1:
+	.asciz	"another perfectly compressable data sample *********************************"
+
+	.section	.debug_info,"",@progbits
+	.rept 32
+	.long	.Linfo_string0
+	.long	.Linfo_string1
+	.long	0
+	.long	0
+	.endr
+
+	.section	.debug_abbrev,"",@progbits
+	.rept 64
+	.byte	0
+	.endr
+
+	.section	.debug_frame,"",@progbits
+	.long	0
@@ -1002,6 +1002,8 @@ static int performOperation(ArchiveOperation Operation,
     fail("unable to open '" + ArchiveName + "': " + EC.message());
 
   if (!EC) {
+    // Every operation walks the members in order.
+    Buf.get()->adviseIfMmap(MemoryBuffer::AccessSequential);
     Error Err = Error::success();
     object::Archive Archive(Buf.get()->getMemBufferRef(), Err);
     failIfError(std::move(Err), "unable to load '" + ArchiveName + "'");
@@ -243,6 +243,12 @@ static opt<bool> Verify("verify", desc("Verify the DWARF debug info."),
                         cat(DwarfDumpCategory));
 static opt<bool> Quiet("quiet", desc("Use with -verify to not emit to STDOUT."),
                        cat(DwarfDumpCategory));
+static opt<unsigned>
+    NumThreads("num-threads",
+               desc("Number of threads used to parse the debug info with "
+                    "-verify or -statistics. 0 means one per hardware "
+                    "thread."),
+               cat(DwarfDumpCategory), init(1), value_desc("N"));
 static opt<bool> DumpUUID("uuid", desc("Show the UUID for each architecture."),
                           cat(DwarfDumpCategory));
 static alias DumpUUIDAlias("u", desc("Alias for -uuid."), aliasopt(DumpUUID));
@@ -673,13 +679,28 @@ int main(int argc, char **argv) {
     llvm::append_range(Objects, Objs);
   }
 
+  // Verification and statistics visit every DIE, so parse all the units up
+  // front when more than one thread is available.
+  auto ExtractingUnitDIEs = [](HandlerFn HandleObj) -> HandlerFn {
+    if (NumThreads == 1)
+      return HandleObj;
+    return [HandleObj](ObjectFile &Obj, DWARFContext &DICtx,
+                       const Twine &Filename, raw_ostream &OS) {
+      DICtx.extractAllUnitDIEs(NumThreads);
+      return HandleObj(Obj, DICtx, Filename, OS);
+    };
+  };
+
   bool Success = true;
   if (Verify) {
     for (auto Object : Objects)
-      Success &= handleFile(Object, verifyObjectFile, OutputFile.os());
+      Success &= handleFile(Object, ExtractingUnitDIEs(verifyObjectFile),
+                            OutputFile.os());
   } else if (Statistics) {
     for (auto Object : Objects)
-      Success &= handleFile(Object, collectStatsForObjectFile, OutputFile.os());
+      Success &= handleFile(Object,
+                            ExtractingUnitDIEs(collectStatsForObjectFile),
+                            OutputFile.os());
   } else if (ShowSectionSizes) {
     for (auto Object : Objects)
       Success &= handleFile(Object, collectObjectSectionSizes, OutputFile.os());
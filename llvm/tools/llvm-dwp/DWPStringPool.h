@@ -4,6 +4,8 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSection.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/StringSaver.h"
 #include <cassert>
 
 namespace llvm {
@@ -33,6 +35,8 @@ class DWPStringPool {
   MCStreamer &Out;
   MCSection *Sec;
   DenseMap<const char *, uint32_t, CStrDenseMapInfo> Pool;
+  BumpPtrAllocator Alloc;
+  StringSaver Saver{Alloc};
   uint32_t Offset = 0;
 
 public:
@@ -41,14 +45,19 @@ public:
   uint32_t getOffset(const char *Str, unsigned Length) {
     assert(strlen(Str) + 1 == Length && "Ensure length hint is correct");
 
-    auto Pair = Pool.insert(std::make_pair(Str, Offset));
-    if (Pair.second) {
-      Out.SwitchSection(Sec);
-      Out.emitBytes(StringRef(Str, Length));
-      Offset += Length;
-    }
+    auto I = Pool.find(Str);
+    if (I != Pool.end())
+      return I->second;
 
-    return Pair.first->second;
+    // Key the pool with a copy of the string, so that the input it came from
+    // can be released.
+    const char *Key = Saver.save(StringRef(Str, Length - 1)).data();
+    Pool.insert(std::make_pair(Key, Offset));
+    Out.SwitchSection(Sec);
+    Out.emitBytes(StringRef(Key, Length));
+    uint32_t StrOffset = Offset;
+    Offset += Length;
+    return StrOffset;
   }
 };
 }
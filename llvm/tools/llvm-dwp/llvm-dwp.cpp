@@ -561,18 +561,16 @@ static Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
+  // Each input, and the sections decompressed from it, is released once its
+  // contents have been emitted: the string pool keeps its own copy of the
+  // strings, so memory use does not grow with the total size of the inputs.
   for (const auto &Input : Inputs) {
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj)
       return ErrOrObj.takeError();
 
     auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    std::deque<SmallString<32>> UncompressedSections;
 
     UnitIndexEntry CurEntry = {};
 
@@ -9,10 +9,13 @@
 #include "Analysis.h"
 #include "BenchmarkResult.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCTargetOptions.h"
 #include "llvm/Support/FormatVariadic.h"
+#include <cmath>
 #include <limits>
+#include <set>
 #include <unordered_set>
 #include <vector>
 
@@ -244,6 +247,28 @@ Analysis::makePointsPerSchedClass() const {
   return Entries;
 }
 
+std::vector<Analysis::SchedClassCluster> Analysis::makeSchedClassClusters(
+    const ResolvedSchedClassAndPoints &RSCAndPoints) const {
+  std::vector<SchedClassCluster> SchedClassClusters;
+  for (const size_t PointId : RSCAndPoints.PointIds) {
+    const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
+    if (!ClusterId.isValid())
+      continue; // Ignore noise and errors. FIXME: take noise into account ?
+    if (ClusterId.isUnstable() ^ AnalysisDisplayUnstableOpcodes_)
+      continue; // Either display stable or unstable clusters only.
+    auto SchedClassClusterIt = llvm::find_if(
+        SchedClassClusters, [ClusterId](const SchedClassCluster &C) {
+          return C.id() == ClusterId;
+        });
+    if (SchedClassClusterIt == SchedClassClusters.end()) {
+      SchedClassClusters.emplace_back();
+      SchedClassClusterIt = std::prev(SchedClassClusters.end());
+    }
+    SchedClassClusterIt->addPoint(PointId, Clustering_);
+  }
+  return SchedClassClusters;
+}
+
 // Parallel benchmarks repeat the same opcode multiple times. Just show this
 // opcode and show the whole snippet only on hover.
 static void writeParallelSnippetHtml(raw_ostream &OS,
@@ -547,24 +572,8 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   for (const auto &RSCAndPoints : makePointsPerSchedClass()) {
     if (!RSCAndPoints.RSC.SCDesc)
       continue;
-    // Bucket sched class points into sched class clusters.
-    std::vector<SchedClassCluster> SchedClassClusters;
-    for (const size_t PointId : RSCAndPoints.PointIds) {
-      const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
-      if (!ClusterId.isValid())
-        continue; // Ignore noise and errors. FIXME: take noise into account ?
-      if (ClusterId.isUnstable() ^ AnalysisDisplayUnstableOpcodes_)
-        continue; // Either display stable or unstable clusters only.
-      auto SchedClassClusterIt = llvm::find_if(
-          SchedClassClusters, [ClusterId](const SchedClassCluster &C) {
-            return C.id() == ClusterId;
-          });
-      if (SchedClassClusterIt == SchedClassClusters.end()) {
-        SchedClassClusters.emplace_back();
-        SchedClassClusterIt = std::prev(SchedClassClusters.end());
-      }
-      SchedClassClusterIt->addPoint(PointId, Clustering_);
-    }
+    const std::vector<SchedClassCluster> SchedClassClusters =
+        makeSchedClassClusters(RSCAndPoints);
 
     // Print any scheduling class that has at least one cluster that does not
     // match the checked-in data.
@@ -598,5 +607,99 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   return Error::success();
 }
 
+void Analysis::printSchedClassOverride(const SchedClassCluster &Cluster,
+                                       const ResolvedSchedClass &RSC,
+                                       raw_ostream &OS) const {
+  const auto &Points = Clustering_.getPoints();
+  const InstructionBenchmark::ModeE Mode = Points[0].Mode;
+  const std::vector<BenchmarkMeasure> Measured =
+      Cluster.getCentroid().getAsPoint();
+
+  // Only latency and micro-op counts map to a SchedWriteRes field. Resource
+  // pressure is left in the comment below, since it does not say which
+  // resources the instructions actually use. Without a field to set there is
+  // nothing to propose.
+  std::vector<std::string> Fields;
+  for (const BenchmarkMeasure &M : Measured) {
+    const long Rounded = std::max(0L, std::lround(M.PerInstructionValue));
+    if (Mode == InstructionBenchmark::Latency)
+      Fields.push_back(formatv("Latency = {0}", Rounded).str());
+    else if (Mode == InstructionBenchmark::Uops && M.Key == "NumMicroOps")
+      Fields.push_back(formatv("NumMicroOps = {0}", Rounded).str());
+  }
+  if (Fields.empty())
+    return;
+
+  const std::vector<BenchmarkMeasure> Modeled =
+      RSC.getAsPoint(Mode, *SubtargetInfo_, Cluster.getCentroid().getStats());
+
+  OS << "// Sched class ";
+#if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
+  OS << RSC.SCDesc->Name;
+#else
+  OS << RSC.SchedClassId;
+#endif
+  OS << ", cluster " << Cluster.id().getId() << ":\n";
+  for (size_t I = 0, E = Measured.size(); I < E; ++I) {
+    OS << "//   " << Measured[I].Key << ": measured ";
+    writeMeasurementValue<kEscapeCsv>(OS, Measured[I].PerInstructionValue);
+    if (I < Modeled.size()) {
+      OS << ", model ";
+      writeMeasurementValue<kEscapeCsv>(OS, Modeled[I].PerInstructionValue);
+    }
+    OS << "\n";
+  }
+
+  const std::string WriteName = formatv("ExegesisWriteSC{0}_C{1}",
+                                        RSC.SchedClassId, Cluster.id().getId());
+  OS << "def " << WriteName << " : SchedWriteRes<[]> {\n";
+  for (const std::string &Field : Fields)
+    OS << "  let " << Field << ";\n";
+  OS << "}\n";
+
+  std::set<StringRef> Opcodes;
+  for (const size_t PointId : Cluster.getPointIds())
+    Opcodes.insert(
+        InstrInfo_->getName(Points[PointId].keyInstruction().getOpcode()));
+  OS << "def : InstRW<[" << WriteName << "], (instrs";
+  ListSeparator LS(",");
+  for (StringRef Opcode : Opcodes)
+    OS << LS << "\n  " << Opcode;
+  OS << ")>;\n\n";
+}
+
+template <>
+Error Analysis::run<Analysis::PrintSchedClassOverrides>(
+    raw_ostream &OS) const {
+  const auto &FirstPoint = Clustering_.getPoints()[0];
+  OS << "// Scheduling model overrides proposed by llvm-exegesis for "
+     << FirstPoint.CpuName << " (" << FirstPoint.LLVMTriple << ").\n"
+     << "// Only the measured quantities are filled in: review them and add\n"
+     << "// the resources used before merging them into the model.\n\n";
+
+  // Inverse throughput depends on the resources an instruction uses, which
+  // exegesis does not measure, so it can't be turned into a SchedWriteRes.
+  if (FirstPoint.Mode == InstructionBenchmark::InverseThroughput) {
+    OS << "// Inverse throughput measurements do not map to a SchedWriteRes\n"
+       << "// field, so no overrides are proposed.\n";
+    return Error::success();
+  }
+
+  for (const auto &RSCAndPoints : makePointsPerSchedClass()) {
+    if (!RSCAndPoints.RSC.SCDesc)
+      continue;
+    for (const SchedClassCluster &Cluster :
+         makeSchedClassClusters(RSCAndPoints)) {
+      if (!Cluster.getCentroid().validate(FirstPoint.Mode) ||
+          Cluster.measurementsMatch(*SubtargetInfo_, RSCAndPoints.RSC,
+                                    Clustering_,
+                                    AnalysisInconsistencyEpsilonSquared_))
+        continue;
+      printSchedClassOverride(Cluster, RSCAndPoints.RSC, OS);
+    }
+  }
+  return Error::success();
+}
+
 } // namespace exegesis
 } // namespace llvm
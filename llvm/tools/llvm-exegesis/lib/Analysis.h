@@ -45,6 +45,8 @@ public:
   struct PrintClusters {};
   // Find potential errors in the scheduling information given measurements.
   struct PrintSchedClassInconsistencies {};
+  // Propose TableGen scheduling overrides for the inconsistent sched classes.
+  struct PrintSchedClassOverrides {};
 
   template <typename Pass> Error run(raw_ostream &OS) const;
 
@@ -106,6 +108,14 @@ private:
   // Builds a list of ResolvedSchedClassAndPoints.
   std::vector<ResolvedSchedClassAndPoints> makePointsPerSchedClass() const;
 
+  // Buckets the displayed points of a sched class into sched class clusters.
+  std::vector<SchedClassCluster>
+  makeSchedClassClusters(const ResolvedSchedClassAndPoints &RSCAndPoints) const;
+
+  void printSchedClassOverride(const SchedClassCluster &Cluster,
+                               const ResolvedSchedClass &RSC,
+                               raw_ostream &OS) const;
+
   template <typename EscapeTag, EscapeTag Tag>
   void writeSnippet(raw_ostream &OS, ArrayRef<uint8_t> Bytes,
                     const char *Separator) const;
@@ -159,6 +159,11 @@ static cl::opt<std::string>
     AnalysisInconsistenciesOutputFile("analysis-inconsistencies-output-file",
                                       cl::desc(""), cl::cat(AnalysisOptions),
                                       cl::init(""));
+static cl::opt<std::string> AnalysisSchedOverridesOutputFile(
+    "analysis-sched-overrides-output-file",
+    cl::desc("write TableGen SchedWriteRes/InstRW proposals for the sched "
+             "classes whose measurements do not match the model"),
+    cl::cat(AnalysisOptions), cl::init(""));
 
 static cl::opt<bool> AnalysisDisplayUnstableOpcodes(
     "analysis-display-unstable-clusters",
@@ -396,10 +401,12 @@ static void analysisMain() {
     ExitWithError("--benchmarks-file must be set");
 
   if (AnalysisClustersOutputFile.empty() &&
-      AnalysisInconsistenciesOutputFile.empty()) {
+      AnalysisInconsistenciesOutputFile.empty() &&
+      AnalysisSchedOverridesOutputFile.empty()) {
     ExitWithError(
-        "for --mode=analysis: At least one of --analysis-clusters-output-file "
-        "and --analysis-inconsistencies-output-file must be specified");
+        "for --mode=analysis: At least one of --analysis-clusters-output-file, "
+        "--analysis-inconsistencies-output-file and "
+        "--analysis-sched-overrides-output-file must be specified");
   }
 
   InitializeNativeTarget();
@@ -443,6 +450,8 @@ static void analysisMain() {
   maybeRunAnalysis<Analysis::PrintSchedClassInconsistencies>(
       Analyzer, "sched class consistency analysis",
       AnalysisInconsistenciesOutputFile);
+  maybeRunAnalysis<Analysis::PrintSchedClassOverrides>(
+      Analyzer, "sched class overrides", AnalysisSchedOverridesOutputFile);
 }
 
 } // namespace exegesis
@@ -77,6 +77,12 @@ static cl::opt<bool>
 // to use all hardware threads or cores in the system.
 static cl::opt<std::string> Threads("thinlto-threads");
 
+static cl::opt<unsigned> ThinLTOMemoryBudget(
+    "thinlto-memory-budget",
+    cl::desc("Limit the estimated memory use of concurrent ThinLTO backends "
+             "to this many megabytes (0 means no limit)"),
+    cl::init(0));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -301,6 +307,7 @@ static int run(int argc, char **argv) {
   Conf.OverrideTriple = OverrideTriple;
   Conf.DefaultTriple = DefaultTriple;
   Conf.StatsFile = StatsFile;
+  Conf.ThinLTOMemoryBudget = uint64_t(ThinLTOMemoryBudget) << 20;
   Conf.PTO.LoopVectorization = Conf.OptLevel > 1;
   Conf.PTO.SLPVectorization = Conf.OptLevel > 1;
 
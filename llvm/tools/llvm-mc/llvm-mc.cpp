@@ -71,6 +71,11 @@ static cl::opt<DebugCompressionType> CompressDebugSections(
                clEnumValN(DebugCompressionType::GNU, "zlib-gnu",
                           "Use zlib-gnu compression (deprecated)")));
 
+static cl::opt<unsigned> CompressDebugSectionsThreads(
+    "compress-debug-sections-threads", cl::init(1),
+    cl::desc("Number of threads used to compress DWARF debug sections "
+             "(0 = all hardware threads)"));
+
 static cl::opt<bool>
 ShowInst("show-inst", cl::desc("Show internal instruction representation"));
 
@@ -371,6 +376,7 @@ int main(int argc, char **argv) {
       return 1;
     }
     MAI->setCompressDebugSections(CompressDebugSections);
+    MAI->setCompressDebugSectionsThreads(CompressDebugSectionsThreads);
   }
   MAI->setPreserveAsmComments(PreserveComments);
 
@@ -21,5 +21,12 @@ void PipelinePrinter::printReport(llvm::raw_ostream &OS) const {
   for (const auto &V : Views)
     V->printView(OutputKind, OS);
 }
+
+json::Object PipelinePrinter::getJSONReport() const {
+  json::Object JO;
+  for (const auto &V : Views)
+    JO.try_emplace(V->getNameAsString().str(), V->toJSON());
+  return JO;
+}
 } // namespace mca.
 } // namespace llvm
@@ -48,6 +48,9 @@ public:
   }
 
   void printReport(llvm::raw_ostream &OS) const;
+
+  /// Returns the JSON output of every view, keyed by view name.
+  json::Object getJSONReport() const;
 };
 } // namespace mca
 } // namespace llvm
@@ -632,6 +632,41 @@ void BottleneckAnalysis::printBottleneckHints(raw_ostream &OS) const {
      << "% ]\n";
 }
 
+json::Value BottleneckAnalysis::toJSON() const {
+  // Name the kind of pressure that increased backpressure the most, so that
+  // regions can be grouped by bottleneck without looking at the numbers.
+  StringRef Bottleneck = "None";
+  if (SeenStallCycles && BPI.PressureIncreaseCycles) {
+    unsigned MaxCycles = BPI.ResourcePressureCycles;
+    Bottleneck = "Resources";
+    if (BPI.RegisterDependencyCycles > MaxCycles) {
+      MaxCycles = BPI.RegisterDependencyCycles;
+      Bottleneck = "RegisterDependencies";
+    }
+    if (BPI.MemoryDependencyCycles > MaxCycles)
+      Bottleneck = "MemoryDependencies";
+  }
+
+  json::Array Resources;
+  const MCSchedModel &SM = getSubTargetInfo().getSchedModel();
+  ArrayRef<unsigned> Distribution = Tracker.getResourcePressureDistribution();
+  for (unsigned I = 0, E = Distribution.size(); I < E; ++I) {
+    if (Distribution[I])
+      Resources.push_back(json::Object({{"Name", SM.getProcResource(I)->Name},
+                                        {"Cycles", Distribution[I]}}));
+  }
+
+  json::Object JO({{"Bottleneck", Bottleneck},
+                   {"TotalCycles", TotalCycles},
+                   {"PressureIncreaseCycles", BPI.PressureIncreaseCycles},
+                   {"ResourcePressureCycles", BPI.ResourcePressureCycles},
+                   {"DataDependencyCycles", BPI.DataDependencyCycles},
+                   {"RegisterDependencyCycles", BPI.RegisterDependencyCycles},
+                   {"MemoryDependencyCycles", BPI.MemoryDependencyCycles},
+                   {"ResourcePressure", std::move(Resources)}});
+  return JO;
+}
+
 void BottleneckAnalysis::printView(raw_ostream &OS) const {
   std::string Buffer;
   raw_string_ostream TempStream(Buffer);
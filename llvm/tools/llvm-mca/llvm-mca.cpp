@@ -457,6 +457,9 @@ int main(int argc, char **argv) {
       *STI, *MRI, mc::InitMCTargetOptionsFromFlags()));
   assert(MAB && "Unable to create asm backend!");
 
+  // With -json, the reports of all the regions make up a single document.
+  json::Array JSONRegions;
+
   for (const std::unique_ptr<mca::CodeRegion> &Region : Regions) {
     // Skip empty code regions.
     if (Region->empty())
@@ -464,7 +467,8 @@ int main(int argc, char **argv) {
 
     // Don't print the header of this region if it is the default region, and
     // it doesn't have an end location.
-    if (Region->startLoc().isValid() || Region->endLoc().isValid()) {
+    if (!PrintJson &&
+        (Region->startLoc().isValid() || Region->endLoc().isValid())) {
       TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
       StringRef Desc = Region->getDescription();
       if (!Desc.empty())
@@ -507,9 +511,13 @@ int main(int argc, char **argv) {
       auto P = std::make_unique<mca::Pipeline>();
       P->appendStage(std::make_unique<mca::EntryStage>(S));
       P->appendStage(std::make_unique<mca::InstructionTables>(SM));
-      mca::PipelinePrinter Printer(*P, mca::View::OK_READABLE);
+      mca::PipelinePrinter Printer(*P, PrintJson ? mca::View::OK_JSON
+                                                 : mca::View::OK_READABLE);
 
       // Create the views for this pipeline, execute, and emit a report.
+      if (PrintJson)
+        Printer.addView(
+            std::make_unique<mca::InstructionView>(*STI, *IP, Insts, MCPU));
       if (PrintInstructionInfoView) {
         Printer.addView(std::make_unique<mca::InstructionInfoView>(
             *STI, *MCII, CE, ShowEncoding, Insts, *IP));
@@ -520,7 +528,13 @@ int main(int argc, char **argv) {
       if (!runPipeline(*P))
         return 1;
 
-      Printer.printReport(TOF->os());
+      if (PrintJson) {
+        json::Object JO = Printer.getJSONReport();
+        JO.try_emplace("Name", Region->getDescription());
+        JSONRegions.push_back(std::move(JO));
+      } else {
+        Printer.printReport(TOF->os());
+      }
       continue;
     }
 
@@ -580,12 +594,23 @@ int main(int argc, char **argv) {
     if (!runPipeline(*P))
       return 1;
 
-    Printer.printReport(TOF->os());
+    if (PrintJson) {
+      json::Object JO = Printer.getJSONReport();
+      JO.try_emplace("Name", Region->getDescription());
+      JSONRegions.push_back(std::move(JO));
+    } else {
+      Printer.printReport(TOF->os());
+    }
 
     // Clear the InstrBuilder internal state in preparation for another round.
     IB.clear();
   }
 
+  if (PrintJson)
+    TOF->os() << formatv("{0:2}", json::Value(json::Object(
+                                      {{"CodeRegions", std::move(JSONRegions)}})))
+              << "\n";
+
   TOF->keep();
   return 0;
 }
@@ -11,6 +11,7 @@
 #include "Object.h"
 #include "llvm-objcopy.h"
 #include "llvm/ADT/BitmaskEnum.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
@@ -32,6 +33,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -474,15 +476,35 @@ static Error replaceAndRemoveSections(const CopyConfig &Config, Object &Obj) {
   }
 
   if (Config.CompressionType != DebugCompressionType::None) {
-    if (Error Err = replaceDebugSections(
-            Obj, RemovePred, isCompressable,
-            [&Config, &Obj](const SectionBase *S) -> Expected<SectionBase *> {
+    // Compressing the data is by far the most expensive part of this and each
+    // debug section is independent, so do it up front in parallel. Adding the
+    // new sections to the object has to stay serial.
+    std::vector<std::pair<const SectionBase *, Optional<CompressedSection>>>
+        Compressed;
+    for (const SectionBase &Sec : Obj.sections())
+      if (isCompressable(Sec))
+        Compressed.emplace_back(&Sec, None);
+    if (Error Err = parallelForEachError(
+            Compressed, [&Config](auto &Entry) -> Error {
               Expected<CompressedSection> NewSection =
-                  CompressedSection::create(*S, Config.CompressionType);
+                  CompressedSection::create(*Entry.first,
+                                            Config.CompressionType);
               if (!NewSection)
                 return NewSection.takeError();
+              Entry.second.emplace(std::move(*NewSection));
+              return Error::success();
+            }))
+      return Err;
 
-              return &Obj.addSection<CompressedSection>(std::move(*NewSection));
+    DenseMap<const SectionBase *, CompressedSection *> CompressedFor;
+    for (auto &Entry : Compressed)
+      CompressedFor[Entry.first] = Entry.second.getPointer();
+
+    if (Error Err = replaceDebugSections(
+            Obj, RemovePred, isCompressable,
+            [&CompressedFor, &Obj](const SectionBase *S) {
+              return &Obj.addSection<CompressedSection>(
+                  std::move(*CompressedFor.lookup(S)));
             }))
       return Err;
   } else if (Config.DecompressDebugSections) {
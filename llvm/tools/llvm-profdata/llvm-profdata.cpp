@@ -285,6 +285,92 @@ static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
       WC->Errors.emplace_back(std::move(E), Filename);
 }
 
+/// Load an input, adding each function record to the writer context of the
+/// shard the hash of its name falls into. The shards partition the functions,
+/// so no function is held by more than one context, and merging the contexts
+/// afterwards only moves records around.
+static void loadInputSharded(const WeightedFile &Input,
+                             SymbolRemapper *Remapper,
+                             ArrayRef<std::unique_ptr<WriterContext>> Shards) {
+  std::string Filename = Input.Filename;
+  WriterContext *ErrWC = Shards[0].get();
+
+  auto ReaderOrErr = InstrProfReader::create(Input.Filename);
+  if (Error E = ReaderOrErr.takeError()) {
+    // Skip the empty profiles by returning sliently.
+    instrprof_error IPE = InstrProfError::take(std::move(E));
+    if (IPE != instrprof_error::empty_raw_profile) {
+      std::unique_lock<std::mutex> CtxGuard{ErrWC->Lock};
+      ErrWC->Errors.emplace_back(make_error<InstrProfError>(IPE), Filename);
+    }
+    return;
+  }
+
+  // Every input goes through the first shard first, so all the shards agree
+  // on the kind of the profile.
+  auto Reader = std::move(ReaderOrErr.get());
+  for (const std::unique_ptr<WriterContext> &WC : Shards) {
+    std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+    if (WC->Writer.setIsIRLevelProfile(Reader->isIRLevelProfile(),
+                                       Reader->hasCSIRLevelProfile())) {
+      CtxGuard.unlock();
+      std::unique_lock<std::mutex> ErrGuard{ErrWC->Lock};
+      ErrWC->Errors.emplace_back(
+          make_error<StringError>(
+              "Merge IR generated profile with Clang generated profile.",
+              std::error_code()),
+          Filename);
+      return;
+    }
+    WC->Writer.setInstrEntryBBEnabled(Reader->instrEntryBBEnabled());
+  }
+
+  // Buffer the records of each shard, to take its lock once per batch rather
+  // than once per function.
+  const size_t BatchSize = 256;
+  std::vector<std::vector<NamedInstrProfRecord>> Pending(Shards.size());
+  auto Flush = [&](unsigned Shard) {
+    WriterContext *WC = Shards[Shard].get();
+    std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+    for (NamedInstrProfRecord &I : Pending[Shard]) {
+      const StringRef FuncName = I.Name;
+      bool Reported = false;
+      WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
+        if (Reported) {
+          consumeError(std::move(E));
+          return;
+        }
+        Reported = true;
+        // Only show hint the first time an error occurs.
+        instrprof_error IPE = InstrProfError::take(std::move(E));
+        std::unique_lock<std::mutex> ErrGuard{WC->ErrLock};
+        bool firstTime = WC->WriterErrorCodes.insert(IPE).second;
+        handleMergeWriterError(make_error<InstrProfError>(IPE), Filename,
+                               FuncName, firstTime);
+      });
+    }
+    Pending[Shard].clear();
+  };
+
+  for (auto &I : *Reader) {
+    if (Remapper)
+      I.Name = (*Remapper)(I.Name);
+    unsigned Shard = IndexedInstrProf::ComputeHash(I.Name) % Shards.size();
+    Pending[Shard].push_back(std::move(I));
+    if (Pending[Shard].size() >= BatchSize)
+      Flush(Shard);
+  }
+  for (unsigned Shard = 0; Shard < Shards.size(); ++Shard)
+    if (!Pending[Shard].empty())
+      Flush(Shard);
+
+  if (Reader->hasError())
+    if (Error E = Reader->getError()) {
+      std::unique_lock<std::mutex> CtxGuard{ErrWC->Lock};
+      ErrWC->Errors.emplace_back(std::move(E), Filename);
+    }
+}
+
 /// Merge the \p Src writer context into \p Dst.
 static void mergeWriterContexts(WriterContext *Dst, WriterContext *Src) {
   for (auto &ErrorPair : Src->Errors)
@@ -354,31 +440,16 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   } else {
     ThreadPool Pool(hardware_concurrency(NumThreads));
 
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
-    for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
-    }
+    // Load the inputs in parallel, each context holding the functions of one
+    // hash shard, so that memory use doesn't grow with the number of threads.
+    for (const auto &Input : Inputs)
+      Pool.async(loadInputSharded, Input, Remapper,
+                 ArrayRef<std::unique_ptr<WriterContext>>(Contexts));
     Pool.wait();
 
-    // Merge the writer contexts together (~ lg(NumThreads) serial steps).
-    unsigned Mid = Contexts.size() / 2;
-    unsigned End = Contexts.size();
-    assert(Mid > 0 && "Expected more than one context");
-    do {
-      for (unsigned I = 0; I < Mid; ++I)
-        Pool.async(mergeWriterContexts, Contexts[I].get(),
-                   Contexts[I + Mid].get());
-      Pool.wait();
-      if (End & 1) {
-        Pool.async(mergeWriterContexts, Contexts[0].get(),
-                   Contexts[End - 1].get());
-        Pool.wait();
-      }
-      End = Mid;
-      Mid /= 2;
-    } while (Mid > 0);
+    // The shards are disjoint, so merging them just collects their records.
+    for (unsigned I = 1; I < NumThreads; ++I)
+      mergeWriterContexts(Contexts[0].get(), Contexts[I].get());
   }
 
   // Handle deferred errors encountered during merging. If the number of errors
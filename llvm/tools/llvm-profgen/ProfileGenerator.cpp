@@ -187,6 +187,44 @@ void ProfileGenerator::findDisjointRanges(RangeSample &DisjointRanges,
   }
 }
 
+void writeSymbolOrderingFile(const BinarySampleCounterMap &BinarySampleCounters,
+                             StringRef Filename) {
+  // Weight each function by the number of bytes of code executed in it, as
+  // counted by the LBR ranges of all the contexts.
+  StringMap<uint64_t> FuncHotness;
+  for (const auto &BI : BinarySampleCounters) {
+    ProfiledBinary *Binary = BI.first;
+    for (const auto &CI : BI.second) {
+      for (const auto &Range : CI.second.RangeCounter) {
+        uint64_t Begin = Range.first.first;
+        uint64_t End = Range.first.second;
+        StringRef FuncName = Binary->getFuncFromOffset(Begin);
+        if (FuncName.empty() || End < Begin)
+          continue;
+        FuncHotness[FuncName] += Range.second * (End - Begin + 1);
+      }
+    }
+  }
+
+  std::vector<std::pair<StringRef, uint64_t>> SortedFuncs;
+  SortedFuncs.reserve(FuncHotness.size());
+  for (const auto &Entry : FuncHotness)
+    SortedFuncs.emplace_back(Entry.first(), Entry.second);
+  llvm::sort(SortedFuncs, [](const std::pair<StringRef, uint64_t> &L,
+                             const std::pair<StringRef, uint64_t> &R) {
+    if (L.second != R.second)
+      return L.second > R.second;
+    return L.first < R.first;
+  });
+
+  std::error_code EC;
+  raw_fd_ostream OS(Filename, EC, sys::fs::OF_Text);
+  if (EC)
+    exitWithError(EC, Filename);
+  for (const auto &Func : SortedFuncs)
+    OS << Func.first << "\n";
+}
+
 FunctionSamples &
 CSProfileGenerator::getFunctionProfileForContext(StringRef ContextStr,
                                                  bool WasLeafInlined) {
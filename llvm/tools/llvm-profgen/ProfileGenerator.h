@@ -203,6 +203,12 @@ public:
   static int32_t MaxCompressionSize;
 };
 
+// Write the names of the functions sampled in \p BinarySampleCounters to
+// \p Filename, hottest first, one per line. The result can be passed to lld's
+// --symbol-ordering-file to lay out the hot functions of the binary together.
+void writeSymbolOrderingFile(const BinarySampleCounterMap &BinarySampleCounters,
+                             StringRef Filename);
+
 using ProbeCounterMap = std::unordered_map<const PseudoProbe *, uint64_t>;
 
 class PseudoProbeCSProfileGenerator : public CSProfileGenerator {
@@ -305,6 +305,7 @@ bool ProfiledBinary::dissassembleSymbol(std::size_t SI, ArrayRef<uint8_t> Bytes,
     outs() << "\n";
 
   FuncStartAddrMap[StartOffset] = Symbols[SI].Name.str();
+  FuncRanges[StartOffset] = EndOffset;
   return true;
 }
 
@@ -29,6 +29,7 @@
 #include "llvm/ProfileData/SampleProf.h"
 #include "llvm/Support/Path.h"
 #include <list>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
@@ -116,6 +117,9 @@ class ProfiledBinary {
   std::set<std::pair<uint64_t, uint64_t>> TextSections;
   // Function offset to name mapping.
   std::unordered_map<uint64_t, std::string> FuncStartAddrMap;
+  // Function start offset to end offset mapping, sorted by start offset. Used
+  // to find the function containing a given offset.
+  std::map<uint64_t, uint64_t> FuncRanges;
   // Offset to context location map. Used to expand the context.
   std::unordered_map<uint64_t, FrameLocationStack> Offset2LocStackMap;
   // An array of offsets of all instructions sorted in increasing order. The
@@ -226,6 +230,18 @@ public:
     return FuncStartAddrMap[Offset];
   }
 
+  // Get the name of the function containing the code at \p Offset, or an
+  // empty name if the offset is outside of any disassembled function.
+  StringRef getFuncFromOffset(uint64_t Offset) const {
+    auto I = FuncRanges.upper_bound(Offset);
+    if (I == FuncRanges.begin())
+      return StringRef();
+    --I;
+    if (Offset >= I->second)
+      return StringRef();
+    return FuncStartAddrMap.at(I->first);
+  }
+
   Optional<FrameLocation> getInlineLeafFrameLoc(uint64_t Offset) {
     const auto &Stack = getFrameLocationStack(Offset);
     if (Stack.empty())
@@ -29,6 +29,12 @@ static cl::list<std::string>
                     llvm::cl::MiscFlags::CommaSeparated,
                     cl::desc("Path of profiled binary files"));
 
+static cl::opt<std::string> SymbolOrderingFilename(
+    "symbol-ordering-output", cl::value_desc("filename"),
+    cl::desc("Also write the sampled functions, hottest first, to a symbol "
+             "ordering file that can be passed to lld with "
+             "--symbol-ordering-file"));
+
 extern cl::opt<bool> ShowDisassemblyOnly;
 
 using namespace llvm;
@@ -55,5 +61,9 @@ int main(int argc, const char *argv[]) {
   Generator->generateProfile();
   Generator->write();
 
+  if (!SymbolOrderingFilename.empty())
+    writeSymbolOrderingFile(Reader.getBinarySampleCounters(),
+                            SymbolOrderingFilename);
+
   return EXIT_SUCCESS;
 }
@@ -283,6 +283,8 @@ int main(int argc, char **argv) {
   } else {
     Opts.PathStyle = DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath;
   }
+  if (Args.hasArg(OPT_cache_size_EQ))
+    parseIntArg(Args, OPT_cache_size_EQ, Opts.MaxCacheSize);
   Opts.DebugFileDirectory = Args.getAllArgValues(OPT_debug_file_directory_EQ);
   Opts.DefaultArch = Args.getLastArgValue(OPT_default_arch_EQ).str();
   Opts.Demangle = Args.hasFlag(OPT_demangle, OPT_no_demangle, !IsAddr2Line);
@@ -339,11 +341,14 @@ int main(int argc, char **argv) {
       symbolizeInput(Args, AdjustVMA, IsAddr2Line, OutputStyle,
                      StrippedInputString, Symbolizer, Printer);
       outs().flush();
+      Symbolizer.pruneCache();
     }
   } else {
-    for (StringRef Address : InputAddresses)
+    for (StringRef Address : InputAddresses) {
       symbolizeInput(Args, AdjustVMA, IsAddr2Line, OutputStyle, Address,
                      Symbolizer, Printer);
+      Symbolizer.pruneCache();
+    }
   }
 
   return 0;
@@ -0,0 +1,221 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+static_assert(std::is_const<std::remove_pointer<
+                  FlatHashMap<int, int>::const_iterator::pointer>::type>::value,
+              "Iterator pointer type should be const");
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<int, int> Map;
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(0u, Map.size());
+  EXPECT_EQ(0u, Map.count(1));
+  EXPECT_TRUE(Map.find(1) == Map.end());
+  EXPECT_TRUE(Map.begin() == Map.end());
+  EXPECT_EQ(0, Map.lookup(1));
+  EXPECT_FALSE(Map.erase(1));
+  EXPECT_EQ(0u, Map.getMemorySize());
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<int, int> Map;
+  EXPECT_TRUE(Map.insert({1, 10}).second);
+  EXPECT_FALSE(Map.insert({1, 20}).second);
+  EXPECT_TRUE(Map.try_emplace(2, 30).second);
+  Map[3] = 40;
+  EXPECT_EQ(3u, Map.size());
+  EXPECT_EQ(10, Map.lookup(1));
+  EXPECT_EQ(30, Map.find(2)->second);
+  EXPECT_EQ(40, Map[3]);
+
+  EXPECT_TRUE(Map.erase(1));
+  EXPECT_FALSE(Map.erase(1));
+  Map.erase(Map.find(2));
+  EXPECT_EQ(1u, Map.size());
+  EXPECT_EQ(0u, Map.count(1));
+  EXPECT_EQ(0u, Map.count(2));
+  EXPECT_EQ(1u, Map.count(3));
+}
+
+// Keys that DenseMap reserves are usable.
+TEST(FlatHashMapTest, ReservedDenseMapKeys) {
+  FlatHashMap<unsigned, int> Map;
+  Map[DenseMapInfo<unsigned>::getEmptyKey()] = 1;
+  Map[DenseMapInfo<unsigned>::getTombstoneKey()] = 2;
+  EXPECT_EQ(1, Map.lookup(DenseMapInfo<unsigned>::getEmptyKey()));
+  EXPECT_EQ(2, Map.lookup(DenseMapInfo<unsigned>::getTombstoneKey()));
+}
+
+TEST(FlatHashMapTest, Grow) {
+  FlatHashMap<unsigned, unsigned> Map;
+  for (unsigned I = 0; I < 10000; ++I)
+    EXPECT_TRUE(Map.insert({I, I * 2}).second);
+  EXPECT_EQ(10000u, Map.size());
+  for (unsigned I = 0; I < 10000; ++I)
+    EXPECT_EQ(I * 2, Map.lookup(I));
+  EXPECT_EQ(0u, Map.count(10000));
+
+  std::vector<bool> Seen(10000);
+  for (const auto &KV : Map) {
+    EXPECT_FALSE(Seen[KV.first]);
+    Seen[KV.first] = true;
+  }
+  EXPECT_EQ(Seen, std::vector<bool>(10000, true));
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<int, int> Map(1000);
+  size_t MemorySize = Map.getMemorySize();
+  EXPECT_NE(0u, MemorySize);
+  for (int I = 0; I < 1000; ++I)
+    Map[I] = I;
+  EXPECT_EQ(MemorySize, Map.getMemorySize());
+}
+
+// Erasing and inserting many keys leaves many deleted slots behind, which must
+// not grow the table indefinitely or break lookups.
+TEST(FlatHashMapTest, Churn) {
+  FlatHashMap<int, int> Map;
+  for (int I = 0; I < 100; ++I)
+    Map[I] = I;
+  size_t MemorySize = Map.getMemorySize();
+  for (int I = 100; I < 100000; ++I) {
+    EXPECT_TRUE(Map.erase(I - 100));
+    Map[I] = I;
+  }
+  EXPECT_EQ(100u, Map.size());
+  EXPECT_LE(Map.getMemorySize(), 2 * MemorySize);
+  for (int I = 0; I < 100000 - 100; ++I)
+    EXPECT_EQ(0u, Map.count(I));
+  for (int I = 100000 - 100; I < 100000; ++I)
+    EXPECT_EQ(I, Map.lookup(I));
+}
+
+TEST(FlatHashMapTest, EraseWhileIterating) {
+  FlatHashMap<int, int> Map;
+  for (int I = 0; I < 100; ++I)
+    Map[I] = I;
+  for (auto It = Map.begin(), E = Map.end(); It != E;) {
+    auto Current = It++;
+    if (Current->first % 2)
+      Map.erase(Current);
+  }
+  EXPECT_EQ(50u, Map.size());
+  for (const auto &KV : Map)
+    EXPECT_EQ(0, KV.first % 2);
+}
+
+// Only hashing and comparison are needed, not empty or tombstone keys.
+struct StringInfo {
+  static unsigned getHashValue(const std::string &S) {
+    return DenseMapInfo<StringRef>::getHashValue(S);
+  }
+  static bool isEqual(const std::string &LHS, const std::string &RHS) {
+    return LHS == RHS;
+  }
+};
+
+TEST(FlatHashMapTest, CopyAndMove) {
+  using MapT = FlatHashMap<std::string, std::string, StringInfo>;
+  MapT Map;
+  for (int I = 0; I < 100; ++I)
+    Map[std::to_string(I)] = std::string(100, 'a' + I % 26);
+
+  MapT Copy(Map);
+  EXPECT_EQ(100u, Copy.size());
+  EXPECT_EQ(std::string(100, 'b'), Copy.lookup("1"));
+
+  MapT Moved(std::move(Map));
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_EQ(std::string(100, 'c'), Moved.lookup("2"));
+
+  Copy = Moved;
+  Moved.clear();
+  EXPECT_TRUE(Moved.empty());
+  EXPECT_EQ(0u, Moved.count("1"));
+  EXPECT_EQ(100u, Copy.size());
+  Moved = std::move(Copy);
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_EQ(std::string(100, 'd'), Moved.lookup("3"));
+}
+
+TEST(FlatHashMapTest, MoveOnlyValues) {
+  FlatHashMap<int, std::unique_ptr<int>> Map;
+  for (int I = 0; I < 100; ++I)
+    Map.try_emplace(I, std::make_unique<int>(I));
+  for (int I = 0; I < 100; ++I)
+    EXPECT_EQ(I, *Map.find(I)->second);
+}
+
+TEST(FlatHashMapTest, DestroysValues) {
+  auto Counter = std::make_shared<int>(0);
+  {
+    FlatHashMap<int, std::shared_ptr<int>> Map;
+    for (int I = 0; I < 100; ++I)
+      Map[I] = Counter;
+    EXPECT_EQ(101, Counter.use_count());
+    Map.erase(0);
+    EXPECT_EQ(100, Counter.use_count());
+    FlatHashMap<int, std::shared_ptr<int>> Copy(Map);
+    EXPECT_EQ(199, Counter.use_count());
+    Map.clear();
+    EXPECT_EQ(100, Counter.use_count());
+  }
+  EXPECT_EQ(1, Counter.use_count());
+}
+
+TEST(FlatHashMapTest, StringRefKeys) {
+  std::vector<std::string> Strings;
+  for (int I = 0; I < 1000; ++I)
+    Strings.push_back("key" + std::to_string(I));
+  FlatHashMap<StringRef, int> Map;
+  for (int I = 0; I < 1000; ++I)
+    Map[Strings[I]] = I;
+  for (int I = 0; I < 1000; ++I)
+    EXPECT_EQ(I, Map.lookup(std::string("key") + std::to_string(I)));
+  EXPECT_EQ(0u, Map.count("key1000"));
+}
+
+TEST(FlatHashSetTest, Basic) {
+  FlatHashSet<int> Set = {1, 2, 3};
+  EXPECT_EQ(3u, Set.size());
+  EXPECT_FALSE(Set.insert(2).second);
+  EXPECT_TRUE(Set.insert(4).second);
+  EXPECT_EQ(1u, Set.count(4));
+  EXPECT_TRUE(Set.erase(1));
+  EXPECT_EQ(0u, Set.count(1));
+
+  int Sum = 0;
+  for (int V : Set)
+    Sum += V;
+  EXPECT_EQ(9, Sum);
+}
+
+TEST(FlatHashSetTest, Pointers) {
+  std::vector<int> Storage(1000);
+  FlatHashSet<const int *> Set(Storage.size());
+  for (const int &I : Storage)
+    Set.insert(&I);
+  EXPECT_EQ(1000u, Set.size());
+  for (const int &I : Storage)
+    EXPECT_EQ(1u, Set.count(&I));
+  EXPECT_EQ(0u, Set.count(Storage.data() + Storage.size()));
+}
+
+} // namespace
@@ -0,0 +1,95 @@
+//===- ModuleMemoryUsageTest.cpp - ModuleMemoryUsage unit tests -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/ModuleMemoryUsage.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+namespace {
+
+TEST(ModuleMemoryUsageTest, Counts) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(R"IR(
+@g = global [2 x i32] [i32 1, i32 2]
+declare void @f(i32*)
+define i32 @add(i32 %a, i32 %b) {
+entry:
+  %sum = add i32 %a, %b
+  %twice = add i32 %sum, %sum
+  call void @f(i32* getelementptr ([2 x i32], [2 x i32]* @g, i64 0, i64 1))
+  ret i32 %twice
+}
+)IR",
+                                                  Err, C);
+  ASSERT_TRUE(M);
+
+  ModuleMemoryUsage Usage = ModuleMemoryUsage::compute(*M);
+  EXPECT_EQ(2u, Usage.Functions);
+  EXPECT_EQ(3u, Usage.Arguments);
+  EXPECT_EQ(1u, Usage.BasicBlocks);
+  EXPECT_EQ(1u, Usage.GlobalValues);
+  EXPECT_EQ(4u, Usage.Instructions);
+  EXPECT_EQ(2 * sizeof(BinaryOperator) + sizeof(CallInst) + sizeof(ReturnInst),
+            Usage.InstructionBytes);
+  // The initializer, the getelementptr and its two indices.
+  EXPECT_EQ(4u, Usage.Constants);
+  // The initializer of @g, 7 instruction operands and the 3 operands of the
+  // getelementptr.
+  EXPECT_EQ(11u, Usage.Uses);
+  EXPECT_EQ(11 * sizeof(Use), Usage.UseBytes);
+  EXPECT_LT(Usage.UseListBytes, Usage.UseBytes);
+  // g, f, add, a, b, entry, sum and twice.
+  EXPECT_EQ(8 * (sizeof(ValueName) + 1) + 20, Usage.NameBytes);
+  EXPECT_EQ(Usage.FunctionBytes + Usage.ArgumentBytes + Usage.BasicBlockBytes +
+                Usage.GlobalValueBytes + Usage.InstructionBytes +
+                Usage.ConstantBytes + Usage.UseBytes + Usage.NameBytes,
+            Usage.getTotalBytes());
+  EXPECT_EQ(0u, Usage.DILocations);
+}
+
+TEST(ModuleMemoryUsageTest, DebugLocations) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(R"IR(
+define void @f() !dbg !4 {
+  ret void, !dbg !9
+}
+define void @g() !dbg !6 {
+  call void @f(), !dbg !8
+  call void @f(), !dbg !8
+  ret void, !dbg !7
+}
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!2}
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1)
+!1 = !DIFile(filename: "a.c", directory: "/")
+!2 = !{i32 2, !"Debug Info Version", i32 3}
+!3 = !DISubroutineType(types: !{})
+!4 = distinct !DISubprogram(name: "f", scope: !1, file: !1, type: !3, unit: !0)
+!6 = distinct !DISubprogram(name: "g", scope: !1, file: !1, type: !3, unit: !0)
+!7 = !DILocation(line: 1, scope: !4, inlinedAt: !8)
+!8 = !DILocation(line: 2, scope: !6)
+!9 = !DILocation(line: 3, scope: !4)
+)IR",
+                                                  Err, C);
+  ASSERT_TRUE(M);
+
+  ModuleMemoryUsage Usage = ModuleMemoryUsage::compute(*M);
+  EXPECT_EQ(3u, Usage.DILocations);
+  EXPECT_EQ(3 * sizeof(DILocation) + 4 * sizeof(MDOperand),
+            Usage.DILocationBytes);
+}
+
+} // end anonymous namespace
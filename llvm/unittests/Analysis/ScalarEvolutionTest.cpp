@@ -22,11 +22,14 @@
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
 namespace llvm {
 
+extern cl::opt<unsigned> MaxRangeCacheEntries;
+
 // We use this fixture to ensure that we clean up ScalarEvolution before
 // deleting the PassManager.
 class ScalarEvolutionsTest : public testing::Test {
@@ -1421,4 +1424,51 @@ TEST_F(ScalarEvolutionsTest, MatchURem) {
   });
 }
 
+// Flushing the range caches to stay within budget must not change the ranges.
+TEST_F(ScalarEvolutionsTest, BoundedRangeCache) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(
+      "define void @test(i32 %n, i8 %x) { "
+      "entry: "
+      "  %x.ext = zext i8 %x to i32 "
+      "  br label %loop "
+      "loop: "
+      "  %iv = phi i32 [ 0, %entry ], [ %iv.next, %loop ] "
+      "  %iv.x = add nuw nsw i32 %iv, %x.ext "
+      "  %iv.sub = sub i32 %iv.x, 7 "
+      "  %iv.mul = mul i32 %iv.sub, 3 "
+      "  %iv.ashr = ashr i32 %iv.mul, 2 "
+      "  %iv.next = add nuw nsw i32 %iv, 1 "
+      "  %cmp = icmp ult i32 %iv.next, 100 "
+      "  br i1 %cmp, label %loop, label %exit "
+      "exit: "
+      "  ret void "
+      "} ",
+      Err, C);
+
+  ASSERT_TRUE(M && "Could not parse module?");
+  ASSERT_TRUE(!verifyModule(*M) && "Must have been well formed!");
+
+  auto ComputeRanges = [&]() {
+    std::vector<std::pair<ConstantRange, ConstantRange>> Ranges;
+    runWithSE(*M, "test", [&](Function &F, LoopInfo &LI, ScalarEvolution &SE) {
+      for (Instruction &I : instructions(F))
+        if (SE.isSCEVable(I.getType())) {
+          const SCEV *S = SE.getSCEV(&I);
+          Ranges.push_back({SE.getUnsignedRange(S), SE.getSignedRange(S)});
+        }
+    });
+    return Ranges;
+  };
+
+  auto Unbounded = ComputeRanges();
+  unsigned OldMaxRangeCacheEntries = MaxRangeCacheEntries;
+  for (unsigned Budget : {1, 2, 5}) {
+    MaxRangeCacheEntries = Budget;
+    EXPECT_TRUE(Unbounded == ComputeRanges()) << "Budget " << Budget;
+  }
+  MaxRangeCacheEntries = OldMaxRangeCacheEntries;
+}
+
 }  // end namespace llvm
@@ -0,0 +1,127 @@
+//===- InstructionSelectorTest.cpp ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "GISelMITest.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelector.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelectorImpl.h"
+#include "llvm/Support/CodeGenCoverage.h"
+
+namespace {
+
+// A selector running a hand-written match table, the way the tablegen-erated
+// selectors run theirs.
+class TestSelector : public InstructionSelector {
+public:
+  using PredicateBitset = PredicateBitsetImpl<1>;
+  using ComplexMatcherMemFn =
+      ComplexRendererFns (TestSelector::*)(MachineOperand &) const;
+  using CustomRendererFn = void (TestSelector::*)(MachineInstrBuilder &,
+                                                  const MachineInstr &,
+                                                  int) const;
+
+  TestSelector(const TargetSubtargetInfo &STI, const int64_t *MatchTable)
+      : STI(STI), MatchTable(MatchTable),
+        ISelInfo(nullptr, 0, nullptr, nullptr, nullptr) {}
+
+  static const char *getName() { return "test-selector"; }
+
+  void setupGeneratedPerFunctionState(MachineFunction &MF) override {}
+
+  bool select(MachineInstr &I) override {
+    MatcherState State(0);
+    State.MIs.push_back(&I);
+    NewMIVector OutMIs;
+    return executeMatchTable(*this, OutMIs, State, ISelInfo, MatchTable,
+                             *STI.getInstrInfo(), MF->getRegInfo(),
+                             *STI.getRegisterInfo(), *STI.getRegBankInfo(),
+                             PredicateBitset(), *CoverageInfo);
+  }
+
+private:
+  const TargetSubtargetInfo &STI;
+  const int64_t *MatchTable;
+  ISelInfoTy<PredicateBitset, ComplexMatcherMemFn, CustomRendererFn> ISelInfo;
+};
+
+TEST_F(AArch64GISelMITest, ProfileMatchTableRules) {
+  setUp();
+  if (!TM)
+    return;
+
+  // Two rules, like -instrument-gisel-profile emits them. Rule 0 only matches
+  // G_SUB and rule 1 matches G_ADD.
+  const int64_t MatchTable[] = {
+      GIM_Try, /*On fail goto*/ 8,
+        GIR_ProfileRule, 0,
+        GIM_CheckOpcode, /*MI*/ 0, TargetOpcode::G_SUB,
+        GIR_Done,
+      // Label 0: @8
+      GIM_Try, /*On fail goto*/ 16,
+        GIR_ProfileRule, 1,
+        GIM_CheckOpcode, /*MI*/ 0, TargetOpcode::G_ADD,
+        GIR_Done,
+      // Label 1: @16
+      GIM_Reject,
+  };
+
+  LLT s64 = LLT::scalar(64);
+  auto Add = B.buildAdd(s64, Copies[0], Copies[1]);
+  auto Mul = B.buildMul(s64, Copies[0], Copies[1]);
+
+  CodeGenCoverage CoverageInfo;
+  TestSelector ISel(MF->getSubtarget(), MatchTable);
+  ISel.setupMF(*MF, nullptr, CoverageInfo, nullptr, nullptr);
+
+  // Rule 0 runs its opcode check and is rejected. Rule 1 runs its check and
+  // completes.
+  EXPECT_TRUE(ISel.select(*Add));
+  EXPECT_EQ(CoverageInfo.executedOpcodes().vec(),
+            std::vector<uint64_t>({1, 2}));
+
+  // Both rules run their check and are rejected. The final GIM_Reject is
+  // outside of any rule.
+  EXPECT_FALSE(ISel.select(*Mul));
+  EXPECT_EQ(CoverageInfo.executedOpcodes().vec(),
+            std::vector<uint64_t>({2, 3}));
+
+  // This is what -gisel-print-rule-profile prints after the function name.
+  std::string Profile;
+  raw_string_ostream OS(Profile);
+  CoverageInfo.printExecutedOpcodes(OS);
+  EXPECT_EQ(OS.str(), " id0=2 id1=3");
+
+  CoverageInfo.reset();
+  EXPECT_TRUE(CoverageInfo.executedOpcodes().empty());
+}
+
+TEST_F(AArch64GISelMITest, UnprofiledMatchTable) {
+  setUp();
+  if (!TM)
+    return;
+
+  // Without GIR_ProfileRule, nothing is counted.
+  const int64_t MatchTable[] = {
+      GIM_Try, /*On fail goto*/ 6,
+        GIM_CheckOpcode, /*MI*/ 0, TargetOpcode::G_ADD,
+        GIR_Done,
+      // Label 0: @6
+      GIM_Reject,
+  };
+
+  LLT s64 = LLT::scalar(64);
+  auto Add = B.buildAdd(s64, Copies[0], Copies[1]);
+
+  CodeGenCoverage CoverageInfo;
+  TestSelector ISel(MF->getSubtarget(), MatchTable);
+  ISel.setupMF(*MF, nullptr, CoverageInfo, nullptr, nullptr);
+
+  EXPECT_TRUE(ISel.select(*Add));
+  EXPECT_TRUE(CoverageInfo.executedOpcodes().empty());
+}
+
+} // end namespace
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <cstdlib>
+#include <string>
 #include "llvm/Demangle/Demangle.h"
 #include "gtest/gtest.h"
 
@@ -191,3 +192,26 @@ TEST(PartialDemanglerTest, TestPrintCases) {
 
   std::free(Buf);
 }
+
+TEST(PartialDemanglerTest, TestReuse) {
+  // Names of growing and shrinking size, so that the demangler's memory is
+  // released and reused. Each result must match a fresh demangle.
+  llvm::ItaniumPartialDemangler D;
+  char *Buf = nullptr;
+  size_t N = 0;
+  for (unsigned I = 0; I != 200; ++I) {
+    std::string Mangled = "_ZN1a1bIJ";
+    for (unsigned J = 0, E = (I * 7) % 64; J != E; ++J)
+      Mangled += "N2ns1TIiEE";
+    Mangled += "EE1fEv";
+
+    EXPECT_FALSE(D.partialDemangle(Mangled.c_str()));
+    Buf = D.finishDemangle(Buf, &N);
+    char *Expected =
+        llvm::itaniumDemangle(Mangled.c_str(), nullptr, nullptr, nullptr);
+    ASSERT_NE(nullptr, Expected);
+    EXPECT_STREQ(Expected, Buf);
+    std::free(Expected);
+  }
+  std::free(Buf);
+}
@@ -0,0 +1,121 @@
+//===------ CallCountingLayerTest.cpp - Unit tests for CallCountingLayer --===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CallCountingLayer.h"
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/IR/IRBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class CallCountingLayerTest : public testing::Test, public OrcExecutionTest {
+protected:
+  // Adds a function that returns Ret, plus the result of Callee if given.
+  // The function keeps Ret in a local, so that its entry block starts with
+  // a static alloca.
+  static Function *addFunction(Module &M, StringRef Name, int Ret,
+                               GlobalValue::LinkageTypes Linkage,
+                               Function *Callee = nullptr) {
+    LLVMContext &Ctx = M.getContext();
+    Type *Int32Ty = Type::getInt32Ty(Ctx);
+    Function *F = Function::Create(FunctionType::get(Int32Ty, {}, false),
+                                   Linkage, Name, M);
+    IRBuilder<> Builder(BasicBlock::Create(Ctx, "entry", F));
+    Value *Local = Builder.CreateAlloca(Int32Ty);
+    Builder.CreateStore(ConstantInt::get(Int32Ty, Ret), Local);
+    Value *Result = Builder.CreateLoad(Int32Ty, Local);
+    if (Callee)
+      Result = Builder.CreateAdd(Result, Builder.CreateCall(Callee));
+    Builder.CreateRet(Result);
+    return F;
+  }
+};
+
+TEST_F(CallCountingLayerTest, ReportsEachHotFunctionOnce) {
+  if (!SupportsJIT)
+    return;
+
+  // The instrumentation refers to the layer and its entry point by absolute
+  // address, which may be anywhere in the address space.
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    return;
+  }
+  JTMB->setCodeModel(CodeModel::Large);
+  auto HostTM = JTMB->createTargetMachine();
+  if (!HostTM) {
+    consumeError(HostTM.takeError());
+    return;
+  }
+  std::unique_ptr<TargetMachine> LargeTM = std::move(*HostTM);
+  const DataLayout DL = LargeTM->createDataLayout();
+
+  ThreadSafeContext TSCtx(std::make_unique<LLVMContext>());
+  ModuleBuilder MB(*TSCtx.getContext(),
+                   LargeTM->getTargetTriple().str(), "dummy");
+  MB.getModule()->setDataLayout(DL);
+  // Functions with local linkage cannot be redirected, so calls to @local
+  // are not counted even though @hot calls it.
+  Function *Local = addFunction(*MB.getModule(), "local", 1,
+                                GlobalValue::InternalLinkage);
+  Local->addFnAttr(Attribute::NoInline);
+  addFunction(*MB.getModule(), "hot", 0, GlobalValue::ExternalLinkage, Local);
+  addFunction(*MB.getModule(), "cold", 2, GlobalValue::ExternalLinkage);
+
+  auto &JD = ES.createBareJITDylib("main");
+  MangleAndInterner Mangle(ES, DL);
+  RTDyldObjectLinkingLayer ObjLayer(
+      ES, []() { return std::make_unique<SectionMemoryManager>(); });
+  IRCompileLayer CompileLayer(ES, ObjLayer,
+                              std::make_unique<SimpleCompiler>(*LargeTM));
+
+  std::vector<SymbolStringPtr> HotFunctions;
+  CallCountingLayer CallCounting(
+      ES, CompileLayer, Mangle, /*HotThreshold=*/3,
+      [&](JITDylib &HotJD, SymbolStringPtr Name) {
+        EXPECT_EQ(&HotJD, &JD);
+        HotFunctions.push_back(std::move(Name));
+      });
+  cantFail(CallCounting.addRuntime(JD));
+  cantFail(CallCounting.add(
+      JD, ThreadSafeModule(MB.takeModule(), std::move(TSCtx))));
+
+  auto *Hot = jitTargetAddressToFunction<int (*)()>(
+      cantFail(ES.lookup({&JD}, Mangle("hot"))).getAddress());
+  auto *Cold = jitTargetAddressToFunction<int (*)()>(
+      cantFail(ES.lookup({&JD}, Mangle("cold"))).getAddress());
+
+  // The instrumented functions still compute the same result.
+  EXPECT_EQ(Hot(), 1);
+  EXPECT_EQ(Hot(), 1);
+  EXPECT_EQ(Cold(), 2);
+  EXPECT_TRUE(HotFunctions.empty());
+
+  // The call that reaches the threshold reports the function, later calls do
+  // not report it again.
+  EXPECT_EQ(Hot(), 1);
+  ASSERT_EQ(HotFunctions.size(), 1u);
+  EXPECT_EQ(HotFunctions[0], Mangle("hot"));
+  for (int I = 0; I != 10; ++I)
+    EXPECT_EQ(Hot(), 1);
+  EXPECT_EQ(HotFunctions.size(), 1u);
+
+  // Remove the JIT'd code while the layers that own it are still alive.
+  cantFail(ES.endSession());
+}
+
+} // namespace
@@ -0,0 +1,159 @@
+//===- DiskObjectCacheTest.cpp - Unit tests for the on-disk object cache --===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/DiskObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+using llvm::unittest::TempDir;
+
+namespace {
+
+std::unique_ptr<Module> createModule(LLVMContext &Ctx, StringRef FnName) {
+  auto M = std::make_unique<Module>("M", Ctx);
+  Function::Create(FunctionType::get(Type::getVoidTy(Ctx), false),
+                   GlobalValue::ExternalLinkage, FnName, *M);
+  return M;
+}
+
+std::unique_ptr<DiskObjectCache> createCache(StringRef Dir, StringRef CPU) {
+  JITTargetMachineBuilder JTMB((Triple("x86_64-unknown-linux-gnu")));
+  JTMB.setCPU(CPU.str());
+  auto Cache = DiskObjectCache::Create(Dir, JTMB);
+  EXPECT_THAT_EXPECTED(Cache, Succeeded());
+  return Cache ? std::move(*Cache) : nullptr;
+}
+
+TEST(DiskObjectCacheTest, ReuseAcrossInstances) {
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = createModule(Ctx, "foo");
+
+  auto Cache = createCache(Dir.path(), "generic");
+  ASSERT_TRUE(Cache);
+  EXPECT_FALSE(Cache->getObject(M.get()));
+  Cache->notifyObjectCompiled(M.get(),
+                              MemoryBufferRef("object-bytes", "foo.o"));
+
+  // A new cache, as in a later run, finds the entry.
+  auto Later = createCache(Dir.path(), "generic");
+  ASSERT_TRUE(Later);
+  auto Obj = Later->getObject(M.get());
+  ASSERT_TRUE(Obj);
+  EXPECT_EQ("object-bytes", Obj->getBuffer());
+}
+
+TEST(DiskObjectCacheTest, KeyedByIRAndTarget) {
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = createModule(Ctx, "foo");
+
+  auto Cache = createCache(Dir.path(), "generic");
+  ASSERT_TRUE(Cache);
+  EXPECT_FALSE(Cache->getObject(M.get()));
+  Cache->notifyObjectCompiled(M.get(),
+                              MemoryBufferRef("object-bytes", "foo.o"));
+
+  // Different IR misses.
+  auto Other = createModule(Ctx, "bar");
+  EXPECT_FALSE(Cache->getObject(Other.get()));
+
+  // A different CPU misses.
+  auto OtherCPU = createCache(Dir.path(), "skylake");
+  ASSERT_TRUE(OtherCPU);
+  EXPECT_FALSE(OtherCPU->getObject(M.get()));
+}
+
+// Objects are only stored for modules the cache was asked for, since the
+// module passed to notifyObjectCompiled has already been through codegen.
+TEST(DiskObjectCacheTest, StoreWithoutLookupIsIgnored) {
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = createModule(Ctx, "foo");
+
+  auto Cache = createCache(Dir.path(), "generic");
+  ASSERT_TRUE(Cache);
+  Cache->notifyObjectCompiled(M.get(),
+                              MemoryBufferRef("object-bytes", "foo.o"));
+  EXPECT_FALSE(Cache->getObject(M.get()));
+}
+
+// Code generation changes the module it compiles. The object must still be
+// stored under the key of the IR the compiler was given.
+TEST(DiskObjectCacheTest, CompiledModuleHitsTheCache) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    return;
+  }
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    consumeError(TM.takeError());
+    return;
+  }
+
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  auto CacheOrErr = DiskObjectCache::Create(Dir.path(), *JTMB);
+  ASSERT_THAT_EXPECTED(CacheOrErr, Succeeded());
+  DiskObjectCache &Cache = **CacheOrErr;
+  SimpleCompiler Compile(**TM, &Cache);
+
+  auto CreateDefinedModule = [&](LLVMContext &Ctx) {
+    auto M = std::make_unique<Module>("M", Ctx);
+    M->setDataLayout((*TM)->createDataLayout());
+    M->setTargetTriple((*TM)->getTargetTriple().str());
+    // @llvm.is.constant is lowered by the code generator's IR passes.
+    Type *Int32Ty = Type::getInt32Ty(Ctx);
+    Function *F = Function::Create(FunctionType::get(Int32Ty, Int32Ty, false),
+                                   GlobalValue::ExternalLinkage, "f", *M);
+    IRBuilder<> Builder(BasicBlock::Create(Ctx, "entry", F));
+    Value *IsConstant = Builder.CreateIntrinsic(Intrinsic::is_constant,
+                                                {Int32Ty}, {F->getArg(0)});
+    Builder.CreateRet(Builder.CreateZExt(IsConstant, Int32Ty));
+    return M;
+  };
+
+  LLVMContext Ctx;
+  auto First = Compile(*CreateDefinedModule(Ctx));
+  ASSERT_THAT_EXPECTED(First, Succeeded());
+
+  // Replace the only entry, so that a hit can be told from a new compile.
+  std::error_code EC;
+  std::vector<std::string> Entries;
+  for (sys::fs::directory_iterator It(Dir.path(), EC), End; !EC && It != End;
+       It.increment(EC))
+    Entries.push_back(It->path());
+  ASSERT_FALSE(EC);
+  ASSERT_EQ(1u, Entries.size());
+  {
+    raw_fd_ostream OS(Entries[0], EC);
+    ASSERT_FALSE(EC);
+    OS << "cached-object";
+  }
+
+  auto Second = Compile(*CreateDefinedModule(Ctx));
+  ASSERT_THAT_EXPECTED(Second, Succeeded());
+  EXPECT_EQ("cached-object", (*Second)->getBuffer());
+}
+
+} // end anonymous namespace
@@ -0,0 +1,115 @@
+//===- llvm/unittest/IR/StructuralHashTest.cpp - StructuralHash unit tests ===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/IR/StructuralHash.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+std::unique_ptr<Module> parseIR(LLVMContext &Context, const char *IR) {
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(IR, Err, Context);
+  if (!M)
+    Err.print("StructuralHashTest", errs());
+  return M;
+}
+
+const char *TwoFunctionsIR = R"(
+  @g = global i32 0
+  @h = global i32 0
+
+  define i32 @f(i32 %a, i32 %b) {
+  entry:
+    %add = add nsw i32 %a, 1
+    %cmp = icmp slt i32 %add, %b
+    br i1 %cmp, label %then, label %exit
+  then:
+    store i32 %add, i32* @g
+    br label %exit
+  exit:
+    ret i32 %add
+  }
+
+  define i32 @same(i32 %a, i32 %b) {
+  entry:
+    %add = add nsw i32 %a, 1
+    %cmp = icmp slt i32 %add, %b
+    br i1 %cmp, label %then, label %exit
+  then:
+    store i32 %add, i32* @g
+    br label %exit
+  exit:
+    ret i32 %add
+  }
+)";
+
+TEST(StructuralHashTest, IdenticalFunctions) {
+  LLVMContext Context;
+  std::unique_ptr<Module> M = parseIR(Context, TwoFunctionsIR);
+  ASSERT_TRUE(M);
+  const Function &F = *M->getFunction("f");
+  const Function &Same = *M->getFunction("same");
+  EXPECT_EQ(StructuralHash(F), StructuralHash(Same));
+  EXPECT_EQ(StructuralHash(F, /*DetailedHash=*/true),
+            StructuralHash(Same, /*DetailedHash=*/true));
+  EXPECT_NE(StructuralHash(F), StructuralHash(F, /*DetailedHash=*/true));
+}
+
+// Changes that keep the opcodes and the control flow graph intact are only
+// caught by the detailed hash.
+TEST(StructuralHashTest, DetailedHashSeesOperands) {
+  LLVMContext Context;
+  std::unique_ptr<Module> M = parseIR(Context, TwoFunctionsIR);
+  ASSERT_TRUE(M);
+  Function &F = *M->getFunction("f");
+  BasicBlock &Entry = F.getEntryBlock();
+  auto *Add = cast<BinaryOperator>(&Entry.front());
+  auto *Cmp = cast<ICmpInst>(Add->getNextNode());
+  auto *Store = cast<StoreInst>(&Entry.getNextNode()->front());
+
+  uint64_t Hash = StructuralHash(F);
+  uint64_t DetailedHash = StructuralHash(F, /*DetailedHash=*/true);
+  auto ExpectOnlyDetailedHashChanged = [&]() {
+    EXPECT_EQ(Hash, StructuralHash(F));
+    uint64_t NewDetailedHash = StructuralHash(F, /*DetailedHash=*/true);
+    EXPECT_NE(DetailedHash, NewDetailedHash);
+    DetailedHash = NewDetailedHash;
+  };
+
+  Add->setOperand(1, ConstantInt::get(Add->getType(), 2));
+  ExpectOnlyDetailedHashChanged();
+  Add->setHasNoSignedWrap(false);
+  ExpectOnlyDetailedHashChanged();
+  Cmp->setPredicate(CmpInst::ICMP_ULT);
+  ExpectOnlyDetailedHashChanged();
+  Cmp->setOperand(0, F.getArg(0));
+  ExpectOnlyDetailedHashChanged();
+  Store->setOperand(1, M->getNamedGlobal("h"));
+  ExpectOnlyDetailedHashChanged();
+}
+
+TEST(StructuralHashTest, Module) {
+  LLVMContext Context;
+  std::unique_ptr<Module> M = parseIR(Context, TwoFunctionsIR);
+  ASSERT_TRUE(M);
+  uint64_t DetailedHash = StructuralHash(*M, /*DetailedHash=*/true);
+  Function &Same = *M->getFunction("same");
+  auto *Add = cast<BinaryOperator>(&Same.getEntryBlock().front());
+  Add->setOperand(1, ConstantInt::get(Add->getType(), 3));
+  EXPECT_NE(DetailedHash, StructuralHash(*M, /*DetailedHash=*/true));
+}
+
+} // end anonymous namespace
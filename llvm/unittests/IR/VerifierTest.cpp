@@ -17,6 +17,7 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
 #include "gtest/gtest.h"
 
 namespace llvm {
@@ -238,5 +239,69 @@ TEST(VerifierTest, DetectInvalidDebugInfo) {
   }
 }
 
+TEST(VerifierTest, ParallelDomTreesMatchSerial) {
+  LLVMContext C;
+  Module M("M", C);
+  FunctionType *FTy = FunctionType::get(Type::getVoidTy(C), /*isVarArg=*/false);
+  Type *I32 = Type::getInt32Ty(C);
+  Constant *One = ConstantInt::get(I32, 1);
+
+  // Enough valid functions that the broken ones end up in different batches.
+  auto AddValidFunctions = [&](unsigned N) {
+    for (unsigned I = 0; I != N; ++I) {
+      Function *F = Function::Create(FTy, Function::ExternalLinkage, "", M);
+      ReturnInst::Create(C, BasicBlock::Create(C, "entry", F));
+    }
+  };
+
+  AddValidFunctions(10);
+  {
+    // A block without a terminator.
+    Function *F =
+        Function::Create(FTy, Function::ExternalLinkage, "no_terminator", M);
+    BasicBlock *Entry = BasicBlock::Create(C, "entry", F);
+    BasicBlock *Next = BasicBlock::Create(C, "next", F);
+    BranchInst::Create(Next, Entry);
+    BinaryOperator::CreateAdd(One, One, "x", Next);
+  }
+  AddValidFunctions(300);
+  {
+    // A use that is not dominated by its definition.
+    Function *F =
+        Function::Create(FTy, Function::ExternalLinkage, "bad_dominance", M);
+    BasicBlock *Entry = BasicBlock::Create(C, "entry", F);
+    BasicBlock *Left = BasicBlock::Create(C, "left", F);
+    BasicBlock *Right = BasicBlock::Create(C, "right", F);
+    BasicBlock *Exit = BasicBlock::Create(C, "exit", F);
+    BranchInst::Create(Left, Right, ConstantInt::getFalse(C), Entry);
+    Instruction *X = BinaryOperator::CreateAdd(One, One, "x", Left);
+    BranchInst::Create(Exit, Left);
+    BranchInst::Create(Exit, Right);
+    BinaryOperator::CreateAdd(X, One, "y", Exit);
+    ReturnInst::Create(C, Exit);
+  }
+  AddValidFunctions(10);
+
+  auto *Opt = static_cast<cl::opt<bool> *>(
+      cl::getRegisteredOptions()["verify-parallel-domtrees"]);
+  ASSERT_NE(Opt, nullptr);
+
+  std::string Serial;
+  raw_string_ostream SerialOS(Serial);
+  EXPECT_TRUE(verifyModule(M, &SerialOS));
+
+  std::string Parallel;
+  raw_string_ostream ParallelOS(Parallel);
+  Opt->setValue(true);
+  EXPECT_TRUE(verifyModule(M, &ParallelOS));
+  Opt->setValue(false);
+
+  EXPECT_EQ(SerialOS.str(), ParallelOS.str());
+  EXPECT_TRUE(StringRef(Serial).contains(
+      "Basic Block in function 'no_terminator' does not have terminator!"));
+  EXPECT_TRUE(
+      StringRef(Serial).contains("Instruction does not dominate all uses!"));
+}
+
 } // end anonymous namespace
 } // end namespace llvm
@@ -7,15 +7,18 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ProfileData/Coverage/CoverageMapping.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ProfileData/Coverage/CoverageMappingReader.h"
 #include "llvm/ProfileData/Coverage/CoverageMappingWriter.h"
 #include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/ProfileData/InstrProfWriter.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Testing/Support/Error.h"
 #include "llvm/Testing/Support/SupportHelpers.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <ostream>
 #include <utility>
 
@@ -100,6 +103,25 @@ struct CoverageMappingReaderMock : CoverageMappingReader {
   }
 };
 
+// A reader whose first record is malformed.
+struct MalformedCoverageMappingReader : CoverageMappingReader {
+  Error readNextRecord(CoverageMappingRecord &Record) override {
+    return make_error<CoverageMapError>(coveragemap_error::malformed);
+  }
+};
+
+// A reader without records that counts how often it is read.
+struct CountingCoverageMappingReader : CoverageMappingReader {
+  std::atomic<unsigned> &Reads;
+
+  CountingCoverageMappingReader(std::atomic<unsigned> &Reads) : Reads(Reads) {}
+
+  Error readNextRecord(CoverageMappingRecord &Record) override {
+    ++Reads;
+    return make_error<CoverageMapError>(coveragemap_error::eof);
+  }
+};
+
 struct InputFunctionCoverageData {
   // Maps the global file index from CoverageMappingTest.Files
   // to the index of that file within this function. We can't just use
@@ -892,6 +914,48 @@ TEST_P(CoverageMappingTest, skip_duplicate_function_record) {
   ASSERT_EQ(3U, NumFuncs);
 }
 
+// The readers are decoded in parallel, in batches of one reader per thread.
+// The functions must still be loaded in reader order.
+TEST_P(CoverageMappingTest, load_coverage_for_more_readers_than_threads) {
+  const unsigned NumFunctions =
+      2 * std::max(1u, parallel::strategy.compute_thread_count()) + 1;
+  for (unsigned I = 0; I != NumFunctions; ++I) {
+    std::string Name = "func" + utostr(I);
+    ProfileWriter.addRecord({Name, 0x1234, {I}}, Err);
+    startFunction(Name, 0x1234);
+    addCMR(Counter::getCounter(0), "file1", I + 1, 1, I + 1, 5);
+  }
+
+  EXPECT_THAT_ERROR(loadCoverageMapping(), Succeeded());
+
+  unsigned I = 0;
+  for (const auto &FunctionRecord : LoadedCoverage->getCoveredFunctions()) {
+    EXPECT_EQ("func" + utostr(I), FunctionRecord.Name);
+    EXPECT_EQ(I, FunctionRecord.ExecutionCount);
+    ++I;
+  }
+  EXPECT_EQ(NumFunctions, I);
+}
+
+// Only one batch of readers is decoded at a time, so a malformed record in the
+// first batch stops the load before the later readers are read.
+TEST_P(CoverageMappingTest, load_coverage_stops_at_first_failing_batch) {
+  readProfCounts();
+  const unsigned BatchSize =
+      std::max(1u, parallel::strategy.compute_thread_count());
+  std::atomic<unsigned> Reads(0);
+  std::vector<std::unique_ptr<CoverageMappingReader>> CoverageReaders;
+  CoverageReaders.push_back(std::make_unique<MalformedCoverageMappingReader>());
+  for (unsigned I = 1; I != 3 * BatchSize; ++I)
+    CoverageReaders.push_back(
+        std::make_unique<CountingCoverageMappingReader>(Reads));
+
+  auto CoverageOrErr = CoverageMapping::load(CoverageReaders, *ProfileReader);
+  EXPECT_TRUE(
+      ErrorEquals(coveragemap_error::malformed, CoverageOrErr.takeError()));
+  EXPECT_EQ(BatchSize - 1, Reads);
+}
+
 // FIXME: Use ::testing::Combine() when llvm updates its copy of googletest.
 INSTANTIATE_TEST_CASE_P(ParameterizedCovMapTest, CoverageMappingTest,
                         ::testing::Values(std::pair<bool, bool>({false, false}),
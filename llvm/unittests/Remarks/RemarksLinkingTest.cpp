@@ -189,6 +189,34 @@ TEST(Remarks, LinkingGoodStrTab) {
                   304));
 }
 
+// Check that linking several buffers at once deduplicates across buffers and
+// keeps the result independent of the parsing order.
+TEST(Remarks, LinkingMultipleBuffers) {
+  StringRef Inline = "--- !Missed\n"
+                     "Pass:            inline\n"
+                     "Name:            NoDefinition\n"
+                     "DebugLoc:        { File: file.c, Line: 3, Column: 12 }\n"
+                     "Function:        foo\n"
+                     "...\n";
+  StringRef Unroll = "--- !Passed\n"
+                     "Pass:            loop-unroll\n"
+                     "Name:            FullyUnrolled\n"
+                     "DebugLoc:        { File: file.c, Line: 5, Column: 3 }\n"
+                     "Function:        bar\n"
+                     "...\n";
+  remarks::RemarkLinker RL;
+  EXPECT_FALSE(RL.link(ArrayRef<StringRef>({Unroll, Inline, Unroll, Inline}),
+                       remarks::Format::YAML));
+  // Passed remarks sort before missed ones.
+  serializeAndCheck(RL, remarks::Format::YAML, (Twine(Unroll) + Inline).str());
+
+  remarks::RemarkLinker BadRL;
+  Error E = BadRL.link(ArrayRef<StringRef>({Inline, "badyaml", Unroll}),
+                       remarks::Format::YAML);
+  EXPECT_TRUE(static_cast<bool>(E));
+  consumeError(std::move(E));
+}
+
 // Check that we propagate parsing errors.
 TEST(Remarks, LinkingError) {
   remarks::RemarkLinker RL;
@@ -13,6 +13,7 @@
 #include "llvm/ADT/Triple.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/InitLLVM.h"
@@ -1894,4 +1895,69 @@ TEST(CommandLineTest, ConsumeAfterTwoPositionals) {
   EXPECT_TRUE(Errs.empty());
 }
 
+TEST(CommandLineTest, PendingOptionIsRegisteredOnFirstUse) {
+  cl::ResetCommandLineParser();
+
+  StackOption<bool> PendingOption("pending-option");
+  EXPECT_EQ(1u, cl::getRegisteredOptions().count("pending-option"));
+
+  const char *Args[] = {"prog", "-pending-option"};
+  EXPECT_TRUE(
+      cl::ParseCommandLineOptions(2, Args, StringRef(), &llvm::nulls()));
+  EXPECT_TRUE(PendingOption);
+}
+
+TEST(CommandLineTest, RemovePendingOption) {
+  // Make sure the options below are the only pending ones.
+  cl::getRegisteredOptions();
+
+  StackOption<bool> Kept("kept-pending-option");
+  {
+    cl::opt<bool> Removed("removed-pending-option");
+    Removed.removeArgument();
+  }
+  auto Destroyed = std::make_unique<cl::opt<bool>>("destroyed-pending-option");
+  Destroyed.reset();
+
+  StringMap<cl::Option *> &Map = cl::getRegisteredOptions();
+  EXPECT_EQ(0u, Map.count("removed-pending-option"));
+  EXPECT_EQ(0u, Map.count("destroyed-pending-option"));
+  EXPECT_EQ(1u, Map.count("kept-pending-option"));
+}
+
+TEST(CommandLineTest, OptionCreatedWhileParsing) {
+  cl::ResetCommandLineParser();
+
+  // Stands in for a plugin that is loaded by an argument and registers its
+  // own options.
+  std::unique_ptr<StackOption<bool>> PluginOption;
+  StackOption<bool> Load("load-plugin", cl::callback([&](const bool &) {
+                           PluginOption = std::make_unique<StackOption<bool>>(
+                               "plugin-option");
+                         }));
+
+  const char *Args[] = {"prog", "-load-plugin", "-plugin-option"};
+  EXPECT_TRUE(
+      cl::ParseCommandLineOptions(3, Args, StringRef(), &llvm::nulls()));
+  ASSERT_TRUE(PluginOption);
+  EXPECT_TRUE(*PluginOption);
+}
+
+#if GTEST_HAS_DEATH_TEST
+TEST(CommandLineTest, DuplicatePendingOption) {
+  // Tools like clang exit from the fatal error handler. That destroys the
+  // global options, which must not wait on the lock taken to register them.
+  EXPECT_DEATH(
+      {
+        install_fatal_error_handler(
+            [](void *, const std::string &, bool) { exit(1); });
+        cl::getRegisteredOptions();
+        StackOption<bool> First("duplicate-pending-option");
+        StackOption<bool> Second("duplicate-pending-option");
+        cl::getRegisteredOptions();
+      },
+      "registered more than once");
+}
+#endif
+
 } // anonymous namespace
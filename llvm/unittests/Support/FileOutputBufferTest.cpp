@@ -155,6 +155,32 @@ TEST(FileOutputBuffer, Test) {
   ASSERT_EQ(File6Size, 0ULL);
   ASSERT_NO_ERROR(fs::remove(File6.str()));
 
+  // TEST 7: Released ranges keep their contents.
+  SmallString<128> File7(TestDirectory);
+  File7.append("/file7");
+  {
+    Expected<std::unique_ptr<FileOutputBuffer>> BufferOrErr =
+        FileOutputBuffer::create(File7, 65536);
+    ASSERT_NO_ERROR(errorToErrorCode(BufferOrErr.takeError()));
+    std::unique_ptr<FileOutputBuffer> &Buffer = *BufferOrErr;
+    memset(Buffer->getBufferStart(), 'x', 65536);
+    Buffer->releaseRange(0, 65536);
+    // The released range is still writable.
+    memcpy(Buffer->getBufferStart() + 100, "AABBCCDDEEFFGGHHIIJJ", 20);
+    Buffer->releaseRange(10, 40000);
+    ASSERT_NO_ERROR(errorToErrorCode(Buffer->commit()));
+  }
+  {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+        MemoryBuffer::getFile(File7);
+    ASSERT_NO_ERROR(BufOrErr.getError());
+    StringRef Contents = (*BufOrErr)->getBuffer();
+    ASSERT_EQ(Contents.size(), 65536U);
+    EXPECT_EQ(Contents.substr(100, 20), "AABBCCDDEEFFGGHHIIJJ");
+    EXPECT_EQ(Contents.count('x'), 65536U - 20);
+  }
+  ASSERT_NO_ERROR(fs::remove(File7.str()));
+
   // Clean up.
   ASSERT_NO_ERROR(fs::remove(TestDirectory.str()));
 }
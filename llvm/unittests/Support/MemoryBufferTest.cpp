@@ -310,6 +310,16 @@ TEST_F(MemoryBufferTest, slice) {
   EXPECT_TRUE(BufData2.substr(0x17F8,8).equals("12345678"));
   EXPECT_TRUE(BufData2.substr(0x1800,8).equals("abcdefgh"));
   EXPECT_TRUE(BufData2.substr(0x2FF8,8).equals("abcdefgh"));
+
+  // Access hints don't change the contents.
+  for (OwningBuffer *Buf : {&MB.get(), &MB2.get()}) {
+    (*Buf)->adviseIfMmap(MemoryBuffer::AccessRandom);
+    (*Buf)->willNeedIfMmap(0x100, 0x2000);
+    (*Buf)->willNeedIfMmap(0, (*Buf)->getBufferSize());
+    (*Buf)->adviseIfMmap(MemoryBuffer::AccessSequential);
+  }
+  EXPECT_TRUE(BufData.substr(0x1000,8).equals("abcdefgh"));
+  EXPECT_TRUE(BufData2.substr(0x1800,8).equals("abcdefgh"));
 }
 
 TEST_F(MemoryBufferTest, writableSlice) {
@@ -14,6 +14,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -49,6 +50,26 @@ TEST(Parallel, parallel_for) {
   ASSERT_EQ(range[2049], 1u);
 }
 
+TEST(Parallel, UnevenTasks) {
+  // A few expensive items at the start of the range must not keep the rest of
+  // the range from being processed by the other threads.
+  std::atomic<uint64_t> sum{0};
+  parallelForEachN(0, 4096, [&](size_t i) {
+    uint64_t v = 0;
+    for (size_t j = 0, e = i < 16 ? 100000 : 10; j != e; ++j)
+      v += j % 7;
+    sum += v + 1;
+  });
+  uint64_t expected = 0;
+  for (size_t i = 0; i != 4096; ++i) {
+    uint64_t v = 0;
+    for (size_t j = 0, e = i < 16 ? 100000 : 10; j != e; ++j)
+      v += j % 7;
+    expected += v + 1;
+  }
+  EXPECT_EQ(sum, expected);
+}
+
 TEST(Parallel, TransformReduce) {
   // Sum an empty list, check that it works.
   auto identity = [](uint32_t v) { return v; };
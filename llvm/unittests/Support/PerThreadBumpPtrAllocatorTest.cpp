@@ -0,0 +1,86 @@
+//===- PerThreadBumpPtrAllocatorTest.cpp ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/Support/Parallel.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(PerThreadBumpPtrAllocatorTest, SingleThread) {
+  PerThreadBumpPtrAllocator Alloc;
+  uint64_t *A = Alloc.Allocate<uint64_t>(10);
+  uint64_t *B = Alloc.Allocate<uint64_t>(10);
+  EXPECT_NE(A, B);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(A) % alignof(uint64_t));
+  EXPECT_EQ(&Alloc.getThreadArena(), &Alloc.getThreadArena());
+  EXPECT_EQ(160u, Alloc.getBytesAllocated());
+
+  Alloc.Reset();
+  EXPECT_EQ(0u, Alloc.getBytesAllocated());
+  Alloc.Allocate<uint64_t>(1);
+  EXPECT_EQ(8u, Alloc.getBytesAllocated());
+}
+
+// Each allocator has its own arena, even when the calling thread alternates
+// between them or when one is created where another one was destroyed.
+TEST(PerThreadBumpPtrAllocatorTest, SeveralAllocators) {
+  PerThreadBumpPtrAllocator A, B;
+  EXPECT_NE(&A.getThreadArena(), &B.getThreadArena());
+  A.Allocate(16, 8);
+  B.Allocate(32, 8);
+  A.Allocate(16, 8);
+  EXPECT_EQ(32u, A.getBytesAllocated());
+  EXPECT_EQ(32u, B.getBytesAllocated());
+
+  for (int I = 0; I < 3; ++I) {
+    auto *C = new PerThreadBumpPtrAllocator;
+    EXPECT_EQ(0u, C->getBytesAllocated());
+    C->Allocate(8, 8);
+    EXPECT_EQ(8u, C->getBytesAllocated());
+    delete C;
+  }
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, ParallelForEach) {
+  PerThreadBumpPtrAllocator Alloc;
+  std::vector<unsigned *> Ptrs(10000);
+  parallelForEachN(0, Ptrs.size(), [&](size_t I) {
+    Ptrs[I] = new (Alloc.Allocate<unsigned>()) unsigned(I);
+  });
+  for (size_t I = 0; I < Ptrs.size(); ++I)
+    EXPECT_EQ(I, *Ptrs[I]);
+  EXPECT_EQ(Ptrs.size() * sizeof(unsigned), Alloc.getBytesAllocated());
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, Threads) {
+  PerThreadBumpPtrAllocator Alloc;
+  std::vector<BumpPtrAllocator *> Arenas(4);
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T < Arenas.size(); ++T)
+    Threads.emplace_back([&, T] {
+      for (int I = 0; I < 1000; ++I)
+        Alloc.Allocate(8, 8);
+      Arenas[T] = &Alloc.getThreadArena();
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  for (unsigned T = 0; T < Arenas.size(); ++T) {
+    EXPECT_EQ(8000u, Arenas[T]->getBytesAllocated());
+    for (unsigned U = 0; U < T; ++U)
+      EXPECT_NE(Arenas[T], Arenas[U]);
+  }
+  EXPECT_EQ(32000u, Alloc.getBytesAllocated());
+}
+
+} // namespace
@@ -0,0 +1,54 @@
+//===- unittests/Support/SamplingProfilerTest.cpp -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/SamplingProfiler.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+#include <chrono>
+
+using namespace llvm;
+
+namespace {
+
+TEST(SamplingProfilerTest, RecordsSamples) {
+  if (!sys::startSamplingProfiler(1000))
+    return; // Not supported on this platform.
+  EXPECT_FALSE(sys::startSamplingProfiler(1000));
+
+  // Burn some CPU time; the profiler only ticks while the process runs.
+  volatile uint64_t Sink = 0;
+  auto End = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+  while (std::chrono::steady_clock::now() < End)
+    for (unsigned I = 0; I < 10000; ++I)
+      Sink = Sink + I;
+
+  std::string Profile;
+  raw_string_ostream OS(Profile);
+  sys::stopSamplingProfiler(OS);
+  OS.flush();
+
+  // Every line is a stack followed by a sample count.
+  ASSERT_FALSE(Profile.empty());
+  StringRef Line = StringRef(Profile).split('\n').first;
+  unsigned Count = 0;
+  EXPECT_FALSE(Line.rsplit(' ').second.getAsInteger(10, Count));
+  EXPECT_GT(Count, 0u);
+
+  // Stopping twice does nothing.
+  std::string Empty;
+  raw_string_ostream EmptyOS(Empty);
+  sys::stopSamplingProfiler(EmptyOS);
+  EXPECT_TRUE(EmptyOS.str().empty());
+
+  // The profiler can be started again once it has been stopped.
+  EXPECT_TRUE(sys::startSamplingProfiler(1000));
+  sys::stopSamplingProfiler(EmptyOS);
+}
+
+} // end anonymous namespace
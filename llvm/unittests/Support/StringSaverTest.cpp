@@ -0,0 +1,59 @@
+//===- llvm/unittest/Support/StringSaverTest.cpp --------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/StringSaver.h"
+#include "llvm/Support/Parallel.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(StringSaverTest, UniqueStringSaver) {
+  BumpPtrAllocator Alloc;
+  UniqueStringSaver Saver(Alloc);
+  std::string Hello = "hello";
+  StringRef Saved = Saver.save(Hello);
+  EXPECT_EQ("hello", Saved);
+  EXPECT_NE(Hello.data(), Saved.data());
+  EXPECT_EQ('\0', *Saved.end());
+  EXPECT_EQ(Saved.data(), Saver.save(StringRef("hello")).data());
+}
+
+TEST(StringSaverTest, ConcurrentUniqueStringSaver) {
+  for (unsigned NumShards : {1, 3, 64}) {
+    ConcurrentUniqueStringSaver Saver(NumShards);
+    StringRef Saved = Saver.save(std::string("hello"));
+    EXPECT_EQ("hello", Saved);
+    EXPECT_EQ('\0', *Saved.end());
+    EXPECT_EQ(Saved.data(), Saver.save(Twine("hel") + "lo").data());
+    EXPECT_NE(Saved.data(), Saver.save("world").data());
+    EXPECT_EQ("", Saver.save(""));
+    EXPECT_NE(0u, Saver.getBytesAllocated());
+  }
+}
+
+TEST(StringSaverTest, ConcurrentUniqueStringSaverParallel) {
+  std::vector<std::string> Strings;
+  for (int I = 0; I < 1000; ++I)
+    Strings.push_back("string" + std::to_string(I));
+  ConcurrentUniqueStringSaver Saver;
+  // Save every string several times, from concurrent tasks.
+  std::vector<StringRef> Saved(Strings.size() * 4);
+  parallelForEachN(0, Saved.size(), [&](size_t I) {
+    Saved[I] = Saver.save(Strings[I % Strings.size()]);
+  });
+  for (size_t I = 0; I < Saved.size(); ++I) {
+    EXPECT_EQ(Strings[I % Strings.size()], Saved[I]);
+    EXPECT_EQ(Saved[I % Strings.size()].data(), Saved[I].data());
+  }
+}
+
+} // namespace
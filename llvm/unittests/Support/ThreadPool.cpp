@@ -183,6 +183,64 @@ TEST_F(ThreadPoolTest, PoolDestruction) {
   ASSERT_EQ(5, checked_in);
 }
 
+TEST_F(ThreadPoolTest, Priorities) {
+  CHECK_UNSUPPORTED();
+  // With a single thread, the queued tasks run strictly by priority once the
+  // first task is released.
+  ThreadPool Pool(hardware_concurrency(1));
+  std::mutex Lock;
+  std::vector<int> Order;
+  auto Record = [&](int I) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    Order.push_back(I);
+  };
+  Pool.async([this] { waitForMainThread(); });
+  Pool.asyncWithPriority(ThreadPool::Priority::Low, [&] { Record(0); });
+  Pool.asyncWithPriority(ThreadPool::Priority::Default, [&] { Record(1); });
+  Pool.asyncWithPriority(ThreadPool::Priority::High, [&] { Record(2); });
+  Pool.asyncWithPriority(ThreadPool::Priority::High, [&] { Record(3); });
+  setMainThreadReady();
+  Pool.wait();
+  ASSERT_EQ(std::vector<int>({2, 3, 1, 0}), Order);
+}
+
+TEST_F(ThreadPoolTest, Cancellation) {
+  CHECK_UNSUPPORTED();
+  ThreadPool Pool(hardware_concurrency(1));
+  std::atomic_int i{0};
+  Pool.async([this] { waitForMainThread(); });
+  CancellationToken Cancelled = CancellationToken::create();
+  CancellationToken Kept = CancellationToken::create();
+  auto F1 = Pool.asyncWithPriority(ThreadPool::Priority::Default,
+                                   [&i] { i += 1; }, Cancelled);
+  auto F2 = Pool.asyncWithPriority(ThreadPool::Priority::Default,
+                                   [&i] { i += 2; }, Kept);
+  Cancelled.cancel();
+  EXPECT_TRUE(Cancelled.isCancelled());
+  EXPECT_FALSE(Kept.isCancelled());
+  setMainThreadReady();
+  F1.get();
+  F2.get();
+  Pool.wait();
+  ASSERT_EQ(2, i.load());
+}
+
+TEST_F(ThreadPoolTest, BoundedQueue) {
+  CHECK_UNSUPPORTED();
+  // Submitting more tasks than the queue holds blocks until there is room,
+  // and tasks submitted by workers are never blocked.
+  std::atomic_int checked_in{0};
+  ThreadPool Pool(hardware_concurrency(2), /*MaxQueuedTasks=*/2);
+  for (size_t i = 0; i < 20; ++i) {
+    Pool.async([&] {
+      ++checked_in;
+      Pool.async([&checked_in] { ++checked_in; });
+    });
+  }
+  Pool.wait();
+  ASSERT_EQ(40, checked_in);
+}
+
 #if LLVM_ENABLE_THREADS == 1
 
 std::vector<llvm::BitVector>
@@ -883,6 +883,124 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+namespace {
+/// Counts the calls that reach the underlying file system.
+class CountingFileSystem : public vfs::ProxyFileSystem {
+public:
+  explicit CountingFileSystem(IntrusiveRefCntPtr<vfs::FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  ErrorOr<vfs::Status> status(const Twine &Path) override {
+    ++NumStats;
+    return ProxyFileSystem::status(Path);
+  }
+  vfs::directory_iterator dir_begin(const Twine &Dir,
+                                    std::error_code &EC) override {
+    ++NumListings;
+    return ProxyFileSystem::dir_begin(Dir, EC);
+  }
+
+  unsigned NumStats = 0;
+  unsigned NumListings = 0;
+};
+} // namespace
+
+TEST(CachingFileSystemTest, Basic) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> Base(
+      new vfs::InMemoryFileSystem());
+  Base->addFile("/dir/a", 0, MemoryBuffer::getMemBuffer("a"));
+  IntrusiveRefCntPtr<CountingFileSystem> Counting(new CountingFileSystem(Base));
+  vfs::CachingFileSystem CFS(Counting);
+  ASSERT_FALSE(CFS.setCurrentWorkingDirectory("/dir"));
+
+  // Both spellings of the path share one cache entry, and the status keeps
+  // the name it was asked for.
+  auto Stat = CFS.status("/dir/a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ("/dir/a", Stat->getName());
+  Stat = CFS.status("a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ("a", Stat->getName());
+  // Setting the working directory checked that /dir exists.
+  EXPECT_EQ(2u, Counting->NumStats);
+
+  // Missing files are remembered too, until they are invalidated.
+  EXPECT_TRUE(CFS.status("/dir/b").getError());
+  Base->addFile("/dir/b", 0, MemoryBuffer::getMemBuffer("b"));
+  EXPECT_TRUE(CFS.status("/dir/b").getError());
+  EXPECT_TRUE(CFS.openFileForRead("/dir/b").getError());
+  EXPECT_EQ(3u, Counting->NumStats);
+
+  std::error_code EC;
+  CFS.dir_begin("/dir", EC);
+  ASSERT_FALSE(EC);
+  EXPECT_EQ(1u, Counting->NumListings);
+
+  CFS.invalidate("/dir/b");
+  Stat = CFS.status("/dir/b");
+  ASSERT_FALSE(Stat.getError());
+  auto File = CFS.openFileForRead("b");
+  ASSERT_FALSE(File.getError());
+  EXPECT_EQ("b", (*(*File)->getBuffer("ignored"))->getBuffer());
+  EXPECT_EQ("b", (*File)->getName().get());
+
+  // Invalidating /dir/b also dropped the listing of /dir, which now has
+  // both files. The entries are named after the directory as requested.
+  std::vector<std::string> Names;
+  for (vfs::directory_iterator I = CFS.dir_begin(".", EC), E; !EC && I != E;
+       I.increment(EC))
+    Names.push_back(std::string(I->path()));
+  ASSERT_FALSE(EC);
+  EXPECT_EQ(2u, Counting->NumListings);
+  EXPECT_THAT(Names, UnorderedElementsAre("./a", "./b"));
+
+  // The listing is now cached.
+  CFS.dir_begin("/dir", EC);
+  ASSERT_FALSE(EC);
+  EXPECT_EQ(2u, Counting->NumListings);
+
+  CFS.invalidateAll();
+  ASSERT_FALSE(CFS.status("a").getError());
+  EXPECT_EQ(5u, Counting->NumStats);
+}
+
+TEST(CachingFileSystemTest, SharedCacheWithOwnWorkingDirectories) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> Base(
+      new vfs::InMemoryFileSystem());
+  Base->addFile("/x/a", 0, MemoryBuffer::getMemBuffer("x"));
+  Base->addFile("/y/a", 0, MemoryBuffer::getMemBuffer("y"));
+  ASSERT_FALSE(Base->setCurrentWorkingDirectory("/"));
+  IntrusiveRefCntPtr<CountingFileSystem> Counting(new CountingFileSystem(Base));
+
+  auto Cache = std::make_shared<vfs::CachingFileSystem::SharedCache>();
+  vfs::CachingFileSystem X(Counting, Cache), Y(Counting, Cache);
+  ASSERT_FALSE(X.setCurrentWorkingDirectory("/x"));
+  ASSERT_FALSE(Y.setCurrentWorkingDirectory("/y"));
+
+  // Each file system resolves relative paths against its own working
+  // directory, and leaves the one of the underlying file system alone.
+  EXPECT_EQ("/x", X.getCurrentWorkingDirectory().get());
+  EXPECT_EQ("/y", Y.getCurrentWorkingDirectory().get());
+  EXPECT_EQ("/", Base->getCurrentWorkingDirectory().get());
+  auto XFile = X.openFileForRead("a");
+  ASSERT_FALSE(XFile.getError());
+  EXPECT_EQ("x", (*(*XFile)->getBuffer("a"))->getBuffer());
+  auto YFile = Y.openFileForRead("a");
+  ASSERT_FALSE(YFile.getError());
+  EXPECT_EQ("y", (*(*YFile)->getBuffer("a"))->getBuffer());
+
+  // The cache is shared.
+  unsigned NumStats = Counting->NumStats;
+  ASSERT_FALSE(X.status("a").getError());
+  ASSERT_FALSE(Y.status("/x/a").getError());
+  EXPECT_EQ(NumStats + 1, Counting->NumStats);
+  EXPECT_TRUE(X.status("b").getError());
+  Base->addFile("/x/b", 0, MemoryBuffer::getMemBuffer("b"));
+  EXPECT_TRUE(Y.status("/x/b").getError());
+  Y.invalidate("/x/b");
+  EXPECT_FALSE(X.status("b").getError());
+}
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
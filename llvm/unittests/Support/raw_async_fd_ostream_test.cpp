@@ -0,0 +1,104 @@
+//===- raw_async_fd_ostream_test.cpp - raw_async_fd_ostream tests ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/raw_async_fd_ostream.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+class raw_async_fd_ostreamTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    int FD;
+    ASSERT_FALSE(sys::fs::createTemporaryFile("async", "out", FD, Path));
+    sys::fs::closeFile(FD);
+    Cleanup.setFile(Path);
+  }
+
+  std::string readFile() {
+    auto Buffer = MemoryBuffer::getFile(Path);
+    EXPECT_TRUE(bool(Buffer));
+    return Buffer ? (*Buffer)->getBuffer().str() : std::string();
+  }
+
+  SmallString<64> Path;
+  FileRemover Cleanup;
+};
+
+TEST_F(raw_async_fd_ostreamTest, Small) {
+  {
+    std::error_code EC;
+    raw_async_fd_ostream OS(Path, EC);
+    ASSERT_FALSE(EC);
+    OS << "hello " << 42 << '\n';
+    EXPECT_EQ(9u, OS.tell());
+  }
+  EXPECT_EQ("hello 42\n", readFile());
+}
+
+// Writes of several chunks, including single writes larger than a chunk.
+TEST_F(raw_async_fd_ostreamTest, Large) {
+  std::string Expected;
+  {
+    std::error_code EC;
+    raw_async_fd_ostream OS(Path, EC);
+    ASSERT_FALSE(EC);
+    for (int I = 0; I < 200000; ++I) {
+      std::string Line = std::to_string(I) + "\n";
+      OS << Line;
+      Expected += Line;
+    }
+    std::string Big(3 * 1024 * 1024 + 17, 'x');
+    OS << Big;
+    Expected += Big;
+    OS << "end";
+    Expected += "end";
+    EXPECT_EQ(Expected.size(), OS.tell());
+    OS.close();
+    EXPECT_FALSE(OS.has_error());
+  }
+  EXPECT_EQ(Expected, readFile());
+}
+
+TEST_F(raw_async_fd_ostreamTest, Pwrite) {
+  std::string Expected;
+  {
+    std::error_code EC;
+    raw_async_fd_ostream OS(Path, EC);
+    ASSERT_FALSE(EC);
+    OS << "header";
+    // Patch some bytes that were handed to the writer thread, one that is
+    // still buffered, and keep appending afterwards.
+    Expected = "header" + std::string(2 * 1024 * 1024, 'a') + "tail";
+    OS << StringRef(Expected).drop_front(6).drop_back(4);
+    OS.pwrite("HEAD", 4, 0);
+    OS.pwrite("bb", 2, 1024 * 1024);
+    OS << "ta";
+    OS.pwrite("c", 1, OS.tell() - 1);
+    OS << "il";
+    Expected.replace(0, 4, "HEAD");
+    Expected.replace(1024 * 1024, 2, "bb");
+    Expected.replace(Expected.size() - 3, 1, "c");
+  }
+  EXPECT_EQ(Expected, readFile());
+}
+
+TEST_F(raw_async_fd_ostreamTest, OpenError) {
+  std::error_code EC;
+  raw_async_fd_ostream OS("/no/such/directory/file", EC);
+  EXPECT_TRUE(bool(EC));
+}
+
+} // namespace
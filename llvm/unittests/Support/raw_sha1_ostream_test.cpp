@@ -59,6 +59,20 @@ TEST(sha1_hash_test, Update) {
   ASSERT_EQ("3E4A614101AD84985AB0FE54DC12A6D71551E5AE", Hash);
 }
 
+// Several full blocks, which go through the accelerated block function when
+// the host has one.
+TEST(sha1_hash_test, MultiBlock) {
+  SHA1 sha1;
+  sha1.update("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+  ASSERT_EQ("84983E441C3BD26EBAAE4AA1F95129E5E54670F1", toHex(sha1.result()));
+
+  sha1.init();
+  std::string Input(1000, 'a');
+  for (int I = 0; I < 1000; ++I)
+    sha1.update(Input);
+  ASSERT_EQ("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F", toHex(sha1.final()));
+}
+
 // Check that getting the intermediate hash in the middle of the stream does
 // not invalidate the final result.
 TEST(raw_sha1_ostreamTest, Intermediate) {
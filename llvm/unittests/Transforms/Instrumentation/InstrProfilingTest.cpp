@@ -0,0 +1,119 @@
+//===- InstrProfilingTest.cpp - Unit tests for InstrProfiling lowering ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/Instrumentation/InstrProfiling.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/ProfileData/InstrProf.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+static const char *const ModuleIR = R"IR(
+  target triple = "x86_64-unknown-linux-gnu"
+
+  @__profn_f = private constant [1 x i8] c"f"
+
+  define void @f() {
+  entry:
+    call void @llvm.instrprof.increment(i8* getelementptr inbounds ([1 x i8], [1 x i8]* @__profn_f, i32 0, i32 0), i64 0, i32 2, i32 0)
+    br label %next
+  next:
+    call void @llvm.instrprof.increment(i8* getelementptr inbounds ([1 x i8], [1 x i8]* @__profn_f, i32 0, i32 0), i64 0, i32 2, i32 1)
+    ret void
+  }
+
+  declare void @llvm.instrprof.increment(i8*, i64, i32, i32)
+)IR";
+
+class InstrProfilingTest : public testing::Test {
+protected:
+  void SetUp() override {
+    Shards = static_cast<cl::opt<unsigned> *>(
+        cl::getRegisteredOptions()["instrprof-counter-shards"]);
+    ASSERT_NE(Shards, nullptr);
+    Shards->setValue(4);
+  }
+
+  void TearDown() override {
+    if (Shards)
+      Shards->setValue(1);
+  }
+
+  std::unique_ptr<Module> parseModule() {
+    SMDiagnostic Err;
+    std::unique_ptr<Module> M = parseAssemblyString(ModuleIR, Err, Context);
+    if (!M)
+      Err.print("InstrumentationTests", errs());
+    return M;
+  }
+
+  /// Lowers the intrinsics in \p M with \p Lowering.
+  bool lower(InstrProfiling &Lowering, Module &M) {
+    TargetLibraryInfoImpl TLII(Triple(M.getTargetTriple()));
+    TargetLibraryInfo TLI(TLII);
+    return Lowering.run(M, [&](Function &) -> const TargetLibraryInfo & {
+      return TLI;
+    });
+  }
+
+  /// Checks that \p M has sharded counters for @f, and that the shard is
+  /// computed in the entry block of @f.
+  void checkShardedCounters(Module &M) {
+    EXPECT_FALSE(verifyModule(M, &errs()));
+
+    GlobalVariable *Counters = M.getNamedGlobal("__profc_f");
+    ASSERT_NE(Counters, nullptr);
+    auto *CountersTy = cast<ArrayType>(Counters->getValueType());
+    EXPECT_EQ(CountersTy->getNumElements(), 2u * 4u);
+
+    GlobalVariable *Anchor =
+        M.getNamedGlobal(getInstrProfCounterShardAnchorVarName());
+    ASSERT_NE(Anchor, nullptr);
+    bool FoundShard = false;
+    for (Instruction &I : M.getFunction("f")->getEntryBlock())
+      if (auto *PtrToInt = dyn_cast<PtrToIntInst>(&I))
+        FoundShard |= PtrToInt->getPointerOperand() == Anchor;
+    EXPECT_TRUE(FoundShard);
+  }
+
+  LLVMContext Context;
+  cl::opt<unsigned> *Shards = nullptr;
+};
+
+TEST_F(InstrProfilingTest, ShardedCounters) {
+  std::unique_ptr<Module> M = parseModule();
+  ASSERT_TRUE(M);
+  InstrProfiling Lowering;
+  EXPECT_TRUE(lower(Lowering, *M));
+  checkShardedCounters(*M);
+}
+
+// The lowering caches per-function values computed in the entry block. They
+// must not leak into the next module lowered by the same pass instance, even
+// when a function of the new module reuses the address of a previous one.
+TEST_F(InstrProfilingTest, ShardedCountersInSeveralModules) {
+  InstrProfiling Lowering;
+  for (int I = 0; I != 3; ++I) {
+    std::unique_ptr<Module> M = parseModule();
+    ASSERT_TRUE(M);
+    EXPECT_TRUE(lower(Lowering, *M));
+    checkShardedCounters(*M);
+  }
+}
+
+} // end anonymous namespace
@@ -0,0 +1,71 @@
+//===- CodeLayoutTest.cpp - CodeLayout unit tests -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/Utils/CodeLayout.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+using namespace llvm;
+
+namespace {
+
+TEST(CodeLayoutTest, EmptyGraph) {
+  EXPECT_TRUE(applyExtTspLayout({}, {}, {}).empty());
+}
+
+// A diamond whose hot side is laid out last: 0 -> {1 (cold), 2 (hot)} -> 3.
+TEST(CodeLayoutTest, HotPathBecomesFallthrough) {
+  std::vector<uint64_t> Sizes = {16, 16, 16, 16};
+  std::vector<uint64_t> Counts = {100, 1, 99, 100};
+  EdgeCountMap Edges;
+  Edges[{0, 1}] = 1;
+  Edges[{0, 2}] = 99;
+  Edges[{1, 3}] = 1;
+  Edges[{2, 3}] = 99;
+
+  std::vector<uint64_t> Order = applyExtTspLayout(Sizes, Counts, Edges);
+  EXPECT_EQ(Order, std::vector<uint64_t>({0, 2, 3, 1}));
+  EXPECT_GT(calcExtTspScore(Order, Sizes, Counts, Edges),
+            calcExtTspScore(Sizes, Counts, Edges));
+}
+
+TEST(CodeLayoutTest, EntryStaysFirst) {
+  // The hottest jump goes back to the entry, which must not move.
+  std::vector<uint64_t> Sizes = {8, 8, 8};
+  std::vector<uint64_t> Counts = {10, 1000, 10};
+  EdgeCountMap Edges;
+  Edges[{0, 2}] = 10;
+  Edges[{1, 0}] = 1000;
+  Edges[{2, 1}] = 10;
+
+  std::vector<uint64_t> Order = applyExtTspLayout(Sizes, Counts, Edges);
+  ASSERT_EQ(3u, Order.size());
+  EXPECT_EQ(0u, Order[0]);
+}
+
+// Every node is placed exactly once, whatever the graph.
+TEST(CodeLayoutTest, Permutation) {
+  const uint64_t N = 100;
+  std::vector<uint64_t> Sizes(N), Counts(N);
+  EdgeCountMap Edges;
+  for (uint64_t I = 0; I < N; ++I) {
+    Sizes[I] = 4 + I % 7 * 8;
+    Counts[I] = (I * 37) % 11;
+    Edges[{I, (I * 13 + 5) % N}] = (I * 17) % 23;
+    Edges[{I, (I + 1) % N}] = I % 3;
+  }
+
+  std::vector<uint64_t> Order = applyExtTspLayout(Sizes, Counts, Edges);
+  EXPECT_EQ(0u, Order[0]);
+  std::vector<uint64_t> Sorted = Order;
+  std::sort(Sorted.begin(), Sorted.end());
+  for (uint64_t I = 0; I < N; ++I)
+    EXPECT_EQ(I, Sorted[I]);
+}
+
+} // end anonymous namespace
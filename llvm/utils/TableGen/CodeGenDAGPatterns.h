@@ -1174,6 +1174,13 @@ public:
   CodeGenDAGPatterns(RecordKeeper &R,
                      PatternRewriterFn PatternRewriter = nullptr);
 
+  /// Return the patterns for the target described by \p R, building them
+  /// the first time. The instruction selector backends share them when
+  /// llvm-tblgen runs several of them on the same records.
+  static CodeGenDAGPatterns &get(RecordKeeper &R) {
+    return R.getCached<CodeGenDAGPatterns>();
+  }
+
   CodeGenTarget &getTargetInfo() { return Target; }
   const CodeGenTarget &getTargetInfo() const { return Target; }
   const TypeSetByHwMode &getLegalTypes() const { return LegalVTS; }
@@ -68,6 +68,12 @@ static cl::opt<bool> GenerateCoverage(
     cl::desc("Generate coverage instrumentation for GlobalISel"),
     cl::init(false), cl::cat(GlobalISelEmitterCat));
 
+static cl::opt<bool> GenerateProfile(
+    "instrument-gisel-profile",
+    cl::desc("Generate instrumentation counting the match table opcodes each "
+             "GlobalISel rule executes"),
+    cl::init(false), cl::cat(GlobalISelEmitterCat));
+
 static cl::opt<std::string> UseCoverageFile(
     "gisel-coverage-file", cl::init(""),
     cl::desc("Specify file to retrieve coverage information from"),
@@ -3307,6 +3313,10 @@ void RuleMatcher::emit(MatchTable &Table) {
         << MatchTable::Comment(("Rule ID " + Twine(RuleID) + " //").str())
         << MatchTable::LineBreak;
 
+  if (GenerateProfile)
+    Table << MatchTable::Opcode("GIR_ProfileRule")
+          << MatchTable::IntValue(RuleID) << MatchTable::LineBreak;
+
   if (!RequiredFeatures.empty()) {
     Table << MatchTable::Opcode("GIM_CheckFeatures")
           << MatchTable::NamedValue(getNameForFeatureBitset(RequiredFeatures))
@@ -3488,7 +3498,7 @@ public:
 
 private:
   const RecordKeeper &RK;
-  const CodeGenDAGPatterns CGP;
+  const CodeGenDAGPatterns &CGP;
   const CodeGenTarget &Target;
   CodeGenRegBank &CGRegs;
 
@@ -3718,8 +3728,8 @@ GlobalISelEmitter::getEquivNode(Record &Equiv, const TreePatternNode *N) const {
 }
 
 GlobalISelEmitter::GlobalISelEmitter(RecordKeeper &RK)
-    : RK(RK), CGP(RK), Target(CGP.getTargetInfo()),
-      CGRegs(Target.getRegBank()) {}
+    : RK(RK), CGP(CodeGenDAGPatterns::get(RK)),
+      Target(CGP.getTargetInfo()), CGRegs(Target.getRegBank()) {}
 
 //===- Emitter ------------------------------------------------------------===//
 
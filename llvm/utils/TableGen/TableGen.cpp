@@ -148,7 +148,13 @@ cl::opt<std::string> Class("class", cl::desc("Print Enum list for this class"),
                            cl::value_desc("class name"),
                            cl::cat(PrintEnumsCat));
 
-bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
+cl::list<std::string> ExtraOutputs(
+    "extra-output",
+    cl::desc("Also run another backend on the parsed records and write its "
+             "output to a file, e.g. -extra-output=gen-fast-isel=X.inc"),
+    cl::value_desc("backend=filename"));
+
+bool runAction(ActionType Action, raw_ostream &OS, RecordKeeper &Records) {
   switch (Action) {
   case PrintRecords:
     OS << Records;              // No argument, dump all contents
@@ -282,13 +288,48 @@ bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
 
   return false;
 }
+
+bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
+  return runAction(Action, OS, Records);
+}
+
+/// A backend requested with -extra-output.
+struct ExtraBackend {
+  ActionType Action;
+
+  bool operator()(raw_ostream &OS, RecordKeeper &Records) const {
+    return runAction(Action, OS, Records);
+  }
+};
 }
 
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
   cl::ParseCommandLineOptions(argc, argv);
 
-  return TableGenMain(argv[0], &LLVMTableGenMain);
+  // Parse -extra-output first: TableGenOutput only refers to its backend, so
+  // ExtraBackends must not grow once Extras points into it.
+  std::vector<ExtraBackend> ExtraBackends;
+  std::vector<StringRef> ExtraFilenames;
+  for (StringRef Spec : ExtraOutputs) {
+    StringRef Backend, Filename;
+    std::tie(Backend, Filename) = Spec.split('=');
+    ExtraBackend Extra;
+    if (Filename.empty() ||
+        Action.getParser().parse(Action, Backend, Backend, Extra.Action)) {
+      errs() << argv[0] << ": invalid -extra-output '" << Spec
+             << "', expected <backend>=<filename>\n";
+      return 1;
+    }
+    ExtraBackends.push_back(Extra);
+    ExtraFilenames.push_back(Filename);
+  }
+
+  std::vector<TableGenOutput> Extras;
+  for (unsigned I = 0, E = ExtraBackends.size(); I != E; ++I)
+    Extras.push_back({ExtraFilenames[I].str(), ExtraBackends[I]});
+
+  return TableGenMain(argv[0], &LLVMTableGenMain, Extras);
 }
 
 #ifndef __has_feature
@@ -0,0 +1,61 @@
+//===- BytecodeReader.h - MLIR Bytecode Reader ------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This header defines interfaces to read MLIR bytecode files/streams.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MLIR_BYTECODE_BYTECODEREADER_H
+#define MLIR_BYTECODE_BYTECODEREADER_H
+
+#include "mlir/Parser.h"
+
+namespace llvm {
+class MemoryBufferRef;
+} // end namespace llvm
+
+namespace mlir {
+/// Returns true if the given buffer starts with the magic number of the MLIR
+/// bytecode format.
+bool isBytecode(llvm::MemoryBufferRef buffer);
+
+/// Read the operations encoded in the given bytecode buffer and append them to
+/// the given block. If the block is non-empty, the operations are placed before
+/// the current terminator. If reading is successful, success is returned.
+/// Otherwise, an error message is emitted through the error handler registered
+/// in the context, and failure is returned. If `sourceFileLoc` is non-null, it
+/// is populated with a file location representing the start of the buffer.
+/// If `referenceBuffer` is true, dense elements attributes refer to their data
+/// in the buffer instead of copying it into the context, in which case the
+/// buffer must outlive the context.
+LogicalResult readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
+                               MLIRContext *context,
+                               LocationAttr *sourceFileLoc = nullptr,
+                               bool referenceBuffer = false);
+
+/// Read the operations encoded in the given bytecode buffer. If the buffer
+/// contained a single instance of `ContainerOpT`, it is returned. Otherwise, a
+/// new instance of `ContainerOpT` is constructed containing all of the read
+/// operations. If reading was not successful, null is returned and an error
+/// message is emitted through the error handler registered in the context.
+/// `ContainerOpT` has the same requirements as for `parseSourceFile`.
+template <typename ContainerOpT>
+inline OwningOpRef<ContainerOpT>
+readBytecodeFile(llvm::MemoryBufferRef buffer, MLIRContext *context,
+                 bool referenceBuffer = false) {
+  LocationAttr sourceFileLoc;
+  Block block;
+  if (failed(readBytecodeFile(buffer, &block, context, &sourceFileLoc,
+                              referenceBuffer)))
+    return OwningOpRef<ContainerOpT>();
+  return detail::constructContainerOpForParserIfNecessary<ContainerOpT>(
+      &block, context, sourceFileLoc);
+}
+} // end namespace mlir
+
+#endif // MLIR_BYTECODE_BYTECODEREADER_H
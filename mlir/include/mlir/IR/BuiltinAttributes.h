@@ -257,6 +257,16 @@ public:
                                             ArrayRef<char> rawBuffer,
                                             bool isSplatBuffer);
 
+  /// Construct a dense elements attribute that refers to the given raw buffer,
+  /// which has the format expected by `getFromRawBuffer`, instead of copying
+  /// it into the context. This avoids copying and hashing large constants, e.g.
+  /// from a memory mapped file. The buffer must outlive the context. Such
+  /// attributes are uniqued by the address of the buffer, not by its contents:
+  /// attributes with the same contents but different buffers are different.
+  static DenseElementsAttr getFromExternalRawBuffer(ShapedType type,
+                                                    ArrayRef<char> rawBuffer,
+                                                    bool isSplatBuffer);
+
   /// Returns true if the given buffer is a valid raw buffer for the given type.
   /// `detectedSplat` is set if the buffer is valid and represents a splat
   /// buffer.
@@ -23,6 +23,9 @@ class PDLByteCode;
 /// the number of duplicated patterns that need to be created.
 class FrozenRewritePatternList {
   using NativePatternListT = std::vector<std::unique_ptr<RewritePattern>>;
+  using SortedNativePatternListT = std::vector<const RewritePattern *>;
+  using OpSpecificNativePatternMapT =
+      DenseMap<OperationName, SortedNativePatternListT>;
 
 public:
   /// Freeze the patterns held in `patterns`, and take ownership.
@@ -43,6 +46,19 @@ public:
     return llvm::make_pointee_range(nativePatterns);
   }
 
+  /// Return the native patterns that match a specific operation, keyed by the
+  /// root operation. Each list is stable sorted by static benefit, and does not
+  /// contain patterns that are impossible to match.
+  const OpSpecificNativePatternMapT &getOpSpecificNativePatterns() const {
+    return impl->nativeOpSpecificPatternMap;
+  }
+
+  /// Return the native patterns that may match any operation type, stable
+  /// sorted by static benefit.
+  ArrayRef<const RewritePattern *> getMatchAnyOpNativePatterns() const {
+    return impl->nativeAnyOpPatterns;
+  }
+
   /// Return the compiled PDL bytecode held by this list. Returns null if
   /// there are no PDL patterns within the list.
   const detail::PDLByteCode *getPDLByteCode() const {
@@ -55,6 +71,12 @@ private:
     /// The set of native C++ rewrite patterns.
     NativePatternListT nativePatterns;
 
+    /// The native patterns separated by root kind and sorted by static
+    /// benefit. These are computed once when the list is frozen, so that
+    /// applicators using the default cost model don't need to recompute them.
+    OpSpecificNativePatternMapT nativeOpSpecificPatternMap;
+    SortedNativePatternListT nativeAnyOpPatterns;
+
     /// The bytecode containing the compiled PDL patterns.
     std::unique_ptr<detail::PDLByteCode> pdlByteCode;
   };
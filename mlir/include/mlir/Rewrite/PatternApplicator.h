@@ -55,10 +55,9 @@ public:
   void applyCostModel(CostModel model);
 
   /// Apply the default cost model that solely uses the pattern's static
-  /// benefit.
-  void applyDefaultCostModel() {
-    applyCostModel([](const Pattern &pattern) { return pattern.getBenefit(); });
-  }
+  /// benefit. This reuses the pattern lists sorted when the patterns were
+  /// frozen.
+  void applyDefaultCostModel();
 
   /// Walk all of the patterns within the applicator.
   void walkAllPatterns(function_ref<void(const Pattern &)> walk);
@@ -9,6 +9,8 @@
 #ifndef MLIR_TARGET_LLVMIR_EXPORT_H
 #define MLIR_TARGET_LLVMIR_EXPORT_H
 
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
 #include "llvm/ADT/StringRef.h"
 #include <memory>
 
@@ -27,6 +29,26 @@ class Operation;
 std::unique_ptr<llvm::Module>
 translateModuleToLLVMIR(Operation *module, llvm::LLVMContext &llvmContext,
                         llvm::StringRef name = "LLVMDialectModule");
+
+/// An LLVM IR module along with the context it lives in. The module is
+/// destroyed before its context.
+using LLVMModuleAndContext = std::pair<std::unique_ptr<llvm::LLVMContext>,
+                                       std::unique_ptr<llvm::Module>>;
+
+/// Translate operation that satisfies LLVM dialect module requirements into at
+/// most `numPartitions` LLVM IR modules, each living in its own context, so
+/// that both the translation and the compilation of the resulting modules can
+/// proceed in parallel. Every function and global definition is emitted into
+/// exactly one of the modules, and is declared in the others. Definitions with
+/// private or internal linkage are emitted into the same module as all of
+/// their users. Linking the modules, or the object files compiled from them,
+/// yields the same program as `translateModuleToLLVMIR`. The partitions are
+/// translated on multiple threads, unless multi-threading is disabled in the
+/// context of `module`.
+LogicalResult
+translateModuleToLLVMIR(Operation *module, unsigned numPartitions,
+                        SmallVectorImpl<LLVMModuleAndContext> &llvmModules,
+                        llvm::StringRef name = "LLVMDialectModule");
 } // namespace mlir
 
 #endif // MLIR_TARGET_LLVMIR_EXPORT_H
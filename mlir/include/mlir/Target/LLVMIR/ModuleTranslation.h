@@ -20,6 +20,7 @@
 #include "mlir/Target/LLVMIR/LLVMTranslationInterface.h"
 #include "mlir/Target/LLVMIR/TypeTranslation.h"
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Frontend/OpenMP/OMPIRBuilder.h"
 
@@ -51,6 +52,10 @@ class LLVMFuncOp;
 class ModuleTranslation {
   friend std::unique_ptr<llvm::Module>
   mlir::translateModuleToLLVMIR(Operation *, llvm::LLVMContext &, StringRef);
+  friend LogicalResult
+  mlir::translateModuleToLLVMIR(Operation *, unsigned,
+                                SmallVectorImpl<LLVMModuleAndContext> &,
+                                StringRef);
 
 public:
   /// Stores the mapping between a function name and its LLVM IR representation.
@@ -177,10 +182,24 @@ public:
   llvm::NamedMDNode *getOrInsertNamedModuleMetadata(StringRef name);
 
 private:
-  ModuleTranslation(Operation *module,
-                    std::unique_ptr<llvm::Module> llvmModule);
+  ModuleTranslation(Operation *module, std::unique_ptr<llvm::Module> llvmModule,
+                    const DenseSet<Operation *> *definitions = nullptr);
   ~ModuleTranslation();
 
+  /// Translates `module` into a new LLVM IR module in `llvmContext`. If
+  /// `definitions` is provided, only the functions and globals it contains are
+  /// defined in the LLVM IR module.
+  static std::unique_ptr<llvm::Module>
+  translate(Operation *module, llvm::LLVMContext &llvmContext, StringRef name,
+            const DenseSet<Operation *> *definitions = nullptr);
+
+  /// Returns true if the given function or global is defined in the module
+  /// being translated, as opposed to being only declared, or omitted if it
+  /// has local linkage.
+  bool isDefinedHere(Operation *op) const {
+    return !definitions || definitions->count(op);
+  }
+
   /// Converts individual components.
   LogicalResult convertOperation(Operation &op, llvm::IRBuilderBase &builder);
   LogicalResult convertFunctionSignatures();
@@ -198,6 +217,10 @@ private:
   /// Original and translated module.
   Operation *mlirModule;
   std::unique_ptr<llvm::Module> llvmModule;
+
+  /// The functions and globals that are defined in the translated module when
+  /// it is one partition of `mlirModule`, or null if all of them are.
+  const DenseSet<Operation *> *definitions;
   /// A converter for translating debug information.
   std::unique_ptr<detail::DebugTranslation> debugTranslation;
 
@@ -0,0 +1,607 @@
+//===- BytecodeReader.cpp - MLIR Bytecode Reader --------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the reader of the MLIR bytecode format, see Encoding.h
+// for a description of the format.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Bytecode/BytecodeReader.h"
+#include "Encoding.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Dialect.h"
+#include "mlir/IR/Verifier.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Alignment.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+using namespace mlir;
+
+namespace {
+class BytecodeReader {
+public:
+  BytecodeReader(llvm::MemoryBufferRef buffer, MLIRContext *context,
+                 Location fileLoc, bool referenceBuffer)
+      : buffer(buffer), context(context), fileLoc(fileLoc),
+        referenceBuffer(referenceBuffer), ptr(buffer.getBufferStart()) {}
+  ~BytecodeReader();
+
+  /// Read the buffer and append the operations it contains to `block`.
+  LogicalResult read(Block *block);
+
+private:
+  //===--------------------------------------------------------------------===//
+  // Primitive decoding
+
+  /// Emit an error about the contents of the buffer.
+  InFlightDiagnostic emitError(const Twine &msg) {
+    return mlir::emitError(fileLoc) << "malformed MLIR bytecode: " << msg;
+  }
+
+  /// Return the number of bytes left in the buffer.
+  size_t remaining() const { return buffer.getBufferEnd() - ptr; }
+
+  LogicalResult readByte(uint8_t &result);
+  LogicalResult readBytes(size_t length, StringRef &result);
+  LogicalResult readVarInt(uint64_t &result);
+
+  /// Read the number of elements of a list, each of which is encoded in at
+  /// least one byte.
+  LogicalResult readListSize(uint64_t &result);
+
+  /// Read an index into the given table, and return the entry it refers to.
+  template <typename T>
+  LogicalResult readEntry(ArrayRef<T> table, T &result, StringRef kind) {
+    uint64_t index;
+    if (failed(readVarInt(index)))
+      return failure();
+    if (index >= table.size())
+      return emitError("invalid ") << kind << " index " << index;
+    result = table[index];
+    return success();
+  }
+  LogicalResult readString(StringRef &result) {
+    return readEntry<StringRef>(strings, result, "string");
+  }
+  LogicalResult readType(Type &result) {
+    return readEntry<Type>(types, result, "type");
+  }
+  LogicalResult readAttribute(Attribute &result) {
+    return readEntry<Attribute>(attributes, result, "attribute");
+  }
+  LogicalResult readLocation(Location &result);
+
+  //===--------------------------------------------------------------------===//
+  // Tables
+
+  LogicalResult readStringTable();
+  LogicalResult readTypeTable();
+  LogicalResult readAttributeTable();
+  LogicalResult readAttributeEntry(Attribute &result);
+
+  //===--------------------------------------------------------------------===//
+  // IR
+
+  LogicalResult readOperations(Block *block, Block::iterator insertPt);
+  LogicalResult readOperation(Block *block, Block::iterator insertPt);
+  LogicalResult readRegion(Region &region);
+  LogicalResult readOperand(Value &result);
+
+  /// Define the value with the given id, resolving any forward reference to
+  /// it.
+  LogicalResult defineValue(uint64_t id, Value value);
+
+  /// Return the placeholder for the forward reference to the given id,
+  /// creating it if necessary.
+  Value getForwardRef(uint64_t id, Type type);
+
+  /// The buffer being read, and the current position within it.
+  llvm::MemoryBufferRef buffer;
+  MLIRContext *context;
+  Location fileLoc;
+  bool referenceBuffer;
+  const char *ptr;
+
+  /// The tables of the file.
+  std::vector<StringRef> strings;
+  std::vector<Type> types;
+  std::vector<Attribute> attributes;
+
+  /// The values of the file by id, and the number of values defined so far.
+  std::vector<Value> values;
+  uint64_t numDefinedValues = 0;
+
+  /// The placeholders of the values that are used before being defined.
+  DenseMap<uint64_t, Value> forwardRefs;
+
+  /// The blocks of the regions being read, successors refer to blocks of the
+  /// innermost one.
+  std::vector<SmallVector<Block *, 4>> regionBlocks;
+};
+} // end anonymous namespace
+
+BytecodeReader::~BytecodeReader() {
+  // Drop the uses of any forward reference left over after an error, and
+  // destroy their placeholder operation.
+  for (auto &it : forwardRefs) {
+    it.second.dropAllUses();
+    it.second.getDefiningOp()->destroy();
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Primitive decoding
+
+LogicalResult BytecodeReader::readByte(uint8_t &result) {
+  if (remaining() == 0)
+    return emitError("unexpected end of file");
+  result = static_cast<uint8_t>(*ptr++);
+  return success();
+}
+
+LogicalResult BytecodeReader::readBytes(size_t length, StringRef &result) {
+  if (remaining() < length)
+    return emitError("unexpected end of file");
+  result = StringRef(ptr, length);
+  ptr += length;
+  return success();
+}
+
+LogicalResult BytecodeReader::readVarInt(uint64_t &result) {
+  unsigned length = 0;
+  const char *error = nullptr;
+  result = llvm::decodeULEB128(
+      reinterpret_cast<const uint8_t *>(ptr), &length,
+      reinterpret_cast<const uint8_t *>(buffer.getBufferEnd()), &error);
+  if (error)
+    return emitError(error);
+  ptr += length;
+  return success();
+}
+
+LogicalResult BytecodeReader::readListSize(uint64_t &result) {
+  if (failed(readVarInt(result)))
+    return failure();
+  if (result > remaining())
+    return emitError("invalid list size ") << result;
+  return success();
+}
+
+LogicalResult BytecodeReader::readLocation(Location &result) {
+  Attribute attr;
+  if (failed(readAttribute(attr)))
+    return failure();
+  auto loc = attr.dyn_cast<LocationAttr>();
+  if (!loc)
+    return emitError("expected location, but found '") << attr << "'";
+  result = loc;
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// Tables
+
+LogicalResult BytecodeReader::readStringTable() {
+  uint64_t numStrings;
+  if (failed(readListSize(numStrings)))
+    return failure();
+  strings.resize(numStrings);
+  for (StringRef &str : strings) {
+    uint64_t length;
+    if (failed(readVarInt(length)) || failed(readBytes(length, str)))
+      return failure();
+  }
+  return success();
+}
+
+LogicalResult BytecodeReader::readTypeTable() {
+  uint64_t numTypes;
+  if (failed(readListSize(numTypes)))
+    return failure();
+  types.reserve(numTypes);
+  for (uint64_t i = 0; i != numTypes; ++i) {
+    StringRef str;
+    if (failed(readString(str)))
+      return failure();
+    Type type = parseType(str, context);
+    if (!type)
+      return emitError("invalid type '") << str << "'";
+    types.push_back(type);
+  }
+  return success();
+}
+
+LogicalResult BytecodeReader::readAttributeTable() {
+  uint64_t numAttrs;
+  if (failed(readListSize(numAttrs)))
+    return failure();
+  attributes.reserve(numAttrs);
+  for (uint64_t i = 0; i != numAttrs; ++i) {
+    Attribute attr;
+    if (failed(readAttributeEntry(attr)))
+      return failure();
+    attributes.push_back(attr);
+  }
+  return success();
+}
+
+LogicalResult BytecodeReader::readAttributeEntry(Attribute &result) {
+  using bytecode::AttrKind;
+  uint8_t kind;
+  if (failed(readByte(kind)))
+    return failure();
+
+  switch (static_cast<AttrKind>(kind)) {
+  case AttrKind::Textual: {
+    StringRef str;
+    if (failed(readString(str)))
+      return failure();
+    if (!(result = parseAttribute(str, context)))
+      return emitError("invalid attribute '") << str << "'";
+    return success();
+  }
+  case AttrKind::DenseElements: {
+    Type type;
+    uint8_t isSplat;
+    uint64_t numBytes;
+    if (failed(readType(type)) || failed(readByte(isSplat)) ||
+        failed(readVarInt(numBytes)))
+      return failure();
+
+    // Skip the padding that aligns the data within the file.
+    size_t offset = ptr - buffer.getBufferStart();
+    StringRef padding, data;
+    if (failed(readBytes(
+            llvm::alignTo(offset, bytecode::kDenseDataAlignment) - offset,
+            padding)) ||
+        failed(readBytes(numBytes, data)))
+      return failure();
+
+    // Only statically shaped vectors and tensors of integers, floats, and
+    // complex numbers of either have a raw representation.
+    auto shapedType = type.dyn_cast<ShapedType>();
+    if (!shapedType || !shapedType.isa<RankedTensorType, VectorType>() ||
+        !shapedType.hasStaticShape())
+      return emitError("invalid dense elements type ") << type;
+    Type elementType = shapedType.getElementType();
+    if (auto complexType = elementType.dyn_cast<ComplexType>())
+      elementType = complexType.getElementType();
+    if (!elementType.isIntOrIndexOrFloat())
+      return emitError("invalid dense elements type ") << type;
+
+    bool detectedSplat;
+    ArrayRef<char> rawData(data.data(), data.size());
+    if (!DenseElementsAttr::isValidRawBuffer(shapedType, rawData,
+                                             detectedSplat))
+      return emitError("invalid dense elements data for type ") << type;
+
+    // The splat flag decides how many elements are read from the data, so it
+    // has to agree with its size. A single element is both a splat and the
+    // whole data only for types with one element, or with up to 8 booleans
+    // that are packed into a single byte.
+    int64_t numElements = shapedType.getNumElements();
+    bool isAmbiguous = numElements == 1 ||
+                       (elementType.isInteger(1) && numElements <= 8);
+    if (isSplat ? !detectedSplat : detectedSplat && !isAmbiguous)
+      return emitError("dense elements data of ")
+             << rawData.size() << " bytes doesn't match its "
+             << (isSplat ? "" : "non-") << "splat flag for type " << type;
+
+    // The data is aligned relative to the start of the file, it can be used in
+    // place if the buffer itself is aligned, as memory mapped files are.
+    if (referenceBuffer &&
+        llvm::isAddrAligned(llvm::Align(bytecode::kDenseDataAlignment),
+                            data.data()))
+      result = DenseElementsAttr::getFromExternalRawBuffer(shapedType, rawData,
+                                                           isSplat);
+    else
+      result =
+          DenseElementsAttr::getFromRawBuffer(shapedType, rawData, isSplat);
+    return success();
+  }
+  case AttrKind::UnknownLoc:
+    result = UnknownLoc::get(context);
+    return success();
+  case AttrKind::FileLineColLoc: {
+    StringRef filename;
+    uint64_t line, column;
+    if (failed(readString(filename)) || failed(readVarInt(line)) ||
+        failed(readVarInt(column)))
+      return failure();
+    result = FileLineColLoc::get(context, filename, line, column);
+    return success();
+  }
+  case AttrKind::NameLoc: {
+    StringRef name;
+    Location childLoc = UnknownLoc::get(context);
+    if (failed(readString(name)) || failed(readLocation(childLoc)))
+      return failure();
+    result = NameLoc::get(Identifier::get(name, context), childLoc);
+    return success();
+  }
+  case AttrKind::CallSiteLoc: {
+    Location callee = UnknownLoc::get(context);
+    Location caller = UnknownLoc::get(context);
+    if (failed(readLocation(callee)) || failed(readLocation(caller)))
+      return failure();
+    result = CallSiteLoc::get(callee, caller);
+    return success();
+  }
+  case AttrKind::FusedLoc: {
+    uint64_t numLocs;
+    if (failed(readListSize(numLocs)))
+      return failure();
+    SmallVector<Location, 4> locs;
+    locs.reserve(numLocs);
+    for (uint64_t i = 0; i != numLocs; ++i) {
+      Location loc = UnknownLoc::get(context);
+      if (failed(readLocation(loc)))
+        return failure();
+      locs.push_back(loc);
+    }
+    uint64_t metadataIndex;
+    if (failed(readVarInt(metadataIndex)))
+      return failure();
+    Attribute metadata;
+    if (metadataIndex != 0) {
+      if (metadataIndex > attributes.size())
+        return emitError("invalid attribute index ") << metadataIndex - 1;
+      metadata = attributes[metadataIndex - 1];
+    }
+    result = FusedLoc::get(locs, metadata, context);
+    return success();
+  }
+  }
+  return emitError("unknown attribute kind ") << unsigned(kind);
+}
+
+//===----------------------------------------------------------------------===//
+// IR
+
+LogicalResult BytecodeReader::readOperations(Block *block,
+                                             Block::iterator insertPt) {
+  uint64_t numOps;
+  if (failed(readListSize(numOps)))
+    return failure();
+  for (uint64_t i = 0; i != numOps; ++i)
+    if (failed(readOperation(block, insertPt)))
+      return failure();
+  return success();
+}
+
+LogicalResult BytecodeReader::readOperation(Block *block,
+                                            Block::iterator insertPt) {
+  StringRef name;
+  Location loc = fileLoc;
+  if (failed(readString(name)) || failed(readLocation(loc)))
+    return failure();
+
+  uint64_t numAttrs;
+  if (failed(readListSize(numAttrs)))
+    return failure();
+  SmallVector<NamedAttribute, 4> attrs;
+  attrs.reserve(numAttrs);
+  for (uint64_t i = 0; i != numAttrs; ++i) {
+    StringRef attrName;
+    Attribute attr;
+    if (failed(readString(attrName)) || failed(readAttribute(attr)))
+      return failure();
+    attrs.emplace_back(Identifier::get(attrName, context), attr);
+  }
+
+  uint64_t numResults;
+  if (failed(readListSize(numResults)))
+    return failure();
+  SmallVector<Type, 4> resultTypes(numResults);
+  for (Type &type : resultTypes)
+    if (failed(readType(type)))
+      return failure();
+
+  uint64_t numOperands;
+  if (failed(readListSize(numOperands)))
+    return failure();
+  SmallVector<Value, 4> operands(numOperands);
+  for (Value &operand : operands)
+    if (failed(readOperand(operand)))
+      return failure();
+
+  uint64_t numSuccessors;
+  if (failed(readListSize(numSuccessors)))
+    return failure();
+  if (numSuccessors != 0 && regionBlocks.empty())
+    return emitError("successors are only allowed within a region");
+  SmallVector<Block *, 2> successors(numSuccessors);
+  for (Block *&successor : successors)
+    if (failed(readEntry<Block *>(regionBlocks.back(), successor, "block")))
+      return failure();
+
+  uint64_t numRegions;
+  if (failed(readListSize(numRegions)))
+    return failure();
+
+  // Lazy load dialects in the context as needed, as the parser does.
+  OperationName opName(name, context);
+  if (!opName.getAbstractOperation()) {
+    StringRef dialectName = name.split('.').first;
+    if (!context->getLoadedDialect(dialectName) &&
+        context->getOrLoadDialect(dialectName))
+      opName = OperationName(name, context);
+  }
+
+  Operation *op = Operation::create(loc, opName, resultTypes, operands, attrs,
+                                    successors, numRegions);
+  block->getOperations().insert(insertPt, op);
+
+  for (OpResult result : op->getResults())
+    if (failed(defineValue(numDefinedValues, result)))
+      return failure();
+
+  for (Region &region : op->getRegions())
+    if (failed(readRegion(region)))
+      return failure();
+  return success();
+}
+
+LogicalResult BytecodeReader::readRegion(Region &region) {
+  uint64_t numBlocks;
+  if (failed(readListSize(numBlocks)))
+    return failure();
+  if (numBlocks == 0)
+    return success();
+
+  // Create all of the blocks upfront, so that successors can refer to blocks
+  // that have not been read yet.
+  regionBlocks.emplace_back();
+  for (uint64_t i = 0; i != numBlocks; ++i) {
+    Block *block = new Block();
+    region.push_back(block);
+    regionBlocks.back().push_back(block);
+  }
+
+  for (Block &block : region) {
+    uint64_t numArgs;
+    if (failed(readListSize(numArgs)))
+      return failure();
+    for (uint64_t i = 0; i != numArgs; ++i) {
+      Type type;
+      if (failed(readType(type)) ||
+          failed(defineValue(numDefinedValues, block.addArgument(type))))
+        return failure();
+    }
+
+    if (failed(readOperations(&block, block.end())))
+      return failure();
+  }
+  regionBlocks.pop_back();
+  return success();
+}
+
+LogicalResult BytecodeReader::readOperand(Value &result) {
+  uint64_t encoding;
+  if (failed(readVarInt(encoding)))
+    return failure();
+  uint64_t id = encoding >> 1;
+  if (id >= values.size())
+    return emitError("invalid value id ") << id;
+
+  // Forward references carry their type.
+  if (encoding & 1) {
+    Type type;
+    if (failed(readType(type)))
+      return failure();
+    if (!values[id]) {
+      result = getForwardRef(id, type);
+      return success();
+    }
+  }
+
+  if (!(result = values[id]))
+    return emitError("use of undefined value ") << id;
+  return success();
+}
+
+LogicalResult BytecodeReader::defineValue(uint64_t id, Value value) {
+  if (id >= values.size())
+    return emitError("invalid value id ") << id;
+  ++numDefinedValues;
+
+  auto it = forwardRefs.find(id);
+  if (it != forwardRefs.end()) {
+    Value placeholder = it->second;
+    if (placeholder.getType() != value.getType())
+      return emitError("value ")
+             << id << " defined with type " << value.getType()
+             << " but used with type " << placeholder.getType();
+    placeholder.replaceAllUsesWith(value);
+    placeholder.getDefiningOp()->destroy();
+    forwardRefs.erase(it);
+  }
+  values[id] = value;
+  return success();
+}
+
+Value BytecodeReader::getForwardRef(uint64_t id, Type type) {
+  Value &placeholder = forwardRefs[id];
+  if (!placeholder) {
+    // Forward references are created as unregistered operations, as in the
+    // parser, because we just need something with a def/use chain.
+    Operation *op = Operation::create(
+        fileLoc, OperationName("placeholder", context), type,
+        /*operands=*/{}, /*attributes=*/llvm::None, /*successors=*/{},
+        /*numRegions=*/0);
+    placeholder = op->getResult(0);
+  }
+  return placeholder;
+}
+
+LogicalResult BytecodeReader::read(Block *block) {
+  StringRef magic;
+  if (failed(readBytes(sizeof(bytecode::kMagic), magic)) ||
+      magic != StringRef(bytecode::kMagic, sizeof(bytecode::kMagic)))
+    return emitError("invalid magic number");
+
+  uint64_t version;
+  if (failed(readVarInt(version)))
+    return failure();
+  if (version != bytecode::kVersion)
+    return emitError("unsupported version ")
+           << version << ", expected " << bytecode::kVersion;
+
+  if (failed(readStringTable()) || failed(readTypeTable()) ||
+      failed(readAttributeTable()))
+    return failure();
+
+  uint64_t numValues;
+  if (failed(readListSize(numValues)))
+    return failure();
+  values.resize(numValues);
+
+  // Read the operations into a top-level operation, as the parser does, so
+  // that they can be verified before being handed out.
+  OwningOpRef<ModuleOp> topLevelOp(ModuleOp::create(fileLoc));
+  Block *topLevelBlock = topLevelOp->getBody();
+  if (failed(readOperations(topLevelBlock, std::prev(topLevelBlock->end()))))
+    return failure();
+  if (remaining() != 0)
+    return emitError("unexpected data at the end of the file");
+
+  if (!forwardRefs.empty()) {
+    uint64_t firstId = values.size();
+    for (auto &it : forwardRefs)
+      firstId = std::min(firstId, it.first);
+    return emitError("use of undefined value ") << firstId;
+  }
+
+  if (failed(verify(*topLevelOp)))
+    return failure();
+
+  // Splice the operations over to the provided block.
+  auto &readOps = topLevelBlock->getOperations();
+  auto &destOps = block->getOperations();
+  destOps.splice(destOps.empty() ? destOps.end() : std::prev(destOps.end()),
+                 readOps, readOps.begin(), std::prev(readOps.end()));
+  return success();
+}
+
+bool mlir::isBytecode(llvm::MemoryBufferRef buffer) {
+  return buffer.getBuffer().startswith(
+      StringRef(bytecode::kMagic, sizeof(bytecode::kMagic)));
+}
+
+LogicalResult mlir::readBytecodeFile(llvm::MemoryBufferRef buffer,
+                                     Block *block, MLIRContext *context,
+                                     LocationAttr *sourceFileLoc,
+                                     bool referenceBuffer) {
+  Location fileLoc = FileLineColLoc::get(context, buffer.getBufferIdentifier(),
+                                         /*line=*/0, /*column=*/0);
+  if (sourceFileLoc)
+    *sourceFileLoc = fileLoc;
+  return BytecodeReader(buffer, context, fileLoc, referenceBuffer).read(block);
+}
@@ -0,0 +1,334 @@
+//===- BytecodeWriter.cpp - MLIR Bytecode Writer --------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the writer of the MLIR bytecode format, see Encoding.h
+// for a description of the format.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Bytecode/BytecodeWriter.h"
+#include "Encoding.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Operation.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace mlir;
+
+namespace {
+//===----------------------------------------------------------------------===//
+// EncodingEmitter
+//===----------------------------------------------------------------------===//
+
+/// This class emits the primitive components of the format to a stream, and
+/// keeps track of the current offset in the file.
+class EncodingEmitter {
+public:
+  EncodingEmitter(raw_ostream &os) : os(os) {}
+
+  void emitByte(uint8_t byte) {
+    os << static_cast<char>(byte);
+    ++offset;
+  }
+  void emitBytes(StringRef bytes) {
+    os << bytes;
+    offset += bytes.size();
+  }
+  void emitVarInt(uint64_t value) { offset += llvm::encodeULEB128(value, os); }
+
+  /// Emit zero bytes until the current offset is a multiple of `alignment`.
+  void alignTo(uint64_t alignment) {
+    for (uint64_t i = offset, e = llvm::alignTo(offset, alignment); i != e; ++i)
+      emitByte(0);
+  }
+
+private:
+  raw_ostream &os;
+  uint64_t offset = 0;
+};
+
+//===----------------------------------------------------------------------===//
+// BytecodeWriter
+//===----------------------------------------------------------------------===//
+
+class BytecodeWriter {
+public:
+  BytecodeWriter(Operation *op) : topLevelOp(op) {}
+
+  /// Write the bytecode of the top-level operation to the given stream.
+  void write(raw_ostream &os);
+
+private:
+  //===--------------------------------------------------------------------===//
+  // Numbering
+
+  /// Number the strings, types, attributes, and values used by the given
+  /// operation and the operations nested within it, in the order in which the
+  /// reader will encounter them.
+  void number(Operation *op);
+
+  unsigned getStringIndex(StringRef str);
+  unsigned getTypeIndex(Type type);
+  unsigned getAttrIndex(Attribute attr);
+
+  //===--------------------------------------------------------------------===//
+  // Emission
+
+  void emitAttribute(EncodingEmitter &emitter, Attribute attr, unsigned aux);
+  void emitOperation(EncodingEmitter &emitter, Operation *op);
+  void emitValueId(EncodingEmitter &emitter, Value value);
+
+  /// The operation being written.
+  Operation *topLevelOp;
+
+  /// The string table, the strings are owned by `stringIndices`.
+  llvm::StringMap<unsigned> stringIndices;
+  std::vector<StringRef> strings;
+
+  /// The type table, holding the string index of the textual form of each
+  /// type.
+  DenseMap<Type, unsigned> typeIndices;
+  std::vector<unsigned> typeStrings;
+
+  /// The attribute table. Each attribute is paired with the string or type
+  /// index its entry refers to, if any.
+  DenseMap<Attribute, unsigned> attrIndices;
+  std::vector<std::pair<Attribute, unsigned>> attrs;
+
+  /// The numbering of the values, and the number of values defined so far
+  /// during emission.
+  DenseMap<Value, unsigned> valueIds;
+  unsigned numDefinedValues = 0;
+
+  /// The index of each block within its parent region, successors refer to
+  /// blocks by this index.
+  DenseMap<Block *, unsigned> blockIds;
+};
+} // end anonymous namespace
+
+void BytecodeWriter::number(Operation *op) {
+  getStringIndex(op->getName().getStringRef());
+  getAttrIndex(op->getLoc());
+  for (NamedAttribute attr : op->getAttrs()) {
+    getStringIndex(attr.first);
+    getAttrIndex(attr.second);
+  }
+
+  // Operands that are not defined yet are forward references, which carry
+  // their type.
+  for (Value operand : op->getOperands())
+    if (!valueIds.count(operand))
+      getTypeIndex(operand.getType());
+
+  // The results are defined when the operation is created, before its regions
+  // are populated.
+  for (OpResult result : op->getResults()) {
+    getTypeIndex(result.getType());
+    valueIds.try_emplace(result, valueIds.size());
+  }
+
+  for (Region &region : op->getRegions()) {
+    unsigned blockIndex = 0;
+    for (Block &block : region) {
+      blockIds[&block] = blockIndex++;
+      for (BlockArgument arg : block.getArguments()) {
+        getTypeIndex(arg.getType());
+        valueIds.try_emplace(arg, valueIds.size());
+      }
+      for (Operation &nestedOp : block)
+        number(&nestedOp);
+    }
+  }
+}
+
+unsigned BytecodeWriter::getStringIndex(StringRef str) {
+  auto it = stringIndices.try_emplace(str, strings.size());
+  if (it.second)
+    strings.push_back(it.first->getKey());
+  return it.first->second;
+}
+
+unsigned BytecodeWriter::getTypeIndex(Type type) {
+  auto it = typeIndices.find(type);
+  if (it != typeIndices.end())
+    return it->second;
+
+  std::string str;
+  llvm::raw_string_ostream os(str);
+  type.print(os);
+  typeStrings.push_back(getStringIndex(os.str()));
+  return typeIndices[type] = typeStrings.size() - 1;
+}
+
+unsigned BytecodeWriter::getAttrIndex(Attribute attr) {
+  auto it = attrIndices.find(attr);
+  if (it != attrIndices.end())
+    return it->second;
+
+  // Opaque locations refer to in-memory objects, only their fallback location
+  // can be written.
+  if (auto loc = attr.dyn_cast<OpaqueLoc>()) {
+    unsigned index = getAttrIndex(loc.getFallbackLocation());
+    return attrIndices[attr] = index;
+  }
+
+  // Number the components of the attribute first, so that the reader already
+  // knows about them when it reaches this attribute.
+  unsigned aux = 0;
+  if (auto loc = attr.dyn_cast<FileLineColLoc>()) {
+    aux = getStringIndex(loc.getFilename());
+  } else if (auto loc = attr.dyn_cast<NameLoc>()) {
+    aux = getStringIndex(loc.getName());
+    getAttrIndex(loc.getChildLoc());
+  } else if (auto loc = attr.dyn_cast<CallSiteLoc>()) {
+    getAttrIndex(loc.getCallee());
+    getAttrIndex(loc.getCaller());
+  } else if (auto loc = attr.dyn_cast<FusedLoc>()) {
+    for (Location nestedLoc : loc.getLocations())
+      getAttrIndex(nestedLoc);
+    if (Attribute metadata = loc.getMetadata())
+      getAttrIndex(metadata);
+  } else if (auto elements = attr.dyn_cast<DenseIntOrFPElementsAttr>()) {
+    aux = getTypeIndex(elements.getType());
+  } else if (!attr.isa<UnknownLoc>()) {
+    std::string str;
+    llvm::raw_string_ostream os(str);
+    attr.print(os);
+    aux = getStringIndex(os.str());
+  }
+
+  attrs.emplace_back(attr, aux);
+  return attrIndices[attr] = attrs.size() - 1;
+}
+
+void BytecodeWriter::emitAttribute(EncodingEmitter &emitter, Attribute attr,
+                                   unsigned aux) {
+  using bytecode::AttrKind;
+  auto emitKind = [&](AttrKind kind) {
+    emitter.emitByte(static_cast<uint8_t>(kind));
+  };
+
+  if (attr.isa<UnknownLoc>()) {
+    emitKind(AttrKind::UnknownLoc);
+  } else if (auto loc = attr.dyn_cast<FileLineColLoc>()) {
+    emitKind(AttrKind::FileLineColLoc);
+    emitter.emitVarInt(aux);
+    emitter.emitVarInt(loc.getLine());
+    emitter.emitVarInt(loc.getColumn());
+  } else if (auto loc = attr.dyn_cast<NameLoc>()) {
+    emitKind(AttrKind::NameLoc);
+    emitter.emitVarInt(aux);
+    emitter.emitVarInt(attrIndices.lookup(loc.getChildLoc()));
+  } else if (auto loc = attr.dyn_cast<CallSiteLoc>()) {
+    emitKind(AttrKind::CallSiteLoc);
+    emitter.emitVarInt(attrIndices.lookup(loc.getCallee()));
+    emitter.emitVarInt(attrIndices.lookup(loc.getCaller()));
+  } else if (auto loc = attr.dyn_cast<FusedLoc>()) {
+    emitKind(AttrKind::FusedLoc);
+    ArrayRef<Location> locs = loc.getLocations();
+    emitter.emitVarInt(locs.size());
+    for (Location nestedLoc : locs)
+      emitter.emitVarInt(attrIndices.lookup(nestedLoc));
+    Attribute metadata = loc.getMetadata();
+    emitter.emitVarInt(metadata ? attrIndices.lookup(metadata) + 1 : 0);
+  } else if (auto elements = attr.dyn_cast<DenseIntOrFPElementsAttr>()) {
+    emitKind(AttrKind::DenseElements);
+    emitter.emitVarInt(aux);
+    emitter.emitByte(elements.isSplat());
+    ArrayRef<char> data = elements.getRawData();
+    emitter.emitVarInt(data.size());
+    emitter.alignTo(bytecode::kDenseDataAlignment);
+    emitter.emitBytes(StringRef(data.data(), data.size()));
+  } else {
+    emitKind(AttrKind::Textual);
+    emitter.emitVarInt(aux);
+  }
+}
+
+void BytecodeWriter::emitValueId(EncodingEmitter &emitter, Value value) {
+  assert(valueIds.count(value) &&
+         "operation uses a value defined above the written operation");
+  unsigned id = valueIds.lookup(value);
+  bool isForwardRef = id >= numDefinedValues;
+  emitter.emitVarInt((uint64_t(id) << 1) | isForwardRef);
+  if (isForwardRef)
+    emitter.emitVarInt(typeIndices.lookup(value.getType()));
+}
+
+void BytecodeWriter::emitOperation(EncodingEmitter &emitter, Operation *op) {
+  emitter.emitVarInt(stringIndices.lookup(op->getName().getStringRef()));
+  emitter.emitVarInt(attrIndices.lookup(op->getLoc()));
+
+  ArrayRef<NamedAttribute> attributes = op->getAttrs();
+  emitter.emitVarInt(attributes.size());
+  for (NamedAttribute attr : attributes) {
+    emitter.emitVarInt(stringIndices.lookup(attr.first));
+    emitter.emitVarInt(attrIndices.lookup(attr.second));
+  }
+
+  emitter.emitVarInt(op->getNumResults());
+  for (Type type : op->getResultTypes())
+    emitter.emitVarInt(typeIndices.lookup(type));
+
+  emitter.emitVarInt(op->getNumOperands());
+  for (Value operand : op->getOperands())
+    emitValueId(emitter, operand);
+  numDefinedValues += op->getNumResults();
+
+  emitter.emitVarInt(op->getNumSuccessors());
+  for (Block *successor : op->getSuccessors())
+    emitter.emitVarInt(blockIds.lookup(successor));
+
+  emitter.emitVarInt(op->getNumRegions());
+  for (Region &region : op->getRegions()) {
+    emitter.emitVarInt(region.getBlocks().size());
+    for (Block &block : region) {
+      emitter.emitVarInt(block.getNumArguments());
+      for (BlockArgument arg : block.getArguments())
+        emitter.emitVarInt(typeIndices.lookup(arg.getType()));
+      numDefinedValues += block.getNumArguments();
+
+      emitter.emitVarInt(block.getOperations().size());
+      for (Operation &nestedOp : block)
+        emitOperation(emitter, &nestedOp);
+    }
+  }
+}
+
+void BytecodeWriter::write(raw_ostream &os) {
+  number(topLevelOp);
+
+  EncodingEmitter emitter(os);
+  emitter.emitBytes(StringRef(bytecode::kMagic, sizeof(bytecode::kMagic)));
+  emitter.emitVarInt(bytecode::kVersion);
+
+  emitter.emitVarInt(strings.size());
+  for (StringRef str : strings) {
+    emitter.emitVarInt(str.size());
+    emitter.emitBytes(str);
+  }
+
+  emitter.emitVarInt(typeStrings.size());
+  for (unsigned stringIndex : typeStrings)
+    emitter.emitVarInt(stringIndex);
+
+  emitter.emitVarInt(attrs.size());
+  for (auto &it : attrs)
+    emitAttribute(emitter, it.first, it.second);
+
+  emitter.emitVarInt(valueIds.size());
+  emitter.emitVarInt(/*numOps=*/1);
+  emitOperation(emitter, topLevelOp);
+}
+
+void mlir::writeBytecodeToFile(Operation *op, raw_ostream &os) {
+  BytecodeWriter(op).write(os);
+}
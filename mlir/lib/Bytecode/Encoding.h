@@ -0,0 +1,73 @@
+//===- Encoding.h - MLIR Bytecode Encoding ----------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file describes the layout of MLIR bytecode files. All integers are
+// encoded as unsigned LEB128 varints, and every reference to a string, type, or
+// attribute is an index into the corresponding table:
+//
+//   file ::= magic version string-table type-table attr-table ir
+//   magic ::= 'M' 'L' 0xEF 'R'
+//   string-table ::= count (length bytes)*
+//   type-table ::= count string-index*
+//   attr-table ::= count (kind payload)*
+//   ir ::= num-values num-ops op*
+//   op ::= name-string loc-attr num-attrs (name-string attr)*
+//          num-results type* num-operands operand* num-successors block*
+//          num-regions region*
+//   operand ::= (value-id << 1 | is-forward-reference) type?
+//   region ::= num-blocks block*
+//   block ::= num-args type* num-ops op*
+//
+// Types are stored in their textual form, as are attributes that have no
+// dedicated encoding. The data of dense integer and floating point elements
+// attributes is stored raw and aligned to `kDenseDataAlignment` from the start
+// of the file, so that it can be used in place from a memory mapped file.
+// Values are numbered in the order they are defined in a pre-order walk of the
+// IR; the results of an operation are defined before its regions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MLIR_LIB_BYTECODE_ENCODING_H
+#define MLIR_LIB_BYTECODE_ENCODING_H
+
+#include <cstdint>
+
+namespace mlir {
+namespace bytecode {
+/// The magic number at the start of every bytecode file.
+static constexpr char kMagic[4] = {'M', 'L', '\xef', 'R'};
+
+/// The current version of the bytecode format. Readers reject files with a
+/// different version.
+static constexpr uint64_t kVersion = 0;
+
+/// The alignment, relative to the start of the file, of raw dense elements
+/// data.
+static constexpr uint64_t kDenseDataAlignment = 16;
+
+/// The kinds of entries in the attribute table.
+enum class AttrKind : uint8_t {
+  /// string-index
+  Textual = 0,
+  /// type-index is-splat num-bytes padding bytes
+  DenseElements = 1,
+  /// (empty)
+  UnknownLoc = 2,
+  /// filename-string line column
+  FileLineColLoc = 3,
+  /// name-string child-loc
+  NameLoc = 4,
+  /// callee-loc caller-loc
+  CallSiteLoc = 5,
+  /// num-locs loc* (metadata-attr + 1, or 0 if there is no metadata)
+  FusedLoc = 6,
+};
+} // end namespace bytecode
+} // end namespace mlir
+
+#endif // MLIR_LIB_BYTECODE_ENCODING_H
@@ -15,17 +15,19 @@
 
 #ifdef MLIR_ASYNCRUNTIME_DEFINE_FUNCTIONS
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
 #include "llvm/ADT/StringMap.h"
-#include "llvm/Support/ThreadPool.h"
 
 using namespace mlir::runtime;
 
@@ -40,6 +42,185 @@ namespace {
 // Forward declare class defined below.
 class RefCounted;
 
+// -------------------------------------------------------------------------- //
+// A work stealing thread pool that runs async tasks.
+//
+// Every worker thread owns a queue of tasks. Tasks submitted from a worker
+// thread, e.g. the body of an `async.execute` launched by another async task,
+// are pushed to the back of the worker queue and popped back in LIFO order by
+// the same worker, which keeps the data they touch in its caches. Idle workers
+// steal tasks from the front of the other queues. Tasks submitted from outside
+// of the pool go to a shared queue, that all workers steal from.
+// -------------------------------------------------------------------------- //
+
+class WorkStealingThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingThreadPool(unsigned numThreads)
+      : numThreads(numThreads) {
+    // The last queue is the shared queue for tasks submitted from outside of
+    // the pool.
+    for (unsigned i = 0; i <= numThreads; ++i)
+      queues.push_back(std::make_unique<TaskQueue>());
+    for (unsigned i = 0; i < numThreads; ++i)
+      threads.emplace_back([this, i] { workerLoop(i); });
+  }
+
+  ~WorkStealingThreadPool() {
+    wait();
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+
+  // Submits a task for execution on one of the worker threads.
+  void async(Task task) {
+    numUnfinishedTasks.fetch_add(1);
+    TaskQueue &queue = *queues[isWorkerThread() ? currentWorker : numThreads];
+    {
+      std::unique_lock<std::mutex> lock(queue.mu);
+      queue.tasks.push_back(std::move(task));
+    }
+
+    // Wake up a sleeping worker, if any. Sleeping workers check the number of
+    // queued tasks after announcing that they go to sleep, so either they see
+    // this task, or we see them sleeping.
+    numQueuedTasks.fetch_add(1);
+    if (numSleepingWorkers.load() != 0) {
+      { std::unique_lock<std::mutex> lock(mu); }
+      workAvailable.notify_one();
+    }
+  }
+
+  // Blocks the caller until all submitted tasks are completed.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mu);
+    allTasksDone.wait(lock, [this] { return numUnfinishedTasks.load() == 0; });
+  }
+
+  // Runs queued tasks on the current thread until `isReady` returns true, if
+  // the current thread is one of the worker threads of this pool. Returns the
+  // last result of `isReady`; false means there was nothing left to run.
+  //
+  // Nested calls on the same thread do not run tasks: a task run in place sits
+  // on top of the waiting frame, which cannot resume until that task returns,
+  // so nesting could block an already ready waiter behind a blocked one and
+  // grows the stack without bound. Nested waiters fall back to blocking.
+  template <typename IsReady>
+  bool runQueuedTasksUntil(IsReady isReady) {
+    if (!isWorkerThread() || runningQueuedTasks)
+      return isReady();
+    runningQueuedTasks = true;
+    bool ready;
+    while (!(ready = isReady())) {
+      Task task;
+      if (!popTask(currentWorker, task))
+        break;
+      runTask(task);
+    }
+    runningQueuedTasks = false;
+    return ready;
+  }
+
+private:
+  struct TaskQueue {
+    std::mutex mu;
+    std::deque<Task> tasks;
+  };
+
+  bool isWorkerThread() const { return currentPool == this; }
+
+  // Pops a task from the back of the worker's own queue, or steals one from
+  // the front of the other queues.
+  bool popTask(unsigned worker, Task &task) {
+    {
+      TaskQueue &queue = *queues[worker];
+      std::unique_lock<std::mutex> lock(queue.mu);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        numQueuedTasks.fetch_sub(1);
+        return true;
+      }
+    }
+    for (unsigned i = 1; i <= numThreads; ++i) {
+      TaskQueue &queue = *queues[(worker + i) % (numThreads + 1)];
+      std::unique_lock<std::mutex> lock(queue.mu, std::try_to_lock);
+      if (!lock.owns_lock() || queue.tasks.empty())
+        continue;
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      numQueuedTasks.fetch_sub(1);
+      return true;
+    }
+    return false;
+  }
+
+  void runTask(Task &task) {
+    task();
+    if (numUnfinishedTasks.fetch_sub(1) == 1) {
+      { std::unique_lock<std::mutex> lock(mu); }
+      allTasksDone.notify_all();
+    }
+  }
+
+  void workerLoop(unsigned worker) {
+    currentPool = this;
+    currentWorker = worker;
+
+    Task task;
+    while (true) {
+      if (popTask(worker, task)) {
+        runTask(task);
+        continue;
+      }
+
+      // Go to sleep until there are queued tasks. A queue might have been
+      // skipped above because it was locked, so check the number of queued
+      // tasks before sleeping.
+      std::unique_lock<std::mutex> lock(mu);
+      numSleepingWorkers.fetch_add(1);
+      workAvailable.wait(lock, [this] {
+        return stopping || numQueuedTasks.load() != 0;
+      });
+      numSleepingWorkers.fetch_sub(1);
+      if (stopping && numQueuedTasks.load() == 0)
+        return;
+    }
+  }
+
+  // The worker thread queues, followed by the shared queue.
+  std::vector<std::unique_ptr<TaskQueue>> queues;
+  std::vector<std::thread> threads;
+  unsigned numThreads;
+
+  std::atomic<int64_t> numQueuedTasks{0};
+  std::atomic<int64_t> numUnfinishedTasks{0};
+  std::atomic<int32_t> numSleepingWorkers{0};
+
+  // Guards sleeping and waking up of the worker threads, and the completion of
+  // all submitted tasks.
+  std::mutex mu;
+  std::condition_variable workAvailable;
+  std::condition_variable allTasksDone;
+  bool stopping = false;
+
+  // The pool and the index of the worker running on the current thread.
+  static thread_local WorkStealingThreadPool *currentPool;
+  static thread_local unsigned currentWorker;
+  // Set while the current thread runs queued tasks from `runQueuedTasksUntil`.
+  static thread_local bool runningQueuedTasks;
+};
+
+thread_local WorkStealingThreadPool *WorkStealingThreadPool::currentPool;
+thread_local unsigned WorkStealingThreadPool::currentWorker;
+thread_local bool WorkStealingThreadPool::runningQueuedTasks;
+
 // -------------------------------------------------------------------------- //
 // AsyncRuntime orchestrates all async operations and Async runtime API is built
 // on top of the default runtime instance.
@@ -47,7 +228,9 @@ class RefCounted;
 
 class AsyncRuntime {
 public:
-  AsyncRuntime() : numRefCountedObjects(0) {}
+  AsyncRuntime()
+      : numRefCountedObjects(0),
+        threadPool(std::max(1u, std::thread::hardware_concurrency())) {}
 
   ~AsyncRuntime() {
     threadPool.wait(); // wait for the completion of all async tasks
@@ -59,7 +242,18 @@ public:
     return numRefCountedObjects.load(std::memory_order_relaxed);
   }
 
-  llvm::ThreadPool &getThreadPool() { return threadPool; }
+  WorkStealingThreadPool &getThreadPool() { return threadPool; }
+
+  // Blocks the caller until `isReady` returns true. If the caller is one of
+  // the worker threads, it runs queued tasks while waiting instead of
+  // blocking, as the awaited task might be one of them. `wait` is called to
+  // block once there is nothing left to run, or if the caller is itself a task
+  // run in place by an outer await on the same thread.
+  template <typename IsReady, typename Wait>
+  void awaitInPlace(IsReady isReady, Wait wait) {
+    if (!threadPool.runQueuedTasksUntil(isReady))
+      wait();
+  }
 
 private:
   friend class RefCounted;
@@ -74,7 +268,7 @@ private:
   }
 
   std::atomic<int32_t> numRefCountedObjects;
-  llvm::ThreadPool threadPool;
+  WorkStealingThreadPool threadPool;
 };
 
 // -------------------------------------------------------------------------- //
@@ -139,6 +333,8 @@ struct AsyncToken : public RefCounted {
   AsyncToken(AsyncRuntime *runtime)
       : RefCounted(runtime, /*count=*/2), ready(false) {}
 
+  // Set once the token is emplaced. Awaiters check it without taking the lock,
+  // and only take it to register continuations or to block.
   std::atomic<bool> ready;
 
   // Pending awaiters are guarded by a mutex.
@@ -213,42 +409,50 @@ extern "C" AsyncGroup *mlirAsyncRuntimeCreateGroup() {
   return group;
 }
 
+// Runs all the awaiters registered before the object became ready. `ready`
+// must be already set, so that no new awaiters can be added concurrently, and
+// the awaiters run without holding the lock, so that resumed coroutines can
+// freely access the object.
+template <typename T>
+static void runAwaiters(T *object, std::unique_lock<std::mutex> &lock) {
+  std::vector<std::function<void()>> awaiters;
+  awaiters.swap(object->awaiters);
+  object->cv.notify_all();
+  lock.unlock();
+  for (auto &awaiter : awaiters)
+    awaiter();
+}
+
 extern "C" int64_t mlirAsyncRuntimeAddTokenToGroup(AsyncToken *token,
                                                    AsyncGroup *group) {
-  std::unique_lock<std::mutex> lockToken(token->mu);
-  std::unique_lock<std::mutex> lockGroup(group->mu);
-
   // Get the rank of the token inside the group before we drop the reference.
   int rank = group->rank.fetch_add(1);
-  group->pendingTokens.fetch_add(1);
 
+  // If the token is already ready it doesn't change the number of pending
+  // tokens in the group, and there is nothing else to do.
+  if (token->ready.load(std::memory_order_acquire))
+    return rank;
+
+  // Otherwise, update group pending tokens when the token will become ready.
+  // Because this will happen asynchronously we must ensure that `group` is
+  // alive until then.
+  group->pendingTokens.fetch_add(1);
+  group->addRef();
   auto onTokenReady = [group]() {
     // Run all group awaiters if it was the last token in the group.
     if (group->pendingTokens.fetch_sub(1) == 1) {
-      group->cv.notify_all();
-      for (auto &awaiter : group->awaiters)
-        awaiter();
+      std::unique_lock<std::mutex> lockGroup(group->mu);
+      runAwaiters(group, lockGroup);
     }
+    group->dropRef();
   };
 
-  if (token->ready) {
-    // Update group pending tokens immediately and maybe run awaiters.
+  std::unique_lock<std::mutex> lockToken(token->mu);
+  if (token->ready.load(std::memory_order_relaxed)) {
+    lockToken.unlock();
     onTokenReady();
-
   } else {
-    // Update group pending tokens when token will become ready. Because this
-    // will happen asynchronously we must ensure that `group` is alive until
-    // then, and re-ackquire the lock.
-    group->addRef();
-
-    token->awaiters.push_back([group, onTokenReady]() {
-      // Make sure that `dropRef` does not destroy the mutex owned by the lock.
-      {
-        std::unique_lock<std::mutex> lockGroup(group->mu);
-        onTokenReady();
-      }
-      group->dropRef();
-    });
+    token->awaiters.push_back(onTokenReady);
   }
 
   return rank;
@@ -256,14 +460,9 @@ extern "C" int64_t mlirAsyncRuntimeAddTokenToGroup(AsyncToken *token,
 
 // Switches `async.token` to ready state and runs all awaiters.
 extern "C" void mlirAsyncRuntimeEmplaceToken(AsyncToken *token) {
-  // Make sure that `dropRef` does not destroy the mutex owned by the lock.
-  {
-    std::unique_lock<std::mutex> lock(token->mu);
-    token->ready = true;
-    token->cv.notify_all();
-    for (auto &awaiter : token->awaiters)
-      awaiter();
-  }
+  std::unique_lock<std::mutex> lock(token->mu);
+  token->ready.store(true, std::memory_order_release);
+  runAwaiters(token, lock);
 
   // Async tokens created with a ref count `2` to keep token alive until the
   // async task completes. Drop this reference explicitly when token emplaced.
@@ -272,36 +471,41 @@ extern "C" void mlirAsyncRuntimeEmplaceToken(AsyncToken *token) {
 
 // Switches `async.value` to ready state and runs all awaiters.
 extern "C" void mlirAsyncRuntimeEmplaceValue(AsyncValue *value) {
-  // Make sure that `dropRef` does not destroy the mutex owned by the lock.
-  {
-    std::unique_lock<std::mutex> lock(value->mu);
-    value->ready = true;
-    value->cv.notify_all();
-    for (auto &awaiter : value->awaiters)
-      awaiter();
-  }
+  std::unique_lock<std::mutex> lock(value->mu);
+  value->ready.store(true, std::memory_order_release);
+  runAwaiters(value, lock);
 
   // Async values created with a ref count `2` to keep value alive until the
   // async task completes. Drop this reference explicitly when value emplaced.
   value->dropRef();
 }
 
+// Blocks the caller until `object` becomes ready. Ready objects are checked
+// without taking the lock.
+template <typename T, typename IsReady>
+static void awaitReady(T *object, IsReady isReady) {
+  if (isReady())
+    return;
+  getDefaultAsyncRuntime()->awaitInPlace(isReady, [&] {
+    std::unique_lock<std::mutex> lock(object->mu);
+    object->cv.wait(lock, isReady);
+  });
+}
+
 extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
-  std::unique_lock<std::mutex> lock(token->mu);
-  if (!token->ready)
-    token->cv.wait(lock, [token] { return token->ready.load(); });
+  awaitReady(token, [token] {
+    return token->ready.load(std::memory_order_acquire);
+  });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
-  std::unique_lock<std::mutex> lock(value->mu);
-  if (!value->ready)
-    value->cv.wait(lock, [value] { return value->ready.load(); });
+  awaitReady(value, [value] {
+    return value->ready.load(std::memory_order_acquire);
+  });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitAllInGroup(AsyncGroup *group) {
-  std::unique_lock<std::mutex> lock(group->mu);
-  if (group->pendingTokens != 0)
-    group->cv.wait(lock, [group] { return group->pendingTokens == 0; });
+  awaitReady(group, [group] { return group->pendingTokens.load() == 0; });
 }
 
 // Returns a pointer to the storage owned by the async value.
@@ -314,43 +518,48 @@ extern "C" void mlirAsyncRuntimeExecute(CoroHandle handle, CoroResume resume) {
   runtime->getThreadPool().async([handle, resume]() { (*resume)(handle); });
 }
 
-extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
-                                                     CoroHandle handle,
-                                                     CoroResume resume) {
+// Resumes the coroutine in place if `object` is ready, or when it becomes
+// ready otherwise. Ready objects are checked without taking the lock.
+template <typename T, typename IsReady>
+static void awaitReadyAndExecute(T *object, IsReady isReady,
+                                 CoroHandle handle, CoroResume resume) {
   auto execute = [handle, resume]() { (*resume)(handle); };
-  std::unique_lock<std::mutex> lock(token->mu);
-  if (token->ready) {
+  if (isReady()) {
+    execute();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(object->mu);
+  if (isReady()) {
     lock.unlock();
     execute();
   } else {
-    token->awaiters.push_back([execute]() { execute(); });
+    object->awaiters.push_back(execute);
   }
 }
 
+extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
+                                                     CoroHandle handle,
+                                                     CoroResume resume) {
+  awaitReadyAndExecute(
+      token, [token] { return token->ready.load(std::memory_order_acquire); },
+      handle, resume);
+}
+
 extern "C" void mlirAsyncRuntimeAwaitValueAndExecute(AsyncValue *value,
                                                      CoroHandle handle,
                                                      CoroResume resume) {
-  auto execute = [handle, resume]() { (*resume)(handle); };
-  std::unique_lock<std::mutex> lock(value->mu);
-  if (value->ready) {
-    lock.unlock();
-    execute();
-  } else {
-    value->awaiters.push_back([execute]() { execute(); });
-  }
+  awaitReadyAndExecute(
+      value, [value] { return value->ready.load(std::memory_order_acquire); },
+      handle, resume);
 }
 
 extern "C" void mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *group,
                                                           CoroHandle handle,
                                                           CoroResume resume) {
-  auto execute = [handle, resume]() { (*resume)(handle); };
-  std::unique_lock<std::mutex> lock(group->mu);
-  if (group->pendingTokens == 0) {
-    lock.unlock();
-    execute();
-  } else {
-    group->awaiters.push_back([execute]() { execute(); });
-  }
+  awaitReadyAndExecute(
+      group, [group] { return group->pendingTokens.load() == 0; }, handle,
+      resume);
 }
 
 //===----------------------------------------------------------------------===//
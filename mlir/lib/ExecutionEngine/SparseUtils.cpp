@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 //===----------------------------------------------------------------------===//
@@ -56,13 +57,35 @@ namespace {
 ///   ({i}, a[i])
 /// and a rank-5 tensor element like
 ///   ({i,j,k,l,m}, a[i,j,k,l,m])
+/// The indices are owned by the enclosing sparse tensor, which stores the
+/// indices of all elements contiguously, so that reading a large tensor does
+/// not require an allocation per element.
 struct Element {
-  Element(const std::vector<uint64_t> &ind, double val)
-      : indices(ind), value(val){};
-  std::vector<uint64_t> indices;
+  Element(const uint64_t *ind, double val) : indices(ind), value(val){};
+  const uint64_t *indices;
   double value;
 };
 
+/// Work below which a loop is not split over multiple threads.
+constexpr uint64_t kMinParallelWork = 1 << 16;
+
+/// Returns the number of threads to use for the given amount of work.
+static unsigned getNumThreads(uint64_t work) {
+  uint64_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+  return std::max<uint64_t>(1, std::min(numThreads, work / kMinParallelWork));
+}
+
+/// Calls fn(t) for each t in [0, numThreads), on separate threads.
+template <typename Fn>
+static void parallelFor(unsigned numThreads, Fn fn) {
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < numThreads; t++)
+    threads.emplace_back(fn, t);
+  fn(0);
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
 /// A memory-resident sparse tensor in coordinate scheme (collection of
 /// elements). This data structure is used to read a sparse tensor from
 /// external file format into memory and sort the elements lexicographically
@@ -70,19 +93,41 @@ struct Element {
 /// formats require the elements to appear in lexicographic index order).
 struct SparseTensor {
 public:
-  SparseTensor(const std::vector<uint64_t> &szs, uint64_t capacity)
-      : sizes(szs), pos(0) {
-    elements.reserve(capacity);
+  /// Constructs a tensor with the given per-rank dimension sizes and `nnz`
+  /// zero elements, to be set through `getIndices` and `setValue`.
+  SparseTensor(const std::vector<uint64_t> &szs, uint64_t nnz)
+      : sizes(szs), indices(nnz * getRank()), pos(0) {
+    elements.reserve(nnz);
+    for (uint64_t k = 0, rank = getRank(); k < nnz; k++)
+      elements.emplace_back(&indices[k * rank], 0.0);
   }
-  /// Adds element as indices and value.
-  void add(const std::vector<uint64_t> &ind, double val) {
-    assert(getRank() == ind.size());
-    for (int64_t r = 0, rank = getRank(); r < rank; r++)
-      assert(ind[r] < sizes[r]); // within bounds
-    elements.emplace_back(Element(ind, val));
+  /// Returns the indices of the k-th element, for writing.
+  uint64_t *getIndices(uint64_t k) { return &indices[k * getRank()]; }
+  /// Sets the value of the k-th element.
+  void setValue(uint64_t k, double val) { elements[k].value = val; }
+  /// Sorts elements lexicographically by index. Large tensors are sorted by
+  /// sorting one slice per thread and merging the sorted slices pairwise.
+  void sort() {
+    LexOrder lexOrder(getRank());
+    uint64_t nnz = elements.size();
+    unsigned numThreads = getNumThreads(nnz);
+    std::vector<std::vector<Element>::iterator> bounds;
+    for (unsigned t = 0; t <= numThreads; t++)
+      bounds.push_back(elements.begin() + nnz * t / numThreads);
+    parallelFor(numThreads, [&](unsigned t) {
+      std::sort(bounds[t], bounds[t + 1], lexOrder);
+    });
+    for (unsigned width = 1; width < numThreads; width *= 2) {
+      unsigned numMerges = (numThreads + 2 * width - 1) / (2 * width);
+      parallelFor(numMerges, [&](unsigned m) {
+        unsigned lo = 2 * width * m, mid = lo + width;
+        if (mid < numThreads)
+          std::inplace_merge(bounds[lo], bounds[mid],
+                             bounds[std::min(mid + width, numThreads)],
+                             lexOrder);
+      });
+    }
   }
-  /// Sorts elements lexicographically by index.
-  void sort() { std::sort(elements.begin(), elements.end(), lexOrder); }
   /// Primitive one-time iteration.
   const Element &next() { return elements[pos++]; }
   /// Returns rank.
@@ -93,17 +138,21 @@ public:
   const std::vector<Element> &getElements() const { return elements; }
 
 private:
-  /// Returns true if indices of e1 < indices of e2.
-  static bool lexOrder(const Element &e1, const Element &e2) {
-    assert(e1.indices.size() == e2.indices.size());
-    for (int64_t r = 0, rank = e1.indices.size(); r < rank; r++) {
-      if (e1.indices[r] == e2.indices[r])
-        continue;
-      return e1.indices[r] < e2.indices[r];
+  /// Orders elements lexicographically by indices.
+  struct LexOrder {
+    explicit LexOrder(uint64_t rank) : rank(rank) {}
+    bool operator()(const Element &e1, const Element &e2) const {
+      for (uint64_t r = 0; r < rank; r++) {
+        if (e1.indices[r] == e2.indices[r])
+          continue;
+        return e1.indices[r] < e2.indices[r];
+      }
+      return false;
     }
-    return false;
-  }
-  std::vector<uint64_t> sizes; // per-rank dimension sizes
+    uint64_t rank;
+  };
+  std::vector<uint64_t> sizes;   // per-rank dimension sizes
+  std::vector<uint64_t> indices; // per-element indices
   std::vector<Element> elements;
   uint64_t pos;
 };
@@ -193,8 +242,8 @@ private:
     uint64_t full = 0;
     while (lo < hi) {
       // Find segment in interval with same index elements in this dimension.
-      unsigned idx = elements[lo].indices[d];
-      unsigned seg = lo + 1;
+      uint64_t idx = elements[lo].indices[d];
+      uint64_t seg = lo + 1;
       while (seg < hi && elements[seg].indices[d] == idx)
         seg++;
       // Handle segment in interval for sparse or dense dimension.
@@ -314,6 +363,142 @@ static void readExtFROSTTHeader(FILE *file, char *name, uint64_t *idata) {
   }
 }
 
+/// Returns the end of the line starting at `p`, i.e. the position of its
+/// newline character or `end`.
+static const char *findLineEnd(const char *p, const char *end) {
+  const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+  return newline ? newline : end;
+}
+
+/// Returns true if the given line only contains whitespace.
+static bool isBlankLine(const char *p, const char *lineEnd) {
+  for (; p < lineEnd; p++)
+    if (!isspace(static_cast<unsigned char>(*p)))
+      return false;
+  return true;
+}
+
+/// Parses the 1-based indices and the value of a nonzero element on the given
+/// line into the k-th element of the tensor. Returns false on failure.
+static bool parseElement(const char *p, const char *lineEnd,
+                         SparseTensor *tensor, uint64_t k) {
+  uint64_t *indices = tensor->getIndices(k);
+  char *parsed;
+  for (uint64_t r = 0, rank = tensor->getRank(); r < rank; r++) {
+    uint64_t index = strtoull(p, &parsed, 10);
+    if (parsed == p || parsed > lineEnd || index == 0 ||
+        index > tensor->getSizes()[r])
+      return false;
+    indices[r] = index - 1; // 0-based index
+    p = parsed;
+  }
+  double value = strtod(p, &parsed);
+  if (parsed == p || parsed > lineEnd)
+    return false;
+  tensor->setValue(k, value);
+  return true;
+}
+
+/// Size of the blocks in which the nonzero elements are read from the file.
+constexpr size_t kReadBlockSize = 1 << 24;
+
+/// Reads the nonzero elements, one per line, from the given whole lines into
+/// the tensor, starting at the element at position `start`. Returns the
+/// position after the last element read. Large blocks are split into one chunk
+/// of lines per thread: a first pass counts the elements in each chunk, which
+/// gives the position of the first element of every chunk, and a second pass
+/// parses the chunks directly into the tensor.
+static uint64_t readLines(char *name, const char *begin, const char *end,
+                          SparseTensor *tensor, uint64_t start) {
+  unsigned numThreads = getNumThreads(end - begin);
+  std::vector<const char *> bounds(numThreads + 1, end);
+  bounds[0] = begin;
+  for (unsigned t = 1; t < numThreads; t++) {
+    const char *p = begin + (end - begin) * t / numThreads;
+    bounds[t] = std::max(bounds[t - 1], findLineEnd(p, end));
+  }
+
+  std::vector<uint64_t> first(numThreads + 1, start);
+  parallelFor(numThreads, [&](unsigned t) {
+    uint64_t count = 0;
+    for (const char *p = bounds[t]; p < bounds[t + 1];) {
+      const char *lineEnd = findLineEnd(p, end);
+      count += !isBlankLine(p, lineEnd);
+      p = lineEnd + 1;
+    }
+    first[t + 1] = count;
+  });
+  for (unsigned t = 0; t < numThreads; t++)
+    first[t + 1] += first[t];
+  uint64_t nnz = tensor->getElements().size();
+  if (first[numThreads] > nnz) {
+    fprintf(stderr, "Expected %" PRIu64 " nonzeros but found more in %s\n",
+            nnz, name);
+    exit(1);
+  }
+
+  std::vector<char> failed(numThreads, false);
+  parallelFor(numThreads, [&](unsigned t) {
+    uint64_t k = first[t];
+    for (const char *p = bounds[t]; p < bounds[t + 1] && !failed[t];) {
+      const char *lineEnd = findLineEnd(p, end);
+      if (!isBlankLine(p, lineEnd))
+        failed[t] = !parseElement(p, lineEnd, tensor, k++);
+      p = lineEnd + 1;
+    }
+  });
+  if (std::find(failed.begin(), failed.end(), true) != failed.end()) {
+    fprintf(stderr, "Cannot find next element in %s\n", name);
+    exit(1);
+  }
+  return first[numThreads];
+}
+
+/// Reads the nonzero elements, one per line, from the remainder of the file
+/// into the tensor. The file is read in blocks of whole lines, so that besides
+/// the tensor itself only about kReadBlockSize bytes of the file are held in
+/// memory, however large the file is.
+static void readElements(FILE *file, char *name, SparseTensor *tensor) {
+  // One more character terminates the contents with a null character, so
+  // that the parsing of the last line stops within the block.
+  std::vector<char> block(kReadBlockSize + 1);
+  size_t size = 0;
+  uint64_t k = 0;
+  while (true) {
+    size += fread(block.data() + size, 1, block.size() - size - 1, file);
+    if (ferror(file)) {
+      fprintf(stderr, "Cannot read %s\n", name);
+      exit(1);
+    }
+    bool atEnd = size + 1 < block.size();
+    block[size] = '\0';
+    const char *begin = block.data();
+    const char *end = begin + size;
+    // Keep a partial last line for the next block, unless the file ends.
+    const char *linesEnd = end;
+    if (!atEnd) {
+      while (linesEnd != begin && linesEnd[-1] != '\n')
+        linesEnd--;
+      if (linesEnd == begin) {
+        // A single line fills the block, read on with a larger one.
+        block.resize(2 * block.size() - 1);
+        continue;
+      }
+    }
+    k = readLines(name, begin, linesEnd, tensor, k);
+    if (atEnd)
+      break;
+    size = end - linesEnd;
+    memmove(block.data(), linesEnd, size);
+  }
+  uint64_t nnz = tensor->getElements().size();
+  if (k != nnz) {
+    fprintf(stderr, "Expected %" PRIu64 " nonzeros but found %" PRIu64
+            " in %s\n", nnz, k, name);
+    exit(1);
+  }
+}
+
 } // anonymous namespace
 
 //===----------------------------------------------------------------------===//
@@ -372,31 +557,17 @@ void *openTensorC(char *filename, uint64_t *idata) {
     exit(1);
   }
   // Prepare sparse tensor object with per-rank dimension sizes
-  // and the number of nonzeros as initial capacity.
+  // and the number of nonzeros.
   uint64_t rank = idata[0];
   uint64_t nnz = idata[1];
-  std::vector<uint64_t> indices(rank);
+  std::vector<uint64_t> sizes(rank);
   for (uint64_t r = 0; r < rank; r++)
-    indices[r] = idata[2 + r];
-  SparseTensor *tensor = new SparseTensor(indices, nnz);
+    sizes[r] = idata[2 + r];
+  SparseTensor *tensor = new SparseTensor(sizes, nnz);
   // Read all nonzero elements.
-  for (uint64_t k = 0; k < nnz; k++) {
-    for (uint64_t r = 0; r < rank; r++) {
-      if (fscanf(file, "%" PRIu64, &indices[r]) != 1) {
-        fprintf(stderr, "Cannot find next index in %s\n", filename);
-        exit(1);
-      }
-      indices[r]--; // 0-based index
-    }
-    double value;
-    if (fscanf(file, "%lg\n", &value) != 1) {
-      fprintf(stderr, "Cannot find next value in %s\n", filename);
-      exit(1);
-    }
-    tensor->add(indices, value);
-  }
-  // Close the file and return sorted tensor.
+  readElements(file, filename, tensor);
   fclose(file);
+  // Return sorted tensor.
   tensor->sort(); // sort lexicographically
   return tensor;
 }
@@ -410,8 +581,9 @@ void *openTensor(char *filename, uint64_t *ibase, uint64_t *idata,
 
 /// Yields the next element from the given opaque sparse tensor object.
 void readTensorItemC(void *tensor, uint64_t *idata, double *ddata) {
-  const Element &e = static_cast<SparseTensor *>(tensor)->next();
-  for (uint64_t r = 0, rank = e.indices.size(); r < rank; r++)
+  SparseTensor *t = static_cast<SparseTensor *>(tensor);
+  const Element &e = t->next();
+  for (uint64_t r = 0, rank = t->getRank(); r < rank; r++)
     idata[r] = e.indices[r];
   ddata[0] = e.value;
 }
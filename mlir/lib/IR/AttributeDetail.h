@@ -53,13 +53,15 @@ public:
 /// An attribute representing a reference to a dense vector or tensor object.
 struct DenseIntOrFPElementsAttrStorage : public DenseElementsAttributeStorage {
   DenseIntOrFPElementsAttrStorage(ShapedType ty, ArrayRef<char> data,
-                                  bool isSplat = false)
-      : DenseElementsAttributeStorage(ty, isSplat), data(data) {}
+                                  bool isSplat = false, bool isExternal = false)
+      : DenseElementsAttributeStorage(ty, isSplat), data(data),
+        isExternal(isExternal) {}
 
   struct KeyTy {
     KeyTy(ShapedType type, ArrayRef<char> data, llvm::hash_code hashCode,
-          bool isSplat = false)
-        : type(type), data(data), hashCode(hashCode), isSplat(isSplat) {}
+          bool isSplat = false, bool isExternal = false)
+        : type(type), data(data), hashCode(hashCode), isSplat(isSplat),
+          isExternal(isExternal) {}
 
     /// The type of the dense elements.
     ShapedType type;
@@ -72,13 +74,22 @@ struct DenseIntOrFPElementsAttrStorage : public DenseElementsAttributeStorage {
 
     /// A boolean that indicates if this data is a splat or not.
     bool isSplat;
+
+    /// A boolean that indicates if this data is an external buffer, which is
+    /// referenced instead of copied and is uniqued by address.
+    bool isExternal;
   };
 
   /// Compare this storage instance with the provided key.
   bool operator==(const KeyTy &key) const {
-    if (key.type != getType())
+    if (key.type != getType() || key.isExternal != isExternal)
       return false;
 
+    // External buffers are compared by identity.
+    if (isExternal)
+      return key.isSplat == isSplat && key.data.data() == data.data() &&
+             key.data.size() == data.size();
+
     // For boolean splats we need to explicitly check that the first bit is the
     // same. Boolean values are packed at the bit level, and even though a splat
     // is detected the rest of the bits in the first byte may differ from the
@@ -138,6 +149,16 @@ struct DenseIntOrFPElementsAttrStorage : public DenseElementsAttributeStorage {
     return KeyTy(ty, firstElt, hashVal, /*isSplat=*/true);
   }
 
+  /// Construct a key for an external data buffer. The data is neither hashed
+  /// nor checked for splats, which would touch every page of the buffer.
+  static KeyTy getKey(ShapedType ty, ArrayRef<char> data, bool isSplat,
+                      bool isExternal) {
+    if (!isExternal)
+      return getKey(ty, data, isSplat);
+    return KeyTy(ty, data, llvm::hash_combine(data.data(), data.size()),
+                 isSplat, isExternal);
+  }
+
   /// Construct a key with a set of boolean data.
   static KeyTy getKeyForBoolData(ShapedType ty, ArrayRef<char> data,
                                  size_t numElements) {
@@ -181,6 +202,12 @@ struct DenseIntOrFPElementsAttrStorage : public DenseElementsAttributeStorage {
   /// Construct a new storage instance.
   static DenseIntOrFPElementsAttrStorage *
   construct(AttributeStorageAllocator &allocator, KeyTy key) {
+    // External buffers are owned by the user, and are used in place.
+    if (key.isExternal)
+      return new (allocator.allocate<DenseIntOrFPElementsAttrStorage>())
+          DenseIntOrFPElementsAttrStorage(key.type, key.data, key.isSplat,
+                                          /*isExternal=*/true);
+
     // If the data buffer is non-empty, we copy it into the allocator with a
     // 64-bit alignment.
     ArrayRef<char> copy, data = key.data;
@@ -200,6 +227,10 @@ struct DenseIntOrFPElementsAttrStorage : public DenseElementsAttributeStorage {
   }
 
   ArrayRef<char> data;
+
+  /// If the data refers to an external buffer rather than to a copy owned by
+  /// the context.
+  bool isExternal;
 };
 
 /// An attribute representing a reference to a dense vector or tensor object
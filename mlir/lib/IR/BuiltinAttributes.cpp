@@ -769,6 +769,14 @@ DenseElementsAttr DenseElementsAttr::getFromRawBuffer(ShapedType type,
   return DenseIntOrFPElementsAttr::getRaw(type, rawBuffer, isSplatBuffer);
 }
 
+DenseElementsAttr
+DenseElementsAttr::getFromExternalRawBuffer(ShapedType type,
+                                            ArrayRef<char> rawBuffer,
+                                            bool isSplatBuffer) {
+  return DenseIntOrFPElementsAttr::getRawExternal(type, rawBuffer,
+                                                  isSplatBuffer);
+}
+
 /// Returns true if the given buffer is a valid raw buffer for the given type.
 bool DenseElementsAttr::isValidRawBuffer(ShapedType type,
                                          ArrayRef<char> rawBuffer,
@@ -1013,6 +1021,21 @@ DenseElementsAttr DenseIntOrFPElementsAttr::getRaw(ShapedType type,
   return Base::get(type.getContext(), type, data, isSplat);
 }
 
+DenseElementsAttr DenseIntOrFPElementsAttr::getRawExternal(ShapedType type,
+                                                           ArrayRef<char> data,
+                                                           bool isSplat) {
+  assert((type.isa<RankedTensorType, VectorType>()) &&
+         "type must be ranked tensor or vector");
+  assert(type.hasStaticShape() && "type must have static shape");
+  // The data is neither copied nor scanned, so it must have the right size.
+  bool detectedSplat = false;
+  assert(isValidRawBuffer(type, data, detectedSplat) &&
+         (!isSplat || detectedSplat) && "invalid raw buffer for the type");
+  (void)detectedSplat;
+  return Base::get(type.getContext(), type, data, isSplat,
+                   /*isExternal=*/true);
+}
+
 /// Overload of the raw 'get' method that asserts that the given type is of
 /// complex type. This method is used to verify type invariants that the
 /// templatized 'get' method cannot.
@@ -580,11 +580,29 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
     }
   }
 
+  // Schedule the largest operations first when there are more operations than
+  // executors, so that a large operation picked up last doesn't leave the
+  // other threads idle while it is processed. The operations are otherwise
+  // handed out dynamically, as the executors become available.
+  SmallVector<unsigned, 8> schedule(llvm::seq<unsigned>(0, opAMPairs.size()));
+  if (opAMPairs.size() > asyncExecutors.size()) {
+    SmallVector<size_t, 8> opSizes;
+    opSizes.reserve(opAMPairs.size());
+    for (auto &it : opAMPairs) {
+      size_t numOps = 0;
+      it.first->walk([&](Operation *) { ++numOps; });
+      opSizes.push_back(numOps);
+    }
+    llvm::stable_sort(schedule, [&](unsigned lhs, unsigned rhs) {
+      return opSizes[lhs] > opSizes[rhs];
+    });
+  }
+
   // A parallel diagnostic handler that provides deterministic diagnostic
   // ordering.
   ParallelDiagnosticHandler diagHandler(&getContext());
 
-  // An index for the current operation/analysis manager pair.
+  // An index for the next operation to schedule.
   std::atomic<unsigned> opIt(0);
 
   // Get the current thread for this adaptor.
@@ -601,11 +619,14 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
       [&](MutableArrayRef<OpPassManager> pms) {
         for (auto e = opAMPairs.size(); !passFailed && opIt < e;) {
           // Get the next available operation index.
-          unsigned nextID = opIt++;
-          if (nextID >= e)
+          unsigned nextIndex = opIt++;
+          if (nextIndex >= e)
             break;
+          unsigned nextID = schedule[nextIndex];
 
-          // Set the order id for this thread in the diagnostic handler.
+          // Set the order id for this thread in the diagnostic handler. This is
+          // the position of the operation in the IR, which keeps diagnostics
+          // ordering independent of the schedule.
           diagHandler.setOrderIDForThread(nextID);
 
           // Get the pass manager for this operation and execute it.
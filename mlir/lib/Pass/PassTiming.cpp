@@ -14,6 +14,7 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/Threading.h"
 #include <chrono>
 
@@ -66,11 +67,12 @@ struct Timer {
   /// Start the timer.
   void start() { startTime = std::chrono::system_clock::now(); }
 
-  /// Stop the timer.
-  void stop() {
+  /// Stop the timer, and return the time elapsed since it was started.
+  std::chrono::nanoseconds stop() {
     auto newTime = std::chrono::system_clock::now() - startTime;
     wallTime += newTime;
     userTime += newTime;
+    return newTime;
   }
 
   /// Get or create a child timer with the provided name and id.
@@ -196,6 +198,11 @@ struct PassTiming : public PassInstrumentation {
     return activeTimers.pop_back_val();
   }
 
+  /// Stop the given pass or analysis timer, which was the last active timer of
+  /// the current thread, and account for the time in the busy time of the
+  /// thread if it isn't nested within another pass or analysis.
+  void stopPassOrAnalysisTimer(Timer *timer);
+
   /// Print the timing result in list mode.
   void printResultsAsList(raw_ostream &os, Timer *root, TimeRecord totalTime);
 
@@ -203,6 +210,9 @@ struct PassTiming : public PassInstrumentation {
   void printResultsAsPipeline(raw_ostream &os, Timer *root,
                               TimeRecord totalTime);
 
+  /// Print the time each thread spent executing passes.
+  void printThreadUtilization(raw_ostream &os, TimeRecord totalTime);
+
   /// Returns a timer for the provided identifier and name.
   Timer *getTimer(const void *id, TimerKind kind,
                   std::function<std::string()> &&nameBuilder) {
@@ -232,6 +242,14 @@ struct PassTiming : public PassInstrumentation {
   /// A stack of the currently active pass timers per thread.
   DenseMap<uint64_t, SmallVector<Timer *, 4>> activeThreadTimers;
 
+  /// The time each thread spent executing passes and analyses, in the order
+  /// the threads were first seen.
+  llvm::MapVector<uint64_t, std::chrono::nanoseconds> threadBusyTimes;
+
+  /// Mutex guarding threadBusyTimes, which is updated by every thread that
+  /// runs passes.
+  llvm::sys::SmartMutex<true> threadBusyTimesMutex;
+
   /// The configuration object to use when printing the timing results.
   std::unique_ptr<PassManager::PassTimingConfig> config;
 
@@ -311,12 +329,30 @@ void PassTiming::runAfterPass(Pass *pass, Operation *) {
     pipelinesToMerge.erase(toMerge);
   }
 
-  timer->stop();
+  // Adaptors aren't timed, they gather their total from their held passes.
+  if (timer->kind == TimerKind::PassOrAnalysis)
+    stopPassOrAnalysisTimer(timer);
+  else
+    timer->stop();
 }
 
 /// Stop a timer.
 void PassTiming::runAfterAnalysis(StringRef, TypeID, Operation *) {
-  popLastActiveTimer()->stop();
+  stopPassOrAnalysisTimer(popLastActiveTimer());
+}
+
+void PassTiming::stopPassOrAnalysisTimer(Timer *timer) {
+  std::chrono::nanoseconds elapsed = timer->stop();
+
+  // Analyses computed by a pass, and passes run by a dynamic pipeline, are
+  // already part of the time of the enclosing pass.
+  auto tid = llvm::get_threadid();
+  if (llvm::none_of(activeThreadTimers[tid], [](Timer *activeTimer) {
+        return activeTimer->kind == TimerKind::PassOrAnalysis;
+      })) {
+    llvm::sys::SmartScopedLock<true> lock(threadBusyTimesMutex);
+    threadBusyTimes[tid] += elapsed;
+  }
 }
 
 /// Utility to print the timer heading information.
@@ -364,11 +400,13 @@ void PassTiming::print() {
       break;
     }
     printTimeEntry(os, 0, "Total", totalTime, totalTime);
+    printThreadUtilization(os, totalTime);
     os.flush();
 
     // Reset root timers.
     rootTimers.clear();
     activeThreadTimers.clear();
+    threadBusyTimes.clear();
   };
 
   config->printTiming(printCallback);
@@ -453,6 +491,26 @@ void PassTiming::printResultsAsPipeline(raw_ostream &os, Timer *root,
     printTimer(0, topLevelTimer.second.get());
 }
 
+/// Print the time each thread spent executing passes, relative to the total
+/// execution time. This shows how well the threads were utilized when nested
+/// pipelines are run in parallel.
+void PassTiming::printThreadUtilization(raw_ostream &os, TimeRecord totalTime) {
+  // There is nothing interesting to show if everything ran on one thread.
+  if (threadBusyTimes.size() < 2)
+    return;
+
+  os << "\n   ---Busy Time---  --- Thread ---\n";
+  TimeRecord wallTime(totalTime.wall, totalTime.wall);
+  for (auto &it : llvm::enumerate(threadBusyTimes)) {
+    double busyTime =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            it.value().second)
+            .count();
+    printTimeEntry(os, 0, ("Thread #" + Twine(it.index())).str(),
+                   TimeRecord(busyTime, busyTime), wallTime);
+  }
+}
+
 // Out-of-line as key function.
 PassManager::PassTimingConfig::~PassTimingConfig() {}
 
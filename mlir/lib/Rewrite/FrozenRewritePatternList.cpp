@@ -58,6 +58,24 @@ FrozenRewritePatternList::FrozenRewritePatternList(
     : impl(std::make_shared<Impl>()) {
   impl->nativePatterns = std::move(patterns.getNativePatterns());
 
+  // Separate the native patterns by root kind, and sort them by static benefit
+  // to simplify lookup later on.
+  for (const std::unique_ptr<RewritePattern> &pat : impl->nativePatterns) {
+    if (pat->getBenefit().isImpossibleToMatch())
+      continue;
+    if (Optional<OperationName> opName = pat->getRootKind())
+      impl->nativeOpSpecificPatternMap[*opName].push_back(pat.get());
+    else
+      impl->nativeAnyOpPatterns.push_back(pat.get());
+  }
+  auto cmp = [](const RewritePattern *lhs, const RewritePattern *rhs) {
+    return lhs->getBenefit() > rhs->getBenefit();
+  };
+  for (auto &it : impl->nativeOpSpecificPatternMap)
+    std::stable_sort(it.second.begin(), it.second.end(), cmp);
+  std::stable_sort(impl->nativeAnyOpPatterns.begin(),
+                   impl->nativeAnyOpPatterns.end(), cmp);
+
   // Generate the bytecode for the PDL patterns if any were provided.
   PDLPatternModule &pdlPatterns = patterns.getPDLPatterns();
   ModuleOp pdlModule = pdlPatterns.getModule();
@@ -38,7 +38,9 @@ void PatternApplicator::applyCostModel(CostModel model) {
       mutableByteCodeState->updatePatternBenefit(it.index(), model(it.value()));
   }
 
-  // Separate patterns by root kind to simplify lookup later on.
+  // Separate patterns by root kind to simplify lookup later on. This starts
+  // from the registration order, so that patterns with equal benefit under
+  // `model` keep their relative order.
   patterns.clear();
   anyOpPatterns.clear();
   for (const auto &pat : frozenPatternList.getNativePatterns()) {
@@ -98,6 +100,24 @@ void PatternApplicator::applyCostModel(CostModel model) {
   processPatternList(anyOpPatterns);
 }
 
+void PatternApplicator::applyDefaultCostModel() {
+  // The frozen list already sorted the native patterns by their static
+  // benefit, so there is nothing to recompute for them. The bytecode patterns
+  // only need their benefits reset, in case a different model was applied
+  // before.
+  if (const PDLByteCode *bytecode = frozenPatternList.getPDLByteCode()) {
+    for (auto it : llvm::enumerate(bytecode->getPatterns()))
+      mutableByteCodeState->updatePatternBenefit(it.index(),
+                                                 it.value().getBenefit());
+  }
+  patterns.clear();
+  for (const auto &it : frozenPatternList.getOpSpecificNativePatterns())
+    patterns[it.first].assign(it.second.begin(), it.second.end());
+  ArrayRef<const RewritePattern *> anyPatterns =
+      frozenPatternList.getMatchAnyOpNativePatterns();
+  anyOpPatterns.assign(anyPatterns.begin(), anyPatterns.end());
+}
+
 void PatternApplicator::walkAllPatterns(
     function_ref<void(const Pattern &)> walk) {
   for (const Pattern &it : frozenPatternList.getNativePatterns())
@@ -72,6 +72,68 @@ private:
   };
   using StorageTypeSet = DenseSet<HashedStorage, StorageKeyInfo>;
 
+#if LLVM_ENABLE_THREADS != 0
+  /// This class represents an append-only open addressing table of storage
+  /// instances, that allows for finding existing instances without acquiring
+  /// any lock. Entries are only inserted while holding the writer lock of the
+  /// owning shard and are never removed, so readers only need to observe fully
+  /// published entries.
+  class LockFreeIndex {
+  public:
+    explicit LockFreeIndex(size_t capacity)
+        : entries(new Entry[capacity]), capacity(capacity) {
+      assert(llvm::isPowerOf2_64(capacity) &&
+             "the capacity is required to be a power of 2");
+    }
+
+    /// Return an existing instance matching the given key, or null if there
+    /// is none.
+    BaseStorage *lookup(const LookupKey &key) const {
+      for (size_t i = key.hashValue;; ++i) {
+        const Entry &entry = entries[i & (capacity - 1)];
+        BaseStorage *storage = entry.storage.load(std::memory_order_acquire);
+        if (!storage)
+          return nullptr;
+        if (entry.hashValue.load(std::memory_order_relaxed) == key.hashValue &&
+            key.isEqual(storage))
+          return storage;
+      }
+    }
+
+    /// Insert a new instance, which must not already be in the index.
+    void insert(unsigned hashValue, BaseStorage *storage) {
+      assert(hasRoomForInsertion() && "inserting into a full index");
+      for (size_t i = hashValue;; ++i) {
+        Entry &entry = entries[i & (capacity - 1)];
+        if (entry.storage.load(std::memory_order_relaxed))
+          continue;
+        // Publish the hash value before the storage instance, readers use the
+        // latter to detect that the entry is valid.
+        entry.hashValue.store(hashValue, std::memory_order_relaxed);
+        entry.storage.store(storage, std::memory_order_release);
+        ++size;
+        return;
+      }
+    }
+
+    /// Returns true if an instance can be inserted while keeping the probe
+    /// sequences short, i.e. the table at most half full.
+    bool hasRoomForInsertion() const { return (size + 1) * 2 <= capacity; }
+
+    /// Return the number of entries in the table.
+    size_t getCapacity() const { return capacity; }
+
+  private:
+    struct Entry {
+      std::atomic<unsigned> hashValue{0};
+      std::atomic<BaseStorage *> storage{nullptr};
+    };
+    std::unique_ptr<Entry[]> entries;
+    size_t capacity;
+    size_t size = 0;
+  };
+#endif
+
   /// This class represents a single shard of the uniquer. The uniquer uses a
   /// set of shards to allow for multiple threads to create instances with less
   /// lock contention.
@@ -85,6 +147,14 @@ private:
 #if LLVM_ENABLE_THREADS != 0
     /// A mutex to keep uniquing thread-safe.
     llvm::sys::SmartRWMutex<true> mutex;
+
+    /// An index of `instances` that may be queried without holding `mutex`.
+    std::atomic<LockFreeIndex *> index{nullptr};
+
+    /// The storage of the current index, and of the indices it replaced as
+    /// `instances` grew. Replaced indices are kept alive as readers may still
+    /// be probing them.
+    std::vector<std::unique_ptr<LockFreeIndex>> indexStorage;
 #endif
   };
 
@@ -95,11 +165,39 @@ private:
                     function_ref<BaseStorage *(StorageAllocator &)> ctorFn) {
     auto existing = shard.instances.insert_as({key.hashValue}, key);
     BaseStorage *&storage = existing.first->storage;
-    if (existing.second)
+    if (existing.second) {
       storage = ctorFn(shard.allocator);
+#if LLVM_ENABLE_THREADS != 0
+      addToIndex(shard, key.hashValue, storage);
+#endif
+    }
     return storage;
   }
 
+#if LLVM_ENABLE_THREADS != 0
+  /// Add a newly created instance to the lock-free index of the given shard.
+  /// This must only be called when the shard is not accessed concurrently, or
+  /// while holding its writer lock.
+  void addToIndex(Shard &shard, unsigned hashValue, BaseStorage *storage) {
+    LockFreeIndex *index = shard.index.load(std::memory_order_relaxed);
+    if (index && index->hasRoomForInsertion()) {
+      index->insert(hashValue, storage);
+      return;
+    }
+
+    // Otherwise, build a larger index from the instances of the shard, which
+    // already contain the new instance, and publish it.
+    size_t capacity = index ? index->getCapacity() * 2 : 64;
+    while (shard.instances.size() * 2 > capacity)
+      capacity *= 2;
+    auto newIndex = std::make_unique<LockFreeIndex>(capacity);
+    for (HashedStorage &instance : shard.instances)
+      newIndex->insert(instance.hashValue, instance.storage);
+    shard.index.store(newIndex.get(), std::memory_order_release);
+    shard.indexStorage.push_back(std::move(newIndex));
+  }
+#endif
+
   /// Destroy all of the storage instances within the given shard.
   void destroyShardInstances(Shard &shard) {
     if (!destructorFn)
@@ -147,12 +245,12 @@ public:
     if (localInst)
       return localInst;
 
-    // Check for an existing instance in read-only mode.
-    {
-      llvm::sys::SmartScopedReader<true> typeLock(shard.mutex);
-      auto it = shard.instances.find_as(lookupKey);
-      if (it != shard.instances.end())
-        return localInst = it->storage;
+    // Check for an existing instance in the lock-free index of the shard. The
+    // index contains every instance of the shard, aside from those being
+    // inserted concurrently, which are handled under the writer-lock below.
+    if (LockFreeIndex *index = shard.index.load(std::memory_order_acquire)) {
+      if (BaseStorage *storage = index->lookup(lookupKey))
+        return localInst = storage;
     }
 
     // Acquire a writer-lock so that we can safely create the new storage
@@ -16,14 +16,31 @@
 #include "mlir/Translation.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
 
 using namespace mlir;
 
+static llvm::cl::opt<unsigned> clNumPartitions(
+    "mlir-to-llvmir-partitions",
+    llvm::cl::desc("Translate into at most this many LLVM IR modules, in "
+                   "parallel, and print them one after the other"),
+    llvm::cl::init(0));
+
 namespace mlir {
 void registerToLLVMIRTranslation() {
   TranslateFromMLIRRegistration registration(
       "mlir-to-llvmir",
       [](ModuleOp module, raw_ostream &output) {
+        if (clNumPartitions != 0) {
+          SmallVector<LLVMModuleAndContext, 8> llvmModules;
+          if (failed(translateModuleToLLVMIR(module, clNumPartitions,
+                                             llvmModules)))
+            return failure();
+          for (LLVMModuleAndContext &llvmModule : llvmModules)
+            llvmModule.second->print(output, nullptr);
+          return success();
+        }
+
         llvm::LLVMContext llvmContext;
         auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
         if (!llvmModule)
@@ -20,12 +20,14 @@
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/RegionGraphTraits.h"
 #include "mlir/Support/LLVM.h"
 #include "mlir/Target/LLVMIR/LLVMTranslationInterface.h"
 #include "mlir/Target/LLVMIR/TypeTranslation.h"
 #include "llvm/ADT/TypeSwitch.h"
 
+#include "llvm/ADT/EquivalenceClasses.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Frontend/OpenMP/OMPIRBuilder.h"
@@ -39,9 +41,12 @@
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 
+#include <atomic>
+
 using namespace mlir;
 using namespace mlir::LLVM;
 using namespace mlir::LLVM::detail;
@@ -189,9 +194,11 @@ llvm::Constant *mlir::LLVM::detail::getLLVMConstant(
   return nullptr;
 }
 
-ModuleTranslation::ModuleTranslation(Operation *module,
-                                     std::unique_ptr<llvm::Module> llvmModule)
+ModuleTranslation::ModuleTranslation(
+    Operation *module, std::unique_ptr<llvm::Module> llvmModule,
+    const DenseSet<Operation *> *definitions)
     : mlirModule(module), llvmModule(std::move(llvmModule)),
+      definitions(definitions),
       debugTranslation(
           std::make_unique<DebugTranslation>(module, *this->llvmModule)),
       typeTranslator(this->llvmModule->getContext()),
@@ -364,10 +371,32 @@ static Block &getModuleBody(Operation *module) {
   return module->getRegion(0).front();
 }
 
+/// Returns true if the given function or global has a linkage that makes it
+/// only visible within its module.
+static bool hasLocalLinkage(Operation *op) {
+  Linkage linkage = isa<LLVMFuncOp>(op) ? cast<LLVMFuncOp>(op).linkage()
+                                        : cast<GlobalOp>(op).linkage();
+  return linkage == Linkage::Private || linkage == Linkage::Internal;
+}
+
 /// Create named global variables that correspond to llvm.mlir.global
 /// definitions.
 LogicalResult ModuleTranslation::convertGlobals() {
   for (auto op : getModuleBody(mlirModule).getOps<LLVM::GlobalOp>()) {
+    // Globals defined in another partition of the module are only declared, or
+    // omitted if they cannot be referenced from other modules.
+    if (!isDefinedHere(op)) {
+      if (hasLocalLinkage(op) || op.linkage() == Linkage::Appending)
+        continue;
+      auto *var = new llvm::GlobalVariable(
+          *llvmModule, convertType(op.getType()), op.constant(),
+          llvm::GlobalValue::ExternalLinkage, /*Initializer=*/nullptr,
+          op.sym_name(), /*InsertBefore=*/nullptr,
+          llvm::GlobalValue::NotThreadLocal, op.addr_space());
+      globalsMapping.try_emplace(op, var);
+      continue;
+    }
+
     llvm::Type *type = convertType(op.getType());
     llvm::Constant *cst = llvm::UndefValue::get(type);
     if (op.getValueOrNull()) {
@@ -603,11 +632,18 @@ LogicalResult ModuleTranslation::convertFunctionSignatures() {
   // Declare all functions first because there may be function calls that form a
   // call graph with cycles, or global initializers that reference functions.
   for (auto function : getModuleBody(mlirModule).getOps<LLVMFuncOp>()) {
+    // Functions defined in another partition of the module are only declared,
+    // or omitted if they cannot be referenced from other modules.
+    bool isDefined = isDefinedHere(function);
+    if (!isDefined && hasLocalLinkage(function))
+      continue;
+
     llvm::FunctionCallee llvmFuncCst = llvmModule->getOrInsertFunction(
         function.getName(),
         cast<llvm::FunctionType>(convertType(function.getType())));
     llvm::Function *llvmFunc = cast<llvm::Function>(llvmFuncCst.getCallee());
-    llvmFunc->setLinkage(convertLinkageToLLVM(function.linkage()));
+    llvmFunc->setLinkage(isDefined ? convertLinkageToLLVM(function.linkage())
+                                   : llvm::GlobalValue::ExternalLinkage);
     mapFunction(function.getName(), llvmFunc);
 
     // Forward the pass-through attributes to LLVM.
@@ -622,8 +658,8 @@ LogicalResult ModuleTranslation::convertFunctionSignatures() {
 LogicalResult ModuleTranslation::convertFunctions() {
   // Convert functions.
   for (auto function : getModuleBody(mlirModule).getOps<LLVMFuncOp>()) {
-    // Ignore external functions.
-    if (function.isExternal())
+    // Ignore external functions, and functions defined in another partition.
+    if (function.isExternal() || !isDefinedHere(function))
       continue;
 
     if (failed(convertOneFunction(function)))
@@ -725,18 +761,13 @@ prepareLLVMModule(Operation *m, llvm::LLVMContext &llvmContext,
 }
 
 std::unique_ptr<llvm::Module>
-mlir::translateModuleToLLVMIR(Operation *module, llvm::LLVMContext &llvmContext,
-                              StringRef name) {
-  if (!satisfiesLLVMModule(module))
-    return nullptr;
-  if (failed(checkSupportedModuleOps(module)))
-    return nullptr;
+ModuleTranslation::translate(Operation *module, llvm::LLVMContext &llvmContext,
+                             StringRef name,
+                             const DenseSet<Operation *> *definitions) {
   std::unique_ptr<llvm::Module> llvmModule =
       prepareLLVMModule(module, llvmContext, name);
 
-  LLVM::ensureDistinctSuccessors(module);
-
-  ModuleTranslation translator(module, std::move(llvmModule));
+  ModuleTranslation translator(module, std::move(llvmModule), definitions);
   if (failed(translator.convertFunctionSignatures()))
     return nullptr;
   if (failed(translator.convertGlobals()))
@@ -750,3 +781,154 @@ mlir::translateModuleToLLVMIR(Operation *module, llvm::LLVMContext &llvmContext,
 
   return std::move(translator.llvmModule);
 }
+
+std::unique_ptr<llvm::Module>
+mlir::translateModuleToLLVMIR(Operation *module, llvm::LLVMContext &llvmContext,
+                              StringRef name) {
+  if (!satisfiesLLVMModule(module))
+    return nullptr;
+  if (failed(checkSupportedModuleOps(module)))
+    return nullptr;
+
+  LLVM::ensureDistinctSuccessors(module);
+  return ModuleTranslation::translate(module, llvmContext, name);
+}
+
+/// Returns true if the given function or global is only a declaration.
+static bool isDeclaration(Operation *op) {
+  if (auto function = dyn_cast<LLVMFuncOp>(op))
+    return function.isExternal();
+  auto global = cast<GlobalOp>(op);
+  if (global.linkage() == Linkage::ExternWeak)
+    return true;
+  return global.linkage() == Linkage::External && !global.getValueOrNull() &&
+         !global.getInitializerBlock();
+}
+
+/// Splits the function and global definitions of the given module into at most
+/// `numPartitions` sets, balanced by the number of operations they contain.
+/// Definitions with local linkage are placed in the same set as the
+/// definitions that refer to them. Declarations are part of every set.
+static SmallVector<DenseSet<Operation *>, 8>
+partitionDefinitions(Operation *module, unsigned numPartitions) {
+  SymbolTable symbolTable(module);
+  SmallVector<Operation *, 8> declarations, definitions;
+  llvm::EquivalenceClasses<Operation *> components;
+  DenseMap<Operation *, unsigned> sizes;
+  for (Operation &op : getModuleBody(module)) {
+    if (!isa<LLVMFuncOp, GlobalOp>(op))
+      continue;
+    if (isDeclaration(&op)) {
+      declarations.push_back(&op);
+      continue;
+    }
+    definitions.push_back(&op);
+    components.insert(&op);
+
+    // Compute the size of the definition, and group it with the definitions
+    // with local linkage that it refers to.
+    unsigned &size = sizes[&op];
+    op.walk([&](Operation *nested) {
+      ++size;
+      for (NamedAttribute attr : nested->getAttrs()) {
+        auto symbolRef = attr.second.dyn_cast<FlatSymbolRefAttr>();
+        if (!symbolRef)
+          continue;
+        Operation *symbol = symbolTable.lookup(symbolRef.getValue());
+        if (symbol && isa<LLVMFuncOp, GlobalOp>(symbol) &&
+            !isDeclaration(symbol) && hasLocalLinkage(symbol))
+          components.unionSets(&op, symbol);
+      }
+    });
+  }
+
+  // Collect the size of each group of definitions, in module order to keep the
+  // partitioning deterministic.
+  DenseMap<Operation *, unsigned> componentIndices;
+  SmallVector<std::pair<Operation *, unsigned>, 8> componentSizes;
+  for (Operation *op : definitions) {
+    Operation *leader = components.getLeaderValue(op);
+    auto it = componentIndices.try_emplace(leader, componentSizes.size());
+    if (it.second)
+      componentSizes.emplace_back(leader, 0);
+    componentSizes[it.first->second].second += sizes[op];
+  }
+
+  // Assign the largest groups first, each to the partition that has the
+  // smallest size so far.
+  llvm::stable_sort(componentSizes, [](const auto &lhs, const auto &rhs) {
+    return lhs.second > rhs.second;
+  });
+  numPartitions = std::max<size_t>(
+      1, std::min<size_t>(numPartitions, componentSizes.size()));
+  SmallVector<unsigned, 8> partitionSizes(numPartitions, 0);
+  DenseMap<Operation *, unsigned> componentPartitions;
+  for (auto &component : componentSizes) {
+    unsigned partition = std::distance(
+        partitionSizes.begin(), llvm::min_element(partitionSizes));
+    partitionSizes[partition] += component.second;
+    componentPartitions[component.first] = partition;
+  }
+
+  SmallVector<DenseSet<Operation *>, 8> partitions(numPartitions);
+  for (Operation *op : definitions)
+    partitions[componentPartitions[components.getLeaderValue(op)]].insert(op);
+  for (DenseSet<Operation *> &partition : partitions)
+    partition.insert(declarations.begin(), declarations.end());
+  return partitions;
+}
+
+LogicalResult mlir::translateModuleToLLVMIR(
+    Operation *module, unsigned numPartitions,
+    SmallVectorImpl<LLVMModuleAndContext> &llvmModules, StringRef name) {
+  if (!satisfiesLLVMModule(module))
+    return failure();
+  if (failed(checkSupportedModuleOps(module)))
+    return failure();
+
+  // Make sure that the module is not modified, nor any dialect loaded, while
+  // the partitions are translated concurrently.
+  MLIRContext *context = module->getContext();
+  context->getOrLoadDialect<LLVM::LLVMDialect>();
+  LLVM::ensureDistinctSuccessors(module);
+
+  SmallVector<DenseSet<Operation *>, 8> partitions =
+      partitionDefinitions(module, numPartitions);
+  size_t firstModule = llvmModules.size();
+  llvmModules.resize(firstModule + partitions.size());
+  auto translatePartition = [&](size_t i) {
+    auto llvmContext = std::make_unique<llvm::LLVMContext>();
+    std::string partitionName =
+        partitions.size() == 1 ? name.str() : (name + "." + Twine(i)).str();
+    std::unique_ptr<llvm::Module> llvmModule = ModuleTranslation::translate(
+        module, *llvmContext, partitionName, &partitions[i]);
+    if (!llvmModule)
+      return failure();
+    llvmModules[firstModule + i] = {std::move(llvmContext),
+                                    std::move(llvmModule)};
+    return success();
+  };
+
+  std::atomic<bool> translationFailed(false);
+  if (!context->isMultithreadingEnabled() || partitions.size() == 1) {
+    for (size_t i = 0, e = partitions.size(); i != e; ++i)
+      if (failed(translatePartition(i)))
+        translationFailed = true;
+  } else {
+    // Translate the partitions in parallel, keeping the diagnostics in
+    // partition order.
+    ParallelDiagnosticHandler handler(context);
+    llvm::parallelForEachN(0, partitions.size(), [&](size_t i) {
+      handler.setOrderIDForThread(i);
+      if (failed(translatePartition(i)))
+        translationFailed = true;
+      handler.eraseOrderIDForThread();
+    });
+  }
+
+  if (translationFailed) {
+    llvmModules.resize(firstModule);
+    return failure();
+  }
+  return success();
+}
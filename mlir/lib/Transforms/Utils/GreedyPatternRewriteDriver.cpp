@@ -11,11 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "mlir/IR/BlockAndValueMapping.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
 #include "mlir/Transforms/FoldUtils.h"
 #include "mlir/Transforms/RegionUtils.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -83,6 +85,41 @@ protected:
   // inserted ops are added to the worklist for processing.
   void notifyOperationInserted(Operation *op) override { addToWorklist(op); }
 
+  // An operation that was modified in place may now be simplified further, so
+  // make sure to revisit it.
+  void finalizeRootUpdate(Operation *op) override { addToWorklist(op); }
+
+  // The arguments of `source` are replaced without going through the rewriter,
+  // so revisit their users as they may now be simplified further.
+  void mergeBlocks(Block *source, Block *dest,
+                   ValueRange argValues = llvm::None) override {
+    for (BlockArgument arg : source->getArguments())
+      for (Operation *user : arg.getUsers())
+        addToWorklist(user);
+    PatternRewriter::mergeBlocks(source, dest, argValues);
+  }
+
+  // Cloned operations are not inserted through the builder, add them to the
+  // worklist explicitly.
+  void cloneRegionBefore(Region &region, Region &parent,
+                         Region::iterator before,
+                         BlockAndValueMapping &mapping) override {
+    PatternRewriter::cloneRegionBefore(region, parent, before, mapping);
+    for (Block &block : region) {
+      mapping.lookup(&block)->walk(
+          [this](Operation *op) { addToWorklist(op); });
+    }
+  }
+
+  // Operations moved out of an inlined region may be simplified further in
+  // their new location, add them to the worklist.
+  void inlineRegionBefore(Region &region, Region &parent,
+                          Region::iterator before) override {
+    region.walk([this](Operation *op) { addToWorklist(op); });
+    PatternRewriter::inlineRegionBefore(region, parent, before);
+  }
+  using PatternRewriter::inlineRegionBefore;
+
   // If an operation is about to be removed, make sure it is not in our
   // worklist anymore because we'd get dangling references to it.
   void notifyOperationRemoved(Operation *op) override {
@@ -133,6 +170,17 @@ private:
 
   /// Non-pattern based folder for operations.
   OperationFolder folder;
+
+  /// The number of match attempts and failures of each pattern. These are only
+  /// collected when debug output is enabled for this file.
+  struct PatternStatistics {
+    unsigned numAttempts = 0;
+    unsigned numFailures = 0;
+  };
+  llvm::MapVector<const Pattern *, PatternStatistics> patternStats;
+
+  /// Print the statistics collected in `patternStats`.
+  void printPatternStatistics(raw_ostream &os);
 };
 } // end anonymous namespace
 
@@ -143,17 +191,31 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
   // Add the given operation to the worklist.
   auto collectOps = [this](Operation *op) { addToWorklist(op); };
 
+  // Per-pattern statistics are only collected when they will be printed, as
+  // they require a map lookup for every match attempt.
+  bool collectStats = false;
+  LLVM_DEBUG(collectStats = true);
+  auto onAttempt = [&](const Pattern &pattern) {
+    ++patternStats[&pattern].numAttempts;
+    return true;
+  };
+  auto onFailure = [&](const Pattern &pattern) {
+    ++patternStats[&pattern].numFailures;
+  };
+
   bool changed = false;
   int i = 0;
   do {
-    // Add all nested operations to the worklist.
+    // Add all nested operations to the worklist. Once the worklist has been
+    // processed, every change made through the rewriter or the folder has been
+    // propagated to the affected operations, so a subsequent iteration is only
+    // necessary when the CFG simplification below changes the regions.
     for (auto &region : regions)
       region.walk(collectOps);
 
     // These are scratch vectors used in the folding loop below.
     SmallVector<Value, 8> originalOperands, resultValues;
 
-    changed = false;
     while (!worklist.empty()) {
       auto *op = popFromWorklist();
 
@@ -166,7 +228,6 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
       if (isOpTriviallyDead(op)) {
         notifyOperationRemoved(op);
         op->erase();
-        changed = true;
         continue;
       }
 
@@ -190,27 +251,58 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
       bool inPlaceUpdate;
       if ((succeeded(folder.tryToFold(op, collectOps, preReplaceAction,
                                       &inPlaceUpdate)))) {
-        changed = true;
         if (!inPlaceUpdate)
           continue;
+
+        // The operands of the op may have changed, and its users may now be
+        // simplified further. The op itself may fold again, so revisit it
+        // before trying the patterns on it.
+        addToWorklist(originalOperands);
+        for (auto result : op->getResults())
+          for (auto *userOp : result.getUsers())
+            addToWorklist(userOp);
+        addToWorklist(op);
+        continue;
       }
 
       // Try to match one of the patterns. The rewriter is automatically
       // notified of any necessary changes, so there is nothing else to do here.
-      changed |= succeeded(matcher.matchAndRewrite(op, *this));
+      if (collectStats)
+        (void)matcher.matchAndRewrite(op, *this, onAttempt, onFailure);
+      else
+        (void)matcher.matchAndRewrite(op, *this);
     }
 
     // After applying patterns, make sure that the CFG of each of the regions is
     // kept up to date.
-    if (succeeded(simplifyRegions(regions))) {
+    changed = succeeded(simplifyRegions(regions));
+    if (changed)
       folder.clear();
-      changed = true;
-    }
   } while (changed && ++i < maxIterations);
+
+  LLVM_DEBUG(printPatternStatistics(llvm::dbgs()));
+
   // Whether the rewrite converges, i.e. wasn't changed in the last iteration.
   return !changed;
 }
 
+void GreedyPatternRewriteDriver::printPatternStatistics(raw_ostream &os) {
+  if (patternStats.empty())
+    return;
+  os << "Pattern match statistics:\n";
+  for (auto &it : patternStats) {
+    const Pattern *pattern = it.first;
+    os << "  '";
+    if (Optional<OperationName> rootKind = pattern->getRootKind())
+      os << *rootKind;
+    else
+      os << "<any>";
+    os << "' (benefit " << pattern->getBenefit().getBenefit()
+       << "): " << it.second.numAttempts << " attempts, "
+       << it.second.numFailures << " failures\n";
+  }
+}
+
 /// Rewrite the regions of the specified operation, which must be isolated from
 /// above, by repeatedly applying the highest benefit patterns in a greedy
 /// work-list driven manner. Return success if no more patterns can be matched
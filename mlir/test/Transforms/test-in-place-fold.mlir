@@ -0,0 +1,12 @@
+// RUN: mlir-opt -test-patterns %s | FileCheck %s
+
+// An operation folded in place must be revisited by the greedy driver, as it
+// may fold again.
+// CHECK-LABEL: func @fold_in_place_twice
+// CHECK-SAME:    (%[[ARG:.*]]: i32)
+func @fold_in_place_twice(%arg0 : i32) -> i32 {
+  // CHECK-NOT: test.op_in_place_two_step_fold
+  // CHECK:     return %[[ARG]]
+  %0 = "test.op_in_place_two_step_fold"(%arg0) : (i32) -> i32
+  return %0 : i32
+}
@@ -637,13 +637,21 @@ LogicalResult TestOpWithVariadicResultsAndFolder::fold(
 
 OpFoldResult TestOpInPlaceFold::fold(ArrayRef<Attribute> operands) {
   assert(operands.size() == 1);
-  if (operands.front()) {
+  if (operands.front() && operands.front() != attrAttr()) {
     (*this)->setAttr("attr", operands.front());
     return getResult();
   }
   return {};
 }
 
+OpFoldResult TestOpInPlaceTwoStepFold::fold(ArrayRef<Attribute> operands) {
+  if (!folded_once()) {
+    (*this)->setAttr("folded_once", UnitAttr::get(getContext()));
+    return getResult();
+  }
+  return op();
+}
+
 OpFoldResult TestPassthroughFold::fold(ArrayRef<Attribute> operands) {
   return getOperand();
 }
@@ -0,0 +1,181 @@
+//===- BytecodeTest.cpp - MLIR Bytecode Tests -----------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Bytecode/BytecodeReader.h"
+#include "mlir/Bytecode/BytecodeWriter.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Parser.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+namespace {
+constexpr static llvm::StringLiteral kIR = R"mlir(
+func @cfg(%arg0: i32, %arg1: i1) -> i32 {
+  %0 = "test.op"(%arg0) {
+    dense = dense<[1.0, 2.0, 3.0, 4.0]> : tensor<4xf32>,
+    splat = dense<7> : tensor<16xi32>,
+    bools = dense<[true, false, true]> : tensor<3xi1>,
+    str = "hello"
+  } : (i32) -> i32 loc(callsite("foo" at "file.mlir":3:4))
+  "test.cond_br"(%arg1, %0)[^bb1, ^bb2] : (i1, i32) -> ()
+      loc(fused["a.mlir":1:2, unknown])
+^bb1:
+  "test.br"()[^bb2] : () -> ()
+^bb2:
+  "test.return"(%arg0) : (i32) -> ()
+}
+"test.graph"() ({
+  %0 = "test.use"(%1) : (i32) -> i32
+  %1 = "test.def"(%0) : (i32) -> i32
+}) : () -> ()
+)mlir";
+
+/// Print the given operation with its locations.
+static std::string print(Operation *op) {
+  std::string str;
+  llvm::raw_string_ostream os(str);
+  op->print(os, OpPrintingFlags().enableDebugInfo());
+  return os.str();
+}
+
+TEST(Bytecode, RoundTrip) {
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  OwningModuleRef module = parseSourceString(kIR, &context);
+  ASSERT_TRUE(module);
+
+  std::string bytecode;
+  llvm::raw_string_ostream os(bytecode);
+  writeBytecodeToFile(*module, os);
+  os.flush();
+
+  llvm::MemoryBufferRef buffer(bytecode, "bytecode");
+  ASSERT_TRUE(isBytecode(buffer));
+  OwningOpRef<ModuleOp> roundTripped =
+      readBytecodeFile<ModuleOp>(buffer, &context);
+  ASSERT_TRUE(roundTripped);
+  EXPECT_EQ(print(*module), print(*roundTripped));
+}
+
+TEST(Bytecode, RoundTripInPlace) {
+  std::string bytecode, expected;
+  {
+    MLIRContext context;
+    context.allowUnregisteredDialects();
+    OwningModuleRef module = parseSourceString(kIR, &context);
+    ASSERT_TRUE(module);
+    llvm::raw_string_ostream os(bytecode);
+    writeBytecodeToFile(*module, os);
+    os.flush();
+    expected = print(*module);
+  }
+
+  // The buffer must outlive the context whose attributes refer to it.
+  std::unique_ptr<llvm::WritableMemoryBuffer> buffer =
+      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(bytecode.size(),
+                                                        "bytecode");
+  ASSERT_TRUE(buffer);
+  std::copy(bytecode.begin(), bytecode.end(), buffer->getBufferStart());
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  OwningOpRef<ModuleOp> roundTripped = readBytecodeFile<ModuleOp>(
+      buffer->getMemBufferRef(), &context, /*referenceBuffer=*/true);
+  ASSERT_TRUE(roundTripped);
+  EXPECT_EQ(expected, print(*roundTripped));
+}
+
+TEST(Bytecode, Truncated) {
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  OwningModuleRef module = parseSourceString(kIR, &context);
+  ASSERT_TRUE(module);
+
+  std::string bytecode;
+  llvm::raw_string_ostream os(bytecode);
+  writeBytecodeToFile(*module, os);
+  os.flush();
+
+  // Every prefix of the file must be rejected without crashing.
+  ScopedDiagnosticHandler handler(&context,
+                                  [](Diagnostic &) { return success(); });
+  for (size_t size = 0, e = bytecode.size(); size != e; ++size) {
+    llvm::MemoryBufferRef buffer(StringRef(bytecode).take_front(size),
+                                 "bytecode");
+    EXPECT_FALSE(readBytecodeFile<ModuleOp>(buffer, &context));
+  }
+}
+
+/// Write a module holding the given dense elements attribute, whose raw data
+/// must occur only once in the file, and flip the splat flag that precedes it.
+static std::string writeWithFlippedSplatFlag(MLIRContext &context,
+                                             StringRef attr,
+                                             StringRef rawData) {
+  std::string ir = ("\"test.op\"() {value = " + attr + "} : () -> ()").str();
+  OwningModuleRef module = parseSourceString(ir, &context);
+  EXPECT_TRUE(module);
+
+  std::string bytecode;
+  llvm::raw_string_ostream os(bytecode);
+  writeBytecodeToFile(*module, os);
+  os.flush();
+
+  // The data is preceded by the splat flag, its size, and zero padding.
+  size_t pos = bytecode.find(rawData.str());
+  EXPECT_NE(pos, std::string::npos);
+  EXPECT_EQ(bytecode.find(rawData.str(), pos + 1), std::string::npos);
+  while (bytecode[pos - 1] == 0)
+    --pos;
+  EXPECT_EQ(static_cast<size_t>(bytecode[pos - 1]), rawData.size());
+  char &isSplat = bytecode[pos - 2];
+  EXPECT_LE(isSplat, 1);
+  isSplat = !isSplat;
+  return bytecode;
+}
+
+TEST(Bytecode, MismatchedSplatFlag) {
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  std::string diag;
+  ScopedDiagnosticHandler handler(&context, [&](Diagnostic &d) {
+    diag = d.str();
+    return success();
+  });
+
+  // A splat flag on the data of every element, and its absence on the data of
+  // a single element, must both be rejected.
+  std::string nonSplat = writeWithFlippedSplatFlag(
+      context, "dense<[305419896, 2, 3, 4]> : tensor<4xi32>",
+      StringRef("\x78\x56\x34\x12\x02\0\0\0"
+                "\x03\0\0\0\x04\0\0\0",
+                16));
+  std::string splat = writeWithFlippedSplatFlag(
+      context, "dense<305419896> : tensor<16xi32>",
+      StringRef("\x78\x56\x34\x12", 4));
+  for (StringRef bytecode : {nonSplat, splat}) {
+    // Dense data is only referenced in place from an aligned buffer, which a
+    // new memory buffer is.
+    std::unique_ptr<llvm::WritableMemoryBuffer> aligned =
+        llvm::WritableMemoryBuffer::getNewUninitMemBuffer(bytecode.size(),
+                                                          "bytecode");
+    ASSERT_TRUE(aligned);
+    std::copy(bytecode.begin(), bytecode.end(), aligned->getBufferStart());
+
+    for (bool referenceBuffer : {false, true}) {
+      diag.clear();
+      EXPECT_FALSE(readBytecodeFile<ModuleOp>(aligned->getMemBufferRef(),
+                                              &context, referenceBuffer));
+      EXPECT_NE(diag.find("splat flag"), std::string::npos) << diag;
+    }
+  }
+}
+} // end anonymous namespace
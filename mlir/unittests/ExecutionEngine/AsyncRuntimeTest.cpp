@@ -0,0 +1,112 @@
+//===- AsyncRuntimeTest.cpp - Async runtime unit tests --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/AsyncRuntime.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+using namespace mlir::runtime;
+
+namespace {
+
+// Number of tasks running on the current thread, including the ones run in
+// place by an await from another task.
+thread_local int taskDepth = 0;
+std::atomic<int> maxTaskDepth(0);
+
+// Runs `fn` as an async runtime task, tracking the task nesting depth.
+void execute(std::function<void()> fn) {
+  auto *task = new std::function<void()>(std::move(fn));
+  mlirAsyncRuntimeExecute(task, [](void *handle) {
+    auto *task = static_cast<std::function<void()> *>(handle);
+    int depth = ++taskDepth;
+    int max = maxTaskDepth.load();
+    while (depth > max && !maxTaskDepth.compare_exchange_weak(max, depth))
+      ;
+    (*task)();
+    --taskDepth;
+    delete task;
+  });
+}
+
+// Awaits `token` and drops the reference owned by the caller.
+void awaitAndDrop(AsyncToken *token) {
+  mlirAsyncRuntimeAwaitToken(token);
+  mlirAsyncRuntimeDropRef(token, 1);
+}
+
+bool hasMultipleWorkers() { return std::thread::hardware_concurrency() > 1; }
+
+} // namespace
+
+TEST(AsyncRuntimeTest, AwaitFromMainThread) {
+  AsyncToken *token = mlirAsyncRuntimeCreateToken();
+  execute([token] { mlirAsyncRuntimeEmplaceToken(token); });
+  awaitAndDrop(token);
+}
+
+TEST(AsyncRuntimeTest, AwaitFromWorker) {
+  AsyncToken *inner = mlirAsyncRuntimeCreateToken();
+  AsyncToken *outer = mlirAsyncRuntimeCreateToken();
+  execute([=] {
+    execute([inner] { mlirAsyncRuntimeEmplaceToken(inner); });
+    // The inner task is queued on this worker and runs in place.
+    awaitAndDrop(inner);
+    mlirAsyncRuntimeEmplaceToken(outer);
+  });
+  awaitAndDrop(outer);
+}
+
+// A task run in place by an await must not run further queued tasks in place
+// when it awaits itself: it blocks instead, and the tasks it waits for run on
+// the other workers.
+TEST(AsyncRuntimeTest, NestedAwaitFallsBackToBlocking) {
+  if (!hasMultipleWorkers())
+    return;
+
+  for (int i = 0; i < 100; ++i) {
+    maxTaskDepth = 0;
+    AsyncToken *first = mlirAsyncRuntimeCreateToken();
+    AsyncToken *second = mlirAsyncRuntimeCreateToken();
+    AsyncToken *done = mlirAsyncRuntimeCreateToken();
+    execute([=] {
+      execute([second] { mlirAsyncRuntimeEmplaceToken(second); });
+      execute([=] {
+        awaitAndDrop(second);
+        mlirAsyncRuntimeEmplaceToken(first);
+      });
+      awaitAndDrop(first);
+      mlirAsyncRuntimeEmplaceToken(done);
+    });
+    awaitAndDrop(done);
+    EXPECT_LE(maxTaskDepth.load(), 2);
+  }
+}
+
+TEST(AsyncRuntimeTest, AwaitGroupFromWorker) {
+  constexpr int numTasks = 16;
+  AsyncToken *done = mlirAsyncRuntimeCreateToken();
+  execute([=] {
+    AsyncGroup *group = mlirAsyncRuntimeCreateGroup();
+    for (int i = 0; i < numTasks; ++i) {
+      AsyncToken *token = mlirAsyncRuntimeCreateToken();
+      mlirAsyncRuntimeAddTokenToGroup(token, group);
+      execute([token] { mlirAsyncRuntimeEmplaceToken(token); });
+      mlirAsyncRuntimeDropRef(token, 1);
+    }
+    mlirAsyncRuntimeAwaitAllInGroup(group);
+    mlirAsyncRuntimeDropRef(group, 1);
+    mlirAsyncRuntimeEmplaceToken(done);
+  });
+  awaitAndDrop(done);
+}
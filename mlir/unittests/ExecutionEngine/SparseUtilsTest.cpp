@@ -0,0 +1,115 @@
+//===- SparseUtilsTest.cpp - Sparse tensor reader unit tests --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/CRunnerUtils.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+// Writes `contents` to a temporary file with the given suffix, which is
+// removed with the returned remover.
+std::string writeTensorFile(StringRef suffix, StringRef contents,
+                            Optional<FileRemover> &remover) {
+  int fd;
+  SmallString<128> path;
+  EXPECT_FALSE(sys::fs::createTemporaryFile("sparse", suffix, fd, path));
+  remover.emplace(path);
+  raw_fd_ostream os(fd, /*shouldClose=*/true);
+  os << contents;
+  return std::string(path.str());
+}
+
+TEST(SparseUtilsTest, ReadMatrixMarket) {
+  Optional<FileRemover> remover;
+  std::string path = writeTensorFile("mtx", "%%MatrixMarket matrix coordinate "
+                                            "real general\n"
+                                            "% A comment.\n"
+                                            "3 4 4\n"
+                                            "3 1 5.5\n"
+                                            "1 4 -2.0\n"
+                                            "\n"
+                                            "1 2 1.25\n"
+                                            "2 3 3e2\n",
+                                     remover);
+
+  uint64_t idata[4];
+  void *tensor = openTensorC(&path[0], idata);
+  EXPECT_EQ(idata[0], 2u);
+  EXPECT_EQ(idata[1], 4u);
+  EXPECT_EQ(idata[2], 3u);
+  EXPECT_EQ(idata[3], 4u);
+
+  // The elements come back sorted by 0-based indices.
+  const uint64_t expectedIndices[4][2] = {{0, 1}, {0, 3}, {1, 2}, {2, 0}};
+  const double expectedValues[4] = {1.25, -2.0, 300.0, 5.5};
+  for (int k = 0; k < 4; k++) {
+    uint64_t indices[2];
+    double value;
+    readTensorItemC(tensor, indices, &value);
+    EXPECT_EQ(indices[0], expectedIndices[k][0]);
+    EXPECT_EQ(indices[1], expectedIndices[k][1]);
+    EXPECT_EQ(value, expectedValues[k]);
+  }
+  closeTensor(tensor);
+}
+
+TEST(SparseUtilsTest, ReadLargeFROSTT) {
+  // Enough elements to read the file in several blocks and to split the
+  // parsing and the sorting over threads. The elements are written in
+  // reverse order, with a value that tells where each one came from.
+  const uint64_t n = 1 << 21;
+  std::string contents = "# A comment.\n3 " + std::to_string(n) + "\n" +
+                         "64 128 256\n";
+  for (uint64_t k = n; k-- > 0;) {
+    contents += std::to_string(k / (128 * 256) + 1) + " " +
+                std::to_string(k / 256 % 128 + 1) + " " +
+                std::to_string(k % 256 + 1) + " " + std::to_string(k) + "\n";
+    if (k % 100000 == 0)
+      contents += "\n";
+  }
+  Optional<FileRemover> remover;
+  std::string path = writeTensorFile("tns", contents, remover);
+
+  uint64_t idata[5];
+  void *tensor = openTensorC(&path[0], idata);
+  EXPECT_EQ(idata[0], 3u);
+  EXPECT_EQ(idata[1], n);
+  EXPECT_EQ(idata[2], 64u);
+  EXPECT_EQ(idata[3], 128u);
+  EXPECT_EQ(idata[4], 256u);
+
+  for (uint64_t k = 0; k < n; k++) {
+    uint64_t indices[3];
+    double value;
+    readTensorItemC(tensor, indices, &value);
+    ASSERT_EQ(indices[0], k / (128 * 256));
+    ASSERT_EQ(indices[1], k / 256 % 128);
+    ASSERT_EQ(indices[2], k % 256);
+    ASSERT_EQ(value, static_cast<double>(k));
+  }
+  closeTensor(tensor);
+}
+
+TEST(SparseUtilsTest, ReadWrongNonzeroCount) {
+  Optional<FileRemover> remover;
+  std::string path = writeTensorFile("tns", "2 3\n2 2\n1 1 1.0\n2 2 2.0\n",
+                                     remover);
+  uint64_t idata[4];
+  EXPECT_EXIT(openTensorC(&path[0], idata), testing::ExitedWithCode(1),
+              "Expected 3 nonzeros but found 2");
+}
+
+} // end anonymous namespace
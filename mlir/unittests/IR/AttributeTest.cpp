@@ -203,4 +203,26 @@ TEST(DenseScalarTest, ExtractZeroRankElement) {
   EXPECT_TRUE(attr.getValue({0}) == value);
 }
 
+TEST(DenseExternalTest, ReferencesBuffer) {
+  MLIRContext context;
+  IntegerType intTy = IntegerType::get(&context, 32);
+  RankedTensorType shape = RankedTensorType::get({4}, intTy);
+  static const int32_t data[] = {1, 2, 3, 4};
+  ArrayRef<char> rawData(reinterpret_cast<const char *>(data), sizeof(data));
+
+  // The attribute uses the buffer in place, and is uniqued by its address.
+  auto external = DenseElementsAttr::getFromExternalRawBuffer(
+      shape, rawData, /*isSplatBuffer=*/false);
+  EXPECT_EQ(external.getRawData().data(), rawData.data());
+  EXPECT_EQ(external, DenseElementsAttr::getFromExternalRawBuffer(
+                          shape, rawData, /*isSplatBuffer=*/false));
+  auto copy = DenseElementsAttr::get(shape, llvm::makeArrayRef(data));
+  EXPECT_NE(external, copy);
+
+  // The usual accessors work on the external data.
+  EXPECT_FALSE(external.isSplat());
+  EXPECT_TRUE(external.getValue({2}) == IntegerAttr::get(intTy, 3));
+  EXPECT_TRUE(llvm::equal(external.getValues<int32_t>(), data));
+}
+
 } // end namespace
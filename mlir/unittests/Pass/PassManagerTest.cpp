@@ -10,8 +10,13 @@
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/Pass.h"
+#include "llvm/Support/Threading.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 using namespace mlir;
 using namespace mlir::detail;
 
@@ -75,6 +80,69 @@ TEST(PassManagerTest, OpSpecificAnalysis) {
   }
 }
 
+/// Pass that keeps the first two functions it runs on busy until both of them
+/// have started, so that they run on two threads at once.
+struct WaitForTwoFunctionsPass
+    : public PassWrapper<WaitForTwoFunctionsPass, OperationPass<FuncOp>> {
+  WaitForTwoFunctionsPass(std::atomic<unsigned> &numStarted)
+      : numStarted(numStarted) {}
+
+  void runOnOperation() override {
+    getAnalysis<GenericAnalysis>();
+    if (numStarted++ >= 2)
+      return;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (numStarted < 2 && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::yield();
+  }
+
+  std::atomic<unsigned> &numStarted;
+};
+
+/// Timing config that prints into a string.
+struct StringTimingConfig : public PassManager::PassTimingConfig {
+  StringTimingConfig(std::string &output) : output(output) {}
+  void printTiming(PrintCallbackFn printCallback) override {
+    llvm::raw_string_ostream os(output);
+    printCallback(os);
+  }
+  std::string &output;
+};
+
+TEST(PassManagerTest, TimingReportsThreadUtilization) {
+  // The functions can only run on two threads at once if there are two.
+  if (llvm::hardware_concurrency().compute_thread_count() < 2)
+    return;
+
+  MLIRContext context;
+  Builder builder(&context);
+
+  OwningModuleRef module(ModuleOp::create(UnknownLoc::get(&context)));
+  for (int i = 0; i < 8; ++i) {
+    FuncOp func =
+        FuncOp::create(builder.getUnknownLoc(), "func" + std::to_string(i),
+                       builder.getFunctionType(llvm::None, llvm::None));
+    func.setPrivate();
+    module->push_back(func);
+  }
+
+  std::string output;
+  std::atomic<unsigned> numStarted(0);
+  {
+    PassManager pm(&context);
+    pm.addNestedPass<FuncOp>(
+        std::make_unique<WaitForTwoFunctionsPass>(numStarted));
+    pm.enableTiming(std::make_unique<StringTimingConfig>(output));
+    EXPECT_TRUE(succeeded(pm.run(module.get())));
+  }
+
+  // The report is printed when the pass manager is destroyed.
+  EXPECT_NE(output.find("WaitForTwoFunctionsPass"), std::string::npos);
+  EXPECT_NE(output.find("---Busy Time---"), std::string::npos);
+  EXPECT_NE(output.find("Thread #0"), std::string::npos);
+  EXPECT_NE(output.find("Thread #1"), std::string::npos);
+}
+
 namespace {
 struct InvalidPass : Pass {
   InvalidPass() : Pass(TypeID::get<InvalidPass>(), StringRef("invalid_op")) {}
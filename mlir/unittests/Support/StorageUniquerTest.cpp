@@ -7,7 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Support/StorageUniquer.h"
+#include "llvm/Config/llvm-config.h"
 #include "gmock/gmock.h"
+#include <thread>
 
 using namespace mlir;
 
@@ -58,3 +60,38 @@ TEST(StorageUniquerTest, NonTrivialDestructor) {
 
   EXPECT_TRUE(wasDestructed);
 }
+
+#if LLVM_ENABLE_THREADS != 0
+TEST(StorageUniquerTest, ConcurrentCreation) {
+  struct IntStorage : public SimpleStorage<IntStorage, int> {
+    using Base::Base;
+  };
+  StorageUniquer uniquer;
+  uniquer.registerParametricStorageType<IntStorage>();
+
+  // Create overlapping sets of instances from several threads, enough for the
+  // tables of each shard to grow several times, and check that every thread
+  // observes the same instance for a given key.
+  constexpr int numThreads = 8, numKeys = 4096;
+  std::vector<std::vector<IntStorage *>> results(numThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != numThreads; ++t) {
+    threads.emplace_back([&, t] {
+      results[t].resize(numKeys);
+      for (int i = 0; i != numKeys; ++i) {
+        int key = (i * 7 + t * 13) % numKeys;
+        results[t][key] = IntStorage::get(uniquer, key);
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (int key = 0; key != numKeys; ++key) {
+    EXPECT_EQ(std::get<0>(results[0][key]->key), key);
+    for (int t = 1; t != numThreads; ++t)
+      EXPECT_EQ(results[t][key], results[0][key]);
+    EXPECT_EQ(IntStorage::get(uniquer, key), results[0][key]);
+  }
+}
+#endif
@@ -0,0 +1,148 @@
+//===- ModuleTranslationTest.cpp - LLVM IR translation tests --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains tests for the translation of LLVM dialect modules into
+// several LLVM IR modules.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Parser.h"
+#include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Export.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gmock/gmock.h"
+
+using namespace mlir;
+
+static const char *const moduleStr = R"mlir(
+  llvm.mlir.global private @counter(0 : i32) : i32
+  llvm.mlir.global @shared(1 : i32) : i32
+  llvm.func @ext() -> i32
+  llvm.func internal @helper() -> i32 {
+    %0 = llvm.mlir.addressof @counter : !llvm.ptr<i32>
+    %1 = llvm.load %0 : !llvm.ptr<i32>
+    llvm.return %1 : i32
+  }
+  llvm.func @a() -> i32 {
+    %0 = llvm.call @helper() : () -> i32
+    llvm.return %0 : i32
+  }
+  llvm.func @b() -> i32 {
+    %0 = llvm.call @ext() : () -> i32
+    %1 = llvm.call @a() : () -> i32
+    %2 = llvm.add %0, %1 : i32
+    llvm.return %2 : i32
+  }
+)mlir";
+
+class ModuleTranslationTest : public ::testing::Test {
+protected:
+  ModuleTranslationTest() {
+    DialectRegistry registry;
+    registry.insert<LLVM::LLVMDialect>();
+    registerLLVMDialectTranslation(registry);
+    context.appendDialectRegistry(registry);
+    module = parseSourceString(moduleStr, &context);
+  }
+
+  static std::string print(const llvm::Module &llvmModule) {
+    std::string str;
+    llvm::raw_string_ostream os(str);
+    llvmModule.print(os, nullptr);
+    return os.str();
+  }
+
+  /// Returns the index of the module that defines `name`, and checks that no
+  /// other module defines it.
+  static int getDefiningModule(ArrayRef<LLVMModuleAndContext> llvmModules,
+                               StringRef name) {
+    int index = -1;
+    for (int i = 0, e = llvmModules.size(); i != e; ++i) {
+      llvm::GlobalValue *value = llvmModules[i].second->getNamedValue(name);
+      if (!value || value->isDeclaration())
+        continue;
+      EXPECT_EQ(index, -1) << name.str() << " is defined in several modules";
+      index = i;
+    }
+    return index;
+  }
+
+  MLIRContext context;
+  OwningModuleRef module;
+};
+
+TEST_F(ModuleTranslationTest, SinglePartitionMatchesSerialTranslation) {
+  ASSERT_TRUE(!!module);
+  llvm::LLVMContext llvmContext;
+  std::unique_ptr<llvm::Module> expected =
+      translateModuleToLLVMIR(*module, llvmContext);
+  ASSERT_TRUE(!!expected);
+
+  SmallVector<LLVMModuleAndContext, 1> llvmModules;
+  ASSERT_TRUE(succeeded(translateModuleToLLVMIR(*module, 1, llvmModules)));
+  ASSERT_EQ(llvmModules.size(), 1u);
+  EXPECT_EQ(print(*llvmModules[0].second), print(*expected));
+}
+
+TEST_F(ModuleTranslationTest, DefinitionsAreSplitAcrossPartitions) {
+  ASSERT_TRUE(!!module);
+  SmallVector<LLVMModuleAndContext, 2> llvmModules;
+  ASSERT_TRUE(succeeded(translateModuleToLLVMIR(*module, 2, llvmModules)));
+  ASSERT_EQ(llvmModules.size(), 2u);
+
+  int a = getDefiningModule(llvmModules, "a");
+  int b = getDefiningModule(llvmModules, "b");
+  ASSERT_NE(a, -1);
+  ASSERT_NE(b, -1);
+  EXPECT_NE(getDefiningModule(llvmModules, "shared"), -1);
+  EXPECT_EQ(getDefiningModule(llvmModules, "ext"), -1);
+
+  // Definitions with local linkage go with their users.
+  EXPECT_EQ(getDefiningModule(llvmModules, "helper"), a);
+  EXPECT_EQ(getDefiningModule(llvmModules, "counter"), a);
+
+  for (int i = 0; i != 2; ++i) {
+    llvm::Module &llvmModule = *llvmModules[i].second;
+    // External definitions are declared everywhere else.
+    for (const char *name : {"a", "b", "shared", "ext"})
+      EXPECT_NE(llvmModule.getNamedValue(name), nullptr) << name;
+    // Local definitions are omitted from the other modules.
+    if (i != a) {
+      EXPECT_EQ(llvmModule.getNamedValue("helper"), nullptr);
+      EXPECT_EQ(llvmModule.getNamedValue("counter"), nullptr);
+    }
+  }
+}
+
+TEST_F(ModuleTranslationTest, PartitionsAreBoundedByDefinitionGroups) {
+  ASSERT_TRUE(!!module);
+  // `a`, `helper` and `counter` form one group, `b` and `shared` the others.
+  SmallVector<LLVMModuleAndContext, 8> llvmModules;
+  ASSERT_TRUE(succeeded(translateModuleToLLVMIR(*module, 8, llvmModules)));
+  EXPECT_EQ(llvmModules.size(), 3u);
+}
+
+TEST_F(ModuleTranslationTest, ParallelTranslationIsDeterministic) {
+  ASSERT_TRUE(!!module);
+  SmallVector<LLVMModuleAndContext, 3> parallelModules;
+  ASSERT_TRUE(succeeded(translateModuleToLLVMIR(*module, 3, parallelModules)));
+
+  context.disableMultithreading();
+  SmallVector<LLVMModuleAndContext, 3> serialModules;
+  ASSERT_TRUE(succeeded(translateModuleToLLVMIR(*module, 3, serialModules)));
+
+  ASSERT_EQ(parallelModules.size(), serialModules.size());
+  for (size_t i = 0, e = serialModules.size(); i != e; ++i)
+    EXPECT_EQ(print(*parallelModules[i].second),
+              print(*serialModules[i].second));
+}
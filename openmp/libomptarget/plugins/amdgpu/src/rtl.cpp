@@ -92,6 +92,7 @@ uint32_t TgtStackItemSize = 0;
   {}
 #endif
 
+#include "MemoryManager.h"
 #include "elf_common.h"
 
 /// Keep entries table per device
@@ -351,6 +352,65 @@ public:
   static const int Default_WG_Size =
       llvm::omp::AMDGPUGpuGridValues[llvm::omp::GVIDX::GV_Default_WG_Size];
 
+  /// A class responsible for interacting with ATMI to allocate and free device
+  /// memory on behalf of the memory manager.
+  class AMDGPUDeviceAllocatorTy : public DeviceAllocatorTy {
+    const int DeviceId;
+
+  public:
+    AMDGPUDeviceAllocatorTy(int DeviceId) : DeviceId(DeviceId) {}
+
+    void *allocate(size_t Size, void *) override {
+      if (Size == 0)
+        return nullptr;
+
+      void *Ptr = nullptr;
+      atmi_status_t Err = atmi_malloc(&Ptr, Size, get_gpu_mem_place(DeviceId));
+      if (Err != ATMI_STATUS_SUCCESS) {
+        DP("Error when allocating %zu bytes of device memory\n", Size);
+        return nullptr;
+      }
+
+      return Ptr;
+    }
+
+    int free(void *TgtPtr) override {
+      atmi_status_t Err = atmi_free(TgtPtr);
+      if (Err != ATMI_STATUS_SUCCESS) {
+        DP("Error when freeing device memory\n");
+        return OFFLOAD_FAIL;
+      }
+
+      return OFFLOAD_SUCCESS;
+    }
+  };
+
+  /// A vector of device allocators
+  std::vector<AMDGPUDeviceAllocatorTy> DeviceAllocators;
+
+  /// A vector of memory managers, which cache device allocations per device
+  /// so that mapping and private arguments of repeated target regions do not
+  /// go through atmi_malloc and atmi_free every time. Since the memory manager
+  /// is non-copyable and non-removable, we wrap them into std::unique_ptr.
+  std::vector<std::unique_ptr<MemoryManagerTy>> MemoryManagers;
+
+  /// Whether use memory manager
+  bool UseMemoryManager = true;
+
+  void *dataAlloc(int32_t DeviceId, int64_t Size) {
+    if (UseMemoryManager)
+      return MemoryManagers[DeviceId]->allocate(Size, nullptr);
+
+    return DeviceAllocators[DeviceId].allocate(Size, nullptr);
+  }
+
+  int dataDelete(int32_t DeviceId, void *TgtPtr) {
+    if (UseMemoryManager)
+      return MemoryManagers[DeviceId]->free(TgtPtr);
+
+    return DeviceAllocators[DeviceId].free(TgtPtr);
+  }
+
   using MemcpyFunc = atmi_status_t (*)(hsa_signal_t, void *, const void *,
                                        size_t size, hsa_agent_t);
   atmi_status_t freesignalpool_memcpy(void *dest, const void *src, size_t size,
@@ -473,6 +533,19 @@ public:
     NumThreads.resize(NumberOfDevices);
     deviceStateStore.resize(NumberOfDevices);
 
+    for (int i = 0; i < NumberOfDevices; i++)
+      DeviceAllocators.emplace_back(i);
+
+    // Get the size threshold from environment variable
+    std::pair<size_t, bool> Res = MemoryManagerTy::getSizeThresholdFromEnv();
+    UseMemoryManager = Res.second;
+    size_t MemoryManagerThreshold = Res.first;
+
+    if (UseMemoryManager)
+      for (int i = 0; i < NumberOfDevices; i++)
+        MemoryManagers.emplace_back(std::make_unique<MemoryManagerTy>(
+            DeviceAllocators[i], MemoryManagerThreshold));
+
     for (int i = 0; i < NumberOfDevices; i++) {
       uint32_t queue_size = 0;
       {
@@ -540,6 +613,8 @@ public:
     // atmi_finalize removes access to it
     deviceStateStore.clear();
     KernelArgPoolMap.clear();
+    // Return the memory cached by the memory managers while ATMI is alive
+    MemoryManagers.clear();
     // Terminate hostrpc before finalizing ATMI
     hostrpc_terminate();
     atmi_finalize();
@@ -1498,10 +1573,9 @@ void *__tgt_rtl_data_alloc(int device_id, int64_t size, void *, int32_t kind) {
     return NULL;
   }
 
-  atmi_status_t err = atmi_malloc(&ptr, size, get_gpu_mem_place(device_id));
+  ptr = DeviceInfo.dataAlloc(device_id, size);
   DP("Tgt alloc data %ld bytes, (tgt:%016llx).\n", size,
      (long long unsigned)(Elf64_Addr)ptr);
-  ptr = (err == ATMI_STATUS_SUCCESS) ? ptr : NULL;
   return ptr;
 }
 
@@ -1549,14 +1623,8 @@ int32_t __tgt_rtl_data_retrieve_async(int device_id, void *hst_ptr,
 
 int32_t __tgt_rtl_data_delete(int device_id, void *tgt_ptr) {
   assert(device_id < DeviceInfo.NumberOfDevices && "Device ID too large");
-  atmi_status_t err;
   DP("Tgt free data (tgt:%016llx).\n", (long long unsigned)(Elf64_Addr)tgt_ptr);
-  err = atmi_free(tgt_ptr);
-  if (err != ATMI_STATUS_SUCCESS) {
-    DP("Error when freeing CUDA memory\n");
-    return OFFLOAD_FAIL;
-  }
-  return OFFLOAD_SUCCESS;
+  return DeviceInfo.dataDelete(device_id, tgt_ptr);
 }
 
 // Determine launch values for threadsPerGroup and num_groups.
@@ -834,6 +834,8 @@ extern int __kmp_affinity_respect_mask; // Respect process' init affinity mask?
 extern char *__kmp_affinity_proclist; /* proc ID list */
 extern kmp_affin_mask_t *__kmp_affinity_masks;
 extern unsigned __kmp_affinity_num_masks;
+// Package (socket) id of each place, or NULL if the topology is unknown
+extern int *__kmp_affinity_place_package;
 extern void __kmp_affinity_bind_thread(int which);
 
 extern kmp_affin_mask_t *__kmp_affin_fullMask;
@@ -2191,6 +2193,14 @@ typedef enum kmp_tasking_mode {
 extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
+
+/* How a thief picks a new victim when its last victim ran dry */
+typedef enum kmp_task_steal_policy {
+  task_steal_random = 0, /* any teammate, uniformly at random */
+  task_steal_local = 1 /* prefer teammates in the same processor package */
+} kmp_task_steal_policy_t;
+
+extern kmp_task_steal_policy_t __kmp_task_steal_policy;
 extern int __kmp_enable_task_throttling;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
@@ -4258,6 +4258,27 @@ static int __kmp_affinity_cmp_Address_child_num(const void *a, const void *b) {
   return 0;
 }
 
+// Record the package of every place, so that KMP_TASK_STEALING=local can
+// tell which teammates share a socket. A place spanning several packages is
+// attributed to the first one.
+static void __kmp_affinity_find_place_packages(AddrUnsPair *address2os,
+                                               int nprocs, int depth) {
+  if (depth < 2) // flat topology, labels[0] is the proc itself
+    return;
+  __kmp_affinity_place_package =
+      (int *)__kmp_allocate(sizeof(int) * __kmp_affinity_num_masks);
+  for (unsigned p = 0; p < __kmp_affinity_num_masks; ++p) {
+    kmp_affin_mask_t *mask = KMP_CPU_INDEX(__kmp_affinity_masks, p);
+    __kmp_affinity_place_package[p] = -1;
+    for (int i = 0; i < nprocs; ++i) {
+      if (KMP_CPU_ISSET(address2os[i].second, mask)) {
+        __kmp_affinity_place_package[p] = address2os[i].first.labels[0];
+        break;
+      }
+    }
+  }
+}
+
 static void __kmp_aux_affinity_initialize(void) {
   if (__kmp_affinity_masks != NULL) {
     KMP_ASSERT(__kmp_affin_fullMask != NULL);
@@ -4768,6 +4789,7 @@ static void __kmp_aux_affinity_initialize(void) {
   }
 
   KMP_CPU_FREE_ARRAY(osId2Mask, maxIndex + 1);
+  __kmp_affinity_find_place_packages(address2os, __kmp_avail_proc, depth);
   machine_hierarchy.init(address2os, __kmp_avail_proc);
 }
 #undef KMP_EXIT_AFF_NONE
@@ -4804,6 +4826,10 @@ void __kmp_affinity_uninitialize(void) {
     __kmp_affin_fullMask = NULL;
   }
   __kmp_affinity_num_masks = 0;
+  if (__kmp_affinity_place_package != NULL) {
+    __kmp_free(__kmp_affinity_place_package);
+    __kmp_affinity_place_package = NULL;
+  }
   __kmp_affinity_type = affinity_default;
   __kmp_affinity_num_places = 0;
   if (__kmp_affinity_proclist != NULL) {
@@ -1257,6 +1257,66 @@ static bool __kmp_target_mem_available;
    MA == llvm_omp_target_shared_mem_alloc ||                                   \
    MA == llvm_omp_target_device_mem_alloc)
 
+#if KMP_OS_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Without memkind, the interleaved partition trait is implemented directly
+// with the mbind system call, on memory obtained from mmap. Pages are placed
+// round-robin on the NUMA nodes the process is allowed to allocate from.
+#define KMP_MPOL_INTERLEAVE 3
+#define KMP_MPOL_F_MEMS_ALLOWED (1 << 2)
+#define KMP_MAX_NUMA_NODES 1024
+static unsigned long
+    kmp_numa_nodes[KMP_MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
+static int __kmp_numa_interleave_available;
+static size_t kmp_page_size;
+
+static void __kmp_init_numa_interleave() {
+  __kmp_numa_interleave_available = 0;
+  if (syscall(SYS_get_mempolicy, NULL, kmp_numa_nodes, KMP_MAX_NUMA_NODES,
+              NULL, KMP_MPOL_F_MEMS_ALLOWED) != 0)
+    return;
+  int num_nodes = 0;
+  for (unsigned long word : kmp_numa_nodes)
+    num_nodes += __builtin_popcountl(word);
+  kmp_page_size = (size_t)sysconf(_SC_PAGESIZE);
+  // Interleaving over a single node is the same as not interleaving
+  __kmp_numa_interleave_available = num_nodes > 1;
+  KE_TRACE(25, ("__kmp_init_numa_interleave: %d nodes\n", num_nodes));
+}
+
+// Whether a block of size_a bytes for allocator al is mapped and interleaved
+// rather than taken from the thread's pool. Blocks smaller than a page cannot
+// be spread across nodes, so they are served by the pool.
+static inline bool __kmp_is_interleaved(kmp_allocator_t *al, size_t size_a) {
+  return (omp_allocator_handle_t)al > kmp_max_mem_alloc &&
+         al->memkind == (void *)omp_atv_interleaved &&
+         size_a >= kmp_page_size;
+}
+
+static void *__kmp_interleaved_malloc(size_t size) {
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED)
+    return NULL;
+  // The placement is only a hint, the memory is usable anyway
+  syscall(SYS_mbind, ptr, size, KMP_MPOL_INTERLEAVE, kmp_numa_nodes,
+          KMP_MAX_NUMA_NODES + 1, 0);
+  return ptr;
+}
+#endif // KMP_OS_LINUX
+
+// Allocate memory for a custom allocator when memkind is not available
+static void *__kmp_custom_malloc(int gtid, kmp_allocator_t *al, size_t size) {
+#if KMP_OS_LINUX
+  if (__kmp_is_interleaved(al, size))
+    return __kmp_interleaved_malloc(size);
+#endif
+  return __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), size);
+}
+
 #if KMP_OS_UNIX && KMP_DYNAMIC_LIB
 static inline void chk_kind(void ***pkind) {
   KMP_DEBUG_ASSERT(pkind);
@@ -1326,6 +1386,9 @@ void __kmp_init_memkind() {
   mk_dax_kmem = NULL;
   mk_dax_kmem_all = NULL;
   mk_dax_kmem_preferred = NULL;
+#if KMP_OS_LINUX
+  __kmp_init_numa_interleave();
+#endif
 }
 
 void __kmp_fini_memkind() {
@@ -1458,6 +1521,13 @@ omp_allocator_handle_t __kmpc_init_allocator(int gtid, omp_memspace_handle_t ms,
       __kmp_free(al);
       return omp_null_allocator;
     }
+#if KMP_OS_LINUX
+    // Only the interleaved partition needs special treatment; the others are
+    // served by first-touch placement of the default memory policy.
+    if (al->memkind == (void *)omp_atv_interleaved &&
+        !__kmp_numa_interleave_available)
+      al->memkind = NULL;
+#endif
   }
   return (omp_allocator_handle_t)al;
 }
@@ -1627,14 +1697,14 @@ void *__kmpc_alloc(int gtid, size_t size, omp_allocator_handle_t allocator) {
       } // else ptr == NULL;
     } else {
       // pool has enough space
-      ptr = __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), desc.size_a);
+      ptr = __kmp_custom_malloc(gtid, al, desc.size_a);
       if (ptr == NULL && al->fb == omp_atv_abort_fb) {
         KMP_ASSERT(0); // abort fallback requested
       } // no sense to look for another fallback because of same internal alloc
     }
   } else {
     // custom allocator, pool size not requested
-    ptr = __kmp_thread_malloc(__kmp_thread_from_gtid(gtid), desc.size_a);
+    ptr = __kmp_custom_malloc(gtid, al, desc.size_a);
     if (ptr == NULL && al->fb == omp_atv_abort_fb) {
       KMP_ASSERT(0); // abort fallback requested
     } // no sense to look for another fallback because of same internal alloc
@@ -1790,7 +1860,12 @@ void __kmpc_free(int gtid, void *ptr, const omp_allocator_handle_t allocator) {
       (void)used; // to suppress compiler warning
       KMP_DEBUG_ASSERT(used >= desc.size_a);
     }
-    __kmp_thread_free(__kmp_thread_from_gtid(gtid), desc.ptr_alloc);
+#if KMP_OS_LINUX
+    if (__kmp_is_interleaved(al, desc.size_a))
+      munmap(desc.ptr_alloc, desc.size_a);
+    else
+#endif
+      __kmp_thread_free(__kmp_thread_from_gtid(gtid), desc.ptr_alloc);
   }
   KE_TRACE(10, ("__kmpc_free: T#%d freed %p (%p)\n", gtid, desc.ptr_alloc,
                 allocator));
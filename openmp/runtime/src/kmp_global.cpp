@@ -276,6 +276,7 @@ int __kmp_affinity_respect_mask = affinity_respect_mask_default;
 char *__kmp_affinity_proclist = NULL;
 kmp_affin_mask_t *__kmp_affinity_masks = NULL;
 unsigned __kmp_affinity_num_masks = 0;
+int *__kmp_affinity_place_package = NULL;
 
 char *__kmp_cpuinfo_file = NULL;
 
@@ -356,6 +357,7 @@ omp_memspace_handle_t const llvm_omp_target_device_mem_space =
 KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
+kmp_task_steal_policy_t __kmp_task_steal_policy = task_steal_random;
 int __kmp_enable_task_throttling = 1;
 
 #ifdef DEBUG_SUSPEND
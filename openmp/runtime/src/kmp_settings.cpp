@@ -1275,6 +1275,27 @@ static void __kmp_stg_print_task_stealing(kmp_str_buf_t *buffer,
   __kmp_stg_print_int(buffer, name, __kmp_task_stealing_constraint);
 } // __kmp_stg_print_task_stealing
 
+// -----------------------------------------------------------------------------
+// KMP_TASK_STEALING
+
+static void __kmp_stg_parse_task_steal_policy(char const *name,
+                                              char const *value, void *data) {
+  if (__kmp_str_match("random", 1, value)) {
+    __kmp_task_steal_policy = task_steal_random;
+  } else if (__kmp_str_match("local", 1, value)) {
+    __kmp_task_steal_policy = task_steal_local;
+  } else {
+    KMP_WARNING(StgInvalidValue, name, value);
+  }
+} // __kmp_stg_parse_task_steal_policy
+
+static void __kmp_stg_print_task_steal_policy(kmp_str_buf_t *buffer,
+                                              char const *name, void *data) {
+  __kmp_stg_print_str(buffer, name,
+                      __kmp_task_steal_policy == task_steal_local ? "local"
+                                                                  : "random");
+} // __kmp_stg_print_task_steal_policy
+
 static void __kmp_stg_parse_max_active_levels(char const *name,
                                               char const *value, void *data) {
   kmp_uint64 tmp_dflt = 0;
@@ -5134,6 +5155,8 @@ static kmp_setting_t __kmp_stg_table[] = {
      0},
     {"KMP_TASK_STEALING_CONSTRAINT", __kmp_stg_parse_task_stealing,
      __kmp_stg_print_task_stealing, NULL, 0, 0},
+    {"KMP_TASK_STEALING", __kmp_stg_parse_task_steal_policy,
+     __kmp_stg_print_task_steal_policy, NULL, 0, 0},
     {"OMP_MAX_ACTIVE_LEVELS", __kmp_stg_parse_max_active_levels,
      __kmp_stg_print_max_active_levels, NULL, 0, 0},
     {"OMP_DEFAULT_DEVICE", __kmp_stg_parse_default_device,
@@ -2866,6 +2866,48 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
   return task;
 }
 
+// Package (socket) that a thread is bound to, or -1 if unknown
+static inline int __kmp_get_thread_package(kmp_info_t *thr) {
+#if KMP_AFFINITY_SUPPORTED
+  int place = thr->th.th_current_place;
+  if (__kmp_affinity_place_package != NULL && place >= 0 &&
+      (unsigned)place < __kmp_affinity_num_masks)
+    return __kmp_affinity_place_package[place];
+#endif
+  return -1;
+}
+
+// Number of random draws a thief makes looking for a victim on its own
+// package before settling for any teammate (KMP_TASK_STEALING=local).
+#define KMP_TASK_STEAL_LOCAL_TRIES 4
+
+// Pick a random teammate other than tid to steal from. With the local policy,
+// prefer one bound to the same package as the thief: on multi-socket machines
+// this keeps tasks next to the data their parents touched, while still
+// drawing remote victims when no local one turns up.
+static inline kmp_int32 __kmp_get_random_victim(kmp_info_t *thread,
+                                                kmp_int32 tid,
+                                                kmp_int32 nthreads,
+                                                kmp_thread_data_t *threads_data) {
+  kmp_int32 victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+  if (victim_tid >= tid)
+    ++victim_tid; // Adjusts random distribution to exclude self
+  if (__kmp_task_steal_policy != task_steal_local || nthreads <= 2)
+    return victim_tid;
+  int package = __kmp_get_thread_package(thread);
+  if (package < 0)
+    return victim_tid;
+  for (int i = 1; i < KMP_TASK_STEAL_LOCAL_TRIES; ++i) {
+    if (__kmp_get_thread_package(threads_data[victim_tid].td.td_thr) ==
+        package)
+      break;
+    victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+    if (victim_tid >= tid)
+      ++victim_tid;
+  }
+  return victim_tid;
+}
+
 // __kmp_execute_tasks_template: Choose and execute tasks until either the
 // condition is statisfied (return true) or there are none left (return false).
 //
@@ -2935,10 +2977,8 @@ static inline int __kmp_execute_tasks_template(
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
             // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
-            }
+            victim_tid =
+                __kmp_get_random_victim(thread, tid, nthreads, threads_data);
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
             // There is a slight chance that __kmp_enable_tasking() did not wake
@@ -0,0 +1,43 @@
+// RUN: %libomp-compile-and-run
+
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#define SIZE (4 * 1024 * 1024)
+
+int main() {
+  omp_alloctrait_t at[2];
+  omp_allocator_handle_t a;
+  char *p[4];
+  int i, failed = 0;
+  at[0].key = omp_atk_partition;
+  at[0].value = omp_atv_interleaved;
+  at[1].key = omp_atk_alignment;
+  at[1].value = 64;
+  a = omp_init_allocator(omp_default_mem_space, 2, at);
+  printf("allocator interleaved created: %p\n", (void *)a);
+#pragma omp parallel num_threads(4)
+  {
+    int t = omp_get_thread_num();
+    // Large blocks may be placed across NUMA nodes, small ones come from the
+    // thread's pool; both must be usable and correctly aligned
+    p[t] = omp_alloc(t % 2 ? SIZE : 100, a);
+    if (p[t])
+      memset(p[t], t, t % 2 ? SIZE : 100);
+  }
+  for (i = 0; i < 4; ++i) {
+    size_t size = i % 2 ? SIZE : 100;
+    if (p[i] == NULL || (size_t)p[i] % 64 != 0 || p[i][0] != i ||
+        p[i][size - 1] != i) {
+      printf("failed: block %d at %p\n", i, (void *)p[i]);
+      failed = 1;
+    }
+    omp_free(p[i], a);
+  }
+  omp_destroy_allocator(a);
+  if (failed)
+    return 1;
+  printf("passed\n");
+  return 0;
+}
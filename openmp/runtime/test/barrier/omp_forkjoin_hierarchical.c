@@ -0,0 +1,57 @@
+// RUN: %libomp-compile && env KMP_FORKJOIN_BARRIER_PATTERN=hierarchical,hierarchical %libomp-run
+// RUN: %libomp-compile && env KMP_FORKJOIN_BARRIER_PATTERN=hierarchical,hierarchical KMP_BLOCKTIME=infinite %libomp-run
+// RUN: %libomp-compile && env KMP_FORKJOIN_BARRIER_PATTERN=hierarchical,hierarchical KMP_BLOCKTIME=0 %libomp-run
+//
+// Many small parallel regions, as in fine-grained loops, with the
+// hierarchical fork/join barrier selected through the environment. Every
+// region must see the values written before it and publish its own writes.
+#include <stdio.h>
+#include "omp_testsuite.h"
+
+#define NREGIONS 2000
+#define NTHREADS 8
+
+int test_omp_forkjoin_hierarchical() {
+  int counts[NTHREADS] = {0};
+  int expected = 0;
+  int i, j;
+
+  for (i = 0; i < NREGIONS; i++) {
+    int nthreads = 1;
+    #pragma omp parallel num_threads(NTHREADS)
+    {
+      int tid = omp_get_thread_num();
+      // Reads the value written by this slot's owner in the previous region
+      if (counts[tid] != expected)
+        counts[tid] = -1;
+      else
+        counts[tid]++;
+      #pragma omp single
+      nthreads = omp_get_num_threads();
+    }
+    expected++;
+    // Slots of threads not granted this time must keep up with the others
+    for (j = nthreads; j < NTHREADS; j++)
+      if (counts[j] >= 0)
+        counts[j]++;
+  }
+
+  for (j = 0; j < NTHREADS; j++) {
+    if (counts[j] != NREGIONS) {
+      fprintf(stderr, "slot %d: %d instead of %d\n", j, counts[j], NREGIONS);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int main() {
+  int i;
+  int num_failed = 0;
+
+  for (i = 0; i < REPETITIONS; i++) {
+    if (!test_omp_forkjoin_hierarchical())
+      num_failed++;
+  }
+  return num_failed;
+}
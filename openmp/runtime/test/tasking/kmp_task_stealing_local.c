@@ -0,0 +1,57 @@
+// RUN: %libomp-compile && env KMP_TASK_STEALING=local %libomp-run
+// RUN: %libomp-compile && env KMP_TASK_STEALING=local KMP_AFFINITY=compact %libomp-run
+// RUN: %libomp-compile && env KMP_TASK_STEALING=random %libomp-run
+//
+// Tasks created by a single thread must all be executed, and get stolen by
+// the other threads of the team, whichever victim selection policy is used.
+#include <stdio.h>
+#include "omp_testsuite.h"
+#include "omp_my_sleep.h"
+
+#define NTASKS 1000
+
+int test_task_stealing() {
+  int tids[NTASKS];
+  int executed = 0;
+  int i;
+
+  #pragma omp parallel num_threads(4)
+  {
+    #pragma omp single
+    {
+      for (i = 0; i < NTASKS; i++) {
+        int myi = i;
+        #pragma omp task
+        {
+          if (myi % 100 == 0)
+            my_sleep(0.01);
+          tids[myi] = omp_get_thread_num();
+          #pragma omp atomic
+          executed++;
+        }
+      }
+    }
+  }
+
+  if (executed != NTASKS) {
+    fprintf(stderr, "executed %d tasks out of %d\n", executed, NTASKS);
+    return 0;
+  }
+  for (i = 1; i < NTASKS; i++) {
+    if (tids[i] != tids[0])
+      return 1;
+  }
+  fprintf(stderr, "no task was stolen\n");
+  return 0;
+}
+
+int main() {
+  int i;
+  int num_failed = 0;
+
+  for (i = 0; i < REPETITIONS; i++) {
+    if (!test_task_stealing())
+      num_failed++;
+  }
+  return num_failed;
+}
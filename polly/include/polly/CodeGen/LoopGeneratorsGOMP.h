@@ -69,6 +69,37 @@ public:
   /// @note This function is called right before the thread will exit the
   ///       subfunction and only if the runtime system depends on it.
   void createCallCleanupThread();
+
+private:
+  /// Whether loops are statically divided into one block per thread.
+  ///
+  /// This is the case for '-polly-scheduling=static' without a chunk size.
+  /// The loop bounds are then passed to a single GOMP_parallel call and each
+  /// thread computes its own block, so that no runtime call is needed per
+  /// work item and no work-sharing state is set up in the runtime.
+  bool isStaticBlockScheduled() const;
+
+  /// The type of the struct that carries the loop bounds and the user context
+  /// to a statically scheduled subfunction.
+  StructType *getStaticArgsType() const;
+
+  /// Create a runtime library call to execute @p SubFn on all threads.
+  ///
+  /// @param SubFn      The subfunction which holds the loop body.
+  /// @param SubFnParam The parameter for the subfunction.
+  void createCallParallel(Value *SubFn, Value *SubFnParam);
+
+  /// Create a call to the parameterless int returning runtime function
+  /// @p Name and sign extend the result to LongType.
+  Value *createCallGetThreadInfo(StringRef Name);
+
+  /// Create the subfunction for a statically block scheduled loop.
+  ///
+  /// @see createSubFn
+  std::tuple<Value *, Function *> createStaticSubFn(Value *Stride,
+                                                    AllocaInst *Struct,
+                                                    SetVector<Value *> Data,
+                                                    ValueMapT &VMap);
 };
 } // end namespace polly
 #endif
@@ -51,6 +51,24 @@ void ParallelLoopGeneratorGOMP::deployParallelExecution(Function *SubFn,
                                                         Value *SubFnParam,
                                                         Value *LB, Value *UB,
                                                         Value *Stride) {
+  if (isStaticBlockScheduled()) {
+    // Pass the bounds along with the user context; every thread, including
+    // this one, derives its block from them in the subfunction.
+    StructType *Ty = getStaticArgsType();
+    const DataLayout &DL = M->getDataLayout();
+    Function *F = Builder.GetInsertBlock()->getParent();
+    BasicBlock &EntryBB = F->getEntryBlock();
+    AllocaInst *Args =
+        new AllocaInst(Ty, DL.getAllocaAddrSpace(), nullptr,
+                       "polly.par.staticArgs", &*EntryBB.getFirstInsertionPt());
+    Builder.CreateStore(LB, Builder.CreateStructGEP(Ty, Args, 0));
+    Builder.CreateStore(UB, Builder.CreateStructGEP(Ty, Args, 1));
+    Builder.CreateStore(SubFnParam, Builder.CreateStructGEP(Ty, Args, 2));
+    createCallParallel(SubFn,
+                       Builder.CreateBitCast(Args, Builder.getInt8PtrTy()));
+    return;
+  }
+
   // Tell the runtime we start a parallel loop
   createCallSpawnThreads(SubFn, SubFnParam, LB, UB, Stride);
   Builder.CreateCall(SubFn, SubFnParam);
@@ -91,10 +109,13 @@ std::tuple<Value *, Function *>
 ParallelLoopGeneratorGOMP::createSubFn(Value *Stride, AllocaInst *StructData,
                                        SetVector<Value *> Data,
                                        ValueMapT &Map) {
+  if (isStaticBlockScheduled())
+    return createStaticSubFn(Stride, StructData, Data, Map);
+
   if (PollyScheduling != OMPGeneralSchedulingType::Runtime) {
     // User tried to influence the scheduling type (currently not supported)
     errs() << "warning: Polly's GNU OpenMP backend solely "
-              "supports the scheduling type 'runtime'.\n";
+              "supports the scheduling types 'runtime' and 'static'.\n";
   }
 
   if (PollyChunkSize != 0) {
@@ -221,3 +242,158 @@ void ParallelLoopGeneratorGOMP::createCallCleanupThread() {
 
   Builder.CreateCall(F, {});
 }
+
+bool ParallelLoopGeneratorGOMP::isStaticBlockScheduled() const {
+  return PollyScheduling == OMPGeneralSchedulingType::StaticChunked &&
+         PollyChunkSize == 0;
+}
+
+StructType *ParallelLoopGeneratorGOMP::getStaticArgsType() const {
+  return StructType::get(Builder.getContext(),
+                         {LongType, LongType, Builder.getInt8PtrTy()});
+}
+
+void ParallelLoopGeneratorGOMP::createCallParallel(Value *SubFn,
+                                                   Value *SubFnParam) {
+  const std::string Name = "GOMP_parallel";
+
+  Function *F = M->getFunction(Name);
+
+  // If F is not available, declare it.
+  if (!F) {
+    GlobalValue::LinkageTypes Linkage = Function::ExternalLinkage;
+
+    Type *Params[] = {PointerType::getUnqual(FunctionType::get(
+                          Builder.getVoidTy(), Builder.getInt8PtrTy(), false)),
+                      Builder.getInt8PtrTy(), Builder.getInt32Ty(),
+                      Builder.getInt32Ty()};
+
+    FunctionType *Ty = FunctionType::get(Builder.getVoidTy(), Params, false);
+    F = Function::Create(Ty, Linkage, Name, M);
+  }
+
+  // GOMP_parallel runs the subfunction on the calling thread as well and
+  // returns once all threads are done with it.
+  Value *Args[] = {SubFn, SubFnParam, Builder.getInt32(PollyNumThreads),
+                   Builder.getInt32(0)};
+
+  Builder.CreateCall(F, Args);
+}
+
+Value *ParallelLoopGeneratorGOMP::createCallGetThreadInfo(StringRef Name) {
+  Function *F = M->getFunction(Name);
+
+  // If F is not available, declare it.
+  if (!F) {
+    GlobalValue::LinkageTypes Linkage = Function::ExternalLinkage;
+
+    FunctionType *Ty = FunctionType::get(Builder.getInt32Ty(), false);
+    F = Function::Create(Ty, Linkage, Name, M);
+  }
+
+  return Builder.CreateSExt(Builder.CreateCall(F, {}), LongType);
+}
+
+// Create a subfunction of the following (preliminary) structure:
+//
+//    PrevBB
+//       |
+//       v
+//    HeaderBB
+//       |\______
+//       |       v
+//       |  PreHeaderBB
+//       |   ____/
+//       v  v
+//     ExitBB
+//
+// HeaderBB will hold the loading of variables and computes the block of
+// iterations of the current thread: the loop is split into as many blocks of
+// equal size as there are threads, the last ones possibly being smaller or
+// empty. If the block is not empty, go to PreHeaderBB, otherwise go to ExitBB.
+// PreHeaderBB will lead to the loop body later on.
+std::tuple<Value *, Function *> ParallelLoopGeneratorGOMP::createStaticSubFn(
+    Value *Stride, AllocaInst *StructData, SetVector<Value *> Data,
+    ValueMapT &Map) {
+  Function *SubFn = createSubFnDefinition();
+  LLVMContext &Context = SubFn->getContext();
+
+  // Store the previous basic block.
+  BasicBlock *PrevBB = Builder.GetInsertBlock();
+
+  // Create basic blocks.
+  BasicBlock *HeaderBB = BasicBlock::Create(Context, "polly.par.setup", SubFn);
+  BasicBlock *ExitBB = BasicBlock::Create(Context, "polly.par.exit", SubFn);
+  BasicBlock *PreHeaderBB =
+      BasicBlock::Create(Context, "polly.par.loadIVBounds", SubFn);
+
+  DT.addNewBlock(HeaderBB, PrevBB);
+  DT.addNewBlock(ExitBB, HeaderBB);
+  DT.addNewBlock(PreHeaderBB, HeaderBB);
+
+  // Fill up basic block HeaderBB.
+  Builder.SetInsertPoint(HeaderBB);
+  StructType *ArgsTy = getStaticArgsType();
+  Value *Args = Builder.CreateBitCast(&*SubFn->arg_begin(),
+                                      ArgsTy->getPointerTo(),
+                                      "polly.par.staticArgs");
+  Value *GlobalLB = Builder.CreateLoad(
+      LongType, Builder.CreateStructGEP(ArgsTy, Args, 0), "polly.par.loopLB");
+  Value *GlobalUB = Builder.CreateLoad(
+      LongType, Builder.CreateStructGEP(ArgsTy, Args, 1), "polly.par.loopUB");
+  Value *UserContext = Builder.CreateLoad(
+      Builder.getInt8PtrTy(), Builder.CreateStructGEP(ArgsTy, Args, 2));
+  UserContext = Builder.CreateBitCast(UserContext, StructData->getType(),
+                                      "polly.par.userContext");
+
+  extractValuesFromStruct(Data, StructData->getAllocatedType(), UserContext,
+                          Map);
+
+  // The upper bound is exclusive and not necessarily reached by the stride, so
+  // round the number of iterations up.
+  Value *One = ConstantInt::get(LongType, 1);
+  Value *NumIters = Builder.CreateSub(GlobalUB, GlobalLB);
+  NumIters = Builder.CreateAdd(NumIters, Builder.CreateSub(Stride, One));
+  NumIters = Builder.CreateSDiv(NumIters, Stride, "polly.par.numIters");
+
+  Value *ThreadNum = createCallGetThreadInfo("omp_get_thread_num");
+  Value *NumThreads = createCallGetThreadInfo("omp_get_num_threads");
+  Value *BlockSize =
+      Builder.CreateAdd(NumIters, Builder.CreateSub(NumThreads, One));
+  BlockSize = Builder.CreateSDiv(BlockSize, NumThreads, "polly.par.blockSize");
+
+  Value *Begin = Builder.CreateMul(ThreadNum, BlockSize, "polly.par.begin");
+  Value *End = Builder.CreateAdd(Begin, BlockSize);
+  End = Builder.CreateSelect(Builder.CreateICmpSLT(End, NumIters), End,
+                             NumIters, "polly.par.end");
+  Value *HasWork = Builder.CreateICmpSLT(Begin, End, "polly.par.hasWork");
+  Builder.CreateCondBr(HasWork, PreHeaderBB, ExitBB);
+
+  // Add code to compute the iv bounds of this block.
+  Builder.SetInsertPoint(PreHeaderBB);
+  Value *LB = Builder.CreateAdd(GlobalLB, Builder.CreateMul(Begin, Stride),
+                                "polly.par.LB");
+  Value *UB = Builder.CreateAdd(GlobalLB, Builder.CreateMul(End, Stride));
+
+  // Subtract one as the end of the block is exclusive whereas the
+  // codegenForSequential function creates a <= comparison.
+  UB = Builder.CreateSub(UB, One, "polly.par.UBAdjusted");
+
+  Builder.CreateBr(ExitBB);
+  Builder.SetInsertPoint(&*--Builder.GetInsertPoint());
+  BasicBlock *AfterBB;
+  Value *IV =
+      createLoop(LB, UB, Stride, Builder, LI, DT, AfterBB, ICmpInst::ICMP_SLE,
+                 nullptr, true, /* UseGuard */ false);
+
+  BasicBlock::iterator LoopBody = Builder.GetInsertPoint();
+
+  // Add code to terminate this subfunction. No work-sharing construct was
+  // started, so there is nothing to clean up.
+  Builder.SetInsertPoint(ExitBB);
+  Builder.CreateRetVoid();
+
+  Builder.SetInsertPoint(&*LoopBody);
+
+  return std::make_tuple(IV, SubFn);
+}